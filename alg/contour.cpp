@@ -563,6 +563,13 @@ mode.
  * A negative value means a single transaction. The function takes care of
  * issuing the starting transaction and committing the final one.
  *
+ *   NUM_THREADS=num|ALL_CPUS
+ *
+ * (GDAL >= 3.12) Number of worker threads used to contour horizontal strips
+ * of the raster in parallel. Segments are still merged across strip
+ * boundaries, in order, so the output is the same as with a single thread.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
 CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
@@ -680,6 +687,12 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool(options, "POLYGONIZE", false);
 
+    const char *pszThreads = CSLFetchNameValueDef(
+        options, "NUM_THREADS", CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -857,7 +870,7 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 ContourGeneratorFromRaster<decltype(writer),
                                            FixedLevelRangeIterator>
                     cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = cg.process(pfnProgress, pProgressArg, nThreads);
             }
         }
         else
@@ -900,7 +913,7 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 ContourGeneratorFromRaster<decltype(writer),
                                            FixedLevelRangeIterator>
                     cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = cg.process(pfnProgress, pProgressArg, nThreads);
             }
         }
     }
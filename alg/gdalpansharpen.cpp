@@ -14,6 +14,7 @@
 #include "cpl_port.h"
 #include "cpl_worker_thread_pool.h"
 #include "gdalpansharpen.h"
+#include "gdalpansharpen_avx2.h"
 
 #include <algorithm>
 #include <array>
@@ -23,9 +24,12 @@
 #include <cstring>
 #include <limits>
 #include <new>
+#include <type_traits>
 
 #include "cpl_conv.h"
+#include "cpl_cpu_features.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_float.h"
 #include "cpl_multiproc.h"
 #include "cpl_vsi.h"
@@ -593,6 +597,42 @@ template <class T> static inline T ClampAndRound(double dfVal, T nMaxValue)
         return static_cast<T>(dfVal + 0.5);
 }
 
+/************************************************************************/
+/*                       WeightedBroveyAVX2()                           */
+/************************************************************************/
+
+// Processes the first values with the AVX2 kernels when they are available
+// at runtime and support the combination of data types.
+// Returns the number of values processed, possibly 0.
+template <class WorkDataType, class OutDataType>
+static size_t WeightedBroveyAVX2(
+    [[maybe_unused]] const GDALPansharpenOptions *psOptions,
+    [[maybe_unused]] const WorkDataType *pPanBuffer,
+    [[maybe_unused]] const WorkDataType *pUpsampledSpectralBuffer,
+    [[maybe_unused]] OutDataType *pDataBuf, [[maybe_unused]] size_t nValues,
+    [[maybe_unused]] size_t nBandValues,
+    [[maybe_unused]] WorkDataType nMaxValue)
+{
+#ifdef HAVE_PANSHARPEN_AVX2
+    if constexpr ((std::is_same_v<WorkDataType, GByte> ||
+                   std::is_same_v<WorkDataType, GUInt16> ||
+                   std::is_same_v<WorkDataType, double>) &&
+                  (std::is_same_v<WorkDataType, OutDataType> ||
+                   std::is_same_v<OutDataType, double>))
+    {
+        if (CPLHaveRuntimeAVX2())
+        {
+            return GDALPansharpenWeightedBroveyAVX2(
+                pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+                nBandValues, psOptions->nInputSpectralBands,
+                psOptions->padfWeights, psOptions->nOutPansharpenedBands,
+                psOptions->panOutPansharpenedBands, nMaxValue);
+        }
+    }
+#endif
+    return 0;
+}
+
 /************************************************************************/
 /*                         WeightedBrovey()                             */
 /************************************************************************/
@@ -611,7 +651,15 @@ void GDALPansharpenOperation::WeightedBrovey3(
         return;
     }
 
-    for (size_t j = 0; j < nValues; j++)
+    size_t j = 0;
+    if constexpr (!bHasBitDepth ||
+                  std::numeric_limits<WorkDataType>::is_integer)
+    {
+        j = WeightedBroveyAVX2(psOptions, pPanBuffer, pUpsampledSpectralBuffer,
+                               pDataBuf, nValues, nBandValues,
+                               bHasBitDepth ? nMaxValue : WorkDataType(0));
+    }
+    for (; j < nValues; j++)
     {
         double dfFactor = 0.0;
         // if( pPanBuffer[j] == 0 )
@@ -797,8 +845,12 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
 
     if (nMaxValue == 0)
         nMaxValue = cpl::NumericLimits<T>::max();
-    size_t j;
-    if (psOptions->nInputSpectralBands == 3 &&
+    // When the AVX2 kernel has been used, only the last values, if any,
+    // remain to be processed by the generic loops.
+    size_t j = WeightedBroveyAVX2(psOptions, pPanBuffer,
+                                  pUpsampledSpectralBuffer, pDataBuf, nValues,
+                                  nBandValues, nMaxValue);
+    if (j == 0 && psOptions->nInputSpectralBands == 3 &&
         psOptions->nOutPansharpenedBands == 3 &&
         psOptions->panOutPansharpenedBands[0] == 0 &&
         psOptions->panOutPansharpenedBands[1] == 1 &&
@@ -808,7 +860,7 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
             pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
             nBandValues, nMaxValue);
     }
-    else if (psOptions->nInputSpectralBands == 4 &&
+    else if (j == 0 && psOptions->nInputSpectralBands == 4 &&
              psOptions->nOutPansharpenedBands == 4 &&
              psOptions->panOutPansharpenedBands[0] == 0 &&
              psOptions->panOutPansharpenedBands[1] == 1 &&
@@ -819,7 +871,7 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
             pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
             nBandValues, nMaxValue);
     }
-    else if (psOptions->nInputSpectralBands == 4 &&
+    else if (j == 0 && psOptions->nInputSpectralBands == 4 &&
              psOptions->nOutPansharpenedBands == 3 &&
              psOptions->panOutPansharpenedBands[0] == 0 &&
              psOptions->panOutPansharpenedBands[1] == 1 &&
@@ -831,7 +883,7 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
     }
     else
     {
-        for (j = 0; j + 1 < nValues; j += 2)
+        for (; j + 1 < nValues; j += 2)
         {
             double dfFactor = 0.0;
             double dfFactor2 = 0.0;
@@ -1182,22 +1234,13 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
     GByte *pUpsampledSpectralBuffer = static_cast<GByte *>(VSI_MALLOC3_VERBOSE(
         nXSize, nYSize,
         cpl::fits_on<int>(psOptions->nInputSpectralBands * nDataTypeSize)));
-    GByte *pPanBuffer = static_cast<GByte *>(
-        VSI_MALLOC3_VERBOSE(nXSize, nYSize, nDataTypeSize));
+    std::unique_ptr<GByte, VSIFreeReleaser> pabyPanBufferHolder(
+        static_cast<GByte *>(
+            VSI_MALLOC3_VERBOSE(nXSize, nYSize, nDataTypeSize)));
+    GByte *pPanBuffer = pabyPanBufferHolder.get();
     if (pUpsampledSpectralBuffer == nullptr || pPanBuffer == nullptr)
     {
         VSIFree(pUpsampledSpectralBuffer);
-        VSIFree(pPanBuffer);
-        return CE_Failure;
-    }
-
-    CPLErr eErr = poPanchroBand->RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize,
-                                          pPanBuffer, nXSize, nYSize,
-                                          eWorkDataType, 0, 0, nullptr);
-    if (eErr != CE_None)
-    {
-        VSIFree(pUpsampledSpectralBuffer);
-        VSIFree(pPanBuffer);
         return CE_Failure;
     }
 
@@ -1209,6 +1252,57 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
             nTasks = nYSize;
     }
 
+    // When worker threads are available, read the panchromatic band in one
+    // of them, while the spectral bands are read and upsampled. This is only
+    // safe if the panchromatic band does not belong to a dataset from which
+    // spectral bands are read.
+    bool bReadPanInThread = poThreadPool != nullptr &&
+                            poPanchroBand->GetDataset() != nullptr;
+    for (int i = 0; bReadPanInThread && i < psOptions->nInputSpectralBands;
+         i++)
+    {
+        bReadPanInThread =
+            aMSBands[i]->GetDataset() != poPanchroBand->GetDataset() &&
+            GDALRasterBand::FromHandle(psOptions->pahInputSpectralBands[i])
+                    ->GetDataset() != poPanchroBand->GetDataset();
+    }
+
+    CPLErr eErr = CE_None;
+    CPLErr eErrPan = CE_None;
+    CPLErrorAccumulator oPanErrorAccumulator;
+    // Declared after pabyPanBufferHolder, so that on early exit, the reading
+    // of the panchromatic band is completed before the buffer is freed.
+    std::unique_ptr<CPLJobQueue> poPanJobQueue;
+    if (bReadPanInThread)
+    {
+        poPanJobQueue = poThreadPool->CreateJobQueue();
+        if (!poPanJobQueue->SubmitJob(
+                [poPanchroBand, nXOff, nYOff, nXSize, nYSize, pPanBuffer,
+                 eWorkDataType, &eErrPan, &oPanErrorAccumulator]()
+                {
+                    auto oContext =
+                        oPanErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oContext);
+                    eErrPan = poPanchroBand->RasterIO(
+                        GF_Read, nXOff, nYOff, nXSize, nYSize, pPanBuffer,
+                        nXSize, nYSize, eWorkDataType, 0, 0, nullptr);
+                }))
+        {
+            poPanJobQueue.reset();
+        }
+    }
+    if (!poPanJobQueue)
+    {
+        eErr = poPanchroBand->RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize,
+                                       pPanBuffer, nXSize, nYSize,
+                                       eWorkDataType, 0, 0, nullptr);
+        if (eErr != CE_None)
+        {
+            VSIFree(pUpsampledSpectralBuffer);
+            return CE_Failure;
+        }
+    }
+
     GDALRasterIOExtraArg sExtraArg;
     INIT_RASTERIO_EXTRA_ARG(sExtraArg);
     const GDALRIOResampleAlg eResampleAlg = psOptions->eResampleAlg;
@@ -1268,7 +1362,6 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         if (pSpectralBuffer == nullptr)
         {
             VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
             return CE_Failure;
         }
 
@@ -1298,7 +1391,6 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         {
             VSIFree(pSpectralBuffer);
             VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
             return CE_Failure;
         }
 
@@ -1438,7 +1530,6 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
                         GDALClose(poMEMDS);
                         VSIFree(pSpectralBuffer);
                         VSIFree(pUpsampledSpectralBuffer);
-                        VSIFree(pPanBuffer);
 
                         return CE_Failure;
                     }
@@ -1477,7 +1568,17 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         if (eErr != CE_None)
         {
             VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
+            return CE_Failure;
+        }
+    }
+
+    if (poPanJobQueue)
+    {
+        poPanJobQueue->WaitCompletion();
+        oPanErrorAccumulator.ReplayErrors();
+        if (eErrPan != CE_None)
+        {
+            VSIFree(pUpsampledSpectralBuffer);
             return CE_Failure;
         }
     }
@@ -1549,7 +1650,6 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         if (padfTempBuffer == nullptr)
         {
             VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
             return CE_Failure;
         }
         pDataBuf = padfTempBuffer;
@@ -1626,7 +1726,6 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
     }
 
     VSIFree(pUpsampledSpectralBuffer);
-    VSIFree(pPanBuffer);
 
     return eErr;
 }
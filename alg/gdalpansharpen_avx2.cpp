@@ -0,0 +1,199 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Pansharpening module
+ * Purpose:  AVX2 implementation of the weighted Brovey algorithm
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "gdalpansharpen_avx2.h"
+
+#ifdef HAVE_PANSHARPEN_AVX2
+
+#include <immintrin.h>
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// 4 pixels are processed at a time, with one pixel per lane. The pseudo
+// panchromatic value is accumulated in the order of the spectral bands, with
+// separate multiplications and additions, so that results are identical to
+// the ones of the scalar code of gdalpansharpen.cpp.
+
+/************************************************************************/
+/*                            Load4Values()                             */
+/************************************************************************/
+
+static inline __m256d Load4Values(const GByte *pSrc)
+{
+    int nVal;
+    memcpy(&nVal, pSrc, sizeof(nVal));
+    return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(nVal)));
+}
+
+static inline __m256d Load4Values(const GUInt16 *pSrc)
+{
+    return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pSrc))));
+}
+
+static inline __m256d Load4Values(const double *pSrc)
+{
+    return _mm256_loadu_pd(pSrc);
+}
+
+/************************************************************************/
+/*                            Store4Values()                            */
+/************************************************************************/
+
+// Values are expected to be already rounded and clamped to the range of the
+// output data type for integer types.
+
+static inline void Store4Values(__m256d val, GByte *pDst)
+{
+    __m128i nVal = _mm256_cvttpd_epi32(val);
+    nVal = _mm_packus_epi32(nVal, nVal);
+    nVal = _mm_packus_epi16(nVal, nVal);
+    const int nBytes = _mm_cvtsi128_si32(nVal);
+    memcpy(pDst, &nBytes, sizeof(nBytes));
+}
+
+static inline void Store4Values(__m256d val, GUInt16 *pDst)
+{
+    __m128i nVal = _mm256_cvttpd_epi32(val);
+    nVal = _mm_packus_epi32(nVal, nVal);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(pDst), nVal);
+}
+
+static inline void Store4Values(__m256d val, double *pDst)
+{
+    _mm256_storeu_pd(pDst, val);
+}
+
+/************************************************************************/
+/*                        WeightedBroveyAVX2()                          */
+/************************************************************************/
+
+template <class WorkDataType, class OutDataType>
+static size_t WeightedBroveyAVX2(const WorkDataType *pPanBuffer,
+                                 const WorkDataType *pUpsampledSpectralBuffer,
+                                 OutDataType *pDataBuf, size_t nValues,
+                                 size_t nBandValues, int nInputBands,
+                                 const double *padfWeights, int nOutBands,
+                                 const int *panOutBands,
+                                 WorkDataType nMaxValue)
+{
+    constexpr bool bIsInteger = std::numeric_limits<WorkDataType>::is_integer;
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d maxValue = _mm256_set1_pd(
+        nMaxValue != 0 ? static_cast<double>(nMaxValue)
+                       : static_cast<double>(
+                             std::numeric_limits<WorkDataType>::max()));
+
+    size_t j = 0;
+    for (; j + 3 < nValues; j += 4)
+    {
+        __m256d pseudoPanchro = zero;
+        for (int i = 0; i < nInputBands; i++)
+        {
+            pseudoPanchro = _mm256_add_pd(
+                pseudoPanchro,
+                _mm256_mul_pd(_mm256_set1_pd(padfWeights[i]),
+                              Load4Values(pUpsampledSpectralBuffer +
+                                          i * nBandValues + j)));
+        }
+
+        // Factor is 0 where the pseudo panchromatic value is 0
+        const __m256d factor = _mm256_and_pd(
+            _mm256_cmp_pd(pseudoPanchro, zero, _CMP_NEQ_UQ),
+            _mm256_div_pd(Load4Values(pPanBuffer + j), pseudoPanchro));
+
+        for (int i = 0; i < nOutBands; i++)
+        {
+            __m256d val = _mm256_mul_pd(
+                Load4Values(pUpsampledSpectralBuffer +
+                            panOutBands[i] * nBandValues + j),
+                factor);
+            if constexpr (bIsInteger)
+            {
+                // Same as GDALCopyWord() to the working data type, followed
+                // by clamping to nMaxValue. NaN becomes 0.
+                val = _mm256_min_pd(
+                    _mm256_max_pd(_mm256_add_pd(val, half), zero), maxValue);
+                if constexpr (std::is_same_v<OutDataType, double>)
+                {
+                    val = _mm256_round_pd(
+                        val, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                }
+            }
+            Store4Values(val, pDataBuf + i * nBandValues + j);
+        }
+    }
+    return j;
+}
+
+/************************************************************************/
+/*                 GDALPansharpenWeightedBroveyAVX2()                   */
+/************************************************************************/
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const GByte *pPanBuffer, const GByte *pUpsampledSpectralBuffer,
+    GByte *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    GByte nMaxValue)
+{
+    return WeightedBroveyAVX2(pPanBuffer, pUpsampledSpectralBuffer, pDataBuf,
+                              nValues, nBandValues, nInputBands, padfWeights,
+                              nOutBands, panOutBands, nMaxValue);
+}
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const GByte *pPanBuffer, const GByte *pUpsampledSpectralBuffer,
+    double *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    GByte nMaxValue)
+{
+    return WeightedBroveyAVX2(pPanBuffer, pUpsampledSpectralBuffer, pDataBuf,
+                              nValues, nBandValues, nInputBands, padfWeights,
+                              nOutBands, panOutBands, nMaxValue);
+}
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const GUInt16 *pPanBuffer, const GUInt16 *pUpsampledSpectralBuffer,
+    GUInt16 *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    GUInt16 nMaxValue)
+{
+    return WeightedBroveyAVX2(pPanBuffer, pUpsampledSpectralBuffer, pDataBuf,
+                              nValues, nBandValues, nInputBands, padfWeights,
+                              nOutBands, panOutBands, nMaxValue);
+}
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const GUInt16 *pPanBuffer, const GUInt16 *pUpsampledSpectralBuffer,
+    double *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    GUInt16 nMaxValue)
+{
+    return WeightedBroveyAVX2(pPanBuffer, pUpsampledSpectralBuffer, pDataBuf,
+                              nValues, nBandValues, nInputBands, padfWeights,
+                              nOutBands, panOutBands, nMaxValue);
+}
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const double *pPanBuffer, const double *pUpsampledSpectralBuffer,
+    double *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    double nMaxValue)
+{
+    return WeightedBroveyAVX2(pPanBuffer, pUpsampledSpectralBuffer, pDataBuf,
+                              nValues, nBandValues, nInputBands, padfWeights,
+                              nOutBands, panOutBands, nMaxValue);
+}
+
+#endif  // HAVE_PANSHARPEN_AVX2
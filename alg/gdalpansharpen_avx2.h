@@ -0,0 +1,67 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Pansharpening module
+ * Purpose:  AVX2 implementation of the weighted Brovey algorithm
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef GDALPANSHARPEN_AVX2_H_INCLUDED
+#define GDALPANSHARPEN_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+#include <cstddef>
+
+//! @cond Doxygen_Suppress
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#define HAVE_PANSHARPEN_AVX2
+
+// Each function computes the weighted Brovey pansharpening of the first
+// values of the buffers, and returns how many of them have been processed
+// (a multiple of 4). Remaining values must be processed by the caller.
+//
+// For integer working data types, pansharpened values are rounded and clamped
+// to [0, nMaxValue], or to the range of the working data type if nMaxValue is
+// 0. For double, they are stored unmodified.
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const GByte *pPanBuffer, const GByte *pUpsampledSpectralBuffer,
+    GByte *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    GByte nMaxValue);
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const GByte *pPanBuffer, const GByte *pUpsampledSpectralBuffer,
+    double *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    GByte nMaxValue);
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const GUInt16 *pPanBuffer, const GUInt16 *pUpsampledSpectralBuffer,
+    GUInt16 *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    GUInt16 nMaxValue);
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const GUInt16 *pPanBuffer, const GUInt16 *pUpsampledSpectralBuffer,
+    double *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    GUInt16 nMaxValue);
+
+size_t GDALPansharpenWeightedBroveyAVX2(
+    const double *pPanBuffer, const double *pUpsampledSpectralBuffer,
+    double *pDataBuf, size_t nValues, size_t nBandValues, int nInputBands,
+    const double *padfWeights, int nOutBands, const int *panOutBands,
+    double nMaxValue);
+
+#endif
+
+//! @endcond
+
+#endif /* GDALPANSHARPEN_AVX2_H_INCLUDED */
@@ -18,6 +18,8 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -25,6 +27,7 @@
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    int *panNearY, int bForward, int iLine,
@@ -33,6 +36,13 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    double *pdfSrcNoDataValue, int nTargetValues,
                                    int *panTargetValues);
 
+static CPLErr ComputeExactProximity(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hProximityBand,
+    GDALRasterBandH hWorkProximityBand, double dfMaxDist, double dfDistMult,
+    const double *pdfSrcNoDataValue, float fNoDataValue, bool bFixedBufVal,
+    double dfFixedBufVal, int nTargetValues, const int *panTargetValues,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg);
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -89,6 +99,20 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threshold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[PROPAGATION]/EXACT
+
+(GDAL >= 3.12) Algorithm used to compute distances. PROPAGATION, the
+default, propagates the nearest target from neighbouring pixels in a
+single thread, and may in rare configurations report a slightly larger
+distance than the exact one. EXACT computes exact Euclidean distances with
+a separable distance transform, which can use several threads.
+
+  NUM_THREADS=n/ALL_CPUS
+
+(GDAL >= 3.12) Number of worker threads used by ALGORITHM=EXACT. Defaults
+to the value of the GDAL_NUM_THREADS configuration option, or 1. The output
+does not depend on the number of threads.
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -225,6 +249,35 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         CSLDestroy(papszValuesTokens);
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Which algorithm, and how many threads?                          */
+    /* -------------------------------------------------------------------- */
+    bool bExact = false;
+    pszOpt = CSLFetchNameValue(papszOptions, "ALGORITHM");
+    if (pszOpt)
+    {
+        if (EQUAL(pszOpt, "EXACT"))
+        {
+            bExact = true;
+        }
+        else if (!EQUAL(pszOpt, "PROPAGATION"))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unrecognized ALGORITHM value '%s', should be "
+                     "PROPAGATION or EXACT.",
+                     pszOpt);
+            CPLFree(panTargetValues);
+            return CE_Failure;
+        }
+    }
+
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -252,8 +305,12 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     GInt32 *panSrcScanline = nullptr;
     bool bTempFileAlreadyDeleted = false;
 
+    // The exact algorithm stores vertical distances in whole rows in the
+    // work band, which must be able to hold any line number.
     if (eProxType == GDT_Byte || eProxType == GDT_UInt16 ||
-        eProxType == GDT_UInt32)
+        eProxType == GDT_UInt32 ||
+        (bExact && eProxType != GDT_Int32 && eProxType != GDT_Int64 &&
+         eProxType != GDT_Float32 && eProxType != GDT_Float64))
     {
         GDALDriverH hDriver = GDALGetDriverByName("GTiff");
         if (hDriver == nullptr)
@@ -278,6 +335,16 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         hWorkProximityBand = GDALGetRasterBand(hWorkProximityDS, 1);
     }
 
+    if (bExact)
+    {
+        eErr = ComputeExactProximity(
+            hSrcBand, hProximityBand, hWorkProximityBand, dfMaxDist,
+            dfDistMult, pdfSrcNoData, fNoDataValue, bFixedBufVal,
+            dfFixedBufVal, nTargetValues, panTargetValues, nThreads,
+            pfnProgress, pProgressArg);
+        goto end;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate buffer for two scanlines of distances as floats        */
     /*      (the current and last line).                                    */
@@ -573,3 +640,284 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
 
     return CE_None;
 }
+
+/************************************************************************/
+/*                       ComputeExactProximity()                        */
+/************************************************************************/
+
+/* Exact Euclidean distance transform (Felzenszwalb & Huttenlocher, "Distance
+ * Transforms of Sampled Functions"), processed by chunks of lines so that
+ * memory use stays bounded.
+ *
+ * The first pass scans the image from top to bottom, and stores in the work
+ * band, for each pixel, the number of lines to the closest target above it in
+ * the same column (or -1).  The second pass scans the image from bottom to
+ * top, completes those vertical distances with the closest target below, and
+ * computes the final squared distance of each line as the lower envelope of
+ * the parabolas rooted at the pixels of that line.
+ *
+ * Reading and writing happen in the calling thread.  The columns of a chunk
+ * are split between the worker threads for the vertical scans, and its lines
+ * for the lower envelopes.
+ */
+
+static CPLErr ComputeExactProximity(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hProximityBand,
+    GDALRasterBandH hWorkProximityBand, double dfMaxDist, double dfDistMult,
+    const double *pdfSrcNoDataValue, float fNoDataValue, bool bFixedBufVal,
+    double dfFixedBufVal, int nTargetValues, const int *panTargetValues,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Number of lines processed at once: about 4 million pixels,      */
+    /*      rounded to whole source blocks when possible.                   */
+    /* -------------------------------------------------------------------- */
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    GDALGetBlockSize(hSrcBand, &nBlockXSize, &nBlockYSize);
+    int nChunkLines = std::max(1, (4 * 1024 * 1024) / nXSize);
+    if (nBlockYSize > 1 && nChunkLines > nBlockYSize)
+        nChunkLines = (nChunkLines / nBlockYSize) * nBlockYSize;
+    nChunkLines = std::max(
+        1, atoi(CPLGetConfigOption("GDAL_PROXIMITY_CHUNK_LINES",
+                                   CPLSPrintf("%d", nChunkLines))));
+    nChunkLines = std::min(nChunkLines, nYSize);
+    const int nChunks = (nYSize + nChunkLines - 1) / nChunkLines;
+
+    const auto IsTarget = [nTargetValues, panTargetValues](GInt32 nVal)
+    {
+        if (nTargetValues == 0)
+            return nVal != 0;
+        for (int i = 0; i < nTargetValues; i++)
+        {
+            if (nVal == panTargetValues[i])
+                return true;
+        }
+        return false;
+    };
+
+    std::vector<GInt32> anSrc;
+    std::vector<float> afDist;
+    std::vector<int> anCarry;
+    try
+    {
+        anSrc.resize(static_cast<size_t>(nXSize) * nChunkLines);
+        afDist.resize(static_cast<size_t>(nXSize) * nChunkLines);
+        anCarry.resize(nXSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALComputeProximity()");
+        return CE_Failure;
+    }
+
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+
+    // Run pfnJob(iStart, iEnd) over [0, nCount) split between the threads.
+    const auto RunParallel = [nThreads, &poQueue](int nCount, auto &&pfnJob)
+    {
+        const int nJobs = std::min(nThreads, nCount);
+        for (int iJob = 0; iJob < nJobs; ++iJob)
+        {
+            const int iStart = static_cast<int>(
+                static_cast<GIntBig>(nCount) * iJob / nJobs);
+            const int iEnd = static_cast<int>(static_cast<GIntBig>(nCount) *
+                                              (iJob + 1) / nJobs);
+            if (!poQueue || iJob == nJobs - 1 ||
+                !poQueue->SubmitJob([&pfnJob, iStart, iEnd]()
+                                    { pfnJob(iStart, iEnd); }))
+            {
+                pfnJob(iStart, iEnd);
+            }
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+    };
+
+    // Update the vertical distance carried along each column with the pixel
+    // of the given line, and return it.
+    const auto UpdateCarry = [&IsTarget, dfMaxDist](int &nCarry, GInt32 nVal)
+    {
+        if (IsTarget(nVal))
+            nCarry = 0;
+        else if (nCarry >= 0 && ++nCarry > dfMaxDist)
+            nCarry = -1;
+        return nCarry;
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      Top to bottom: distance to the closest target above.            */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    std::fill(anCarry.begin(), anCarry.end(), -1);
+    for (int iChunk = 0; eErr == CE_None && iChunk < nChunks; ++iChunk)
+    {
+        const int nYOff = iChunk * nChunkLines;
+        const int nLines = std::min(nChunkLines, nYSize - nYOff);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nYOff, nXSize, nLines,
+                            anSrc.data(), nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        RunParallel(nXSize,
+                    [&](int iXStart, int iXEnd)
+                    {
+                        for (int iLine = 0; iLine < nLines; ++iLine)
+                        {
+                            const size_t nOff =
+                                static_cast<size_t>(iLine) * nXSize;
+                            for (int i = iXStart; i < iXEnd; ++i)
+                            {
+                                afDist[nOff + i] = static_cast<float>(
+                                    UpdateCarry(anCarry[i], anSrc[nOff + i]));
+                            }
+                        }
+                    });
+
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Write, 0, nYOff, nXSize,
+                            nLines, afDist.data(), nXSize, nLines, GDT_Float32,
+                            0, 0);
+        if (eErr != CE_None)
+            break;
+
+        if (!pfnProgress(0.5 * (nYOff + nLines) / static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Bottom to top: distance to the closest target in the column,    */
+    /*      then lower envelope along each line.                            */
+    /* -------------------------------------------------------------------- */
+    std::fill(anCarry.begin(), anCarry.end(), -1);
+    const double dfMaxDistSq = dfMaxDist * dfMaxDist;
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    for (int iChunk = nChunks - 1; eErr == CE_None && iChunk >= 0; --iChunk)
+    {
+        const int nYOff = iChunk * nChunkLines;
+        const int nLines = std::min(nChunkLines, nYSize - nYOff);
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Read, 0, nYOff, nXSize,
+                            nLines, afDist.data(), nXSize, nLines, GDT_Float32,
+                            0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nYOff, nXSize, nLines,
+                                anSrc.data(), nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        RunParallel(nXSize,
+                    [&](int iXStart, int iXEnd)
+                    {
+                        for (int iLine = nLines - 1; iLine >= 0; --iLine)
+                        {
+                            const size_t nOff =
+                                static_cast<size_t>(iLine) * nXSize;
+                            for (int i = iXStart; i < iXEnd; ++i)
+                            {
+                                const int nBelow =
+                                    UpdateCarry(anCarry[i], anSrc[nOff + i]);
+                                if (nBelow >= 0 && (afDist[nOff + i] < 0 ||
+                                                    nBelow < afDist[nOff + i]))
+                                {
+                                    afDist[nOff + i] =
+                                        static_cast<float>(nBelow);
+                                }
+                            }
+                        }
+                    });
+
+        RunParallel(
+            nLines,
+            [&](int iLineStart, int iLineEnd)
+            {
+                // Parabola roots, squared heights, and boundaries of the
+                // lower envelope.
+                std::vector<int> anRoot(nXSize);
+                std::vector<double> adfHeight(nXSize);
+                std::vector<double> adfBound(static_cast<size_t>(nXSize) + 1);
+                for (int iLine = iLineStart; iLine < iLineEnd; ++iLine)
+                {
+                    float *pafLine =
+                        afDist.data() + static_cast<size_t>(iLine) * nXSize;
+                    const GInt32 *panLine =
+                        anSrc.data() + static_cast<size_t>(iLine) * nXSize;
+
+                    int k = -1;
+                    for (int q = 0; q < nXSize; ++q)
+                    {
+                        if (pafLine[q] < 0)
+                            continue;
+                        const double dfH =
+                            static_cast<double>(pafLine[q]) * pafLine[q];
+                        adfHeight[q] = dfH;
+                        double s = -INF;
+                        while (k >= 0)
+                        {
+                            const int r = anRoot[k];
+                            s = ((dfH + static_cast<double>(q) * q) -
+                                 (adfHeight[r] + static_cast<double>(r) * r)) /
+                                (2.0 * (q - r));
+                            if (s > adfBound[k])
+                                break;
+                            --k;
+                            s = -INF;
+                        }
+                        ++k;
+                        anRoot[k] = q;
+                        adfBound[k] = s;
+                    }
+
+                    const int nParabolas = k + 1;
+                    k = 0;
+                    for (int q = 0; q < nXSize; ++q)
+                    {
+                        double dfDistSq = INF;
+                        if (nParabolas > 0)
+                        {
+                            while (k + 1 < nParabolas && adfBound[k + 1] < q)
+                                ++k;
+                            const int r = anRoot[k];
+                            dfDistSq = static_cast<double>(q - r) * (q - r) +
+                                       adfHeight[r];
+                        }
+
+                        if (dfDistSq == 0)
+                            pafLine[q] = 0.0f;
+                        else if (dfDistSq > dfMaxDistSq ||
+                                 (pdfSrcNoDataValue != nullptr &&
+                                  panLine[q] == *pdfSrcNoDataValue))
+                            pafLine[q] = fNoDataValue;
+                        else if (bFixedBufVal)
+                            pafLine[q] = static_cast<float>(dfFixedBufVal);
+                        else
+                            pafLine[q] = static_cast<float>(
+                                sqrt(dfDistSq) * dfDistMult);
+                    }
+                }
+            });
+
+        eErr = GDALRasterIO(hProximityBand, GF_Write, 0, nYOff, nXSize, nLines,
+                            afDist.data(), nXSize, nLines, GDT_Float32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        if (!pfnProgress(0.5 + 0.5 * (nYSize - nYOff) /
+                                   static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
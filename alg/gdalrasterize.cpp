@@ -20,18 +20,24 @@
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
+#include <cmath>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 #include <vector>
 #include <algorithm>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -857,6 +863,275 @@ static CPLErr GDALRasterizeOptions(CSLConstList papszOptions, int *pbAllTouched,
     return CE_None;
 }
 
+/************************************************************************/
+/*                 GDALRasterizeGeometriesMultiThreaded()               */
+/************************************************************************/
+
+/* The output raster is split into tiles aligned on its blocks. Worker threads
+ * first compute the pixel envelope of each geometry, and bin it into the
+ * tiles it intersects. The tiles are then burnt concurrently, each with its
+ * own list of geometries in their original order, so that the result is
+ * identical to the one of the sequential algorithms. Reading and writing the
+ * tiles is serialized, as the output dataset is not thread-safe.
+ */
+
+static CPLErr GDALRasterizeGeometriesMultiThreaded(
+    GDALDataset *poDS, int nBandCount, const int *panBandList, int nGeomCount,
+    const OGRGeometryH *pahGeometries, GDALTransformerFunc pfnTransformer,
+    const std::vector<void *> &apTransformArgs, GDALDataType eBurnValueType,
+    const double *padfGeomBurnValues, const int64_t *panGeomBurnValues,
+    int bAllTouched, GDALBurnValueSrc eBurnValueSource,
+    GDALRasterMergeAlg eMergeAlg, int nTileXSize, int nTileYSize,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nThreads = static_cast<int>(apTransformArgs.size());
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    const int nXTiles = DIV_ROUND_UP(nXSize, nTileXSize);
+    const int nYTiles = DIV_ROUND_UP(nYSize, nTileYSize);
+    const int nTiles = nXTiles * nYTiles;
+
+    const GDALDataType eType = GDALGetNonComplexDataType(
+        poDS->GetRasterBand(panBandList[0])->GetRasterDataType());
+    const size_t nPixelSize =
+        static_cast<size_t>(nBandCount) * GDALGetDataTypeSizeBytes(eType);
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    if (!poPool)
+        return CE_Failure;
+    auto poQueue = poPool->CreateJobQueue();
+
+    CPLErrorAccumulator oErrorAccumulator;
+    std::atomic<bool> bError{false};
+
+    /* -------------------------------------------------------------------- */
+    /*      Bin the geometries into the tiles their pixel envelope          */
+    /*      intersects. Each job handles a range of geometries, so that     */
+    /*      concatenating the bins of the jobs in order keeps the original  */
+    /*      order of the geometries.                                        */
+    /* -------------------------------------------------------------------- */
+    std::vector<std::vector<std::vector<int>>> aaanJobBins(nThreads);
+    for (int iJob = 0; iJob < nThreads; ++iJob)
+    {
+        const auto BinGeometries = [&, iJob]()
+        {
+            auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oAccumulator);
+            try
+            {
+                auto &aanBins = aaanJobBins[iJob];
+                aanBins.resize(nTiles);
+                const int iStart = static_cast<int>(
+                    static_cast<GIntBig>(nGeomCount) * iJob / nThreads);
+                const int iEnd = static_cast<int>(
+                    static_cast<GIntBig>(nGeomCount) * (iJob + 1) / nThreads);
+                std::vector<double> aPointX, aPointY, aPointVariant;
+                std::vector<int> aPartSize;
+                std::vector<int> anSuccess;
+                for (int iShape = iStart; iShape < iEnd; ++iShape)
+                {
+                    aPointX.clear();
+                    aPointY.clear();
+                    aPartSize.clear();
+                    GDALCollectRingsFromGeometry(
+                        OGRGeometry::FromHandle(pahGeometries[iShape]),
+                        aPointX, aPointY, aPointVariant, aPartSize,
+                        GBV_UserBurnValue);
+                    if (aPointX.empty())
+                        continue;
+                    anSuccess.resize(aPointX.size());
+                    pfnTransformer(apTransformArgs[iJob], FALSE,
+                                   static_cast<int>(aPointX.size()),
+                                   aPointX.data(), aPointY.data(), nullptr,
+                                   anSuccess.data());
+
+                    // Pixels touched by a geometry are at most one pixel
+                    // away from its envelope.
+                    double dfMinX = std::numeric_limits<double>::infinity();
+                    double dfMinY = dfMinX;
+                    double dfMaxX = -dfMinX;
+                    double dfMaxY = -dfMinX;
+                    for (size_t i = 0; i < aPointX.size(); ++i)
+                    {
+                        if (!std::isnan(aPointX[i]) && !std::isnan(aPointY[i]))
+                        {
+                            dfMinX = std::min(dfMinX, aPointX[i]);
+                            dfMinY = std::min(dfMinY, aPointY[i]);
+                            dfMaxX = std::max(dfMaxX, aPointX[i]);
+                            dfMaxY = std::max(dfMaxY, aPointY[i]);
+                        }
+                    }
+                    if (!(dfMinX - 1 < nXSize && dfMaxX + 1 >= 0 &&
+                          dfMinY - 1 < nYSize && dfMaxY + 1 >= 0))
+                        continue;
+                    const auto ToTile = [](double dfVal, int nSize, int nTile)
+                    {
+                        return static_cast<int>(
+                                   std::clamp(dfVal, 0.0, nSize - 1.0)) /
+                               nTile;
+                    };
+                    const int nMinTileX =
+                        ToTile(dfMinX - 1, nXSize, nTileXSize);
+                    const int nMaxTileX =
+                        ToTile(dfMaxX + 1, nXSize, nTileXSize);
+                    const int nMinTileY =
+                        ToTile(dfMinY - 1, nYSize, nTileYSize);
+                    const int nMaxTileY =
+                        ToTile(dfMaxY + 1, nYSize, nTileYSize);
+                    for (int iTileY = nMinTileY; iTileY <= nMaxTileY; ++iTileY)
+                    {
+                        for (int iTileX = nMinTileX; iTileX <= nMaxTileX;
+                             ++iTileX)
+                        {
+                            aanBins[static_cast<size_t>(iTileY) * nXTiles +
+                                    iTileX]
+                                .push_back(iShape);
+                        }
+                    }
+                }
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in GDALRasterizeGeometries()");
+                bError = true;
+            }
+        };
+        if (!poQueue->SubmitJob(BinGeometries))
+            BinGeometries();
+    }
+    poQueue->WaitCompletion();
+    oErrorAccumulator.ReplayErrors();
+    if (bError)
+        return CE_Failure;
+
+    /* -------------------------------------------------------------------- */
+    /*      Burn the tiles. Each job takes the next tile to process until   */
+    /*      all are done.                                                   */
+    /* -------------------------------------------------------------------- */
+    std::mutex oIOMutex;
+    std::mutex oProgressMutex;
+    std::condition_variable oProgressCV;
+    std::atomic<int> nNextTile{0};
+    int nTilesDone = 0;
+    int nJobsDone = 0;
+
+    const auto BurnTile = [&](int iTile, void *pTransformArg)
+    {
+        size_t nGeoms = 0;
+        for (const auto &aanBins : aaanJobBins)
+            nGeoms += aanBins[iTile].size();
+        if (nGeoms == 0)
+            return;
+
+        const int nXOff = (iTile % nXTiles) * nTileXSize;
+        const int nYOff = (iTile / nXTiles) * nTileYSize;
+        const int nThisXSize = std::min(nTileXSize, nXSize - nXOff);
+        const int nThisYSize = std::min(nTileYSize, nYSize - nYOff);
+
+        std::vector<GByte> abyBuffer(nPixelSize * nThisXSize * nThisYSize);
+        {
+            std::lock_guard<std::mutex> oLock(oIOMutex);
+            if (poDS->RasterIO(GF_Read, nXOff, nYOff, nThisXSize, nThisYSize,
+                               abyBuffer.data(), nThisXSize, nThisYSize, eType,
+                               nBandCount, panBandList, 0, 0, 0,
+                               nullptr) != CE_None)
+            {
+                bError = true;
+                return;
+            }
+        }
+
+        for (const auto &aanBins : aaanJobBins)
+        {
+            for (int iShape : aanBins[iTile])
+            {
+                gv_rasterize_one_shape(
+                    abyBuffer.data(), nXOff, nYOff, nThisXSize, nThisYSize,
+                    nBandCount, eType, 0, 0, 0, bAllTouched,
+                    OGRGeometry::FromHandle(pahGeometries[iShape]),
+                    eBurnValueType,
+                    padfGeomBurnValues
+                        ? padfGeomBurnValues +
+                              static_cast<size_t>(iShape) * nBandCount
+                        : nullptr,
+                    panGeomBurnValues
+                        ? panGeomBurnValues +
+                              static_cast<size_t>(iShape) * nBandCount
+                        : nullptr,
+                    eBurnValueSource, eMergeAlg, pfnTransformer,
+                    pTransformArg);
+            }
+        }
+
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        if (poDS->RasterIO(GF_Write, nXOff, nYOff, nThisXSize, nThisYSize,
+                           abyBuffer.data(), nThisXSize, nThisYSize, eType,
+                           nBandCount, panBandList, 0, 0, 0,
+                           nullptr) != CE_None)
+        {
+            bError = true;
+        }
+    };
+
+    const auto BurnTiles = [&](int iJob)
+    {
+        auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+        CPL_IGNORE_RET_VAL(oAccumulator);
+        int iTile;
+        while (!bError && (iTile = nNextTile++) < nTiles)
+        {
+            try
+            {
+                BurnTile(iTile, apTransformArgs[iJob]);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in GDALRasterizeGeometries()");
+                bError = true;
+            }
+            std::lock_guard<std::mutex> oLock(oProgressMutex);
+            ++nTilesDone;
+            oProgressCV.notify_one();
+        }
+        std::lock_guard<std::mutex> oLock(oProgressMutex);
+        ++nJobsDone;
+        oProgressCV.notify_one();
+    };
+
+    pfnProgress(0.0, nullptr, pProgressArg);
+    for (int iJob = 0; iJob < nThreads; ++iJob)
+    {
+        if (!poQueue->SubmitJob([&BurnTiles, iJob]() { BurnTiles(iJob); }))
+            BurnTiles(iJob);
+    }
+    {
+        std::unique_lock<std::mutex> oLock(oProgressMutex);
+        int nLastTilesDone = 0;
+        while (nJobsDone < nThreads)
+        {
+            oProgressCV.wait(oLock,
+                             [&]() {
+                                 return nTilesDone != nLastTilesDone ||
+                                        nJobsDone == nThreads;
+                             });
+            nLastTilesDone = nTilesDone;
+            if (!bError &&
+                !pfnProgress(nLastTilesDone / static_cast<double>(nTiles), "",
+                             pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bError = true;
+            }
+        }
+    }
+    poQueue->WaitCompletion();
+    oErrorAccumulator.ReplayErrors();
+
+    return bError ? CE_Failure : CE_None;
+}
+
 /************************************************************************/
 /*                      GDALRasterizeGeometries()                       */
 /************************************************************************/
@@ -925,6 +1200,14 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * with tiled images to be efficient. The auto mode (the default) will chose
  * the algorithm based on input and output properties.
  * </li>
+ * <li>"NUM_THREADS": (GDAL >= 3.12) Number of worker threads, or ALL_CPUS.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * When more than one thread is used, the raster is split into tiles aligned
+ * on its blocks, geometries are binned into the tiles their envelope
+ * intersects, and tiles are burnt concurrently. Results are identical to the
+ * ones of the single-threaded algorithms. This requires pfnTransformer to be
+ * NULL or GDALGenImgProjTransform, and OPTIM and CHUNKYSIZE are then ignored.
+ * </li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1106,14 +1389,68 @@ static CPLErr GDALRasterizeGeometriesInternal(
         }
     }
 
+    int nXBlockSize, nYBlockSize;
+    poBand->GetBlockSize(&nXBlockSize, &nYBlockSize);
+
+    /* -------------------------------------------------------------------- */
+    /*      Multithreaded algorithm: burn tiles of about one million        */
+    /*      pixels, aligned on blocks, concurrently. The transformer is     */
+    /*      cloned for each thread, which is only possible with GDAL        */
+    /*      transformers.                                                   */
+    /* -------------------------------------------------------------------- */
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    if (nThreads > 1 && pfnTransformer == GDALGenImgProjTransform)
+    {
+        const int nTileXSize =
+            std::min(poDS->GetRasterXSize(),
+                     std::max(1, 1024 / nXBlockSize) * nXBlockSize);
+        const int nTileYSize = std::min(
+            poDS->GetRasterYSize(),
+            std::max(1, 1024 * 1024 / nTileXSize / nYBlockSize) * nYBlockSize);
+        if (nTileXSize < poDS->GetRasterXSize() ||
+            nTileYSize < poDS->GetRasterYSize())
+        {
+            std::vector<void *> apTransformArgs{pTransformArg};
+            for (int i = 1; i < nThreads; ++i)
+            {
+                void *pClonedTransformArg = GDALCloneTransformer(pTransformArg);
+                if (!pClonedTransformArg)
+                    break;
+                apTransformArgs.push_back(pClonedTransformArg);
+            }
+            CPLErr eErr = CE_Failure;
+            if (static_cast<int>(apTransformArgs.size()) == nThreads)
+            {
+                CPLDebug("GDAL",
+                         "Rasterizer operating on %d x %d tiles with %d "
+                         "threads.",
+                         nTileXSize, nTileYSize, nThreads);
+                eErr = GDALRasterizeGeometriesMultiThreaded(
+                    poDS, nBandCount, panBandList, nGeomCount, pahGeometries,
+                    pfnTransformer, apTransformArgs, eBurnValueType,
+                    padfGeomBurnValues, panGeomBurnValues, bAllTouched,
+                    eBurnValueSource, eMergeAlg, nTileXSize, nTileYSize,
+                    pfnProgress, pProgressArg);
+            }
+            for (size_t i = 1; i < apTransformArgs.size(); ++i)
+                GDALDestroyTransformer(apTransformArgs[i]);
+            if (bNeedToFreeTransformer)
+                GDALDestroyTransformer(pTransformArg);
+            return eErr;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Choice of optimisation in auto mode. Use vector optim :         */
     /*      1) if output is tiled                                           */
     /*      2) if large number of features is present (>10000)              */
     /*      3) if the nb of pixels > 50 * nb of features (not-too-small ft) */
     /* -------------------------------------------------------------------- */
-    int nXBlockSize, nYBlockSize;
-    poBand->GetBlockSize(&nXBlockSize, &nYBlockSize);
 
     if (eOptim == GRO_Auto)
     {
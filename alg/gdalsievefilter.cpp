@@ -17,16 +17,25 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <set>
 #include <vector>
 #include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 #define MY_MAX_INT 2147483647
 
@@ -125,6 +134,951 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+namespace
+{
+
+/************************************************************************/
+/*                            GDALSieveExit                             */
+/*                                                                      */
+/*      End of a chain of "biggest neighbours": the value of a          */
+/*      polygon at least as large as the threshold, a seam polygon      */
+/*      from which the chain must be followed further, or neither if    */
+/*      the chain cycles or reaches a polygon without neighbour.        */
+/************************************************************************/
+
+struct GDALSieveExit
+{
+    int nSeamId = -1;
+    bool bHasValue = false;
+    std::int64_t nValue = 0;
+};
+
+/************************************************************************/
+/*                         GDALSieveNeighbour                           */
+/*                                                                      */
+/*      Biggest neighbour of a polygon of a tile. Among neighbours of   */
+/*      the same size, the one met first in raster scan order is kept,  */
+/*      like CompareNeighbour() does. nKey identifies the contact: it   */
+/*      is 4 times the index of the pixel being scanned, plus the rank  */
+/*      of the comparison (up, up-left, up-right, left).                */
+/************************************************************************/
+
+struct GDALSieveNeighbour
+{
+    int nSize = -1;
+    int nId = -1;
+    GUIntBig nKey = 0;
+};
+
+/************************************************************************/
+/*                       GDALSieveSeamNeighbour                         */
+/*                                                                      */
+/*      Biggest neighbour of a seam polygon, over all its tiles. The    */
+/*      neighbour itself is replaced by the exit of its chain.          */
+/************************************************************************/
+
+struct GDALSieveSeamNeighbour
+{
+    int nSize = -1;
+    GUIntBig nKey = 0;
+    GDALSieveExit oExit{};
+};
+
+/************************************************************************/
+/*                             GDALSieveTile                            */
+/************************************************************************/
+
+struct GDALSieveTile
+{
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+
+    // Polygon ids of the tile touching an edge shared with another tile,
+    // sorted. The i-th one has the seam id nFirstSeamId + i.
+    std::vector<GInt32> anSeamPolyIds{};
+    int nFirstSeamId = 0;
+};
+
+/************************************************************************/
+/*                           GDALSieveTileData                          */
+/*                                                                      */
+/*      Polygons of a tile, enumerated independently of the other       */
+/*      tiles. As the enumeration is deterministic, each pass gets the  */
+/*      same polygon ids.                                               */
+/************************************************************************/
+
+struct GDALSieveTileData
+{
+    explicit GDALSieveTileData(int nConnectedness) : oEnum(nConnectedness)
+    {
+    }
+
+    GDALRasterPolygonEnumerator oEnum;
+    std::vector<std::int64_t> anValues{};
+    std::vector<std::int64_t> anWriteValues{};
+    std::vector<GInt32> anIds{};
+    std::vector<int> anSizes{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALSieveTileData)
+};
+}  // namespace
+
+/************************************************************************/
+/*                          GDALSieveIsBetter()                         */
+/************************************************************************/
+
+static inline bool GDALSieveIsBetter(int nSize, GUIntBig nKey, int nCurSize,
+                                     GUIntBig nCurKey)
+{
+    return nSize > nCurSize || (nSize == nCurSize && nKey < nCurKey);
+}
+
+/************************************************************************/
+/*                      GDALSieveReadAndLabelTile()                     */
+/************************************************************************/
+
+static bool GDALSieveReadAndLabelTile(GDALRasterBandH hSrcBand,
+                                      GDALRasterBandH hMaskBand,
+                                      const GDALSieveTile &oTile,
+                                      std::mutex &oIOMutex, bool bForWrite,
+                                      GDALSieveTileData &oData)
+{
+    const int nXSize = oTile.nXSize;
+    const size_t nPixels = static_cast<size_t>(nXSize) * oTile.nYSize;
+    oData.anValues.resize(nPixels);
+    std::vector<GByte> abyMask(hMaskBand ? nPixels : 0);
+    {
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        if (GDALRasterIO(hSrcBand, GF_Read, oTile.nXOff, oTile.nYOff, nXSize,
+                         oTile.nYSize, oData.anValues.data(), nXSize,
+                         oTile.nYSize, GDT_Int64, 0, 0) != CE_None ||
+            (hMaskBand &&
+             GDALRasterIO(hMaskBand, GF_Read, oTile.nXOff, oTile.nYOff,
+                          nXSize, oTile.nYSize, abyMask.data(), nXSize,
+                          oTile.nYSize, GDT_Byte, 0, 0) != CE_None))
+        {
+            return false;
+        }
+    }
+    if (bForWrite)
+        oData.anWriteValues = oData.anValues;
+    for (size_t i = 0; i < abyMask.size(); i++)
+    {
+        if (abyMask[i] == 0)
+            oData.anValues[i] = GP_NODATA_MARKER;
+    }
+
+    oData.anIds.resize(nPixels);
+    for (int iY = 0; iY < oTile.nYSize; iY++)
+    {
+        const size_t nOff = static_cast<size_t>(iY) * nXSize;
+        if (!oData.oEnum.ProcessLine(
+                iY == 0 ? nullptr : oData.anValues.data() + nOff - nXSize,
+                oData.anValues.data() + nOff,
+                iY == 0 ? nullptr : oData.anIds.data() + nOff - nXSize,
+                oData.anIds.data() + nOff, nXSize))
+        {
+            return false;
+        }
+    }
+    if (oData.oEnum.nNextPolygonId == 0)
+    {
+        oData.anSizes.clear();
+        return true;
+    }
+    oData.oEnum.CompleteMerges();
+
+    oData.anSizes.assign(oData.oEnum.nNextPolygonId, 0);
+    for (auto &nId : oData.anIds)
+    {
+        if (nId >= 0)
+        {
+            nId = oData.oEnum.panPolyIdMap[nId];
+            oData.anSizes[nId]++;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        GDALSieveTileSeamIds()                        */
+/*                                                                      */
+/*      Return the sorted ids of the polygons of the tile touching an   */
+/*      edge shared with another tile.                                  */
+/************************************************************************/
+
+static std::vector<GInt32> GDALSieveTileSeamIds(const GDALSieveTile &oTile,
+                                                const GDALSieveTileData &oData,
+                                                int nRasterXSize,
+                                                int nRasterYSize)
+{
+    std::vector<GInt32> anSeamIds;
+    const auto AddLine = [&](int iY)
+    {
+        const GInt32 *panIds =
+            oData.anIds.data() + static_cast<size_t>(iY) * oTile.nXSize;
+        for (int iX = 0; iX < oTile.nXSize; iX++)
+        {
+            if (panIds[iX] >= 0)
+                anSeamIds.push_back(panIds[iX]);
+        }
+    };
+    const auto AddColumn = [&](int iX)
+    {
+        for (int iY = 0; iY < oTile.nYSize; iY++)
+        {
+            const GInt32 nId =
+                oData.anIds[static_cast<size_t>(iY) * oTile.nXSize + iX];
+            if (nId >= 0)
+                anSeamIds.push_back(nId);
+        }
+    };
+    if (oTile.nYOff > 0)
+        AddLine(0);
+    if (oTile.nYOff + oTile.nYSize < nRasterYSize)
+        AddLine(oTile.nYSize - 1);
+    if (oTile.nXOff > 0)
+        AddColumn(0);
+    if (oTile.nXOff + oTile.nXSize < nRasterXSize)
+        AddColumn(oTile.nXSize - 1);
+    std::sort(anSeamIds.begin(), anSeamIds.end());
+    anSeamIds.erase(std::unique(anSeamIds.begin(), anSeamIds.end()),
+                    anSeamIds.end());
+    return anSeamIds;
+}
+
+/************************************************************************/
+/*                      GDALSieveTileNeighbours()                       */
+/*                                                                      */
+/*      Find the biggest neighbour of each polygon of the tile, among   */
+/*      the polygons of the tile. anSizes must hold the size of the     */
+/*      whole polygon for seam polygons.                                */
+/************************************************************************/
+
+static void
+GDALSieveTileNeighbours(const GDALSieveTile &oTile,
+                        const GDALSieveTileData &oData,
+                        const std::vector<int> &anSizes, int nRasterXSize,
+                        int nConnectedness,
+                        std::vector<GDALSieveNeighbour> &aoNeighbours)
+{
+    aoNeighbours.assign(anSizes.size(), GDALSieveNeighbour());
+
+    const auto Compare =
+        [&aoNeighbours, &anSizes](int nId1, int nId2, GUIntBig nKey)
+    {
+        if (nId1 < 0 || nId2 < 0 || nId1 == nId2)
+            return;
+        auto &oNeighbour1 = aoNeighbours[nId1];
+        if (oNeighbour1.nId < 0 ||
+            GDALSieveIsBetter(anSizes[nId2], nKey, oNeighbour1.nSize,
+                              oNeighbour1.nKey))
+        {
+            oNeighbour1.nSize = anSizes[nId2];
+            oNeighbour1.nId = nId2;
+            oNeighbour1.nKey = nKey;
+        }
+        auto &oNeighbour2 = aoNeighbours[nId2];
+        if (oNeighbour2.nId < 0 ||
+            GDALSieveIsBetter(anSizes[nId1], nKey, oNeighbour2.nSize,
+                              oNeighbour2.nKey))
+        {
+            oNeighbour2.nSize = anSizes[nId1];
+            oNeighbour2.nId = nId1;
+            oNeighbour2.nKey = nKey;
+        }
+    };
+
+    const int nXSize = oTile.nXSize;
+    for (int iY = 0; iY < oTile.nYSize; iY++)
+    {
+        const GInt32 *panThisLineId =
+            oData.anIds.data() + static_cast<size_t>(iY) * nXSize;
+        const GInt32 *panLastLineId =
+            iY > 0 ? panThisLineId - nXSize : nullptr;
+        const GUIntBig nLineKey =
+            (static_cast<GUIntBig>(oTile.nYOff + iY) * nRasterXSize +
+             oTile.nXOff) *
+            4;
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            const GUIntBig nKey = nLineKey + static_cast<GUIntBig>(iX) * 4;
+            if (iY > 0)
+            {
+                Compare(panThisLineId[iX], panLastLineId[iX], nKey);
+                if (iX > 0 && nConnectedness == 8)
+                    Compare(panThisLineId[iX], panLastLineId[iX - 1],
+                            nKey + 1);
+                if (iX < nXSize - 1 && nConnectedness == 8)
+                    Compare(panThisLineId[iX], panLastLineId[iX + 1],
+                            nKey + 2);
+            }
+            if (iX > 0)
+                Compare(panThisLineId[iX], panThisLineId[iX - 1], nKey + 3);
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALSieveFollowTileChain()                     */
+/*                                                                      */
+/*      Follow the biggest neighbours from polygon nId of a tile, until */
+/*      a polygon large enough, a seam polygon or a dead end. The exits */
+/*      of the visited polygons are memoized in aoExits.                */
+/************************************************************************/
+
+static GDALSieveExit GDALSieveFollowTileChain(
+    int nId, const GDALSieveTileData &oData, const std::vector<int> &anSizes,
+    const std::vector<GInt32> &anSeamRootOfPoly,
+    const std::vector<GDALSieveNeighbour> &aoNeighbours, int nSizeThreshold,
+    std::vector<GByte> &abyState, std::vector<GDALSieveExit> &aoExits)
+{
+    constexpr GByte STATE_IN_PROGRESS = 1;
+    constexpr GByte STATE_DONE = 2;
+
+    std::vector<int> anPath;
+    GDALSieveExit oExit;
+    while (true)
+    {
+        if (abyState[nId] == STATE_DONE)
+        {
+            oExit = aoExits[nId];
+            break;
+        }
+        if (abyState[nId] == STATE_IN_PROGRESS)
+            break;
+        if (anSizes[nId] >= nSizeThreshold)
+        {
+            oExit.bHasValue = true;
+            oExit.nValue = oData.oEnum.panPolyValue[nId];
+            break;
+        }
+        if (anSeamRootOfPoly[nId] >= 0)
+        {
+            oExit.nSeamId = anSeamRootOfPoly[nId];
+            break;
+        }
+        if (aoNeighbours[nId].nId < 0)
+            break;
+        abyState[nId] = STATE_IN_PROGRESS;
+        anPath.push_back(nId);
+        nId = aoNeighbours[nId].nId;
+    }
+
+    for (const int nPathId : anPath)
+    {
+        abyState[nPathId] = STATE_DONE;
+        aoExits[nPathId] = oExit;
+    }
+    return oExit;
+}
+
+/************************************************************************/
+/*                     GDALSieveFilterMultiThreaded()                   */
+/*                                                                      */
+/*      Same result as the line by line implementation, but polygons    */
+/*      are enumerated on tiles processed in parallel. Polygons         */
+/*      touching an edge shared by two tiles ("seam polygons") are      */
+/*      merged with a union-find over their ids, and they are the only  */
+/*      ones for which information is kept between the passes. Memory   */
+/*      use thus depends on the tile size and the number of seam        */
+/*      polygons, not on the raster size.                               */
+/*                                                                      */
+/*      1) Enumerate the polygons of each tile, and number its seam     */
+/*         polygons. After each batch of tile rows, merge the seam      */
+/*         polygons across the seams, and record the contacts between   */
+/*         different seam polygons.                                     */
+/*                                                                      */
+/*      2) Find the biggest neighbour of the polygons of each tile. For */
+/*         seam polygons, the best one over all their tiles and         */
+/*         contacts is kept, with the exit of its chain in the tile.    */
+/*         Then resolve the chains of the small seam polygons.          */
+/*                                                                      */
+/*      3) Find again the biggest neighbours of the polygons of each    */
+/*         tile, follow the chains of the small polygons, and write     */
+/*         the tile.                                                    */
+/************************************************************************/
+
+static CPLErr GDALSieveFilterMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+    GDALRasterBandH hDstBand, int nSizeThreshold, int nConnectedness,
+    int nTileSize, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+    const int nXTiles = (nXSize + nTileSize - 1) / nTileSize;
+    const int nYTiles = (nYSize + nTileSize - 1) / nTileSize;
+
+    std::vector<GDALSieveTile> aoTiles(static_cast<size_t>(nXTiles) *
+                                       nYTiles);
+    for (int iTileY = 0; iTileY < nYTiles; iTileY++)
+    {
+        for (int iTileX = 0; iTileX < nXTiles; iTileX++)
+        {
+            auto &oTile =
+                aoTiles[static_cast<size_t>(iTileY) * nXTiles + iTileX];
+            oTile.nXOff = iTileX * nTileSize;
+            oTile.nYOff = iTileY * nTileSize;
+            oTile.nXSize = std::min(nTileSize, nXSize - oTile.nXOff);
+            oTile.nYSize = std::min(nTileSize, nYSize - oTile.nYOff);
+        }
+    }
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    if (!poPool)
+        return CE_Failure;
+    auto poQueue = poPool->CreateJobQueue();
+
+    std::mutex oIOMutex;
+
+    /* -------------------------------------------------------------------- */
+    /*      Run ProcessTile() on tiles [iFirstTile, iEndTile) with the      */
+    /*      worker threads, and report progress from this thread.          */
+    /* -------------------------------------------------------------------- */
+    const auto RunTiles =
+        [&](int iFirstTile, int iEndTile,
+            const std::function<bool(GDALSieveTile &)> &ProcessTile,
+            double dfProgressStart, double dfProgressEnd)
+    {
+        CPLErrorAccumulator oErrorAccumulator;
+        std::mutex oProgressMutex;
+        std::condition_variable oProgressCV;
+        std::atomic<bool> bError{false};
+        std::atomic<int> nNextTile{iFirstTile};
+        const int nTiles = iEndTile - iFirstTile;
+        int nTilesDone = 0;
+        int nJobsDone = 0;
+
+        const auto ProcessTiles = [&]()
+        {
+            auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oAccumulator);
+            int iTile;
+            while (!bError && (iTile = nNextTile++) < iEndTile)
+            {
+                try
+                {
+                    if (!ProcessTile(aoTiles[iTile]))
+                        bError = true;
+                }
+                catch (const std::bad_alloc &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Out of memory in GDALSieveFilter()");
+                    bError = true;
+                }
+                std::lock_guard<std::mutex> oLock(oProgressMutex);
+                ++nTilesDone;
+                oProgressCV.notify_one();
+            }
+            std::lock_guard<std::mutex> oLock(oProgressMutex);
+            ++nJobsDone;
+            oProgressCV.notify_one();
+        };
+
+        const int nJobs = std::min(nThreads, nTiles);
+        for (int iJob = 0; iJob < nJobs; ++iJob)
+        {
+            if (!poQueue->SubmitJob(ProcessTiles))
+                ProcessTiles();
+        }
+
+        {
+            std::unique_lock<std::mutex> oLock(oProgressMutex);
+            int nLastTilesDone = 0;
+            while (nJobsDone < nJobs)
+            {
+                oProgressCV.wait(oLock,
+                                 [&]() {
+                                     return nTilesDone != nLastTilesDone ||
+                                            nJobsDone == nJobs;
+                                 });
+                nLastTilesDone = nTilesDone;
+                if (!bError &&
+                    !pfnProgress(dfProgressStart +
+                                     (dfProgressEnd - dfProgressStart) *
+                                         nLastTilesDone / nTiles,
+                                 "", pProgressArg))
+                {
+                    CPLError(CE_Failure, CPLE_UserInterrupt,
+                             "User terminated");
+                    bError = true;
+                }
+            }
+        }
+        poQueue->WaitCompletion();
+        oErrorAccumulator.ReplayErrors();
+        return !bError;
+    };
+
+    /* ==================================================================== */
+    /*      First pass: enumerate the polygons of the tiles, and merge the  */
+    /*      seam polygons across the seams.                                 */
+    /* ==================================================================== */
+    std::mutex oSeamMutex;
+    std::vector<int> anSeamSizes;
+    std::vector<std::int64_t> anSeamValues;
+    std::vector<int> anSeamParent;
+    // Smallest contact key between two different seam polygons.
+    std::map<std::pair<int, int>, GUIntBig> oMapContacts;
+
+    const auto FindRoot = [&anSeamParent](int nId)
+    {
+        while (anSeamParent[nId] != nId)
+        {
+            anSeamParent[nId] = anSeamParent[anSeamParent[nId]];
+            nId = anSeamParent[nId];
+        }
+        return nId;
+    };
+
+    const auto Link = [&](int nId1, int nId2, GUIntBig nKey)
+    {
+        if (nId1 < 0 || nId2 < 0)
+            return;
+        if (anSeamValues[nId1] == anSeamValues[nId2])
+        {
+            nId1 = FindRoot(nId1);
+            nId2 = FindRoot(nId2);
+            if (nId1 != nId2)
+                anSeamParent[std::max(nId1, nId2)] = std::min(nId1, nId2);
+        }
+        else
+        {
+            auto oIter =
+                oMapContacts
+                    .emplace(std::make_pair(std::min(nId1, nId2),
+                                            std::max(nId1, nId2)),
+                             nKey)
+                    .first;
+            oIter->second = std::min(oIter->second, nKey);
+        }
+    };
+
+    // Seam ids of the first and last lines of each tile row of the batch,
+    // and of the first and last columns of each tile of the batch.
+    // Processing tile rows by batches bounds the memory used by the seams.
+    const int nBatchTileRows =
+        std::max(1, std::min(nYTiles, (2 * nThreads + nXTiles - 1) / nXTiles));
+    std::vector<std::vector<GInt32>> aanTopLines(nBatchTileRows);
+    std::vector<std::vector<GInt32>> aanBottomLines(nBatchTileRows);
+    std::vector<std::vector<GInt32>> aanLeftColumns(
+        static_cast<size_t>(nBatchTileRows) * nXTiles);
+    std::vector<std::vector<GInt32>> aanRightColumns(
+        static_cast<size_t>(nBatchTileRows) * nXTiles);
+    std::vector<GInt32> anLastBottomLine;
+    int iBatchFirstTileRow = 0;
+
+    const auto EnumerateTile = [&](GDALSieveTile &oTile)
+    {
+        GDALSieveTileData oData(nConnectedness);
+        if (!GDALSieveReadAndLabelTile(hSrcBand, hMaskBand, oTile, oIOMutex,
+                                       false, oData))
+            return false;
+        oTile.anSeamPolyIds =
+            GDALSieveTileSeamIds(oTile, oData, nXSize, nYSize);
+        {
+            std::lock_guard<std::mutex> oLock(oSeamMutex);
+            if (anSeamSizes.size() + oTile.anSeamPolyIds.size() >
+                static_cast<size_t>(std::numeric_limits<int>::max()))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "GDALSieveFilter(): too many polygons");
+                return false;
+            }
+            oTile.nFirstSeamId = static_cast<int>(anSeamSizes.size());
+            for (const GInt32 nId : oTile.anSeamPolyIds)
+            {
+                anSeamParent.push_back(static_cast<int>(anSeamSizes.size()));
+                anSeamSizes.push_back(oData.anSizes[nId]);
+                anSeamValues.push_back(oData.oEnum.panPolyValue[nId]);
+            }
+        }
+
+        std::vector<GInt32> anSeamIdOfPoly(oData.anSizes.size(), -1);
+        for (size_t i = 0; i < oTile.anSeamPolyIds.size(); i++)
+            anSeamIdOfPoly[oTile.anSeamPolyIds[i]] =
+                oTile.nFirstSeamId + static_cast<int>(i);
+        const auto SeamId = [&](int iX, int iY)
+        {
+            const GInt32 nId =
+                oData.anIds[static_cast<size_t>(iY) * oTile.nXSize + iX];
+            return nId >= 0 ? anSeamIdOfPoly[nId] : -1;
+        };
+
+        const int iRow = oTile.nYOff / nTileSize - iBatchFirstTileRow;
+        const size_t iBatchTile =
+            static_cast<size_t>(iRow) * nXTiles + oTile.nXOff / nTileSize;
+        if (oTile.nYOff > 0)
+        {
+            for (int iX = 0; iX < oTile.nXSize; iX++)
+                aanTopLines[iRow][oTile.nXOff + iX] = SeamId(iX, 0);
+        }
+        if (oTile.nYOff + oTile.nYSize < nYSize)
+        {
+            for (int iX = 0; iX < oTile.nXSize; iX++)
+                aanBottomLines[iRow][oTile.nXOff + iX] =
+                    SeamId(iX, oTile.nYSize - 1);
+        }
+        if (oTile.nXOff > 0)
+        {
+            aanLeftColumns[iBatchTile].resize(oTile.nYSize);
+            for (int iY = 0; iY < oTile.nYSize; iY++)
+                aanLeftColumns[iBatchTile][iY] = SeamId(0, iY);
+        }
+        if (oTile.nXOff + oTile.nXSize < nXSize)
+        {
+            aanRightColumns[iBatchTile].resize(oTile.nYSize);
+            for (int iY = 0; iY < oTile.nYSize; iY++)
+                aanRightColumns[iBatchTile][iY] =
+                    SeamId(oTile.nXSize - 1, iY);
+        }
+        return true;
+    };
+
+    for (; iBatchFirstTileRow < nYTiles; iBatchFirstTileRow += nBatchTileRows)
+    {
+        const int nRows =
+            std::min(nBatchTileRows, nYTiles - iBatchFirstTileRow);
+        for (int iRow = 0; iRow < nRows; iRow++)
+        {
+            aanTopLines[iRow].assign(nXSize, -1);
+            aanBottomLines[iRow].assign(nXSize, -1);
+        }
+
+        if (!RunTiles(iBatchFirstTileRow * nXTiles,
+                      (iBatchFirstTileRow + nRows) * nXTiles, EnumerateTile,
+                      0.25 * iBatchFirstTileRow / nYTiles,
+                      0.25 * (iBatchFirstTileRow + nRows) / nYTiles))
+        {
+            return CE_Failure;
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Link the seam polygons on both sides of the seams, in the   */
+        /*      order CompareNeighbour() would see them.                    */
+        /* ---------------------------------------------------------------- */
+        for (int iRow = 0; iRow < nRows; iRow++)
+        {
+            const int nY0 = (iBatchFirstTileRow + iRow) * nTileSize;
+            if (nY0 > 0)
+            {
+                const GInt32 *panUp = iRow == 0
+                                          ? anLastBottomLine.data()
+                                          : aanBottomLines[iRow - 1].data();
+                const GInt32 *panDown = aanTopLines[iRow].data();
+                for (int iX = 0; iX < nXSize; iX++)
+                {
+                    const GUIntBig nKey =
+                        (static_cast<GUIntBig>(nY0) * nXSize + iX) * 4;
+                    Link(panDown[iX], panUp[iX], nKey);
+                    if (iX > 0 && nConnectedness == 8)
+                        Link(panDown[iX], panUp[iX - 1], nKey + 1);
+                    if (iX < nXSize - 1 && nConnectedness == 8)
+                        Link(panDown[iX], panUp[iX + 1], nKey + 2);
+                }
+            }
+
+            const int nTileYSize = std::min(nTileSize, nYSize - nY0);
+            for (int iTileX = 1; iTileX < nXTiles; iTileX++)
+            {
+                const size_t iBatchTile =
+                    static_cast<size_t>(iRow) * nXTiles + iTileX;
+                const GInt32 *panLeft =
+                    aanRightColumns[iBatchTile - 1].data();
+                const GInt32 *panRight = aanLeftColumns[iBatchTile].data();
+                const int nX0 = iTileX * nTileSize;
+                for (int iY = 0; iY < nTileYSize; iY++)
+                {
+                    const GUIntBig nKey =
+                        (static_cast<GUIntBig>(nY0 + iY) * nXSize + nX0) * 4;
+                    if (iY > 0 && nConnectedness == 8)
+                    {
+                        Link(panLeft[iY], panRight[iY - 1], nKey - 4 + 2);
+                        Link(panRight[iY], panLeft[iY - 1], nKey + 1);
+                    }
+                    Link(panRight[iY], panLeft[iY], nKey + 3);
+                }
+            }
+        }
+        anLastBottomLine = std::move(aanBottomLines[nRows - 1]);
+        for (auto &anColumn : aanLeftColumns)
+            anColumn.clear();
+        for (auto &anColumn : aanRightColumns)
+            anColumn.clear();
+    }
+    aanTopLines.clear();
+    aanBottomLines.clear();
+    anLastBottomLine.clear();
+
+    /* -------------------------------------------------------------------- */
+    /*      Accumulate the sizes of the seam polygons on their root, and    */
+    /*      flatten the union-find.                                         */
+    /* -------------------------------------------------------------------- */
+    const int nSeamIds = static_cast<int>(anSeamSizes.size());
+    std::vector<GInt32> anSeamRoot(nSeamIds);
+    {
+        std::vector<int> anRootSizes(nSeamIds);
+        for (int nId = 0; nId < nSeamIds; nId++)
+        {
+            const int nRoot = FindRoot(nId);
+            anSeamRoot[nId] = nRoot;
+            anRootSizes[nRoot] = static_cast<int>(
+                std::min<GIntBig>(MY_MAX_INT, static_cast<GIntBig>(
+                                                  anRootSizes[nRoot]) +
+                                                  anSeamSizes[nId]));
+        }
+        anSeamSizes = std::move(anRootSizes);
+        anSeamParent.clear();
+        anSeamParent.shrink_to_fit();
+    }
+
+    std::vector<GDALSieveSeamNeighbour> aoSeamNeighbours(nSeamIds);
+    const auto UpdateSeamNeighbour =
+        [&aoSeamNeighbours](int nRoot, int nSize, GUIntBig nKey,
+                            const GDALSieveExit &oExit)
+    {
+        auto &oNeighbour = aoSeamNeighbours[nRoot];
+        if (oNeighbour.nSize < 0 ||
+            GDALSieveIsBetter(nSize, nKey, oNeighbour.nSize, oNeighbour.nKey))
+        {
+            oNeighbour.nSize = nSize;
+            oNeighbour.nKey = nKey;
+            oNeighbour.oExit = oExit;
+        }
+    };
+
+    for (const auto &oContact : oMapContacts)
+    {
+        const int nRoot1 = anSeamRoot[oContact.first.first];
+        const int nRoot2 = anSeamRoot[oContact.first.second];
+        GDALSieveExit oExit;
+        oExit.nSeamId = nRoot2;
+        UpdateSeamNeighbour(nRoot1, anSeamSizes[nRoot2], oContact.second,
+                            oExit);
+        oExit.nSeamId = nRoot1;
+        UpdateSeamNeighbour(nRoot2, anSeamSizes[nRoot1], oContact.second,
+                            oExit);
+    }
+    oMapContacts.clear();
+
+    /* -------------------------------------------------------------------- */
+    /*      Label a tile again, with the root seam id and whole size of     */
+    /*      its seam polygons, and find the biggest neighbours.             */
+    /* -------------------------------------------------------------------- */
+    const auto PrepareTile =
+        [&](const GDALSieveTile &oTile, bool bForWrite,
+            GDALSieveTileData &oData, std::vector<GInt32> &anSeamRootOfPoly,
+            std::vector<GDALSieveNeighbour> &aoNeighbours)
+    {
+        if (!GDALSieveReadAndLabelTile(hSrcBand, hMaskBand, oTile, oIOMutex,
+                                       bForWrite, oData))
+            return false;
+        anSeamRootOfPoly.assign(oData.anSizes.size(), -1);
+        for (size_t i = 0; i < oTile.anSeamPolyIds.size(); i++)
+        {
+            const GInt32 nId = oTile.anSeamPolyIds[i];
+            const int nRoot =
+                anSeamRoot[oTile.nFirstSeamId + static_cast<int>(i)];
+            anSeamRootOfPoly[nId] = nRoot;
+            oData.anSizes[nId] = anSeamSizes[nRoot];
+        }
+        GDALSieveTileNeighbours(oTile, oData, oData.anSizes, nXSize,
+                                nConnectedness, aoNeighbours);
+        return true;
+    };
+
+    /* ==================================================================== */
+    /*      Second pass: biggest neighbour of the seam polygons.            */
+    /* ==================================================================== */
+    const auto FindSeamNeighbours = [&](GDALSieveTile &oTile)
+    {
+        GDALSieveTileData oData(nConnectedness);
+        std::vector<GInt32> anSeamRootOfPoly;
+        std::vector<GDALSieveNeighbour> aoNeighbours;
+        if (!PrepareTile(oTile, false, oData, anSeamRootOfPoly, aoNeighbours))
+            return false;
+
+        std::vector<GByte> abyState(oData.anSizes.size());
+        std::vector<GDALSieveExit> aoExits(oData.anSizes.size());
+        std::vector<std::pair<int, GDALSieveNeighbour>> aoPendingSeamNeighbours;
+        std::vector<GDALSieveExit> aoSeamExits;
+        for (const GInt32 nId : oTile.anSeamPolyIds)
+        {
+            const auto &oNeighbour = aoNeighbours[nId];
+            if (oNeighbour.nId < 0)
+                continue;
+            aoPendingSeamNeighbours.emplace_back(anSeamRootOfPoly[nId],
+                                                 oNeighbour);
+            aoSeamExits.push_back(GDALSieveFollowTileChain(
+                oNeighbour.nId, oData, oData.anSizes, anSeamRootOfPoly,
+                aoNeighbours, nSizeThreshold, abyState, aoExits));
+        }
+
+        std::lock_guard<std::mutex> oLock(oSeamMutex);
+        for (size_t i = 0; i < aoPendingSeamNeighbours.size(); i++)
+        {
+            UpdateSeamNeighbour(aoPendingSeamNeighbours[i].first,
+                                aoPendingSeamNeighbours[i].second.nSize,
+                                aoPendingSeamNeighbours[i].second.nKey,
+                                aoSeamExits[i]);
+        }
+        return true;
+    };
+
+    if (!RunTiles(0, static_cast<int>(aoTiles.size()), FindSeamNeighbours,
+                  0.25, 0.5))
+    {
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Resolve the chains of the small seam polygons. All polygons of  */
+    /*      a chain share its outcome.                                      */
+    /* -------------------------------------------------------------------- */
+    std::vector<GDALSieveExit> aoSeamResults(nSeamIds);
+    std::atomic<int> nSieveTargets{0};
+    std::atomic<int> nIsolatedSmall{0};
+    std::atomic<int> nFailedMerges{0};
+    {
+        constexpr GByte STATE_IN_PROGRESS = 1;
+        constexpr GByte STATE_DONE = 2;
+        std::vector<GByte> abyState(nSeamIds);
+        std::vector<int> anPath;
+        for (int nRoot = 0; nRoot < nSeamIds; nRoot++)
+        {
+            if (anSeamRoot[nRoot] != nRoot ||
+                anSeamSizes[nRoot] >= nSizeThreshold)
+                continue;
+
+            nSieveTargets++;
+            if (aoSeamNeighbours[nRoot].nSize < 0)
+            {
+                nIsolatedSmall++;
+                continue;
+            }
+
+            if (abyState[nRoot] != STATE_DONE)
+            {
+                anPath.clear();
+                int nCur = nRoot;
+                GDALSieveExit oExit;
+                while (true)
+                {
+                    abyState[nCur] = STATE_IN_PROGRESS;
+                    anPath.push_back(nCur);
+                    oExit = aoSeamNeighbours[nCur].oExit;
+                    if (oExit.bHasValue || oExit.nSeamId < 0)
+                        break;
+                    nCur = oExit.nSeamId;
+                    oExit = GDALSieveExit();
+                    if (anSeamSizes[nCur] >= nSizeThreshold)
+                    {
+                        oExit.bHasValue = true;
+                        oExit.nValue = anSeamValues[nCur];
+                        break;
+                    }
+                    if (abyState[nCur] == STATE_DONE)
+                    {
+                        oExit = aoSeamResults[nCur];
+                        break;
+                    }
+                    if (abyState[nCur] == STATE_IN_PROGRESS ||
+                        aoSeamNeighbours[nCur].nSize < 0)
+                    {
+                        break;
+                    }
+                }
+                oExit.nSeamId = -1;
+                for (const int nPathId : anPath)
+                {
+                    abyState[nPathId] = STATE_DONE;
+                    aoSeamResults[nPathId] = oExit;
+                }
+            }
+
+            if (!aoSeamResults[nRoot].bHasValue)
+                nFailedMerges++;
+        }
+    }
+    aoSeamNeighbours.clear();
+    aoSeamNeighbours.shrink_to_fit();
+
+    /* ==================================================================== */
+    /*      Third pass: apply the merges.                                   */
+    /* ==================================================================== */
+    const auto SieveTile = [&](GDALSieveTile &oTile)
+    {
+        GDALSieveTileData oData(nConnectedness);
+        std::vector<GInt32> anSeamRootOfPoly;
+        std::vector<GDALSieveNeighbour> aoNeighbours;
+        if (!PrepareTile(oTile, true, oData, anSeamRootOfPoly, aoNeighbours))
+            return false;
+
+        const int nPolys = static_cast<int>(oData.anSizes.size());
+        std::vector<GByte> abyState(nPolys);
+        std::vector<GDALSieveExit> aoExits(nPolys);
+        std::vector<GDALSieveExit> aoResults(nPolys);
+        for (int nId = 0; nId < nPolys; nId++)
+        {
+            if (oData.oEnum.panPolyIdMap[nId] != nId)
+                continue;
+            if (anSeamRootOfPoly[nId] >= 0)
+            {
+                aoResults[nId] = aoSeamResults[anSeamRootOfPoly[nId]];
+                continue;
+            }
+            if (oData.anSizes[nId] >= nSizeThreshold)
+                continue;
+
+            nSieveTargets++;
+            if (aoNeighbours[nId].nId < 0)
+            {
+                nIsolatedSmall++;
+                continue;
+            }
+
+            GDALSieveExit oExit = GDALSieveFollowTileChain(
+                aoNeighbours[nId].nId, oData, oData.anSizes, anSeamRootOfPoly,
+                aoNeighbours, nSizeThreshold, abyState, aoExits);
+            if (!oExit.bHasValue && oExit.nSeamId >= 0)
+                oExit = aoSeamResults[oExit.nSeamId];
+            if (oExit.bHasValue)
+                aoResults[nId] = oExit;
+            else
+                nFailedMerges++;
+        }
+
+        for (size_t i = 0; i < oData.anIds.size(); i++)
+        {
+            const GInt32 nId = oData.anIds[i];
+            if (nId >= 0 && aoResults[nId].bHasValue)
+                oData.anWriteValues[i] = aoResults[nId].nValue;
+        }
+
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        return GDALRasterIO(hDstBand, GF_Write, oTile.nXOff, oTile.nYOff,
+                            oTile.nXSize, oTile.nYSize,
+                            oData.anWriteValues.data(), oTile.nXSize,
+                            oTile.nYSize, GDT_Int64, 0, 0) == CE_None;
+    };
+
+    if (!RunTiles(0, static_cast<int>(aoTiles.size()), SieveTile, 0.5, 1.0))
+    {
+        return CE_Failure;
+    }
+
+    CPLDebug("GDALSieveFilter",
+             "Small Polygons: %d, Isolated: %d, Unmergable: %d",
+             nSieveTargets.load(), nIsolatedSmall.load(),
+             nFailedMerges.load());
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -156,6 +1110,12 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * extremely noisy rasters with many one pixel polygons will end up being
  * expensive (in memory) to process.
  *
+ * When more than one thread is used (see the NUM_THREADS option), polygons
+ * are enumerated on tiles processed in parallel, and only the polygons
+ * crossing tile boundaries are tracked for the whole raster. Memory use then
+ * depends on the tile size and on the number of such polygons.  The result is
+ * identical to the single-threaded one.
+ *
  * @param hSrcBand the source raster band to be processed.
  * @param hMaskBand an optional mask band.  All pixels in the mask band with a
  * value other than zero will be considered suitable for inclusion in polygons.
@@ -166,8 +1126,13 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.
+ * The following options are supported:
+ * <ul>
+ * <li>NUM_THREADS=num|ALL_CPUS (GDAL >= 3.12). Number of worker threads.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * </li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -179,7 +1144,7 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
                                    GDALRasterBandH hMaskBand,
                                    GDALRasterBandH hDstBand, int nSizeThreshold,
                                    int nConnectedness,
-                                   CPL_UNUSED char **papszOptions,
+                                   char **papszOptions,
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressArg)
 {
@@ -189,11 +1154,38 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
+    int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Use the tiled multithreaded implementation if requested, and if */
+    /*      the raster is larger than a tile.                               */
+    /* -------------------------------------------------------------------- */
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    if (nThreads > 1)
+    {
+        int nTileSize = 512;
+        // For testing purposes
+        const char *pszTileSize =
+            CPLGetConfigOption("GDAL_SIEVE_TILE_SIZE", nullptr);
+        if (pszTileSize)
+            nTileSize = std::max(1, std::min(16384, atoi(pszTileSize)));
+        if (nTileSize < nXSize || nTileSize < nYSize)
+        {
+            return GDALSieveFilterMultiThreaded(
+                hSrcBand, hMaskBand, hDstBand, nSizeThreshold, nConnectedness,
+                nTileSize, nThreads, pfnProgress, pProgressArg);
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
-    int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    int nYSize = GDALGetRasterBandYSize(hSrcBand);
     auto panLastLineValKeeper = std::unique_ptr<std::int64_t, VSIFreeReleaser>(
         static_cast<std::int64_t *>(
             VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize)));
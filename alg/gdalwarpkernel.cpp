@@ -24,8 +24,12 @@
 
 #include <algorithm>
 #include <limits>
+#include <list>
+#include <map>
 #include <mutex>
 #include <new>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -45,6 +49,11 @@
 #include "gdal_alg_priv.h"
 #include "gdal_thread_pool.h"
 #include "gdalresamplingkernels.h"
+#include "gdalwarpkernel_avx2.h"
+
+#ifdef HAVE_GWK_AVX2
+#include "cpl_cpu_features.h"
+#endif
 
 // #define CHECK_SUM_WITH_GEOS
 #ifdef CHECK_SUM_WITH_GEOS
@@ -236,8 +245,249 @@ struct GWKThreadData
     std::map<GIntBig, void *> mapThreadToTransformerArg{};
     int nTotalThreadCountForThisRun = 0;
     int nCurThreadCountForThisRun = 0;
+
+    // Identifier of the transformer in the transform cache, or -1 if
+    // GDAL_WARP_TRANSFORM_CACHE_MAX is not set.
+    int nTransformCacheId = -1;
+    // Statistics of the transform cache. Protected by its mutex.
+    int nTransformCacheHits = 0;
+    int nTransformCacheMisses = 0;
+};
+
+/************************************************************************/
+/*                         GWKTransformCache                            */
+/************************************************************************/
+
+// Process-wide cache of the source coordinates computed by the kernels for
+// each destination row. Transformers are identified by their serialized XML,
+// so that the coordinates are reused by all the warp operations sharing the
+// same source and destination georeferencing (e.g. rasters of a time series),
+// and not only by the chunks of a single operation.
+
+namespace
+{
+struct GWKTransformCacheRow
+{
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+    std::vector<double> adfZ{};
+    std::vector<int> abSuccess{};
+};
+
+// Transformer identifier, X and Y of the first point, number of points.
+using GWKTransformCacheKey = std::tuple<int, double, double, int>;
+
+struct GWKTransformCacheSignature
+{
+    int nId = 0;
+    // Number of rows of oMapRows with that identifier.
+    int nRowCount = 0;
+};
+
+struct GWKTransformCache
+{
+    std::mutex mutex{};
+    GIntBig nMaxSize = 0;
+    // Size of the cached rows and of the signatures of their transformers.
+    GIntBig nCurSize = 0;
+    // Identifiers are never reused, so that rows cached by a warp operation
+    // whose signature has been evicted in the meantime cannot be returned
+    // to another one.
+    int nNextId = 0;
+    std::map<std::string, GWKTransformCacheSignature> oMapSignatureToId{};
+    std::map<int, std::map<std::string, GWKTransformCacheSignature>::iterator>
+        oMapIdToSignature{};
+    // Most recently used rows first.
+    std::list<GWKTransformCacheKey> oLRUList{};
+    std::map<GWKTransformCacheKey,
+             std::pair<GWKTransformCacheRow,
+                       std::list<GWKTransformCacheKey>::iterator>>
+        oMapRows{};
+
+    void EvictIfNeeded()
+    {
+        while (nCurSize > nMaxSize && !oLRUList.empty())
+        {
+            auto oIter = oMapRows.find(oLRUList.back());
+            nCurSize -= GetRowSize(oIter->second.first);
+            const int nId = std::get<0>(oIter->first);
+            oMapRows.erase(oIter);
+            oLRUList.pop_back();
+
+            // Evict the signature together with its last row
+            const auto oIterId = oMapIdToSignature.find(nId);
+            if (oIterId != oMapIdToSignature.end() &&
+                --oIterId->second->second.nRowCount == 0)
+            {
+                EvictSignature(oIterId);
+            }
+        }
+    }
+
+    // Evict signatures without cached rows, which may have been
+    // registered by warp operations that did not cache anything.
+    void EvictUnusedSignatures()
+    {
+        for (auto oIter = oMapIdToSignature.begin();
+             oIter != oMapIdToSignature.end();)
+        {
+            if (oIter->second->second.nRowCount == 0)
+                oIter = EvictSignature(oIter);
+            else
+                ++oIter;
+        }
+    }
+
+    decltype(oMapIdToSignature)::iterator
+    EvictSignature(decltype(oMapIdToSignature)::iterator oIterId)
+    {
+        nCurSize -= GetSignatureSize(oIterId->second->first);
+        oMapSignatureToId.erase(oIterId->second);
+        return oMapIdToSignature.erase(oIterId);
+    }
+
+    void AddRow(int nId)
+    {
+        const auto oIterId = oMapIdToSignature.find(nId);
+        if (oIterId != oMapIdToSignature.end())
+            ++oIterId->second->second.nRowCount;
+    }
+
+    static GIntBig GetRowSize(const GWKTransformCacheRow &oRow)
+    {
+        return static_cast<GIntBig>(oRow.adfX.size()) *
+               (3 * sizeof(double) + sizeof(int));
+    }
+
+    static GIntBig GetSignatureSize(const std::string &osSignature)
+    {
+        return static_cast<GIntBig>(osSignature.size()) +
+               sizeof(GWKTransformCacheSignature);
+    }
 };
 
+GWKTransformCache &GWKGetTransformCache()
+{
+    static GWKTransformCache oCache;
+    return oCache;
+}
+}  // namespace
+
+/************************************************************************/
+/*                      GWKTransformCacheGetId()                        */
+/************************************************************************/
+
+// Return the identifier of the transformer in the transform cache, or -1
+// if the transformer cannot be serialized.
+static int GWKTransformCacheGetId(GDALTransformerFunc pfnTransformer,
+                                  void *pTransformerArg, GIntBig nMaxSize)
+{
+    if (pfnTransformer == nullptr || pTransformerArg == nullptr)
+        return -1;
+
+    // Transformers that cannot be serialized are just not cached
+    CPLXMLNode *psTree;
+    {
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        psTree = GDALSerializeTransformer(pfnTransformer, pTransformerArg);
+    }
+    if (psTree == nullptr)
+        return -1;
+    char *pszSignature = CPLSerializeXMLTree(psTree);
+    CPLDestroyXMLNode(psTree);
+    if (pszSignature == nullptr)
+        return -1;
+    const std::string osSignature(pszSignature);
+    CPLFree(pszSignature);
+
+    auto &oCache = GWKGetTransformCache();
+    std::lock_guard<std::mutex> oLock(oCache.mutex);
+    oCache.nMaxSize = nMaxSize;
+    oCache.EvictIfNeeded();
+    const auto oIter = oCache.oMapSignatureToId.find(osSignature);
+    if (oIter != oCache.oMapSignatureToId.end())
+        return oIter->second.nId;
+
+    oCache.EvictUnusedSignatures();
+    const GIntBig nSignatureSize =
+        GWKTransformCache::GetSignatureSize(osSignature);
+    if (nSignatureSize > nMaxSize || oCache.nNextId == INT_MAX)
+        return -1;
+    GWKTransformCacheSignature sSignature;
+    sSignature.nId = oCache.nNextId++;
+    const auto oIterNew =
+        oCache.oMapSignatureToId.emplace(osSignature, sSignature).first;
+    oCache.oMapIdToSignature[sSignature.nId] = oIterNew;
+    oCache.nCurSize += nSignatureSize;
+    oCache.EvictIfNeeded();
+    return sSignature.nId;
+}
+
+/************************************************************************/
+/*                        GWKTransformDstRow()                          */
+/************************************************************************/
+
+// Transform nDstXSize destination points of the same row, at regularly
+// spaced columns, from destination to source pixel/line coordinates,
+// using the transform cache when enabled.
+static void GWKTransformDstRow(const GWKJobStruct *psJob, int nDstXSize,
+                               double *padfX, double *padfY, double *padfZ,
+                               int *pabSuccess)
+{
+    const GDALWarpKernel *poWK = psJob->poWK;
+    GWKThreadData *psThreadData =
+        static_cast<GWKThreadData *>(poWK->psThreadData);
+    if (psThreadData == nullptr || psThreadData->nTransformCacheId < 0 ||
+        nDstXSize == 0)
+    {
+        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
+                             padfY, padfZ, pabSuccess);
+        return;
+    }
+
+    const GWKTransformCacheKey oKey(psThreadData->nTransformCacheId,
+                                    padfX[0], padfY[0], nDstXSize);
+    auto &oCache = GWKGetTransformCache();
+    {
+        std::lock_guard<std::mutex> oLock(oCache.mutex);
+        const auto oIter = oCache.oMapRows.find(oKey);
+        if (oIter != oCache.oMapRows.end())
+        {
+            const GWKTransformCacheRow &oRow = oIter->second.first;
+            memcpy(padfX, oRow.adfX.data(), nDstXSize * sizeof(double));
+            memcpy(padfY, oRow.adfY.data(), nDstXSize * sizeof(double));
+            memcpy(padfZ, oRow.adfZ.data(), nDstXSize * sizeof(double));
+            memcpy(pabSuccess, oRow.abSuccess.data(), nDstXSize * sizeof(int));
+            oCache.oLRUList.splice(oCache.oLRUList.begin(), oCache.oLRUList,
+                                   oIter->second.second);
+            ++psThreadData->nTransformCacheHits;
+            return;
+        }
+    }
+
+    poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
+                         padfY, padfZ, pabSuccess);
+
+    GWKTransformCacheRow oRow;
+    oRow.adfX.assign(padfX, padfX + nDstXSize);
+    oRow.adfY.assign(padfY, padfY + nDstXSize);
+    oRow.adfZ.assign(padfZ, padfZ + nDstXSize);
+    oRow.abSuccess.assign(pabSuccess, pabSuccess + nDstXSize);
+    const GIntBig nRowSize = GWKTransformCache::GetRowSize(oRow);
+
+    std::lock_guard<std::mutex> oLock(oCache.mutex);
+    ++psThreadData->nTransformCacheMisses;
+    if (nRowSize > oCache.nMaxSize ||
+        oCache.oMapRows.find(oKey) != oCache.oMapRows.end())
+        return;
+    oCache.oLRUList.push_front(oKey);
+    oCache.oMapRows.emplace(
+        oKey, std::make_pair(std::move(oRow), oCache.oLRUList.begin()));
+    oCache.AddRow(psThreadData->nTransformCacheId);
+    oCache.nCurSize += nRowSize;
+    oCache.EvictIfNeeded();
+}
+
 /************************************************************************/
 /*                        GWKProgressThread()                           */
 /************************************************************************/
@@ -305,7 +555,7 @@ static CPLErr GWKGenericMonoThread(GDALWarpKernel *poWK,
 /************************************************************************/
 
 void *GWKThreadsCreate(char **papszWarpOptions,
-                       GDALTransformerFunc /* pfnTransformer */,
+                       GDALTransformerFunc pfnTransformer,
                        void *pTransformerArg)
 {
     const char *pszWarpThreads =
@@ -338,6 +588,32 @@ void *GWKThreadsCreate(char **papszWarpOptions,
         psThreadData->pTransformerArgInput = pTransformerArg;
     }
 
+    const char *pszTransformCacheMax =
+        CPLGetConfigOption("GDAL_WARP_TRANSFORM_CACHE_MAX", nullptr);
+    if (pszTransformCacheMax)
+    {
+        GIntBig nTransformCacheMax = 0;
+        bool bUnitSpecified = false;
+        if (CPLParseMemorySize(pszTransformCacheMax, &nTransformCacheMax,
+                               &bUnitSpecified) != CE_None)
+        {
+            CPLError(CE_Warning, CPLE_IllegalArg,
+                     "Invalid value for GDAL_WARP_TRANSFORM_CACHE_MAX: %s",
+                     pszTransformCacheMax);
+        }
+        else
+        {
+            // Megabytes by default
+            if (!bUnitSpecified)
+                nTransformCacheMax *= 1024 * 1024;
+            if (nTransformCacheMax > 0)
+            {
+                psThreadData->nTransformCacheId = GWKTransformCacheGetId(
+                    pfnTransformer, pTransformerArg, nTransformCacheMax);
+            }
+        }
+    }
+
     return psThreadData;
 }
 
@@ -351,6 +627,12 @@ void GWKThreadsEnd(void *psThreadDataIn)
         return;
 
     GWKThreadData *psThreadData = static_cast<GWKThreadData *>(psThreadDataIn);
+    if (psThreadData->nTransformCacheId >= 0)
+    {
+        CPLDebug("WARP", "Transform cache: %d rows reused, %d rows computed",
+                 psThreadData->nTransformCacheHits,
+                 psThreadData->nTransformCacheMisses);
+    }
     if (psThreadData->poJobQueue)
     {
         // cppcheck-suppress constVariableReference
@@ -3049,6 +3331,63 @@ static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
     return true;
 }
 
+#ifdef HAVE_GWK_AVX2
+
+/************************************************************************/
+/*                    GWKCubicResample4SampleAVX2()                     */
+/************************************************************************/
+
+// Same as GWKCubicResample4Sample() for non-complex data types, with the
+// horizontal pass done on the 4 rows at once.
+static bool GWKCubicResample4SampleAVX2(const GDALWarpKernel *poWK, int iBand,
+                                        double dfSrcX, double dfSrcY,
+                                        double *pdfDensity, double *pdfReal)
+
+{
+    const int iSrcX = static_cast<int>(dfSrcX - 0.5);
+    const int iSrcY = static_cast<int>(dfSrcY - 0.5);
+    const GPtrDiff_t iSrcOffset =
+        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * poWK->nSrcXSize;
+    const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
+    const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
+    double dfValueImagIgnored = 0.0;
+
+    // Get the bilinear interpolation at the image borders.
+    if (iSrcX - 1 < 0 || iSrcX + 2 >= poWK->nSrcXSize || iSrcY - 1 < 0 ||
+        iSrcY + 2 >= poWK->nSrcYSize)
+        return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
+                                          pdfDensity, pdfReal,
+                                          &dfValueImagIgnored);
+
+    double adfCoeffsX[4] = {};
+    GWKCubicComputeWeights(dfDeltaX, adfCoeffsX);
+
+    double adfValueDens[4] = {};
+    double adfValueReal[4] = {};
+    if (!GWKCubicConvolveRows4x4AVX2(
+            poWK->eWorkingDataType, poWK->papabySrcImage[iBand],
+            poWK->panUnifiedSrcValid,
+            poWK->papanBandSrcValid ? poWK->papanBandSrcValid[iBand] : nullptr,
+            poWK->pafUnifiedSrcDensity, SRC_DENSITY_THRESHOLD,
+            iSrcOffset - poWK->nSrcXSize - 1, poWK->nSrcXSize, adfCoeffsX,
+            adfValueReal, adfValueDens))
+    {
+        return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
+                                          pdfDensity, pdfReal,
+                                          &dfValueImagIgnored);
+    }
+
+    double adfCoeffsY[4] = {};
+    GWKCubicComputeWeights(dfDeltaY, adfCoeffsY);
+
+    *pdfDensity = CONVOL4(adfCoeffsY, adfValueDens);
+    *pdfReal = CONVOL4(adfCoeffsY, adfValueReal);
+
+    return true;
+}
+
+#endif  // HAVE_GWK_AVX2
+
 #ifdef USE_SSE2
 
 /************************************************************************/
@@ -3611,6 +3950,15 @@ struct _GWKResampleWrkStruct
     double *padfRowDensity;
     double *padfRowReal;
     double *padfRowImag;
+
+#ifdef HAVE_GWK_AVX2
+    // Whether rows are accumulated with GWKAccumulateMaskedRowsAVX2().
+    bool bUseAVX2;
+    // Space for saving the per-row sums computed by it.
+    double *padfRowSumReal;
+    double *padfRowSumDensity;
+    double *padfRowSumWeight;
+#endif
 };
 
 /************************************************************************/
@@ -3665,6 +4013,22 @@ static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
     psWrkStruct->padfRowImag =
         static_cast<double *>(CPLCalloc(nXDist, sizeof(double)));
 
+#ifdef HAVE_GWK_AVX2
+    psWrkStruct->bUseAVX2 =
+        GWKAVX2SupportsDataType(poWK->eWorkingDataType) &&
+        CPLHaveRuntimeAVX2() &&
+        CPLTestBool(CPLGetConfigOption("GDAL_USE_AVX2", "YES"));
+    if (psWrkStruct->bUseAVX2)
+    {
+        psWrkStruct->padfRowSumReal =
+            static_cast<double *>(CPLCalloc(nYDist, sizeof(double)));
+        psWrkStruct->padfRowSumDensity =
+            static_cast<double *>(CPLCalloc(nYDist, sizeof(double)));
+        psWrkStruct->padfRowSumWeight =
+            static_cast<double *>(CPLCalloc(nYDist, sizeof(double)));
+    }
+#endif
+
     if (poWK->eResample == GRA_Lanczos)
     {
         psWrkStruct->pfnGWKResample = GWKResampleOptimizedLanczos;
@@ -3723,6 +4087,11 @@ static void GWKResampleDeleteWrkStruct(GWKResampleWrkStruct *psWrkStruct)
     CPLFree(psWrkStruct->padfRowDensity);
     CPLFree(psWrkStruct->padfRowReal);
     CPLFree(psWrkStruct->padfRowImag);
+#ifdef HAVE_GWK_AVX2
+    CPLFree(psWrkStruct->padfRowSumReal);
+    CPLFree(psWrkStruct->padfRowSumDensity);
+    CPLFree(psWrkStruct->padfRowSumWeight);
+#endif
     CPLFree(psWrkStruct);
 }
 
@@ -3789,72 +4158,115 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
     const int bXScaleBelow1 = (dfXScale < 1.0);
     const int bYScaleBelow1 = (dfYScale < 1.0);
 
-    GPtrDiff_t iRowOffset =
-        iSrcOffset + static_cast<GPtrDiff_t>(j - 1) * nSrcXSize + iMin;
+#ifdef HAVE_GWK_AVX2
+    if (psWrkStruct->bUseAVX2 && j <= jMax && iMin <= iMax)
+    {
+        // Compute all X weights upfront, and accumulate each row of the
+        // kernel in one go.
+        for (int i = iMin; i <= iMax; ++i)
+        {
+            padfWeightsX[i - iMin] =
+                (bXScaleBelow1) ? pfnGetWeight((i - dfDeltaX) * dfXScale)
+                                : pfnGetWeight(i - dfDeltaX);
+        }
 
-    // Loop over pixel rows in the kernel.
-    for (; j <= jMax; ++j)
-    {
-        iRowOffset += nSrcXSize;
-
-        // Get pixel values.
-        // We can potentially read extra elements after the "normal" end of the
-        // source arrays, but the contract of papabySrcImage[iBand],
-        // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
-        // is to have WARP_EXTRA_ELTS reserved at their end.
-        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
-                            padfRowDensity, padfRowReal, padfRowImag))
-            continue;
-
-        // Calculate the Y weight.
-        double dfWeight1 = (bYScaleBelow1)
-                               ? pfnGetWeight((j - dfDeltaY) * dfYScale)
-                               : pfnGetWeight(j - dfDeltaY);
-
-        // Iterate over pixels in row.
-        double dfAccumulatorRealLocal = 0.0;
-        double dfAccumulatorImagLocal = 0.0;
-        double dfAccumulatorDensityLocal = 0.0;
-        double dfAccumulatorWeightLocal = 0.0;
+        int nCountValidIgnored = 0;
+        GWKAccumulateMaskedRowsAVX2(
+            poWK->eWorkingDataType, poWK->papabySrcImage[iBand],
+            poWK->panUnifiedSrcValid,
+            poWK->papanBandSrcValid ? poWK->papanBandSrcValid[iBand] : nullptr,
+            poWK->pafUnifiedSrcDensity, SRC_DENSITY_THRESHOLD,
+            iSrcOffset + static_cast<GPtrDiff_t>(j) * nSrcXSize + iMin,
+            nSrcXSize, iMax - iMin + 1, jMax - j + 1, padfWeightsX,
+            psWrkStruct->padfRowSumReal, psWrkStruct->padfRowSumDensity,
+            psWrkStruct->padfRowSumWeight, &nCountValidIgnored);
+
+        for (int k = 0; j <= jMax; ++j, ++k)
+        {
+            const double dfWeight1 =
+                (bYScaleBelow1) ? pfnGetWeight((j - dfDeltaY) * dfYScale)
+                                : pfnGetWeight(j - dfDeltaY);
 
-        for (int i = iMin; i <= iMax; ++i)
+            dfAccumulatorReal += psWrkStruct->padfRowSumReal[k] * dfWeight1;
+            if (padfRowDensity != nullptr)
+                dfAccumulatorDensity +=
+                    psWrkStruct->padfRowSumDensity[k] * dfWeight1;
+            dfAccumulatorWeight +=
+                psWrkStruct->padfRowSumWeight[k] * dfWeight1;
+        }
+    }
+    else
+#endif
+    {
+        GPtrDiff_t iRowOffset =
+            iSrcOffset + static_cast<GPtrDiff_t>(j - 1) * nSrcXSize + iMin;
+
+        // Loop over pixel rows in the kernel.
+        for (; j <= jMax; ++j)
         {
-            // Skip sampling if pixel has zero density.
-            if (padfRowDensity != nullptr &&
-                padfRowDensity[i - iMin] < SRC_DENSITY_THRESHOLD)
+            iRowOffset += nSrcXSize;
+
+            // Get pixel values.
+            // We can potentially read extra elements after the "normal" end of
+            // the source arrays, but the contract of papabySrcImage[iBand],
+            // papanBandSrcValid[iBand], panUnifiedSrcValid and
+            // pafUnifiedSrcDensity is to have WARP_EXTRA_ELTS reserved at
+            // their end.
+            if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                                padfRowDensity, padfRowReal, padfRowImag))
                 continue;
 
-            double dfWeight2 = 0.0;
+            // Calculate the Y weight.
+            double dfWeight1 = (bYScaleBelow1)
+                                   ? pfnGetWeight((j - dfDeltaY) * dfYScale)
+                                   : pfnGetWeight(j - dfDeltaY);
 
-            // Make or use a cached set of weights for this row.
-            if (pabCalcX[i - iMin])
-            {
-                // Use saved weight value instead of recomputing it.
-                dfWeight2 = padfWeightsX[i - iMin];
-            }
-            else
+            // Iterate over pixels in row.
+            double dfAccumulatorRealLocal = 0.0;
+            double dfAccumulatorImagLocal = 0.0;
+            double dfAccumulatorDensityLocal = 0.0;
+            double dfAccumulatorWeightLocal = 0.0;
+
+            for (int i = iMin; i <= iMax; ++i)
             {
-                // Calculate & save the X weight.
-                padfWeightsX[i - iMin] = dfWeight2 =
-                    (bXScaleBelow1) ? pfnGetWeight((i - dfDeltaX) * dfXScale)
-                                    : pfnGetWeight(i - dfDeltaX);
+                // Skip sampling if pixel has zero density.
+                if (padfRowDensity != nullptr &&
+                    padfRowDensity[i - iMin] < SRC_DENSITY_THRESHOLD)
+                    continue;
 
-                pabCalcX[i - iMin] = true;
+                double dfWeight2 = 0.0;
+
+                // Make or use a cached set of weights for this row.
+                if (pabCalcX[i - iMin])
+                {
+                    // Use saved weight value instead of recomputing it.
+                    dfWeight2 = padfWeightsX[i - iMin];
+                }
+                else
+                {
+                    // Calculate & save the X weight.
+                    padfWeightsX[i - iMin] = dfWeight2 =
+                        (bXScaleBelow1)
+                            ? pfnGetWeight((i - dfDeltaX) * dfXScale)
+                            : pfnGetWeight(i - dfDeltaX);
+
+                    pabCalcX[i - iMin] = true;
+                }
+
+                // Accumulate!
+                dfAccumulatorRealLocal += padfRowReal[i - iMin] * dfWeight2;
+                dfAccumulatorImagLocal += padfRowImag[i - iMin] * dfWeight2;
+                if (padfRowDensity != nullptr)
+                    dfAccumulatorDensityLocal +=
+                        padfRowDensity[i - iMin] * dfWeight2;
+                dfAccumulatorWeightLocal += dfWeight2;
             }
 
-            // Accumulate!
-            dfAccumulatorRealLocal += padfRowReal[i - iMin] * dfWeight2;
-            dfAccumulatorImagLocal += padfRowImag[i - iMin] * dfWeight2;
-            if (padfRowDensity != nullptr)
-                dfAccumulatorDensityLocal +=
-                    padfRowDensity[i - iMin] * dfWeight2;
-            dfAccumulatorWeightLocal += dfWeight2;
+            dfAccumulatorReal += dfAccumulatorRealLocal * dfWeight1;
+            dfAccumulatorImag += dfAccumulatorImagLocal * dfWeight1;
+            dfAccumulatorDensity += dfAccumulatorDensityLocal * dfWeight1;
+            dfAccumulatorWeight += dfAccumulatorWeightLocal * dfWeight1;
         }
-
-        dfAccumulatorReal += dfAccumulatorRealLocal * dfWeight1;
-        dfAccumulatorImag += dfAccumulatorImagLocal * dfWeight1;
-        dfAccumulatorDensity += dfAccumulatorDensityLocal * dfWeight1;
-        dfAccumulatorWeight += dfAccumulatorWeightLocal * dfWeight1;
     }
 
     if (dfAccumulatorWeight < 0.000001 ||
@@ -4333,76 +4745,110 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         return true;
     }
 
-    GPtrDiff_t iRowOffset =
-        iSrcOffset + static_cast<GPtrDiff_t>(jMin - 1) * nSrcXSize + iMin;
-
     int nCountValid = 0;
     const bool bIsNonComplex = !GDALDataTypeIsComplex(poWK->eWorkingDataType);
 
-    for (int j = jMin; j <= jMax; ++j)
+#ifdef HAVE_GWK_AVX2
+    if (psWrkStruct->bUseAVX2 && jMin <= jMax && iMin <= iMax)
     {
-        iRowOffset += nSrcXSize;
-
-        // Get pixel values.
-        // We can potentially read extra elements after the "normal" end of the
-        // source arrays, but the contract of papabySrcImage[iBand],
-        // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
-        // is to have WARP_EXTRA_ELTS reserved at their end.
-        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
-                            padfRowDensity, padfRowReal, padfRowImag))
-            continue;
+        GWKAccumulateMaskedRowsAVX2(
+            poWK->eWorkingDataType, poWK->papabySrcImage[iBand],
+            poWK->panUnifiedSrcValid,
+            poWK->papanBandSrcValid ? poWK->papanBandSrcValid[iBand] : nullptr,
+            poWK->pafUnifiedSrcDensity, SRC_DENSITY_THRESHOLD,
+            iSrcOffset + static_cast<GPtrDiff_t>(jMin) * nSrcXSize + iMin,
+            nSrcXSize, iMax - iMin + 1, jMax - jMin + 1,
+            padfWeightsXShifted + iMin, psWrkStruct->padfRowSumReal,
+            psWrkStruct->padfRowSumDensity, psWrkStruct->padfRowSumWeight,
+            &nCountValid);
 
-        const double dfWeight1 = padfWeightsYShifted[j];
+        for (int j = jMin; j <= jMax; ++j)
+        {
+            const double dfWeight1 = padfWeightsYShifted[j];
+            dfAccumulatorReal +=
+                psWrkStruct->padfRowSumReal[j - jMin] * dfWeight1;
+            if (padfRowDensity != nullptr)
+            {
+                dfAccumulatorDensity +=
+                    psWrkStruct->padfRowSumDensity[j - jMin] * dfWeight1;
+                dfAccumulatorWeight +=
+                    psWrkStruct->padfRowSumWeight[j - jMin] * dfWeight1;
+            }
+        }
+    }
+    else
+#endif
+    {
+        GPtrDiff_t iRowOffset =
+            iSrcOffset + static_cast<GPtrDiff_t>(jMin - 1) * nSrcXSize + iMin;
 
-        // Iterate over pixels in row.
-        if (padfRowDensity != nullptr)
+        for (int j = jMin; j <= jMax; ++j)
         {
-            for (int i = iMin; i <= iMax; ++i)
+            iRowOffset += nSrcXSize;
+
+            // Get pixel values.
+            // We can potentially read extra elements after the "normal" end of
+            // the source arrays, but the contract of papabySrcImage[iBand],
+            // papanBandSrcValid[iBand], panUnifiedSrcValid and
+            // pafUnifiedSrcDensity is to have WARP_EXTRA_ELTS reserved at
+            // their end.
+            if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                                padfRowDensity, padfRowReal, padfRowImag))
+                continue;
+
+            const double dfWeight1 = padfWeightsYShifted[j];
+
+            // Iterate over pixels in row.
+            if (padfRowDensity != nullptr)
             {
-                // Skip sampling if pixel has zero density.
-                if (padfRowDensity[i - iMin] < SRC_DENSITY_THRESHOLD)
-                    continue;
+                for (int i = iMin; i <= iMax; ++i)
+                {
+                    // Skip sampling if pixel has zero density.
+                    if (padfRowDensity[i - iMin] < SRC_DENSITY_THRESHOLD)
+                        continue;
 
-                nCountValid++;
+                    nCountValid++;
 
-                //  Use a cached set of weights for this row.
-                const double dfWeight2 = dfWeight1 * padfWeightsXShifted[i];
+                    //  Use a cached set of weights for this row.
+                    const double dfWeight2 = dfWeight1 * padfWeightsXShifted[i];
 
-                // Accumulate!
-                dfAccumulatorReal += padfRowReal[i - iMin] * dfWeight2;
-                dfAccumulatorImag += padfRowImag[i - iMin] * dfWeight2;
-                dfAccumulatorDensity += padfRowDensity[i - iMin] * dfWeight2;
-                dfAccumulatorWeight += dfWeight2;
+                    // Accumulate!
+                    dfAccumulatorReal += padfRowReal[i - iMin] * dfWeight2;
+                    dfAccumulatorImag += padfRowImag[i - iMin] * dfWeight2;
+                    dfAccumulatorDensity +=
+                        padfRowDensity[i - iMin] * dfWeight2;
+                    dfAccumulatorWeight += dfWeight2;
+                }
             }
-        }
-        else if (bIsNonComplex)
-        {
-            double dfRowAccReal = 0.0;
-            for (int i = iMin; i <= iMax; ++i)
+            else if (bIsNonComplex)
             {
-                const double dfWeight2 = padfWeightsXShifted[i];
+                double dfRowAccReal = 0.0;
+                for (int i = iMin; i <= iMax; ++i)
+                {
+                    const double dfWeight2 = padfWeightsXShifted[i];
 
-                // Accumulate!
-                dfRowAccReal += padfRowReal[i - iMin] * dfWeight2;
-            }
+                    // Accumulate!
+                    dfRowAccReal += padfRowReal[i - iMin] * dfWeight2;
+                }
 
-            dfAccumulatorReal += dfRowAccReal * dfWeight1;
-        }
-        else
-        {
-            double dfRowAccReal = 0.0;
-            double dfRowAccImag = 0.0;
-            for (int i = iMin; i <= iMax; ++i)
+                dfAccumulatorReal += dfRowAccReal * dfWeight1;
+            }
+            else
             {
-                const double dfWeight2 = padfWeightsXShifted[i];
+                double dfRowAccReal = 0.0;
+                double dfRowAccImag = 0.0;
+                for (int i = iMin; i <= iMax; ++i)
+                {
+                    const double dfWeight2 = padfWeightsXShifted[i];
 
-                // Accumulate!
-                dfRowAccReal += padfRowReal[i - iMin] * dfWeight2;
-                dfRowAccImag += padfRowImag[i - iMin] * dfWeight2;
-            }
+                    // Accumulate!
+                    dfRowAccReal += padfRowReal[i - iMin] * dfWeight2;
+                    dfRowAccImag += padfRowImag[i - iMin] * dfWeight2;
+                }
 
-            dfAccumulatorReal += dfRowAccReal * dfWeight1;
-            dfAccumulatorImag += dfRowAccImag * dfWeight1;
+                dfAccumulatorReal += dfRowAccReal * dfWeight1;
+                dfAccumulatorImag += dfRowAccImag * dfWeight1;
+            }
         }
     }
 
@@ -5306,8 +5752,7 @@ static void GWKGeneralCaseThread(void *pData)
         /*      to source pixel/line coordinates. */
         /* --------------------------------------------------------------------
          */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
+        GWKTransformDstRow(psJob, nDstXSize, padfX, padfY, padfZ, pabSuccess);
         if (dfSrcCoordPrecision > 0.0)
         {
             GWKRoundSourceCoordinates(
@@ -5553,6 +5998,10 @@ static void GWKRealCaseThread(void *pData)
                                    poWK->papanBandSrcValid == nullptr &&
                                    poWK->pafUnifiedSrcDensity != nullptr;
 
+#ifdef HAVE_GWK_AVX2
+    const bool bUseAVX2 = psWrkStruct != nullptr && psWrkStruct->bUseAVX2;
+#endif
+
     const bool bOneSourceCornerFailsToReproject =
         GWKOneSourceCornerFailsToReproject(psJob);
 
@@ -5582,8 +6031,7 @@ static void GWKRealCaseThread(void *pData)
         /*      to source pixel/line coordinates. */
         /* --------------------------------------------------------------------
          */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
+        GWKTransformDstRow(psJob, nDstXSize, padfX, padfY, padfZ, pabSuccess);
         if (dfSrcCoordPrecision > 0.0)
         {
             GWKRoundSourceCoordinates(
@@ -5712,6 +6160,15 @@ static void GWKRealCaseThread(void *pData)
                                 &dfValueReal);
                         }
                     }
+#ifdef HAVE_GWK_AVX2
+                    else if (bUseAVX2)
+                    {
+                        GWKCubicResample4SampleAVX2(
+                            poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                            padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                            &dfValueReal);
+                    }
+#endif
                     else
                     {
                         double dfValueImagIgnored = 0.0;
@@ -6011,8 +6468,7 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal(void *pData)
         /*      to source pixel/line coordinates. */
         /* --------------------------------------------------------------------
          */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
+        GWKTransformDstRow(psJob, nDstXSize, padfX, padfY, padfZ, pabSuccess);
         if (dfSrcCoordPrecision > 0.0)
         {
             GWKRoundSourceCoordinates(
@@ -6270,8 +6726,7 @@ template <class T> static void GWKNearestThread(void *pData)
         /*      to source pixel/line coordinates. */
         /* --------------------------------------------------------------------
          */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
+        GWKTransformDstRow(psJob, nDstXSize, padfX, padfY, padfZ, pabSuccess);
         if (dfSrcCoordPrecision > 0.0)
         {
             GWKRoundSourceCoordinates(
@@ -6710,10 +7165,9 @@ static void GWKAverageOrModeThread(void *pData)
         /*      to source pixel/line coordinates. */
         /* --------------------------------------------------------------------
          */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX2,
-                             padfY2, padfZ2, pabSuccess2);
+        GWKTransformDstRow(psJob, nDstXSize, padfX, padfY, padfZ, pabSuccess);
+        GWKTransformDstRow(psJob, nDstXSize, padfX2, padfY2, padfZ2,
+                           pabSuccess2);
 
         if (dfSrcCoordPrecision > 0.0)
         {
@@ -0,0 +1,425 @@
+/******************************************************************************
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  AVX2 specializations of the warp kernel
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "gdalwarpkernel_avx2.h"
+
+#ifdef HAVE_GWK_AVX2
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cstring>
+
+// The kernels of this file process 4 source rows at a time, with one row
+// per lane, and accumulate the columns of each row in the same order as the
+// scalar code of gdalwarpkernel.cpp. Products and sums are thus evaluated
+// identically (FMA is not used), and results match the scalar code.
+
+/************************************************************************/
+/*                             Load4Values()                            */
+/************************************************************************/
+
+static inline __m256d Load4Values(const GByte *pSrc)
+{
+    int nVal;
+    memcpy(&nVal, pSrc, sizeof(nVal));
+    return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(nVal)));
+}
+
+static inline __m256d Load4Values(const GInt16 *pSrc)
+{
+    return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pSrc))));
+}
+
+static inline __m256d Load4Values(const GUInt16 *pSrc)
+{
+    return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pSrc))));
+}
+
+static inline __m256d Load4Values(const float *pSrc)
+{
+    return _mm256_cvtps_pd(_mm_loadu_ps(pSrc));
+}
+
+static inline __m256d Load4Values(const double *pSrc)
+{
+    return _mm256_loadu_pd(pSrc);
+}
+
+/************************************************************************/
+/*                           GetValidBits4()                            */
+/************************************************************************/
+
+// Return the 4 bits of panMask starting at iOffset.
+static inline unsigned GetValidBits4(const GUInt32 *panMask, GPtrDiff_t iOffset)
+{
+    if (panMask == nullptr)
+        return 0xF;
+    const GPtrDiff_t iWord = iOffset >> 5;
+    const int nShift = static_cast<int>(iOffset & 31);
+    GUInt64 nBits = panMask[iWord];
+    if (nShift > 28)
+        nBits |= static_cast<GUInt64>(panMask[iWord + 1]) << 32;
+    return static_cast<unsigned>(nBits >> nShift) & 0xF;
+}
+
+/************************************************************************/
+/*                          Load4Densities()                            */
+/************************************************************************/
+
+// Density of 4 consecutive source pixels, as computed by GWKGetPixelRow():
+// 0 if invalid in one of the validity masks, the unified source density if
+// there is one, or 1 otherwise.
+static inline __m256d Load4Densities(const GUInt32 *panUnifiedSrcValid,
+                                     const GUInt32 *panBandSrcValid,
+                                     const float *pafUnifiedSrcDensity,
+                                     GPtrDiff_t iOffset)
+{
+    const unsigned nBits = GetValidBits4(panUnifiedSrcValid, iOffset) &
+                           GetValidBits4(panBandSrcValid, iOffset);
+    const __m256i ymmBitSelect = _mm256_set_epi64x(8, 4, 2, 1);
+    const __m256d ymmValid = _mm256_castsi256_pd(_mm256_cmpeq_epi64(
+        _mm256_and_si256(_mm256_set1_epi64x(nBits), ymmBitSelect),
+        ymmBitSelect));
+    const __m256d ymmDensity =
+        pafUnifiedSrcDensity
+            ? _mm256_cvtps_pd(_mm_loadu_ps(pafUnifiedSrcDensity + iOffset))
+            : _mm256_set1_pd(1.0);
+    return _mm256_and_pd(ymmDensity, ymmValid);
+}
+
+/************************************************************************/
+/*                             Transpose4x4()                           */
+/************************************************************************/
+
+static inline void Transpose4x4(__m256d &r0, __m256d &r1, __m256d &r2,
+                                __m256d &r3)
+{
+    const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+    r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+
+/************************************************************************/
+/*                   GWKAccumulateMaskedRowsAVX2T()                     */
+/************************************************************************/
+
+template <class T>
+static void GWKAccumulateMaskedRowsAVX2T(
+    const T *pSrcImage, const GUInt32 *panUnifiedSrcValid,
+    const GUInt32 *panBandSrcValid, const float *pafUnifiedSrcDensity,
+    double dfDensityThreshold, GPtrDiff_t iSrcOffset, int nSrcXSize, int nCols,
+    int nRows, const double *padfWeightsX, double *padfRowReal,
+    double *padfRowDensity, double *padfRowWeight, int *pnCountValid)
+{
+    const __m256d ymmThreshold = _mm256_set1_pd(dfDensityThreshold);
+    const __m256d ymmZero = _mm256_setzero_pd();
+    int nCountValid = 0;
+
+    for (int j0 = 0; j0 < nRows; j0 += 4)
+    {
+        const int nLanes = std::min(4, nRows - j0);
+        GPtrDiff_t aiRowOffset[4];
+        for (int k = 0; k < 4; ++k)
+        {
+            // Missing lanes read the last row again, and are discarded
+            aiRowOffset[k] =
+                iSrcOffset +
+                static_cast<GPtrDiff_t>(j0 + std::min(k, nLanes - 1)) *
+                    nSrcXSize;
+        }
+
+        __m256d ymmAccReal = ymmZero;
+        __m256d ymmAccDensity = ymmZero;
+        __m256d ymmAccWeight = ymmZero;
+        __m256i ymmCountValid = _mm256_setzero_si256();
+
+        const auto Accumulate =
+            [&](const __m256d &ymmValues, const __m256d &ymmDensities, int i)
+        {
+            const __m256d ymmValid =
+                _mm256_cmp_pd(ymmDensities, ymmThreshold, _CMP_NLT_UQ);
+            const __m256d ymmWeight = _mm256_set1_pd(padfWeightsX[i]);
+            ymmAccReal = _mm256_add_pd(
+                ymmAccReal,
+                _mm256_and_pd(_mm256_mul_pd(ymmValues, ymmWeight), ymmValid));
+            ymmAccDensity = _mm256_add_pd(
+                ymmAccDensity, _mm256_and_pd(
+                                   _mm256_mul_pd(ymmDensities, ymmWeight),
+                                   ymmValid));
+            ymmAccWeight =
+                _mm256_add_pd(ymmAccWeight, _mm256_and_pd(ymmWeight, ymmValid));
+            ymmCountValid = _mm256_sub_epi64(ymmCountValid,
+                                             _mm256_castpd_si256(ymmValid));
+        };
+
+        int i = 0;
+        for (; i + 4 <= nCols; i += 4)
+        {
+            __m256d v0 = Load4Values(pSrcImage + aiRowOffset[0] + i);
+            __m256d v1 = Load4Values(pSrcImage + aiRowOffset[1] + i);
+            __m256d v2 = Load4Values(pSrcImage + aiRowOffset[2] + i);
+            __m256d v3 = Load4Values(pSrcImage + aiRowOffset[3] + i);
+            Transpose4x4(v0, v1, v2, v3);
+
+            __m256d d0 = Load4Densities(panUnifiedSrcValid, panBandSrcValid,
+                                        pafUnifiedSrcDensity,
+                                        aiRowOffset[0] + i);
+            __m256d d1 = Load4Densities(panUnifiedSrcValid, panBandSrcValid,
+                                        pafUnifiedSrcDensity,
+                                        aiRowOffset[1] + i);
+            __m256d d2 = Load4Densities(panUnifiedSrcValid, panBandSrcValid,
+                                        pafUnifiedSrcDensity,
+                                        aiRowOffset[2] + i);
+            __m256d d3 = Load4Densities(panUnifiedSrcValid, panBandSrcValid,
+                                        pafUnifiedSrcDensity,
+                                        aiRowOffset[3] + i);
+            Transpose4x4(d0, d1, d2, d3);
+
+            Accumulate(v0, d0, i);
+            Accumulate(v1, d1, i + 1);
+            Accumulate(v2, d2, i + 2);
+            Accumulate(v3, d3, i + 3);
+        }
+
+        for (; i < nCols; ++i)
+        {
+            double adfValues[4];
+            double adfDensities[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                const GPtrDiff_t iOffset = aiRowOffset[k] + i;
+                adfValues[k] = static_cast<double>(pSrcImage[iOffset]);
+                if ((panUnifiedSrcValid &&
+                     !(panUnifiedSrcValid[iOffset >> 5] &
+                       (1U << (iOffset & 31)))) ||
+                    (panBandSrcValid &&
+                     !(panBandSrcValid[iOffset >> 5] &
+                       (1U << (iOffset & 31)))))
+                    adfDensities[k] = 0.0;
+                else if (pafUnifiedSrcDensity)
+                    adfDensities[k] = pafUnifiedSrcDensity[iOffset];
+                else
+                    adfDensities[k] = 1.0;
+            }
+            Accumulate(_mm256_loadu_pd(adfValues),
+                       _mm256_loadu_pd(adfDensities), i);
+        }
+
+        double adfAccReal[4];
+        double adfAccDensity[4];
+        double adfAccWeight[4];
+        GInt64 anCountValid[4];
+        _mm256_storeu_pd(adfAccReal, ymmAccReal);
+        _mm256_storeu_pd(adfAccDensity, ymmAccDensity);
+        _mm256_storeu_pd(adfAccWeight, ymmAccWeight);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(anCountValid),
+                            ymmCountValid);
+        for (int k = 0; k < nLanes; ++k)
+        {
+            padfRowReal[j0 + k] = adfAccReal[k];
+            padfRowDensity[j0 + k] = adfAccDensity[k];
+            padfRowWeight[j0 + k] = adfAccWeight[k];
+            nCountValid += static_cast<int>(anCountValid[k]);
+        }
+    }
+
+    *pnCountValid = nCountValid;
+}
+
+/************************************************************************/
+/*                    GWKAccumulateMaskedRowsAVX2()                     */
+/************************************************************************/
+
+/**
+ * For each of the nRows rows of nCols source pixels starting at iSrcOffset,
+ * compute the sum of value * weight, density * weight and weight over the
+ * pixels whose density is not below dfDensityThreshold, using
+ * padfWeightsX[] as the weight of each column. Also return the total number
+ * of such pixels.
+ */
+void GWKAccumulateMaskedRowsAVX2(
+    GDALDataType eDT, const void *pSrcImage, const GUInt32 *panUnifiedSrcValid,
+    const GUInt32 *panBandSrcValid, const float *pafUnifiedSrcDensity,
+    double dfDensityThreshold, GPtrDiff_t iSrcOffset, int nSrcXSize, int nCols,
+    int nRows, const double *padfWeightsX, double *padfRowReal,
+    double *padfRowDensity, double *padfRowWeight, int *pnCountValid)
+{
+    switch (eDT)
+    {
+        case GDT_Byte:
+            GWKAccumulateMaskedRowsAVX2T(
+                static_cast<const GByte *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, nCols, nRows, padfWeightsX, padfRowReal,
+                padfRowDensity, padfRowWeight, pnCountValid);
+            break;
+        case GDT_Int16:
+            GWKAccumulateMaskedRowsAVX2T(
+                static_cast<const GInt16 *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, nCols, nRows, padfWeightsX, padfRowReal,
+                padfRowDensity, padfRowWeight, pnCountValid);
+            break;
+        case GDT_UInt16:
+            GWKAccumulateMaskedRowsAVX2T(
+                static_cast<const GUInt16 *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, nCols, nRows, padfWeightsX, padfRowReal,
+                padfRowDensity, padfRowWeight, pnCountValid);
+            break;
+        case GDT_Float32:
+            GWKAccumulateMaskedRowsAVX2T(
+                static_cast<const float *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, nCols, nRows, padfWeightsX, padfRowReal,
+                padfRowDensity, padfRowWeight, pnCountValid);
+            break;
+        case GDT_Float64:
+            GWKAccumulateMaskedRowsAVX2T(
+                static_cast<const double *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, nCols, nRows, padfWeightsX, padfRowReal,
+                padfRowDensity, padfRowWeight, pnCountValid);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                   GWKCubicConvolveRows4x4AVX2T()                     */
+/************************************************************************/
+
+template <class T>
+static bool GWKCubicConvolveRows4x4AVX2T(
+    const T *pSrcImage, const GUInt32 *panUnifiedSrcValid,
+    const GUInt32 *panBandSrcValid, const float *pafUnifiedSrcDensity,
+    double dfDensityThreshold, GPtrDiff_t iSrcOffset, int nSrcXSize,
+    const double *padfCoeffsX, double *padfValueReal, double *padfValueDens)
+{
+    const GPtrDiff_t iOffset0 = iSrcOffset;
+    const GPtrDiff_t iOffset1 = iOffset0 + nSrcXSize;
+    const GPtrDiff_t iOffset2 = iOffset1 + nSrcXSize;
+    const GPtrDiff_t iOffset3 = iOffset2 + nSrcXSize;
+
+    __m256d d0 = Load4Densities(panUnifiedSrcValid, panBandSrcValid,
+                                pafUnifiedSrcDensity, iOffset0);
+    __m256d d1 = Load4Densities(panUnifiedSrcValid, panBandSrcValid,
+                                pafUnifiedSrcDensity, iOffset1);
+    __m256d d2 = Load4Densities(panUnifiedSrcValid, panBandSrcValid,
+                                pafUnifiedSrcDensity, iOffset2);
+    __m256d d3 = Load4Densities(panUnifiedSrcValid, panBandSrcValid,
+                                pafUnifiedSrcDensity, iOffset3);
+
+    // Let the caller fall back to the generic code if any pixel of the
+    // kernel is not valid.
+    const __m256d ymmThreshold = _mm256_set1_pd(dfDensityThreshold);
+    const __m256d ymmInvalid = _mm256_or_pd(
+        _mm256_or_pd(_mm256_cmp_pd(d0, ymmThreshold, _CMP_LT_OQ),
+                     _mm256_cmp_pd(d1, ymmThreshold, _CMP_LT_OQ)),
+        _mm256_or_pd(_mm256_cmp_pd(d2, ymmThreshold, _CMP_LT_OQ),
+                     _mm256_cmp_pd(d3, ymmThreshold, _CMP_LT_OQ)));
+    if (_mm256_movemask_pd(ymmInvalid) != 0)
+        return false;
+
+    __m256d v0 = Load4Values(pSrcImage + iOffset0);
+    __m256d v1 = Load4Values(pSrcImage + iOffset1);
+    __m256d v2 = Load4Values(pSrcImage + iOffset2);
+    __m256d v3 = Load4Values(pSrcImage + iOffset3);
+    Transpose4x4(v0, v1, v2, v3);
+    Transpose4x4(d0, d1, d2, d3);
+
+    const __m256d c0 = _mm256_set1_pd(padfCoeffsX[0]);
+    const __m256d c1 = _mm256_set1_pd(padfCoeffsX[1]);
+    const __m256d c2 = _mm256_set1_pd(padfCoeffsX[2]);
+    const __m256d c3 = _mm256_set1_pd(padfCoeffsX[3]);
+
+    // Same evaluation order as the CONVOL4() macro
+    __m256d ymmReal = _mm256_mul_pd(c0, v0);
+    ymmReal = _mm256_add_pd(ymmReal, _mm256_mul_pd(c1, v1));
+    ymmReal = _mm256_add_pd(ymmReal, _mm256_mul_pd(c2, v2));
+    ymmReal = _mm256_add_pd(ymmReal, _mm256_mul_pd(c3, v3));
+    _mm256_storeu_pd(padfValueReal, ymmReal);
+
+    __m256d ymmDens = _mm256_mul_pd(c0, d0);
+    ymmDens = _mm256_add_pd(ymmDens, _mm256_mul_pd(c1, d1));
+    ymmDens = _mm256_add_pd(ymmDens, _mm256_mul_pd(c2, d2));
+    ymmDens = _mm256_add_pd(ymmDens, _mm256_mul_pd(c3, d3));
+    _mm256_storeu_pd(padfValueDens, ymmDens);
+
+    return true;
+}
+
+/************************************************************************/
+/*                    GWKCubicConvolveRows4x4AVX2()                     */
+/************************************************************************/
+
+/**
+ * Horizontal pass of the 4x4 cubic convolution of the source window whose
+ * top-left pixel is at iSrcOffset: for each of the 4 rows, compute the
+ * convolution of the values and densities with padfCoeffsX[].
+ * Return false, without computing anything, if one of the 16 pixels has a
+ * density below dfDensityThreshold.
+ */
+bool GWKCubicConvolveRows4x4AVX2(
+    GDALDataType eDT, const void *pSrcImage, const GUInt32 *panUnifiedSrcValid,
+    const GUInt32 *panBandSrcValid, const float *pafUnifiedSrcDensity,
+    double dfDensityThreshold, GPtrDiff_t iSrcOffset, int nSrcXSize,
+    const double *padfCoeffsX, double *padfValueReal, double *padfValueDens)
+{
+    switch (eDT)
+    {
+        case GDT_Byte:
+            return GWKCubicConvolveRows4x4AVX2T(
+                static_cast<const GByte *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, padfCoeffsX, padfValueReal,
+                padfValueDens);
+        case GDT_Int16:
+            return GWKCubicConvolveRows4x4AVX2T(
+                static_cast<const GInt16 *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, padfCoeffsX, padfValueReal,
+                padfValueDens);
+        case GDT_UInt16:
+            return GWKCubicConvolveRows4x4AVX2T(
+                static_cast<const GUInt16 *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, padfCoeffsX, padfValueReal,
+                padfValueDens);
+        case GDT_Float32:
+            return GWKCubicConvolveRows4x4AVX2T(
+                static_cast<const float *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, padfCoeffsX, padfValueReal,
+                padfValueDens);
+        case GDT_Float64:
+            return GWKCubicConvolveRows4x4AVX2T(
+                static_cast<const double *>(pSrcImage), panUnifiedSrcValid,
+                panBandSrcValid, pafUnifiedSrcDensity, dfDensityThreshold,
+                iSrcOffset, nSrcXSize, padfCoeffsX, padfValueReal,
+                padfValueDens);
+        default:
+            break;
+    }
+    return false;
+}
+
+#endif /* HAVE_GWK_AVX2 */
@@ -0,0 +1,48 @@
+/******************************************************************************
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  AVX2 specializations of the warp kernel
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef GDALWARPKERNEL_AVX2_H_INCLUDED
+#define GDALWARPKERNEL_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+#include "gdal.h"
+
+//! @cond Doxygen_Suppress
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#define HAVE_GWK_AVX2
+
+/** Return whether the AVX2 kernels support the working data type */
+inline bool GWKAVX2SupportsDataType(GDALDataType eDT)
+{
+    return eDT == GDT_Byte || eDT == GDT_Int16 || eDT == GDT_UInt16 ||
+           eDT == GDT_Float32 || eDT == GDT_Float64;
+}
+
+void GWKAccumulateMaskedRowsAVX2(
+    GDALDataType eDT, const void *pSrcImage, const GUInt32 *panUnifiedSrcValid,
+    const GUInt32 *panBandSrcValid, const float *pafUnifiedSrcDensity,
+    double dfDensityThreshold, GPtrDiff_t iSrcOffset, int nSrcXSize, int nCols,
+    int nRows, const double *padfWeightsX, double *padfRowReal,
+    double *padfRowDensity, double *padfRowWeight, int *pnCountValid);
+
+bool GWKCubicConvolveRows4x4AVX2(
+    GDALDataType eDT, const void *pSrcImage, const GUInt32 *panUnifiedSrcValid,
+    const GUInt32 *panBandSrcValid, const float *pafUnifiedSrcDensity,
+    double dfDensityThreshold, GPtrDiff_t iSrcOffset, int nSrcXSize,
+    const double *padfCoeffsX, double *padfValueReal, double *padfValueDens);
+
+#endif
+
+//! @endcond
+
+#endif /* GDALWARPKERNEL_AVX2_H_INCLUDED */
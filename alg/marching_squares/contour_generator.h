@@ -15,8 +15,14 @@
 
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 
 #include "gdal.h"
+#include "cpl_error_internal.h"
+#include "gdal_thread_pool.h"
 
 #include "utility.h"
 #include "point.h"
@@ -54,7 +60,21 @@ class ContourGenerator
         return CE_None;
     }
 
-  private:
+    // Make the generator start at line lineIdx, with previousLine being
+    // the content of line lineIdx - 1 (or nullptr if lineIdx == 0).
+    // This is used to process a horizontal strip of a raster independently
+    // of the preceding ones.
+    void setStartLine(size_t lineIdx, const double *previousLine)
+    {
+        lineIdx_ = lineIdx;
+        if (previousLine)
+            std::copy(previousLine, previousLine + width_,
+                      previousLine_.begin());
+        else
+            std::fill(previousLine_.begin(), previousLine_.end(), NaN);
+    }
+
+  protected:
     size_t width_;
     size_t height_;
     bool hasNoData_;
@@ -67,6 +87,7 @@ class ContourGenerator
     ContourWriter &writer_;
     LevelGenerator &levelGenerator_;
 
+  private:
     class ExtendedLine
     {
       public:
@@ -125,6 +146,88 @@ class ContourGenerator
     }
 };
 
+// Writer that records the calls it receives from a ContourGenerator, so that
+// they can later be replayed, in order, into another writer (typically a
+// SegmentMerger). This allows the marching squares evaluation of several
+// strips of a raster to be done in parallel, while the stitching of segments
+// across strip boundaries is still done by a single writer.
+class SegmentRecorder
+{
+  public:
+    explicit SegmentRecorder(bool polygonize_) : polygonize(polygonize_)
+    {
+    }
+
+    void addSegment(int levelIdx, const Point &start, const Point &end)
+    {
+        events_.push_back({Event::SEGMENT, levelIdx, start, end});
+    }
+
+    void addBorderSegment(int levelIdx, const Point &start, const Point &end)
+    {
+        events_.push_back({Event::BORDER_SEGMENT, levelIdx, start, end});
+    }
+
+    void beginningOfLine()
+    {
+        events_.push_back({Event::BEGINNING_OF_LINE, 0, Point(), Point()});
+    }
+
+    void endOfLine()
+    {
+        events_.push_back({Event::END_OF_LINE, 0, Point(), Point()});
+    }
+
+    template <typename ContourWriter> void replay(ContourWriter &writer) const
+    {
+        for (const auto &event : events_)
+        {
+            switch (event.type)
+            {
+                case Event::SEGMENT:
+                    writer.addSegment(event.levelIdx, event.start, event.end);
+                    break;
+                case Event::BORDER_SEGMENT:
+                    writer.addBorderSegment(event.levelIdx, event.start,
+                                            event.end);
+                    break;
+                case Event::BEGINNING_OF_LINE:
+                    writer.beginningOfLine();
+                    break;
+                case Event::END_OF_LINE:
+                    writer.endOfLine();
+                    break;
+            }
+        }
+    }
+
+    void clear()
+    {
+        events_.clear();
+    }
+
+    const bool polygonize;
+
+  private:
+    struct Event
+    {
+        enum Type
+        {
+            SEGMENT,
+            BORDER_SEGMENT,
+            BEGINNING_OF_LINE,
+            END_OF_LINE
+        };
+
+        Type type;
+        int levelIdx;
+        Point start;
+        Point end;
+    };
+
+    std::vector<Event> events_{};
+};
+
 template <typename ContourWriter, typename LevelGenerator>
 inline ContourGenerator<ContourWriter, LevelGenerator> *
 newContourGenerator(size_t width, size_t height, bool hasNoData,
@@ -150,9 +253,19 @@ class ContourGeneratorFromRaster
     {
     }
 
+    // If nThreads > 1, horizontal strips of the raster are contoured in
+    // parallel, and the resulting segments are fed in order to the writer,
+    // so that the output is identical to the single-threaded one.
     bool process(GDALProgressFunc progressFunc = nullptr,
-                 void *progressData = nullptr)
+                 void *progressData = nullptr, int nThreads = 1)
     {
+        if (nThreads > 1)
+        {
+            bool ok = false;
+            if (processMultiThreaded(progressFunc, progressData, nThreads, ok))
+                return ok;
+        }
+
         size_t width = GDALGetRasterBandXSize(band_);
         size_t height = GDALGetRasterBandYSize(band_);
         std::vector<double> line;
@@ -184,6 +297,179 @@ class ContourGeneratorFromRaster
   private:
     const GDALRasterBandH band_;
 
+    // Returns false if multi-threaded processing cannot be used, in which
+    // case the caller should fall back to the sequential code path.
+    bool processMultiThreaded(GDALProgressFunc progressFunc, void *progressData,
+                              int nThreads, bool &ok)
+    {
+        const size_t width = GDALGetRasterBandXSize(band_);
+        const size_t height = GDALGetRasterBandYSize(band_);
+
+        // Strips of about 1 million pixels, but at least 4 strips per thread
+        size_t linesPerStrip =
+            std::max<size_t>(1, (1024 * 1024) / std::max<size_t>(1, width));
+        linesPerStrip = std::min(
+            linesPerStrip,
+            std::max<size_t>(1, height / (4 * static_cast<size_t>(nThreads))));
+        const size_t stripCount = (height + linesPerStrip - 1) / linesPerStrip;
+        if (stripCount < 2)
+            return false;
+
+        // Worker threads read from a thread-safe view of the source dataset
+        GDALDatasetH hDS = GDALGetBandDataset(band_);
+        const int bandNumber = GDALGetBandNumber(band_);
+        if (hDS == nullptr || bandNumber < 1 ||
+            GDALGetRasterBand(hDS, bandNumber) != band_ ||
+            GDALGetRasterAccess(band_) != GA_ReadOnly)
+            return false;
+        GDALDatasetH hTSDS;
+        {
+            CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+            hTSDS = GDALGetThreadSafeDataset(hDS, GDAL_OF_RASTER, nullptr);
+        }
+        if (hTSDS == nullptr)
+            return false;
+        GDALRasterBandH hTSBand = GDALGetRasterBand(hTSDS, bandNumber);
+
+        nThreads = static_cast<int>(
+            std::min(static_cast<size_t>(nThreads), stripCount));
+        CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+        auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+        if (!poQueue)
+        {
+            GDALReleaseDataset(hTSDS);
+            return false;
+        }
+
+        struct Strip
+        {
+            SegmentRecorder recorder;
+            bool done = false;
+            bool ok = false;
+
+            explicit Strip(bool polygonize) : recorder(polygonize)
+            {
+            }
+        };
+
+        std::vector<std::unique_ptr<Strip>> strips(stripCount);
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::atomic<bool> stop{false};
+        CPLErrorAccumulator oErrorAccumulator;
+
+        const auto processStrip = [&](size_t iStrip)
+        {
+            auto oContext = oErrorAccumulator.InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oContext);
+
+            Strip &strip = *strips[iStrip];
+            bool stripOk = true;
+            if (!stop)
+            {
+                const size_t y0 = iStrip * linesPerStrip;
+                const size_t y1 = std::min(height, y0 + linesPerStrip);
+                ContourGenerator<SegmentRecorder, LevelGenerator> cg(
+                    width, height, this->hasNoData_, this->noDataValue_,
+                    strip.recorder, this->levelGenerator_);
+                std::vector<double> previousLine;
+                std::vector<double> line(width);
+                if (y0 > 0)
+                {
+                    previousLine.resize(width);
+                    stripOk = GDALRasterIO(hTSBand, GF_Read, 0, int(y0 - 1),
+                                           int(width), 1, previousLine.data(),
+                                           int(width), 1, GDT_Float64, 0,
+                                           0) == CE_None;
+                }
+                cg.setStartLine(y0, y0 > 0 ? previousLine.data() : nullptr);
+                for (size_t y = y0; stripOk && y < y1 && !stop; ++y)
+                {
+                    if (GDALRasterIO(hTSBand, GF_Read, 0, int(y), int(width),
+                                     1, line.data(), int(width), 1,
+                                     GDT_Float64, 0, 0) != CE_None)
+                    {
+                        CPLDebug("CONTOUR", "failed fetch %d %d", int(y),
+                                 int(width));
+                        stripOk = false;
+                        break;
+                    }
+                    cg.feedLine(line.data());
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            strip.ok = stripOk && !stop;
+            strip.done = true;
+            cv.notify_one();
+        };
+
+        // Keep a bounded number of strips in flight, and replay them in
+        // order into the final writer.
+        const size_t maxInFlight = 2 * static_cast<size_t>(nThreads);
+        size_t nextToSubmit = 0;
+        ok = true;
+        const auto waitAndRelease = [&]()
+        {
+            stop = true;
+            poQueue->WaitCompletion();
+            oErrorAccumulator.ReplayErrors();
+            GDALReleaseDataset(hTSDS);
+        };
+        try
+        {
+            for (size_t iStrip = 0; iStrip < stripCount; ++iStrip)
+            {
+                while (nextToSubmit < stripCount &&
+                       nextToSubmit < iStrip + maxInFlight)
+                {
+                    strips[nextToSubmit] =
+                        std::make_unique<Strip>(this->writer_.polygonize);
+                    const size_t iStripToSubmit = nextToSubmit;
+                    if (!poQueue->SubmitJob([&processStrip, iStripToSubmit]()
+                                            { processStrip(iStripToSubmit); }))
+                    {
+                        processStrip(iStripToSubmit);
+                    }
+                    ++nextToSubmit;
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&strips, iStrip]()
+                            { return strips[iStrip]->done; });
+                }
+
+                if (!strips[iStrip]->ok)
+                {
+                    ok = false;
+                    break;
+                }
+                strips[iStrip]->recorder.replay(this->writer_);
+                strips[iStrip].reset();
+
+                if (progressFunc &&
+                    progressFunc(double(iStrip + 1) / stripCount,
+                                 "Processing line", progressData) == FALSE)
+                {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+        catch (...)
+        {
+            // Make sure no job refers to local state before propagating
+            waitAndRelease();
+            throw;
+        }
+        waitAndRelease();
+
+        if (ok && progressFunc)
+            progressFunc(1.0, "", progressData);
+        return true;
+    }
+
     ContourGeneratorFromRaster(const ContourGeneratorFromRaster &) = delete;
     ContourGeneratorFromRaster &
     operator=(const ContourGeneratorFromRaster &) = delete;
@@ -19,18 +19,23 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 #include "gdal_alg_priv.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
@@ -65,6 +70,511 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/*                       GPGetThreadSafeDataset()                       */
+/*                                                                      */
+/*      Return a thread-safe dataset for the dataset owning hBand, or   */
+/*      nullptr if hBand is not a regular band of a read-only dataset.  */
+/************************************************************************/
+
+static GDALDatasetH GPGetThreadSafeDataset(GDALRasterBandH hBand)
+{
+    GDALDatasetH hDS = GDALGetBandDataset(hBand);
+    const int nBand = GDALGetBandNumber(hBand);
+    if (hDS == nullptr || nBand < 1 || GDALGetRasterBand(hDS, nBand) != hBand ||
+        GDALGetRasterAccess(hBand) != GA_ReadOnly)
+        return nullptr;
+    CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+    return GDALGetThreadSafeDataset(hDS, GDAL_OF_RASTER, nullptr);
+}
+
+/************************************************************************/
+/*                       GPProcessStripsInOrder()                       */
+/*                                                                      */
+/*      Run processStrip() on each strip in a job queue, with a         */
+/*      bounded number of strips in flight, and call consumeStrip()     */
+/*      from the calling thread on each strip in order.                 */
+/************************************************************************/
+
+template <class Strip, class ProcessFunc, class ConsumeFunc>
+static bool GPProcessStripsInOrder(CPLJobQueue *poQueue, int nStrips,
+                                   int nMaxInFlight,
+                                   CPLErrorAccumulator &oErrorAccumulator,
+                                   ProcessFunc processStrip,
+                                   ConsumeFunc consumeStrip)
+{
+    struct Slot
+    {
+        Strip oStrip{};
+        bool bDone = false;
+        bool bOK = false;
+    };
+
+    std::vector<std::unique_ptr<Slot>> apoSlots(nStrips);
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::atomic<bool> bStop{false};
+
+    const auto runJob = [&](int iStrip)
+    {
+        auto oContext = oErrorAccumulator.InstallForCurrentScope();
+        CPL_IGNORE_RET_VAL(oContext);
+
+        Slot &oSlot = *apoSlots[iStrip];
+        bool bOK = false;
+        if (!bStop)
+        {
+            try
+            {
+                bOK = processStrip(iStrip, oSlot.oStrip);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in GDALPolygonize()");
+            }
+        }
+
+        std::lock_guard<std::mutex> oLock(oMutex);
+        oSlot.bOK = bOK;
+        oSlot.bDone = true;
+        oCV.notify_one();
+    };
+
+    bool bRet = true;
+    try
+    {
+        int iNext = 0;
+        for (int iStrip = 0; iStrip < nStrips; ++iStrip)
+        {
+            for (; iNext < nStrips && iNext < iStrip + nMaxInFlight; ++iNext)
+            {
+                apoSlots[iNext] = std::make_unique<Slot>();
+                const int iJob = iNext;
+                if (!poQueue->SubmitJob([&runJob, iJob]() { runJob(iJob); }))
+                    runJob(iJob);
+            }
+
+            {
+                std::unique_lock<std::mutex> oLock(oMutex);
+                oCV.wait(oLock, [&apoSlots, iStrip]()
+                         { return apoSlots[iStrip]->bDone; });
+            }
+
+            if (!apoSlots[iStrip]->bOK ||
+                !consumeStrip(iStrip, apoSlots[iStrip]->oStrip))
+            {
+                bRet = false;
+                break;
+            }
+            apoSlots[iStrip].reset();
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        bRet = false;
+    }
+
+    bStop = true;
+    poQueue->WaitCompletion();
+    return bRet;
+}
+
+/************************************************************************/
+/*                         GPReadAndLabelStrip()                        */
+/*                                                                      */
+/*      Read a strip of lines and assign strip-local polygon ids to     */
+/*      its pixels, using a fresh enumerator.                           */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static bool
+GPReadAndLabelStrip(GDALRasterBandH hBand, GDALRasterBandH hMaskBand,
+                    GDALDataType eDT, int nXSize, int nYOff, int nLines,
+                    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> &oEnum,
+                    std::vector<DataType> &anVal, std::vector<GInt32> &anId)
+{
+    const size_t nPixels = static_cast<size_t>(nXSize) * nLines;
+    anVal.resize(nPixels);
+    anId.resize(nPixels);
+
+    if (GDALRasterIO(hBand, GF_Read, 0, nYOff, nXSize, nLines, anVal.data(),
+                     nXSize, nLines, eDT, 0, 0) != CE_None)
+        return false;
+
+    if (hMaskBand != nullptr)
+    {
+        std::vector<GByte> abyMask(nPixels);
+        if (GDALRasterIO(hMaskBand, GF_Read, 0, nYOff, nXSize, nLines,
+                         abyMask.data(), nXSize, nLines, GDT_Byte, 0,
+                         0) != CE_None)
+            return false;
+        for (size_t i = 0; i < nPixels; i++)
+        {
+            if (abyMask[i] == 0)
+                anVal[i] = GP_NODATA_MARKER;
+        }
+    }
+
+    for (int iLine = 0; iLine < nLines; iLine++)
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        if (!oEnum.ProcessLine(
+                iLine == 0 ? nullptr : anVal.data() + nOffset - nXSize,
+                anVal.data() + nOffset,
+                iLine == 0 ? nullptr : anId.data() + nOffset - nXSize,
+                anId.data() + nOffset, nXSize))
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                      GDALPolygonizeMultiThreadedT()                  */
+/*                                                                      */
+/*      The raster is split into strips of lines whose height only      */
+/*      depends on the raster width, so that the result does not       */
+/*      depend on the number of threads.                                */
+/*                                                                      */
+/*      First pass: each strip is labeled independently in a worker     */
+/*      thread. The main thread collects the strip polygon id maps in   */
+/*      a global union-find map, and merges the polygons that connect   */
+/*      across the boundary between two consecutive strips.             */
+/*                                                                      */
+/*      Second pass: each strip is read and labeled again in a worker   */
+/*      thread and its ids are translated to final global ids. The      */
+/*      main thread feeds the lines, in order, to the Polygonizer which */
+/*      traces the polygon edges and emits the polygons.                */
+/*                                                                      */
+/*      Returns false, without doing anything, if multi-threading       */
+/*      cannot be used.                                                 */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static bool GDALPolygonizeMultiThreadedT(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand, OGRLayerH hOutLayer,
+    int iPixValField, double *padfGeoTransform, int nConnectedness,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg,
+    GDALDataType eDT, CPLErr &eErr)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    // Strips of about 1 million pixels, aligned on blocks when possible.
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    GDALGetBlockSize(hSrcBand, &nBlockXSize, &nBlockYSize);
+    int nLinesPerStrip = std::max(1, (1024 * 1024) / std::max(1, nXSize));
+    if (nBlockYSize > 0 && nLinesPerStrip > nBlockYSize)
+        nLinesPerStrip = (nLinesPerStrip / nBlockYSize) * nBlockYSize;
+    const int nStrips = static_cast<int>(
+        (static_cast<GIntBig>(nYSize) + nLinesPerStrip - 1) / nLinesPerStrip);
+    if (nStrips < 2)
+        return false;
+
+    /* -------------------------------------------------------------------- */
+    /*      Get thread-safe views of the source and mask bands.             */
+    /* -------------------------------------------------------------------- */
+    GDALDatasetH hTSSrcDS = GPGetThreadSafeDataset(hSrcBand);
+    if (hTSSrcDS == nullptr)
+        return false;
+    GDALRasterBandH hTSSrcBand =
+        GDALGetRasterBand(hTSSrcDS, GDALGetBandNumber(hSrcBand));
+    GDALDatasetH hTSMaskDS = nullptr;
+    GDALRasterBandH hTSMaskBand = nullptr;
+    if (hMaskBand != nullptr)
+    {
+        if (hMaskBand == GDALGetMaskBand(hSrcBand))
+        {
+            hTSMaskBand = GDALGetMaskBand(hTSSrcBand);
+        }
+        else
+        {
+            hTSMaskDS = GPGetThreadSafeDataset(hMaskBand);
+            if (hTSMaskDS)
+                hTSMaskBand = GDALGetRasterBand(hTSMaskDS,
+                                                GDALGetBandNumber(hMaskBand));
+        }
+    }
+    const auto ReleaseDatasets = [hTSSrcDS, hTSMaskDS]()
+    {
+        GDALReleaseDataset(hTSSrcDS);
+        if (hTSMaskDS)
+            GDALReleaseDataset(hTSMaskDS);
+    };
+    if (hMaskBand != nullptr && hTSMaskBand == nullptr)
+    {
+        ReleaseDatasets();
+        return false;
+    }
+
+    nThreads = std::min(nThreads, nStrips);
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (!poQueue)
+    {
+        ReleaseDatasets();
+        return false;
+    }
+    const int nMaxInFlight = 2 * nThreads;
+    CPLErrorAccumulator oErrorAccumulator;
+    CPLDebug("GDAL", "Polygonize: using %d threads on %d strips", nThreads,
+             nStrips);
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: build the global polygon id map.                    */
+    /* -------------------------------------------------------------------- */
+    struct LabelStrip
+    {
+        std::vector<GInt32> anPolyIdMap{};
+        std::vector<DataType> anFirstLineVal{};
+        std::vector<GInt32> anFirstLineId{};
+        std::vector<DataType> anLastLineVal{};
+        std::vector<GInt32> anLastLineId{};
+    };
+
+    std::vector<GInt32> anGlobalMap;
+    std::vector<GInt32> anStripIdOffset(nStrips);
+    std::vector<DataType> anPrevLastLineVal;
+    std::vector<GInt32> anPrevLastLineId;
+
+    const auto FindRoot = [&anGlobalMap](GInt32 nId)
+    {
+        while (anGlobalMap[nId] != nId)
+        {
+            anGlobalMap[nId] = anGlobalMap[anGlobalMap[nId]];
+            nId = anGlobalMap[nId];
+        }
+        return nId;
+    };
+
+    const auto Merge = [&anGlobalMap, &FindRoot](GInt32 nId1, GInt32 nId2)
+    {
+        const GInt32 nRoot1 = FindRoot(nId1);
+        const GInt32 nRoot2 = FindRoot(nId2);
+        if (nRoot1 < nRoot2)
+            anGlobalMap[nRoot2] = nRoot1;
+        else if (nRoot2 < nRoot1)
+            anGlobalMap[nRoot1] = nRoot2;
+    };
+
+    const auto ProcessLabelStrip = [&](int iStrip, LabelStrip &oStrip)
+    {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oEnum(
+            nConnectedness);
+        std::vector<DataType> anVal;
+        std::vector<GInt32> anId;
+        if (!GPReadAndLabelStrip(hTSSrcBand, hTSMaskBand, eDT, nXSize, nYOff,
+                                 nLines, oEnum, anVal, anId))
+            return false;
+
+        oStrip.anPolyIdMap.assign(oEnum.panPolyIdMap,
+                                  oEnum.panPolyIdMap + oEnum.nNextPolygonId);
+        const size_t nLastOffset = static_cast<size_t>(nLines - 1) * nXSize;
+        oStrip.anFirstLineVal.assign(anVal.begin(), anVal.begin() + nXSize);
+        oStrip.anFirstLineId.assign(anId.begin(), anId.begin() + nXSize);
+        oStrip.anLastLineVal.assign(anVal.begin() + nLastOffset, anVal.end());
+        oStrip.anLastLineId.assign(anId.begin() + nLastOffset, anId.end());
+        return true;
+    };
+
+    const auto ConsumeLabelStrip = [&](int iStrip, LabelStrip &oStrip)
+    {
+        const size_t nOldSize = anGlobalMap.size();
+        if (nOldSize + oStrip.anPolyIdMap.size() >=
+            static_cast<size_t>(std::numeric_limits<GInt32>::max()))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALPolygonize(): maximum number of polygons reached");
+            return false;
+        }
+        const GInt32 nIdOffset = static_cast<GInt32>(nOldSize);
+        anStripIdOffset[iStrip] = nIdOffset;
+        anGlobalMap.resize(nOldSize + oStrip.anPolyIdMap.size());
+        for (size_t i = 0; i < oStrip.anPolyIdMap.size(); ++i)
+            anGlobalMap[nOldSize + i] = oStrip.anPolyIdMap[i] + nIdOffset;
+
+        // Merge polygons connected across the boundary with the previous
+        // strip, following the same connectivity rules as ProcessLine().
+        if (iStrip > 0)
+        {
+            EqualityTest eq;
+            const GInt32 nPrevIdOffset = anStripIdOffset[iStrip - 1];
+            for (int i = 0; i < nXSize; i++)
+            {
+                if (oStrip.anFirstLineId[i] < 0)
+                    continue;
+                const GInt32 nId = oStrip.anFirstLineId[i] + nIdOffset;
+                const DataType nVal = oStrip.anFirstLineVal[i];
+                const int iStart = nConnectedness == 8 ? std::max(0, i - 1) : i;
+                const int iEnd =
+                    nConnectedness == 8 ? std::min(nXSize - 1, i + 1) : i;
+                for (int j = iStart; j <= iEnd; ++j)
+                {
+                    if (anPrevLastLineId[j] >= 0 &&
+                        eq.operator()(anPrevLastLineVal[j], nVal))
+                    {
+                        Merge(anPrevLastLineId[j] + nPrevIdOffset, nId);
+                    }
+                }
+            }
+        }
+
+        anPrevLastLineVal = std::move(oStrip.anLastLineVal);
+        anPrevLastLineId = std::move(oStrip.anLastLineId);
+
+        if (!pfnProgress(0.10 * ((iStrip + 1) / static_cast<double>(nStrips)),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+        return true;
+    };
+
+    bool bOK = GPProcessStripsInOrder<LabelStrip>(
+        poQueue.get(), nStrips, nMaxInFlight, oErrorAccumulator,
+        ProcessLabelStrip, ConsumeLabelStrip);
+
+    // Make every polygon id point to its final id.
+    if (bOK)
+    {
+        anPrevLastLineVal.clear();
+        anPrevLastLineId.clear();
+        for (size_t i = 0; i < anGlobalMap.size(); ++i)
+            anGlobalMap[i] = FindRoot(static_cast<GInt32>(i));
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: collect polygon edges as geometries.               */
+    /* -------------------------------------------------------------------- */
+    OGRPolygonWriter<DataType> oPolygonWriter{hOutLayer, iPixValField,
+                                              padfGeoTransform};
+    Polygonizer<GInt32, DataType> oPolygonizer{-1, &oPolygonWriter};
+    std::vector<TwoArm> aoArms1;
+    std::vector<TwoArm> aoArms2;
+    std::vector<DataType> anLastLineVal;
+    TwoArm *paoLastLineArm = nullptr;
+    TwoArm *paoThisLineArm = nullptr;
+    if (bOK)
+    {
+        try
+        {
+            aoArms1.resize(nXSize + 2);
+            aoArms2.resize(nXSize + 2);
+            anLastLineVal.resize(nXSize);
+            paoLastLineArm = aoArms1.data();
+            paoThisLineArm = aoArms2.data();
+            for (int i = 0; i < nXSize + 2; ++i)
+            {
+                paoLastLineArm[i].poPolyInside =
+                    oPolygonizer.getTheOuterPolygon();
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize()");
+            bOK = false;
+        }
+    }
+
+    struct PolygonizeStrip
+    {
+        std::vector<DataType> anVal{};
+        std::vector<GInt32> anId{};
+    };
+
+    const auto ProcessPolygonizeStrip =
+        [&](int iStrip, PolygonizeStrip &oStrip)
+    {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oEnum(
+            nConnectedness);
+        if (!GPReadAndLabelStrip(hTSSrcBand, hTSMaskBand, eDT, nXSize, nYOff,
+                                 nLines, oEnum, oStrip.anVal, oStrip.anId))
+            return false;
+        const GInt32 nIdOffset = anStripIdOffset[iStrip];
+        for (auto &nId : oStrip.anId)
+        {
+            if (nId >= 0)
+                nId = anGlobalMap[nId + nIdOffset];
+        }
+        return true;
+    };
+
+    const auto ConsumePolygonizeStrip =
+        [&](int iStrip, PolygonizeStrip &oStrip)
+    {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        for (int iLine = 0; iLine < nLines; iLine++)
+        {
+            const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+            if (!oPolygonizer.processLine(oStrip.anId.data() + nOffset,
+                                          anLastLineVal.data(), paoThisLineArm,
+                                          paoLastLineArm, nYOff + iLine,
+                                          nXSize) ||
+                oPolygonWriter.getErr() != CE_None)
+            {
+                return false;
+            }
+            std::copy(oStrip.anVal.begin() + nOffset,
+                      oStrip.anVal.begin() + nOffset + nXSize,
+                      anLastLineVal.begin());
+            std::swap(paoThisLineArm, paoLastLineArm);
+        }
+
+        if (!pfnProgress(std::min(1.0, 0.10 + 0.90 * ((nYOff + nLines) /
+                                                      static_cast<double>(
+                                                          nYSize))),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+        return true;
+    };
+
+    if (bOK)
+    {
+        bOK = GPProcessStripsInOrder<PolygonizeStrip>(
+            poQueue.get(), nStrips, nMaxInFlight, oErrorAccumulator,
+            ProcessPolygonizeStrip, ConsumePolygonizeStrip);
+    }
+
+    // Close the polygons touching the bottom of the raster.
+    if (bOK)
+    {
+        try
+        {
+            std::vector<GInt32> anOuterLineId(
+                nXSize, decltype(oPolygonizer)::THE_OUTER_POLYGON_ID);
+            bOK = oPolygonizer.processLine(anOuterLineId.data(),
+                                           anLastLineVal.data(), paoThisLineArm,
+                                           paoLastLineArm, nYSize, nXSize) &&
+                  oPolygonWriter.getErr() == CE_None;
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize()");
+            bOK = false;
+        }
+    }
+
+    oErrorAccumulator.ReplayErrors();
+    ReleaseDatasets();
+
+    eErr = bOK ? CE_None : CE_Failure;
+    return true;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -166,6 +676,34 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Use the multi-threaded implementation if requested and          */
+    /*      possible.                                                       */
+    /* -------------------------------------------------------------------- */
+    // GDAL_NUM_THREADS is deliberately not used as the default, as the
+    // multi-threaded implementation may emit polygons in a different order.
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS", "1");
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    if (nThreads > 1)
+    {
+        CPLErr eMTErr = CE_None;
+        if (GDALPolygonizeMultiThreadedT<DataType, EqualityTest>(
+                hSrcBand, hMaskBand, hOutLayer, iPixValField, adfGeoTransform,
+                nConnectedness, nThreads, pfnProgress, pProgressArg, eDT,
+                eMTErr))
+        {
+            CPLFree(panThisLineId);
+            CPLFree(panLastLineId);
+            CPLFree(panThisLineVal);
+            CPLFree(panLastLineVal);
+            CPLFree(pabyMaskLine);
+            return eMTErr;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -489,6 +1027,13 @@ GBool GDALFloatEquals(float A, float B)
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=num|ALL_CPUS: (GDAL >= 3.12) Number of worker threads.
+ * Defaults to 1. The GDAL_NUM_THREADS configuration option is not used.
+ * When greater than 1, strips of lines are read and their pixels assigned
+ * to polygons in parallel. Polygons spanning several strips are merged
+ * before their edges are traced. The polygon geometries are the same as
+ * in single-threaded mode, but polygons completed on the same line may be
+ * emitted in a different order.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -563,6 +1108,13 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=num|ALL_CPUS: (GDAL >= 3.12) Number of worker threads.
+ * Defaults to 1. The GDAL_NUM_THREADS configuration option is not used.
+ * When greater than 1, strips of lines are read and their pixels assigned
+ * to polygons in parallel. Polygons spanning several strips are merged
+ * before their edges are traced. The polygon geometries are the same as
+ * in single-threaded mode, but polygons completed on the same line may be
+ * emitted in a different order.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -19,16 +19,22 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALFilterLine()                           */
@@ -344,6 +350,493 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+/************************************************************************/
+/*                         GDALFillNodataLine()                         */
+/*                                                                      */
+/*      Interpolate the nodata pixels of line iY in [nXStart, nXEnd),   */
+/*      from the closest valid pixel of each column above it (top-down  */
+/*      pass, including the current line) and below it.                 */
+/************************************************************************/
+
+static void GDALFillNodataLine(int iY, int nXStart, int nXEnd, int nXSize,
+                               const GUInt32 *panTopDownY,
+                               const float *pafTopDownValue,
+                               const GUInt32 *panLastY,
+                               const float *pafLastValue, GByte *pabyMask,
+                               GByte *pabyFiltMask, float *pafScanline,
+                               double dfMaxSearchDist, int nMaxSearchDist,
+                               bool bNearest, bool bHasNoData, float fNoData,
+                               GUInt32 nNoDataVal)
+{
+    for (int iX = nXStart; iX < nXEnd; iX++)
+    {
+        int nThisMaxSearchDist = nMaxSearchDist;
+
+        // If this was a valid target - no change.
+        if (pabyMask[iX])
+            continue;
+
+        enum Quadrants
+        {
+            QUAD_TOP_LEFT = 0,
+            QUAD_BOTTOM_LEFT = 1,
+            QUAD_TOP_RIGHT = 2,
+            QUAD_BOTTOM_RIGHT = 3,
+        };
+
+        constexpr int QUAD_COUNT = 4;
+        double adfQuadDist[QUAD_COUNT] = {};
+        float afQuadValue[QUAD_COUNT] = {};
+
+        for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+        {
+            adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+            afQuadValue[iQuad] = 0.0;
+        }
+
+        // Step left and right by one pixel searching for the closest
+        // target value for each quadrant.
+        for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+        {
+            const int iLeftX = std::max(0, iX - iStep);
+            const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+            // Top left includes current line.
+            QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT],
+                       afQuadValue[QUAD_TOP_LEFT], iLeftX,
+                       panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
+                       nNoDataVal);
+
+            // Bottom left.
+            QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
+                       afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
+                       panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
+                       nNoDataVal);
+
+            // Top right and bottom right do no include center pixel.
+            if (iStep == 0)
+                continue;
+
+            // Top right includes current line.
+            QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT],
+                       afQuadValue[QUAD_TOP_RIGHT], iRightX,
+                       panTopDownY[iRightX], iX, iY,
+                       pafTopDownValue[iRightX], nNoDataVal);
+
+            // Bottom right.
+            QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
+                       afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
+                       panLastY[iRightX], iX, iY, pafLastValue[iRightX],
+                       nNoDataVal);
+
+            // Every four steps, recompute maximum distance.
+            if ((iStep & 0x3) == 0)
+                nThisMaxSearchDist = static_cast<int>(floor(
+                    std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                             std::max(adfQuadDist[2], adfQuadDist[3]))));
+        }
+
+        bool bHasSrcValues = false;
+        if (bNearest)
+        {
+            double dfNearestDist = dfMaxSearchDist + 1;
+            float fNearestValue = 0.0f;
+
+            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+            {
+                if (adfQuadDist[iQuad] < dfNearestDist)
+                {
+                    bHasSrcValues = true;
+                    if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                    {
+                        fNearestValue = afQuadValue[iQuad];
+                        dfNearestDist = adfQuadDist[iQuad];
+                    }
+                }
+            }
+
+            if (bHasSrcValues)
+            {
+                pabyFiltMask[iX] = 255;
+                if (dfNearestDist <= dfMaxSearchDist)
+                {
+                    pabyMask[iX] = 255;
+                    pafScanline[iX] = fNearestValue;
+                }
+                else
+                    pafScanline[iX] = fNoData;
+            }
+        }
+        else
+        {
+            double dfWeightSum = 0.0;
+            double dfValueSum = 0.0;
+
+            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+            {
+                if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+                {
+                    bHasSrcValues = true;
+                    if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                    {
+                        const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                        dfWeightSum += dfWeight;
+                        dfValueSum += afQuadValue[iQuad] * dfWeight;
+                    }
+                }
+            }
+
+            if (bHasSrcValues)
+            {
+                pabyFiltMask[iX] = 255;
+                if (dfWeightSum > 0.0)
+                {
+                    pabyMask[iX] = 255;
+                    pafScanline[iX] =
+                        static_cast<float>(dfValueSum / dfWeightSum);
+                }
+                else
+                    pafScanline[iX] = fNoData;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                        GDALFillNodataSmooth()                        */
+/*                                                                      */
+/*      Run the smoothing iterations on the pixels set in               */
+/*      hFiltMaskBand, reporting progress from dfProgressStart to 1.    */
+/************************************************************************/
+
+static CPLErr GDALFillNodataSmooth(GDALRasterBandH hTargetBand,
+                                   GDALRasterBandH hMaskBand,
+                                   bool bMaskIsWorkCopy,
+                                   GDALRasterBandH hFiltMaskBand,
+                                   int nSmoothingIterations,
+                                   double dfProgressStart,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressArg)
+{
+    if (!bMaskIsWorkCopy)
+    {
+        // Force masks to be to flushed and recomputed when the user
+        // didn't pass a user-provided hMaskBand, and we assigned it
+        // to be the mask band of hTargetBand.
+        GDALFlushRasterCache(hMaskBand);
+    }
+
+    void *pScaledProgress = GDALCreateScaledProgress(dfProgressStart, 1.0,
+                                                     pfnProgress, pProgressArg);
+
+    const CPLErr eErr = GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
+                                        nSmoothingIterations,
+                                        GDALScaledProgress, pScaledProgress);
+
+    GDALDestroyScaledProgress(pScaledProgress);
+    return eErr;
+}
+
+/************************************************************************/
+/*                     GDALFillNodataMultiThreaded()                    */
+/*                                                                      */
+/*      Same interpolation as the line by line passes of                */
+/*      GDALFillNodata(), done on tiles of nTileSize x nTileSize        */
+/*      pixels processed in parallel. Each tile is read with a halo of  */
+/*      nHalo pixels, enough for the searches of its own pixels, so     */
+/*      that the result is identical. Tiles must be interpolated from   */
+/*      the original pixels, so they write to temporary files that are */
+/*      copied to the target band (and the work copy of the mask) once  */
+/*      all tiles are done.                                             */
+/************************************************************************/
+
+static CPLErr GDALFillNodataMultiThreaded(
+    GDALRasterBandH hTargetBand, GDALRasterBandH hMaskBand,
+    bool bMaskIsWorkCopy, GDALDriverH hDriver, CSLConstList papszWorkFileOptions,
+    const CPLString &osTmpFile, double dfMaxSearchDist, int nMaxSearchDist,
+    bool bNearest, bool bHasNoData, float fNoData, GUInt32 nNoDataVal,
+    int nTileSize, int nHalo, int nThreads, int nSmoothingIterations,
+    double dfProgressRatio, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Create the work files.                                          */
+    /* -------------------------------------------------------------------- */
+    const auto CreateWorkFile = [&](const char *pszSuffix, GDALDataType eDT)
+    {
+        std::unique_ptr<GDALDataset> poDS(GDALDataset::FromHandle(
+            GDALCreate(hDriver, (osTmpFile + pszSuffix).c_str(), nXSize,
+                       nYSize, 1, eDT, papszWorkFileOptions)));
+        if (poDS == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Could not create %s work file. Check driver "
+                     "capabilities.",
+                     pszSuffix);
+        }
+        else
+        {
+            poDS->MarkSuppressOnClose();
+        }
+        return poDS;
+    };
+
+    auto poValDS = CreateWorkFile("fill_val_work.tif", GDT_Float32);
+    auto poFiltMaskDS = CreateWorkFile("fill_filtmask_work.tif", GDT_Byte);
+    std::unique_ptr<GDALDataset> poNewMaskDS;
+    if (bMaskIsWorkCopy)
+        poNewMaskDS = CreateWorkFile("fill_newmask_work.tif", GDT_Byte);
+    if (poValDS == nullptr || poFiltMaskDS == nullptr ||
+        (bMaskIsWorkCopy && poNewMaskDS == nullptr))
+    {
+        return CE_Failure;
+    }
+    GDALRasterBandH hValBand = GDALRasterBand::ToHandle(poValDS->GetRasterBand(1));
+    GDALRasterBandH hFiltMaskBand =
+        GDALRasterBand::ToHandle(poFiltMaskDS->GetRasterBand(1));
+    GDALRasterBandH hNewMaskBand =
+        poNewMaskDS ? GDALRasterBand::ToHandle(poNewMaskDS->GetRasterBand(1))
+                    : nullptr;
+
+    const int nXTiles = DIV_ROUND_UP(nXSize, nTileSize);
+    const int nYTiles = DIV_ROUND_UP(nYSize, nTileSize);
+    const int nTiles = nXTiles * nYTiles;
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    if (!poPool)
+        return CE_Failure;
+    auto poQueue = poPool->CreateJobQueue();
+
+    CPLErrorAccumulator oErrorAccumulator;
+    std::mutex oIOMutex;
+    std::mutex oProgressMutex;
+    std::condition_variable oProgressCV;
+    std::atomic<bool> bError{false};
+    std::atomic<int> nNextTile{0};
+    int nTilesDone = 0;
+    int nJobsDone = 0;
+
+    /* -------------------------------------------------------------------- */
+    /*      Process one tile.                                               */
+    /* -------------------------------------------------------------------- */
+    const auto ProcessTile = [&](int iTile)
+    {
+        const int nCoreXOff = (iTile % nXTiles) * nTileSize;
+        const int nCoreYOff = (iTile / nXTiles) * nTileSize;
+        const int nCoreXSize = std::min(nTileSize, nXSize - nCoreXOff);
+        const int nCoreYSize = std::min(nTileSize, nYSize - nCoreYOff);
+
+        const int nWinXOff = std::max(0, nCoreXOff - nHalo);
+        const int nWinYOff = std::max(0, nCoreYOff - nHalo);
+        const int nWinXSize =
+            std::min(nXSize, nCoreXOff + nCoreXSize + nHalo) - nWinXOff;
+        const int nWinYSize =
+            std::min(nYSize, nCoreYOff + nCoreYSize + nHalo) - nWinYOff;
+        const size_t nWinPixels = static_cast<size_t>(nWinXSize) * nWinYSize;
+
+        std::vector<GByte> abyMask(nWinPixels);
+        std::vector<float> afValues(nWinPixels);
+        {
+            std::lock_guard<std::mutex> oLock(oIOMutex);
+            if (GDALRasterIO(hMaskBand, GF_Read, nWinXOff, nWinYOff, nWinXSize,
+                             nWinYSize, abyMask.data(), nWinXSize, nWinYSize,
+                             GDT_Byte, 0, 0) != CE_None ||
+                GDALRasterIO(hTargetBand, GF_Read, nWinXOff, nWinYOff,
+                             nWinXSize, nWinYSize, afValues.data(), nWinXSize,
+                             nWinYSize, GDT_Float32, 0, 0) != CE_None)
+            {
+                bError = true;
+                return;
+            }
+        }
+
+        // Top to bottom pass: last valid line of each column, kept for all
+        // lines of the window.
+        std::vector<GUInt32> anTopDownY(nWinPixels);
+        std::vector<float> afTopDownValue(nWinPixels);
+        std::vector<GUInt32> anLastY(nWinXSize, nNoDataVal);
+        std::vector<float> afLastValue(nWinXSize);
+        for (int iLine = 0; iLine < nWinYSize; iLine++)
+        {
+            const int iY = nWinYOff + iLine;
+            const size_t nOff = static_cast<size_t>(iLine) * nWinXSize;
+            GUInt32 *panThisY = anTopDownY.data() + nOff;
+            float *pafThisValue = afTopDownValue.data() + nOff;
+            for (int iX = 0; iX < nWinXSize; iX++)
+            {
+                if (abyMask[nOff + iX])
+                {
+                    pafThisValue[iX] = afValues[nOff + iX];
+                    panThisY[iX] = iY;
+                }
+                else if (iY <= dfMaxSearchDist + anLastY[iX])
+                {
+                    pafThisValue[iX] = afLastValue[iX];
+                    panThisY[iX] = anLastY[iX];
+                }
+                else
+                {
+                    panThisY[iX] = nNoDataVal;
+                }
+            }
+            std::copy_n(panThisY, nWinXSize, anLastY.begin());
+            std::copy_n(pafThisValue, nWinXSize, afLastValue.begin());
+        }
+
+        // Bottom to top pass, interpolating the lines of the tile.
+        std::vector<GByte> abyFiltMask(nWinPixels);
+        std::vector<GUInt32> anThisY(nWinXSize);
+        std::vector<float> afThisValue(nWinXSize);
+        std::fill(anLastY.begin(), anLastY.end(), nNoDataVal);
+        const int nCoreXStart = nCoreXOff - nWinXOff;
+        for (int iLine = nWinYSize - 1; iLine >= 0; iLine--)
+        {
+            const int iY = nWinYOff + iLine;
+            const size_t nOff = static_cast<size_t>(iLine) * nWinXSize;
+            for (int iX = 0; iX < nWinXSize; iX++)
+            {
+                if (abyMask[nOff + iX])
+                {
+                    afThisValue[iX] = afValues[nOff + iX];
+                    anThisY[iX] = iY;
+                }
+                else if (anLastY[iX] - iY <= dfMaxSearchDist)
+                {
+                    afThisValue[iX] = afLastValue[iX];
+                    anThisY[iX] = anLastY[iX];
+                }
+                else
+                {
+                    anThisY[iX] = nNoDataVal;
+                }
+            }
+
+            if (iY >= nCoreYOff && iY < nCoreYOff + nCoreYSize)
+            {
+                GDALFillNodataLine(
+                    iY, nCoreXStart, nCoreXStart + nCoreXSize, nWinXSize,
+                    anTopDownY.data() + nOff, afTopDownValue.data() + nOff,
+                    anLastY.data(), afLastValue.data(), abyMask.data() + nOff,
+                    abyFiltMask.data() + nOff, afValues.data() + nOff,
+                    dfMaxSearchDist, nMaxSearchDist, bNearest, bHasNoData,
+                    fNoData, nNoDataVal);
+            }
+
+            std::swap(anThisY, anLastY);
+            std::swap(afThisValue, afLastValue);
+        }
+
+        // Write the tile.
+        const size_t nCoreOff =
+            static_cast<size_t>(nCoreYOff - nWinYOff) * nWinXSize +
+            nCoreXStart;
+        const GSpacing nLineSpace = nWinXSize;
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        if (GDALRasterIOEx(hValBand, GF_Write, nCoreXOff, nCoreYOff,
+                           nCoreXSize, nCoreYSize, afValues.data() + nCoreOff,
+                           nCoreXSize, nCoreYSize, GDT_Float32, sizeof(float),
+                           nLineSpace * sizeof(float), nullptr) != CE_None ||
+            GDALRasterIOEx(hFiltMaskBand, GF_Write, nCoreXOff, nCoreYOff,
+                           nCoreXSize, nCoreYSize,
+                           abyFiltMask.data() + nCoreOff, nCoreXSize,
+                           nCoreYSize, GDT_Byte, 1, nLineSpace,
+                           nullptr) != CE_None ||
+            (hNewMaskBand &&
+             GDALRasterIOEx(hNewMaskBand, GF_Write, nCoreXOff, nCoreYOff,
+                            nCoreXSize, nCoreYSize, abyMask.data() + nCoreOff,
+                            nCoreXSize, nCoreYSize, GDT_Byte, 1, nLineSpace,
+                            nullptr) != CE_None))
+        {
+            bError = true;
+        }
+    };
+
+    const auto ProcessTiles = [&]()
+    {
+        auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+        CPL_IGNORE_RET_VAL(oAccumulator);
+        int iTile;
+        while (!bError && (iTile = nNextTile++) < nTiles)
+        {
+            try
+            {
+                ProcessTile(iTile);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in GDALFillNodata()");
+                bError = true;
+            }
+            std::lock_guard<std::mutex> oLock(oProgressMutex);
+            ++nTilesDone;
+            oProgressCV.notify_one();
+        }
+        std::lock_guard<std::mutex> oLock(oProgressMutex);
+        ++nJobsDone;
+        oProgressCV.notify_one();
+    };
+
+    const int nJobs = std::min(nThreads, nTiles);
+    for (int iJob = 0; iJob < nJobs; ++iJob)
+    {
+        if (!poQueue->SubmitJob(ProcessTiles))
+            ProcessTiles();
+    }
+
+    // The copy of the work files to the target band accounts for the last
+    // 10% of the interpolation progress.
+    {
+        std::unique_lock<std::mutex> oLock(oProgressMutex);
+        int nLastTilesDone = 0;
+        while (nJobsDone < nJobs)
+        {
+            oProgressCV.wait(oLock,
+                             [&]() {
+                                 return nTilesDone != nLastTilesDone ||
+                                        nJobsDone == nJobs;
+                             });
+            nLastTilesDone = nTilesDone;
+            if (!bError &&
+                !pfnProgress(dfProgressRatio * 0.9 * nLastTilesDone / nTiles,
+                             "Filling...", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bError = true;
+            }
+        }
+    }
+    poQueue->WaitCompletion();
+    oErrorAccumulator.ReplayErrors();
+    if (bError)
+        return CE_Failure;
+
+    /* -------------------------------------------------------------------- */
+    /*      Copy the interpolated values to the target band.                */
+    /* -------------------------------------------------------------------- */
+    void *pScaledProgress = GDALCreateScaledProgress(
+        dfProgressRatio * 0.9, dfProgressRatio, pfnProgress, pProgressArg);
+    CPLErr eErr = GDALRasterBandCopyWholeRaster(
+        hValBand, hTargetBand, nullptr, GDALScaledProgress, pScaledProgress);
+    GDALDestroyScaledProgress(pScaledProgress);
+    if (eErr == CE_None && hNewMaskBand)
+    {
+        eErr = GDALRasterBandCopyWholeRaster(hNewMaskBand, hMaskBand, nullptr,
+                                             nullptr, nullptr);
+    }
+
+    if (eErr == CE_None && nSmoothingIterations > 0)
+    {
+        eErr = GDALFillNodataSmooth(hTargetBand, hMaskBand, bMaskIsWorkCopy,
+                                    hFiltMaskBand, nSmoothingIterations,
+                                    dfProgressRatio, pfnProgress, pProgressArg);
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -384,6 +877,12 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * <li>INTERPOLATION=INV_DIST/NEAREST (GDAL >= 3.9). By default, pixels are
  * interpolated using an inverse distance weighting (INV_DIST). It is also
  * possible to choose a nearest neighbour (NEAREST) strategy.</li>
+ * <li>NUM_THREADS=num|ALL_CPUS (GDAL >= 3.12). Number of worker threads.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * When more than one thread is used, and the raster is large compared to
+ * dfMaxSearchDist, the interpolation is done in parallel on tiles read with a
+ * halo of dfMaxSearchDist pixels, which bounds memory use. Results are
+ * identical to the single-threaded ones.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -521,6 +1020,38 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Use the tiled multithreaded implementation if requested, and if */
+    /*      the raster is large compared to the search distance.            */
+    /* -------------------------------------------------------------------- */
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    if (nThreads > 1)
+    {
+        // The searches may go one pixel beyond nMaxSearchDist, plus the line
+        // below for the bottom-up pass.
+        const int nHalo = nMaxSearchDist + 2;
+        int nTileSize = std::max(256, 2 * nHalo);
+        // For testing purposes
+        const char *pszTileSize =
+            CPLGetConfigOption("GDAL_FILLNODATA_TILE_SIZE", nullptr);
+        if (pszTileSize)
+            nTileSize = std::max(1, atoi(pszTileSize));
+        if (nTileSize < nXSize || nTileSize < nYSize)
+        {
+            return GDALFillNodataMultiThreaded(
+                hTargetBand, hMaskBand, poTmpMaskDS != nullptr, hDriver,
+                aosWorkFileOptions.List(), osTmpFile, dfMaxSearchDist,
+                nMaxSearchDist, bNearest, bHasNoData, fNoData, nNoDataVal,
+                nTileSize, nHalo, nThreads, nSmoothingIterations,
+                dfProgressRatio, pfnProgress, pProgressArg);
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Create a work file to hold the Y "last value" indices.          */
     /* -------------------------------------------------------------------- */
@@ -781,138 +1312,10 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         /* --------------------------------------------------------------------
          */
         memset(pabyFiltMask, 0, nXSize);
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if (pabyMask[iX])
-                continue;
-
-            enum Quadrants
-            {
-                QUAD_TOP_LEFT = 0,
-                QUAD_BOTTOM_LEFT = 1,
-                QUAD_TOP_RIGHT = 2,
-                QUAD_BOTTOM_RIGHT = 3,
-            };
-
-            constexpr int QUAD_COUNT = 4;
-            double adfQuadDist[QUAD_COUNT] = {};
-            float afQuadValue[QUAD_COUNT] = {};
-
-            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                afQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT],
-                           afQuadValue[QUAD_TOP_LEFT], iLeftX,
-                           panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
-                           nNoDataVal);
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
-                           afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
-                           panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
-                           nNoDataVal);
-
-                // Top right and bottom right do no include center pixel.
-                if (iStep == 0)
-                    continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT],
-                           afQuadValue[QUAD_TOP_RIGHT], iRightX,
-                           panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal);
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
-                           afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
-                           panLastY[iRightX], iX, iY, pafLastValue[iRightX],
-                           nNoDataVal);
-
-                // Every four steps, recompute maximum distance.
-                if ((iStep & 0x3) == 0)
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            bool bHasSrcValues = false;
-            if (bNearest)
-            {
-                double dfNearestDist = dfMaxSearchDist + 1;
-                float fNearestValue = 0.0f;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] < dfNearestDist)
-                    {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            fNearestValue = afQuadValue[iQuad];
-                            dfNearestDist = adfQuadDist[iQuad];
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfNearestDist <= dfMaxSearchDist)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] = fNearestValue;
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
-            }
-            else
-            {
-                double dfWeightSum = 0.0;
-                double dfValueSum = 0.0;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] <= dfMaxSearchDist)
-                    {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                            dfWeightSum += dfWeight;
-                            dfValueSum += afQuadValue[iQuad] * dfWeight;
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfWeightSum > 0.0)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] =
-                            static_cast<float>(dfValueSum / dfWeightSum);
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
-            }
-        }
+        GDALFillNodataLine(iY, 0, nXSize, nXSize, panTopDownY, pafTopDownValue,
+                           panLastY, pafLastValue, pabyMask, pabyFiltMask,
+                           pafScanline, dfMaxSearchDist, nMaxSearchDist,
+                           bNearest, bHasNoData, fNoData, nNoDataVal);
 
         /* --------------------------------------------------------------------
          */
@@ -972,22 +1375,10 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     /* ==================================================================== */
     if (eErr == CE_None && nSmoothingIterations > 0)
     {
-        if (poTmpMaskDS == nullptr)
-        {
-            // Force masks to be to flushed and recomputed when the user
-            // didn't pass a user-provided hMaskBand, and we assigned it
-            // to be the mask band of hTargetBand.
-            GDALFlushRasterCache(hMaskBand);
-        }
-
-        void *pScaledProgress = GDALCreateScaledProgress(
-            dfProgressRatio, 1.0, pfnProgress, pProgressArg);
-
-        eErr = GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
-                               nSmoothingIterations, GDALScaledProgress,
-                               pScaledProgress);
-
-        GDALDestroyScaledProgress(pScaledProgress);
+        eErr = GDALFillNodataSmooth(hTargetBand, hMaskBand,
+                                    poTmpMaskDS != nullptr, hFiltMaskBand,
+                                    nSmoothingIterations, dfProgressRatio,
+                                    pfnProgress, pProgressArg);
     }
 
 /* -------------------------------------------------------------------- */
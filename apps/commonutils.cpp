@@ -12,14 +12,19 @@
 
 #include "commonutils.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
 #include <string>
 
 #include "cpl_conv.h"
+#include "cpl_error_internal.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /* -------------------------------------------------------------------- */
 /*                         GetOutputDriversFor()                        */
@@ -227,3 +232,152 @@ bool GDALPatternMatch(const char *input, const char *pattern)
     else
         return true;
 }
+
+/************************************************************************/
+/*                 GDALDatasetOpenPrefetcher::Job                       */
+/************************************************************************/
+
+struct GDALDatasetOpenPrefetcher::Job
+{
+    std::string osFilename{};
+    std::unique_ptr<GDALDataset> poDS{};
+    CPLErrorAccumulator oErrorAccumulator{};
+    bool bSubmitted = false;
+    bool bDone = false;
+};
+
+/************************************************************************/
+/*                     GDALDatasetOpenPrefetcher()                      */
+/************************************************************************/
+
+GDALDatasetOpenPrefetcher::GDALDatasetOpenPrefetcher(
+    unsigned int nOpenFlags, CSLConstList papszOpenOptions)
+    : m_nOpenFlags(nOpenFlags), m_aosOpenOptions(papszOpenOptions)
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    if (nThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+        {
+            m_poJobQueue = poThreadPool->CreateJobQueue();
+            // Keep a few datasets in advance per thread so that workers do
+            // not starve while the caller processes the current one.
+            m_nMaxPending = static_cast<size_t>(nThreads) * 4;
+        }
+    }
+}
+
+/************************************************************************/
+/*                    ~GDALDatasetOpenPrefetcher()                      */
+/************************************************************************/
+
+GDALDatasetOpenPrefetcher::~GDALDatasetOpenPrefetcher()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                 GDALDatasetOpenPrefetcher::Submit()                  */
+/************************************************************************/
+
+void GDALDatasetOpenPrefetcher::Submit(const std::string &osFilename)
+{
+    auto poJob = std::make_unique<Job>();
+    poJob->osFilename = osFilename;
+    Job *psJob = poJob.get();
+    m_apoJobs.push_back(std::move(poJob));
+    if (!m_poJobQueue)
+        return;
+
+    const auto OpenJob = [this, psJob]()
+    {
+        std::unique_ptr<GDALDataset> poDS;
+        {
+            auto oContext = psJob->oErrorAccumulator.InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oContext);
+            poDS.reset(GDALDataset::Open(psJob->osFilename.c_str(),
+                                         m_nOpenFlags, nullptr,
+                                         m_aosOpenOptions.List(), nullptr));
+            if (poDS)
+            {
+                // Fetch the properties that the callers inspect, as drivers
+                // often load them lazily, and that may involve extra I/O
+                // (side-car files, ...)
+                GDALGeoTransform gt;
+                CPL_IGNORE_RET_VAL(poDS->GetGeoTransform(gt));
+                CPL_IGNORE_RET_VAL(poDS->GetSpatialRef());
+                for (int i = 1; i <= poDS->GetRasterCount(); ++i)
+                {
+                    auto poBand = poDS->GetRasterBand(i);
+                    CPL_IGNORE_RET_VAL(poBand->GetNoDataValue());
+                    CPL_IGNORE_RET_VAL(poBand->GetColorTable());
+                    CPL_IGNORE_RET_VAL(poBand->GetMaskFlags());
+                }
+            }
+        }
+        std::lock_guard oLock(m_oMutex);
+        psJob->poDS = std::move(poDS);
+        psJob->bDone = true;
+        m_oCV.notify_all();
+    };
+    // If submission fails, the dataset will be opened synchronously by
+    // Next()
+    psJob->bSubmitted = m_poJobQueue->SubmitJob(OpenJob);
+}
+
+/************************************************************************/
+/*             GDALDatasetOpenPrefetcher::GetNextFilename()             */
+/************************************************************************/
+
+/** Return the filename of the dataset that Next() will return. */
+const std::string &GDALDatasetOpenPrefetcher::GetNextFilename() const
+{
+    CPLAssert(!m_apoJobs.empty());
+    return m_apoJobs.front()->osFilename;
+}
+
+/************************************************************************/
+/*                  GDALDatasetOpenPrefetcher::Next()                   */
+/************************************************************************/
+
+/** Return the oldest submitted dataset (or nullptr if it could not be
+ * opened), after having replayed the errors emitted while opening it. */
+std::unique_ptr<GDALDataset> GDALDatasetOpenPrefetcher::Next()
+{
+    CPLAssert(!m_apoJobs.empty());
+    auto poJob = std::move(m_apoJobs.front());
+    m_apoJobs.pop_front();
+    if (poJob->bSubmitted)
+    {
+        std::unique_lock oLock(m_oMutex);
+        m_oCV.wait(oLock, [&poJob] { return poJob->bDone; });
+        oLock.unlock();
+        poJob->oErrorAccumulator.ReplayErrors();
+        return std::move(poJob->poDS);
+    }
+    return std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(poJob->osFilename.c_str(), m_nOpenFlags, nullptr,
+                          m_aosOpenOptions.List(), nullptr));
+}
+
+/************************************************************************/
+/*                GDALDatasetOpenPrefetcher::SkipNext()                 */
+/************************************************************************/
+
+/** Discard the oldest submitted dataset, silently. */
+void GDALDatasetOpenPrefetcher::SkipNext()
+{
+    CPLAssert(!m_apoJobs.empty());
+    auto poJob = std::move(m_apoJobs.front());
+    m_apoJobs.pop_front();
+    if (poJob->bSubmitted)
+    {
+        std::unique_lock oLock(m_oMutex);
+        m_oCV.wait(oLock, [&poJob] { return poJob->bDone; });
+    }
+}
@@ -87,8 +87,16 @@ CPL_C_END
 #ifdef __cplusplus
 
 #include "cpl_string.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+class CPLJobQueue;
+class GDALDataset;
+
 std::vector<std::string> CPL_DLL
 GetOutputDriversFor(const char *pszDestFilename, int nFlagRasterVector);
 CPLString CPL_DLL GetOutputDriverForRaster(const char *pszDestFilename);
@@ -104,6 +112,60 @@ bool GDALPatternMatch(const char *input, const char *pattern);
 constexpr int OVR_LEVEL_AUTO = -2;
 constexpr int OVR_LEVEL_NONE = -1;
 
+/************************************************************************/
+/*                      GDALDatasetOpenPrefetcher                       */
+/************************************************************************/
+
+/** Opens datasets in worker threads ahead of their sequential consumption.
+ *
+ * Filenames are queued with Submit() and the corresponding datasets are
+ * retrieved with Next() in submission order. Errors and warnings emitted
+ * while opening a dataset are replayed by Next(), so that the caller sees
+ * the same sequence of datasets and messages as if it had opened them
+ * itself. The number of worker threads is taken from the GDAL_NUM_THREADS
+ * configuration option, and defaults to 1, in which case datasets are
+ * opened synchronously by Next().
+ */
+class GDALDatasetOpenPrefetcher
+{
+  public:
+    GDALDatasetOpenPrefetcher(unsigned int nOpenFlags,
+                              CSLConstList papszOpenOptions);
+    ~GDALDatasetOpenPrefetcher();
+
+    /** Maximum number of submitted datasets that should not have been
+     * consumed yet, for the caller to bound the number of opened datasets. */
+    size_t GetMaxPendingCount() const
+    {
+        return m_nMaxPending;
+    }
+
+    /** Number of submitted datasets not yet consumed. */
+    size_t GetPendingCount() const
+    {
+        return m_apoJobs.size();
+    }
+
+    void Submit(const std::string &osFilename);
+
+    const std::string &GetNextFilename() const;
+    std::unique_ptr<GDALDataset> Next();
+    void SkipNext();
+
+  private:
+    struct Job;
+
+    const unsigned int m_nOpenFlags;
+    const CPLStringList m_aosOpenOptions;
+    size_t m_nMaxPending = 1;
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    std::deque<std::unique_ptr<Job>> m_apoJobs{};
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALDatasetOpenPrefetcher)
+};
+
 #endif /* __cplusplus */
 
 #endif /* COMMONUTILS_H_INCLUDED */
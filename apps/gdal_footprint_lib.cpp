@@ -19,18 +19,23 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
 #include <vector>
 
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "memdataset.h"
@@ -818,59 +823,23 @@ static double GetMinDistanceBetweenTwoPoints(const OGRGeometry *poGeom)
 }
 
 /************************************************************************/
-/*                       GDALFootprintProcess()                         */
+/*                    GDALFootprintGetSrcMaskBands()                    */
 /************************************************************************/
 
-static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
-                                 const GDALFootprintOptions *psOptions)
+/** Collect the bands whose validity must be combined for the footprint.
+ *
+ * Bands in apoTmpNoDataMaskBands are owned by the caller, and referenced
+ * by apoSrcMaskBands.
+ */
+static bool GDALFootprintGetSrcMaskBands(
+    GDALDataset *poSrcDS, const std::vector<int> &anBands,
+    const std::vector<double> &adfSrcNoData, int nOvrIndex,
+    std::vector<GDALRasterBand *> &apoSrcMaskBands,
+    std::vector<std::unique_ptr<GDALRasterBand>> &apoTmpNoDataMaskBands,
+    bool &bGlobalMask)
 {
-    std::unique_ptr<OGRCoordinateTransformation> poCT_SRS;
-    const OGRSpatialReference *poDstSRS = poDstLayer->GetSpatialRef();
-    if (!psOptions->oOutputSRS.IsEmpty())
-        poDstSRS = &(psOptions->oOutputSRS);
-    if (poDstSRS)
-    {
-        auto poSrcSRS = poSrcDS->GetSpatialRef();
-        if (!poSrcSRS)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Output layer has CRS, but input is not georeferenced");
-            return false;
-        }
-        poCT_SRS.reset(OGRCreateCoordinateTransformation(poSrcSRS, poDstSRS));
-        if (!poCT_SRS)
-            return false;
-    }
-
-    std::vector<int> anBands = psOptions->anBands;
     const int nBandCount = poSrcDS->GetRasterCount();
-    if (anBands.empty())
-    {
-        for (int i = 1; i <= nBandCount; ++i)
-            anBands.push_back(i);
-    }
-
-    std::vector<GDALRasterBand *> apoSrcMaskBands;
-    const CPLStringList aosSrcNoData(
-        CSLTokenizeString2(psOptions->osSrcNoData.c_str(), " ", 0));
-    std::vector<double> adfSrcNoData;
-    if (!psOptions->osSrcNoData.empty())
-    {
-        if (aosSrcNoData.size() != 1 &&
-            static_cast<size_t>(aosSrcNoData.size()) != anBands.size())
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Number of values in -srcnodata should be 1 or the number "
-                     "of bands");
-            return false;
-        }
-        for (int i = 0; i < aosSrcNoData.size(); ++i)
-        {
-            adfSrcNoData.emplace_back(CPLAtof(aosSrcNoData[i]));
-        }
-    }
-    bool bGlobalMask = true;
-    std::vector<std::unique_ptr<GDALRasterBand>> apoTmpNoDataMaskBands;
+    bGlobalMask = true;
     for (size_t i = 0; i < anBands.size(); ++i)
     {
         const int nBand = anBands[i];
@@ -906,14 +875,14 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                 }
                 poMaskBand = poBand->GetMaskBand();
             }
-            if (psOptions->nOvrIndex >= 0)
+            if (nOvrIndex >= 0)
             {
                 if (nMaskFlags == GMF_NODATA)
                 {
                     // If the mask band is based on nodata, we don't need
                     // to check the overviews of the mask band, but we
                     // can take the mask band of the overviews
-                    auto poOvrBand = poBand->GetOverview(psOptions->nOvrIndex);
+                    auto poOvrBand = poBand->GetOverview(nOvrIndex);
                     if (!poOvrBand)
                     {
                         if (poBand->GetOverviewCount() == 0)
@@ -923,7 +892,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 "Overview index %d invalid for this dataset. "
                                 "Bands of this dataset have no "
                                 "precomputed overviews",
-                                psOptions->nOvrIndex);
+                                nOvrIndex);
                         }
                         else
                         {
@@ -931,7 +900,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 CE_Failure, CPLE_AppDefined,
                                 "Overview index %d invalid for this dataset. "
                                 "Value should be in [0,%d] range",
-                                psOptions->nOvrIndex,
+                                nOvrIndex,
                                 poBand->GetOverviewCount() - 1);
                         }
                         return false;
@@ -946,7 +915,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                 }
                 else
                 {
-                    poMaskBand = poMaskBand->GetOverview(psOptions->nOvrIndex);
+                    poMaskBand = poMaskBand->GetOverview(nOvrIndex);
                     if (!poMaskBand)
                     {
                         if (poBand->GetMaskBand()->GetOverviewCount() == 0)
@@ -956,7 +925,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 "Overview index %d invalid for this dataset. "
                                 "Mask bands of this dataset have no "
                                 "precomputed overviews",
-                                psOptions->nOvrIndex);
+                                nOvrIndex);
                         }
                         else
                         {
@@ -964,7 +933,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 CE_Failure, CPLE_AppDefined,
                                 "Overview index %d invalid for this dataset. "
                                 "Value should be in [0,%d] range",
-                                psOptions->nOvrIndex,
+                                nOvrIndex,
                                 poBand->GetMaskBand()->GetOverviewCount() - 1);
                         }
                         return false;
@@ -975,6 +944,223 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
         }
     }
 
+    return true;
+}
+
+/************************************************************************/
+/*                    GDALFootprintCreateMaskBand()                     */
+/************************************************************************/
+
+static std::unique_ptr<GDALRasterBand> GDALFootprintCreateMaskBand(
+    const std::vector<GDALRasterBand *> &apoSrcMaskBands, bool bGlobalMask,
+    bool bCombineBandsUnion)
+{
+    if (bGlobalMask || apoSrcMaskBands.size() == 1)
+    {
+        return std::make_unique<GDALFootprintMaskBand>(apoSrcMaskBands[0]);
+    }
+    return std::make_unique<GDALFootprintCombinedMaskBand>(apoSrcMaskBands,
+                                                           bCombineBandsUnion);
+}
+
+/************************************************************************/
+/*                GDALFootprintComputeMaskMultiThreaded()               */
+/************************************************************************/
+
+/** Evaluate poMaskBand into a MEM dataset, by strips of lines processed by
+ * nThreads worker threads, each one reading from its own view of the source
+ * dataset.
+ *
+ * Returns false in case of error or interruption. poMaskDS is left to null
+ * if the source cannot be read from several threads, or if the mask would
+ * take too much RAM.
+ */
+static bool GDALFootprintComputeMaskMultiThreaded(
+    GDALDataset *poSrcDS, const std::vector<int> &anBands,
+    const std::vector<double> &adfSrcNoData,
+    const GDALFootprintOptions *psOptions, GDALRasterBand *poMaskBand,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressData,
+    std::unique_ptr<GDALDataset> &poMaskDS)
+{
+    const int nXSize = poMaskBand->GetXSize();
+    const int nYSize = poMaskBand->GetYSize();
+
+    const GIntBig nUsableRAM = CPLGetUsablePhysicalRAM();
+    if (nUsableRAM > 0 &&
+        static_cast<GIntBig>(nXSize) * nYSize > nUsableRAM / 4)
+    {
+        CPLDebug("FOOTPRINT", "Mask too large to be computed in memory. "
+                              "Using a single thread");
+        return true;
+    }
+
+    // Strips of about 1 million pixels, aligned on blocks when possible.
+    int nBlockYSize = 0;
+    poMaskBand->GetBlockSize(nullptr, &nBlockYSize);
+    int nLinesPerStrip = std::max(1, (1024 * 1024) / std::max(1, nXSize));
+    if (nBlockYSize > 0 && nLinesPerStrip > nBlockYSize)
+        nLinesPerStrip = (nLinesPerStrip / nBlockYSize) * nBlockYSize;
+    const int nStrips = static_cast<int>(
+        (static_cast<GIntBig>(nYSize) + nLinesPerStrip - 1) / nLinesPerStrip);
+    if (nStrips < 2)
+        return true;
+
+    GDALDataset *poTSDS = nullptr;
+    {
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        poTSDS = GDALGetThreadSafeDataset(poSrcDS, GDAL_OF_RASTER);
+    }
+    CPLWorkerThreadPool *poPool =
+        poTSDS ? GDALGetGlobalThreadPool(std::min(nThreads, nStrips))
+               : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (!poQueue)
+    {
+        CPLDebug("FOOTPRINT", "Source dataset cannot be read from several "
+                              "threads. Using a single thread");
+        if (poTSDS)
+            poTSDS->ReleaseRef();
+        return true;
+    }
+
+    auto poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    auto poMEMDS = std::unique_ptr<GDALDataset>(
+        poMEMDriver ? poMEMDriver->Create("", nXSize, nYSize, 1, GDT_Byte,
+                                          nullptr)
+                    : nullptr);
+    if (!poMEMDS)
+    {
+        poTSDS->ReleaseRef();
+        return false;
+    }
+    GByte *pabyMask =
+        cpl::down_cast<MEMRasterBand *>(poMEMDS->GetRasterBand(1))->GetData();
+
+    CPLErrorAccumulator oErrorAccumulator;
+    std::atomic<bool> bError{false};
+    std::atomic<int> nStripsDone{0};
+    for (int iStrip = 0; iStrip < nStrips; ++iStrip)
+    {
+        poQueue->SubmitJob(
+            [&, iStrip]()
+            {
+                auto oContext = oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oContext);
+                if (bError)
+                    return;
+
+                // Each job builds its own stack of mask bands, as they are
+                // not safe to use from several threads
+                std::vector<GDALRasterBand *> apoTSMaskBands;
+                std::vector<std::unique_ptr<GDALRasterBand>> apoTmpBands;
+                bool bGlobalMask = true;
+                if (!GDALFootprintGetSrcMaskBands(
+                        poTSDS, anBands, adfSrcNoData, psOptions->nOvrIndex,
+                        apoTSMaskBands, apoTmpBands, bGlobalMask))
+                {
+                    bError = true;
+                    return;
+                }
+                auto poTSMaskBand = GDALFootprintCreateMaskBand(
+                    apoTSMaskBands, bGlobalMask, psOptions->bCombineBandsUnion);
+
+                const int nYOff = iStrip * nLinesPerStrip;
+                const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+                if (poTSMaskBand->RasterIO(
+                        GF_Read, 0, nYOff, nXSize, nLines,
+                        pabyMask + static_cast<size_t>(nYOff) * nXSize, nXSize,
+                        nLines, GDT_Byte, 1, nXSize, nullptr) != CE_None)
+                {
+                    bError = true;
+                }
+                ++nStripsDone;
+            });
+    }
+
+    bool bRet = true;
+    while (bRet && nStripsDone < nStrips && !bError)
+    {
+        poQueue->WaitEvent();
+        if (!pfnProgress(static_cast<double>(nStripsDone) / nStrips, "",
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            bError = true;
+            bRet = false;
+        }
+    }
+    poQueue->WaitCompletion();
+    oErrorAccumulator.ReplayErrors();
+    poTSDS->ReleaseRef();
+
+    if (bError)
+        return false;
+
+    poMaskDS = std::move(poMEMDS);
+    return true;
+}
+
+/************************************************************************/
+/*                       GDALFootprintProcess()                         */
+/************************************************************************/
+
+static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
+                                 const GDALFootprintOptions *psOptions)
+{
+    std::unique_ptr<OGRCoordinateTransformation> poCT_SRS;
+    const OGRSpatialReference *poDstSRS = poDstLayer->GetSpatialRef();
+    if (!psOptions->oOutputSRS.IsEmpty())
+        poDstSRS = &(psOptions->oOutputSRS);
+    if (poDstSRS)
+    {
+        auto poSrcSRS = poSrcDS->GetSpatialRef();
+        if (!poSrcSRS)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Output layer has CRS, but input is not georeferenced");
+            return false;
+        }
+        poCT_SRS.reset(OGRCreateCoordinateTransformation(poSrcSRS, poDstSRS));
+        if (!poCT_SRS)
+            return false;
+    }
+
+    std::vector<int> anBands = psOptions->anBands;
+    const int nBandCount = poSrcDS->GetRasterCount();
+    if (anBands.empty())
+    {
+        for (int i = 1; i <= nBandCount; ++i)
+            anBands.push_back(i);
+    }
+
+    std::vector<GDALRasterBand *> apoSrcMaskBands;
+    const CPLStringList aosSrcNoData(
+        CSLTokenizeString2(psOptions->osSrcNoData.c_str(), " ", 0));
+    std::vector<double> adfSrcNoData;
+    if (!psOptions->osSrcNoData.empty())
+    {
+        if (aosSrcNoData.size() != 1 &&
+            static_cast<size_t>(aosSrcNoData.size()) != anBands.size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Number of values in -srcnodata should be 1 or the number "
+                     "of bands");
+            return false;
+        }
+        for (int i = 0; i < aosSrcNoData.size(); ++i)
+        {
+            adfSrcNoData.emplace_back(CPLAtof(aosSrcNoData[i]));
+        }
+    }
+    bool bGlobalMask = true;
+    std::vector<std::unique_ptr<GDALRasterBand>> apoTmpNoDataMaskBands;
+    if (!GDALFootprintGetSrcMaskBands(poSrcDS, anBands, adfSrcNoData,
+                                      psOptions->nOvrIndex, apoSrcMaskBands,
+                                      apoTmpNoDataMaskBands, bGlobalMask))
+    {
+        return false;
+    }
+
     std::unique_ptr<OGRCoordinateTransformation> poCT_GT;
     GDALGeoTransform gt;
     if (psOptions->bOutCSGeoref && poSrcDS->GetGeoTransform(gt) == CE_None)
@@ -1003,25 +1189,49 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
         poCT_GT = std::make_unique<GeoTransformCoordinateTransformation>(gt);
     }
 
-    std::unique_ptr<GDALRasterBand> poMaskForRasterize;
-    if (bGlobalMask || anBands.size() == 1)
-    {
-        poMaskForRasterize =
-            std::make_unique<GDALFootprintMaskBand>(apoSrcMaskBands[0]);
-    }
-    else
+    std::unique_ptr<GDALRasterBand> poMaskForRasterize =
+        GDALFootprintCreateMaskBand(apoSrcMaskBands, bGlobalMask,
+                                    psOptions->bCombineBandsUnion);
+    auto hBand = GDALRasterBand::ToHandle(poMaskForRasterize.get());
+
+    // With several threads, evaluate the mask by strips in parallel into a
+    // temporary in-memory dataset, which is then polygonized.
+    GDALProgressFunc pfnPolygonizeProgress = psOptions->pfnProgress;
+    void *pPolygonizeProgressData = psOptions->pProgressData;
+    std::unique_ptr<void, decltype(&GDALDestroyScaledProgress)>
+        pScaledProgress(nullptr, GDALDestroyScaledProgress);
+    std::unique_ptr<GDALDataset> poMaskDS;
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    if (nThreads > 1)
     {
-        poMaskForRasterize = std::make_unique<GDALFootprintCombinedMaskBand>(
-            apoSrcMaskBands, psOptions->bCombineBandsUnion);
+        pScaledProgress.reset(GDALCreateScaledProgress(
+            0.0, 0.5, psOptions->pfnProgress, psOptions->pProgressData));
+        if (!GDALFootprintComputeMaskMultiThreaded(
+                poSrcDS, anBands, adfSrcNoData, psOptions,
+                poMaskForRasterize.get(), nThreads, GDALScaledProgress,
+                pScaledProgress.get(), poMaskDS))
+        {
+            return false;
+        }
+        if (poMaskDS)
+        {
+            hBand = GDALRasterBand::ToHandle(poMaskDS->GetRasterBand(1));
+            pScaledProgress.reset(GDALCreateScaledProgress(
+                0.5, 1.0, psOptions->pfnProgress, psOptions->pProgressData));
+            pfnPolygonizeProgress = GDALScaledProgress;
+            pPolygonizeProgressData = pScaledProgress.get();
+        }
     }
 
-    auto hBand = GDALRasterBand::ToHandle(poMaskForRasterize.get());
     auto poMemLayer = std::make_unique<OGRMemLayer>("", nullptr, wkbUnknown);
     const CPLErr eErr =
         GDALPolygonize(hBand, hBand, OGRLayer::ToHandle(poMemLayer.get()),
                        /* iPixValField = */ -1,
-                       /* papszOptions = */ nullptr, psOptions->pfnProgress,
-                       psOptions->pProgressData);
+                       /* papszOptions = */ nullptr, pfnPolygonizeProgress,
+                       pPolygonizeProgressData);
     if (eErr != CE_None)
     {
         return false;
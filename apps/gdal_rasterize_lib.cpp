@@ -282,6 +282,15 @@ GDALRasterizeOptionsGetParser(GDALRasterizeOptions *psOptions,
         .help(_("Align the coordinates of the extent to the values of the "
                 "output raster."));
 
+    argParser->add_argument("-j")
+        .metavar("<n>|ALL_CPUS")
+        .action(
+            [psOptions](const std::string &s) {
+                psOptions->aosRasterizeOptions.SetNameValue("NUM_THREADS",
+                                                            s.c_str());
+            })
+        .help(_("Number of threads to use for rasterization."));
+
     argParser->add_argument("-optim")
         .metavar("AUTO|VECTOR|RASTER")
         .action(
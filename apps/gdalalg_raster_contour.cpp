@@ -82,6 +82,7 @@ GDALRasterContourAlgorithm::GDALRasterContourAlgorithm(bool standaloneStep)
            _("Group n features per transaction (default 100 000)"),
            &m_groupTransactions)
         .SetMinValueIncluded(0);
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 }
 
 /************************************************************************/
@@ -211,6 +212,11 @@ bool GDALRasterContourAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
         aosOptions.AddString("-nln");
         aosOptions.AddString(m_outputLayerName);
     }
+    if (m_numThreads > 0)
+    {
+        aosOptions.AddString("-j");
+        aosOptions.AddString(CPLSPrintf("%d", m_numThreads));
+    }
 
     // Check that one of --interval, --levels, --exp-base is specified
     if (m_levels.size() == 0 && std::isnan(m_interval) && m_expBase == 0)
@@ -65,6 +65,8 @@ GDALRasterFillNodataAlgorithm::GDALRasterFillNodataAlgorithm(
            &m_strategy)
         .SetDefault(m_strategy)
         .SetChoices("invdist", "nearest");
+
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 }
 
 /************************************************************************/
@@ -110,6 +112,10 @@ bool GDALRasterFillNodataAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
         aosFillOptions.AddNameValue("INTERPOLATION",
                                     "INV_DIST");  // default strategy
 
+    if (m_numThreads > 0)
+        aosFillOptions.AddNameValue("NUM_THREADS",
+                                    CPLSPrintf("%d", m_numThreads));
+
     pScaledData.reset(
         GDALCreateScaledProgress(0.5, 1.0, pfnProgress, pProgressData));
     const auto retVal = GDALFillNodata(
@@ -68,6 +68,8 @@ GDALRasterPolygonizeAlgorithm::GDALRasterPolygonizeAlgorithm(
     AddArg("connect-diagonal-pixels", 'c',
            _("Consider diagonal pixels as connected"), &m_connectDiagonalPixels)
         .SetDefault(m_connectDiagonalPixels);
+
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 }
 
 /************************************************************************/
@@ -245,6 +247,11 @@ bool GDALRasterPolygonizeAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
     {
         aosPolygonizeOptions.SetNameValue("8CONNECTED", "8");
     }
+    if (m_numThreads > 0)
+    {
+        aosPolygonizeOptions.SetNameValue("NUM_THREADS",
+                                          CPLSPrintf("%d", m_numThreads));
+    }
 
     bool ret;
     if (GDALDataTypeIsInteger(eDT))
@@ -56,6 +56,8 @@ class GDALRasterPolygonizeAlgorithm /* non final */
     int m_band = 1;
     std::string m_attributeName = "DN";
     bool m_connectDiagonalPixels = false;
+    int m_numThreads = 0;
+    std::string m_numThreadsStr{};
 };
 
 /************************************************************************/
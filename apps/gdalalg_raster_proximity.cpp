@@ -55,6 +55,11 @@ GDALRasterProximityAlgorithm::GDALRasterProximityAlgorithm(bool standaloneStep)
            _("Specify a nodata value to use for pixels that are beyond the "
              "maximum distance"),
            &m_noDataValue);
+    AddArg("algorithm", 0, _("Algorithm used to compute distances"),
+           &m_algorithm)
+        .SetChoices("propagation", "exact")
+        .SetDefault(m_algorithm);
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 }
 
 /************************************************************************/
@@ -130,6 +135,18 @@ bool GDALRasterProximityAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
             CPLSPrintf("VALUES=%s", targetPixelValues.c_str()));
     }
 
+    if (GetArg("algorithm")->IsExplicitlySet())
+    {
+        proximityOptions.AddString(
+            CPLSPrintf("ALGORITHM=%s", m_algorithm.c_str()));
+    }
+
+    if (m_numThreads > 0)
+    {
+        proximityOptions.SetNameValue("NUM_THREADS",
+                                      CPLSPrintf("%d", m_numThreads));
+    }
+
     const auto error = GDALComputeProximity(srcBand, dstBand, proximityOptions,
                                             pfnProgress, pProgressData);
     if (error == CE_None)
@@ -44,6 +44,9 @@ class GDALRasterProximityAlgorithm /* non final */
     std::string m_distanceUnits = "pixel";  // pixel|geo
     double m_maxDistance = 0.0;
     double m_fixedBufferValue = 0.0;
+    std::string m_algorithm = "propagation";  // propagation|exact
+    int m_numThreads = 0;
+    std::string m_numThreadsStr{};
 };
 
 /************************************************************************/
@@ -115,6 +115,7 @@ GDALVectorRasterizeAlgorithm::GDALVectorRasterizeAlgorithm(bool bStandaloneStep)
            &m_optimization)
         .SetChoices("AUTO", "RASTER", "VECTOR")
         .SetDefault("AUTO");
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 
     if (bStandaloneStep)
     {
@@ -312,6 +313,12 @@ bool GDALVectorRasterizeAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
         aosOptions.AddString(m_optimization.c_str());
     }
 
+    if (m_numThreads > 0)
+    {
+        aosOptions.AddString("-j");
+        aosOptions.AddString(CPLSPrintf("%d", m_numThreads));
+    }
+
     bool bOK = false;
     std::unique_ptr<GDALRasterizeOptions, decltype(&GDALRasterizeOptionsFree)>
         psOptions{GDALRasterizeOptionsNew(aosOptions.List(), nullptr),
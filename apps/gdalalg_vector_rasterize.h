@@ -78,6 +78,8 @@ class GDALVectorRasterizeAlgorithm /* non final */
         m_targetSize{};  // Mutually exclusive with targetResolution
     std::string m_outputType{};
     std::string m_optimization{};  // {AUTO|VECTOR|RASTER}
+    int m_numThreads = 0;
+    std::string m_numThreadsStr{};
 };
 
 /************************************************************************/
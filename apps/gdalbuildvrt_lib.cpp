@@ -1664,6 +1664,17 @@ std::unique_ptr<GDALDataset> VRTBuilder::Build(GDALProgressFunc pfnProgress,
         }
     }
 
+    // Sources are opened ahead in worker threads when GDAL_NUM_THREADS is
+    // set, but analysed sequentially in input order below, so that the
+    // result does not depend on the number of threads.
+    std::unique_ptr<GDALDatasetOpenPrefetcher> poPrefetcher;
+    if (pahSrcDS == nullptr)
+    {
+        poPrefetcher = std::make_unique<GDALDatasetOpenPrefetcher>(
+            GDAL_OF_RASTER, papszOpenOptions);
+    }
+    int iNextToSubmit = 0;
+
     bool bFoundValid = false;
     for (int i = 0; ppszInputFilenames != nullptr && i < nInputFiles; i++)
     {
@@ -1674,10 +1685,24 @@ std::unique_ptr<GDALDataset> VRTBuilder::Build(GDALProgressFunc pfnProgress,
             return nullptr;
         }
 
-        GDALDatasetH hDS = (pahSrcDS)
-                               ? pahSrcDS[i]
-                               : GDALOpenEx(dsFileName, GDAL_OF_RASTER, nullptr,
-                                            papszOpenOptions, nullptr);
+        GDALDatasetH hDS = nullptr;
+        if (pahSrcDS)
+        {
+            hDS = pahSrcDS[i];
+        }
+        else
+        {
+            // nInputFiles may grow while analysing datasets with subdatasets
+            iNextToSubmit = std::max(iNextToSubmit, i);
+            while (iNextToSubmit < nInputFiles &&
+                   poPrefetcher->GetPendingCount() <
+                       poPrefetcher->GetMaxPendingCount())
+            {
+                poPrefetcher->Submit(ppszInputFilenames[iNextToSubmit]);
+                ++iNextToSubmit;
+            }
+            hDS = GDALDataset::ToHandle(poPrefetcher->Next().release());
+        }
         asDatasetProperties[i].isFileOK = FALSE;
 
         if (hDS)
@@ -96,10 +96,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_float.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
@@ -107,6 +111,7 @@
 #include "cpl_vsi_virtual.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__x86_64__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
@@ -310,6 +315,313 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
     return nVal;
 }
 
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessingParams                      */
+/************************************************************************/
+
+template <class T> struct GDALGeneric3x3ProcessingParams
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    GDALDataType eReadDT = GDT_Unknown;
+    int bSrcHasNoData = FALSE;
+    T fSrcNoDataValue = 0;
+    bool bIsSrcNoDataNan = false;
+    float fDstNoDataValue = 0;
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample = nullptr;
+    const AlgorithmParameters *pData = nullptr;
+    bool bComputeAtEdges = false;
+};
+
+/************************************************************************/
+/*                  GDALGeneric3x3LineHasNoData()                       */
+/************************************************************************/
+
+template <class T>
+static bool GDALGeneric3x3LineHasNoData(const T *pafLine, int nXSize,
+                                        T fSrcNoDataValue)
+{
+    if constexpr (std::numeric_limits<T>::is_integer)
+    {
+        int iX = 0;
+        for (; iX + 3 < nXSize; iX += 4)
+        {
+            if (pafLine[iX] == fSrcNoDataValue ||
+                pafLine[iX + 1] == fSrcNoDataValue ||
+                pafLine[iX + 2] == fSrcNoDataValue ||
+                pafLine[iX + 3] == fSrcNoDataValue)
+            {
+                return true;
+            }
+        }
+        for (; iX < nXSize; iX++)
+        {
+            if (pafLine[iX] == fSrcNoDataValue)
+                return true;
+        }
+    }
+    else
+    {
+        int iX = 0;
+        for (; iX + 3 < nXSize; iX += 4)
+        {
+            if (pafLine[iX] == fSrcNoDataValue || std::isnan(pafLine[iX]) ||
+                pafLine[iX + 1] == fSrcNoDataValue ||
+                std::isnan(pafLine[iX + 1]) ||
+                pafLine[iX + 2] == fSrcNoDataValue ||
+                std::isnan(pafLine[iX + 2]) ||
+                pafLine[iX + 3] == fSrcNoDataValue ||
+                std::isnan(pafLine[iX + 3]))
+            {
+                return true;
+            }
+        }
+        for (; iX < nXSize; iX++)
+        {
+            if (pafLine[iX] == fSrcNoDataValue || std::isnan(pafLine[iX]))
+                return true;
+        }
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessingLine()                      */
+/************************************************************************/
+
+// Compute one output line from the source line at the same position and
+// its previous and next lines. pafPrevLine (resp. pafNextLine) is null for
+// the first (resp. last) line of the raster.
+template <class T>
+static void
+GDALGeneric3x3ProcessingLine(const GDALGeneric3x3ProcessingParams<T> &sParams,
+                             const T *pafPrevLine, const T *pafLine,
+                             const T *pafNextLine,
+                             bool bOneOfThreeLinesHasNoData,
+                             float *pafOutputBuf)
+{
+    const int nXSize = sParams.nXSize;
+    const int bSrcHasNoData = sParams.bSrcHasNoData;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    const bool bIsSrcNoDataNan = sParams.bIsSrcNoDataNan;
+    const float fDstNoDataValue = sParams.fDstNoDataValue;
+    const auto pfnAlg = sParams.pfnAlg;
+    const AlgorithmParameters *pData = sParams.pData;
+    const bool bComputeAtEdges = sParams.bComputeAtEdges;
+
+    // Move a 3x3 pafWindow over each cell
+    // (where the cell in question is #4)
+    //
+    //      0 1 2
+    //      3 4 5
+    //      6 7 8
+
+    if (pafPrevLine == nullptr || pafNextLine == nullptr)
+    {
+        if (!bComputeAtEdges || nXSize < 2 ||
+            (pafPrevLine == nullptr && pafNextLine == nullptr))
+        {
+            // Exclude the edges
+            for (int j = 0; j < nXSize; j++)
+            {
+                pafOutputBuf[j] = fDstNoDataValue;
+            }
+        }
+        else if (pafPrevLine == nullptr)
+        {
+            // First line: extrapolate the line above it.
+            for (int j = 0; j < nXSize; j++)
+            {
+                int jmin = (j == 0) ? j : j - 1;
+                int jmax = (j == nXSize - 1) ? j : j + 1;
+
+                T afWin[9] = {
+                    INTERPOL(pafLine[jmin], pafNextLine[jmin], bSrcHasNoData,
+                             fSrcNoDataValue),
+                    INTERPOL(pafLine[j], pafNextLine[j], bSrcHasNoData,
+                             fSrcNoDataValue),
+                    INTERPOL(pafLine[jmax], pafNextLine[jmax], bSrcHasNoData,
+                             fSrcNoDataValue),
+                    pafLine[jmin],
+                    pafLine[j],
+                    pafLine[jmax],
+                    pafNextLine[jmin],
+                    pafNextLine[j],
+                    pafNextLine[jmax]};
+                pafOutputBuf[j] =
+                    ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
+                               bIsSrcNoDataNan, afWin, fDstNoDataValue, pfnAlg,
+                               pData, bComputeAtEdges);
+            }
+        }
+        else
+        {
+            // Last line: extrapolate the line below it.
+            for (int j = 0; j < nXSize; j++)
+            {
+                int jmin = (j == 0) ? j : j - 1;
+                int jmax = (j == nXSize - 1) ? j : j + 1;
+
+                T afWin[9] = {
+                    pafPrevLine[jmin],
+                    pafPrevLine[j],
+                    pafPrevLine[jmax],
+                    pafLine[jmin],
+                    pafLine[j],
+                    pafLine[jmax],
+                    INTERPOL(pafLine[jmin], pafPrevLine[jmin], bSrcHasNoData,
+                             fSrcNoDataValue),
+                    INTERPOL(pafLine[j], pafPrevLine[j], bSrcHasNoData,
+                             fSrcNoDataValue),
+                    INTERPOL(pafLine[jmax], pafPrevLine[jmax], bSrcHasNoData,
+                             fSrcNoDataValue),
+                };
+
+                pafOutputBuf[j] =
+                    ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
+                               bIsSrcNoDataNan, afWin, fDstNoDataValue, pfnAlg,
+                               pData, bComputeAtEdges);
+            }
+        }
+        return;
+    }
+
+    if (bComputeAtEdges && nXSize >= 2)
+    {
+        int j = 0;
+        T afWin[9] = {
+            INTERPOL(pafPrevLine[j], pafPrevLine[j + 1], bSrcHasNoData,
+                     fSrcNoDataValue),
+            pafPrevLine[j],
+            pafPrevLine[j + 1],
+            INTERPOL(pafLine[j], pafLine[j + 1], bSrcHasNoData,
+                     fSrcNoDataValue),
+            pafLine[j],
+            pafLine[j + 1],
+            INTERPOL(pafNextLine[j], pafNextLine[j + 1], bSrcHasNoData,
+                     fSrcNoDataValue),
+            pafNextLine[j],
+            pafNextLine[j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(
+            bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+            fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        pafOutputBuf[0] = fDstNoDataValue;
+    }
+
+    int j = 1;
+    if (sParams.pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
+    {
+        j = sParams.pfnAlg_multisample(pafPrevLine, pafLine, pafNextLine,
+                                       nXSize, pData, pafOutputBuf);
+    }
+
+    for (; j < nXSize - 1; j++)
+    {
+        T afWin[9] = {pafPrevLine[j - 1], pafPrevLine[j], pafPrevLine[j + 1],
+                      pafLine[j - 1],     pafLine[j],     pafLine[j + 1],
+                      pafNextLine[j - 1], pafNextLine[j], pafNextLine[j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(
+            bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+            fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+    }
+
+    if (bComputeAtEdges && nXSize >= 2)
+    {
+        j = nXSize - 1;
+
+        T afWin[9] = {pafPrevLine[j - 1],
+                      pafPrevLine[j],
+                      INTERPOL(pafPrevLine[j], pafPrevLine[j - 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafLine[j - 1],
+                      pafLine[j],
+                      INTERPOL(pafLine[j], pafLine[j - 1], bSrcHasNoData,
+                               fSrcNoDataValue),
+                      pafNextLine[j - 1],
+                      pafNextLine[j],
+                      INTERPOL(pafNextLine[j], pafNextLine[j - 1],
+                               bSrcHasNoData, fSrcNoDataValue)};
+
+        pafOutputBuf[j] = ComputeVal(
+            bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+            fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        if (nXSize > 1)
+            pafOutputBuf[nXSize - 1] = fDstNoDataValue;
+    }
+}
+
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessingStrip()                     */
+/************************************************************************/
+
+// Compute the output lines [nYStart, nYEnd[ into pafOutputBuf, by reading
+// the corresponding source lines, plus one line above and below them (when
+// they exist) into pafSrcBuf, which must be large enough to hold
+// nYEnd - nYStart + 2 lines.
+template <class T>
+static CPLErr
+GDALGeneric3x3ProcessingStrip(const GDALGeneric3x3ProcessingParams<T> &sParams,
+                              GDALRasterBandH hSrcBand, int nYStart, int nYEnd,
+                              T *pafSrcBuf, float *pafOutputBuf)
+{
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+    const int nSrcYStart = std::max(0, nYStart - 1);
+    const int nSrcYEnd = std::min(nYSize, nYEnd + 1);
+    const int nSrcLines = nSrcYEnd - nSrcYStart;
+
+    if (GDALRasterIO(hSrcBand, GF_Read, 0, nSrcYStart, nXSize, nSrcLines,
+                     pafSrcBuf, nXSize, nSrcLines, sParams.eReadDT, 0,
+                     0) != CE_None)
+    {
+        return CE_Failure;
+    }
+
+    // In case none of the 3 lines have nodata values, then no need to
+    // check it in ComputeVal()
+    std::vector<bool> abLineHasNoDataValue(nSrcLines, false);
+    if (sParams.bSrcHasNoData)
+    {
+        for (int i = 0; i < nSrcLines; i++)
+        {
+            abLineHasNoDataValue[i] = GDALGeneric3x3LineHasNoData(
+                pafSrcBuf + static_cast<size_t>(i) * nXSize, nXSize,
+                sParams.fSrcNoDataValue);
+        }
+    }
+
+    for (int iY = nYStart; iY < nYEnd; iY++)
+    {
+        const int iSrcLine = iY - nSrcYStart;
+        const T *pafLine = pafSrcBuf + static_cast<size_t>(iSrcLine) * nXSize;
+        const T *pafPrevLine = iY > 0 ? pafLine - nXSize : nullptr;
+        const T *pafNextLine = iY + 1 < nYSize ? pafLine + nXSize : nullptr;
+        const bool bOneOfThreeLinesHasNoData =
+            abLineHasNoDataValue[iSrcLine] ||
+            (pafPrevLine && abLineHasNoDataValue[iSrcLine - 1]) ||
+            (pafNextLine && abLineHasNoDataValue[iSrcLine + 1]);
+
+        GDALGeneric3x3ProcessingLine(
+            sParams, pafPrevLine, pafLine, pafNextLine,
+            bOneOfThreeLinesHasNoData,
+            pafOutputBuf + static_cast<size_t>(iY - nYStart) * nXSize);
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                  GDALGeneric3x3Processing()                          */
 /************************************************************************/
@@ -335,32 +647,23 @@ static CPLErr GDALGeneric3x3Processing(
         return CE_Failure;
     }
 
-    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
-
-    // 1 line destination buffer.
-    float *pafOutputBuf =
-        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin =
-        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize));
-    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
-        return CE_Failure;
-    }
+    GDALGeneric3x3ProcessingParams<T> sParams;
+    sParams.nXSize = GDALGetRasterBandXSize(hSrcBand);
+    sParams.nYSize = GDALGetRasterBandYSize(hSrcBand);
+    sParams.pfnAlg = pfnAlg;
+    sParams.pfnAlg_multisample = pfnAlg_multisample;
+    sParams.pData = pData.get();
+    sParams.bComputeAtEdges = bComputeAtEdges;
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
 
-    GDALDataType eReadDT;
     int bSrcHasNoData = FALSE;
     const double dfNoDataValue =
         GDALGetRasterNoDataValue(hSrcBand, &bSrcHasNoData);
 
-    bool bIsSrcNoDataNan = false;
-    T fSrcNoDataValue = 0;
     if constexpr (std::numeric_limits<T>::is_integer)
     {
-        eReadDT = GDT_Int32;
+        sParams.eReadDT = GDT_Int32;
         if (bSrcHasNoData)
         {
             GDALDataType eSrcDT = GDALGetRasterDataType(hSrcBand);
@@ -376,7 +679,8 @@ static CPLErr GDALGeneric3x3Processing(
             if (fabs(dfNoDataValue - floor(dfNoDataValue + 0.5)) < 1e-2 &&
                 dfNoDataValue >= nMinVal && dfNoDataValue <= nMaxVal)
             {
-                fSrcNoDataValue = static_cast<T>(floor(dfNoDataValue + 0.5));
+                sParams.fSrcNoDataValue =
+                    static_cast<T>(floor(dfNoDataValue + 0.5));
             }
             else
             {
@@ -386,383 +690,204 @@ static CPLErr GDALGeneric3x3Processing(
     }
     else
     {
-        eReadDT = GDT_Float32;
-        fSrcNoDataValue = static_cast<T>(dfNoDataValue);
-        bIsSrcNoDataNan = bSrcHasNoData && std::isnan(dfNoDataValue);
+        sParams.eReadDT = GDT_Float32;
+        sParams.fSrcNoDataValue = static_cast<T>(dfNoDataValue);
+        sParams.bIsSrcNoDataNan = bSrcHasNoData && std::isnan(dfNoDataValue);
     }
+    sParams.bSrcHasNoData = bSrcHasNoData;
 
     int bDstHasNoData = FALSE;
-    float fDstNoDataValue =
+    sParams.fDstNoDataValue =
         static_cast<float>(GDALGetRasterNoDataValue(hDstBand, &bDstHasNoData));
     if (!bDstHasNoData)
-        fDstNoDataValue = 0.0;
-
-    int nLine1Off = 0;
-    int nLine2Off = nXSize;
-    int nLine3Off = 2 * nXSize;
-
-    // Move a 3x3 pafWindow over each cell
-    // (where the cell in question is #4)
-    //
-    //      0 1 2
-    //      3 4 5
-    //      6 7 8
-
-    /* Preload the first 2 lines */
+        sParams.fDstNoDataValue = 0.0;
 
-    bool abLineHasNoDataValue[3] = {CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData)};
-
-    for (int i = 0; i < 2 && i < nYSize; i++)
+    /* -------------------------------------------------------------------- */
+    /*      Split the raster into strips of lines that can be processed     */
+    /*      independently, each one reading one extra source line above     */
+    /*      and below it.                                                   */
+    /* -------------------------------------------------------------------- */
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                 ? CPLGetNumCPUs()
+                                                 : atoi(pszThreads)));
+
+    constexpr size_t STRIP_MEMORY_SIZE = 8 * 1024 * 1024;
+    int nStripHeight = static_cast<int>(std::min<size_t>(
+        nYSize, std::max<size_t>(1, STRIP_MEMORY_SIZE /
+                                        (static_cast<size_t>(nXSize) *
+                                         (sizeof(T) + sizeof(float))))));
+    if (nThreads > 1)
+    {
+        // Have several strips per thread for load balancing.
+        nStripHeight =
+            std::min(nStripHeight, std::max(1, nYSize / (4 * nThreads)));
+    }
+    // Align strips on source blocks, so that they are not read by several
+    // threads.
+    int nBlockYSize = 0;
+    GDALGetBlockSize(hSrcBand, nullptr, &nBlockYSize);
+    if (nBlockYSize > 1 && nStripHeight > nBlockYSize)
+        nStripHeight = (nStripHeight / nBlockYSize) * nBlockYSize;
+    const int nStrips = DIV_ROUND_UP(nYSize, nStripHeight);
+
+    GDALDataset *poTSDS = nullptr;
+    int nSrcBand = 0;
+    if (nThreads > 1 && nStrips > 1)
     {
-        if (GDALRasterIO(hSrcBand, GF_Read, 0, i, nXSize, 1,
-                         pafThreeLineWin + i * nXSize, nXSize, 1, eReadDT, 0,
-                         0) != CE_None)
+        GDALRasterBand *poSrcBand = GDALRasterBand::FromHandle(hSrcBand);
+        GDALDataset *poSrcDS = poSrcBand->GetDataset();
+        nSrcBand = poSrcBand->GetBand();
+        if (poSrcDS && nSrcBand >= 1 && nSrcBand <= poSrcDS->GetRasterCount() &&
+            poSrcDS->GetRasterBand(nSrcBand) == poSrcBand &&
+            poSrcDS->GetAccess() == GA_ReadOnly)
         {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return CE_Failure;
+            CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+            poTSDS = GDALGetThreadSafeDataset(poSrcDS, GDAL_OF_RASTER);
         }
-        if (bSrcHasNoData)
+        if (poTSDS == nullptr || GDALGetGlobalThreadPool(nThreads) == nullptr)
         {
-            abLineHasNoDataValue[i] = false;
-            if constexpr (std::numeric_limits<T>::is_integer)
-            {
-                for (int iX = 0; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue)
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                for (int iX = 0; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[i * nXSize + iX]))
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
-                }
-            }
+            CPLDebug("GDALDEM", "Source dataset cannot be read from several "
+                                "threads. Using a single thread");
+            if (poTSDS)
+                poTSDS->ReleaseRef();
+            poTSDS = nullptr;
         }
     }
 
     CPLErr eErr = CE_None;
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+    if (poTSDS == nullptr)
     {
-        for (int j = 0; j < nXSize; j++)
+        std::unique_ptr<T, VSIFreeReleaser> pafSrcBuf(static_cast<T *>(
+            VSI_MALLOC3_VERBOSE(sizeof(T), nXSize, nStripHeight + 2)));
+        std::unique_ptr<float, VSIFreeReleaser> pafOutputBuf(
+            static_cast<float *>(
+                VSI_MALLOC3_VERBOSE(sizeof(float), nXSize, nStripHeight)));
+        if (pafSrcBuf == nullptr || pafOutputBuf == nullptr)
+            return CE_Failure;
+
+        for (int iStrip = 0; iStrip < nStrips && eErr == CE_None; ++iStrip)
         {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j], pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]};
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
+            const int nYStart = iStrip * nStripHeight;
+            const int nYEnd = std::min(nYSize, nYStart + nStripHeight);
+            eErr = GDALGeneric3x3ProcessingStrip(sParams, hSrcBand, nYStart,
+                                                 nYEnd, pafSrcBuf.get(),
+                                                 pafOutputBuf.get());
+            if (eErr == CE_None)
+            {
+                eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYStart, nXSize,
+                                    nYEnd - nYStart, pafOutputBuf.get(),
+                                    nXSize, nYEnd - nYStart, GDT_Float32, 0,
+                                    0);
+            }
+            if (eErr == CE_None &&
+                !pfnProgress(1.0 * nYEnd / nYSize, nullptr, pProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
+            }
         }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
     }
     else
     {
-        // Exclude the edges
-        for (int j = 0; j < nXSize; j++)
-        {
-            pafOutputBuf[j] = fDstNoDataValue;
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr == CE_None && nYSize > 1)
+        // Strips are computed by worker threads from the thread-safe source
+        // dataset, and written in order by this thread.
+        struct StripResult
         {
-            eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYSize - 1, nXSize, 1,
-                                pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-        }
-    }
-    if (eErr != CE_None)
-    {
-        CPLFree(pafOutputBuf);
-        CPLFree(pafThreeLineWin);
+            std::unique_ptr<float, VSIFreeReleaser> pafOutputBuf{};
+            bool bDone = false;
+            bool bOK = false;
+        };
 
-        return eErr;
-    }
+        std::vector<StripResult> asStrips(nStrips);
+        std::mutex oMutex;
+        std::condition_variable oCV;
+        std::atomic<bool> bStop{false};
+        CPLErrorAccumulator oErrorAccumulator;
+        GDALRasterBandH hTSBand =
+            GDALRasterBand::ToHandle(poTSDS->GetRasterBand(nSrcBand));
 
-    int i = 1;  // Used after for.
-    for (; i < nYSize - 1; i++)
-    {
-        /* Read third line of the line buffer */
-        eErr =
-            GDALRasterIO(hSrcBand, GF_Read, 0, i + 1, nXSize, 1,
-                         pafThreeLineWin + nLine3Off, nXSize, 1, eReadDT, 0, 0);
-        if (eErr != CE_None)
+        const auto ProcessStripJob = [&](int iStrip)
         {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
+            auto oContext = oErrorAccumulator.InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oContext);
+
+            const int nYStart = iStrip * nStripHeight;
+            const int nYEnd = std::min(nYSize, nYStart + nStripHeight);
+            std::unique_ptr<float, VSIFreeReleaser> pafOutputBuf;
+            bool bOK = false;
+            if (!bStop)
+            {
+                std::unique_ptr<T, VSIFreeReleaser> pafSrcBuf(
+                    static_cast<T *>(VSI_MALLOC3_VERBOSE(sizeof(T), nXSize,
+                                                         nYEnd - nYStart + 2)));
+                pafOutputBuf.reset(static_cast<float *>(VSI_MALLOC3_VERBOSE(
+                    sizeof(float), nXSize, nYEnd - nYStart)));
+                bOK = pafSrcBuf && pafOutputBuf &&
+                      GDALGeneric3x3ProcessingStrip(
+                          sParams, hTSBand, nYStart, nYEnd, pafSrcBuf.get(),
+                          pafOutputBuf.get()) == CE_None;
+            }
 
-            return eErr;
-        }
+            std::lock_guard<std::mutex> oLock(oMutex);
+            asStrips[iStrip].pafOutputBuf = std::move(pafOutputBuf);
+            asStrips[iStrip].bOK = bOK;
+            asStrips[iStrip].bDone = true;
+            oCV.notify_one();
+        };
 
-        // In case none of the 3 lines have nodata values, then no need to
-        // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if (bSrcHasNoData)
+        // Limit the number of strips computed in advance of the one being
+        // written, to bound memory usage.
+        const int nMaxStripsInFlight = 2 * nThreads;
+        auto poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+        int iNextStripToSubmit = 0;
+        for (int iStrip = 0; iStrip < nStrips && eErr == CE_None; ++iStrip)
         {
-            if constexpr (std::numeric_limits<T>::is_integer)
+            for (; iNextStripToSubmit < nStrips &&
+                   iNextStripToSubmit < iStrip + nMaxStripsInFlight;
+                 ++iNextStripToSubmit)
             {
-                bool bLastLineHasNoDataValue = false;
-                int iX = 0;
-                for (; iX + 3 < nXSize; iX += 4)
-                {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                        pafThreeLineWin[nLine3Off + iX + 1] ==
-                            fSrcNoDataValue ||
-                        pafThreeLineWin[nLine3Off + iX + 2] ==
-                            fSrcNoDataValue ||
-                        pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue)
-                    {
-                        bLastLineHasNoDataValue = true;
-                        break;
-                    }
-                }
-                if (!bLastLineHasNoDataValue)
-                {
-                    for (; iX < nXSize; iX++)
-                    {
-                        if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue)
-                        {
-                            bLastLineHasNoDataValue = true;
-                        }
-                    }
-                }
-                abLineHasNoDataValue[nLine3Off / nXSize] =
-                    bLastLineHasNoDataValue;
+                const int iJobStrip = iNextStripToSubmit;
+                poJobQueue->SubmitJob([&ProcessStripJob, iJobStrip]()
+                                      { ProcessStripJob(iJobStrip); });
+            }
 
-                bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                            abLineHasNoDataValue[1] ||
-                                            abLineHasNoDataValue[2];
+            {
+                std::unique_lock<std::mutex> oLock(oMutex);
+                oCV.wait(oLock, [&asStrips, iStrip]
+                         { return asStrips[iStrip].bDone; });
+            }
+
+            const int nYStart = iStrip * nStripHeight;
+            const int nYEnd = std::min(nYSize, nYStart + nStripHeight);
+            if (!asStrips[iStrip].bOK)
+            {
+                eErr = CE_Failure;
             }
             else
             {
-                bool bLastLineHasNoDataValue = false;
-                int iX = 0;
-                for (; iX + 3 < nXSize; iX += 4)
-                {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[nLine3Off + iX]) ||
-                        pafThreeLineWin[nLine3Off + iX + 1] ==
-                            fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[nLine3Off + iX + 1]) ||
-                        pafThreeLineWin[nLine3Off + iX + 2] ==
-                            fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[nLine3Off + iX + 2]) ||
-                        pafThreeLineWin[nLine3Off + iX + 3] ==
-                            fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[nLine3Off + iX + 3]))
-                    {
-                        bLastLineHasNoDataValue = true;
-                        break;
-                    }
-                }
-                if (!bLastLineHasNoDataValue)
-                {
-                    for (; iX < nXSize; iX++)
-                    {
-                        if (pafThreeLineWin[nLine3Off + iX] ==
-                                fSrcNoDataValue ||
-                            std::isnan(pafThreeLineWin[nLine3Off + iX]))
-                        {
-                            bLastLineHasNoDataValue = true;
-                        }
-                    }
-                }
-                abLineHasNoDataValue[nLine3Off / nXSize] =
-                    bLastLineHasNoDataValue;
-
-                bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                            abLineHasNoDataValue[1] ||
-                                            abLineHasNoDataValue[2];
+                eErr = GDALRasterIO(
+                    hDstBand, GF_Write, 0, nYStart, nXSize, nYEnd - nYStart,
+                    asStrips[iStrip].pafOutputBuf.get(), nXSize,
+                    nYEnd - nYStart, GDT_Float32, 0, 0);
+            }
+            asStrips[iStrip].pafOutputBuf.reset();
+            if (eErr == CE_None &&
+                !pfnProgress(1.0 * nYEnd / nYSize, nullptr, pProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
             }
         }
 
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            int j = 0;
-            T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] = ComputeVal(
-                bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
-        }
-
-        int j = 1;
-        if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
-        {
-            j = pfnAlg_multisample(
-                pafThreeLineWin + nLine1Off, pafThreeLineWin + nLine2Off,
-                pafThreeLineWin + nLine3Off, nXSize, pData.get(), pafOutputBuf);
-        }
-
-        for (; j < nXSize - 1; j++)
-        {
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] = ComputeVal(
-                bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
-        }
-
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            j = nXSize - 1;
-
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue)};
-
-            pafOutputBuf[j] = ComputeVal(
-                bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            if (nXSize > 1)
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
-        }
-
-        /* -----------------------------------------
-         * Write Line to Raster
-         */
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-        if (eErr != CE_None)
-        {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return eErr;
-        }
-
-        if (!pfnProgress(1.0 * (i + 1) / nYSize, nullptr, pProgressData))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
-
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return eErr;
-        }
-
-        const int nTemp = nLine1Off;
-        nLine1Off = nLine2Off;
-        nLine2Off = nLine3Off;
-        nLine3Off = nTemp;
-    }
-
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
-    {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax], bSrcHasNoData,
-                         fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-        if (eErr != CE_None)
-        {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return eErr;
-        }
+        bStop = true;
+        poJobQueue->WaitCompletion();
+        oErrorAccumulator.ReplayErrors();
+        poTSDS->ReleaseRef();
     }
 
-    pfnProgress(1.0, nullptr, pProgressData);
-    eErr = CE_None;
-
-    CPLFree(pafOutputBuf);
-    CPLFree(pafThreeLineWin);
+    if (eErr == CE_None)
+        pfnProgress(1.0, nullptr, pProgressData);
 
     return eErr;
 }
@@ -802,6 +927,45 @@ template <class T> struct Gradient<T, GradientAlg::ZEVENBERGEN_THORNE>
     }
 };
 
+#ifdef HAVE_16_SSE_REG
+
+// Computes the unscaled x and y gradients of 4 consecutive pixels, with the
+// same operations as the scalar versions of the algorithms, so that results
+// are identical. firstLine, secondLine and thirdLine point to the pixel at
+// the left of the first one.
+template <class T, class REG_T, GradientAlg alg>
+static inline void Gradient4Val(const T *firstLine, const T *secondLine,
+                                const T *thirdLine, XMMReg4Double &x,
+                                XMMReg4Double &y)
+{
+    if constexpr (alg == GradientAlg::HORN)
+    {
+        const auto firstLine0 = REG_T::Load4Val(firstLine);
+        const auto firstLine1 = REG_T::Load4Val(firstLine + 1);
+        const auto firstLine2 = REG_T::Load4Val(firstLine + 2);
+        const auto secondLine0 = REG_T::Load4Val(secondLine);
+        const auto secondLine2 = REG_T::Load4Val(secondLine + 2);
+        const auto thirdLine0 = REG_T::Load4Val(thirdLine);
+        const auto thirdLine1 = REG_T::Load4Val(thirdLine + 1);
+        const auto thirdLine2 = REG_T::Load4Val(thirdLine + 2);
+        x = ((firstLine0 + secondLine0 + secondLine0 + thirdLine0) -
+             (firstLine2 + secondLine2 + secondLine2 + thirdLine2))
+                .cast_to_double();
+        y = ((thirdLine0 + thirdLine1 + thirdLine1 + thirdLine2) -
+             (firstLine0 + firstLine1 + firstLine1 + firstLine2))
+                .cast_to_double();
+    }
+    else
+    {
+        x = (REG_T::Load4Val(secondLine) - REG_T::Load4Val(secondLine + 2))
+                .cast_to_double();
+        y = (REG_T::Load4Val(thirdLine + 1) - REG_T::Load4Val(firstLine + 1))
+                .cast_to_double();
+    }
+}
+
+#endif
+
 /************************************************************************/
 /*                         GDALHillshade()                              */
 /************************************************************************/
@@ -1132,6 +1296,56 @@ static int GDALHillshadeAlg_same_res_multisample(
     }
     return j;
 }
+
+template <class T, class REG_T, GradientAlg alg>
+static int GDALHillshadeAlg_multisample(const T *pafFirstLine,
+                                        const T *pafSecondLine,
+                                        const T *pafThirdLine, int nXSize,
+                                        const AlgorithmParameters *pData,
+                                        float *pafOutputBuf)
+{
+    // Vectorized version of GDALHillshadeAlg()
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const auto reg_inv_ewres = XMMReg4Double::Set1(psData->inv_ewres_xscale);
+    const auto reg_inv_nsres = XMMReg4Double::Set1(psData->inv_nsres_yscale);
+    const auto reg_fact_x =
+        XMMReg4Double::Set1(psData->sin_az_mul_cos_alt_mul_z_mul_254);
+    const auto reg_fact_y =
+        XMMReg4Double::Set1(psData->cos_az_mul_cos_alt_mul_z_mul_254);
+    const auto reg_constant_num =
+        XMMReg4Double::Set1(psData->sin_altRadians_mul_254);
+    const auto reg_constant_denom = XMMReg4Double::Set1(psData->square_z);
+    const auto reg_half = XMMReg4Double::Set1(0.5);
+    const auto reg_one = reg_half + reg_half;
+    const auto reg_one_float = XMMReg4Float::Set1(1.0f);
+
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 4; j += 4)
+    {
+        XMMReg4Double reg_x;
+        XMMReg4Double reg_y;
+        Gradient4Val<T, REG_T, alg>(pafFirstLine + j - 1,
+                                    pafSecondLine + j - 1,
+                                    pafThirdLine + j - 1, reg_x, reg_y);
+        reg_x *= reg_inv_ewres;
+        reg_y *= reg_inv_nsres;
+
+        const auto reg_xx_plus_yy = reg_x * reg_x + reg_y * reg_y;
+        const auto reg_numerator =
+            reg_constant_num - (reg_y * reg_fact_y - reg_x * reg_fact_x);
+        const auto reg_denominator =
+            reg_one + reg_constant_denom * reg_xx_plus_yy;
+        const auto cang_mul_254 =
+            reg_numerator * reg_denominator.approx_inv_sqrt(reg_one, reg_half);
+
+        // cang = cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254
+        auto res = (cang_mul_254 + reg_one).cast_to_float();
+        res = XMMReg4Float::Max(reg_one_float, res);
+        res.Store4Val(pafOutputBuf + j);
+    }
+    return j;
+}
 #endif
 
 static const double INV_SQUARE_OF_HALF_PI = 1.0 / ((M_PI * M_PI) / 4);
@@ -1382,6 +1596,59 @@ static float GDALSlopeZevenbergenThorneAlg(const T *afWin,
     return static_cast<float>(100 * (sqrt(key) / 2));
 }
 
+#ifdef HAVE_16_SSE_REG
+
+template <class T, class REG_T, GradientAlg alg>
+static int GDALSlopeAlg_multisample(const T *pafFirstLine,
+                                    const T *pafSecondLine,
+                                    const T *pafThirdLine, int nXSize,
+                                    const AlgorithmParameters *pData,
+                                    float *pafOutputBuf)
+{
+    // Vectorized version of GDALSlopeHornAlg() and
+    // GDALSlopeZevenbergenThorneAlg() for the gradient computation.
+    const GDALSlopeAlgData *psData =
+        static_cast<const GDALSlopeAlgData *>(pData);
+    const auto reg_ewres = XMMReg4Double::Set1(psData->ewres_xscale);
+    const auto reg_nsres = XMMReg4Double::Set1(psData->nsres_yscale);
+    constexpr double dfDivisor = (alg == GradientAlg::HORN) ? 8 : 2;
+
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 4; j += 4)
+    {
+        XMMReg4Double reg_x;
+        XMMReg4Double reg_y;
+        Gradient4Val<T, REG_T, alg>(pafFirstLine + j - 1,
+                                    pafSecondLine + j - 1,
+                                    pafThirdLine + j - 1, reg_x, reg_y);
+        reg_x = reg_x / reg_ewres;
+        reg_y = reg_y / reg_nsres;
+        const auto reg_key = reg_x * reg_x + reg_y * reg_y;
+
+        double adfKey[4];
+        reg_key.Store4Val(adfKey);
+        if (psData->slopeFormat == 1)
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                pafOutputBuf[j + k] = static_cast<float>(
+                    atan(sqrt(adfKey[k]) / dfDivisor) * kdfRadiansToDegrees);
+            }
+        }
+        else
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                pafOutputBuf[j + k] =
+                    static_cast<float>(100 * (sqrt(adfKey[k]) / dfDivisor));
+            }
+        }
+    }
+    return j;
+}
+
+#endif
+
 static std::unique_ptr<AlgorithmParameters>
 GDALCreateSlopeData(double *adfGeoTransform, double xscale, double yscale,
                     int slopeFormat)
@@ -3849,6 +4116,12 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                     GDALHillshadeAlg<float, GradientAlg::ZEVENBERGEN_THORNE>;
                 pfnAlgInt32 =
                     GDALHillshadeAlg<GInt32, GradientAlg::ZEVENBERGEN_THORNE>;
+#ifdef HAVE_16_SSE_REG
+                pfnAlgFloat_multisample = GDALHillshadeAlg_multisample<
+                    float, XMMReg4Float, GradientAlg::ZEVENBERGEN_THORNE>;
+                pfnAlgInt32_multisample = GDALHillshadeAlg_multisample<
+                    GInt32, XMMReg4Int, GradientAlg::ZEVENBERGEN_THORNE>;
+#endif
             }
         }
         else
@@ -3885,6 +4158,14 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                 {
                     pfnAlgFloat = GDALHillshadeAlg<float, GradientAlg::HORN>;
                     pfnAlgInt32 = GDALHillshadeAlg<GInt32, GradientAlg::HORN>;
+#ifdef HAVE_16_SSE_REG
+                    pfnAlgFloat_multisample =
+                        GDALHillshadeAlg_multisample<float, XMMReg4Float,
+                                                     GradientAlg::HORN>;
+                    pfnAlgInt32_multisample =
+                        GDALHillshadeAlg_multisample<GInt32, XMMReg4Int,
+                                                     GradientAlg::HORN>;
+#endif
                 }
             }
         }
@@ -3901,11 +4182,27 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         {
             pfnAlgFloat = GDALSlopeZevenbergenThorneAlg<float>;
             pfnAlgInt32 = GDALSlopeZevenbergenThorneAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgFloat_multisample =
+                GDALSlopeAlg_multisample<float, XMMReg4Float,
+                                         GradientAlg::ZEVENBERGEN_THORNE>;
+            pfnAlgInt32_multisample =
+                GDALSlopeAlg_multisample<GInt32, XMMReg4Int,
+                                         GradientAlg::ZEVENBERGEN_THORNE>;
+#endif
         }
         else
         {
             pfnAlgFloat = GDALSlopeHornAlg<float>;
             pfnAlgInt32 = GDALSlopeHornAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgFloat_multisample =
+                GDALSlopeAlg_multisample<float, XMMReg4Float,
+                                         GradientAlg::HORN>;
+            pfnAlgInt32_multisample =
+                GDALSlopeAlg_multisample<GInt32, XMMReg4Int,
+                                         GradientAlg::HORN>;
+#endif
         }
     }
 
@@ -957,13 +957,28 @@ GDALDatasetH GDALTileIndexInternal(const char *pszDest,
     /* -------------------------------------------------------------------- */
     /*      loop over GDAL files, processing.                               */
     /* -------------------------------------------------------------------- */
+    // Sources are opened ahead in worker threads when GDAL_NUM_THREADS is
+    // set, and consumed in the order returned by the tile iterator.
+    GDALDatasetOpenPrefetcher oPrefetcher(
+        GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR, nullptr);
+    bool bIteratorExhausted = false;
     int iCur = 0;
     int nTotal = nSrcCount + 1;
     while (true)
     {
-        const std::string osSrcFilename = oGDALTileIndexTileIterator.next();
-        if (osSrcFilename.empty())
+        while (!bIteratorExhausted && oPrefetcher.GetPendingCount() <
+                                          oPrefetcher.GetMaxPendingCount())
+        {
+            const std::string osNextFilename =
+                oGDALTileIndexTileIterator.next();
+            if (osNextFilename.empty())
+                bIteratorExhausted = true;
+            else
+                oPrefetcher.Submit(osNextFilename);
+        }
+        if (oPrefetcher.GetPendingCount() == 0)
             break;
+        const std::string osSrcFilename = oPrefetcher.GetNextFilename();
 
         std::string osFileNameToWrite;
         VSIStatBuf sStatBuf;
@@ -988,12 +1003,11 @@ GDALDatasetH GDALTileIndexInternal(const char *pszDest,
             CPLError(CE_Warning, CPLE_AppDefined,
                      "File %s is already in tileindex. Skipping it.",
                      osFileNameToWrite.c_str());
+            oPrefetcher.SkipNext();
             continue;
         }
 
-        auto poSrcDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
-            osSrcFilename.c_str(), GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
-            nullptr, nullptr, nullptr));
+        auto poSrcDS = oPrefetcher.Next();
         if (poSrcDS == nullptr)
         {
             CPLError(CE_Warning, CPLE_AppDefined,
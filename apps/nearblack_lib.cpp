@@ -29,17 +29,23 @@
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #include "nearblack_lib.h"
 
-static void ProcessLine(GByte *pabyLine, GByte *pabyMask, int iStart, int iEnd,
-                        int nSrcBands, int nDstBands, int nNearDist,
-                        int nMaxNonBlack, const Colors &oColors,
-                        int *panLastLineCounts, bool bDoHorizontalCheck,
-                        bool bDoVerticalCheck, bool bBottomUp,
-                        int iLineFromTopOrBottom);
+static void ProcessLineVertical(GByte *pabyLine, GByte *pabyMask,
+                                int iColStart, int iColEnd, int nSrcBands,
+                                int nDstBands, int nNearDist, int nMaxNonBlack,
+                                const Colors &oColors, int *panLastLineCounts,
+                                int iLineFromTopOrBottom);
+static void ProcessLineHorizontal(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                  int iEnd, int nSrcBands, int nDstBands,
+                                  int nNearDist, int nMaxNonBlack,
+                                  const Colors &oColors,
+                                  const int *panLastLineCounts, bool bBottomUp);
 
 /************************************************************************/
 /*                            GDALNearblack()                           */
@@ -352,6 +358,18 @@ GDALDatasetH CPL_DLL GDALNearblack(const char *pszDest, GDALDatasetH hDstDS,
     return hDstDS;
 }
 
+/************************************************************************/
+/*                     GDALNearblackGetNumThreads()                     */
+/************************************************************************/
+
+int GDALNearblackGetNumThreads()
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    return std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                         ? CPLGetNumCPUs()
+                                         : atoi(pszThreads)));
+}
+
 /************************************************************************/
 /*                   GDALNearblackTwoPassesAlgorithm()                  */
 /*                                                                      */
@@ -373,33 +391,152 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
     const bool bSetAlpha = psOptions->bSetAlpha;
 
     /* -------------------------------------------------------------------- */
-    /*      Allocate a line buffer.                                         */
+    /*      With several threads, lines are processed by strips. The       */
+    /*      vertical check of a column only depends on that column, and     */
+    /*      the horizontal check of a line only depends on that line and    */
+    /*      on the column counters resulting from its vertical check, so    */
+    /*      the vertical check is split by ranges of columns, and the       */
+    /*      horizontal one by ranges of lines.                              */
     /* -------------------------------------------------------------------- */
+    const int nThreads = GDALNearblackGetNumThreads();
+    std::unique_ptr<CPLJobQueue> poQueue;
+    if (nThreads > 1)
+    {
+        CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+        if (poPool)
+            poQueue = poPool->CreateJobQueue();
+    }
 
-    std::vector<GByte> abyLine(static_cast<size_t>(nXSize) * nDstBands);
-    GByte *pabyLine = abyLine.data();
+    int nLinesPerStrip = 1;
+    if (poQueue)
+    {
+        constexpr size_t STRIP_MEMORY_SIZE = 16 * 1024 * 1024;
+        nLinesPerStrip = static_cast<int>(std::min<size_t>(
+            nYSize,
+            std::max<size_t>(
+                1, STRIP_MEMORY_SIZE /
+                       (static_cast<size_t>(nXSize) *
+                        (nDstBands + (bSetMask ? 1 : 0) + sizeof(int))))));
+    }
 
+    /* -------------------------------------------------------------------- */
+    /*      Allocate strip buffers.                                         */
+    /* -------------------------------------------------------------------- */
+    std::vector<GByte> abyStrip;
     std::vector<GByte> abyMask;
-    GByte *pabyMask = nullptr;
-    if (bSetMask)
+    std::vector<int> anLastLineCounts;
+    std::vector<int> anStripLineCounts;
+    try
     {
-        abyMask.resize(nXSize);
-        pabyMask = abyMask.data();
+        abyStrip.resize(static_cast<size_t>(nLinesPerStrip) * nXSize *
+                        nDstBands);
+        if (bSetMask)
+            abyMask.resize(static_cast<size_t>(nLinesPerStrip) * nXSize);
+        anLastLineCounts.resize(nXSize);
+        anStripLineCounts.resize(static_cast<size_t>(nLinesPerStrip) * nXSize);
     }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffers: %s", e.what());
+        return false;
+    }
+    const size_t nLineStride = static_cast<size_t>(nXSize) * nDstBands;
+    const int nStrips = DIV_ROUND_UP(nYSize, nLinesPerStrip);
 
-    std::vector<int> anLastLineCounts(nXSize);
-    int *panLastLineCounts = anLastLineCounts.data();
+    // Run Task(iTask) for iTask in [0, nTasks), in worker threads if possible
+    const auto RunTasks = [&poQueue](int nTasks, const auto &Task)
+    {
+        if (!poQueue || nTasks == 1)
+        {
+            for (int iTask = 0; iTask < nTasks; ++iTask)
+                Task(iTask);
+            return;
+        }
+        for (int iTask = 0; iTask < nTasks; ++iTask)
+            poQueue->SubmitJob([&Task, iTask]() { Task(iTask); });
+        poQueue->WaitCompletion();
+    };
+
+    // Apply the vertical and horizontal checks to the nLines lines loaded in
+    // the strip buffers, starting at line nYOff.
+    const auto ProcessStrip = [&](int nYOff, int nLines, bool bBottomUp)
+    {
+        // Index in strip of the k-th line in processing order
+        const auto LineIdx = [nLines, bBottomUp](int k)
+        { return bBottomUp ? nLines - 1 - k : k; };
+
+        const int nColChunks =
+            poQueue ? std::max(1, std::min(nThreads, nXSize / 256)) : 1;
+        RunTasks(
+            nColChunks,
+            [&](int iChunk)
+            {
+                const int iColStart = static_cast<int>(
+                    static_cast<GIntBig>(nXSize) * iChunk / nColChunks);
+                const int iColEnd = static_cast<int>(
+                    static_cast<GIntBig>(nXSize) * (iChunk + 1) / nColChunks);
+                for (int k = 0; k < nLines; ++k)
+                {
+                    const int iLineInStrip = LineIdx(k);
+                    const int iLine = nYOff + iLineInStrip;
+                    ProcessLineVertical(
+                        abyStrip.data() + iLineInStrip * nLineStride,
+                        bSetMask ? abyMask.data() +
+                                       static_cast<size_t>(iLineInStrip) *
+                                           nXSize
+                                 : nullptr,
+                        iColStart, iColEnd, nBands, nDstBands, nNearDist,
+                        nMaxNonBlack, oColors, anLastLineCounts.data(),
+                        bBottomUp ? nYSize - 1 - iLine : iLine);
+                    memcpy(anStripLineCounts.data() +
+                               static_cast<size_t>(iLineInStrip) * nXSize +
+                               iColStart,
+                           anLastLineCounts.data() + iColStart,
+                           sizeof(int) * (iColEnd - iColStart));
+                }
+            });
+
+        const int nLineChunks =
+            poQueue ? std::max(1, std::min(nThreads * 4, nLines)) : 1;
+        RunTasks(nLineChunks,
+                 [&](int iChunk)
+                 {
+                     const int iFirst = nLines * iChunk / nLineChunks;
+                     const int iLast = nLines * (iChunk + 1) / nLineChunks;
+                     for (int i = iFirst; i < iLast; ++i)
+                     {
+                         GByte *pabyLine = abyStrip.data() + i * nLineStride;
+                         GByte *pabyLineMask =
+                             bSetMask ? abyMask.data() +
+                                            static_cast<size_t>(i) * nXSize
+                                      : nullptr;
+                         int *panCounts = anStripLineCounts.data() +
+                                          static_cast<size_t>(i) * nXSize;
+                         ProcessLineHorizontal(pabyLine, pabyLineMask, 0,
+                                               nXSize - 1, nBands, nDstBands,
+                                               nNearDist, nMaxNonBlack, oColors,
+                                               panCounts, bBottomUp);
+                         ProcessLineHorizontal(pabyLine, pabyLineMask,
+                                               nXSize - 1, 0, nBands, nDstBands,
+                                               nNearDist, nMaxNonBlack, oColors,
+                                               panCounts, bBottomUp);
+                     }
+                 });
+    };
 
     /* -------------------------------------------------------------------- */
-    /*      Processing data one line at a time.                             */
+    /*      Processing data one strip at a time.                            */
     /* -------------------------------------------------------------------- */
-    int iLine;
-
-    for (iLine = 0; iLine < nYSize; iLine++)
+    for (int iStrip = 0; iStrip < nStrips; iStrip++)
     {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+
         CPLErr eErr = GDALDatasetRasterIO(
-            hSrcDataset, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1,
-            GDT_Byte, nBands, nullptr, nDstBands, nXSize * nDstBands, 1);
+            hSrcDataset, GF_Read, 0, nYOff, nXSize, nLines, abyStrip.data(),
+            nXSize, nLines, GDT_Byte, nBands, nullptr, nDstBands,
+            static_cast<GSpacing>(nLineStride), 1);
         if (eErr != CE_None)
         {
             return false;
@@ -407,48 +544,35 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
 
         if (bSetAlpha)
         {
-            for (int iCol = 0; iCol < nXSize; iCol++)
+            for (size_t i = 0; i < static_cast<size_t>(nLines) * nXSize; i++)
             {
-                pabyLine[iCol * nDstBands + nDstBands - 1] = 255;
+                abyStrip[i * nDstBands + nDstBands - 1] = 255;
             }
         }
 
         if (bSetMask)
         {
-            for (int iCol = 0; iCol < nXSize; iCol++)
-            {
-                pabyMask[iCol] = 255;
-            }
+            memset(abyMask.data(), 255, static_cast<size_t>(nLines) * nXSize);
         }
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, oColors, panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    true,   // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, oColors, panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
+        ProcessStrip(nYOff, nLines, /* bBottomUp = */ false);
 
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
+        eErr = GDALDatasetRasterIO(
+            hDstDS, GF_Write, 0, nYOff, nXSize, nLines, abyStrip.data(),
+            nXSize, nLines, GDT_Byte, nDstBands, nullptr, nDstBands,
+            static_cast<GSpacing>(nLineStride), 1);
 
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** write out the mask band line *****/
+        /***** write out the mask band lines *****/
 
         if (bSetMask)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, nYOff, nXSize, nLines,
+                                abyMask.data(), nXSize, nLines, GDT_Byte, 0, 0);
             if (eErr != CE_None)
             {
                 CPLError(CE_Warning, CPLE_AppDefined,
@@ -458,7 +582,7 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
         }
 
         if (!(psOptions->pfnProgress(
-                0.5 * ((iLine + 1) / static_cast<double>(nYSize)), nullptr,
+                0.5 * ((nYOff + nLines) / static_cast<double>(nYSize)), nullptr,
                 psOptions->pProgressData)))
         {
             return false;
@@ -468,64 +592,59 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
     /* -------------------------------------------------------------------- */
     /*      Now process from the bottom back up                            .*/
     /* -------------------------------------------------------------------- */
-    memset(panLastLineCounts, 0, sizeof(int) * nXSize);
+    std::fill(anLastLineCounts.begin(), anLastLineCounts.end(), 0);
 
-    for (iLine = nYSize - 1; hDstDS != nullptr && iLine >= 0; iLine--)
+    for (int iStrip = 0; hDstDS != nullptr && iStrip < nStrips; iStrip++)
     {
+        const int nYEnd = nYSize - iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYEnd);
+        const int nYOff = nYEnd - nLines;
+
         CPLErr eErr = GDALDatasetRasterIO(
-            hDstDS, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1, GDT_Byte,
-            nDstBands, nullptr, nDstBands, nXSize * nDstBands, 1);
+            hDstDS, GF_Read, 0, nYOff, nXSize, nLines, abyStrip.data(), nXSize,
+            nLines, GDT_Byte, nDstBands, nullptr, nDstBands,
+            static_cast<GSpacing>(nLineStride), 1);
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** read the mask band line back in *****/
+        /***** read the mask band lines back in *****/
 
         if (bSetMask)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, nYOff, nXSize, nLines,
+                                abyMask.data(), nXSize, nLines, GDT_Byte, 0, 0);
             if (eErr != CE_None)
             {
                 return false;
             }
         }
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, oColors, panLastLineCounts,
-                    true,  // bDoHorizontalCheck
-                    true,  // bDoVerticalCheck
-                    true,  // bBottomUp
-                    nYSize - 1 - iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, oColors, panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    true,   // bBottomUp
-                    nYSize - 1 - iLine);
-
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
+        ProcessStrip(nYOff, nLines, /* bBottomUp = */ true);
+
+        eErr = GDALDatasetRasterIO(
+            hDstDS, GF_Write, 0, nYOff, nXSize, nLines, abyStrip.data(),
+            nXSize, nLines, GDT_Byte, nDstBands, nullptr, nDstBands,
+            static_cast<GSpacing>(nLineStride), 1);
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** write out the mask band line *****/
+        /***** write out the mask band lines *****/
 
         if (bSetMask)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, nYOff, nXSize, nLines,
+                                abyMask.data(), nXSize, nLines, GDT_Byte, 0, 0);
             if (eErr != CE_None)
             {
                 return false;
             }
         }
 
-        if (!(psOptions->pfnProgress(0.5 + 0.5 * (nYSize - iLine) /
+        if (!(psOptions->pfnProgress(0.5 + 0.5 * (nYSize - nYOff) /
                                                static_cast<double>(nYSize),
                                      nullptr, psOptions->pProgressData)))
         {
@@ -537,206 +656,198 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
 }
 
 /************************************************************************/
-/*                            ProcessLine()                             */
-/*                                                                      */
-/*      Process a single scanline of image data.                        */
+/*                            IsNonBlack()                              */
 /************************************************************************/
 
-static void ProcessLine(GByte *pabyLine, GByte *pabyMask, int iStart, int iEnd,
-                        int nSrcBands, int nDstBands, int nNearDist,
-                        int nMaxNonBlack, const Colors &oColors,
-                        int *panLastLineCounts, bool bDoHorizontalCheck,
-                        bool bDoVerticalCheck, bool bBottomUp,
-                        int iLineFromTopOrBottom)
+static inline bool IsNonBlack(const GByte *pabyPixel, int nSrcBands,
+                              int nNearDist, const Colors &oColors)
 {
-    const GByte nReplaceValue = !oColors.empty() && oColors.size() == 1 &&
-                                        !oColors[0].empty() &&
-                                        oColors[0][0] == 255
-                                    ? 255
-                                    : 0;
+    bool bIsNonBlack = false;
 
-    /* -------------------------------------------------------------------- */
-    /*      Vertical checking.                                              */
-    /* -------------------------------------------------------------------- */
+    /***** loop over the colors *****/
 
-    if (bDoVerticalCheck)
+    for (int iColor = 0; iColor < static_cast<int>(oColors.size()); iColor++)
     {
-        const int nXSize = std::max(iStart + 1, iEnd + 1);
+        const Color &oColor = oColors[iColor];
 
-        for (int i = 0; i < nXSize; i++)
-        {
-            // are we already terminated for this column?
-            if (panLastLineCounts[i] > nMaxNonBlack)
-                continue;
+        bIsNonBlack = false;
 
-            /***** is the pixel valid data? ****/
+        /***** loop over the bands *****/
 
-            bool bIsNonBlack = false;
-
-            /***** loop over the colors *****/
+        for (int iBand = 0; iBand < nSrcBands; iBand++)
+        {
+            const int nPix = pabyPixel[iBand];
 
-            for (int iColor = 0; iColor < static_cast<int>(oColors.size());
-                 iColor++)
+            if (oColor[iBand] - nPix > nNearDist ||
+                nPix > nNearDist + oColor[iBand])
             {
+                bIsNonBlack = true;
+                break;
+            }
+        }
 
-                const Color &oColor = oColors[iColor];
+        if (!bIsNonBlack)
+            break;
+    }
 
-                bIsNonBlack = false;
+    return bIsNonBlack;
+}
 
-                /***** loop over the bands *****/
+/************************************************************************/
+/*                           GetReplaceValue()                          */
+/************************************************************************/
 
-                for (int iBand = 0; iBand < nSrcBands; iBand++)
-                {
-                    const int nPix = pabyLine[i * nDstBands + iBand];
+static inline GByte GetReplaceValue(const Colors &oColors)
+{
+    return !oColors.empty() && oColors.size() == 1 && !oColors[0].empty() &&
+                   oColors[0][0] == 255
+               ? 255
+               : 0;
+}
 
-                    if (oColor[iBand] - nPix > nNearDist ||
-                        nPix > nNearDist + oColor[iBand])
-                    {
-                        bIsNonBlack = true;
-                        break;
-                    }
-                }
+/************************************************************************/
+/*                        ProcessLineVertical()                         */
+/*                                                                      */
+/*      Vertical checking of the [iColStart, iColEnd[ columns of a      */
+/*      single scanline of image data.                                  */
+/************************************************************************/
 
-                if (!bIsNonBlack)
-                    break;
-            }
+static void ProcessLineVertical(GByte *pabyLine, GByte *pabyMask,
+                                int iColStart, int iColEnd, int nSrcBands,
+                                int nDstBands, int nNearDist, int nMaxNonBlack,
+                                const Colors &oColors, int *panLastLineCounts,
+                                int iLineFromTopOrBottom)
+{
+    const GByte nReplaceValue = GetReplaceValue(oColors);
 
-            if (bIsNonBlack)
-            {
-                panLastLineCounts[i]++;
+    for (int i = iColStart; i < iColEnd; i++)
+    {
+        // are we already terminated for this column?
+        if (panLastLineCounts[i] > nMaxNonBlack)
+            continue;
 
-                if (panLastLineCounts[i] > nMaxNonBlack)
-                    continue;
+        /***** is the pixel valid data? ****/
 
-                if (iLineFromTopOrBottom == 0 && nMaxNonBlack > 0)
-                {
-                    // if there's a valid value just at the top or bottom
-                    // of the raster, then ignore the nMaxNonBlack setting
-                    panLastLineCounts[i] = nMaxNonBlack + 1;
-                    continue;
-                }
-            }
-            // else
-            //   panLastLineCounts[i] = 0; // not sure this even makes sense
+        const bool bIsNonBlack = IsNonBlack(pabyLine + i * nDstBands,
+                                            nSrcBands, nNearDist, oColors);
 
-            /***** replace the pixel values *****/
-            for (int iBand = 0; iBand < nSrcBands; iBand++)
-                pabyLine[i * nDstBands + iBand] = nReplaceValue;
+        if (bIsNonBlack)
+        {
+            panLastLineCounts[i]++;
 
-            /***** alpha *****/
-            if (nDstBands > nSrcBands)
-                pabyLine[i * nDstBands + nDstBands - 1] = 0;
+            if (panLastLineCounts[i] > nMaxNonBlack)
+                continue;
 
-            /***** mask *****/
-            if (pabyMask != nullptr)
-                pabyMask[i] = 0;
+            if (iLineFromTopOrBottom == 0 && nMaxNonBlack > 0)
+            {
+                // if there's a valid value just at the top or bottom
+                // of the raster, then ignore the nMaxNonBlack setting
+                panLastLineCounts[i] = nMaxNonBlack + 1;
+                continue;
+            }
         }
-    }
+        // else
+        //   panLastLineCounts[i] = 0; // not sure this even makes sense
 
-    /* -------------------------------------------------------------------- */
-    /*      Horizontal Checking.                                            */
-    /* -------------------------------------------------------------------- */
-
-    if (bDoHorizontalCheck)
-    {
-        int nNonBlackPixels = 0;
+        /***** replace the pixel values *****/
+        for (int iBand = 0; iBand < nSrcBands; iBand++)
+            pabyLine[i * nDstBands + iBand] = nReplaceValue;
 
-        /***** on a bottom up pass assume nMaxNonBlack is 0 *****/
+        /***** alpha *****/
+        if (nDstBands > nSrcBands)
+            pabyLine[i * nDstBands + nDstBands - 1] = 0;
 
-        if (bBottomUp)
-            nMaxNonBlack = 0;
-
-        const int iDir = iStart < iEnd ? 1 : -1;
-
-        bool bDoTest = TRUE;
-
-        for (int i = iStart; i != iEnd; i += iDir)
-        {
-            /***** not seen any valid data? *****/
+        /***** mask *****/
+        if (pabyMask != nullptr)
+            pabyMask[i] = 0;
+    }
+}
 
-            if (bDoTest)
-            {
-                /***** is the pixel valid data? ****/
+/************************************************************************/
+/*                       ProcessLineHorizontal()                        */
+/*                                                                      */
+/*      Horizontal checking of a single scanline of image data, from    */
+/*      iStart (included) to iEnd (excluded).                           */
+/************************************************************************/
 
-                bool bIsNonBlack = false;
+static void ProcessLineHorizontal(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                  int iEnd, int nSrcBands, int nDstBands,
+                                  int nNearDist, int nMaxNonBlack,
+                                  const Colors &oColors,
+                                  const int *panLastLineCounts, bool bBottomUp)
+{
+    const GByte nReplaceValue = GetReplaceValue(oColors);
 
-                /***** loop over the colors *****/
+    int nNonBlackPixels = 0;
 
-                for (int iColor = 0; iColor < static_cast<int>(oColors.size());
-                     iColor++)
-                {
+    /***** on a bottom up pass assume nMaxNonBlack is 0 *****/
 
-                    const Color &oColor = oColors[iColor];
+    if (bBottomUp)
+        nMaxNonBlack = 0;
 
-                    bIsNonBlack = false;
+    const int iDir = iStart < iEnd ? 1 : -1;
 
-                    /***** loop over the bands *****/
+    bool bDoTest = TRUE;
 
-                    for (int iBand = 0; iBand < nSrcBands; iBand++)
-                    {
-                        const int nPix = pabyLine[i * nDstBands + iBand];
+    for (int i = iStart; i != iEnd; i += iDir)
+    {
+        /***** not seen any valid data? *****/
 
-                        if (oColor[iBand] - nPix > nNearDist ||
-                            nPix > nNearDist + oColor[iBand])
-                        {
-                            bIsNonBlack = true;
-                            break;
-                        }
-                    }
+        if (bDoTest)
+        {
+            /***** is the pixel valid data? ****/
 
-                    if (bIsNonBlack == false)
-                        break;
-                }
+            const bool bIsNonBlack = IsNonBlack(pabyLine + i * nDstBands,
+                                                nSrcBands, nNearDist, oColors);
 
-                if (bIsNonBlack)
-                {
-                    /***** use nNonBlackPixels in grey areas  *****/
-                    /***** from the vertical pass's grey areas ****/
+            if (bIsNonBlack)
+            {
+                /***** use nNonBlackPixels in grey areas  *****/
+                /***** from the vertical pass's grey areas ****/
 
-                    if (panLastLineCounts[i] <= nMaxNonBlack)
-                        nNonBlackPixels = panLastLineCounts[i];
-                    else
-                        nNonBlackPixels++;
-                }
+                if (panLastLineCounts[i] <= nMaxNonBlack)
+                    nNonBlackPixels = panLastLineCounts[i];
+                else
+                    nNonBlackPixels++;
+            }
 
-                if (nNonBlackPixels > nMaxNonBlack)
-                {
-                    bDoTest = false;
-                    continue;
-                }
+            if (nNonBlackPixels > nMaxNonBlack)
+            {
+                bDoTest = false;
+                continue;
+            }
 
-                if (bIsNonBlack && nMaxNonBlack > 0 && i == iStart)
-                {
-                    // if there's a valid value just at the left or right
-                    // of the raster, then ignore the nMaxNonBlack setting
-                    bDoTest = false;
-                    continue;
-                }
+            if (bIsNonBlack && nMaxNonBlack > 0 && i == iStart)
+            {
+                // if there's a valid value just at the left or right
+                // of the raster, then ignore the nMaxNonBlack setting
+                bDoTest = false;
+                continue;
+            }
 
-                /***** replace the pixel values *****/
+            /***** replace the pixel values *****/
 
-                for (int iBand = 0; iBand < nSrcBands; iBand++)
-                    pabyLine[i * nDstBands + iBand] = nReplaceValue;
+            for (int iBand = 0; iBand < nSrcBands; iBand++)
+                pabyLine[i * nDstBands + iBand] = nReplaceValue;
 
-                /***** alpha *****/
+            /***** alpha *****/
 
-                if (nDstBands > nSrcBands)
-                    pabyLine[i * nDstBands + nDstBands - 1] = 0;
+            if (nDstBands > nSrcBands)
+                pabyLine[i * nDstBands + nDstBands - 1] = 0;
 
-                /***** mask *****/
+            /***** mask *****/
 
-                if (pabyMask != nullptr)
-                    pabyMask[i] = 0;
-            }
+            if (pabyMask != nullptr)
+                pabyMask[i] = 0;
+        }
 
-            /***** seen valid data but test if the *****/
-            /***** vertical pass saw any non valid data *****/
+        /***** seen valid data but test if the *****/
+        /***** vertical pass saw any non valid data *****/
 
-            else if (panLastLineCounts[i] == 0)
-            {
-                bDoTest = true;
-                nNonBlackPixels = 0;
-            }
+        else if (panLastLineCounts[i] == 0)
+        {
+            bDoTest = true;
+            nNonBlackPixels = 0;
         }
     }
 }
@@ -49,6 +49,8 @@ struct GDALNearblackOptions
     CPLStringList aosCreationOptions{};
 };
 
+int GDALNearblackGetNumThreads();
+
 bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
                                      GDALDatasetH hSrcDataset,
                                      GDALDatasetH hDstDS,
@@ -11,13 +11,52 @@
  * SPDX-License-Identifier: MIT
  ****************************************************************************/
 
+#include "cpl_worker_thread_pool.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "nearblack_lib.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <queue>
 
+/************************************************************************/
+/*                        IsTransparentPixel()                          */
+/************************************************************************/
+
+// Returns true if the pixel, whose m_nSrcBands first components are pointed
+// by pabyPixel, matches one of the colors within nNearDist.
+static bool IsTransparentPixel(const GByte *pabyPixel, int nSrcBands,
+                               int nNearDist, const Colors &oColors)
+{
+    /***** loop over the colors *****/
+
+    for (const Color &oColor : oColors)
+    {
+        /***** loop over the bands *****/
+        bool bIsNonBlack = false;
+
+        for (int iBand = 0; iBand < nSrcBands; iBand++)
+        {
+            const int nPix = pabyPixel[iBand];
+
+            if (oColor[iBand] - nPix > nNearDist ||
+                nPix > nNearDist + oColor[iBand])
+            {
+                bIsNonBlack = true;
+                break;
+            }
+        }
+
+        if (!bIsNonBlack)
+            return true;
+    }
+
+    return false;
+}
+
 /************************************************************************/
 /*                    GDALNearblackFloodFillAlg                         */
 /************************************************************************/
@@ -83,6 +122,7 @@ struct GDALNearblackFloodFillAlg
     bool Process();
 
   private:
+    bool ProcessMultiThreaded(CPLJobQueue *poQueue, int nThreads);
     bool Fill(int iX, int iY);
     bool LoadLine(int iY);
     bool MustSet(int iX, int iY);
@@ -112,36 +152,11 @@ bool GDALNearblackFloodFillAlg::MustSet(int iX, int iY)
         return m_abyLineMustSet[iX] == MUST_FILL_TRUE;
     }
 
-    /***** loop over the colors *****/
-
-    for (int iColor = 0; iColor < static_cast<int>(m_oColors.size()); iColor++)
-    {
-        const Color &oColor = m_oColors[iColor];
-
-        /***** loop over the bands *****/
-        bool bIsNonBlack = false;
-
-        for (int iBand = 0; iBand < m_nSrcBands; iBand++)
-        {
-            const int nPix = m_abyLine[iX * m_nDstBands + iBand];
-
-            if (oColor[iBand] - nPix > m_psOptions->nNearDist ||
-                nPix > m_psOptions->nNearDist + oColor[iBand])
-            {
-                bIsNonBlack = true;
-                break;
-            }
-        }
-
-        if (!bIsNonBlack)
-        {
-            m_abyLineMustSet[iX] = MUST_FILL_TRUE;
-            return true;
-        }
-    }
-
-    m_abyLineMustSet[iX] = MUST_FILL_FALSE;
-    return false;
+    const bool bMustSet =
+        IsTransparentPixel(&m_abyLine[iX * m_nDstBands], m_nSrcBands,
+                           m_psOptions->nNearDist, m_oColors);
+    m_abyLineMustSet[iX] = bMustSet ? MUST_FILL_TRUE : MUST_FILL_FALSE;
+    return bMustSet;
 }
 
 /************************************************************************/
@@ -434,6 +449,476 @@ bool GDALNearblackFloodFillAlg::Fill(int iXInit, int iYInit)
     return true;
 }
 
+/************************************************************************/
+/*                     NearblackLabelStrip()                            */
+/************************************************************************/
+
+namespace
+{
+// Connected components of the transparent pixels of a strip of lines
+struct NearblackStripLabels
+{
+    // Component of each pixel of the strip, or -1 for opaque pixels
+    std::vector<int> anLabels{};
+
+    // Whether each component contains a pixel of the border of the raster
+    std::vector<bool> abTouchesBorder{};
+};
+}  // namespace
+
+// Labels the 4-connected components of the transparent pixels of a strip of
+// nLines lines. Labels are numbered from 0 in the order in which their first
+// pixel is met, so that labeling the same strip twice gives the same result.
+static void NearblackLabelStrip(const GByte *pabyStrip, int nXSize, int nLines,
+                                bool bFirstLineIsBorder, bool bLastLineIsBorder,
+                                int nSrcBands, int nDstBands, int nNearDist,
+                                const Colors &oColors,
+                                NearblackStripLabels &oLabels)
+{
+    auto &anLabels = oLabels.anLabels;
+    anLabels.assign(static_cast<size_t>(nXSize) * nLines, -1);
+
+    // Union-find over provisional labels, where the parent of a label is
+    // always lower or equal to it.
+    std::vector<int> anParent;
+    const auto Find = [&anParent](int n)
+    {
+        while (anParent[n] != n)
+        {
+            anParent[n] = anParent[anParent[n]];
+            n = anParent[n];
+        }
+        return n;
+    };
+
+    size_t iIdx = 0;
+    for (int iLine = 0; iLine < nLines; iLine++)
+    {
+        for (int iCol = 0; iCol < nXSize; iCol++, iIdx++)
+        {
+            if (!IsTransparentPixel(pabyStrip + iIdx * nDstBands, nSrcBands,
+                                    nNearDist, oColors))
+            {
+                continue;
+            }
+            const int nLeft = iCol > 0 ? anLabels[iIdx - 1] : -1;
+            const int nUp = iLine > 0 ? anLabels[iIdx - nXSize] : -1;
+            int nLabel;
+            if (nLeft < 0 && nUp < 0)
+            {
+                nLabel = static_cast<int>(anParent.size());
+                anParent.push_back(nLabel);
+            }
+            else if (nLeft >= 0 && nUp >= 0)
+            {
+                nLabel = nLeft;
+                const int nRootLeft = Find(nLeft);
+                const int nRootUp = Find(nUp);
+                if (nRootLeft < nRootUp)
+                    anParent[nRootUp] = nRootLeft;
+                else if (nRootUp < nRootLeft)
+                    anParent[nRootLeft] = nRootUp;
+            }
+            else
+            {
+                nLabel = std::max(nLeft, nUp);
+            }
+            anLabels[iIdx] = nLabel;
+        }
+    }
+
+    // Renumber provisional labels into consecutive component numbers
+    std::vector<int> anComponent(anParent.size());
+    int nComponents = 0;
+    for (int i = 0; i < static_cast<int>(anParent.size()); i++)
+    {
+        const int nRoot = Find(i);
+        anComponent[i] = nRoot == i ? nComponents++ : anComponent[nRoot];
+    }
+
+    auto &abTouchesBorder = oLabels.abTouchesBorder;
+    abTouchesBorder.assign(nComponents, false);
+    iIdx = 0;
+    for (int iLine = 0; iLine < nLines; iLine++)
+    {
+        const bool bBorderLine = (iLine == 0 && bFirstLineIsBorder) ||
+                                 (iLine == nLines - 1 && bLastLineIsBorder);
+        for (int iCol = 0; iCol < nXSize; iCol++, iIdx++)
+        {
+            if (anLabels[iIdx] >= 0)
+            {
+                anLabels[iIdx] = anComponent[anLabels[iIdx]];
+                if (bBorderLine || iCol == 0 || iCol == nXSize - 1)
+                    abTouchesBorder[anLabels[iIdx]] = true;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                  NearblackProcessStripsInOrder()                     */
+/************************************************************************/
+
+// Runs pfnRead(iStrip, oSlot) in the calling thread, then pfnProcess(iStrip,
+// oSlot) in a worker thread, then pfnConsume(iStrip, oSlot) in the calling
+// thread, for each strip, with consumption in the order of strips and at most
+// nMaxInFlight strips read but not consumed yet.
+// Returns true if no error.
+template <class Slot, class ReadFunc, class ProcessFunc, class ConsumeFunc>
+static bool NearblackProcessStripsInOrder(CPLJobQueue *poQueue, int nStrips,
+                                          int nMaxInFlight, ReadFunc pfnRead,
+                                          ProcessFunc pfnProcess,
+                                          ConsumeFunc pfnConsume)
+{
+    struct Entry
+    {
+        Slot oSlot{};
+        bool bDone = false;
+    };
+
+    std::vector<std::unique_ptr<Entry>> apoEntries(nStrips);
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    bool bRet = true;
+    int iNextToSubmit = 0;
+    for (int iStrip = 0; bRet && iStrip < nStrips; iStrip++)
+    {
+        while (iNextToSubmit < nStrips &&
+               iNextToSubmit - iStrip < nMaxInFlight)
+        {
+            auto poEntry = std::make_unique<Entry>();
+            if (!pfnRead(iNextToSubmit, poEntry->oSlot))
+            {
+                bRet = false;
+                break;
+            }
+            Entry *poEntryPtr = poEntry.get();
+            apoEntries[iNextToSubmit] = std::move(poEntry);
+            const int iStripToProcess = iNextToSubmit;
+            const auto lambda =
+                [&pfnProcess, &oMutex, &oCV, poEntryPtr, iStripToProcess]()
+            {
+                pfnProcess(iStripToProcess, poEntryPtr->oSlot);
+                std::lock_guard oLock(oMutex);
+                poEntryPtr->bDone = true;
+                oCV.notify_all();
+            };
+            if (!poQueue->SubmitJob(lambda))
+                lambda();
+            ++iNextToSubmit;
+        }
+        if (!bRet)
+            break;
+
+        Entry *poEntry = apoEntries[iStrip].get();
+        {
+            std::unique_lock oLock(oMutex);
+            oCV.wait(oLock, [poEntry] { return poEntry->bDone; });
+        }
+        bRet = pfnConsume(iStrip, poEntry->oSlot);
+        apoEntries[iStrip].reset();
+    }
+    poQueue->WaitCompletion();
+    return bRet;
+}
+
+/************************************************************************/
+/*          GDALNearblackFloodFillAlg::ProcessMultiThreaded()           */
+/************************************************************************/
+
+// Multi-threaded equivalent of the flood fill from the border of the raster:
+// the set of pixels it modifies is the union of the 4-connected components of
+// transparent pixels that contain a pixel of the border. Those components are
+// computed independently for strips of lines in worker threads, and then
+// connected across strip boundaries in the main thread.
+// Returns true if no error.
+
+bool GDALNearblackFloodFillAlg::ProcessMultiThreaded(CPLJobQueue *poQueue,
+                                                     int nThreads)
+{
+    const int nXSize = m_poSrcDataset->GetRasterXSize();
+    const int nYSize = m_poSrcDataset->GetRasterYSize();
+    const size_t nLineSize = static_cast<size_t>(nXSize) * m_nDstBands;
+
+    // Strips of about 16 MB, but with enough of them to keep workers busy
+    constexpr size_t STRIP_SIZE = 16 * 1024 * 1024;
+    const int nLinesPerStrip = static_cast<int>(std::max<size_t>(
+        1, std::min<size_t>(std::max<size_t>(1, STRIP_SIZE / nLineSize),
+                            DIV_ROUND_UP(nYSize, 4 * nThreads))));
+    const int nStrips = DIV_ROUND_UP(nYSize, nLinesPerStrip);
+    const int nMaxInFlight = 2 * nThreads;
+
+    // Same logic as LoadLine(), except that when the output dataset is the
+    // source one, all its bands are read, including the alpha one.
+    const bool bReadFromDst =
+        m_psOptions->nMaxNonBlack > 0 && m_poDstDS != m_poSrcDataset;
+    GDALDataset *poReadDS = bReadFromDst ? m_poDstDS : m_poSrcDataset;
+    const int nReadBands =
+        poReadDS == m_poDstDS ? m_nDstBands : m_nSrcBands;
+    const bool bInitAlpha =
+        m_psOptions->bSetAlpha && m_psOptions->nMaxNonBlack == 0;
+
+    struct Strip
+    {
+        std::vector<GByte> abyLines{};
+        std::vector<GByte> abyMask{};
+        NearblackStripLabels oLabels{};
+        bool bModified = false;
+    };
+
+    const auto ReadStrip = [&](int iStrip, Strip &oStrip, bool bWithMask)
+    {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        try
+        {
+            oStrip.abyLines.resize(nLineSize * nLines);
+            if (bWithMask)
+                oStrip.abyMask.resize(static_cast<size_t>(nXSize) * nLines);
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate working buffers: %s", e.what());
+            return false;
+        }
+        if (poReadDS->RasterIO(GF_Read, 0, nYOff, nXSize, nLines,
+                               oStrip.abyLines.data(), nXSize, nLines,
+                               GDT_Byte, nReadBands, nullptr, m_nDstBands,
+                               static_cast<GSpacing>(nLineSize), 1,
+                               nullptr) != CE_None)
+        {
+            return false;
+        }
+        if (bWithMask && bInitAlpha)
+        {
+            for (size_t i = m_nDstBands - 1; i < oStrip.abyLines.size();
+                 i += m_nDstBands)
+            {
+                oStrip.abyLines[i] = 255;
+            }
+        }
+        if (bWithMask && m_bSetMask)
+        {
+            if (m_psOptions->nMaxNonBlack == 0)
+            {
+                std::fill(oStrip.abyMask.begin(), oStrip.abyMask.end(),
+                          static_cast<GByte>(255));
+            }
+            else if (m_poMaskBand->RasterIO(
+                         GF_Read, 0, nYOff, nXSize, nLines,
+                         oStrip.abyMask.data(), nXSize, nLines, GDT_Byte, 0, 0,
+                         nullptr) != CE_None)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const auto LabelStrip = [&](int iStrip, Strip &oStrip)
+    {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        NearblackLabelStrip(oStrip.abyLines.data(), nXSize, nLines,
+                            iStrip == 0, iStrip == nStrips - 1, m_nSrcBands,
+                            m_nDstBands, m_psOptions->nNearDist, m_oColors,
+                            oStrip.oLabels);
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: label strips, and connect the components that       */
+    /*      touch the first or last line of their strip with the ones of    */
+    /*      the adjacent strips.                                            */
+    /* -------------------------------------------------------------------- */
+
+    // Union-find over the components that touch the first or last line of
+    // their strip. abTouchesBorder is only up-to-date for roots.
+    std::vector<int> anParent;
+    std::vector<bool> abTouchesBorder;
+    const auto Find = [&anParent](int n)
+    {
+        while (anParent[n] != n)
+        {
+            anParent[n] = anParent[anParent[n]];
+            n = anParent[n];
+        }
+        return n;
+    };
+
+    // For each strip, index in anParent of each of its components, or -1
+    std::vector<std::vector<int>> aanGlobalIds(nStrips);
+    // Index in anParent of each pixel of the last line of the previous strip
+    std::vector<int> anPrevLastLine;
+
+    const auto ConsumeLabels = [&](int iStrip, Strip &oStrip)
+    {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        const auto &oLabels = oStrip.oLabels;
+        auto &anGlobalIds = aanGlobalIds[iStrip];
+        try
+        {
+            anGlobalIds.resize(oLabels.abTouchesBorder.size(), -1);
+            const auto GetGlobalId = [&](int nLabel)
+            {
+                if (anGlobalIds[nLabel] < 0)
+                {
+                    anGlobalIds[nLabel] = static_cast<int>(anParent.size());
+                    anParent.push_back(anGlobalIds[nLabel]);
+                    abTouchesBorder.push_back(
+                        oLabels.abTouchesBorder[nLabel]);
+                }
+                return anGlobalIds[nLabel];
+            };
+
+            for (int iCol = 0; iCol < nXSize; iCol++)
+            {
+                const int nLabel = oLabels.anLabels[iCol];
+                if (nLabel < 0)
+                    continue;
+                const int nId = GetGlobalId(nLabel);
+                if (iStrip > 0 && anPrevLastLine[iCol] >= 0)
+                {
+                    const int nRoot1 = Find(anPrevLastLine[iCol]);
+                    const int nRoot2 = Find(nId);
+                    if (nRoot1 != nRoot2)
+                    {
+                        anParent[nRoot2] = nRoot1;
+                        if (abTouchesBorder[nRoot2])
+                            abTouchesBorder[nRoot1] = true;
+                    }
+                }
+            }
+
+            anPrevLastLine.resize(nXSize);
+            const int *panLastLine =
+                oLabels.anLabels.data() + static_cast<size_t>(nLines - 1) *
+                                              nXSize;
+            for (int iCol = 0; iCol < nXSize; iCol++)
+            {
+                anPrevLastLine[iCol] =
+                    panLastLine[iCol] >= 0 ? GetGlobalId(panLastLine[iCol])
+                                           : -1;
+            }
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate working buffers: %s", e.what());
+            return false;
+        }
+
+        return m_psOptions->pfnProgress(0.45 * (iStrip + 1) / nStrips,
+                                        nullptr,
+                                        m_psOptions->pProgressData) != FALSE;
+    };
+
+    if (!NearblackProcessStripsInOrder<Strip>(
+            poQueue, nStrips, nMaxInFlight,
+            [&ReadStrip](int iStrip, Strip &oStrip)
+            { return ReadStrip(iStrip, oStrip, false); },
+            LabelStrip, ConsumeLabels))
+    {
+        return false;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Resolve, for each component of each strip, whether it must be  */
+    /*      filled.                                                         */
+    /* -------------------------------------------------------------------- */
+    std::vector<std::vector<bool>> aabFill(nStrips);
+    for (int iStrip = 0; iStrip < nStrips; iStrip++)
+    {
+        const auto &anGlobalIds = aanGlobalIds[iStrip];
+        auto &abFill = aabFill[iStrip];
+        abFill.resize(anGlobalIds.size());
+        for (size_t i = 0; i < anGlobalIds.size(); i++)
+        {
+            if (anGlobalIds[i] >= 0)
+                abFill[i] = abTouchesBorder[Find(anGlobalIds[i])];
+        }
+        aanGlobalIds[iStrip].clear();
+    }
+    anParent.clear();
+    abTouchesBorder.clear();
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: label again strips, set the pixels of components  */
+    /*      to fill, and write the result.                                  */
+    /* -------------------------------------------------------------------- */
+    const auto FillStrip = [&](int iStrip, Strip &oStrip)
+    {
+        LabelStrip(iStrip, oStrip);
+        const auto &oLabels = oStrip.oLabels;
+        auto &abFill = aabFill[iStrip];
+        // Components that do not touch the first or last line of their strip
+        // have not been seen by the first pass.
+        for (size_t i = 0; i < abFill.size(); i++)
+        {
+            if (oLabels.abTouchesBorder[i])
+                abFill[i] = true;
+        }
+        for (size_t iIdx = 0; iIdx < oLabels.anLabels.size(); iIdx++)
+        {
+            const int nLabel = oLabels.anLabels[iIdx];
+            if (nLabel < 0 || !abFill[nLabel])
+                continue;
+            oStrip.bModified = true;
+            GByte *pabyPixel = oStrip.abyLines.data() + iIdx * m_nDstBands;
+            for (int iBand = 0; iBand < m_nSrcBands; iBand++)
+                pabyPixel[iBand] = m_nReplacevalue;
+
+            /***** alpha *****/
+            if (m_nDstBands > m_nSrcBands)
+                pabyPixel[m_nDstBands - 1] = 0;
+
+            if (m_bSetMask)
+                oStrip.abyMask[iIdx] = 0;
+        }
+        oStrip.oLabels = NearblackStripLabels();
+    };
+
+    const auto WriteStrip = [&](int iStrip, Strip &oStrip)
+    {
+        const int nYOff = iStrip * nLinesPerStrip;
+        const int nLines = std::min(nLinesPerStrip, nYSize - nYOff);
+        const bool bFirstWrite = m_psOptions->nMaxNonBlack == 0;
+        if (oStrip.bModified || (m_poDstDS != m_poSrcDataset && bFirstWrite))
+        {
+            if (m_poDstDS->RasterIO(GF_Write, 0, nYOff, nXSize, nLines,
+                                    oStrip.abyLines.data(), nXSize, nLines,
+                                    GDT_Byte, m_nDstBands, nullptr,
+                                    m_nDstBands,
+                                    static_cast<GSpacing>(nLineSize), 1,
+                                    nullptr) != CE_None)
+            {
+                return false;
+            }
+        }
+        if (m_bSetMask && (oStrip.bModified || bFirstWrite))
+        {
+            if (m_poMaskBand->RasterIO(GF_Write, 0, nYOff, nXSize, nLines,
+                                       oStrip.abyMask.data(), nXSize, nLines,
+                                       GDT_Byte, 0, 0, nullptr) != CE_None)
+            {
+                return false;
+            }
+        }
+        aabFill[iStrip] = std::vector<bool>();
+
+        return m_psOptions->pfnProgress(0.45 + 0.55 * (iStrip + 1) / nStrips,
+                                        nullptr,
+                                        m_psOptions->pProgressData) != FALSE;
+    };
+
+    return NearblackProcessStripsInOrder<Strip>(
+        poQueue, nStrips, nMaxInFlight,
+        [&ReadStrip](int iStrip, Strip &oStrip)
+        { return ReadStrip(iStrip, oStrip, true); },
+        FillStrip, WriteStrip);
+}
+
 /************************************************************************/
 /*              GDALNearblackFloodFillAlg::Process()                    */
 /************************************************************************/
@@ -446,6 +931,20 @@ bool GDALNearblackFloodFillAlg::Process()
     const int nXSize = m_poSrcDataset->GetRasterXSize();
     const int nYSize = m_poSrcDataset->GetRasterYSize();
 
+    // For debugging / testing purposes only
+    const char *pszTmpDriver =
+        CPLGetConfigOption("GDAL_TEMP_DRIVER_NAME", nullptr);
+
+    const int nThreads = GDALNearblackGetNumThreads();
+    if (nThreads > 1 && nYSize > 1 && !pszTmpDriver)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        auto poQueue =
+            poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+        if (poQueue)
+            return ProcessMultiThreaded(poQueue.get(), nThreads);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
@@ -478,9 +977,6 @@ bool GDALNearblackFloodFillAlg::Process()
     /*      Create a temporary dataset to save visited state                */
     /* -------------------------------------------------------------------- */
 
-    // For debugging / testing purposes only
-    const char *pszTmpDriver =
-        CPLGetConfigOption("GDAL_TEMP_DRIVER_NAME", nullptr);
     if (!pszTmpDriver)
     {
         pszTmpDriver =
@@ -607,3 +607,62 @@ cellsize     1
             elev_values.append((f["ELEV_MIN"], f["ELEV_MAX"]))
 
         assert elev_values == expected_elev_values, (elev_values, expected_elev_values)
+
+
+###############################################################################
+# Test that multi-threaded contouring gives the same result as single-threaded
+
+
+@pytest.mark.parametrize("polygonize", [False, True])
+@pytest.mark.parametrize("nodata", [None, 0])
+def test_contour_multithreaded(tmp_vsimem, polygonize, nodata):
+
+    src_filename = str(tmp_vsimem / "n43.tif")
+    src_ds = gdal.Translate(
+        src_filename,
+        "../gdrivers/data/n43.tif",
+        creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+    if nodata is not None:
+        src_ds.GetRasterBand(1).SetNoDataValue(nodata)
+    src_ds = None
+    src_ds = gdal.Open(src_filename)
+
+    def contour(num_threads):
+        ogr_ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+        lyr = ogr_ds.CreateLayer(
+            "contour", geom_type=ogr.wkbPolygon if polygonize else ogr.wkbLineString
+        )
+        lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("ELEV", ogr.OFTReal))
+        lyr.CreateField(ogr.FieldDefn("ELEV_MIN", ogr.OFTReal))
+        lyr.CreateField(ogr.FieldDefn("ELEV_MAX", ogr.OFTReal))
+        options = [
+            "LEVEL_INTERVAL=10",
+            "ID_FIELD=0",
+            f"POLYGONIZE={'YES' if polygonize else 'NO'}",
+            f"NUM_THREADS={num_threads}",
+        ]
+        if polygonize:
+            options += ["ELEV_FIELD_MIN=2", "ELEV_FIELD_MAX=3"]
+        else:
+            options += ["ELEV_FIELD=1"]
+        assert (
+            gdal.ContourGenerateEx(src_ds.GetRasterBand(1), lyr, options=options)
+            == gdal.CE_None
+        )
+        return [
+            (
+                f["ID"],
+                f["ELEV"],
+                f["ELEV_MIN"],
+                f["ELEV_MAX"],
+                f.GetGeometryRef().ExportToIsoWkt(),
+            )
+            for f in lyr
+        ]
+
+    ref = contour(1)
+    assert len(ref) > 0
+    assert contour(4) == ref
+    assert contour("ALL_CPUS") == ref
@@ -386,3 +386,60 @@ def test_fillnodata_nearest(
         for i in range(height)
     ]
     assert got == expected
+
+
+###############################################################################
+# Test that the tiled multithreaded implementation gives the same result as
+# the single-threaded one
+
+
+@pytest.mark.parametrize("interpolation", ["INV_DIST", "NEAREST"])
+@pytest.mark.parametrize("smoothing_iterations", [0, 2])
+@pytest.mark.parametrize("user_mask", [False, True])
+def test_fillnodata_multithreaded(interpolation, smoothing_iterations, user_mask):
+
+    width = 97
+    height = 83
+    values = []
+    for y in range(height):
+        for x in range(width):
+            if (x // 11 + y // 9) % 3 == 0 or (x * 7 + y * 13) % 17 == 0:
+                values.append(0)
+            else:
+                values.append(1 + (x * 3 + y * 5) % 250)
+    ar = struct.pack("f" * (width * height), *values)
+
+    def fill(options):
+        ds = gdal.GetDriverByName("MEM").Create(
+            "", width, height, 1, gdal.GDT_Float32
+        )
+        ds.GetRasterBand(1).WriteRaster(0, 0, width, height, ar)
+        mask_band = None
+        if user_mask:
+            mask_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+            mask_ds.GetRasterBand(1).WriteRaster(
+                0,
+                0,
+                width,
+                height,
+                struct.pack(
+                    "B" * (width * height), *[255 if v else 0 for v in values]
+                ),
+            )
+            mask_band = mask_ds.GetRasterBand(1)
+        else:
+            ds.GetRasterBand(1).SetNoDataValue(0)
+        gdal.FillNodata(
+            targetBand=ds.GetRasterBand(1),
+            maxSearchDist=6,
+            maskBand=mask_band,
+            smoothingIterations=smoothing_iterations,
+            options=["INTERPOLATION=" + interpolation, "TEMP_FILE_DRIVER=MEM"]
+            + options,
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    expected = fill([])
+    with gdal.config_option("GDAL_FILLNODATA_TILE_SIZE", "16"):
+        got = fill(["NUM_THREADS=4"])
+    assert got == expected
@@ -16,6 +16,7 @@
 import struct
 from collections import defaultdict
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -427,3 +428,64 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test that multi-threaded polygonization gives the same polygons as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("use_mask", [False, True])
+def test_polygonize_multithreaded(
+    tmp_vsimem, is_int_polygonize, connectedness, use_mask
+):
+
+    # Large enough to be split in several strips. The source must be opened
+    # in read-only mode to be eligible for the multi-threaded implementation.
+    filename = tmp_vsimem / "src.tif"
+    gdal.Translate(
+        filename,
+        "../gcore/data/byte.tif",
+        width=2048,
+        height=1100,
+        scaleParams=[[74, 255, 0, 7]],
+        noData=3 if use_mask else None,
+    )
+    src_ds = gdal.Open(filename)
+    src_band = src_ds.GetRasterBand(1)
+    mask_band = src_band.GetMaskBand() if use_mask else None
+
+    def polygonize(num_threads):
+        mem_ds = ogr.GetDriverByName("MEM").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        options = [f"NUM_THREADS={num_threads}"]
+        if connectedness == 8:
+            options.append("8CONNECTED=8")
+
+        debug_msgs = []
+
+        def handler(eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                debug_msgs.append(msg)
+
+        with gdaltest.error_handler(handler), gdal.config_option("CPL_DEBUG", "ON"):
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            if is_int_polygonize:
+                result = gdal.Polygonize(src_band, mask_band, mem_layer, 0, options)
+            else:
+                result = gdal.FPolygonize(src_band, mask_band, mem_layer, 0, options)
+        assert result == 0, "Polygonize failed"
+        assert any(
+            msg.startswith("GDAL: Polygonize: using ") for msg in debug_msgs
+        ) == (num_threads > 1)
+        return [(f["DN"], f.GetGeometryRef().ExportToIsoWkt()) for f in mem_layer]
+
+    ref = polygonize(1)
+    assert len(ref) > 1
+    res = polygonize(4)
+    assert sorted(res) == sorted(ref)
+    # The output order does not depend on the number of threads
+    assert polygonize(2) == res
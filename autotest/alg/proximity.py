@@ -11,6 +11,8 @@
 # SPDX-License-Identifier: MIT
 ###############################################################################
 
+import math
+import struct
 
 import pytest
 
@@ -109,3 +111,100 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test the multithreaded exact distance transform against a brute force
+# computation
+
+
+@pytest.mark.parametrize("chunk_lines", [None, "7"])
+def test_proximity_multithreaded_exact(chunk_lines):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 53, 41, 1, gdal.GDT_Int32)
+    src_band = src_ds.GetRasterBand(1)
+    src_band.SetNoDataValue(-1)
+    values = [0] * (53 * 41)
+    for x, y, v in [
+        (3, 2, 1),
+        (50, 5, 2),
+        (20, 20, 1),
+        (21, 20, 3),
+        (7, 38, 2),
+        (40, 33, 1),
+    ]:
+        values[y * 53 + x] = v
+    for x in range(10, 30):
+        values[30 * 53 + x] = -1
+    src_band.WriteRaster(0, 0, 53, 41, struct.pack("i" * len(values), *values))
+
+    targets = [(i % 53, i // 53) for i, v in enumerate(values) if v in (1, 2)]
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 53, 41, 1, gdal.GDT_Float32)
+    dst_band = dst_ds.GetRasterBand(1)
+
+    with gdal.config_option("GDAL_PROXIMITY_CHUNK_LINES", chunk_lines):
+        gdal.ComputeProximity(
+            src_band,
+            dst_band,
+            options=[
+                "VALUES=1,2",
+                "MAXDIST=25",
+                "NODATA=-2",
+                "USE_INPUT_NODATA=YES",
+                "ALGORITHM=EXACT",
+                "NUM_THREADS=3",
+            ],
+        )
+
+    got = struct.unpack("f" * len(values), dst_band.ReadRaster())
+    for i, v in enumerate(values):
+        x = i % 53
+        y = i // 53
+        dist = math.sqrt(min((x - tx) ** 2 + (y - ty) ** 2 for tx, ty in targets))
+        if v == -1 or dist > 25:
+            expected = -2
+        else:
+            expected = dist
+        assert got[i] == pytest.approx(expected, abs=1e-5), (x, y)
+
+
+###############################################################################
+# Test that the number of threads does not change the output
+
+
+@pytest.mark.parametrize("algorithm", [None, "PROPAGATION", "EXACT"])
+def test_proximity_num_threads(algorithm):
+
+    src_ds = gdal.Open("data/pat.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    def compute(options):
+        if algorithm:
+            options = options + [f"ALGORITHM={algorithm}"]
+        dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Float32)
+        dst_band = dst_ds.GetRasterBand(1)
+        assert gdal.ComputeProximity(src_band, dst_band, options=options) == 0
+        return dst_band.ReadRaster()
+
+    ref = compute(["NUM_THREADS=1"])
+    assert compute(["NUM_THREADS=4"]) == ref
+    # GDAL_NUM_THREADS must not change the output either
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert compute([]) == ref
+
+
+###############################################################################
+# Test an invalid ALGORITHM value
+
+
+def test_proximity_invalid_algorithm():
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 5, 5)
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 5, 5, 1, gdal.GDT_Float32)
+    with pytest.raises(Exception, match="Unrecognized ALGORITHM value"):
+        gdal.ComputeProximity(
+            src_ds.GetRasterBand(1),
+            dst_ds.GetRasterBand(1),
+            options=["ALGORITHM=INVALID"],
+        )
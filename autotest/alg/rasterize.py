@@ -1039,3 +1039,63 @@ def test_rasterize_bugfix_gh12129():
 
     # 121 on s390x
     assert target_ds.GetRasterBand(1).Checksum() in (120, 121)
+
+
+###############################################################################
+# Test that multithreaded rasterization gives the same result as the
+# single-threaded algorithm
+
+
+@pytest.mark.parametrize("options", [[], ["-at"], ["-add"], ["-add", "-at"]])
+def test_rasterize_multithreaded(tmp_vsimem, options):
+
+    src_ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    lyr = src_ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    wkts = []
+    for i in range(60):
+        x = (i * 37) % 2100
+        y = (i * 53) % 1100
+        wkts.append(
+            "POLYGON((%d %d,%d %d,%d %d,%d %d))"
+            % (x, y, x + 300, y + 17, x + 150, y + 250, x, y)
+        )
+        wkts.append("LINESTRING(%d %d,%d %d)" % (x, y + 5, 2100 - x, 1100 - y))
+        wkts.append("POINT(%.1f %.1f)" % (x + 0.5, y + 0.5))
+    for i, wkt in enumerate(wkts):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["val"] = 1 + i % 7
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+
+    def rasterize(filename, extra_options):
+        gdal.Rasterize(
+            filename,
+            src_ds,
+            options=[
+                "-a",
+                "val",
+                "-te",
+                "0",
+                "0",
+                "2100",
+                "1100",
+                "-ts",
+                "2100",
+                "1100",
+                "-ot",
+                "Float32",
+                "-of",
+                "GTiff",
+                "-co",
+                "TILED=YES",
+            ]
+            + options
+            + extra_options,
+        )
+        with gdal.Open(filename) as ds:
+            return ds.GetRasterBand(1).ReadRaster()
+
+    expected = rasterize(tmp_vsimem / "st.tif", [])
+    got = rasterize(tmp_vsimem / "mt.tif", ["-j", "4"])
+    assert got == expected
@@ -13,6 +13,8 @@
 ###############################################################################
 
 
+import struct
+
 import gdaltest
 import pytest
 
@@ -341,3 +343,45 @@ def test_sieve_all_masked():
     gdal.SieveFilter(src_band, mask_band, src_band, 4, 4)
 
     assert src_band.Checksum() == expected_cs
+
+
+###############################################################################
+# Test that the tiled multithreaded implementation gives the same result as
+# the single-threaded one
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("use_mask", [False, True])
+def test_sieve_multithreaded(connectedness, use_mask):
+
+    width = 61
+    height = 47
+    values = []
+    for y in range(height):
+        for x in range(width):
+            values.append(((x // 3) * 7 + (y // 2) * 3 + (x * y) % 5 // 4) % 4)
+    ar = struct.pack("B" * (width * height), *values)
+
+    drv = gdal.GetDriverByName("MEM")
+    mask_ds = drv.Create("", width, height)
+    mask_ds.GetRasterBand(1).Fill(255)
+    mask_ds.GetRasterBand(1).WriteRaster(10, 5, 20, 3, b"\x00" * 60)
+
+    def sieve(options):
+        ds = drv.Create("", width, height)
+        ds.GetRasterBand(1).WriteRaster(0, 0, width, height, ar)
+        gdal.SieveFilter(
+            ds.GetRasterBand(1),
+            mask_ds.GetRasterBand(1) if use_mask else None,
+            ds.GetRasterBand(1),
+            6,
+            connectedness,
+            options=options,
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    expected = sieve([])
+    assert expected != ar
+    for tile_size in ("5", "16"):
+        with gdal.config_option("GDAL_SIEVE_TILE_SIZE", tile_size):
+            assert sieve(["NUM_THREADS=4"]) == expected
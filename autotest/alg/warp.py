@@ -2010,6 +2010,116 @@ def test_warp_nodata_substitution(dt, expected_val, resampling):
     )
 
 
+###############################################################################
+# Test that the AVX2 code paths of the general case give the same results as
+# the generic code
+
+
+@pytest.mark.parametrize(
+    "dt,fmt",
+    [(gdal.GDT_Byte, "B"), (gdal.GDT_UInt16, "H"), (gdal.GDT_Float32, "f")],
+)
+@pytest.mark.parametrize("resampling", ["bilinear", "cubic", "cubicspline", "lanczos"])
+@pytest.mark.parametrize("size", [33, 100])
+def test_warp_general_case_avx2_vs_generic(dt, fmt, resampling, size):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 100, 100, 1, dt)
+    src_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    # Pseudo-random content, with about 5% of nodata
+    values = [
+        0 if (i * 7919) % 20 == 0 else 1 + (i * 104729) % 250
+        for i in range(100 * 100)
+    ]
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, 100, 100, struct.pack("%d%s" % (len(values), fmt), *values)
+    )
+
+    def warp():
+        out_ds = gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            width=size,
+            height=size,
+            outputBounds=[0.3, -99.7, 99.7, -0.3],
+            resampleAlg=resampling,
+        )
+        return struct.unpack(
+            "%dd" % (size * size),
+            out_ds.GetRasterBand(1).ReadRaster(buf_type=gdal.GDT_Float64),
+        )
+
+    with gdal.config_option("GDAL_USE_AVX2", "NO"):
+        ref = warp()
+    got = warp()
+
+    if resampling == "lanczos":
+        # Rows are accumulated separately, so rounding may slightly differ
+        tolerance = 1 if dt != gdal.GDT_Float32 else 1e-6
+        assert max(abs(a - b) for a, b in zip(ref, got)) <= tolerance
+    else:
+        assert ref == got
+
+
+###############################################################################
+# Test GDAL_WARP_TRANSFORM_CACHE_MAX
+
+
+def test_warp_transform_cache():
+    def create_src_ds(val):
+        src_ds = gdal.GetDriverByName("MEM").Create("", 50, 40)
+        src_ds.SetGeoTransform([2.123, 0.01, 0, 49.456, 0, -0.01])
+        src_ds.SetSpatialRef(osr.SpatialReference(epsg=4326))
+        src_ds.GetRasterBand(1).Fill(val)
+        src_ds.GetRasterBand(1).WriteRaster(10, 10, 1, 1, b"\xff")
+        return src_ds
+
+    def warp(src_ds):
+        debug_msgs = []
+
+        def handler(eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                debug_msgs.append(msg)
+
+        with gdaltest.error_handler(handler), gdal.config_option("CPL_DEBUG", "WARP"):
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            out_ds = gdal.Warp(
+                "",
+                src_ds,
+                format="MEM",
+                dstSRS="EPSG:3857",
+                width=45,
+                height=55,
+                resampleAlg="bilinear",
+            )
+        # Sum the statistics of all warp operations
+        reused = 0
+        computed = 0
+        for msg in debug_msgs:
+            if msg.startswith("WARP: Transform cache: "):
+                tokens = msg.split(" ")
+                reused += int(tokens[3])
+                computed += int(tokens[6])
+        return out_ds.GetRasterBand(1).ReadRaster(), reused, computed
+
+    ref1, reused, computed = warp(create_src_ds(1))
+    assert (reused, computed) == (0, 0)
+    ref2, _, _ = warp(create_src_ds(2))
+
+    with gdal.config_option("GDAL_WARP_TRANSFORM_CACHE_MAX", "1"):
+        got1, reused, computed = warp(create_src_ds(1))
+        assert got1 == ref1
+        assert reused == 0
+        assert computed >= 55
+
+        # Same georeferencing: coordinates are reused
+        got2, reused, computed = warp(create_src_ds(2))
+        assert got2 == ref2
+        assert reused >= 55
+        assert computed == 0
+
+
 ###############################################################################
 # Test propagation of errors from I/O threads to main thread in multi-threaded reading
 
@@ -1936,6 +1936,55 @@ def test_cog_mask_band_overviews(tmp_vsimem):
     assert ds.GetRasterBand(1).GetOverview(1).IsMaskBand()
 
 
+###############################################################################
+# Test that temporary files are kept in memory when they fit
+
+
+@pytest.mark.parametrize(
+    "tmp_max_memory,expect_tmp_files",
+    [(None, True), ("100MB", False), ("0", True), ("invalid", True)],
+)
+def test_cog_tmp_files_in_memory(tmp_path, tmp_max_memory, expect_tmp_files):
+
+    filename = str(tmp_path / "out.tif")
+    src_ds = gdal.Translate(
+        "",
+        "data/stefan_full_rgba.tif",
+        options="-of MEM -b 1 -b 2 -b 3 -mask 4 -a_srs EPSG:4326 -a_ullr 2 49 3 48",
+    )
+
+    found_tmp_files = set()
+
+    def my_progress(pct, msg, user_data):
+        found_tmp_files.update(f for f in os.listdir(tmp_path) if f.endswith(".tmp"))
+        return 1
+
+    def create():
+        gdal.GetDriverByName("COG").CreateCopy(
+            filename,
+            src_ds,
+            options=["TARGET_SRS=EPSG:3857", "BLOCKSIZE=64"],
+            callback=my_progress,
+        )
+
+    with gdal.config_option("COG_TMP_MAX_MEMORY", tmp_max_memory):
+        if tmp_max_memory == "invalid":
+            with gdaltest.error_raised(gdal.CE_Warning, "COG_TMP_MAX_MEMORY"):
+                create()
+        else:
+            create()
+
+    if expect_tmp_files:
+        assert "out.tif.warped.tif.tmp" in found_tmp_files
+        assert "out.tif.ovr.tmp" in found_tmp_files
+    else:
+        assert not found_tmp_files
+    assert os.listdir(tmp_path) == ["out.tif"]
+
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).GetOverviewCount() > 0
+
+
 ###############################################################################
 # Verify that we can generate an output that is byte-identical to the expected golden file.
 
@@ -981,3 +981,97 @@ def test_stats_uint64():
         1 << 50,
         0,
     ]
+
+
+###############################################################################
+# Test that multithreaded statistics and min/max (GDAL_NUM_THREADS) match the
+# single-threaded ones
+
+
+@pytest.mark.require_driver("GTiff")
+@pytest.mark.parametrize(
+    "datatype,nodata,with_mask",
+    [
+        (gdal.GDT_Byte, None, False),
+        (gdal.GDT_Byte, 0, False),
+        (gdal.GDT_UInt16, None, False),
+        (gdal.GDT_Int16, None, False),
+        (gdal.GDT_Float32, None, False),
+        (gdal.GDT_Float32, 0, False),
+        (gdal.GDT_Float32, None, True),
+    ],
+)
+def test_stats_multithreaded(tmp_vsimem, datatype, nodata, with_mask):
+
+    filename = str(tmp_vsimem / "test_stats_multithreaded.tif")
+    with gdal.GetDriverByName("GTiff").Create(
+        filename,
+        1000,
+        900,
+        1,
+        datatype,
+        options=["TILED=YES", "BLOCKXSIZE=64", "BLOCKYSIZE=64"],
+    ) as ds:
+        ds.GetRasterBand(1).Fill(1)
+        ds.GetRasterBand(1).WriteRaster(
+            10,
+            20,
+            500,
+            700,
+            bytes(i % 251 for i in range(500 * 700)),
+            buf_type=gdal.GDT_Byte,
+        )
+        if nodata is not None:
+            ds.GetRasterBand(1).SetNoDataValue(nodata)
+        if with_mask:
+            ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+            ds.GetRasterBand(1).GetMaskBand().Fill(255)
+            ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+                600, 100, 200, 300, b"\x00" * (200 * 300)
+            )
+
+    def run_and_check_threaded(func, num_threads):
+        # Check through the debug messages that the multithreaded code path
+        # is used if and only if several threads are requested.
+        debug_msgs = []
+
+        def handler(eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                debug_msgs.append(msg)
+
+        with gdaltest.error_handler(handler), gdal.config_option("CPL_DEBUG", "ON"):
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            ret = func()
+        threaded = any(
+            msg.startswith("GDAL: Processing ") and msg.endswith(" threads")
+            for msg in debug_msgs
+        )
+        assert threaded == (num_threads != "1"), debug_msgs
+        return ret
+
+    def compute(num_threads, approx):
+        with gdal.config_options(
+            {"GDAL_NUM_THREADS": num_threads, "GDAL_PAM_ENABLED": "NO"}
+        ):
+            with gdal.Open(filename) as ds:
+                band = ds.GetRasterBand(1)
+                minmax = run_and_check_threaded(
+                    lambda: band.ComputeRasterMinMax(approx), num_threads
+                )
+                stats = run_and_check_threaded(
+                    lambda: band.ComputeStatistics(approx), num_threads
+                )
+                valid_percent = band.GetMetadataItem("STATISTICS_VALID_PERCENT")
+                return minmax, stats, valid_percent
+
+    for approx in (False, True):
+        ref_minmax, ref_stats, ref_valid_percent = compute("1", approx)
+        minmax, stats, valid_percent = compute("4", approx)
+        assert minmax == ref_minmax
+        assert stats[0] == ref_stats[0]
+        assert stats[1] == ref_stats[1]
+        assert stats[2] == pytest.approx(ref_stats[2], rel=1e-12)
+        assert stats[3] == pytest.approx(ref_stats[3], rel=1e-12)
+        assert valid_percent == ref_valid_percent
+        # Results must not depend on the number of threads
+        assert compute("3", approx) == compute("8", approx)
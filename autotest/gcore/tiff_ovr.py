@@ -2414,6 +2414,46 @@ def test_tiff_ovr_multithreading_singleband():
     gdal.Unlink("/vsimem/test.tif")
 
 
+###############################################################################
+# Test that the multithreaded GDALRegenerateOverviews() path, which splits
+# the resampling of each source chunk over several jobs, gives the same
+# result as the single-threaded one
+
+
+@pytest.mark.parametrize(
+    "resampling", ["NEAREST", "AVERAGE", "GAUSS", "MODE", "CUBIC", "LANCZOS"]
+)
+def test_tiff_ovr_multithreading_singleband_chunk_split(tmp_vsimem, resampling):
+
+    src_ds = gdal.Translate(
+        "",
+        "data/stefan_full_rgba.tif",
+        format="MEM",
+        width=2048,
+        height=2048,
+        resampleAlg=gdal.GRIORA_Bilinear,
+    )
+
+    checksums = []
+    for num_threads in ("1", "4"):
+        filename = str(tmp_vsimem / f"test_{num_threads}.tif")
+        ds = gdal.GetDriverByName("GTiff").CreateCopy(
+            filename, src_ds, options=["INTERLEAVE=BAND"]
+        )
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds.BuildOverviews(resampling, [3, 9])
+        checksums.append(
+            [
+                ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+                for i in range(4)
+                for j in range(2)
+            ]
+        )
+        ds = None
+
+    assert checksums[0] == checksums[1]
+
+
 ###############################################################################
 
 
@@ -11,6 +11,7 @@
 # SPDX-License-Identifier: MIT
 ###############################################################################
 
+import os
 import sys
 import time
 
@@ -1578,6 +1579,95 @@ def test_vsicurl_cache_control_no_cache(server):
         assert data == "barbaz"
 
 
+###############################################################################
+# Test the persistent disk cache
+
+
+@gdaltest.enable_exceptions()
+def test_vsicurl_disk_cache(server, tmp_path):
+
+    gdal.VSICurlClearCache()
+
+    url = "/vsicurl/http://localhost:%d/test_vsicurl_disk_cache.txt" % server.port
+    cache_dir = tmp_path / "cache"
+
+    def read(handler):
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL(url, "rb")
+            assert f is not None
+            try:
+                return gdal.VSIFReadL(1, 6, f).decode("ascii")
+            finally:
+                gdal.VSIFCloseL(f)
+
+    with gdal.config_option("CPL_VSIL_CURL_DISK_CACHE_DIR", str(cache_dir)):
+        handler = webserver.SequentialHandler()
+        handler.add("GET", "/", 404)
+        handler.add(
+            "HEAD",
+            "/test_vsicurl_disk_cache.txt",
+            200,
+            {"Content-Length": "6", "ETag": '"etag1"'},
+        )
+        handler.add("GET", "/test_vsicurl_disk_cache.txt", 200, {}, "foobar")
+        assert read(handler) == "foobar"
+
+        chunks = [x for x in os.listdir(cache_dir) if x.endswith(".chunk")]
+        assert len(chunks) == 1
+        # The URL, which might contain credentials, must not be stored
+        with open(cache_dir / chunks[0], "rb") as f:
+            assert b"test_vsicurl_disk_cache" not in f.read()
+        if sys.platform != "win32":
+            assert os.stat(cache_dir).st_mode & 0o777 == 0o700
+            assert os.stat(cache_dir / chunks[0]).st_mode & 0o777 == 0o600
+
+        # Same ETag: content is read from the disk cache, even after the
+        # in-memory cache has been cleared.
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add("GET", "/", 404)
+        handler.add(
+            "HEAD",
+            "/test_vsicurl_disk_cache.txt",
+            200,
+            {"Content-Length": "6", "ETag": '"etag1"'},
+        )
+        assert read(handler) == "foobar"
+
+        # Different ETag: content must be downloaded again
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add("GET", "/", 404)
+        handler.add(
+            "HEAD",
+            "/test_vsicurl_disk_cache.txt",
+            200,
+            {"Content-Length": "6", "ETag": '"etag2"'},
+        )
+        handler.add("GET", "/test_vsicurl_disk_cache.txt", 200, {}, "bazbaz")
+        assert read(handler) == "bazbaz"
+
+        assert len([x for x in os.listdir(cache_dir) if x.endswith(".chunk")]) == 2
+
+        # Least recently used chunks are evicted when the cache is full
+        gdal.VSICurlClearCache()
+        with gdal.config_option("CPL_VSIL_CURL_DISK_CACHE_SIZE", "100"):
+            handler = webserver.SequentialHandler()
+            handler.add("GET", "/", 404)
+            handler.add(
+                "HEAD",
+                "/test_vsicurl_disk_cache.txt",
+                200,
+                {"Content-Length": "6", "ETag": '"etag3"'},
+            )
+            handler.add("GET", "/test_vsicurl_disk_cache.txt", 200, {}, "bazbar")
+            assert read(handler) == "bazbar"
+
+        assert len([x for x in os.listdir(cache_dir) if x.endswith(".chunk")]) < 3
+
+    gdal.VSICurlClearCache()
+
+
 ###############################################################################
 # Test VSICURL_QUERY_STRING path specific option.
 
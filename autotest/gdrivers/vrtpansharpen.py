@@ -2440,3 +2440,92 @@ def test_vrtpansharpen_slightly_different_extent(tmp_vsimem):
         for i in range(vrt_ds.RasterCount)
     ]
     assert mm == [(20.0, 20.0), (40.0, 40.0)]
+
+
+###############################################################################
+# Test weighted Brovey with output bands not in the order of the spectral
+# bands, for the data types that have vectorized code paths, and with the
+# panchromatic band read in a worker thread
+
+
+@pytest.mark.parametrize(
+    "src_type,buf_type",
+    [
+        (gdal.GDT_UInt16, gdal.GDT_UInt16),
+        (gdal.GDT_UInt16, gdal.GDT_Float32),
+        (gdal.GDT_Float32, gdal.GDT_Float32),
+    ],
+)
+@pytest.mark.parametrize("num_threads", [1, 2])
+def test_vrtpansharpen_weighted_brovey_out_of_order_bands(
+    tmp_vsimem, src_type, buf_type, num_threads
+):
+
+    gdaltest.importorskip_gdal_array()
+    numpy = pytest.importorskip("numpy")
+
+    ms = (numpy.arange(3 * 5 * 11).reshape(3, 5, 11) * 397) % 4000
+    ms[:, 0, 0] = 0
+    pan = (numpy.arange(10 * 22).reshape(10, 22) * 53) % 4095
+    if src_type == gdal.GDT_Float32:
+        ms = ms / 7.0
+        pan = pan / 3.0
+
+    ms_filename = str(tmp_vsimem / "ms.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(ms_filename, 11, 5, 3, src_type)
+    ds.SetGeoTransform([0, 2, 0, 0, 0, -2])
+    for i in range(3):
+        ds.GetRasterBand(i + 1).WriteArray(ms[i])
+    ds = None
+    pan_filename = str(tmp_vsimem / "pan.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(pan_filename, 22, 10, 1, src_type)
+    ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    ds.GetRasterBand(1).WriteArray(pan)
+    ds = None
+
+    vrt_ds = gdal.Open(
+        f"""<VRTDataset subClass="VRTPansharpenedDataset">
+        <PansharpeningOptions>
+            <NumThreads>{num_threads}</NumThreads>
+            <Resampling>Nearest</Resampling>
+            <AlgorithmOptions><Weights>0.2,0.5,0.3</Weights></AlgorithmOptions>
+            <PanchroBand>
+                    <SourceFilename>{pan_filename}</SourceFilename>
+                    <SourceBand>1</SourceBand>
+            </PanchroBand>
+            <SpectralBand dstBand="2">
+                    <SourceFilename>{ms_filename}</SourceFilename>
+                    <SourceBand>1</SourceBand>
+            </SpectralBand>
+            <SpectralBand>
+                    <SourceFilename>{ms_filename}</SourceFilename>
+                    <SourceBand>2</SourceBand>
+            </SpectralBand>
+            <SpectralBand dstBand="1">
+                    <SourceFilename>{ms_filename}</SourceFilename>
+                    <SourceBand>3</SourceBand>
+            </SpectralBand>
+        </PansharpeningOptions>
+    </VRTDataset>"""
+    )
+
+    if src_type == gdal.GDT_Float32:
+        ms = ms.astype(numpy.float32).astype(numpy.float64)
+        pan = pan.astype(numpy.float32).astype(numpy.float64)
+    ms_up = ms.repeat(2, axis=1).repeat(2, axis=2)
+    pseudo_panchro = 0.2 * ms_up[0] + 0.5 * ms_up[1] + 0.3 * ms_up[2]
+    with numpy.errstate(divide="ignore", invalid="ignore"):
+        factor = numpy.where(pseudo_panchro != 0, pan / pseudo_panchro, 0)
+
+    # Odd width, so that not all values are processed by vectorized code
+    xoff = 1
+    xsize = 21
+    for dst_band, src_band in ((1, 2), (2, 0)):
+        expected = ms_up[src_band] * factor
+        if src_type == gdal.GDT_UInt16:
+            expected = numpy.floor(numpy.clip(expected + 0.5, 0, 65535))
+        expected = expected[:, xoff : xoff + xsize]
+        got = vrt_ds.GetRasterBand(dst_band).ReadAsArray(
+            xoff, 0, xsize, 10, buf_type=buf_type
+        )
+        numpy.testing.assert_array_equal(got, expected.astype(got.dtype))
@@ -3567,6 +3567,92 @@ def test_ogr_csv_do_not_write_header(tmp_vsimem):
         assert lyr.GetFeatureCount() == 10
 
 
+###############################################################################
+# Test that the parallel implementation of GetNextArrowArray() returns the
+# same result as the generic one
+
+
+@pytest.mark.parametrize("unbalanced_quote_at_end", [False, True])
+def test_ogr_csv_arrow_stream_numpy_multi_threading(
+    tmp_vsimem, unbalanced_quote_at_end
+):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    filename = tmp_vsimem / "test.csv"
+    content = "id,real,str,dt,WKT\r\n"
+    for i in range(100):
+        if i % 10 == 0:
+            content += "\n"
+        if i % 7 == 0:
+            content += f'{i},{i}.5,"multi\r\nline, ""{i}""",,"POINT ({i} {i})"\r\n'
+        else:
+            content += f"{i},,str{i},2025/01/02 03:04:{i % 60:02d},\n"
+    if unbalanced_quote_at_end:
+        content += '100,1.5,"unterminated\n'
+    gdal.FileFromMemBuffer(filename, content)
+    gdal.FileFromMemBuffer(tmp_vsimem / "test.csvt", "Integer,Real,String,DateTime,WKT")
+
+    def check_capability(lyr, num_threads):
+        assert lyr.TestCapability(ogr.OLCFastGetArrowStream) == (num_threads > 1)
+
+    with gdal.quiet_errors():
+        (batches,) = ogrtest.check_arrow_stream_multi_threading(
+            filename,
+            "OGR_CSV_NUM_THREADS",
+            ["MAX_FEATURES_IN_BATCH=3"],
+            layer_callback=check_capability,
+        )
+    assert sum(len(batch["OGC_FID"]) for batch in batches) == 100
+
+
+###############################################################################
+# Test that the parallel implementation of GetNextArrowArray() assigns the
+# same FIDs as GetNextFeature() when there are empty lines
+
+
+@pytest.mark.parametrize("merge_separator", ["NO", "YES"])
+def test_ogr_csv_arrow_stream_numpy_multi_threading_empty_lines(
+    tmp_vsimem, merge_separator
+):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    filename = tmp_vsimem / "test.csv"
+    content = "id,str\n"
+    for i in range(100):
+        if i % 3 == 0:
+            content += "\n"
+        if i % 5 == 0:
+            content += "\r\n\r\n"
+        if i % 11 == 0:
+            # Line with just a UTF-8 BOM
+            content += "\ufeff\n"
+        content += f"{i},,str{i}\n"
+    gdal.FileFromMemBuffer(filename, content)
+    open_options = ["MERGE_SEPARATOR=" + merge_separator]
+
+    with gdal.OpenEx(filename, open_options=open_options) as ds:
+        expected = [(f.GetFID(), f["id"]) for f in ds.GetLayer(0)]
+    assert len(expected) == 100
+
+    def get_fids_and_ids(num_threads):
+        with gdaltest.config_option("OGR_CSV_NUM_THREADS", str(num_threads)):
+            with gdal.OpenEx(filename, open_options=open_options) as ds:
+                lyr = ds.GetLayer(0)
+                stream = lyr.GetArrowStreamAsNumPy(
+                    options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=3"]
+                )
+                return [
+                    (fid, val.decode("utf-8"))
+                    for batch in stream
+                    for fid, val in zip(batch["OGC_FID"].tolist(), batch["id"])
+                ]
+
+    assert get_fids_and_ids(1) == expected
+    assert get_fids_and_ids(4) == expected
+
+
 ###############################################################################
 
 
@@ -1150,6 +1150,99 @@ def test_ogr_flatgeobuf_arrow_stream_numpy(layer_creation_options):
     ogr.GetDriverByName("FlatGeobuf").DeleteDataSource("/vsimem/test.fgb")
 
 
+###############################################################################
+# Test that the vectorized evaluation of attribute filters on Arrow batches
+# gives the same result as the per-feature one
+
+
+@pytest.mark.parametrize(
+    "where",
+    [
+        "int32 = 3",
+        "int32 <> 3",
+        "int32 >= 3 AND int32 < 7",
+        "int32 > 2.5",
+        "3 < int32",
+        "int32 IN (1, 4, 6)",
+        "int32 IN (1.5, 4.0)",
+        "int32 BETWEEN 2 AND 5",
+        "int32 IS NULL",
+        "int32 IS NOT NULL",
+        "NOT (int32 = 3)",
+        "int32 = 3 OR int64 = 5",
+        "NOT (int32 = 3 OR int64 = 5)",
+        "NOT (int32 = 3 AND int64 = 5)",
+        "int64 > int32",
+        "float64 < 4.5",
+        "float32 BETWEEN 1.5 AND 3.5",
+        "bool",
+        "NOT bool",
+        "bool = 0",
+        "str = 'VAL3'",
+        "str <> 'val3'",
+        "str > 'val5'",
+        "str IN ('val1', 'VAL2', 'foo')",
+        "str BETWEEN 'val2' AND 'val4'",
+        "str IS NULL",
+        "str LIKE 'val%'",
+        "int32 + 1 = 4",
+    ],
+)
+def test_ogr_flatgeobuf_arrow_stream_vectorized_attribute_filter(tmp_vsimem, where):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    filename = str(tmp_vsimem / "test.fgb")
+    ds = ogr.GetDriverByName("FlatGeoBuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    field = ogr.FieldDefn("bool", ogr.OFTInteger)
+    field.SetSubType(ogr.OFSTBoolean)
+    lyr.CreateField(field)
+    lyr.CreateField(ogr.FieldDefn("int32", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    field = ogr.FieldDefn("float32", ogr.OFTReal)
+    field.SetSubType(ogr.OFSTFloat32)
+    lyr.CreateField(field)
+    lyr.CreateField(ogr.FieldDefn("float64", ogr.OFTReal))
+    for i in range(10):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i != 7:
+            f["str"] = "val%d" % i
+            f["bool"] = i % 2
+            f["int32"] = i
+            f["int64"] = 10 - i
+            f["float32"] = i * 0.5
+            f["float64"] = i * 1.5
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i, i)))
+        lyr.CreateFeature(f)
+    ds = None
+
+    def get_fids(vectorized):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        lyr.SetAttributeFilter(where)
+        with gdal.config_option(
+            "OGR_ARROW_VECTORIZED_ATTRIBUTE_FILTER", "YES" if vectorized else "NO"
+        ):
+            stream = lyr.GetArrowStreamAsNumPy(
+                options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=4"]
+            )
+            fids = []
+            for batch in stream:
+                fids += list(batch["OGC_FID"])
+        return fids
+
+    expected = []
+    with ogr.Open(filename) as ds:
+        lyr = ds.GetLayer(0)
+        lyr.SetAttributeFilter(where)
+        expected = [f.GetFID() for f in lyr]
+
+    assert get_fids(False) == expected
+    assert get_fids(True) == expected
+
+
 ###############################################################################
 # Test reading an empty file with GetArrowStream()
 
@@ -1650,3 +1743,106 @@ def test_ogr_flatgeobuf_write_empty_file_no_spatial_index(tmp_vsimem):
         assert lyr.GetFeatureCount() == 0
         assert lyr.GetExtent(can_return_null=True) is None
         assert lyr.GetSpatialRef().GetAuthorityCode(None) == "32631"
+
+
+###############################################################################
+# Test multi-threaded GetArrowStream(), with and without a spatial filter
+# going through the packed R-tree
+
+
+@pytest.mark.parametrize("spatial_index", ["YES", "NO"])
+@pytest.mark.parametrize("with_spatial_filter", [False, True])
+def test_ogr_flatgeobuf_arrow_stream_numpy_multi_threading(
+    tmp_vsimem, spatial_index, with_spatial_filter
+):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    filename = str(tmp_vsimem / "test.fgb")
+    with ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename) as ds:
+        lyr = ds.CreateLayer(
+            "test", geom_type=ogr.wkbUnknown, options=["SPATIAL_INDEX=" + spatial_index]
+        )
+        lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+        lyr.CreateField(ogr.FieldDefn("dt", ogr.OFTDateTime))
+        for i in range(1000):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            if i % 7 != 0:
+                f["int"] = i
+                f["str"] = "foo%d" % i
+                f["dt"] = "2025/01/02 03:04:%02d" % (i % 60)
+            if i % 3 == 0:
+                wkt = "POINT (%d %d)" % (i, i)
+            elif i % 3 == 1:
+                wkt = "LINESTRING (%d %d,%d %d)" % (i, i, i + 1, i + 1)
+            else:
+                wkt = "CIRCULARSTRING (%d %d,%d %d,%d %d)" % (
+                    i,
+                    i,
+                    i + 1,
+                    i + 1,
+                    i + 2,
+                    i,
+                )
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+            lyr.CreateFeature(f)
+
+    def set_spatial_filter(lyr, num_threads):
+        if with_spatial_filter:
+            lyr.SetSpatialFilterRect(100.5, 100.5, 800.5, 800.5)
+
+    (batches,) = ogrtest.check_arrow_stream_multi_threading(
+        filename,
+        "OGR_FLATGEOBUF_NUM_THREADS",
+        ["MAX_FEATURES_IN_BATCH=37"],
+        layer_callback=set_spatial_filter,
+    )
+    count = sum(len(batch["OGC_FID"]) for batch in batches)
+    if with_spatial_filter:
+        assert 0 < count < 1000
+    else:
+        assert count == 1000
+
+
+###############################################################################
+# Test native WriteArrowBatch() implementation against the generic one
+
+
+@pytest.mark.parametrize("base_impl", ["YES", "NO"])
+@pytest.mark.parametrize("spatial_index", ["YES", "NO"])
+def test_ogr_flatgeobuf_write_arrow_native(tmp_vsimem, base_impl, spatial_index):
+
+    wkts = [
+        "POINT (1 2)",
+        "POINT Z (1 2 3)",
+        "LINESTRING (1 2,3 4)",
+        "LINESTRING ZM (1 2 3 4,5 6 7 8)",
+        "POLYGON ((0 0,0 1,1 1,0 0))",
+        "POLYGON ((0 0,0 10,10 10,0 0),(1 1,1 2,2 2,1 1))",
+        "MULTIPOINT ((1 2),(3 4))",
+        "MULTILINESTRING ((1 2,3 4),(5 6,7 8))",
+        "MULTIPOLYGON (((0 0,0 1,1 1,0 0)),((10 10,10 11,11 11,10 10)))",
+        "CIRCULARSTRING (0 0,1 1,2 0)",
+        "GEOMETRYCOLLECTION (POINT (1 2))",
+    ]
+    if spatial_index == "NO":
+        wkts += ["POINT EMPTY", "MULTIPOLYGON EMPTY", None]
+    src_ds, src_lyr = ogrtest.create_arrow_write_source_layer(wkts)
+
+    filename = str(tmp_vsimem / "test_ogr_flatgeobuf_write_arrow_native.fgb")
+    ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer(
+        "test", geom_type=ogr.wkbUnknown, options=["SPATIAL_INDEX=" + spatial_index]
+    )
+    assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch)
+
+    with gdal.config_option("OGR_FLATGEOBUF_WRITE_ARROW_BATCH_BASE_IMPL", base_impl):
+        ogrtest.write_arrow_batches(src_lyr, lyr)
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    # Features are reordered when there is a spatial index, and empty
+    # geometries are written as null ones
+    ogrtest.check_arrow_written_layer(lyr, src_lyr, empty_geom_as_null=True)
@@ -5947,3 +5947,80 @@ def test_ogr_geojson_sqlite_dialect_id_property():
             f = sql_lyr.GetNextFeature()
             assert f["id"] == 5
             assert f["foo"] == "bar"
+
+
+###############################################################################
+# Test that the native implementation of GetNextArrowArray() returns the
+# same result as the generic one
+
+
+@pytest.mark.parametrize("variant", ["int_id", "string_id", "fallback"])
+def test_ogr_geojson_arrow_stream_numpy_native(tmp_vsimem, variant):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    geometries = [
+        {"type": "Point", "coordinates": [1, 2]},
+        {"type": "Point", "coordinates": [1.5, 2.5, 3.5]},
+        {"type": "LineString", "coordinates": [[1, 2], [3, 4, 5]]},
+        {"type": "Polygon", "coordinates": [[[0, 0], [0, 1], [1, 1], [0, 0]]]},
+        {"type": "MultiPoint", "coordinates": [[1, 2], [3, 4]]},
+        {"type": "MultiLineString", "coordinates": [[[1, 2], [3, 4]], []]},
+        {
+            "type": "MultiPolygon",
+            "coordinates": [[[[0, 0], [0, 1], [1, 1], [0, 0]]], []],
+        },
+        None,
+    ]
+    features = []
+    for i in range(50):
+        feature = {
+            "type": "Feature",
+            "properties": {
+                "int": i if i % 5 else None,
+                "int64": 1234567890123 * i,
+                "real": i + 0.5,
+                "bool": i % 2 == 0,
+                "str": f"str{i}" if i % 3 else None,
+                "dt": f"2025-01-02T03:04:{i:02d}Z",
+                "date": "2025-01-02",
+            },
+            "geometry": geometries[i % len(geometries)],
+        }
+        if variant == "int_id":
+            # Includes duplicated ids
+            feature["id"] = i % 40
+        elif variant == "string_id":
+            feature["id"] = f"id{i}"
+        if variant == "fallback" and i == 30:
+            feature["geometry"] = {
+                "type": "GeometryCollection",
+                "geometries": [{"type": "Point", "coordinates": [1, 2]}],
+            }
+        features.append(feature)
+
+    filename = tmp_vsimem / "test.geojson"
+    gdal.FileFromMemBuffer(
+        filename, json.dumps({"type": "FeatureCollection", "features": features})
+    )
+
+    def get_batches(base_impl):
+        with gdaltest.config_option(
+            "OGR_GEOJSON_STREAM_BASE_IMPL", "YES" if base_impl else "NO"
+        ):
+            with ogr.Open(filename) as ds:
+                lyr = ds.GetLayer(0)
+                assert lyr.TestCapability(ogr.OLCFastGetArrowStream) == (
+                    not base_impl
+                )
+                stream = lyr.GetArrowStreamAsNumPy(
+                    options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=7"]
+                )
+                with gdal.quiet_errors():
+                    return [
+                        {k: v.tolist() for k, v in batch.items()} for batch in stream
+                    ]
+
+    expected = get_batches(True)
+    assert sum(len(batch["OGC_FID"]) for batch in expected) == 50
+    assert get_batches(False) == expected
@@ -12,6 +12,8 @@
 ###############################################################################
 
 
+import json
+
 import gdaltest
 import pytest
 
@@ -522,3 +524,70 @@ def test_ogr_geojsonseq_WRITE_BBOX(tmp_vsimem):
     gdal.VSIFCloseL(f)
 
     assert b'"bbox": [ 2.0, 49.0, 3.0, 50.0 ]' in data
+
+
+###############################################################################
+# Test that the native implementation of GetNextArrowArray() returns the
+# same result as the generic one
+
+
+def test_ogr_geojsonseq_arrow_stream_numpy_native(tmp_vsimem):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    records = []
+    for i in range(50):
+        if i % 10 == 3:
+            # Bare geometry
+            records.append(json.dumps({"type": "Point", "coordinates": [i, i]}))
+            continue
+        if i % 10 == 6:
+            # Handled by the regular code path
+            geometry = {
+                "type": "GeometryCollection",
+                "geometries": [{"type": "Point", "coordinates": [i, i]}],
+            }
+        elif i % 2:
+            geometry = {"type": "LineString", "coordinates": [[i, i], [i, i, i]]}
+        else:
+            geometry = None
+        records.append(
+            json.dumps(
+                {
+                    "type": "Feature",
+                    "properties": {
+                        "int": i if i % 5 else None,
+                        "str": f"str{i}",
+                        "dt": f"2025-01-02T03:04:{i:02d}",
+                    },
+                    "geometry": geometry,
+                }
+            )
+        )
+    records.insert(20, "not json")
+
+    filename = tmp_vsimem / "test.geojsonl"
+    gdal.FileFromMemBuffer(filename, "\n".join(records) + "\n")
+
+    def get_batches(base_impl):
+        with gdaltest.config_option(
+            "OGR_GEOJSONSEQ_STREAM_BASE_IMPL", "YES" if base_impl else "NO"
+        ):
+            with gdal.quiet_errors():
+                ds = ogr.Open(filename)
+            with ds:
+                lyr = ds.GetLayer(0)
+                assert lyr.TestCapability(ogr.OLCFastGetArrowStream) == (
+                    not base_impl
+                )
+                stream = lyr.GetArrowStreamAsNumPy(
+                    options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=7"]
+                )
+                with gdal.quiet_errors():
+                    return [
+                        {k: v.tolist() for k, v in batch.items()} for batch in stream
+                    ]
+
+    expected = get_batches(True)
+    assert sum(len(batch["OGC_FID"]) for batch in expected) == 50
+    assert get_batches(False) == expected
@@ -10116,6 +10116,103 @@ def test_ogr_gpkg_write_arrow_fallback_types(tmp_vsimem):
     assert f.GetGeometryRef().ExportToIsoWkt() == "POINT (1 2)"
 
 
+###############################################################################
+# Test that the native WriteArrowBatch() implementation gives the same result
+# as the generic one
+
+
+@gdaltest.enable_exceptions()
+@pytest.mark.parametrize("base_impl", ["NO", "YES"])
+def test_ogr_gpkg_write_arrow_native(tmp_vsimem, base_impl):
+
+    wkts = [
+        "POINT (1 2)",
+        "POINT Z (1 2 3)",
+        "POINT EMPTY",
+        "LINESTRING (1 2,3 4)",
+        "POLYGON ((0 0,0 1,1 1,0 0))",
+        "MULTIPOLYGON (((0 0,0 1,1 1,0 0)),((10 10,10 11,11 11,10 10)))",
+        "CIRCULARSTRING (0 0,1 1,2 0)",
+        None,
+    ]
+    src_ds, src_lyr = ogrtest.create_arrow_write_source_layer(wkts)
+    multipolygon_count = 0
+    non_empty_geom_count = 0
+    for src_f in src_lyr:
+        src_g = src_f.GetGeometryRef()
+        if src_g is not None:
+            if not src_g.IsEmpty():
+                non_empty_geom_count += 1
+            if ogr.GT_Flatten(src_g.GetGeometryType()) == ogr.wkbMultiPolygon:
+                multipolygon_count += 1
+
+    def get_rtree_count(ds):
+        with ds.ExecuteSQL("SELECT COUNT(*) FROM rtree_test_geom") as sql_lyr:
+            return sql_lyr.GetNextFeature().GetField(0)
+
+    filename = tmp_vsimem / "test_ogr_gpkg_write_arrow_native.gpkg"
+    ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbUnknown)
+    assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch)
+
+    with gdal.config_option("OGR_GPKG_WRITE_ARROW_BATCH_BASE_IMPL", base_impl):
+        ogrtest.write_arrow_batches(src_lyr, lyr, ["FID=OGC_FID"])
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    ogrtest.check_arrow_written_layer(lyr, src_lyr)
+    for f in lyr:
+        assert f.GetFID() == f["id"] + 1
+
+    # Check the RTree
+    assert get_rtree_count(ds) == non_empty_geom_count
+    lyr.SetSpatialFilterRect(9.5, 9.5, 11.5, 11.5)
+    assert lyr.GetFeatureCount() == multipolygon_count
+    ds = None
+
+    # Append to the now populated and indexed layer within a transaction,
+    # where the RTree is updated in a deferred way
+    src2_ds, src2_lyr = ogrtest.create_arrow_write_source_layer(wkts, first_fid=1001)
+    ds = ogr.Open(filename, update=1)
+    lyr = ds.GetLayer(0)
+    ds.StartTransaction()
+    with gdal.config_option("OGR_GPKG_WRITE_ARROW_BATCH_BASE_IMPL", base_impl):
+        ogrtest.write_arrow_batches(src2_lyr, lyr, ["FID=OGC_FID"], create_fields=False)
+    ds.CommitTransaction()
+    ds = None
+
+    ds = ogr.Open(filename, update=1)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 2 * src_lyr.GetFeatureCount()
+    assert get_rtree_count(ds) == 2 * non_empty_geom_count
+    lyr.SetSpatialFilterRect(9.5, 9.5, 11.5, 11.5)
+    assert lyr.GetFeatureCount() == 2 * multipolygon_count
+    lyr.SetSpatialFilter(None)
+
+    # A batch failing on already existing FIDs, after a successful one, must
+    # leave the layer and its RTree unchanged once the transaction is rolled
+    # back
+    src3_ds, src3_lyr = ogrtest.create_arrow_write_source_layer(wkts, first_fid=2001)
+    ds.StartTransaction()
+    with gdal.config_option("OGR_GPKG_WRITE_ARROW_BATCH_BASE_IMPL", base_impl):
+        ogrtest.write_arrow_batches(src3_lyr, lyr, ["FID=OGC_FID"], create_fields=False)
+        with pytest.raises(Exception):
+            ogrtest.write_arrow_batches(
+                src2_lyr, lyr, ["FID=OGC_FID"], create_fields=False
+            )
+    ds.RollbackTransaction()
+    assert lyr.GetFeatureCount() == 2 * src_lyr.GetFeatureCount()
+    assert get_rtree_count(ds) == 2 * non_empty_geom_count
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 2 * src_lyr.GetFeatureCount()
+    assert get_rtree_count(ds) == 2 * non_empty_geom_count
+    ds = None
+
+
 ###############################################################################
 # Test a SQL request with the geometry in the first row being null
 
@@ -3017,3 +3017,75 @@ def test_ogr_mem_extent():
             0.01796630538796444,
         )
     )
+
+
+###############################################################################
+# Test that the spatial index gives the same results as a sequential scan,
+# including after features have been created, modified or deleted.
+
+
+def test_ogr_mem_spatial_index():
+
+    ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr_ref = ds.CreateLayer("test_ref", options=["SPATIAL_INDEX=NO"])
+
+    for layer in (lyr, lyr_ref):
+        for i in range(2000):
+            f = ogr.Feature(layer.GetLayerDefn())
+            x = i % 50
+            y = i // 50
+            if i % 100 == 7:
+                pass  # no geometry
+            elif i % 3 == 0:
+                f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({x} {y})"))
+            else:
+                f.SetGeometry(
+                    ogr.CreateGeometryFromWkt(
+                        f"LINESTRING ({x} {y},{x + 1.5} {y + 0.5})"
+                    )
+                )
+            layer.CreateFeature(f)
+
+    def check(filter_wkt):
+        geom = ogr.CreateGeometryFromWkt(filter_wkt)
+        lyr.SetSpatialFilter(geom)
+        lyr_ref.SetSpatialFilter(geom)
+        for _ in range(3):
+            got = [f.GetFID() for f in lyr]
+            expected = [f.GetFID() for f in lyr_ref]
+            assert got == expected
+            assert lyr.GetFeatureCount() == lyr_ref.GetFeatureCount()
+
+    check("POLYGON ((10 10,10 20,20 20,20 10,10 10))")
+    check("POLYGON ((-5 -5,-5 0.2,60 0.2,60 -5,-5 -5))")
+    check("POLYGON ((100 100,100 101,101 101,101 100,100 100))")
+
+    for layer in (lyr, lyr_ref):
+        # Move a feature into the filter area
+        f = layer.GetFeature(1999)
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (15 15)"))
+        layer.SetFeature(f)
+        # Move a feature out of the filter area
+        f = layer.GetFeature(11 * 50 + 11)
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (-100 -100)"))
+        layer.SetFeature(f)
+        # Delete a feature in the filter area
+        layer.DeleteFeature(12 * 50 + 12)
+        # Create a new one in the filter area
+        f = ogr.Feature(layer.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (12 12)"))
+        layer.CreateFeature(f)
+        # Update the geometry of a feature
+        f = ogr.Feature(layer.GetLayerDefn())
+        f.SetFID(13 * 50 + 13)
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (-50 -50)"))
+        layer.UpdateFeature(f, [], [0], False)
+
+    check("POLYGON ((10 10,10 20,20 20,20 10,10 10))")
+    check("POLYGON ((-101 -101,-101 -49,-49 -49,-49 -101,-101 -101))")
+
+    # Combined with an attribute filter
+    lyr.SetAttributeFilter("FID > 1000")
+    lyr_ref.SetAttributeFilter("FID > 1000")
+    check("POLYGON ((10 10,10 30,20 30,20 10,10 10))")
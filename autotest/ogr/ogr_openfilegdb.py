@@ -12,6 +12,7 @@
 # SPDX-License-Identifier: MIT
 ###############################################################################
 
+import math
 import os
 import shutil
 import sys
@@ -2967,3 +2968,48 @@ def test_ogr_openfilegdb_vsizip_random_zip_name_and_no_gdb_subdir():
 
     with ogr.Open("/vsizip/data/filegdb/testopenfilegdb.zip") as ds:
         assert ds.GetLayerCount() == 37
+
+
+###############################################################################
+# Test the parallel implementation of GetNextArrowArray()
+
+
+@pytest.mark.parametrize(
+    "filename",
+    [
+        "data/filegdb/testopenfilegdb.gdb.zip",
+        "data/filegdb/sparse.gdb.zip",
+        "data/filegdb/arcgis_pro_32_types.gdb",
+    ],
+)
+def test_ogr_openfilegdb_arrow_stream_numpy_multi_threading(filename):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    def check_capability(lyr, num_threads):
+        if num_threads == 1:
+            assert not lyr.TestCapability(ogr.OLCFastGetArrowStream)
+
+    layers_batches = ogrtest.check_arrow_stream_multi_threading(
+        filename,
+        "OGR_OPENFILEGDB_NUM_THREADS",
+        ["MAX_FEATURES_IN_BATCH=3"],
+        layer_callback=check_capability,
+    )
+    with ogr.Open(filename) as ds:
+        assert len(layers_batches) == ds.GetLayerCount()
+        for lyr, batches in zip(ds, layers_batches):
+            assert lyr.GetFeatureCount() == sum(
+                len(batch[lyr.GetFIDColumn()]) for batch in batches
+            )
+
+    with gdaltest.config_option("OGR_OPENFILEGDB_NUM_THREADS", "4"):
+        with ogr.Open("data/filegdb/testopenfilegdb.gdb.zip") as ds:
+            lyr = ds.GetLayerByName("point")
+            assert lyr.TestCapability(ogr.OLCFastGetArrowStream)
+            # Does not depend on the state of the cursor
+            for f in lyr:
+                pass
+            assert lyr.TestCapability(ogr.OLCFastGetArrowStream)
+            lyr.SetAttributeFilter("id = 1")
+            assert not lyr.TestCapability(ogr.OLCFastGetArrowStream)
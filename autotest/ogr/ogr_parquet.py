@@ -2424,6 +2424,61 @@ def test_ogr_parquet_arrow_stream_numpy_fast_attribute_filter(filter):
         assert fc != 0
 
 
+###############################################################################
+# Test that the vectorized evaluation of attribute filters on fields of
+# (possibly null) structures gives the same result as the per-feature one
+
+
+@pytest.mark.parametrize(
+    "filter",
+    [
+        '"struct_field.a" = 1',
+        '"struct_field.a" IS NULL',
+        '"struct_field.a" IS NOT NULL',
+        '"struct_field.b" > 2',
+        "\"struct_field.c.d\" = 'e'",
+        '"struct_field.c.d" IS NULL',
+        'NOT ("struct_field.a" = 1) OR "struct_field.c.f" = \'g\'',
+    ],
+)
+def test_ogr_parquet_arrow_stream_numpy_vectorized_attribute_filter_on_struct(
+    filter,
+):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    def get_layer(ds):
+        lyr = ds.GetLayer(0)
+        ignored_fields = ["decimal128", "decimal256", "time64_ns"]
+        lyr_defn = lyr.GetLayerDefn()
+        for i in range(lyr_defn.GetFieldCount()):
+            fld_defn = lyr_defn.GetFieldDefn(i)
+            if fld_defn.GetName().startswith("map_"):
+                ignored_fields.append(fld_defn.GetNameRef())
+        lyr.SetIgnoredFields(ignored_fields)
+        lyr.SetAttributeFilter(filter)
+        return lyr
+
+    # "uint8" is unique for each row
+    def get_uint8_values(vectorized):
+        with ogr.Open("data/parquet/test.parquet") as ds:
+            lyr = get_layer(ds)
+            with gdal.config_option(
+                "OGR_ARROW_VECTORIZED_ATTRIBUTE_FILTER", "YES" if vectorized else "NO"
+            ):
+                stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
+                values = []
+                for batch in stream:
+                    values += batch["uint8"].tolist()
+        return values
+
+    with ogr.Open("data/parquet/test.parquet") as ds:
+        expected = [f["uint8"] for f in get_layer(ds)]
+
+    assert get_uint8_values(False) == expected
+    assert get_uint8_values(True) == expected
+
+
 ###############################################################################
 
 
@@ -2234,3 +2234,43 @@ def test_ogr_sql_union_layer_feature_count_add_overflow():
             "select * from test union all select * from test2", dialect="OGRSQL"
         ) as sql_lyr:
             assert sql_lyr.GetFeatureCount() == 0
+
+
+###############################################################################
+# Test ORDER BY with a multithreaded sort, and with sorted runs spilled to
+# a temporary file
+
+
+@pytest.mark.parametrize(
+    "num_threads,max_memory", [("1", None), ("4", None), ("4", "100KB")]
+)
+def test_ogr_sql_order_by_multithreaded_and_spill(num_threads, max_memory):
+
+    ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("int_field", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("str_field", ogr.OFTString))
+    expected = []
+    for i in range(50000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        int_val = (i * 7919) % 1000
+        f["int_field"] = int_val
+        str_val = None
+        if i % 10 != 0:
+            str_val = "val%d" % ((i * 104729) % 317)
+            f["str_field"] = str_val
+        lyr.CreateFeature(f)
+        expected.append((int_val, "" if str_val is None else str_val, f.GetFID()))
+    # Stable sort on (int_field DESC, str_field ASC), nulls first
+    expected.sort(key=lambda x: x[1])
+    expected.sort(key=lambda x: x[0], reverse=True)
+
+    with gdal.config_options(
+        {"GDAL_NUM_THREADS": num_threads, "OGR_SQL_SORT_MAX_MEMORY": max_memory}
+    ):
+        with ds.ExecuteSQL(
+            "SELECT * FROM test ORDER BY int_field DESC, str_field"
+        ) as sql_lyr:
+            got = [f.GetFID() for f in sql_lyr]
+
+    assert got == [x[2] for x in expected]
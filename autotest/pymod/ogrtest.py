@@ -24,6 +24,7 @@
 ###############################################################################
 
 import contextlib
+import math
 import sys
 
 sys.path.append("../pymod")
@@ -407,6 +408,169 @@ def spatial_filter(lyr, *args):
         lyr.SetSpatialFilter(None)
 
 
+###############################################################################
+# Check that the multi-threaded implementation of GetNextArrowArray() of a
+# driver returns the same batches as the single-threaded one.
+# The number of threads is set through the config_option configuration option.
+# If provided, layer_callback(lyr, num_threads) is called on each layer before
+# its Arrow stream is read (for example to set a spatial filter).
+# Returns, for each layer of the dataset, the list of batches as dictionaries
+# of lists.
+
+
+def check_arrow_stream_multi_threading(
+    filename, config_option, options=[], layer_callback=None, num_threads=4
+):
+    __tracebackhide__ = True
+
+    def to_list(array):
+        # NaN values would not compare equal
+        return [
+            None if isinstance(x, float) and math.isnan(x) else x
+            for x in array.tolist()
+        ]
+
+    def get_batches(num_threads):
+        ret = []
+        with gdaltest.config_option(config_option, str(num_threads)):
+            with ogr.Open(filename) as ds:
+                for lyr in ds:
+                    if layer_callback:
+                        layer_callback(lyr, num_threads)
+                    stream = lyr.GetArrowStreamAsNumPy(
+                        options=["USE_MASKED_ARRAYS=NO"] + options
+                    )
+                    ret.append(
+                        [{k: to_list(v) for k, v in batch.items()} for batch in stream]
+                    )
+        return ret
+
+    expected = get_batches(1)
+    assert get_batches(num_threads) == expected
+    return expected
+
+
+###############################################################################
+# Create a MEM layer with fields of most OGR types and feature_count features
+# cycling through the passed geometries, to be used as the source of
+# WriteArrowBatch() tests. The "id" field is set to the index of the feature,
+# and its FID to first_fid + index.
+
+
+def create_arrow_write_source_layer(wkts, feature_count=300, first_fid=1):
+
+    src_ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    src_lyr = src_ds.CreateLayer("test")
+    src_lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    src_lyr.CreateField(ogr.FieldDefn("string", ogr.OFTString))
+    src_lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTBoolean)
+    src_lyr.CreateField(fld_defn)
+    fld_defn = ogr.FieldDefn("int16", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTInt16)
+    src_lyr.CreateField(fld_defn)
+    src_lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    src_lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    fld_defn = ogr.FieldDefn("float32", ogr.OFTReal)
+    fld_defn.SetSubType(ogr.OFSTFloat32)
+    src_lyr.CreateField(fld_defn)
+    src_lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+    src_lyr.CreateField(ogr.FieldDefn("datetime", ogr.OFTDateTime))
+    src_lyr.CreateField(ogr.FieldDefn("binary", ogr.OFTBinary))
+    for i in range(feature_count):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["id"] = i
+        if i % 7 != 0:
+            f["string"] = "foo%d" % i
+            f["int"] = i
+            f["bool"] = i % 2
+            f["int16"] = -i
+            f["int64"] = 12345678901234 + i
+            f["real"] = 1.5 + i
+            f["float32"] = 0.5 + i
+            f["date"] = "2023/10/06"
+            f["datetime"] = "2023/10/06 19:43:%02d.5+00" % (i % 60)
+            f.SetField("binary", b"\x01\x23\x46\x57\x89\xAB\xCD\xEF")
+        wkt = wkts[i % len(wkts)]
+        if wkt:
+            g = ogr.CreateGeometryFromWkt(wkt)
+            if i % 3 == 0 and g.GetGeometryType() not in (
+                ogr.wkbCircularString,
+                ogr.wkbGeometryCollection,
+            ):
+                g.Set3D(True)
+            f.SetGeometry(g)
+        f.SetFID(first_fid + i)
+        src_lyr.CreateFeature(f)
+    return src_ds, src_lyr
+
+
+###############################################################################
+# Write the content of src_lyr into lyr with WriteArrowBatch(), by batches of
+# 50 features. Missing fields are first created with
+# CreateFieldFromArrowSchema() when create_fields is set.
+
+
+def write_arrow_batches(src_lyr, lyr, options=[], create_fields=True):
+    __tracebackhide__ = True
+
+    stream = src_lyr.GetArrowStream(["MAX_FEATURES_IN_BATCH=50"])
+    schema = stream.GetSchema()
+
+    if create_fields:
+        for i in range(schema.GetChildrenCount()):
+            if schema.GetChild(i).GetName() not in ("wkb_geometry", "OGC_FID"):
+                lyr.CreateFieldFromArrowSchema(schema.GetChild(i))
+
+    while True:
+        array = stream.GetNextRecordBatch()
+        if array is None:
+            break
+        assert lyr.WriteArrowBatch(schema, array, options)
+
+
+###############################################################################
+# Check that the features of lyr match the ones of a layer created with
+# create_arrow_write_source_layer(). Features are matched on the "id" field,
+# as some drivers reorder them. When empty_geom_as_null is set, empty source
+# geometries are expected to be read back as null ones.
+
+
+def check_arrow_written_layer(lyr, src_lyr, empty_geom_as_null=False):
+    __tracebackhide__ = True
+
+    assert lyr.GetFeatureCount() == src_lyr.GetFeatureCount()
+    assert lyr.GetExtent() == src_lyr.GetExtent()
+    src_lyr.ResetReading()
+    src_features = {src_f["id"]: src_f for src_f in src_lyr}
+    lyr.ResetReading()
+    for f in lyr:
+        src_f = src_features[f["id"]]
+        for fld_name in (
+            "string",
+            "int",
+            "bool",
+            "int16",
+            "int64",
+            "real",
+            "float32",
+            "date",
+        ):
+            assert f[fld_name] == src_f[fld_name], fld_name
+        assert (
+            f.GetFieldAsDateTime("datetime")[0:6]
+            == src_f.GetFieldAsDateTime("datetime")[0:6]
+        )
+        assert f.GetFieldAsString("binary") == src_f.GetFieldAsString("binary")
+        g = f.GetGeometryRef()
+        src_g = src_f.GetGeometryRef()
+        if src_g is None or (empty_geom_as_null and src_g.IsEmpty()):
+            assert g is None
+        else:
+            check_feature_geometry(g, src_g)
+
+
 ###############################################################################
 # Check transactions rollback, to be called with a freshly created datasource
 
@@ -739,3 +739,38 @@ def test_gdal_footprint_lib_writeAbsolutePath():
     lyr = out_ds.GetLayer(0)
     f = lyr.GetNextFeature()
     assert os.path.isabs(f["location"])
+
+
+###############################################################################
+# Test that computing the mask with several threads gives the same result as
+# with a single one
+
+
+@pytest.mark.parametrize("combineBands", ["union", "intersection"])
+def test_gdal_footprint_lib_num_threads(combineBands):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 1500, 1500, 2)
+    src_ds.GetRasterBand(1).Fill(1)
+    src_ds.GetRasterBand(2).Fill(1)
+    # Holes and islands spanning several strips of lines
+    src_ds.GetRasterBand(1).WriteRaster(100, 200, 300, 900, b"\x00" * (300 * 900))
+    src_ds.GetRasterBand(1).WriteRaster(150, 600, 50, 50, b"\x01" * (50 * 50))
+    src_ds.GetRasterBand(2).WriteRaster(300, 0, 1000, 1000, b"\x00" * (1000 * 1000))
+    src_ds.GetRasterBand(2).WriteRaster(1400, 700, 1, 800, b"\x00" * 800)
+
+    def compute(num_threads):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            out_ds = gdal.Footprint(
+                "",
+                src_ds,
+                format="MEM",
+                srcNodata=0,
+                combineBands=combineBands,
+                splitPolys=True,
+            )
+        lyr = out_ds.GetLayer(0)
+        return sorted(f.GetGeometryRef().ExportToIsoWkt() for f in lyr)
+
+    ref = compute("1")
+    assert ref
+    assert compute("4") == ref
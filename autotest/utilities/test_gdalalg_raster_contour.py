@@ -223,3 +223,36 @@ def test_gdalalg_raster_contour_creation_options(tmp_vsimem):
         ) as sql_lyr:
             assert sql_lyr.GetFeatureCount() == 2
         assert ds.GetLayer(0).GetMetadata_Dict() == {"DESCRIPTION": "my_desc"}
+
+
+def test_gdalalg_raster_contour_num_threads(tmp_vsimem):
+
+    src_filename = str(tmp_vsimem / "n43.tif")
+    gdal.Translate(
+        src_filename,
+        "../gdrivers/data/n43.tif",
+        creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+
+    def run(num_threads):
+        out_filename = str(tmp_vsimem / f"out_{num_threads}.shp")
+        alg = get_contour_alg()
+        assert alg.ParseRunAndFinalize(
+            [
+                src_filename,
+                out_filename,
+                "--interval",
+                "10",
+                "--elevation-name",
+                "ELEV",
+                "--num-threads",
+                num_threads,
+            ]
+        )
+        with ogr.Open(out_filename) as ds:
+            lyr = ds.GetLayer(0)
+            return [(f["ELEV"], f.GetGeometryRef().ExportToIsoWkt()) for f in lyr]
+
+    ref = run("1")
+    assert len(ref) > 0
+    assert run("4") == ref
@@ -78,6 +78,22 @@ def create_gtiff_from_array(
                 dtype=np.float32,
             ),
         ),
+        # Test exact algorithm with several threads
+        (
+            {
+                "datatype": "Float32",
+                "target-values": [1],
+                "distance-units": "PIXEL",
+                "max-distance": 2,
+                "nodata": 0,
+                "algorithm": "exact",
+                "num-threads": 2,
+            },
+            np.array(
+                [[0.0, 0.0, 2.0], [0.0, 1.4142135, 1.0], [2.0, 1.0, 0.0]],
+                dtype=np.float32,
+            ),
+        ),
         # Test with target-values 1 and 3
         (
             {
@@ -19,7 +19,7 @@ import struct
 import gdaltest
 import pytest
 
-from osgeo import gdal
+from osgeo import gdal, osr
 
 ###############################################################################
 # Simple test
@@ -1085,3 +1085,43 @@ def test_gdalbuildvrt_pixel_function_arg_no_pixel_function():
         RuntimeError, match="arguments provided without a pixel function"
     ):
         gdal.BuildVRT("", "../gcore/data/byte.tif", pixelFunctionArgs={"k": 7})
+
+
+###############################################################################
+# Test that opening sources with several threads gives the same result as
+# with a single one
+
+
+def test_gdalbuildvrt_lib_num_threads(tmp_vsimem):
+
+    filenames = []
+    for i in range(30):
+        filename = str(tmp_vsimem / f"src{i}.tif")
+        with gdal.GetDriverByName("GTiff").Create(filename, 3, 2) as ds:
+            ds.SetGeoTransform([i * 3, 1, 0, (i % 3) * 2, 0, -1])
+            ds.SetSpatialRef(osr.SpatialReference(epsg=32631))
+            if i != 5:
+                ds.GetRasterBand(1).SetNoDataValue(i)
+            ds.GetRasterBand(1).Fill(i + 1)
+        filenames.append(filename)
+    filenames.insert(10, str(tmp_vsimem / "i_dont_exist.tif"))
+
+    def build(num_threads):
+        warnings = []
+
+        def handler(err_level, err_no, err_msg):
+            warnings.append(err_msg)
+
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            with gdaltest.error_handler(handler):
+                ds = gdal.BuildVRT("", filenames)
+        return ds.GetMetadata("xml:VRT")[0], ds.ReadRaster(), warnings
+
+    ref_xml, ref_data, ref_warnings = build("1")
+    assert len(ref_warnings) == 1
+    assert "i_dont_exist.tif" in ref_warnings[0]
+
+    xml, data, warnings = build("4")
+    assert xml == ref_xml
+    assert data == ref_data
+    assert warnings == ref_warnings
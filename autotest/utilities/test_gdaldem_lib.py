@@ -894,6 +894,62 @@ def test_gdaldem_lib_nodata():
         pytest.fail("Bad checksum")
 
 
+###############################################################################
+# Test that multithreaded processing gives the same result as single-threaded
+
+
+@pytest.mark.require_driver("GTiff")
+@pytest.mark.parametrize(
+    "processing,options",
+    [
+        ("hillshade", {}),
+        ("hillshade", {"alg": "ZevenbergenThorne"}),
+        ("hillshade", {"scale": 2, "zFactor": 3}),
+        ("hillshade", {"combined": True}),
+        ("slope", {}),
+        ("slope", {"alg": "ZevenbergenThorne", "slopeFormat": "percent"}),
+        ("aspect", {}),
+        ("TRI", {}),
+        ("TPI", {}),
+        ("roughness", {}),
+    ],
+)
+@pytest.mark.parametrize("compute_edges", [False, True])
+@pytest.mark.parametrize("output_type", [gdal.GDT_Int16, gdal.GDT_Float32])
+def test_gdaldem_lib_multithreaded(
+    tmp_vsimem, processing, options, compute_edges, output_type
+):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.Translate(
+        src_filename,
+        "../gdrivers/data/n43.tif",
+        outputType=output_type,
+        creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+    # Add some nodata values
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(
+        20, 30, 10, 5, b"\x00" * (10 * 5), buf_type=gdal.GDT_Byte
+    )
+    src_ds.Close()
+
+    def process(num_threads):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            with gdal.Open(src_filename) as src_ds:
+                out_ds = gdal.DEMProcessing(
+                    "",
+                    src_ds,
+                    processing,
+                    format="MEM",
+                    computeEdges=compute_edges,
+                    **options,
+                )
+                return out_ds.ReadRaster()
+
+    assert process("4") == process("1")
+
+
 ###############################################################################
 # Test option argument handling
 
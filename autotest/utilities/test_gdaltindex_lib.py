@@ -17,7 +17,7 @@ import os
 import gdaltest
 import pytest
 
-from osgeo import gdal, ogr
+from osgeo import gdal, ogr, osr
 
 ###############################################################################
 # Simple test
@@ -458,3 +458,35 @@ def test_gdaltindex_lib_ot(tmp_path, four_tiles):
     ds = ogr.Open(index_filename)
     lyr = ds.GetLayer(0)
     assert lyr.GetMetadataItem("DATA_TYPE") == "UInt16"
+
+
+###############################################################################
+# Test that opening sources with several threads does not change the order
+# of features
+
+
+def test_gdaltindex_lib_num_threads(tmp_vsimem):
+
+    filenames = []
+    for i in range(30):
+        filename = str(tmp_vsimem / f"src{i}.tif")
+        with gdal.GetDriverByName("GTiff").Create(filename, 3, 2) as ds:
+            ds.SetGeoTransform([i * 3, 1, 0, 0, 0, -1])
+            ds.SetSpatialRef(osr.SpatialReference(epsg=32631))
+        filenames.append(filename)
+    filenames.insert(10, str(tmp_vsimem / "i_dont_exist.tif"))
+
+    def build(num_threads):
+        index_filename = str(tmp_vsimem / f"index_{num_threads}.shp")
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            with gdal.quiet_errors():
+                gdal.TileIndex(index_filename, filenames)
+        with ogr.Open(index_filename) as ds:
+            lyr = ds.GetLayer(0)
+            return [
+                (f["location"], f.GetGeometryRef().ExportToIsoWkt()) for f in lyr
+            ]
+
+    ref = build("1")
+    assert len(ref) == 30
+    assert build("4") == ref
@@ -543,6 +543,54 @@ def test_nearblack_lib_floodfill_concave_from_bottom_non_black():
     )
 
 
+###############################################################################
+# Test that multithreaded processing gives the same result as single-threaded
+
+
+@pytest.mark.parametrize("alg", ["twopasses", "floodfill"])
+@pytest.mark.parametrize("maxNonBlack", [0, 2])
+def test_nearblack_lib_num_threads(alg, maxNonBlack):
+
+    width = 600
+    height = 500
+    src_ds = gdal.GetDriverByName("MEM").Create("", width, height, 3)
+    data = bytearray(b"\xff" * (width * height))
+    # Collar of irregular width, with a concave indentation on the left side
+    # and isolated dark pixels inside the image
+    for y in range(height):
+        left = 10 + (y * 7) % 23
+        right = width - 5 - (y * 13) % 17
+        if 200 <= y < 300:
+            left = 300
+        for x in range(width):
+            if x < left or x >= right or y < 3 or y >= height - (x % 11):
+                data[y * width + x] = 0
+            elif (x * 31 + y * 17) % 97 == 0:
+                data[y * width + x] = 2
+    for i in range(3):
+        src_ds.GetRasterBand(i + 1).WriteRaster(0, 0, width, height, bytes(data))
+    # Opaque barrier to the indentation, to check concave areas
+    src_ds.GetRasterBand(1).WriteRaster(250, 150, 10, 200, b"\xff" * (10 * 200))
+
+    def run(num_threads):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = gdal.Nearblack(
+                "",
+                src_ds,
+                format="MEM",
+                nearDist=3,
+                setAlpha=True,
+                setMask=False,
+                maxNonBlack=maxNonBlack,
+                alg=alg,
+            )
+        return [ds.GetRasterBand(i + 1).ReadRaster() for i in range(4)]
+
+    ref = run("1")
+    assert ref[3].count(0) > 0
+    assert run("4") == ref
+
+
 def test_nearblack_lib_dict_arguments():
 
     opt = gdal.NearblackOptions(
@@ -74,6 +74,36 @@ static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
     return osTmpFilename;
 }
 
+/************************************************************************/
+/*                         GetTmpMaxMemory()                            */
+/*                                                                      */
+/*      Maximum cumulated size of the temporary files that may be       */
+/*      created in /vsimem/ instead of on disk. Disabled by default,    */
+/*      as concurrent creations would multiply the memory used.         */
+/************************************************************************/
+
+static GIntBig GetTmpMaxMemory()
+{
+    const char *pszVal = CPLGetConfigOption("COG_TMP_MAX_MEMORY", nullptr);
+    if (pszVal == nullptr)
+        return 0;
+    GIntBig nRet = 0;
+    CPLErr eErr;
+    {
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        eErr = CPLParseMemorySize(pszVal, &nRet, nullptr);
+    }
+    if (eErr != CE_None)
+    {
+        CPLError(CE_Warning, CPLE_IllegalArg,
+                 "Invalid value for COG_TMP_MAX_MEMORY: %s. "
+                 "Temporary files will be written on disk.",
+                 pszVal);
+        return 0;
+    }
+    return std::max<GIntBig>(0, nRet);
+}
+
 /************************************************************************/
 /*                             GetResampling()                          */
 /************************************************************************/
@@ -564,7 +594,7 @@ void COGRemoveWarpingOptions(CPLStringList &aosOptions)
 /************************************************************************/
 
 static std::unique_ptr<GDALDataset> CreateReprojectedDS(
-    const char *pszDstFilename, GDALDataset *poSrcDS,
+    const CPLString &osTmpFile, GDALDataset *poSrcDS,
     const char *const *papszOptions, const CPLString &osResampling,
     const CPLString &osTargetSRS, const int nXSize, const int nYSize,
     const double dfMinX, const double dfMinY, const double dfMaxX,
@@ -667,7 +697,6 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
     CPLDebug("COG", "Reprojecting source dataset: start");
     GDALWarpAppOptionsSetProgress(psOptions, GDALScaledProgress,
                                   pScaledProgress);
-    CPLString osTmpFile(GetTmpFilename(pszDstFilename, "warped.tif.tmp"));
     auto hSrcDS = GDALDataset::ToHandle(poSrcDS);
 
     std::unique_ptr<CPLConfigOptionSetter> poWarpThreadSetter;
@@ -697,9 +726,13 @@ struct GDALCOGCreator final
     std::unique_ptr<GDALDataset> m_poVRTWithOrWithoutStats{};
     CPLString m_osTmpOverviewFilename{};
     CPLString m_osTmpMskOverviewFilename{};
+    GIntBig m_nTmpMemoryRemaining = GetTmpMaxMemory();
 
     ~GDALCOGCreator();
 
+    CPLString GetTmpFilename(const char *pszFilename, const char *pszExt,
+                             double dfEstimatedSize);
+
     GDALDataset *Create(const char *pszFilename, GDALDataset *const poSrcDS,
                         char **papszOptions, GDALProgressFunc pfnProgress,
                         void *pProgressData);
@@ -737,6 +770,33 @@ GDALCOGCreator::~GDALCOGCreator()
     }
 }
 
+/************************************************************************/
+/*                   GDALCOGCreator::GetTmpFilename()                   */
+/*                                                                      */
+/*      Return the name of a temporary file of at most dfEstimatedSize  */
+/*      bytes. It is created in /vsimem/ if it fits in the remaining    */
+/*      memory budget, to avoid writing it to disk and reading it back. */
+/************************************************************************/
+
+CPLString GDALCOGCreator::GetTmpFilename(const char *pszFilename,
+                                         const char *pszExt,
+                                         double dfEstimatedSize)
+{
+    // Keep temporary files next to the output file when they are not
+    // deleted, so that they can be inspected.
+    if (!STARTS_WITH(pszFilename, "/vsimem/") &&
+        CPLTestBool(CPLGetConfigOption("COG_DELETE_TEMP_FILES", "YES")) &&
+        dfEstimatedSize <= static_cast<double>(m_nTmpMemoryRemaining))
+    {
+        m_nTmpMemoryRemaining -= static_cast<GIntBig>(dfEstimatedSize);
+        CPLString osTmpFilename(VSIMemGenerateHiddenFilename(
+            CPLSPrintf("%s.%s", CPLGetFilename(pszFilename), pszExt)));
+        CPLDebug("COG", "Using %s as temporary file", osTmpFilename.c_str());
+        return osTmpFilename;
+    }
+    return ::GetTmpFilename(pszFilename, pszExt);
+}
+
 /************************************************************************/
 /*                    GDALCOGCreator::Create()                          */
 /************************************************************************/
@@ -869,8 +929,17 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
         }
         else
         {
+            // Upper bound of the size of the reprojected dataset, which may
+            // have an extra alpha band.
+            const double dfReprojectedSize =
+                double(nTargetXSize) * nTargetYSize *
+                (poCurDS->GetRasterCount() + 1) *
+                GDALGetDataTypeSizeBytes(
+                    poCurDS->GetRasterBand(1)->GetRasterDataType());
             m_poReprojectedDS = CreateReprojectedDS(
-                pszFilename, poCurDS, papszOptions, osTargetResampling,
+                GetTmpFilename(pszFilename, "warped.tif.tmp",
+                               dfReprojectedSize),
+                poCurDS, papszOptions, osTargetResampling,
                 osTargetSRS, nTargetXSize, nTargetYSize, dfTargetMinX,
                 dfTargetMinY, dfTargetMaxX, dfTargetMaxY, dfRes, pfnProgress,
                 pProgressData, dfCurPixels, dfTotalPixelsToProcess);
@@ -1106,6 +1175,11 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
             double(nXSize) * nYSize * (nBands + (bHasMask ? 1 : 0)) * 4. / 3;
     }
 
+    // Upper bound of the size of the temporary overview files
+    double dfOverviewPixels = 0;
+    for (const auto &oDims : asOverviewDims)
+        dfOverviewPixels += double(oDims.first) * oDims.second;
+
     CPLStringList aosOverviewOptions;
     aosOverviewOptions.SetNameValue(
         "COMPRESS",
@@ -1119,7 +1193,8 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateMskOvr)
     {
         CPLDebug("COG", "Generating overviews of the mask: start");
-        m_osTmpMskOverviewFilename = GetTmpFilename(pszFilename, "msk.ovr.tmp");
+        m_osTmpMskOverviewFilename =
+            GetTmpFilename(pszFilename, "msk.ovr.tmp", dfOverviewPixels);
         GDALRasterBand *poSrcMask = poFirstBand->GetMaskBand();
         const char *pszResampling = CSLFetchNameValueDef(
             papszOptions, "OVERVIEW_RESAMPLING",
@@ -1149,7 +1224,10 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateOvr)
     {
         CPLDebug("COG", "Generating overviews of the imagery: start");
-        m_osTmpOverviewFilename = GetTmpFilename(pszFilename, "ovr.tmp");
+        m_osTmpOverviewFilename = GetTmpFilename(
+            pszFilename, "ovr.tmp",
+            dfOverviewPixels * nBands *
+                GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType()));
         std::vector<GDALRasterBand *> apoSrcBands;
         for (int i = 0; i < nBands; i++)
             apoSrcBands.push_back(poCurDS->GetRasterBand(i + 1));
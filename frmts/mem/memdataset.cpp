@@ -3225,6 +3225,8 @@ OGRMemLayer *MEMDataset::CreateLayer(const OGRFeatureDefn &oDefn,
 
     if (CPLFetchBool(papszOptions, "ADVERTIZE_UTF8", false))
         poLayer->SetAdvertizeUTF8(true);
+    if (!CPLFetchBool(papszOptions, "SPATIAL_INDEX", true))
+        poLayer->SetSpatialIndexEnabled(false);
 
     poLayer->SetDataset(this);
     poLayer->SetFIDColumn(CSLFetchNameValueDef(papszOptions, "FID", ""));
@@ -3262,6 +3264,8 @@ OGRLayer *MEMDataset::ICreateLayer(const char *pszLayerName,
 
     if (CPLFetchBool(papszOptions, "ADVERTIZE_UTF8", false))
         poLayer->SetAdvertizeUTF8(true);
+    if (!CPLFetchBool(papszOptions, "SPATIAL_INDEX", true))
+        poLayer->SetSpatialIndexEnabled(false);
 
     poLayer->SetDataset(this);
     poLayer->SetFIDColumn(CSLFetchNameValueDef(papszOptions, "FID", ""));
@@ -3478,6 +3482,9 @@ void GDALRegister_MEM()
         "the layer will contain UTF-8 strings' default='NO'/>"
         "  <Option name='FID' type='string' description="
         "'Name of the FID column to create' default='' />"
+        "  <Option name='SPATIAL_INDEX' type='boolean' description="
+        "'Whether a spatial index may be built to speed up spatial filters' "
+        "default='YES' />"
         "</LayerCreationOptionList>");
 
     poDriver->SetMetadataItem(GDAL_DCAP_COORDINATE_EPOCH, "YES");
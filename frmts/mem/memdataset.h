@@ -249,6 +249,24 @@ class CPL_DLL OGRMemLayer CPL_NON_FINAL : public OGRLayer
 
     GDALDataset *m_poDS{};
 
+    // Packed Hilbert R-tree on the geometry field of the spatial filter,
+    // lazily built when the layer is read several times with a spatial
+    // filter.
+    struct SpatialIndex;
+    std::unique_ptr<SpatialIndex> m_poSpatialIndex;
+    bool m_bSpatialIndexEnabled = true;
+    int m_nSpatialFilterScans = 0;
+
+    // When the spatial index is used, ascending FIDs of the features that
+    // may match the spatial filter.
+    bool m_bCandidateFIDsComputed = false;
+    bool m_bUseCandidateFIDs = false;
+    std::vector<GIntBig> m_anCandidateFIDs{};
+    size_t m_iNextCandidateFID = 0;
+
+    bool ComputeCandidateFIDs();
+    void InvalidateSpatialIndex(GIntBig nFID);
+
     // Only use it in the lifetime of a function where the list of features
     // doesn't change.
     IOGRMemLayerFeatureIterator *GetIterator();
@@ -266,6 +284,8 @@ class CPL_DLL OGRMemLayer CPL_NON_FINAL : public OGRLayer
     void ResetReading() override;
     OGRFeature *GetNextFeature() override;
     virtual OGRErr SetNextByIndex(GIntBig nIndex) override;
+    OGRErr ISetSpatialFilter(int iGeomField,
+                             const OGRGeometry *poGeom) override;
 
     OGRFeature *GetFeature(GIntBig nFeatureId) override;
     OGRErr ISetFeature(OGRFeature *poFeature) override;
@@ -320,6 +340,8 @@ class CPL_DLL OGRMemLayer CPL_NON_FINAL : public OGRLayer
         m_bAdvertizeUTF8 = bAdvertizeUTF8In;
     }
 
+    void SetSpatialIndexEnabled(bool bEnabled);
+
     void SetFIDColumn(const char *pszFIDColumn)
     {
         m_osFIDColumn = pszFIDColumn;
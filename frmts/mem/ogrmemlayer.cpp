@@ -17,9 +17,13 @@
 #include <cstddef>
 #include <cstring>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <map>
 #include <new>
+#include <set>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -46,6 +50,191 @@ class IOGRMemLayerFeatureIterator
 
 IOGRMemLayerFeatureIterator::~IOGRMemLayerFeatureIterator() = default;
 
+/************************************************************************/
+/*                      OGRMemLayer::SpatialIndex                       */
+/************************************************************************/
+
+// Static packed R-tree, whose leaves are sorted along a Hilbert curve.
+// Features created, modified or deleted after the tree has been built are
+// tracked as "dirty" and are always returned as candidates.
+struct OGRMemLayer::SpatialIndex
+{
+    static constexpr size_t NODE_SIZE = 16;
+
+    int iGeomField = -1;
+
+    // aaoLevels[0] are the leaf envelopes, whose FID is in anFIDs. The last
+    // level contains the root node.
+    std::vector<std::vector<OGREnvelope>> aaoLevels{};
+    std::vector<GIntBig> anFIDs{};
+
+    std::set<GIntBig> oDirtyFIDs{};
+
+    void Build(IOGRMemLayerFeatureIterator *poIter, int iGeomFieldIn);
+    void Search(const OGREnvelope &sEnvelope,
+                std::vector<GIntBig> &anFIDsOut) const;
+};
+
+// Based on public domain code at
+// https://github.com/rawrunprotected/hilbert_curves
+static uint32_t OGRMemHilbert(uint32_t x, uint32_t y)
+{
+    uint32_t a = x ^ y;
+    uint32_t b = 0xFFFF ^ a;
+    uint32_t c = 0xFFFF ^ (x | y);
+    uint32_t d = x & (y ^ 0xFFFF);
+
+    uint32_t A = a | (b >> 1);
+    uint32_t B = (a >> 1) ^ a;
+    uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+    uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+    B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+    C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+    D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+    B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+    C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+    D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+    D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+
+    uint32_t i0 = x ^ y;
+    uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+    i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+    i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+    i0 = (i0 | (i0 << 2)) & 0x33333333;
+    i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+    i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+    i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+    i1 = (i1 | (i1 << 2)) & 0x33333333;
+    i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+    return (i1 << 1) | i0;
+}
+
+void OGRMemLayer::SpatialIndex::Build(IOGRMemLayerFeatureIterator *poIter,
+                                      int iGeomFieldIn)
+{
+    iGeomField = iGeomFieldIn;
+    aaoLevels.clear();
+    anFIDs.clear();
+    oDirtyFIDs.clear();
+
+    // Collect the envelopes of the non-empty geometries, in FID order.
+    // Null and empty geometries never match a spatial filter.
+    std::vector<OGREnvelope> asEnvelopes;
+    std::vector<GIntBig> anUnsortedFIDs;
+    OGREnvelope sExtent;
+    while (OGRFeature *poFeature = poIter->Next())
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(iGeomField);
+        if (poGeom == nullptr || poGeom->IsEmpty())
+            continue;
+        OGREnvelope sEnvelope;
+        poGeom->getEnvelope(&sEnvelope);
+        sExtent.Merge(sEnvelope);
+        asEnvelopes.push_back(sEnvelope);
+        anUnsortedFIDs.push_back(poFeature->GetFID());
+    }
+
+    // Sort the leaves along the Hilbert curve.
+    constexpr double HILBERT_MAX = (1U << 16) - 1;
+    const double dfWidth = sExtent.MaxX - sExtent.MinX;
+    const double dfHeight = sExtent.MaxY - sExtent.MinY;
+    std::vector<std::pair<uint32_t, size_t>> anHilbertIdx(asEnvelopes.size());
+    for (size_t i = 0; i < asEnvelopes.size(); ++i)
+    {
+        const OGREnvelope &sEnv = asEnvelopes[i];
+        uint32_t x = 0;
+        uint32_t y = 0;
+        if (dfWidth > 0)
+            x = static_cast<uint32_t>(
+                std::floor(HILBERT_MAX * ((sEnv.MinX + sEnv.MaxX) / 2 -
+                                          sExtent.MinX) /
+                           dfWidth));
+        if (dfHeight > 0)
+            y = static_cast<uint32_t>(
+                std::floor(HILBERT_MAX * ((sEnv.MinY + sEnv.MaxY) / 2 -
+                                          sExtent.MinY) /
+                           dfHeight));
+        anHilbertIdx[i] = {OGRMemHilbert(x, y), i};
+    }
+    std::sort(anHilbertIdx.begin(), anHilbertIdx.end());
+
+    aaoLevels.emplace_back();
+    auto &aoLeaves = aaoLevels.back();
+    aoLeaves.reserve(anHilbertIdx.size());
+    anFIDs.reserve(anHilbertIdx.size());
+    for (const auto &oPair : anHilbertIdx)
+    {
+        aoLeaves.push_back(asEnvelopes[oPair.second]);
+        anFIDs.push_back(anUnsortedFIDs[oPair.second]);
+    }
+
+    // Build the upper levels, until a single root node is reached.
+    while (aaoLevels.back().size() > 1)
+    {
+        const auto &aoChildren = aaoLevels.back();
+        std::vector<OGREnvelope> aoParents((aoChildren.size() + NODE_SIZE - 1) /
+                                           NODE_SIZE);
+        for (size_t i = 0; i < aoChildren.size(); ++i)
+            aoParents[i / NODE_SIZE].Merge(aoChildren[i]);
+        aaoLevels.emplace_back(std::move(aoParents));
+    }
+}
+
+void OGRMemLayer::SpatialIndex::Search(const OGREnvelope &sEnvelope,
+                                       std::vector<GIntBig> &anFIDsOut) const
+{
+    if (anFIDs.empty())
+        return;
+
+    // Stack of (level, node index) to visit
+    std::vector<std::pair<size_t, size_t>> aoStack;
+    aoStack.emplace_back(aaoLevels.size() - 1, 0);
+    while (!aoStack.empty())
+    {
+        const auto oTop = aoStack.back();
+        aoStack.pop_back();
+        const size_t iLevel = oTop.first;
+        const size_t iNode = oTop.second;
+        if (!aaoLevels[iLevel][iNode].Intersects(sEnvelope))
+            continue;
+        if (iLevel == 0)
+        {
+            anFIDsOut.push_back(anFIDs[iNode]);
+        }
+        else
+        {
+            const size_t iEnd = std::min(aaoLevels[iLevel - 1].size(),
+                                         (iNode + 1) * NODE_SIZE);
+            for (size_t iChild = iNode * NODE_SIZE; iChild < iEnd; ++iChild)
+                aoStack.emplace_back(iLevel - 1, iChild);
+        }
+    }
+}
+
 /************************************************************************/
 /*                            OGRMemLayer()                             */
 /************************************************************************/
@@ -118,6 +307,132 @@ void OGRMemLayer::ResetReading()
 {
     m_iNextReadFID = 0;
     m_oMapFeaturesIter = m_oMapFeatures.begin();
+    m_bCandidateFIDsComputed = false;
+    m_bUseCandidateFIDs = false;
+    m_anCandidateFIDs.clear();
+    m_iNextCandidateFID = 0;
+}
+
+/************************************************************************/
+/*                         ISetSpatialFilter()                          */
+/************************************************************************/
+
+OGRErr OGRMemLayer::ISetSpatialFilter(int iGeomField,
+                                      const OGRGeometry *poGeomIn)
+{
+    const OGRErr eErr = OGRLayer::ISetSpatialFilter(iGeomField, poGeomIn);
+    // The geometry field may have changed, even if the filter did not.
+    m_bCandidateFIDsComputed = false;
+    m_bUseCandidateFIDs = false;
+    m_anCandidateFIDs.clear();
+    m_iNextCandidateFID = 0;
+    return eErr;
+}
+
+/************************************************************************/
+/*                       SetSpatialIndexEnabled()                       */
+/************************************************************************/
+
+/** Enable or disable the use of a spatial index, lazily built when the
+ * layer is read several times with a spatial filter. Enabled by default.
+ */
+void OGRMemLayer::SetSpatialIndexEnabled(bool bEnabled)
+{
+    m_bSpatialIndexEnabled = bEnabled;
+    if (!bEnabled)
+        m_poSpatialIndex.reset();
+    ResetReading();
+}
+
+/************************************************************************/
+/*                       InvalidateSpatialIndex()                       */
+/*                                                                      */
+/*      Record that the feature of FID nFID has been created, modified  */
+/*      or deleted since the spatial index was built.                   */
+/************************************************************************/
+
+void OGRMemLayer::InvalidateSpatialIndex(GIntBig nFID)
+{
+    if (!m_poSpatialIndex)
+        return;
+
+    // Drop the index if too many features have changed since it was
+    // built. It will be rebuilt on a later read if needed.
+    if (m_poSpatialIndex->oDirtyFIDs.size() >=
+        std::max<size_t>(1000, m_poSpatialIndex->anFIDs.size() / 8))
+    {
+        m_poSpatialIndex.reset();
+        return;
+    }
+
+    try
+    {
+        m_poSpatialIndex->oDirtyFIDs.insert(nFID);
+    }
+    catch (const std::bad_alloc &)
+    {
+        m_poSpatialIndex.reset();
+    }
+}
+
+/************************************************************************/
+/*                        ComputeCandidateFIDs()                        */
+/*                                                                      */
+/*      Use the spatial index, building it if needed, to collect the    */
+/*      FIDs of the features that may match the spatial filter.         */
+/*      Returns false if the spatial index should not be used.          */
+/************************************************************************/
+
+bool OGRMemLayer::ComputeCandidateFIDs()
+{
+    // Below that number of features, a sequential scan is fast enough.
+    constexpr GIntBig MIN_FEATURE_COUNT_FOR_INDEX = 1000;
+
+    if (!m_bSpatialIndexEnabled || m_poFilterGeom == nullptr)
+        return false;
+
+    if (m_poSpatialIndex && m_poSpatialIndex->iGeomField != m_iGeomFieldFilter)
+        m_poSpatialIndex.reset();
+
+    try
+    {
+        if (!m_poSpatialIndex)
+        {
+            // Building the index costs more than a single sequential scan,
+            // so only do it when the layer is read again with a spatial
+            // filter.
+            if (m_nFeatureCount < MIN_FEATURE_COUNT_FOR_INDEX ||
+                ++m_nSpatialFilterScans < 2)
+                return false;
+            m_nSpatialFilterScans = 0;
+
+            auto poIndex = std::make_unique<SpatialIndex>();
+            auto poIter =
+                std::unique_ptr<IOGRMemLayerFeatureIterator>(GetIterator());
+            poIndex->Build(poIter.get(), m_iGeomFieldFilter);
+            m_poSpatialIndex = std::move(poIndex);
+        }
+
+        m_anCandidateFIDs.clear();
+        m_poSpatialIndex->Search(m_sFilterEnvelope, m_anCandidateFIDs);
+        m_anCandidateFIDs.insert(m_anCandidateFIDs.end(),
+                                 m_poSpatialIndex->oDirtyFIDs.begin(),
+                                 m_poSpatialIndex->oDirtyFIDs.end());
+    }
+    catch (const std::bad_alloc &)
+    {
+        m_poSpatialIndex.reset();
+        m_anCandidateFIDs.clear();
+        return false;
+    }
+
+    // Return features in FID order, as a sequential scan does.
+    std::sort(m_anCandidateFIDs.begin(), m_anCandidateFIDs.end());
+    m_anCandidateFIDs.erase(
+        std::unique(m_anCandidateFIDs.begin(), m_anCandidateFIDs.end()),
+        m_anCandidateFIDs.end());
+    m_iNextCandidateFID = 0;
+    return true;
 }
 
 /************************************************************************/
@@ -127,6 +442,33 @@ void OGRMemLayer::ResetReading()
 OGRFeature *OGRMemLayer::GetNextFeature()
 
 {
+    if (!m_bCandidateFIDsComputed)
+    {
+        m_bCandidateFIDsComputed = true;
+        m_bUseCandidateFIDs = ComputeCandidateFIDs();
+    }
+
+    if (m_bUseCandidateFIDs)
+    {
+        while (m_iNextCandidateFID < m_anCandidateFIDs.size())
+        {
+            // Features may have been deleted since the candidates were
+            // collected.
+            OGRFeature *poFeature =
+                GetFeatureRef(m_anCandidateFIDs[m_iNextCandidateFID++]);
+            if (poFeature != nullptr &&
+                FilterGeometry(
+                    poFeature->GetGeomFieldRef(m_iGeomFieldFilter)) &&
+                (m_poAttrQuery == nullptr ||
+                 m_poAttrQuery->Evaluate(poFeature)))
+            {
+                m_nFeaturesRead++;
+                return poFeature->Clone();
+            }
+        }
+        return nullptr;
+    }
+
     while (true)
     {
         OGRFeature *poFeature = nullptr;
@@ -395,6 +737,7 @@ OGRErr OGRMemLayer::ISetFeature(OGRFeature *poFeature)
         }
     }
 
+    InvalidateSpatialIndex(nFID);
     m_bUpdated = true;
 
     return OGRERR_NONE;
@@ -494,6 +837,8 @@ OGRErr OGRMemLayer::IUpdateFeature(OGRFeature *poFeature,
         poFeatureRef->SetStyleString(poFeature->GetStyleString());
     }
 
+    if (nUpdatedGeomFieldsCount > 0)
+        InvalidateSpatialIndex(poFeature->GetFID());
     m_bUpdated = true;
 
     return OGRERR_NONE;
@@ -536,6 +881,7 @@ OGRErr OGRMemLayer::DeleteFeature(GIntBig nFID)
     m_bHasHoles = true;
     --m_nFeatureCount;
 
+    InvalidateSpatialIndex(nFID);
     m_bUpdated = true;
 
     return OGRERR_NONE;
@@ -24,13 +24,16 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <new>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_float.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
@@ -41,6 +44,7 @@
 #include "gdal_priv_templates.hpp"
 #include "gdal_interpolateatpoint.h"
 #include "gdal_minmax_element.hpp"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -6428,6 +6432,249 @@ static inline double GetPixelValue(GDALDataType eDataType, bool bSignedByte,
     return dfValue;
 }
 
+/************************************************************************/
+/*                    ComputeStatisticsGenericBlock()                   */
+/************************************************************************/
+
+// Update the running minimum, maximum, mean and sum of square of differences
+// to the mean (Welford algorithm) with the valid pixels of a block.
+static void ComputeStatisticsGenericBlock(
+    const void *pData, GDALDataType eDataType, bool bSignedByte, int nXCheck,
+    int nYCheck, int nBlockXSize, const GDALNoDataValues &sNoDataValues,
+    const GByte *pabyMaskData, double &dfMin, double &dfMax, double &dfMean,
+    double &dfM2, GUIntBig &nValidCount)
+{
+    // This isn't the fastest way to do this, but is easier for now.
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                continue;
+
+            bool bValid = true;
+            double dfValue = GetPixelValue(eDataType, bSignedByte, pData,
+                                           iOffset, sNoDataValues, bValid);
+
+            if (!bValid)
+                continue;
+
+            dfMin = std::min(dfMin, dfValue);
+            dfMax = std::max(dfMax, dfValue);
+
+            nValidCount++;
+            if (dfMin == dfMax)
+            {
+                if (nValidCount == 1)
+                    dfMean = dfMin;
+            }
+            else
+            {
+                const double dfDelta = dfValue - dfMean;
+                dfMean += dfDelta / nValidCount;
+                dfM2 += dfDelta * (dfValue - dfMean);
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                  GDALRasterBandGetParallelReadDataset()              */
+/************************************************************************/
+
+// Returns the number of threads to use (from GDAL_NUM_THREADS) to process
+// nJobCount independent blocks of poBand, and if it is greater than 1,
+// a dataset through which poBand can be read concurrently from several
+// threads (to be released with ReleaseRef()).
+static int GDALRasterBandGetParallelReadDataset(GDALRasterBand *poBand,
+                                                GIntBig nJobCount,
+                                                GDALDataset *&poTSDS)
+{
+    poTSDS = nullptr;
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                 ? CPLGetNumCPUs()
+                                                 : atoi(pszThreads)));
+    nThreads = static_cast<int>(std::min<GIntBig>(nThreads, nJobCount));
+    if (nThreads <= 1)
+        return 1;
+
+    GDALDataset *poDS = poBand->GetDataset();
+    const int nBand = poBand->GetBand();
+    if (poDS == nullptr || nBand <= 0 || nBand > poDS->GetRasterCount() ||
+        poDS->GetRasterBand(nBand) != poBand ||
+        poDS->GetAccess() != GA_ReadOnly)
+    {
+        return 1;
+    }
+
+    // Fails silently if the dataset cannot be cloned.
+    {
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        poTSDS = GDALGetThreadSafeDataset(poDS, GDAL_OF_RASTER);
+    }
+    if (poTSDS == nullptr)
+        return 1;
+
+    if (GDALGetGlobalThreadPool(nThreads) == nullptr)
+    {
+        poTSDS->ReleaseRef();
+        poTSDS = nullptr;
+        return 1;
+    }
+
+    return nThreads;
+}
+
+/************************************************************************/
+/*                    GDALRasterBandProcessBlocksInParallel()           */
+/************************************************************************/
+
+// Process the blocks of index 0, nSampleRate, 2 * nSampleRate, ... of the
+// band nBand of poTSDS (a dataset returned by
+// GDALRasterBandGetParallelReadDataset()) with the global thread pool.
+//
+// The sampled blocks are split into consecutive ranges, and for each range,
+// an accumulator initialized from oInitAcc is updated by calling
+// processBlock(acc, pData, pabyMaskData, nXCheck, nYCheck) on each block,
+// where pData (and pabyMaskData, if bUseMask) have a line stride of
+// nBlockXSize pixels. The accumulators are returned in aoAcc, in block order,
+// so that the caller can merge them in a deterministic way, whatever the
+// number of threads.
+//
+// Returns CE_None on success.
+template <class Accumulator, class ProcessBlockFunc>
+static CPLErr GDALRasterBandProcessBlocksInParallel(
+    GDALDataset *poTSDS, int nBand, int nThreads, bool bUseMask,
+    int nSampleRate, const Accumulator &oInitAcc,
+    const ProcessBlockFunc &processBlock, std::vector<Accumulator> &aoAcc,
+    GDALProgressFunc pfnProgress, void *pProgressData,
+    const char *pszProgressMsg)
+{
+    GDALRasterBand *poTSBand = poTSDS->GetRasterBand(nBand);
+    GDALRasterBand *poTSMaskBand = bUseMask ? poTSBand->GetMaskBand() : nullptr;
+    const GDALDataType eDT = poTSBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poTSBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow =
+        DIV_ROUND_UP(poTSBand->GetXSize(), nBlockXSize);
+    const int nBlocksPerColumn =
+        DIV_ROUND_UP(poTSBand->GetYSize(), nBlockYSize);
+    const GIntBig nTotalBlocks =
+        static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+    const GIntBig nSampledBlocks = DIV_ROUND_UP(nTotalBlocks, nSampleRate);
+
+    // Use a number of ranges that only depends on the number of blocks, so
+    // that results do not depend on the number of threads.
+    constexpr GIntBig MAX_RANGES = 256;
+    const GIntBig nRanges = std::min(MAX_RANGES, nSampledBlocks);
+    CPLDebug("GDAL",
+             "Processing " CPL_FRMT_GIB " blocks of band %d of %s with %d "
+             "threads",
+             nSampledBlocks, nBand, poTSDS->GetDescription(), nThreads);
+    aoAcc.clear();
+    aoAcc.resize(static_cast<size_t>(nRanges), oInitAcc);
+
+    std::atomic<GIntBig> nBlocksDone{0};
+    std::atomic<bool> bStop{false};
+    std::atomic<bool> bError{false};
+    CPLErrorAccumulator oErrorAccumulator;
+
+    auto poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+    for (GIntBig iRange = 0; iRange < nRanges; ++iRange)
+    {
+        const GIntBig iFirstSampled = iRange * nSampledBlocks / nRanges;
+        const GIntBig iLastSampled = (iRange + 1) * nSampledBlocks / nRanges;
+        Accumulator &oAcc = aoAcc[static_cast<size_t>(iRange)];
+        poJobQueue->SubmitJob(
+            [&, iFirstSampled, iLastSampled]()
+            {
+                auto oContext = oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oContext);
+
+                // Use aligned buffers, as some statistics kernels expect it.
+                const size_t nBlockPixels =
+                    static_cast<size_t>(nBlockXSize) * nBlockYSize;
+                std::unique_ptr<void, decltype(&VSIFreeAligned)> pData(
+                    VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nBlockPixels * nDTSize),
+                    VSIFreeAligned);
+                std::unique_ptr<void, decltype(&VSIFreeAligned)> pMask(
+                    poTSMaskBand ? VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nBlockPixels)
+                                 : nullptr,
+                    VSIFreeAligned);
+                if (!pData || (poTSMaskBand && !pMask))
+                {
+                    bError = true;
+                    return;
+                }
+                GByte *pabyMask = static_cast<GByte *>(pMask.get());
+
+                for (GIntBig iSampled = iFirstSampled;
+                     iSampled < iLastSampled && !bStop && !bError; ++iSampled)
+                {
+                    const GIntBig iBlock = iSampled * nSampleRate;
+                    const int iYBlock =
+                        static_cast<int>(iBlock / nBlocksPerRow);
+                    const int iXBlock =
+                        static_cast<int>(iBlock % nBlocksPerRow);
+                    int nXCheck = 0, nYCheck = 0;
+                    poTSBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck,
+                                                 &nYCheck);
+
+                    if (poTSBand->RasterIO(
+                            GF_Read, iXBlock * nBlockXSize,
+                            iYBlock * nBlockYSize, nXCheck, nYCheck,
+                            pData.get(), nXCheck, nYCheck, eDT, nDTSize,
+                            static_cast<GSpacing>(nDTSize) * nBlockXSize,
+                            nullptr) != CE_None ||
+                        (poTSMaskBand &&
+                         poTSMaskBand->RasterIO(
+                             GF_Read, iXBlock * nBlockXSize,
+                             iYBlock * nBlockYSize, nXCheck, nYCheck,
+                             pabyMask, nXCheck, nYCheck, GDT_Byte, 1,
+                             nBlockXSize, nullptr) != CE_None))
+                    {
+                        bError = true;
+                        break;
+                    }
+
+                    processBlock(oAcc, pData.get(), pabyMask, nXCheck,
+                                 nYCheck);
+                    ++nBlocksDone;
+                }
+            });
+    }
+
+    // Report progress while jobs are running.
+    while (poJobQueue->WaitEvent())
+    {
+        if (!bStop &&
+            !pfnProgress(static_cast<double>(nBlocksDone) / nSampledBlocks,
+                         pszProgressMsg, pProgressData))
+        {
+            bStop = true;
+        }
+    }
+    poJobQueue->WaitCompletion();
+
+    oErrorAccumulator.ReplayErrors();
+
+    if (bError)
+        return CE_Failure;
+    if (bStop)
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                         SetValidPercent()                            */
 /************************************************************************/
@@ -6495,6 +6742,14 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.12, the GDAL_NUM_THREADS configuration option can be
+ * set to a number of threads or ALL_CPUS to read and process blocks in
+ * parallel, when the dataset is opened in read-only mode and can be reopened
+ * in several threads (cf GDALGetThreadSafeDataset()). Results are identical
+ * whatever the number of threads, and are identical to the single-threaded
+ * ones for Byte and UInt16 bands without mask. For other data types, the mean
+ * and standard deviation may differ in the last significant digits.
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -6768,55 +7023,127 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     ? static_cast<GUInt32>(sNoDataValues.dfNoDataValue + 1e-10)
                     : nMaxValueType + 1;
 
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            const GIntBig nTotalBlocks =
+                static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+            GDALDataset *poTSDS = nullptr;
+            const int nThreads = GDALRasterBandGetParallelReadDataset(
+                this, DIV_ROUND_UP(nTotalBlocks, nSampleRate), poTSDS);
+            if (nThreads > 1)
             {
-                const int iYBlock =
-                    static_cast<int>(iSampleBlock / nBlocksPerRow);
-                const int iXBlock =
-                    static_cast<int>(iSampleBlock % nBlocksPerRow);
+                struct IntegerStatsAccumulator
+                {
+                    GUInt32 nMin = 0;
+                    GUInt32 nMax = 0;
+                    GUIntBig nSum = 0;
+                    GUIntBig nSumSquare = 0;
+                    GUIntBig nSampleCount = 0;
+                    GUIntBig nValidCount = 0;
+                };
+
+                IntegerStatsAccumulator oInitAcc;
+                oInitAcc.nMin = nMaxValueType;
+                const auto ProcessBlock =
+                    [this, nMaxValueType,
+                     nNoDataValue](IntegerStatsAccumulator &oAcc,
+                                   const void *pData, const GByte *,
+                                   int nXCheck, int nYCheck)
+                {
+                    if (eDataType == GDT_Byte)
+                    {
+                        ComputeStatisticsInternal<
+                            GByte, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nBlockXSize, nYCheck,
+                              static_cast<const GByte *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              oAcc.nMin, oAcc.nMax, oAcc.nSum,
+                              oAcc.nSumSquare, oAcc.nSampleCount,
+                              oAcc.nValidCount);
+                    }
+                    else
+                    {
+                        ComputeStatisticsInternal<
+                            GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nBlockXSize, nYCheck,
+                              static_cast<const GUInt16 *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              oAcc.nMin, oAcc.nMax, oAcc.nSum,
+                              oAcc.nSumSquare, oAcc.nSampleCount,
+                              oAcc.nValidCount);
+                    }
+                };
+
+                std::vector<IntegerStatsAccumulator> aoAcc;
+                const CPLErr eErr = GDALRasterBandProcessBlocksInParallel(
+                    poTSDS, nBand, nThreads, /* bUseMask = */ false,
+                    nSampleRate, oInitAcc, ProcessBlock, aoAcc, pfnProgress,
+                    pProgressData, "Compute Statistics");
+                poTSDS->ReleaseRef();
+                if (eErr != CE_None)
+                    return eErr;
+
+                // Integer sums: the result is identical to the one of the
+                // sequential code path.
+                for (const auto &oAcc : aoAcc)
+                {
+                    nMin = std::min(nMin, oAcc.nMin);
+                    nMax = std::max(nMax, oAcc.nMax);
+                    nSum += oAcc.nSum;
+                    nSumSquare += oAcc.nSumSquare;
+                    nSampleCount += oAcc.nSampleCount;
+                    nValidCount += oAcc.nValidCount;
+                }
+            }
+            else
+            {
+                for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                     iSampleBlock += nSampleRate)
+                {
+                    const int iYBlock =
+                        static_cast<int>(iSampleBlock / nBlocksPerRow);
+                    const int iXBlock =
+                        static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
+                    GDALRasterBlock *const poBlock =
+                        GetLockedBlockRef(iXBlock, iYBlock);
+                    if (poBlock == nullptr)
+                        return CE_Failure;
 
-                void *const pData = poBlock->GetDataRef();
+                    void *const pData = poBlock->GetDataRef();
 
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+                    int nXCheck = 0, nYCheck = 0;
+                    GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                if (eDataType == GDT_Byte)
-                {
-                    ComputeStatisticsInternal<
-                        GByte, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
-                          static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
-                }
-                else
-                {
-                    ComputeStatisticsInternal<
-                        GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
-                          static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
-                }
+                    if (eDataType == GDT_Byte)
+                    {
+                        ComputeStatisticsInternal<
+                            GByte, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nBlockXSize, nYCheck,
+                              static_cast<const GByte *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              nMin, nMax, nSum, nSumSquare, nSampleCount,
+                              nValidCount);
+                    }
+                    else
+                    {
+                        ComputeStatisticsInternal<
+                            GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nBlockXSize, nYCheck,
+                              static_cast<const GUInt16 *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              nMin, nMax, nSum, nSumSquare, nSampleCount,
+                              nValidCount);
+                    }
 
-                poBlock->DropLock();
+                    poBlock->DropLock();
 
-                if (!pfnProgress(static_cast<double>(iSampleBlock) /
-                                     (static_cast<double>(nBlocksPerRow) *
-                                      nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
-                {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
-                    return CE_Failure;
+                    if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                                         static_cast<double>(nTotalBlocks),
+                                     "Compute Statistics", pProgressData))
+                    {
+                        ReportError(CE_Failure, CPLE_UserInterrupt,
+                                    "User terminated");
+                        return CE_Failure;
+                    }
                 }
             }
 
@@ -6885,100 +7212,131 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             return CE_Failure;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        const GIntBig nTotalBlocks =
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+        GDALDataset *poTSDS = nullptr;
+        const int nThreads = GDALRasterBandGetParallelReadDataset(
+            this, DIV_ROUND_UP(nTotalBlocks, nSampleRate), poTSDS);
+        if (nThreads > 1)
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
+            struct StatsAccumulator
             {
-                return CE_Failure;
+                double dfMin = std::numeric_limits<double>::infinity();
+                double dfMax = -std::numeric_limits<double>::infinity();
+                double dfMean = 0.0;
+                double dfM2 = 0.0;
+                GUIntBig nSampleCount = 0;
+                GUIntBig nValidCount = 0;
+            };
+
+            const auto ProcessBlock =
+                [this, bSignedByte,
+                 &sNoDataValues](StatsAccumulator &oAcc, const void *pData,
+                                 const GByte *pabyMaskData, int nXCheck,
+                                 int nYCheck)
+            {
+                ComputeStatisticsGenericBlock(
+                    pData, eDataType, bSignedByte, nXCheck, nYCheck,
+                    nBlockXSize, sNoDataValues, pabyMaskData, oAcc.dfMin,
+                    oAcc.dfMax, oAcc.dfMean, oAcc.dfM2, oAcc.nValidCount);
+                oAcc.nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+            };
+
+            std::vector<StatsAccumulator> aoAcc;
+            const CPLErr eErr = GDALRasterBandProcessBlocksInParallel(
+                poTSDS, nBand, nThreads, poMaskBand != nullptr, nSampleRate,
+                StatsAccumulator(), ProcessBlock, aoAcc, pfnProgress,
+                pProgressData, "Compute Statistics");
+            poTSDS->ReleaseRef();
+            if (eErr != CE_None)
+                return eErr;
+
+            // Merge the partial results in block order, using the pairwise
+            // update formulas of Chan et al. for the mean and sum of square
+            // of differences to the mean.
+            for (const auto &oAcc : aoAcc)
+            {
+                nSampleCount += oAcc.nSampleCount;
+                if (oAcc.nValidCount == 0)
+                    continue;
+                dfMin = std::min(dfMin, oAcc.dfMin);
+                dfMax = std::max(dfMax, oAcc.dfMax);
+                const GUIntBig nNewValidCount = nValidCount + oAcc.nValidCount;
+                const double dfDelta = oAcc.dfMean - dfMean;
+                dfMean += dfDelta * (static_cast<double>(oAcc.nValidCount) /
+                                     nNewValidCount);
+                dfM2 += oAcc.dfM2 + dfDelta * dfDelta *
+                                        static_cast<double>(nValidCount) *
+                                        (static_cast<double>(oAcc.nValidCount) /
+                                         nNewValidCount);
+                nValidCount = nNewValidCount;
             }
         }
-
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+        else
         {
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
             }
 
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
+            for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                 iSampleBlock += nSampleRate)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+                const int iYBlock =
+                    static_cast<int>(iSampleBlock / nBlocksPerRow);
+                const int iXBlock =
+                    static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-            void *const pData = poBlock->GetDataRef();
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
+                if (poMaskBand &&
+                    poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                                         iYBlock * nBlockYSize, nXCheck,
+                                         nYCheck, pabyMaskData, nXCheck,
+                                         nYCheck, GDT_Byte, 0, nBlockXSize,
+                                         nullptr) != CE_None)
                 {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
 
-                    bool bValid = true;
-                    double dfValue =
-                        GetPixelValue(eDataType, bSignedByte, pData, iOffset,
-                                      sNoDataValues, bValid);
+                GDALRasterBlock *const poBlock =
+                    GetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
 
-                    if (!bValid)
-                        continue;
+                ComputeStatisticsGenericBlock(
+                    poBlock->GetDataRef(), eDataType, bSignedByte, nXCheck,
+                    nYCheck, nBlockXSize, sNoDataValues, pabyMaskData, dfMin,
+                    dfMax, dfMean, dfM2, nValidCount);
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+                nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
 
-                    nValidCount++;
-                    if (dfMin == dfMax)
-                    {
-                        if (nValidCount == 1)
-                            dfMean = dfMin;
-                    }
-                    else
-                    {
-                        const double dfDelta = dfValue - dfMean;
-                        dfMean += dfDelta / nValidCount;
-                        dfM2 += dfDelta * (dfValue - dfMean);
-                    }
+                poBlock->DropLock();
+
+                if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                                     static_cast<double>(nTotalBlocks),
+                                 "Compute Statistics", pProgressData))
+                {
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
                 }
             }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
-
-            poBlock->DropLock();
-
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
-            {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+            CPLFree(pabyMaskData);
         }
-
-        CPLFree(pabyMaskData);
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -7381,6 +7739,11 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.12, the GDAL_NUM_THREADS configuration option can be
+ * set to a number of threads or ALL_CPUS to read and process blocks in
+ * parallel, when the dataset is opened in read-only mode and can be reopened
+ * in several threads (cf GDALGetThreadSafeDataset()).
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -7454,14 +7817,18 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
     GDALRasterIOExtraArg sExtraArg;
     INIT_RASTERIO_EXTRA_ARG(sExtraArg);
 
-    GUInt32 nMin = (eDataType == GDT_Byte)
-                       ? 255
-                       : 65535;  // used for GByte & GUInt16 cases
-    GUInt32 nMax = 0;            // used for GByte & GUInt16 cases
-    GInt16 nMinInt16 =
-        std::numeric_limits<GInt16>::max();  // used for GInt16 case
-    GInt16 nMaxInt16 =
-        std::numeric_limits<GInt16>::lowest();  // used for GInt16 case
+    struct MinMaxAccumulator
+    {
+        GUInt32 nMin = 0;  // used for GByte & GUInt16 cases
+        GUInt32 nMax = 0;  // used for GByte & GUInt16 cases
+        GInt16 nMinInt16 =
+            std::numeric_limits<GInt16>::max();  // used for GInt16 case
+        GInt16 nMaxInt16 =
+            std::numeric_limits<GInt16>::lowest();  // used for GInt16 case
+    };
+
+    MinMaxAccumulator oMinMax;
+    oMinMax.nMin = (eDataType == GDT_Byte) ? 255 : 65535;
     double dfMin =
         std::numeric_limits<double>::infinity();  // used for generic code path
     double dfMax =
@@ -7471,9 +7838,9 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, &sNoDataValues, &nMin, &nMax, &nMinInt16,
-         &nMaxInt16](const void *pData, int nXCheck, int nBufferWidth,
-                     int nYCheck)
+        [this, bSignedByte, &sNoDataValues](MinMaxAccumulator &oAcc,
+                                            const void *pData, int nXCheck,
+                                            int nBufferWidth, int nYCheck)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -7490,7 +7857,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  oAcc.nMin, oAcc.nMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -7507,7 +7875,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  oAcc.nMin, oAcc.nMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -7525,7 +7894,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &oAcc.nMinInt16,
+                        &oAcc.nMaxInt16);
                 }
             }
             else
@@ -7535,7 +7905,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &oAcc.nMinInt16, &oAcc.nMaxInt16);
                 }
             }
         }
@@ -7601,7 +7971,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(oMinMax, pData, nXReduced, nXReduced,
+                                  nYReduced);
         }
         else
         {
@@ -7639,11 +8010,83 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 nSampleRate += 1;
         }
 
-        if (bUseOptimizedPath)
+        const GIntBig nTotalBlocks =
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+        GDALDataset *poTSDS = nullptr;
+        const int nThreads = GDALRasterBandGetParallelReadDataset(
+            this, DIV_ROUND_UP(nTotalBlocks, nSampleRate), poTSDS);
+        if (nThreads > 1 && bUseOptimizedPath)
+        {
+            const auto ProcessBlock =
+                [this, bSignedByte,
+                 &ComputeMinMaxForBlock](MinMaxAccumulator &oAcc,
+                                         const void *pData, const GByte *,
+                                         int nXCheck, int nYCheck)
+            {
+                if (!(eDataType == GDT_Byte && !bSignedByte &&
+                      oAcc.nMin == 0 && oAcc.nMax == 255))
+                {
+                    ComputeMinMaxForBlock(oAcc, pData, nXCheck, nBlockXSize,
+                                          nYCheck);
+                }
+            };
+
+            std::vector<MinMaxAccumulator> aoAcc;
+            const CPLErr eErr = GDALRasterBandProcessBlocksInParallel(
+                poTSDS, nBand, nThreads, /* bUseMask = */ false, nSampleRate,
+                oMinMax, ProcessBlock, aoAcc, GDALDummyProgress, nullptr,
+                nullptr);
+            poTSDS->ReleaseRef();
+            if (eErr != CE_None)
+                return eErr;
+
+            for (const auto &oAcc : aoAcc)
+            {
+                oMinMax.nMin = std::min(oMinMax.nMin, oAcc.nMin);
+                oMinMax.nMax = std::max(oMinMax.nMax, oAcc.nMax);
+                oMinMax.nMinInt16 =
+                    std::min(oMinMax.nMinInt16, oAcc.nMinInt16);
+                oMinMax.nMaxInt16 =
+                    std::max(oMinMax.nMaxInt16, oAcc.nMaxInt16);
+            }
+        }
+        else if (nThreads > 1)
         {
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+            struct GenericMinMaxAccumulator
+            {
+                double dfMin = std::numeric_limits<double>::infinity();
+                double dfMax = -std::numeric_limits<double>::infinity();
+            };
+
+            const auto ProcessBlock =
+                [this, bSignedByte,
+                 &sNoDataValues](GenericMinMaxAccumulator &oAcc,
+                                 const void *pData, const GByte *pabyMaskData,
+                                 int nXCheck, int nYCheck)
+            {
+                ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXCheck,
+                                     nYCheck, nBlockXSize, sNoDataValues,
+                                     pabyMaskData, oAcc.dfMin, oAcc.dfMax);
+            };
+
+            std::vector<GenericMinMaxAccumulator> aoAcc;
+            const CPLErr eErr = GDALRasterBandProcessBlocksInParallel(
+                poTSDS, nBand, nThreads, poMaskBand != nullptr, nSampleRate,
+                GenericMinMaxAccumulator(), ProcessBlock, aoAcc,
+                GDALDummyProgress, nullptr, nullptr);
+            poTSDS->ReleaseRef();
+            if (eErr != CE_None)
+                return eErr;
+
+            for (const auto &oAcc : aoAcc)
+            {
+                dfMin = std::min(dfMin, oAcc.dfMin);
+                dfMax = std::max(dfMax, oAcc.dfMax);
+            }
+        }
+        else if (bUseOptimizedPath)
+        {
+            for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
                  iSampleBlock += nSampleRate)
             {
                 const int iYBlock =
@@ -7660,19 +8103,18 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 int nXCheck = 0, nYCheck = 0;
                 GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
+                ComputeMinMaxForBlock(oMinMax, pData, nXCheck, nBlockXSize,
+                                      nYCheck);
 
                 poBlock->DropLock();
 
-                if (eDataType == GDT_Byte && !bSignedByte && nMin == 0 &&
-                    nMax == 255)
+                if (eDataType == GDT_Byte && !bSignedByte &&
+                    oMinMax.nMin == 0 && oMinMax.nMax == 255)
                     break;
             }
         }
         else
         {
-            const GIntBig nTotalBlocks =
-                static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
             if (!ComputeMinMaxGenericIterBlocks(
                     this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
                     nBlocksPerRow, sNoDataValues, poMaskBand, dfMin, dfMax))
@@ -7686,13 +8128,13 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
     {
         if ((eDataType == GDT_Byte && !bSignedByte) || eDataType == GDT_UInt16)
         {
-            dfMin = nMin;
-            dfMax = nMax;
+            dfMin = oMinMax.nMin;
+            dfMax = oMinMax.nMax;
         }
         else if (eDataType == GDT_Int16)
         {
-            dfMin = nMinInt16;
-            dfMax = nMaxInt16;
+            dfMin = oMinMax.nMinInt16;
+            dfMax = oMinMax.nMaxInt16;
         }
     }
 
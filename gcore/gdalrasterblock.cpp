@@ -17,7 +17,9 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <cstring>
 #include <mutex>
 
@@ -30,21 +32,90 @@
 
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+static std::atomic<GIntBig> nCacheUsed{0};
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
+/************************************************************************/
+/*                         GDALRasterBlockShard                         */
+/************************************************************************/
+
+// The LRU list of cached blocks is split into several independent shards,
+// each protected by its own lock, so that threads touching or internalizing
+// blocks of different datasets/bands/blocks do not contend on a single
+// global lock. The GDAL_CACHEMAX budget remains global (nCacheUsed), and
+// eviction visits the shards in turn when it is exceeded.
+
+constexpr int MAX_SHARD_COUNT = 64;
+
+namespace
+{
+struct alignas(64) GDALRasterBlockShard
+{
+#if 0
+    CPLMutex *hLock = nullptr;
+#else
+    CPLLock *hLock = nullptr;
+#endif
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+};
+}  // namespace
+
+static GDALRasterBlockShard asShards[MAX_SHARD_COUNT];
+
+// Index of the shard from which the next eviction scan starts.
+static std::atomic<unsigned> nNextEvictionShard{0};
+
+/************************************************************************/
+/*                            GetShardCount()                           */
+/************************************************************************/
+
+static int GetShardCount()
+{
+    static const int nShardCount = []()
+    {
+        const char *pszShardCount =
+            CPLGetConfigOption("GDAL_RB_SHARD_COUNT", "AUTO");
+        int nCount = EQUAL(pszShardCount, "AUTO") ? CPLGetNumCPUs()
+                                                  : atoi(pszShardCount);
+        nCount = std::clamp(nCount, 1, MAX_SHARD_COUNT);
+        // Round up to a power of two to be able to mask the hash
+        int nPow2 = 1;
+        while (nPow2 < nCount)
+            nPow2 *= 2;
+        return nPow2;
+    }();
+    return nShardCount;
+}
+
+/************************************************************************/
+/*                              GetShard()                              */
+/************************************************************************/
+
+static GDALRasterBlockShard &GetShard(const GDALRasterBand *poBand, int nXOff,
+                                      int nYOff)
+{
+    const int nShardCount = GetShardCount();
+    if (nShardCount == 1)
+        return asShards[0];
+    uint64_t nHash = static_cast<uint64_t>(
+                         reinterpret_cast<std::uintptr_t>(poBand) >> 4) *
+                     UINT64_C(0x9E3779B97F4A7C15);
+    nHash ^= static_cast<uint64_t>(static_cast<unsigned>(nXOff)) *
+             UINT64_C(0xC2B2AE3D27D4EB4F);
+    nHash ^= static_cast<uint64_t>(static_cast<unsigned>(nYOff)) *
+             UINT64_C(0x165667B19E3779F9);
+    nHash ^= nHash >> 29;
+    return asShards[nHash & static_cast<unsigned>(nShardCount - 1)];
+}
+
 #if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
+#define INITIALIZE_LOCK(sShard) CPLMutexHolderD(&((sShard).hLock))
+#define TAKE_LOCK(sShard) CPLMutexHolderOptionalLockD((sShard).hLock)
+#define DESTROY_LOCK(sShard) CPLDestroyMutex((sShard).hLock)
 #else
 
-static CPLLock *hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 
@@ -75,14 +146,27 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+#define INITIALIZE_LOCK(sShard)                                                \
+    CPLLockHolderD(&((sShard).hLock), GetLockType());                          \
+    CPLLockSetDebugPerf((sShard).hLock, bDebugContention)
+#define TAKE_LOCK(sShard) CPLLockHolderOptionalLockD((sShard).hLock)
+#define DESTROY_LOCK(sShard) CPLDestroyLock((sShard).hLock)
 
 #endif
 
+/************************************************************************/
+/*                          InitializeShards()                          */
+/************************************************************************/
+
+static void InitializeShards()
+{
+    const int nShardCount = GetShardCount();
+    for (int i = 0; i < nShardCount; ++i)
+    {
+        INITIALIZE_LOCK(asShards[i]);
+    }
+}
+
 // #define ENABLE_DEBUG
 
 /************************************************************************/
@@ -221,9 +305,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
         flagSetupGDALGetCacheMax64,
         []()
         {
-            {
-                INITIALIZE_LOCK;
-            }
+            InitializeShards();
             bSleepsForBockCacheDebug =
                 CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
@@ -336,6 +418,10 @@ int CPL_STDCALL GDALFlushCacheBlock()
  * across zero or more GDALDataset objects in a global raster cache with
  * a least recently used (LRU) list and an upper cache limit (see
  * GDALSetCacheMax()) under which the cache size is normally kept.
+ * Starting with GDAL 3.12, the LRU list is split into several shards (see
+ * the GDAL_RB_SHARD_COUNT configuration option), each one protected by its
+ * own lock, so that concurrent accesses to different blocks scale with the
+ * number of threads. The cache limit remains global to all shards.
  *
  * Some blocks in the cache may be modified relative to the state on disk
  * (they are marked "Dirty") and must be flushed to disk before they can
@@ -377,11 +463,17 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
+    GDALRasterBlock *poTarget = nullptr;
 
+    const int nShardCount = GetShardCount();
+    const unsigned nStartShard = nNextEvictionShard++;
+    for (int iShard = 0; iShard < nShardCount && poTarget == nullptr;
+         ++iShard)
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        GDALRasterBlockShard &sShard =
+            asShards[(nStartShard + iShard) % nShardCount];
+        INITIALIZE_LOCK(sShard);
+        poTarget = sShard.poOldest;
 
         while (poTarget != nullptr)
         {
@@ -395,7 +487,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            continue;
 #ifndef __COVERITY__
         // Disabled to avoid complains about sleeping under locks, that
         // are only true for debug/testing code
@@ -412,6 +504,9 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
 
+    if (poTarget == nullptr)
+        return FALSE;
+
 #ifndef __COVERITY__
     // Disabled to avoid complains about sleeping under locks, that
     // are only true for debug/testing code
@@ -536,11 +631,11 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
       nXOff(nXOffIn), nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr),
       poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true)
 {
-    if (!hRBLock)
+    if (!asShards[0].hLock)
     {
         // Needed for scenarios where GDALAllRegister() is called after
         // GDALDestroyDriverManager()
-        INITIALIZE_LOCK;
+        InitializeShards();
     }
 
     CPLAssert(poBandIn != nullptr);
@@ -657,19 +752,20 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        TAKE_LOCK(GetShard(poBand, nXOff, nYOff));
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    GDALRasterBlockShard &sShard = GetShard(poBand, nXOff, nYOff);
+    if (sShard.poOldest == this)
+        sShard.poOldest = poPrevious;
 
-    if (poNewest == this)
+    if (sShard.poNewest == this)
     {
-        poNewest = poNext;
+        sShard.poNewest = poNext;
     }
 
     if (poPrevious != nullptr)
@@ -703,26 +799,33 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
-
-    if (poNewest != nullptr)
+    const int nShardCount = GetShardCount();
+    for (int iShard = 0; iShard < nShardCount; ++iShard)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        GDALRasterBlockShard &sShard = asShards[iShard];
+        TAKE_LOCK(sShard);
+
+        CPLAssert((sShard.poNewest == nullptr && sShard.poOldest == nullptr) ||
+                  (sShard.poNewest != nullptr && sShard.poOldest != nullptr));
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        if (sShard.poNewest != nullptr)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            CPLAssert(sShard.poNewest->poPrevious == nullptr);
+            CPLAssert(sShard.poOldest->poNext == nullptr);
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock *poLast = nullptr;
+            for (GDALRasterBlock *poBlock = sShard.poNewest;
+                 poBlock != nullptr; poBlock = poBlock->poNext)
+            {
+                CPLAssert(poBlock->poPrevious == poLast);
+                CPLAssert(&GetShard(poBlock->poBand, poBlock->nXOff,
+                                    poBlock->nYOff) == &sShard);
+
+                poLast = poBlock;
+            }
 
-        CPLAssert(poOldest == poLast);
+            CPLAssert(sShard.poOldest == poLast);
+        }
     }
 }
 
@@ -735,24 +838,27 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-         poBlock = poBlock->poNext)
+    for (int iShard = 0; iShard < GetShardCount(); ++iShard)
     {
-        if (poBlock->GetBand() == poBand)
+        TAKE_LOCK(asShards[iShard]);
+        for (GDALRasterBlock *poBlock = asShards[iShard].poNewest;
+             poBlock != nullptr; poBlock = poBlock->poNext)
         {
-            printf("Cache has still blocks of band %p\n", poBand); /*ok*/
-            printf("Band : %d\n", poBand->GetBand());              /*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
-            if (poBand->GetDataset())
-                printf("Dataset : %s\n", /*ok*/
-                       poBand->GetDataset()->GetDescription());
+            if (poBlock->GetBand() == poBand)
+            {
+                printf("Cache has still blocks of band %p\n", poBand); /*ok*/
+                printf("Band : %d\n", poBand->GetBand());              /*ok*/
+                printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
+                printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
+                int nBlockXSize, nBlockYSize;
+                poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
+                printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
+                printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
+                if (poBand->GetDataset())
+                    printf("Dataset : %s\n", /*ok*/
+                           poBand->GetDataset()->GetDescription());
+            }
         }
     }
 }
@@ -809,32 +915,36 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    GDALRasterBlockShard &sShard = GetShard(poBand, nXOff, nYOff);
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (sShard.poNewest == this)
         return;
 
-    TAKE_LOCK;
+    TAKE_LOCK(sShard);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    GDALRasterBlockShard &sShard = GetShard(poBand, nXOff, nYOff);
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    if (sShard.poNewest == this)
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if (poOldest == this)
-        poOldest = this->poPrevious;
+    if (sShard.poOldest == this)
+        sShard.poOldest = this->poPrevious;
 
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
@@ -843,19 +953,19 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = sShard.poNewest;
 
-    if (poNewest != nullptr)
+    if (sShard.poNewest != nullptr)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        poNewest->poPrevious = this;
+        CPLAssert(sShard.poNewest->poPrevious == nullptr);
+        sShard.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    sShard.poNewest = this;
 
-    if (poOldest == nullptr)
+    if (sShard.poOldest == nullptr)
     {
         CPLAssert(poPrevious == nullptr && poNext == nullptr);
-        poOldest = this;
+        sShard.poOldest = this;
     }
 #ifdef ENABLE_DEBUG
     Verify();
@@ -884,7 +994,7 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
+    // This call will initialize the shard locks. Other call places can
     // only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
@@ -897,81 +1007,70 @@ CPLErr GDALRasterBlock::Internalize()
     bool bFirstIter = true;
     bool bLoopAgain = false;
     GDALDataset *poThisDS = poBand->GetDataset();
+    const int nShardCount = GetShardCount();
     do
     {
         bLoopAgain = false;
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
+
+        if (bFirstIter)
+            nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
+
+        // Visit the shards in turn, starting from a rotating one so that
+        // eviction pressure is spread evenly among them.
+        // In the first pass, only discard clean blocks and dirty blocks of
+        // this dataset. We do this to decrease significantly the likelihood
+        // of the following weakness of the block cache design:
+        // 1. Thread 1 fills block B with ones
+        // 2. Thread 2 evicts this dirty block, while thread 1 almost
+        //    at the same time (but slightly after) tries to reacquire
+        //    this block. As it has been removed from the block cache
+        //    array/set, thread 1 now tries to read block B from disk,
+        //    so gets the old value.
+        // The second pass accepts evicting dirty blocks of other datasets.
+        const unsigned nStartShard = nNextEvictionShard++;
+        for (int iPass = 0; iPass < 2 && !bLoopAgain &&
+                            nBlocksToFree < 64 && nCacheUsed > nCurCacheMax;
+             ++iPass)
         {
-            TAKE_LOCK;
+            if (iPass == 1 && nDisableDirtyBlockFlushCounter != 0)
+                break;
 
-            if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while (nCacheUsed > nCurCacheMax)
+            for (int iShard = 0;
+                 iShard < nShardCount && !bLoopAgain && nBlocksToFree < 64 &&
+                 nCacheUsed > nCurCacheMax;
+                 ++iShard)
             {
-                GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
-                // In this first pass, only discard dirty blocks of this
-                // dataset. We do this to decrease significantly the likelihood
-                // of the following weakness of the block cache design:
-                // 1. Thread 1 fills block B with ones
-                // 2. Thread 2 evicts this dirty block, while thread 1 almost
-                //    at the same time (but slightly after) tries to reacquire
-                //    this block. As it has been removed from the block cache
-                //    array/set, thread 1 now tries to read block B from disk,
-                //    so gets the old value.
-                while (poTarget != nullptr)
+                GDALRasterBlockShard &sShard =
+                    asShards[(nStartShard + iShard) % nShardCount];
+                TAKE_LOCK(sShard);
+
+                GDALRasterBlock *poTarget = sShard.poOldest;
+                while (nCacheUsed > nCurCacheMax)
                 {
-                    if (!poTarget->GetDirty())
-                    {
-                        if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount),
-                                                        0, -1))
-                            break;
-                    }
-                    else if (nDisableDirtyBlockFlushCounter == 0)
+                    while (poTarget != nullptr)
                     {
-                        if (poTarget->poBand->GetDataset() == poThisDS)
+                        if (!poTarget->GetDirty() || iPass == 1 ||
+                            (nDisableDirtyBlockFlushCounter == 0 &&
+                             poTarget->poBand->GetDataset() == poThisDS))
                         {
                             if (CPLAtomicCompareAndExchange(
                                     &(poTarget->nLockCount), 0, -1))
                                 break;
                         }
-                        else if (poDirtyBlockOtherDataset == nullptr)
-                        {
-                            poDirtyBlockOtherDataset = poTarget;
-                        }
+                        poTarget = poTarget->poPrevious;
                     }
-                    poTarget = poTarget->poPrevious;
-                }
-                if (poTarget == nullptr && poDirtyBlockOtherDataset)
-                {
-                    if (CPLAtomicCompareAndExchange(
-                            &(poDirtyBlockOtherDataset->nLockCount), 0, -1))
+
+                    if (poTarget == nullptr)
+                        break;
+
+                    if (iPass == 1 && poTarget->GetDirty())
                     {
                         CPLDebug("GDAL",
                                  "Evicting dirty block of another dataset");
-                        poTarget = poDirtyBlockOtherDataset;
-                    }
-                    else
-                    {
-                        poTarget = poOldest;
-                        while (poTarget != nullptr)
-                        {
-                            if (CPLAtomicCompareAndExchange(
-                                    &(poTarget->nLockCount), 0, -1))
-                            {
-                                CPLDebug(
-                                    "GDAL",
-                                    "Evicting dirty block of another dataset");
-                                break;
-                            }
-                            poTarget = poTarget->poPrevious;
-                        }
                     }
-                }
 
-                if (poTarget != nullptr)
-                {
 #ifndef __COVERITY__
                     // Disabled to avoid complains about sleeping under locks,
                     // that are only true for debug/testing code
@@ -1006,19 +1105,14 @@ CPLErr GDALRasterBlock::Internalize()
 
                     poTarget = _poPrevious;
                 }
-                else
-                {
-                    break;
-                }
             }
+        }
 
-            /* ------------------------------------------------------------------
-             */
-            /*      Add this block to the list. */
-            /* ------------------------------------------------------------------
-             */
-            if (!bLoopAgain)
-                Touch_unlocked();
+        // Add this block to the list.
+        if (!bLoopAgain)
+        {
+            TAKE_LOCK(GetShard(poBand, nXOff, nYOff));
+            Touch_unlocked();
         }
 
         bFirstIter = false;
@@ -1129,9 +1223,12 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for (auto &sShard : asShards)
+    {
+        if (sShard.hLock != nullptr)
+            DESTROY_LOCK(sShard);
+        sShard.hLock = nullptr;
+    }
 }
 
 /*! @endcond */
@@ -1214,7 +1311,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(GetShard(poBand, nXOff, nYOff));
 
     return FALSE;
 }
@@ -1223,14 +1320,17 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    for( int iShard = 0; iShard < GetShardCount(); ++iShard )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( GDALRasterBlock *poBlock = asShards[iShard].poNewest;
+             poBlock != nullptr;
+             poBlock = poBlock->poNext )
+        {
+            printf("Block %d\n", iBlock);/*ok*/
+            poBlock->DumpBlock();
+            printf("\n");/*ok*/
+            iBlock++;
+        }
     }
 }
 
@@ -4655,6 +4655,9 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
 
         GDALRasterBand *poDstBand = nullptr;
 
+        // Whether this is the last job submitted for a source chunk
+        bool bLastJobOfChunk = false;
+
         // Input parameters of pfnResampleFn
         GDALResampleFunction pfnResampleFn = nullptr;
         int nSrcWidth = 0;
@@ -4749,9 +4752,13 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
             poJob->eDstBufferDataType, 0, 0, nullptr);
     };
 
+    // Number of source chunks whose resampling jobs are not all finalized
+    int nChunksInFlight = 0;
+
     // Wait for completion of oldest job and serialize it
     const auto WaitAndFinalizeOldestJob =
-        [WriteJobData](std::list<std::unique_ptr<OvrJob>> &jobList)
+        [WriteJobData,
+         &nChunksInFlight](std::list<std::unique_ptr<OvrJob>> &jobList)
     {
         auto poOldestJob = jobList.front().get();
         poOldestJob->WaitFinished();
@@ -4760,6 +4767,8 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
         {
             l_eErr = WriteJobData(poOldestJob);
         }
+        if (poOldestJob->bLastJobOfChunk)
+            --nChunksInFlight;
 
         jobList.pop_front();
         return l_eErr;
@@ -4817,19 +4826,14 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
             auto poOldestJob = jobList.front().get();
             if (!poOldestJob->IsFinished())
                 break;
-            eErr = poOldestJob->eErr;
-            if (eErr == CE_None)
-            {
-                eErr = WriteJobData(poOldestJob);
-            }
-
-            jobList.pop_front();
+            eErr = WaitAndFinalizeOldestJob(jobList);
         }
 
         // And in case we have saturated the number of threads,
         // wait for completion of tasks to go below the threshold.
-        while (eErr == CE_None &&
-               jobList.size() >= static_cast<size_t>(nThreads))
+        // The limit is expressed in source chunks, which bounds memory
+        // usage, while the jobs of a chunk can be spread over all threads.
+        while (eErr == CE_None && nChunksInFlight >= nThreads)
         {
             eErr = WaitAndFinalizeOldestJob(jobList);
         }
@@ -4974,6 +4978,7 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
             std::make_shared<PointerHolder>(poJobQueue ? pChunk : nullptr);
         auto oSrcMaskBufferHolder = std::make_shared<PointerHolder>(
             poJobQueue ? pabyChunkNodataMask : nullptr);
+        bool bJobSubmittedForChunk = false;
 
         for (int iOverview = 0; iOverview < nOverviewCount && eErr == CE_None;
              ++iOverview)
@@ -5013,59 +5018,124 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
                      nDstWidth, nDstYOff2 - nDstYOff);
 #endif
 
-            auto poJob = std::make_unique<OvrJob>();
-            poJob->pfnResampleFn = pfnResampleFn;
-            poJob->bUseGenericResampleFn = bUseGenericResampleFn;
-            poJob->args.eOvrDataType = poDstBand->GetRasterDataType();
-            poJob->args.nOvrXSize = poDstBand->GetXSize();
-            poJob->args.nOvrYSize = poDstBand->GetYSize();
-            const char *pszNBITS =
-                poDstBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
-            poJob->args.nOvrNBITS = pszNBITS ? atoi(pszNBITS) : 0;
-            poJob->args.dfXRatioDstToSrc = dfXRatioDstToSrc;
-            poJob->args.dfYRatioDstToSrc = dfYRatioDstToSrc;
-            poJob->args.eWrkDataType = eWrkDataType;
-            poJob->pChunk = pChunk;
-            poJob->args.pabyChunkNodataMask = pabyChunkNodataMask;
-            poJob->nSrcWidth = nWidth;
-            poJob->nSrcHeight = nHeight;
-            poJob->args.nChunkXOff = 0;
-            poJob->args.nChunkXSize = nWidth;
-            poJob->args.nChunkYOff = nChunkYOffQueried;
-            poJob->args.nChunkYSize = nChunkYSizeQueried;
-            poJob->nDstWidth = nDstWidth;
-            poJob->args.nDstXOff = 0;
-            poJob->args.nDstXOff2 = nDstWidth;
-            poJob->args.nDstYOff = nDstYOff;
-            poJob->args.nDstYOff2 = nDstYOff2;
-            poJob->poDstBand = poDstBand;
-            poJob->args.pszResampling = pszResampling;
-            poJob->args.bHasNoData = bHasNoData;
-            poJob->args.dfNoDataValue = dfNoDataValue;
-            poJob->args.poColorTable = poColorTable;
-            poJob->args.eSrcDataType = eSrcDataType;
-            poJob->args.bPropagateNoData = bPropagateNoData;
-
+            // When using threads, split the destination lines of the chunk
+            // into several slices, so that the resampling of a single
+            // (possibly large) chunk is spread over all worker threads,
+            // while the main thread reads the next chunk.
+            const int nDstLines = nDstYOff2 - nDstYOff;
+            int nSlices = 1;
             if (poJobQueue)
             {
-                poJob->SetSrcMaskBufferHolder(oSrcMaskBufferHolder);
-                poJob->SetSrcBufferHolder(oSrcBufferHolder);
-                poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
-                jobList.emplace_back(std::move(poJob));
+                constexpr int MIN_PIXELS_PER_SLICE = 65536;
+                nSlices = static_cast<int>(std::max<GIntBig>(
+                    1, std::min<GIntBig>(std::min(nThreads, nDstLines),
+                                         static_cast<GIntBig>(nDstLines) *
+                                             nDstWidth /
+                                             MIN_PIXELS_PER_SLICE)));
             }
-            else
+            // Margin, in source lines, around the source window strictly
+            // needed by a slice, so that it is always a superset of the lines
+            // that the resampling function uses.
+            const int nSliceSrcMargin =
+                (nKernelRadius + 2) *
+                static_cast<int>(std::ceil(dfYRatioDstToSrc));
+
+            for (int iSlice = 0; iSlice < nSlices && eErr == CE_None;
+                 ++iSlice)
             {
-                JobResampleFunc(poJob.get());
-                eErr = poJob->eErr;
-                if (eErr == CE_None)
+                const int nSliceDstYOff =
+                    nDstYOff + static_cast<int>(
+                                   static_cast<GIntBig>(nDstLines) * iSlice /
+                                   nSlices);
+                const int nSliceDstYOff2 =
+                    nDstYOff + static_cast<int>(
+                                   static_cast<GIntBig>(nDstLines) *
+                                   (iSlice + 1) / nSlices);
+
+                int nSliceChunkYOff = nChunkYOffQueried;
+                int nSliceChunkYSize = nChunkYSizeQueried;
+                if (nSlices > 1)
                 {
-                    eErr = WriteJobData(poJob.get());
+                    nSliceChunkYOff = std::max(
+                        nChunkYOffQueried,
+                        static_cast<int>(std::floor(nSliceDstYOff *
+                                                    dfYRatioDstToSrc)) -
+                            nSliceSrcMargin);
+                    nSliceChunkYSize =
+                        std::min(nChunkYOffQueried + nChunkYSizeQueried,
+                                 static_cast<int>(std::ceil(
+                                     nSliceDstYOff2 * dfYRatioDstToSrc)) +
+                                     nSliceSrcMargin) -
+                        nSliceChunkYOff;
+                }
+                const size_t nSliceSrcOffset =
+                    static_cast<size_t>(nSliceChunkYOff - nChunkYOffQueried) *
+                    nWidth;
+
+                auto poJob = std::make_unique<OvrJob>();
+                poJob->pfnResampleFn = pfnResampleFn;
+                poJob->bUseGenericResampleFn = bUseGenericResampleFn;
+                poJob->args.eOvrDataType = poDstBand->GetRasterDataType();
+                poJob->args.nOvrXSize = poDstBand->GetXSize();
+                poJob->args.nOvrYSize = poDstBand->GetYSize();
+                const char *pszNBITS =
+                    poDstBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+                poJob->args.nOvrNBITS = pszNBITS ? atoi(pszNBITS) : 0;
+                poJob->args.dfXRatioDstToSrc = dfXRatioDstToSrc;
+                poJob->args.dfYRatioDstToSrc = dfYRatioDstToSrc;
+                poJob->args.eWrkDataType = eWrkDataType;
+                poJob->pChunk = static_cast<const GByte *>(pChunk) +
+                                nSliceSrcOffset *
+                                    GDALGetDataTypeSizeBytes(eWrkDataType);
+                poJob->args.pabyChunkNodataMask =
+                    pabyChunkNodataMask ? pabyChunkNodataMask + nSliceSrcOffset
+                                        : nullptr;
+                poJob->nSrcWidth = nWidth;
+                poJob->nSrcHeight = nHeight;
+                poJob->args.nChunkXOff = 0;
+                poJob->args.nChunkXSize = nWidth;
+                poJob->args.nChunkYOff = nSliceChunkYOff;
+                poJob->args.nChunkYSize = nSliceChunkYSize;
+                poJob->nDstWidth = nDstWidth;
+                poJob->args.nDstXOff = 0;
+                poJob->args.nDstXOff2 = nDstWidth;
+                poJob->args.nDstYOff = nSliceDstYOff;
+                poJob->args.nDstYOff2 = nSliceDstYOff2;
+                poJob->poDstBand = poDstBand;
+                poJob->args.pszResampling = pszResampling;
+                poJob->args.bHasNoData = bHasNoData;
+                poJob->args.dfNoDataValue = dfNoDataValue;
+                poJob->args.poColorTable = poColorTable;
+                poJob->args.eSrcDataType = eSrcDataType;
+                poJob->args.bPropagateNoData = bPropagateNoData;
+
+                if (poJobQueue)
+                {
+                    poJob->SetSrcMaskBufferHolder(oSrcMaskBufferHolder);
+                    poJob->SetSrcBufferHolder(oSrcBufferHolder);
+                    poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
+                    jobList.emplace_back(std::move(poJob));
+                    bJobSubmittedForChunk = true;
+                }
+                else
+                {
+                    JobResampleFunc(poJob.get());
+                    eErr = poJob->eErr;
+                    if (eErr == CE_None)
+                    {
+                        eErr = WriteJobData(poJob.get());
+                    }
                 }
             }
         }
 
         if (poJobQueue)
         {
+            if (bJobSubmittedForChunk)
+            {
+                jobList.back()->bLastJobOfChunk = true;
+                ++nChunksInFlight;
+            }
             pChunk = nullptr;
             pabyChunkNodataMask = nullptr;
         }
@@ -16,7 +16,9 @@
 
 #include "ogrsf_frmts.h"
 
+#include <memory>
 #include <set>
+#include <string>
 
 typedef enum
 {
@@ -82,6 +84,9 @@ class OGRCSVLayer final : public IOGRCSVLayer, public OGRLayer
     bool bHasFieldNames = false;
 
     OGRFeature *GetNextUnfilteredFeature();
+    OGRFeature *TranslateFeature(char **papszTokens, int64_t nFID,
+                                 bool &bWarningBadTypeOrWidthInOut,
+                                 std::string *posWarningBadTypeOrWidth) const;
 
     bool bNew = false;
     bool bInWriteMode = false;
@@ -136,6 +141,18 @@ class OGRCSVLayer final : public IOGRCSVLayer, public OGRLayer
 
     char **GetNextLineTokens();
 
+    // Parallel implementation of GetNextArrowArray()
+    struct ArrowArrayReader;
+    std::unique_ptr<ArrowArrayReader> m_poArrowArrayReader{};
+    bool m_bArrowArrayReaderFallback = false;
+
+    bool CanUseParallelGetNextArrowArray() const;
+    bool FillArrowArrayFromRecords(const std::string &osRecords,
+                                   int64_t nFirstFID, int nRecords,
+                                   struct ArrowArray *out_array,
+                                   std::string &osWarningBadTypeOrWidth) const;
+    void SubmitArrowArrayJobs();
+
     static bool Matches(const char *pszFieldName, char **papszPossibleNames);
 
     CPL_DISALLOW_COPY_ASSIGN(OGRCSVLayer)
@@ -223,6 +240,9 @@ class OGRCSVLayer final : public IOGRCSVLayer, public OGRLayer
 
     int TestCapability(const char *) override;
 
+    int GetNextArrowArray(struct ArrowArrayStream *,
+                          struct ArrowArray *out_array) override;
+
     virtual OGRErr CreateField(const OGRFieldDefn *poField,
                                int bApproxOK = TRUE) override;
 
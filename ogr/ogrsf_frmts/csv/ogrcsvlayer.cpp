@@ -25,16 +25,22 @@
 #endif
 #include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_csv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -42,6 +48,8 @@
 #include "ogr_p.h"
 #include "ogr_spatialref.h"
 #include "ogrsf_frmts.h"
+#include "ograrrowarrayhelper.h"
+#include "ogrlayerarrow.h"
 
 #define DIGIT_ZERO '0'
 
@@ -1238,6 +1246,9 @@ char **OGRCSVLayer::AutodetectFieldTypes(CSLConstList papszOpenOptions,
 OGRCSVLayer::~OGRCSVLayer()
 
 {
+    // Wait for pending jobs of GetNextArrowArray() before anything else
+    m_poArrowArrayReader.reset();
+
     if (m_nFeaturesRead > 0)
     {
         CPLDebug("CSV", "%d features read on layer '%s'.",
@@ -1264,6 +1275,9 @@ OGRCSVLayer::~OGRCSVLayer()
 void OGRCSVLayer::ResetReading()
 
 {
+    m_poArrowArrayReader.reset();
+    m_bArrowArrayReaderFallback = false;
+
     if (fpCSV)
         VSIRewindL(fpCSV);
 
@@ -1341,6 +1355,50 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
     if (papszTokens == nullptr)
         return nullptr;
 
+    OGRFeature *poFeature = TranslateFeature(papszTokens, m_nNextFID,
+                                             bWarningBadTypeOrWidth, nullptr);
+
+    CSLDestroy(papszTokens);
+
+    if ((m_nNextFID % 100000) == 0)
+    {
+        CPLDebug("CSV", "FID = %" PRId64 ", file offset = %" PRIu64, m_nNextFID,
+                 static_cast<uint64_t>(fpCSV->Tell()));
+    }
+
+    m_nNextFID++;
+
+    m_nFeaturesRead++;
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                          TranslateFeature()                          */
+/*                                                                      */
+/*      Build a feature from the tokens of a record. The state of the   */
+/*      layer is not modified, so that this can be called from worker   */
+/*      threads. The warning about invalid values or too large widths   */
+/*      is emitted only if bWarningBadTypeOrWidthInOut is false, or     */
+/*      stored in *posWarningBadTypeOrWidth when it is not null.        */
+/************************************************************************/
+
+OGRFeature *
+OGRCSVLayer::TranslateFeature(char **papszTokens, int64_t nFID,
+                              bool &bWarningBadTypeOrWidthInOut,
+                              std::string *posWarningBadTypeOrWidth) const
+{
+    const auto EmitWarningBadTypeOrWidth =
+        [&bWarningBadTypeOrWidthInOut, posWarningBadTypeOrWidth](
+            const std::string &osMsg)
+    {
+        bWarningBadTypeOrWidthInOut = true;
+        if (posWarningBadTypeOrWidth)
+            *posWarningBadTypeOrWidth = osMsg;
+        else
+            CPLError(CE_Warning, CPLE_AppDefined, "%s", osMsg.c_str());
+    };
+
     // Create the OGR feature.
     OGRFeature *poFeature = new OGRFeature(poFeatureDefn);
 
@@ -1447,29 +1505,31 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
         const OGRFieldType eFieldType = poFieldDefn->GetType();
         const OGRFieldSubType eFieldSubType = poFieldDefn->GetSubType();
 
-        const auto WarnOnceBadValue = [this, poFieldDefn]()
+        const auto WarnOnceBadValue =
+            [&bWarningBadTypeOrWidthInOut, &EmitWarningBadTypeOrWidth, nFID,
+             poFieldDefn]()
         {
-            if (!bWarningBadTypeOrWidth)
+            if (!bWarningBadTypeOrWidthInOut)
             {
-                bWarningBadTypeOrWidth = true;
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "Invalid value type found in record %" PRId64
-                         " for field %s. "
-                         "This warning will no longer be emitted",
-                         m_nNextFID, poFieldDefn->GetNameRef());
+                EmitWarningBadTypeOrWidth(
+                    CPLSPrintf("Invalid value type found in record %" PRId64
+                               " for field %s. "
+                               "This warning will no longer be emitted",
+                               nFID, poFieldDefn->GetNameRef()));
             };
         };
 
-        const auto WarnTooLargeWidth = [this, poFieldDefn]()
+        const auto WarnTooLargeWidth =
+            [&bWarningBadTypeOrWidthInOut, &EmitWarningBadTypeOrWidth, nFID,
+             poFieldDefn]()
         {
-            if (!bWarningBadTypeOrWidth)
+            if (!bWarningBadTypeOrWidthInOut)
             {
-                bWarningBadTypeOrWidth = true;
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "Value with a width greater than field width "
-                         "found in record %" PRId64 " for field %s. "
-                         "This warning will no longer be emitted",
-                         m_nNextFID, poFieldDefn->GetNameRef());
+                EmitWarningBadTypeOrWidth(
+                    CPLSPrintf("Value with a width greater than field width "
+                               "found in record %" PRId64 " for field %s. "
+                               "This warning will no longer be emitted",
+                               nFID, poFieldDefn->GetNameRef()));
             };
         };
 
@@ -1505,7 +1565,7 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                 if (endptr == papszTokens[iAttr] + strlen(papszTokens[iAttr]))
                 {
                     poFeature->SetField(iOGRField, nVal);
-                    if (!bWarningBadTypeOrWidth &&
+                    if (!bWarningBadTypeOrWidthInOut &&
                         poFieldDefn->GetWidth() > 0 &&
                         static_cast<int>(strlen(papszTokens[iAttr])) >
                             poFieldDefn->GetWidth())
@@ -1532,14 +1592,14 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                 if (endptr == papszTokens[iAttr] + strlen(papszTokens[iAttr]))
                 {
                     poFeature->SetField(iOGRField, dfVal);
-                    if (!bWarningBadTypeOrWidth &&
+                    if (!bWarningBadTypeOrWidthInOut &&
                         poFieldDefn->GetWidth() > 0 &&
                         static_cast<int>(strlen(papszTokens[iAttr])) >
                             poFieldDefn->GetWidth())
                     {
                         WarnTooLargeWidth();
                     }
-                    else if (!bWarningBadTypeOrWidth &&
+                    else if (!bWarningBadTypeOrWidthInOut &&
                              poFieldDefn->GetWidth() > 0)
                     {
                         const char *pszDot = strchr(papszTokens[iAttr], '.');
@@ -1549,13 +1609,12 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                                 : 0;
                         if (nPrecision > poFieldDefn->GetPrecision())
                         {
-                            bWarningBadTypeOrWidth = true;
-                            CPLError(CE_Warning, CPLE_AppDefined,
-                                     "Value with a precision greater than "
-                                     "field precision found in record %" PRId64
-                                     " for field %s. "
-                                     "This warning will no longer be emitted",
-                                     m_nNextFID, poFieldDefn->GetNameRef());
+                            EmitWarningBadTypeOrWidth(CPLSPrintf(
+                                "Value with a precision greater than "
+                                "field precision found in record %" PRId64
+                                " for field %s. "
+                                "This warning will no longer be emitted",
+                                nFID, poFieldDefn->GetNameRef()));
                         }
                     }
                 }
@@ -1570,7 +1629,7 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
             if (papszTokens[iAttr][0] != '\0' && !poFieldDefn->IsIgnored())
             {
                 poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                if (!bWarningBadTypeOrWidth &&
+                if (!bWarningBadTypeOrWidthInOut &&
                     !poFeature->IsFieldSetAndNotNull(iOGRField))
                 {
                     WarnOnceBadValue();
@@ -1586,7 +1645,8 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
             else
             {
                 poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                if (!bWarningBadTypeOrWidth && poFieldDefn->GetWidth() > 0 &&
+                if (!bWarningBadTypeOrWidthInOut &&
+                    poFieldDefn->GetWidth() > 0 &&
                     static_cast<int>(strlen(papszTokens[iAttr])) >
                         poFieldDefn->GetWidth())
                 {
@@ -1715,18 +1775,8 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
         }
     }
 
-    CSLDestroy(papszTokens);
-
-    if ((m_nNextFID % 100000) == 0)
-    {
-        CPLDebug("CSV", "FID = %" PRId64 ", file offset = %" PRIu64, m_nNextFID,
-                 static_cast<uint64_t>(fpCSV->Tell()));
-    }
-
     // Translate the record id.
-    poFeature->SetFID(m_nNextFID++);
-
-    m_nFeaturesRead++;
+    poFeature->SetFID(nFID);
 
     return poFeature;
 }
@@ -1758,6 +1808,664 @@ OGRFeature *OGRCSVLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                          OGRCSVScanRecord()                          */
+/************************************************************************/
+
+namespace
+{
+enum class OGRCSVScanStatus
+{
+    RECORD,          // a complete record has been found
+    NEED_MORE_DATA,  // more bytes are needed to find the end of the record
+    END,             // no more record
+    UNHANDLED,       // record must be read through CSVReadParseLine3L()
+};
+}  // namespace
+
+// Finds the end of the record starting at pabyData, using the same rules
+// as CSVReadParseLine3L() when double quotes are honoured: lines end with
+// CR, LF, CRLF or LFCR, a leading UTF-8 BOM is skipped, and a record spans
+// several lines as long as a quoted string is not closed.
+// Records on which CSVReadParseLine3L() would emit an error (line longer
+// than nMaxLineSize, unbalanced double quotes at end of file) or that contain
+// a nul character are reported as UNHANDLED.
+static OGRCSVScanStatus OGRCSVScanRecord(const char *pabyData, size_t nSize,
+                                         bool bEOF, char chDelimiter,
+                                         int nMaxLineSize, size_t &nRecordSize,
+                                         bool &bEmptyRecord)
+{
+    if (nSize == 0)
+        return bEOF ? OGRCSVScanStatus::END : OGRCSVScanStatus::NEED_MORE_DATA;
+
+    size_t i = 0;
+    if (static_cast<GByte>(pabyData[0]) == 0xEF)
+    {
+        if (nSize < 3 && !bEOF)
+            return OGRCSVScanStatus::NEED_MORE_DATA;
+        if (nSize >= 3 && static_cast<GByte>(pabyData[1]) == 0xBB &&
+            static_cast<GByte>(pabyData[2]) == 0xBF)
+        {
+            i = 3;
+        }
+    }
+    const size_t nContentStart = i;
+    const size_t nMaxLineLength =
+        nMaxLineSize > 0 ? static_cast<size_t>(nMaxLineSize)
+                         : std::numeric_limits<size_t>::max();
+    size_t nLineStart = 0;
+    bool bInString = false;
+    // Previous character of the record, once its lines are joined with LF
+    char chPrev = 0;
+
+    while (true)
+    {
+        if (i == nSize)
+        {
+            if (!bEOF)
+                return OGRCSVScanStatus::NEED_MORE_DATA;
+            if (bInString || i - nLineStart >= nMaxLineLength)
+                return OGRCSVScanStatus::UNHANDLED;
+            nRecordSize = i;
+            bEmptyRecord = (nLineStart == 0 && i == nContentStart);
+            return OGRCSVScanStatus::RECORD;
+        }
+
+        const char ch = pabyData[i];
+        if (ch == '\r' || ch == '\n')
+        {
+            if (i - nLineStart >= nMaxLineLength)
+                return OGRCSVScanStatus::UNHANDLED;
+            size_t nNextLineStart = i + 1;
+            if (i + 1 == nSize)
+            {
+                if (!bEOF)
+                    return OGRCSVScanStatus::NEED_MORE_DATA;
+            }
+            else if ((ch == '\r' && pabyData[i + 1] == '\n') ||
+                     (ch == '\n' && pabyData[i + 1] == '\r'))
+            {
+                nNextLineStart = i + 2;
+            }
+            if (!bInString)
+            {
+                nRecordSize = nNextLineStart;
+                bEmptyRecord = (nLineStart == 0 && i == nContentStart);
+                return OGRCSVScanStatus::RECORD;
+            }
+            chPrev = '\n';
+            nLineStart = nNextLineStart;
+            i = nNextLineStart;
+            continue;
+        }
+        else if (ch == '\0')
+        {
+            return OGRCSVScanStatus::UNHANDLED;
+        }
+        else if (ch == '"')
+        {
+            if (!bInString)
+            {
+                // A quoted string only starts at the beginning of a field
+                if (i == nContentStart || chPrev == chDelimiter)
+                    bInString = true;
+            }
+            else if (i + 1 == nSize && !bEOF)
+            {
+                return OGRCSVScanStatus::NEED_MORE_DATA;
+            }
+            else if (i + 1 < nSize && pabyData[i + 1] == '"')
+            {
+                // Escaped double quote
+                ++i;
+            }
+            else
+            {
+                bInString = false;
+            }
+        }
+        chPrev = ch;
+        ++i;
+    }
+}
+
+/************************************************************************/
+/*                         ArrowArrayReader                             */
+/************************************************************************/
+
+// Target size of the records processed by a job of the parallel
+// implementation of GetNextArrowArray().
+constexpr size_t CSV_ARROW_JOB_SIZE = 4 * 1024 * 1024;
+
+// Minimum size of the reads done by the thread consuming the stream.
+constexpr size_t CSV_ARROW_READ_SIZE = 1024 * 1024;
+
+struct OGRCSVLayer::ArrowArrayReader
+{
+    struct Job
+    {
+        std::string osRecords{};
+        int64_t nFirstFID = 0;
+        int nRecords = 0;
+        struct ArrowArray sArray;
+        CPLErrorAccumulator oErrorAccumulator{};
+        std::string osWarningBadTypeOrWidth{};
+        bool bSuccess = false;
+        bool bFinished = false;
+
+        Job()
+        {
+            memset(&sArray, 0, sizeof(sArray));
+        }
+
+        ~Job()
+        {
+            if (sArray.release)
+                sArray.release(&sArray);
+        }
+
+        CPL_DISALLOW_COPY_ASSIGN(Job)
+    };
+
+    std::unique_ptr<CPLJobQueue> poJobQueue{};
+    size_t nMaxJobs = 0;
+    std::deque<std::unique_ptr<Job>> apoJobs{};
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+
+    // Bytes read from the file that are not yet assigned to a job start at
+    // osBuffer[nBufferPos].
+    std::string osBuffer{};
+    size_t nBufferPos = 0;
+    vsi_l_offset nBufferFileOffset = 0;
+    bool bEOF = false;
+
+    // Set when no more job can be submitted. If bFallback is also set, the
+    // remaining records must be read by the generic implementation.
+    bool bFinished = false;
+    bool bFallback = false;
+    // FID of the first record of the next job, assuming that all records
+    // not detected as empty by OGRCSVScanRecord() result in a feature.
+    int64_t nNextFID = 0;
+
+    ArrowArrayReader() = default;
+
+    ~ArrowArrayReader()
+    {
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(ArrowArrayReader)
+};
+
+/************************************************************************/
+/*                  CanUseParallelGetNextArrowArray()                   */
+/************************************************************************/
+
+bool OGRCSVLayer::CanUseParallelGetNextArrowArray() const
+{
+    if (fpCSV == nullptr || bInWriteMode || !bHonourStrings ||
+        m_poFilterGeom != nullptr || m_poAttrQuery != nullptr ||
+        STARTS_WITH_CI(pszFilename, "/vsistdin/") ||
+        CPLTestBool(CPLGetConfigOption("OGR_CSV_STREAM_BASE_IMPL", "NO")) ||
+        OGRGetNumThreadsForArrowArray("OGR_CSV_NUM_THREADS") <= 1)
+    {
+        return false;
+    }
+
+    // List fields are not handled by OGRArrowArrayHelper
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); ++i)
+    {
+        const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        if (poFieldDefn->IsIgnored())
+            continue;
+        switch (poFieldDefn->GetType())
+        {
+            case OFTInteger:
+            case OFTInteger64:
+            case OFTReal:
+            case OFTString:
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                      OGRCSVFillArrowArray()                          */
+/************************************************************************/
+
+static bool OGRCSVFillArrowArray(OGRArrowArrayHelper &oHelper,
+                                 const OGRFeatureDefn *poFeatureDefn,
+                                 const OGRFeature &oFeature, int iFeat,
+                                 struct tm &brokenDown)
+{
+    if (oHelper.m_panFIDValues)
+        oHelper.m_panFIDValues[iFeat] = oFeature.GetFID();
+
+    for (int iField = 0; iField < oHelper.m_nFieldCount; ++iField)
+    {
+        const int iArrowField = oHelper.m_mapOGRFieldToArrowField[iField];
+        if (iArrowField < 0)
+            continue;
+        auto psArray = oHelper.m_out_array->children[iArrowField];
+        const OGRField *psField = oFeature.GetRawFieldRef(iField);
+        if (!OGR_RawField_IsUnset(psField) && !OGR_RawField_IsNull(psField))
+        {
+            const OGRFieldDefn *poFieldDefn =
+                poFeatureDefn->GetFieldDefnUnsafe(iField);
+            switch (poFieldDefn->GetType())
+            {
+                case OFTInteger:
+                {
+                    if (poFieldDefn->GetSubType() == OFSTBoolean)
+                    {
+                        if (psField->Integer != 0)
+                            oHelper.SetBoolOn(psArray, iFeat);
+                    }
+                    else if (poFieldDefn->GetSubType() == OFSTInt16)
+                    {
+                        oHelper.SetInt16(
+                            psArray, iFeat,
+                            static_cast<int16_t>(psField->Integer));
+                    }
+                    else
+                    {
+                        oHelper.SetInt32(psArray, iFeat, psField->Integer);
+                    }
+                    break;
+                }
+
+                case OFTInteger64:
+                {
+                    oHelper.SetInt64(psArray, iFeat, psField->Integer64);
+                    break;
+                }
+
+                case OFTReal:
+                {
+                    if (poFieldDefn->GetSubType() == OFSTFloat32)
+                    {
+                        oHelper.SetFloat(psArray, iFeat,
+                                         static_cast<float>(psField->Real));
+                    }
+                    else
+                    {
+                        oHelper.SetDouble(psArray, iFeat, psField->Real);
+                    }
+                    break;
+                }
+
+                case OFTString:
+                {
+                    const size_t nLen = strlen(psField->String);
+                    GByte *pabyOut = oHelper.GetPtrForStringOrBinary(
+                        iArrowField, iFeat, nLen);
+                    if (pabyOut == nullptr)
+                        return false;
+                    memcpy(pabyOut, psField->String, nLen);
+                    break;
+                }
+
+                case OFTDate:
+                {
+                    oHelper.SetDate(psArray, iFeat, brokenDown, *psField);
+                    break;
+                }
+
+                case OFTTime:
+                {
+                    oHelper.SetInt32(
+                        psArray, iFeat,
+                        psField->Date.Hour * 3600000 +
+                            psField->Date.Minute * 60000 +
+                            static_cast<int>(psField->Date.Second * 1000 +
+                                             0.5));
+                    break;
+                }
+
+                case OFTDateTime:
+                {
+                    oHelper.SetDateTime(psArray, iFeat, brokenDown,
+                                        oHelper.m_anTZFlags[iField], *psField);
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+        else if (oHelper.m_abNullableFields[iField])
+        {
+            if (!oHelper.SetNull(iArrowField, iFeat))
+                return false;
+        }
+        else if (psArray->n_buffers == 3)
+        {
+            oHelper.SetEmptyStringOrBinary(psArray, iFeat);
+        }
+    }
+
+    for (int iGeomField = 0; iGeomField < oHelper.m_nGeomFieldCount;
+         ++iGeomField)
+    {
+        const int iArrowField =
+            oHelper.m_mapOGRGeomFieldToArrowField[iGeomField];
+        if (iArrowField < 0)
+            continue;
+        const OGRGeometry *poGeom = oFeature.GetGeomFieldRef(iGeomField);
+        std::unique_ptr<OGRGeometry> poEmptyGeom;
+        if (poGeom == nullptr)
+        {
+            const OGRGeomFieldDefn *poGeomFieldDefn =
+                poFeatureDefn->GetGeomFieldDefn(iGeomField);
+            if (poGeomFieldDefn->IsNullable())
+            {
+                if (!oHelper.SetNull(iArrowField, iFeat))
+                    return false;
+                continue;
+            }
+            // Same as the generic implementation
+            const auto eGeomType = poGeomFieldDefn->GetType();
+            poEmptyGeom.reset(OGRGeometryFactory::createGeometry(
+                wkbFlatten(eGeomType) == wkbUnknown ? wkbGeometryCollection
+                                                    : eGeomType));
+            if (poEmptyGeom == nullptr)
+            {
+                oHelper.SetEmptyStringOrBinary(
+                    oHelper.m_out_array->children[iArrowField], iFeat);
+                continue;
+            }
+            poGeom = poEmptyGeom.get();
+        }
+        const size_t nWKBSize = poGeom->WkbSize();
+        GByte *pabyOut =
+            oHelper.GetPtrForStringOrBinary(iArrowField, iFeat, nWKBSize);
+        if (pabyOut == nullptr)
+            return false;
+        poGeom->exportToWkb(wkbNDR, pabyOut, wkbVariantIso);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                     FillArrowArrayFromRecords()                      */
+/*                                                                      */
+/*      Called from worker threads to convert nRecords (non empty)      */
+/*      records to an ArrowArray.                                       */
+/************************************************************************/
+
+bool OGRCSVLayer::FillArrowArrayFromRecords(
+    const std::string &osRecords, int64_t nFirstFID, int nRecords,
+    struct ArrowArray *out_array, std::string &osWarningBadTypeOrWidth) const
+{
+    OGRArrowArrayHelper oHelper(m_poDS, poFeatureDefn,
+                                m_aosArrowArrayStreamOptions, out_array);
+    if (out_array->release == nullptr)
+        return false;
+
+    const std::string osTmpFilename =
+        VSIMemGenerateHiddenFilename("ogrcsv_records.csv");
+    VSILFILE *fp = VSIFileFromMemBuffer(
+        osTmpFilename.c_str(),
+        reinterpret_cast<GByte *>(const_cast<char *>(osRecords.data())),
+        osRecords.size(), /* bTakeOwnership = */ false);
+    if (fp == nullptr)
+    {
+        oHelper.ClearArray();
+        return false;
+    }
+
+    bool bWarningBadTypeOrWidthLocal = false;
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+    bool bRet = true;
+    int iFeat = 0;
+    while (bRet && iFeat < nRecords)
+    {
+        char **papszTokens = CSVReadParseLine3L(
+            fp, m_nMaxLineSize, szDelimiter, bHonourStrings,
+            false,  // bKeepLeadingAndClosingQuotes
+            bMergeDelimiter,
+            true  // bSkipBOM
+        );
+        if (papszTokens == nullptr)
+            break;
+        if (papszTokens[0] == nullptr)
+        {
+            CSLDestroy(papszTokens);
+            continue;
+        }
+
+        std::unique_ptr<OGRFeature> poFeature(
+            TranslateFeature(papszTokens, nFirstFID + iFeat,
+                             bWarningBadTypeOrWidthLocal,
+                             &osWarningBadTypeOrWidth));
+        CSLDestroy(papszTokens);
+
+        bRet = OGRCSVFillArrowArray(oHelper, poFeatureDefn, *poFeature, iFeat,
+                                    brokenDown);
+        ++iFeat;
+    }
+
+    VSIFCloseL(fp);
+    VSIUnlink(osTmpFilename.c_str());
+
+    if (!bRet)
+    {
+        oHelper.ClearArray();
+        return false;
+    }
+    oHelper.Shrink(iFeat);
+    return true;
+}
+
+/************************************************************************/
+/*                       SubmitArrowArrayJobs()                         */
+/*                                                                      */
+/*      Split the file in ranges of complete records, and submit them   */
+/*      to worker threads, until the maximum number of pending jobs is  */
+/*      reached.                                                        */
+/************************************************************************/
+
+void OGRCSVLayer::SubmitArrowArrayJobs()
+{
+    auto &oReader = *m_poArrowArrayReader;
+    const int nMaxBatchSize = OGRArrowArrayHelper::GetMaxFeaturesInBatch(
+        m_aosArrowArrayStreamOptions);
+
+    while (!oReader.bFinished && oReader.apoJobs.size() < oReader.nMaxJobs)
+    {
+        size_t nJobStart = oReader.nBufferPos;
+        int nRecords = 0;
+        while (nRecords < nMaxBatchSize &&
+               oReader.nBufferPos - nJobStart < CSV_ARROW_JOB_SIZE)
+        {
+            size_t nRecordSize = 0;
+            bool bEmptyRecord = false;
+            const auto eStatus = OGRCSVScanRecord(
+                oReader.osBuffer.data() + oReader.nBufferPos,
+                oReader.osBuffer.size() - oReader.nBufferPos, oReader.bEOF,
+                szDelimiter[0], m_nMaxLineSize, nRecordSize, bEmptyRecord);
+            if (eStatus == OGRCSVScanStatus::RECORD)
+            {
+                oReader.nBufferPos += nRecordSize;
+                if (!bEmptyRecord)
+                    ++nRecords;
+            }
+            else if (eStatus == OGRCSVScanStatus::NEED_MORE_DATA)
+            {
+                // Discard bytes of the already submitted jobs
+                oReader.osBuffer.erase(0, nJobStart);
+                oReader.nBufferFileOffset += nJobStart;
+                oReader.nBufferPos -= nJobStart;
+                nJobStart = 0;
+
+                // Grow the read size with the size of the current record,
+                // so that very large records are not scanned too many times
+                const size_t nToRead = std::max(
+                    CSV_ARROW_READ_SIZE, oReader.osBuffer.size() - nJobStart);
+                const size_t nOldSize = oReader.osBuffer.size();
+                oReader.osBuffer.resize(nOldSize + nToRead);
+                const size_t nRead =
+                    VSIFReadL(&oReader.osBuffer[nOldSize], 1, nToRead, fpCSV);
+                oReader.osBuffer.resize(nOldSize + nRead);
+                if (nRead < nToRead)
+                    oReader.bEOF = true;
+            }
+            else
+            {
+                oReader.bFinished = true;
+                oReader.bFallback = (eStatus == OGRCSVScanStatus::UNHANDLED);
+                break;
+            }
+        }
+
+        if (nRecords == 0)
+            continue;
+
+        auto poJob = std::make_unique<ArrowArrayReader::Job>();
+        poJob->osRecords.assign(oReader.osBuffer, nJobStart,
+                                oReader.nBufferPos - nJobStart);
+        poJob->nFirstFID = oReader.nNextFID;
+        poJob->nRecords = nRecords;
+        oReader.nNextFID += nRecords;
+
+        ArrowArrayReader::Job *psJob = poJob.get();
+        oReader.apoJobs.push_back(std::move(poJob));
+        const auto RunJob = [this, psJob, &oReader]()
+        {
+            {
+                auto oContext =
+                    psJob->oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oContext);
+                psJob->bSuccess = FillArrowArrayFromRecords(
+                    psJob->osRecords, psJob->nFirstFID, psJob->nRecords,
+                    &psJob->sArray, psJob->osWarningBadTypeOrWidth);
+            }
+            std::lock_guard oLock(oReader.oMutex);
+            psJob->bFinished = true;
+            oReader.oCV.notify_all();
+        };
+        if (!oReader.poJobQueue->SubmitJob(RunJob))
+            RunJob();
+    }
+}
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/************************************************************************/
+
+// Records are parsed and converted to ArrowArray batches by worker threads,
+// each of them processing a range of complete records. The thread consuming
+// the stream only splits the file at record boundaries.
+// Falls back to the generic implementation when filters are set, when
+// some field types cannot be handled, or when the remaining records are
+// unusual enough (nul characters, too long lines, unbalanced double quotes)
+// so that they are better dealt with by GetNextFeature().
+int OGRCSVLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                   struct ArrowArray *out_array)
+{
+    if (bNeedRewindBeforeRead)
+        ResetReading();
+
+    if (!m_poArrowArrayReader && !m_bArrowArrayReaderFallback)
+    {
+        const int nThreads =
+            OGRGetNumThreadsForArrowArray("OGR_CSV_NUM_THREADS");
+        CPLWorkerThreadPool *poThreadPool =
+            CanUseParallelGetNextArrowArray() &&
+                    !m_aosArrowArrayStreamOptions.FetchBool(
+                        GAS_OPT_DATETIME_AS_STRING, false)
+                ? GDALGetGlobalThreadPool(nThreads)
+                : nullptr;
+        if (poThreadPool)
+        {
+            m_poArrowArrayReader = std::make_unique<ArrowArrayReader>();
+            m_poArrowArrayReader->poJobQueue = poThreadPool->CreateJobQueue();
+            m_poArrowArrayReader->nMaxJobs = 2 * static_cast<size_t>(nThreads);
+            m_poArrowArrayReader->nBufferFileOffset = VSIFTellL(fpCSV);
+            m_poArrowArrayReader->nNextFID = m_nNextFID;
+        }
+        else
+        {
+            m_bArrowArrayReaderFallback = true;
+        }
+    }
+    if (m_bArrowArrayReaderFallback)
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    memset(out_array, 0, sizeof(*out_array));
+
+    auto &oReader = *m_poArrowArrayReader;
+    SubmitArrowArrayJobs();
+    if (oReader.apoJobs.empty())
+    {
+        if (oReader.bFallback)
+        {
+            CPLDebug("CSV",
+                     "Using GetNextFeature() for records from FID %" PRId64,
+                     m_nNextFID);
+            if (VSIFSeekL(fpCSV, oReader.nBufferFileOffset + oReader.nBufferPos,
+                          SEEK_SET) != 0)
+            {
+                return EIO;
+            }
+            m_poArrowArrayReader.reset();
+            m_bArrowArrayReaderFallback = true;
+            return OGRLayer::GetNextArrowArray(stream, out_array);
+        }
+        return 0;
+    }
+
+    auto poJob = std::move(oReader.apoJobs.front());
+    oReader.apoJobs.pop_front();
+    {
+        std::unique_lock oLock(oReader.oMutex);
+        oReader.oCV.wait(oLock, [&poJob] { return poJob->bFinished; });
+    }
+
+    poJob->oErrorAccumulator.ReplayErrors();
+    if (!poJob->osWarningBadTypeOrWidth.empty() && !bWarningBadTypeOrWidth)
+    {
+        bWarningBadTypeOrWidth = true;
+        CPLError(CE_Warning, CPLE_AppDefined, "%s",
+                 poJob->osWarningBadTypeOrWidth.c_str());
+    }
+    if (!poJob->bSuccess)
+        return ENOMEM;
+
+    *out_array = poJob->sArray;
+    memset(&poJob->sArray, 0, sizeof(poJob->sArray));
+
+    // Records that SubmitArrowArrayJobs() did not detect as empty may still
+    // tokenize to nothing and be skipped by the worker thread, so the FIDs
+    // of the job are only estimated. Assign them here, per emitted feature,
+    // as GetNextUnfilteredFeature() does.
+    if (m_aosArrowArrayStreamOptions.FetchBool("INCLUDE_FID", true))
+    {
+        int64_t *panFIDValues = static_cast<int64_t *>(
+            const_cast<void *>(out_array->children[0]->buffers[1]));
+        for (int64_t i = 0; i < out_array->length; ++i)
+            panFIDValues[i] = m_nNextFID + i;
+    }
+    m_nNextFID += out_array->length;
+    m_nFeaturesRead += out_array->length;
+
+    // Keep worker threads busy while the caller processes this batch
+    SubmitArrowArrayJobs();
+
+    return 0;
+}
+
 /************************************************************************/
 /*                           TestCapability()                           */
 /************************************************************************/
@@ -1780,6 +2488,8 @@ int OGRCSVLayer::TestCapability(const char *pszCap)
         return TRUE;
     else if (EQUAL(pszCap, OLCZGeometries))
         return TRUE;
+    else if (EQUAL(pszCap, OLCFastGetArrowStream))
+        return CanUseParallelGetNextArrowArray();
     else
         return FALSE;
 }
@@ -17,6 +17,10 @@
 #include "cplerrors.h"
 #include "ogr_flatgeobuf.h"
 
+#include <cmath>
+#include <cstring>
+#include <limits>
+
 using namespace flatbuffers;
 using namespace FlatGeobuf;
 using namespace ogr_flatgeobuf;
@@ -505,3 +509,337 @@ OGRGeometry *GeometryReader::read()
     }
     return nullptr;
 }
+
+static void WKBAppendUInt32(std::vector<GByte> &abyWKB, uint32_t nVal)
+{
+    CPL_LSBPTR32(&nVal);
+    const GByte *pabyVal = reinterpret_cast<const GByte *>(&nVal);
+    abyWKB.insert(abyWKB.end(), pabyVal, pabyVal + sizeof(nVal));
+}
+
+// Coordinates are stored as little endian doubles, as in the WKB we produce
+static void WKBAppendRawDoubles(std::vector<GByte> &abyWKB,
+                                const double *padfVal, size_t nCount)
+{
+    const GByte *pabyVal = reinterpret_cast<const GByte *>(padfVal);
+    abyWKB.insert(abyWKB.end(), pabyVal, pabyVal + nCount * sizeof(double));
+}
+
+void GeometryReader::writeWKBHeader(std::vector<GByte> &abyWKB, uint32_t nType,
+                                    bool bHasZ, bool bHasM) const
+{
+    abyWKB.push_back(static_cast<GByte>(wkbNDR));
+    WKBAppendUInt32(abyWKB, nType + (bHasZ ? 1000 : 0) + (bHasM ? 2000 : 0));
+}
+
+bool GeometryReader::readPointWKB(std::vector<GByte> &abyWKB)
+{
+    const auto offsetXy = m_offset * 2;
+    if (offsetXy >= m_length)
+    {
+        CPLErrorInvalidLength("XY data");
+        return false;
+    }
+    const double *aZ = nullptr;
+    const double *aM = nullptr;
+    if (m_hasZ)
+    {
+        const auto z = m_geometry->z();
+        if (z == nullptr)
+        {
+            CPLErrorInvalidPointer("Z data");
+            return false;
+        }
+        if (m_offset >= z->size())
+        {
+            CPLErrorInvalidLength("Z data");
+            return false;
+        }
+        aZ = z->data();
+    }
+    if (m_hasM)
+    {
+        const auto pM = m_geometry->m();
+        if (pM == nullptr)
+        {
+            CPLErrorInvalidPointer("M data");
+            return false;
+        }
+        if (m_offset >= pM->size())
+        {
+            CPLErrorInvalidLength("M data");
+            return false;
+        }
+        aM = pM->data();
+    }
+
+    writeWKBHeader(abyWKB, wkbPoint, m_hasZ, m_hasM);
+    if (std::isnan(EndianScalar(m_xy[offsetXy + 0])) ||
+        std::isnan(EndianScalar(m_xy[offsetXy + 1])))
+    {
+        // Empty point: same as OGRPoint::exportToWkb()
+        double dfNan = std::numeric_limits<double>::quiet_NaN();
+        CPL_LSBPTR64(&dfNan);
+        for (int i = 0; i < 2 + (m_hasZ ? 1 : 0) + (m_hasM ? 1 : 0); ++i)
+            WKBAppendRawDoubles(abyWKB, &dfNan, 1);
+    }
+    else
+    {
+        WKBAppendRawDoubles(abyWKB, m_xy + offsetXy, 2);
+        if (aZ)
+            WKBAppendRawDoubles(abyWKB, aZ + m_offset, 1);
+        if (aM)
+            WKBAppendRawDoubles(abyWKB, aM + m_offset, 1);
+    }
+    return true;
+}
+
+bool GeometryReader::readMultiPointWKB(std::vector<GByte> &abyWKB)
+{
+    const auto length = m_length / 2;
+    if (length >= feature_max_buffer_size)
+    {
+        CPLErrorInvalidLength("MultiPoint");
+        return false;
+    }
+    // An empty OGRMultiPoint has no Z or M flag
+    writeWKBHeader(abyWKB, wkbMultiPoint, length > 0 && m_hasZ,
+                   length > 0 && m_hasM);
+    WKBAppendUInt32(abyWKB, length);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        m_offset = i;
+        if (!readPointWKB(abyWKB))
+            return false;
+    }
+    return true;
+}
+
+// Writes the number of points and the points, with the same checks as
+// readSimpleCurve(OGRSimpleCurve*)
+bool GeometryReader::readSimpleCurveWKB(std::vector<GByte> &abyWKB)
+{
+    if (m_offset > feature_max_buffer_size ||
+        m_length > feature_max_buffer_size - m_offset)
+    {
+        CPLErrorInvalidSize("curve offset max");
+        return false;
+    }
+    const uint32_t offsetLen = m_length + m_offset;
+    if (offsetLen > m_xylength / 2)
+    {
+        CPLErrorInvalidSize("curve XY offset");
+        return false;
+    }
+    const double *aZ = nullptr;
+    const double *aM = nullptr;
+    if (m_hasZ)
+    {
+        const auto pZ = m_geometry->z();
+        if (pZ == nullptr)
+        {
+            CPLErrorInvalidPointer("Z data");
+            return false;
+        }
+        if (offsetLen > pZ->size())
+        {
+            CPLErrorInvalidSize("curve Z offset");
+            return false;
+        }
+        aZ = pZ->data();
+    }
+    if (m_hasM)
+    {
+        const auto pM = m_geometry->m();
+        if (pM == nullptr)
+        {
+            CPLErrorInvalidPointer("M data");
+            return false;
+        }
+        if (offsetLen > pM->size())
+        {
+            CPLErrorInvalidSize("curve M offset");
+            return false;
+        }
+        aM = pM->data();
+    }
+
+    WKBAppendUInt32(abyWKB, m_length);
+    const double *xy = m_xy + 2 * static_cast<size_t>(m_offset);
+    if (aZ == nullptr && aM == nullptr)
+    {
+        WKBAppendRawDoubles(abyWKB, xy, 2 * static_cast<size_t>(m_length));
+    }
+    else
+    {
+        for (uint32_t i = 0; i < m_length; i++)
+        {
+            WKBAppendRawDoubles(abyWKB, xy + 2 * static_cast<size_t>(i), 2);
+            if (aZ)
+                WKBAppendRawDoubles(abyWKB, aZ + m_offset + i, 1);
+            if (aM)
+                WKBAppendRawDoubles(abyWKB, aM + m_offset + i, 1);
+        }
+    }
+    return true;
+}
+
+bool GeometryReader::readMultiLineStringWKB(std::vector<GByte> &abyWKB)
+{
+    const auto ends = m_geometry->ends();
+    writeWKBHeader(abyWKB, wkbMultiLineString, m_hasZ, m_hasM);
+    if (ends == nullptr || ends->size() < 2)
+    {
+        WKBAppendUInt32(abyWKB, 1);
+        m_length = m_length / 2;
+        writeWKBHeader(abyWKB, wkbLineString, m_hasZ, m_hasM);
+        return readSimpleCurveWKB(abyWKB);
+    }
+    WKBAppendUInt32(abyWKB, ends->size());
+    m_offset = 0;
+    for (uint32_t i = 0; i < ends->size(); i++)
+    {
+        const auto e = ends->Get(i);
+        if (e < m_offset)
+        {
+            CPLErrorInvalidLength("MultiLineString");
+            return false;
+        }
+        m_length = e - m_offset;
+        writeWKBHeader(abyWKB, wkbLineString, m_hasZ, m_hasM);
+        if (!readSimpleCurveWKB(abyWKB))
+            return false;
+        m_offset = e;
+    }
+    return true;
+}
+
+bool GeometryReader::readPolygonWKB(std::vector<GByte> &abyWKB)
+{
+    const auto ends = m_geometry->ends();
+    writeWKBHeader(abyWKB, wkbPolygon, m_hasZ, m_hasM);
+    if (ends == nullptr || ends->size() < 2)
+    {
+        WKBAppendUInt32(abyWKB, 1);
+        m_length = m_length / 2;
+        return readSimpleCurveWKB(abyWKB);
+    }
+
+    // Invalid rings are skipped, as done by readPolygon()
+    const size_t nRingCountPos = abyWKB.size();
+    WKBAppendUInt32(abyWKB, 0);
+    uint32_t nRings = 0;
+    bool bEmpty = true;
+    for (uint32_t i = 0; i < ends->size(); i++)
+    {
+        const auto e = ends->Get(i);
+        if (e < m_offset)
+        {
+            CPLErrorInvalidLength("Polygon");
+            return false;
+        }
+        m_length = e - m_offset;
+        const size_t nRingPos = abyWKB.size();
+        if (readSimpleCurveWKB(abyWKB))
+        {
+            ++nRings;
+            if (m_length > 0)
+                bEmpty = false;
+        }
+        else
+        {
+            abyWKB.resize(nRingPos);
+        }
+        m_offset = e;
+    }
+    if (bEmpty)
+        return false;
+    CPL_LSBPTR32(&nRings);
+    memcpy(abyWKB.data() + nRingCountPos, &nRings, sizeof(nRings));
+    return true;
+}
+
+bool GeometryReader::readMultiPolygonWKB(std::vector<GByte> &abyWKB)
+{
+    const auto parts = m_geometry->parts();
+    if (parts == nullptr)
+    {
+        CPLErrorInvalidPointer("parts data");
+        return false;
+    }
+    // An empty OGRMultiPolygon has no Z or M flag
+    const bool bHasParts = parts->size() > 0;
+    writeWKBHeader(abyWKB, wkbMultiPolygon, bHasParts && m_hasZ,
+                   bHasParts && m_hasM);
+    WKBAppendUInt32(abyWKB, parts->size());
+    for (uoffset_t i = 0; i < parts->size(); i++)
+    {
+        if (!GeometryReader(parts->Get(i), GeometryType::Polygon, m_hasZ,
+                            m_hasM)
+                 .readWKB(abyWKB))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GeometryReader::readWKB(std::vector<GByte> &abyWKB)
+{
+    if (m_geometryType == GeometryType::MultiPolygon)
+        return readMultiPolygonWKB(abyWKB);
+
+    if (!canReadWKB(m_geometryType))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "GeometryReader::readWKB: Unsupported type %d",
+                 static_cast<int>(m_geometryType));
+        return false;
+    }
+
+    // Same checks as read()
+    const auto pXy = m_geometry->xy();
+    if (pXy == nullptr)
+    {
+        CPLErrorInvalidPointer("XY data");
+        return false;
+    }
+    if (m_hasZ && m_geometry->z() == nullptr)
+    {
+        CPLErrorInvalidPointer("Z data");
+        return false;
+    }
+    if (m_hasM && m_geometry->m() == nullptr)
+    {
+        CPLErrorInvalidPointer("M data");
+        return false;
+    }
+    const auto xySize = pXy->size();
+    if (xySize >= (feature_max_buffer_size / sizeof(OGRRawPoint)))
+    {
+        CPLErrorInvalidLength("XY data");
+        return false;
+    }
+    m_length = xySize;
+    m_xylength = m_length;
+    m_xy = pXy->data();
+
+    switch (m_geometryType)
+    {
+        case GeometryType::Point:
+            return readPointWKB(abyWKB);
+        case GeometryType::MultiPoint:
+            return readMultiPointWKB(abyWKB);
+        case GeometryType::LineString:
+            writeWKBHeader(abyWKB, wkbLineString, m_hasZ, m_hasM);
+            m_length = m_length / 2;
+            return readSimpleCurveWKB(abyWKB);
+        case GeometryType::MultiLineString:
+            return readMultiLineStringWKB(abyWKB);
+        case GeometryType::Polygon:
+            return readPolygonWKB(abyWKB);
+        default:
+            break;
+    }
+    return false;
+}
@@ -24,6 +24,8 @@
 
 #include "ogr_p.h"
 
+#include <vector>
+
 namespace ogr_flatgeobuf
 {
 
@@ -66,6 +68,15 @@ class GeometryReader
         return GeometryReader(part, geometryType, m_hasZ, m_hasM).read();
     }
 
+    bool readPointWKB(std::vector<GByte> &abyWKB);
+    bool readMultiPointWKB(std::vector<GByte> &abyWKB);
+    bool readSimpleCurveWKB(std::vector<GByte> &abyWKB);
+    bool readMultiLineStringWKB(std::vector<GByte> &abyWKB);
+    bool readPolygonWKB(std::vector<GByte> &abyWKB);
+    bool readMultiPolygonWKB(std::vector<GByte> &abyWKB);
+    void writeWKBHeader(std::vector<GByte> &abyWKB, uint32_t nType,
+                        bool bHasZ, bool bHasM) const;
+
     template <class T> T *readSimpleCurve(const bool halfLength = false)
     {
         if (halfLength)
@@ -96,6 +107,22 @@ class GeometryReader
     }
 
     OGRGeometry *read();
+
+    // Whether readWKB() can deal with the geometry type
+    static bool canReadWKB(FlatGeobuf::GeometryType geometryType)
+    {
+        return geometryType == FlatGeobuf::GeometryType::Point ||
+               geometryType == FlatGeobuf::GeometryType::MultiPoint ||
+               geometryType == FlatGeobuf::GeometryType::LineString ||
+               geometryType == FlatGeobuf::GeometryType::MultiLineString ||
+               geometryType == FlatGeobuf::GeometryType::Polygon ||
+               geometryType == FlatGeobuf::GeometryType::MultiPolygon;
+    }
+
+    // Appends the ISO WKB (little endian) of the geometry to abyWKB, such as
+    // the one of read()->exportToWkb(), but without instantiating a
+    // OGRGeometry. Returns false in the cases read() returns nullptr.
+    bool readWKB(std::vector<GByte> &abyWKB);
 };
 
 }  // namespace ogr_flatgeobuf
@@ -12,6 +12,10 @@
 
 #include "geometrywriter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 using namespace flatbuffers;
 using namespace FlatGeobuf;
 using namespace ogr_flatgeobuf;
@@ -227,3 +231,303 @@ const Offset<Geometry> GeometryWriter::write(int depth)
     return FlatGeobuf::CreateGeometryDirect(m_fbb, pEnds, pXy, pZ, pM, nullptr,
                                             nullptr, geometryType);
 }
+
+static bool WKBReadHeader(const GByte *&pabyWKB, const GByte *pabyEnd,
+                          OGRwkbGeometryType &eGType,
+                          OGRwkbByteOrder &eByteOrder)
+{
+    if (pabyEnd - pabyWKB < 5 ||
+        (pabyWKB[0] != wkbNDR && pabyWKB[0] != wkbXDR))
+    {
+        return false;
+    }
+    eByteOrder = static_cast<OGRwkbByteOrder>(pabyWKB[0]);
+    if (OGRReadWKBGeometryType(pabyWKB, wkbVariantIso, &eGType) != OGRERR_NONE)
+        return false;
+    pabyWKB += 5;
+    return true;
+}
+
+static bool WKBReadUInt32(const GByte *&pabyWKB, const GByte *pabyEnd,
+                          OGRwkbByteOrder eByteOrder, uint32_t &nVal)
+{
+    if (pabyEnd - pabyWKB < 4)
+        return false;
+    memcpy(&nVal, pabyWKB, sizeof(nVal));
+    if (OGR_SWAP(eByteOrder))
+        CPL_SWAP32PTR(&nVal);
+    pabyWKB += 4;
+    return true;
+}
+
+bool WKBGeometryWriter::readPoints(const GByte *&pabyWKB, const GByte *pabyEnd,
+                                   OGRwkbByteOrder eByteOrder, bool bIs3D,
+                                   bool bIsMeasured, uint32_t numPoints,
+                                   Part &part)
+{
+    const size_t nDims = 2 + (bIs3D ? 1 : 0) + (bIsMeasured ? 1 : 0);
+    if (static_cast<size_t>(pabyEnd - pabyWKB) / (nDims * sizeof(double)) <
+        numPoints)
+    {
+        return false;
+    }
+
+    const auto xyLength = part.xy.size();
+    part.xy.resize(xyLength + 2 * static_cast<size_t>(numPoints));
+    double *padfXY = part.xy.data() + xyLength;
+    double *padfZ = nullptr;
+    if (m_hasZ)
+    {
+        const auto zLength = part.z.size();
+        part.z.resize(zLength + numPoints);
+        padfZ = part.z.data() + zLength;
+    }
+    double *padfM = nullptr;
+    if (m_hasM)
+    {
+        const auto mLength = part.m.size();
+        part.m.resize(mLength + numPoints);
+        padfM = part.m.data() + mLength;
+    }
+
+    const bool bSwap = OGR_SWAP(eByteOrder);
+    if (nDims == 2 && !bSwap)
+    {
+        memcpy(padfXY, pabyWKB, 2 * sizeof(double) * numPoints);
+        pabyWKB += 2 * sizeof(double) * numPoints;
+    }
+    else
+    {
+        for (uint32_t i = 0; i < numPoints; ++i)
+        {
+            double adfCoords[4];
+            memcpy(adfCoords, pabyWKB, nDims * sizeof(double));
+            pabyWKB += nDims * sizeof(double);
+            if (bSwap)
+            {
+                for (size_t j = 0; j < nDims; ++j)
+                    CPL_SWAPDOUBLE(&adfCoords[j]);
+            }
+            padfXY[2 * i] = adfCoords[0];
+            padfXY[2 * i + 1] = adfCoords[1];
+            // Missing dimensions are written as 0, as OGRSimpleCurve does
+            if (padfZ)
+                padfZ[i] = bIs3D ? adfCoords[2] : 0.0;
+            if (padfM)
+                padfM[i] = bIsMeasured ? adfCoords[bIs3D ? 3 : 2] : 0.0;
+        }
+    }
+    if (padfZ && nDims == 2)
+        std::fill(padfZ, padfZ + numPoints, 0.0);
+    if (padfM && nDims == 2)
+        std::fill(padfM, padfM + numPoints, 0.0);
+
+    m_numPoints += numPoints;
+    return true;
+}
+
+bool WKBGeometryWriter::readPolygon(const GByte *&pabyWKB,
+                                    const GByte *pabyEnd,
+                                    OGRwkbByteOrder eByteOrder, Part &part)
+{
+    const bool bIs3D = OGR_GT_HasZ(m_eGType) != FALSE;
+    const bool bIsMeasured = OGR_GT_HasM(m_eGType) != FALSE;
+    uint32_t numRings = 0;
+    if (!WKBReadUInt32(pabyWKB, pabyEnd, eByteOrder, numRings))
+        return false;
+    // Same as GeometryWriter::writePolygon(): ends are only written if
+    // there are interior rings
+    uint32_t e = 0;
+    for (uint32_t i = 0; i < numRings; ++i)
+    {
+        uint32_t numPoints = 0;
+        if (!WKBReadUInt32(pabyWKB, pabyEnd, eByteOrder, numPoints) ||
+            !readPoints(pabyWKB, pabyEnd, eByteOrder, bIs3D, bIsMeasured,
+                        numPoints, part))
+        {
+            return false;
+        }
+        e += numPoints;
+        if (numRings > 1)
+            part.ends.push_back(e);
+    }
+    return true;
+}
+
+bool WKBGeometryWriter::parse(const GByte *pabyWKB, size_t nWKBSize)
+{
+    m_partCount = 0;
+    m_numPoints = 0;
+    const GByte *const pabyEnd = pabyWKB + nWKBSize;
+
+    OGRwkbByteOrder eByteOrder = wkbNDR;
+    if (!WKBReadHeader(pabyWKB, pabyEnd, m_eGType, eByteOrder))
+        return false;
+    const auto eFlatType = wkbFlatten(m_eGType);
+    const bool bIs3D = OGR_GT_HasZ(m_eGType) != FALSE;
+    const bool bIsMeasured = OGR_GT_HasM(m_eGType) != FALSE;
+
+    const auto GetNewPart = [this]() -> Part &
+    {
+        if (m_partCount == m_parts.size())
+            m_parts.emplace_back();
+        Part &part = m_parts[m_partCount];
+        part.xy.clear();
+        part.z.clear();
+        part.m.clear();
+        part.ends.clear();
+        return part;
+    };
+
+    if (eFlatType == wkbPoint || eFlatType == wkbLineString ||
+        eFlatType == wkbPolygon)
+    {
+        Part &part = GetNewPart();
+        m_partCount = 1;
+        if (eFlatType == wkbPoint)
+        {
+            if (!readPoints(pabyWKB, pabyEnd, eByteOrder, bIs3D, bIsMeasured, 1,
+                            part))
+            {
+                return false;
+            }
+            // An OGRPoint is empty if both X and Y are NaN
+            if (std::isnan(part.xy[0]) && std::isnan(part.xy[1]))
+                m_numPoints = 0;
+            return true;
+        }
+        if (eFlatType == wkbPolygon)
+            return readPolygon(pabyWKB, pabyEnd, eByteOrder, part);
+        uint32_t numPoints = 0;
+        return WKBReadUInt32(pabyWKB, pabyEnd, eByteOrder, numPoints) &&
+               readPoints(pabyWKB, pabyEnd, eByteOrder, bIs3D, bIsMeasured,
+                          numPoints, part);
+    }
+
+    if (eFlatType != wkbMultiPoint && eFlatType != wkbMultiLineString &&
+        eFlatType != wkbMultiPolygon)
+    {
+        return false;
+    }
+
+    // Parts must have the dimensions of the collection: otherwise
+    // OGRGeometryCollection::addGeometry() would promote them.
+    const OGRwkbGeometryType eExpectedPartType = OGR_GT_SetModifier(
+        eFlatType == wkbMultiPoint        ? wkbPoint
+        : eFlatType == wkbMultiLineString ? wkbLineString
+                                          : wkbPolygon,
+        bIs3D, bIsMeasured);
+    uint32_t numParts = 0;
+    if (!WKBReadUInt32(pabyWKB, pabyEnd, eByteOrder, numParts) ||
+        static_cast<size_t>(pabyEnd - pabyWKB) / 9 < numParts)
+    {
+        return false;
+    }
+
+    if (eFlatType != wkbMultiPolygon)
+    {
+        GetNewPart();
+        m_partCount = 1;
+    }
+    uint32_t e = 0;
+    for (uint32_t i = 0; i < numParts; ++i)
+    {
+        OGRwkbGeometryType ePartType = wkbUnknown;
+        OGRwkbByteOrder ePartByteOrder = wkbNDR;
+        if (!WKBReadHeader(pabyWKB, pabyEnd, ePartType, ePartByteOrder) ||
+            ePartType != eExpectedPartType)
+        {
+            return false;
+        }
+        if (eFlatType == wkbMultiPoint)
+        {
+            // Empty points are skipped by GeometryWriter::writeMultiPoint()
+            Part &part = m_parts[0];
+            const auto numPointsBefore = m_numPoints;
+            if (!readPoints(pabyWKB, pabyEnd, ePartByteOrder, bIs3D,
+                            bIsMeasured, 1, part))
+            {
+                return false;
+            }
+            const auto xyLength = part.xy.size();
+            if (std::isnan(part.xy[xyLength - 2]) &&
+                std::isnan(part.xy[xyLength - 1]))
+            {
+                part.xy.resize(xyLength - 2);
+                if (m_hasZ)
+                    part.z.pop_back();
+                if (m_hasM)
+                    part.m.pop_back();
+                m_numPoints = numPointsBefore;
+            }
+        }
+        else if (eFlatType == wkbMultiLineString)
+        {
+            // Same as GeometryWriter::writeMultiLineString()
+            uint32_t numPoints = 0;
+            if (!WKBReadUInt32(pabyWKB, pabyEnd, ePartByteOrder, numPoints) ||
+                !readPoints(pabyWKB, pabyEnd, ePartByteOrder, bIs3D,
+                            bIsMeasured, numPoints, m_parts[0]))
+            {
+                return false;
+            }
+            if (numPoints > 0)
+                m_parts[0].ends.push_back(e += numPoints);
+        }
+        else
+        {
+            // Same as GeometryWriter::writeMultiPolygon()
+            const auto numPointsBefore = m_numPoints;
+            if (!readPolygon(pabyWKB, pabyEnd, ePartByteOrder, GetNewPart()))
+                return false;
+            if (m_numPoints > numPointsBefore)
+                ++m_partCount;
+        }
+    }
+    return true;
+}
+
+void WKBGeometryWriter::getEnvelope(OGREnvelope &sEnvelope) const
+{
+    sEnvelope = OGREnvelope();
+    for (size_t iPart = 0; iPart < m_partCount; ++iPart)
+    {
+        const auto &xy = m_parts[iPart].xy;
+        for (size_t i = 0; i + 1 < xy.size(); i += 2)
+        {
+            sEnvelope.MinX = std::min(sEnvelope.MinX, xy[i]);
+            sEnvelope.MaxX = std::max(sEnvelope.MaxX, xy[i]);
+            sEnvelope.MinY = std::min(sEnvelope.MinY, xy[i + 1]);
+            sEnvelope.MaxY = std::max(sEnvelope.MaxY, xy[i + 1]);
+        }
+    }
+}
+
+const Offset<Geometry>
+WKBGeometryWriter::write(flatbuffers::FlatBufferBuilder &fbb) const
+{
+    const auto CreatePartGeometry =
+        [&fbb](const Part &part, GeometryType geometryType)
+    {
+        return CreateGeometryDirect(
+            fbb, part.ends.empty() ? nullptr : &part.ends,
+            part.xy.empty() ? nullptr : &part.xy,
+            part.z.empty() ? nullptr : &part.z,
+            part.m.empty() ? nullptr : &part.m, nullptr, nullptr, geometryType);
+    };
+
+    if (wkbFlatten(m_eGType) == wkbMultiPolygon)
+    {
+        std::vector<Offset<Geometry>> parts;
+        for (size_t i = 0; i < m_partCount; ++i)
+            parts.push_back(
+                CreatePartGeometry(m_parts[i], GeometryType::Polygon));
+        return CreateGeometryDirect(fbb, nullptr, nullptr, nullptr, nullptr,
+                                    nullptr, nullptr,
+                                    GeometryType::MultiPolygon, &parts);
+    }
+    return CreatePartGeometry(
+        m_parts[0], m_layerGeometryType == GeometryType::Unknown
+                        ? GeometryWriter::translateOGRwkbGeometryType(m_eGType)
+                        : GeometryType::Unknown);
+}
@@ -16,6 +16,8 @@
 #include "ogrsf_frmts.h"
 #include "ogr_p.h"
 
+#include <vector>
+
 #if defined(__clang__)
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wweak-vtables"
@@ -97,6 +99,63 @@ class GeometryWriter
     translateOGRwkbGeometryType(const OGRwkbGeometryType eGType);
 };
 
+// Serializes a geometry from its WKB representation, with the same result
+// as GeometryWriter on the OGRGeometry built from it, but without
+// instantiating it. Only deals with (multi)points, (multi)linestrings and
+// (multi)polygons whose parts have the dimensions of the geometry.
+class WKBGeometryWriter
+{
+  private:
+    struct Part
+    {
+        std::vector<double> xy{};
+        std::vector<double> z{};
+        std::vector<double> m{};
+        std::vector<uint32_t> ends{};
+    };
+
+    const FlatGeobuf::GeometryType m_layerGeometryType;
+    const bool m_hasZ;
+    const bool m_hasM;
+    OGRwkbGeometryType m_eGType = wkbUnknown;
+    // Only one part, unless for a MultiPolygon
+    std::vector<Part> m_parts{};
+    size_t m_partCount = 0;
+    size_t m_numPoints = 0;
+
+    bool readPoints(const GByte *&pabyWKB, const GByte *pabyEnd,
+                    OGRwkbByteOrder eByteOrder, bool bIs3D, bool bIsMeasured,
+                    uint32_t numPoints, Part &part);
+    bool readPolygon(const GByte *&pabyWKB, const GByte *pabyEnd,
+                     OGRwkbByteOrder eByteOrder, Part &part);
+
+  public:
+    WKBGeometryWriter(const FlatGeobuf::GeometryType layerGeometryType,
+                      const bool hasZ, const bool hasM)
+        : m_layerGeometryType(layerGeometryType), m_hasZ(hasZ), m_hasM(hasM)
+    {
+    }
+
+    // Returns false if the WKB is invalid or must go through GeometryWriter
+    bool parse(const GByte *pabyWKB, size_t nWKBSize);
+
+    // Same as OGRGeometry::getGeometryType()
+    OGRwkbGeometryType getGeometryType() const
+    {
+        return m_eGType;
+    }
+
+    // Same as OGRGeometry::IsEmpty()
+    bool isEmpty() const
+    {
+        return m_numPoints == 0;
+    }
+
+    void getEnvelope(OGREnvelope &sEnvelope) const;
+    const flatbuffers::Offset<FlatGeobuf::Geometry>
+    write(flatbuffers::FlatBufferBuilder &fbb) const;
+};
+
 }  // namespace ogr_flatgeobuf
 
 #endif /* ndef FLATGEOBUF_GEOMETRYWRITER_H_INCLUDED */
@@ -32,7 +32,9 @@
 
 #include <deque>
 #include <limits>
+#include <memory>
 
+class OGRArrowArrayHelper;
 class OGRFlatGeobufDataset;
 
 static constexpr uint8_t magicbytes[8] = {0x66, 0x67, 0x62, 0x03,
@@ -118,6 +120,20 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     GByte *m_featureBuf = nullptr;  // reusable/resizable feature data buffer
     uint32_t m_featureBufSize = 0;  // current feature buffer size
 
+    // Arrow
+    enum class ArrowFeatureStatus
+    {
+        OK,
+        SKIPPED,     // filtered out by the spatial filter
+        BATCH_FULL,  // must be added to the next batch
+        FAILURE,
+    };
+
+    struct ArrowFeatureContext;
+    struct ArrowArrayJob;
+    struct ArrowArrayReader;
+    std::unique_ptr<ArrowArrayReader> m_poArrowArrayReader{};
+
     // deserialize
     void ensurePadfBuffers(size_t count);
     OGRErr ensureFeatureBuf(uint32_t featureSize);
@@ -127,11 +143,30 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     void readColumns();
     OGRErr readIndex();
     OGRErr readFeatureOffset(uint64_t index, uint64_t &featureOffset);
+    int readNextFeatureSize(GIntBig &fid, uint32_t &featureSize);
+    ArrowFeatureStatus
+    FillArrowArrayFeature(const GByte *featureBuf, uint32_t featureSize,
+                          GIntBig fid, OGRArrowArrayHelper &sHelper,
+                          struct ArrowArray *out_array, int iFeat,
+                          ArrowFeatureContext &ctxt) const;
+    void FillArrowArrayFromJob(ArrowArrayJob &job) const;
+    void SubmitArrowArrayJob(ArrowArrayJob *psJob);
+    void SubmitArrowArrayJobs();
+    int GetNextArrowArrayParallel(struct ArrowArrayStream *stream,
+                                  struct ArrowArray *out_array);
+    bool PostFilterAndKeepArrowArray(struct ArrowArrayStream *stream,
+                                     struct ArrowArray *out_array,
+                                     GIntBig nFeatureIdxStart);
 
     // serialize
     bool CreateFinalFile();
     void writeHeader(VSILFILE *poFp, uint64_t featuresCount,
                      std::vector<double> *extentVector);
+    OGRErr
+    writeFeature(flatbuffers::FlatBufferBuilder &fbb,
+                 const std::vector<uint8_t> &properties,
+                 flatbuffers::Offset<FlatGeobuf::Geometry> geometryOffset,
+                 const OGREnvelope *psEnvelope);
 
     // construction
     OGRFlatGeobufLayer(const FlatGeobuf::Header *, GByte *headerBuf,
@@ -168,6 +203,9 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     virtual OGRErr CreateField(const OGRFieldDefn *poField,
                                int bApproxOK = true) override;
     virtual OGRErr ICreateFeature(OGRFeature *poFeature) override;
+    bool WriteArrowBatch(const struct ArrowSchema *schema,
+                         struct ArrowArray *array,
+                         CSLConstList papszOptions = nullptr) override;
     virtual int TestCapability(const char *) override;
 
     virtual void ResetReading() override;
@@ -16,6 +16,9 @@
 #include "cpl_json.h"
 #include "cpl_http.h"
 #include "cpl_time.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_p.h"
 #include "ograrrowarrayhelper.h"
 #include "ogrlayerarrow.h"
@@ -28,7 +31,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <mutex>
 #include <new>
 #include <stdexcept>
 
@@ -805,6 +811,8 @@ CPLErr OGRFlatGeobufLayer::Close()
 {
     CPLErr eErr = CE_None;
 
+    m_poArrowArrayReader.reset();
+
     if (m_create)
     {
         if (!CreateFinalFile())
@@ -1444,566 +1452,651 @@ OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature)
 }
 
 /************************************************************************/
-/*                      GetNextArrowArray()                             */
+/*                        ArrowFeatureContext                           */
 /************************************************************************/
 
-int OGRFlatGeobufLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
-                                          struct ArrowArray *out_array)
+// State used by FillArrowArrayFeature(). There is one per thread filling
+// an ArrowArray.
+struct OGRFlatGeobufLayer::ArrowFeatureContext
 {
-    if (!m_poSharedArrowArrayStreamPrivateData->m_anQueriedFIDs.empty() ||
-        CPLTestBool(
-            CPLGetConfigOption("OGR_FLATGEOBUF_STREAM_BASE_IMPL", "NO")))
+    const OGRGeometry *const poFilterGeom;
+    const bool bFilterIsEnvelope;
+    const OGREnvelope sFilterEnvelope;
+    const bool bDateTimeAsString;
+    const uint32_t nMemLimit;
+    OGRPreparedGeometry *pPreparedFilterGeom = nullptr;
+    std::vector<bool> abSetFields{};
+    std::vector<GByte> abyWKB{};
+    struct tm brokenDown{};
+    int errorErrno = EIO;
+
+    ArrowFeatureContext(const OGRGeometry *poFilterGeomIn,
+                        bool bFilterIsEnvelopeIn,
+                        const OGREnvelope &sFilterEnvelopeIn,
+                        bool bDateTimeAsStringIn)
+        : poFilterGeom(poFilterGeomIn), bFilterIsEnvelope(bFilterIsEnvelopeIn),
+          sFilterEnvelope(sFilterEnvelopeIn),
+          bDateTimeAsString(bDateTimeAsStringIn),
+          nMemLimit(OGRArrowArrayHelper::GetMemLimit())
     {
-        return OGRLayer::GetNextArrowArray(stream, out_array);
     }
 
-begin:
-    int errorErrno = EIO;
-    memset(out_array, 0, sizeof(*out_array));
+    ~ArrowFeatureContext()
+    {
+        if (pPreparedFilterGeom)
+            OGRDestroyPreparedGeometry(pPreparedFilterGeom);
+    }
 
-    if (m_create)
-        return EINVAL;
+    CPL_DISALLOW_COPY_ASSIGN(ArrowFeatureContext)
+};
 
-    if (m_bEOF || (m_featuresCount > 0 && m_featuresPos >= m_featuresCount))
+/************************************************************************/
+/*                          ArrowArrayJob                               */
+/************************************************************************/
+
+// Target size of the feature data decoded by a job of the parallel
+// implementation of GetNextArrowArray().
+constexpr size_t FGB_ARROW_JOB_SIZE = 4 * 1024 * 1024;
+
+struct OGRFlatGeobufLayer::ArrowArrayJob
+{
+    // Input: the data of anFIDs.size() features, the one of feature i
+    // starting at abyFeatures[anFeatureOffsets[i]]. Processing starts at
+    // iFirstFeature.
+    std::vector<GByte> abyFeatures{};
+    std::vector<size_t> anFeatureOffsets{};
+    std::vector<GIntBig> anFIDs{};
+    size_t iFirstFeature = 0;
+
+    // Output: features from iNextFeature must go to another ArrowArray
+    size_t iNextFeature = 0;
+    struct ArrowArray sArray;
+    CPLErrorAccumulator oErrorAccumulator{};
+    int nErrno = 0;
+    bool bFinished = false;
+
+    ArrowArrayJob()
     {
-        return 0;
+        memset(&sArray, 0, sizeof(sArray));
     }
 
-    if (readIndex() != OGRERR_NONE)
-        return EIO;
+    ~ArrowArrayJob()
+    {
+        if (sArray.release)
+            sArray.release(&sArray);
+    }
 
-    OGRArrowArrayHelper sHelper(
-        nullptr,  // dataset pointer. only used for field domains (not used by
-                  // FlatGeobuf)
-        m_poFeatureDefn, m_aosArrowArrayStreamOptions, out_array);
-    if (out_array->release == nullptr)
+    CPL_DISALLOW_COPY_ASSIGN(ArrowArrayJob)
+};
+
+/************************************************************************/
+/*                         ArrowArrayReader                             */
+/************************************************************************/
+
+struct OGRFlatGeobufLayer::ArrowArrayReader
+{
+    std::unique_ptr<CPLJobQueue> poJobQueue{};
+    size_t nMaxJobs = 0;
+    std::deque<std::unique_ptr<ArrowArrayJob>> apoJobs{};
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+
+    // Owned copy of the spatial filter, as the one of the layer might be
+    // changed while jobs are running.
+    std::unique_ptr<OGRGeometry> poFilterGeom{};
+    bool bFilterIsEnvelope = false;
+    OGREnvelope sFilterEnvelope{};
+
+    // Set when no more job can be submitted, possibly because of an error
+    // while reading features.
+    bool bFinished = false;
+    int nErrno = 0;
+
+    ArrowArrayReader() = default;
+
+    ~ArrowArrayReader()
     {
-        return ENOMEM;
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
     }
 
-    std::vector<bool> abSetFields(sHelper.m_nFieldCount);
+    CPL_DISALLOW_COPY_ASSIGN(ArrowArrayReader)
+};
 
-    struct tm brokenDown;
-    memset(&brokenDown, 0, sizeof(brokenDown));
+/************************************************************************/
+/*                       readNextFeatureSize()                          */
+/************************************************************************/
 
-    int iFeat = 0;
-    bool bEOFOrError = true;
+// Positions m_poFp on the data of the next feature of the iteration, and
+// reads its size. Returns 1 in case of success, 0 at the end of the
+// iteration, and -1 in case of error.
+int OGRFlatGeobufLayer::readNextFeatureSize(GIntBig &fid,
+                                            uint32_t &featureSize)
+{
+    if ((m_featuresCount > 0 && m_featuresPos >= m_featuresCount) ||
+        (m_queriedSpatialIndex && m_featuresCount == 0))
+    {
+        CPLDebugOnly("FlatGeobuf", "GetNextArrowArray: iteration end at %lu",
+                     static_cast<long unsigned int>(m_featuresPos));
+        return 0;
+    }
 
-    if (m_queriedSpatialIndex && m_featuresCount == 0)
+    auto seek = false;
+    if (m_queriedSpatialIndex && !m_ignoreSpatialFilter)
+    {
+        const auto item = m_foundItems[m_featuresPos];
+        m_offset = m_offsetFeatures + item.offset;
+        fid = item.index;
+        seek = true;
+    }
+    else
     {
-        CPLDebugOnly("FlatGeobuf", "GetNextFeature: no features found");
-        sHelper.m_nMaxBatchSize = 0;
+        fid = m_featuresPos;
     }
 
-    const GIntBig nFeatureIdxStart = m_featuresPos;
-    const bool bDateTimeAsString = m_aosArrowArrayStreamOptions.FetchBool(
-        GAS_OPT_DATETIME_AS_STRING, false);
+    if (m_featuresPos == 0)
+        seek = true;
 
-    const uint32_t nMemLimit = OGRArrowArrayHelper::GetMemLimit();
-    while (iFeat < sHelper.m_nMaxBatchSize)
+    if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1)
     {
-        bEOFOrError = true;
-        if (m_featuresCount > 0 && m_featuresPos >= m_featuresCount)
+        return 0;
+    }
+    if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1)
+    {
+        if (VSIFEofL(m_poFp))
+            return 0;
+        CPLErrorIO("reading feature size");
+        return -1;
+    }
+    CPL_LSBPTR32(&featureSize);
+
+    // Sanity check to avoid allocated huge amount of memory on corrupted
+    // feature
+    if (featureSize > 100 * 1024 * 1024)
+    {
+        if (featureSize > feature_max_buffer_size)
         {
-            CPLDebugOnly("FlatGeobuf", "GetNextFeature: iteration end at %lu",
-                         static_cast<long unsigned int>(m_featuresPos));
-            break;
+            CPLErrorInvalidSize("feature");
+            return -1;
         }
 
-        GIntBig fid;
-        auto seek = false;
-        if (m_queriedSpatialIndex && !m_ignoreSpatialFilter)
+        if (m_nFileSize == 0)
         {
-            const auto item = m_foundItems[m_featuresPos];
-            m_offset = m_offsetFeatures + item.offset;
-            fid = item.index;
-            seek = true;
+            VSIStatBufL sStatBuf;
+            if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
+            {
+                m_nFileSize = sStatBuf.st_size;
+            }
         }
-        else
+        if (m_offset + featureSize > m_nFileSize)
         {
-            fid = m_featuresPos;
+            CPLErrorIO("reading feature size");
+            return -1;
         }
+    }
+    return 1;
+}
 
-        if (sHelper.m_panFIDValues)
-            sHelper.m_panFIDValues[iFeat] = fid;
-
-        if (m_featuresPos == 0)
-            seek = true;
+/************************************************************************/
+/*                      FillArrowArrayFeature()                         */
+/************************************************************************/
 
-        if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1)
+// Decodes the feature of featureBuf as the iFeat-th row of out_array.
+// Only reads the state of the layer, so it can be called concurrently
+// from several threads, with one ArrowFeatureContext per thread.
+OGRFlatGeobufLayer::ArrowFeatureStatus
+OGRFlatGeobufLayer::FillArrowArrayFeature(
+    const GByte *featureBuf, uint32_t featureSize, GIntBig fid,
+    OGRArrowArrayHelper &sHelper, struct ArrowArray *out_array, int iFeat,
+    ArrowFeatureContext &ctxt) const
+{
+    if (m_bVerifyBuffers)
+    {
+        Verifier v(featureBuf, featureSize);
+        const auto ok = VerifyFeatureBuffer(v);
+        if (!ok)
         {
-            break;
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Buffer verification failed");
+            CPLDebugOnly("FlatGeobuf", "fid: " CPL_FRMT_GIB, fid);
+            CPLDebugOnly("FlatGeobuf", "featureSize: %d", featureSize);
+            return ArrowFeatureStatus::FAILURE;
         }
-        uint32_t featureSize;
-        if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1)
+    }
+
+    if (sHelper.m_panFIDValues)
+        sHelper.m_panFIDValues[iFeat] = fid;
+
+    const auto feature = GetRoot<Feature>(featureBuf);
+    const auto geometry = feature->geometry();
+    const auto properties = feature->properties();
+    if (!m_poFeatureDefn->IsGeometryIgnored() && geometry != nullptr)
+    {
+        auto geometryType = m_geometryType;
+        if (geometryType == GeometryType::Unknown)
+            geometryType = geometry->type();
+
+        // Simple geometry types are directly translated to WKB. Others go
+        // through a OGRGeometry.
+        auto &abyWKB = ctxt.abyWKB;
+        abyWKB.clear();
+        GeometryReader reader(geometry, geometryType, m_hasZ, m_hasM);
+        bool bGeometryOK;
+        if (GeometryReader::canReadWKB(geometryType))
         {
-            if (VSIFEofL(m_poFp))
-                break;
-            CPLErrorIO("reading feature size");
-            goto error;
+            bGeometryOK = reader.readWKB(abyWKB);
         }
-        CPL_LSBPTR32(&featureSize);
-
-        // Sanity check to avoid allocated huge amount of memory on corrupted
-        // feature
-        if (featureSize > 100 * 1024 * 1024)
+        else
         {
-            if (featureSize > feature_max_buffer_size)
-            {
-                CPLErrorInvalidSize("feature");
-                goto error;
-            }
-
-            if (m_nFileSize == 0)
+            const auto poOGRGeometry =
+                std::unique_ptr<OGRGeometry>(reader.read());
+            bGeometryOK = poOGRGeometry != nullptr;
+            if (bGeometryOK)
             {
-                VSIStatBufL sStatBuf;
-                if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
-                {
-                    m_nFileSize = sStatBuf.st_size;
-                }
-            }
-            if (m_offset + featureSize > m_nFileSize)
-            {
-                CPLErrorIO("reading feature size");
-                goto error;
+                abyWKB.resize(poOGRGeometry->WkbSize());
+                poOGRGeometry->exportToWkb(wkbNDR, abyWKB.data(),
+                                           wkbVariantIso);
             }
         }
-
-        const auto err = ensureFeatureBuf(featureSize);
-        if (err != OGRERR_NONE)
-            goto error;
-        if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
+        if (!bGeometryOK)
         {
-            CPLErrorIO("reading feature");
-            goto error;
+            CPLError(CE_Failure, CPLE_AppDefined, "Failed to read geometry");
+            return ArrowFeatureStatus::FAILURE;
         }
-        m_offset += featureSize + sizeof(featureSize);
 
-        if (m_bVerifyBuffers)
+        OGREnvelope sEnvelope;
+        if (!FilterWKBGeometry(abyWKB.data(), abyWKB.size(),
+                               /* bEnvelopeAlreadySet = */ false, sEnvelope,
+                               ctxt.poFilterGeom, ctxt.bFilterIsEnvelope,
+                               ctxt.sFilterEnvelope, ctxt.pPreparedFilterGeom))
         {
-            Verifier v(m_featureBuf, featureSize);
-            const auto ok = VerifyFeatureBuffer(v);
-            if (!ok)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Buffer verification failed");
-                CPLDebugOnly("FlatGeobuf", "m_offset: %lu",
-                             static_cast<long unsigned int>(m_offset));
-                CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu",
-                             static_cast<long unsigned int>(m_featuresPos));
-                CPLDebugOnly("FlatGeobuf", "featureSize: %d", featureSize);
-                goto error;
-            }
+            return ArrowFeatureStatus::SKIPPED;
         }
 
-        const auto feature = GetRoot<Feature>(m_featureBuf);
-        const auto geometry = feature->geometry();
-        const auto properties = feature->properties();
-        if (!m_poFeatureDefn->IsGeometryIgnored() && geometry != nullptr)
+        const int iArrowField = sHelper.m_mapOGRGeomFieldToArrowField[0];
+        const size_t nWKBSize = abyWKB.size();
+
+        if (iFeat > 0)
         {
-            auto geometryType = m_geometryType;
-            if (geometryType == GeometryType::Unknown)
-                geometryType = geometry->type();
-            auto poOGRGeometry = std::unique_ptr<OGRGeometry>(
-                GeometryReader(geometry, geometryType, m_hasZ, m_hasM).read());
-            if (poOGRGeometry == nullptr)
+            auto psArray = out_array->children[iArrowField];
+            auto panOffsets = static_cast<int32_t *>(
+                const_cast<void *>(psArray->buffers[1]));
+            const uint32_t nCurLength =
+                static_cast<uint32_t>(panOffsets[iFeat]);
+            if (nWKBSize <= ctxt.nMemLimit &&
+                nWKBSize > ctxt.nMemLimit - nCurLength)
             {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Failed to read geometry");
-                goto error;
+                return ArrowFeatureStatus::BATCH_FULL;
             }
+        }
 
-            if (!FilterGeometry(poOGRGeometry.get()))
-                goto end_of_loop;
+        GByte *outPtr =
+            sHelper.GetPtrForStringOrBinary(iArrowField, iFeat, nWKBSize);
+        if (outPtr == nullptr)
+        {
+            ctxt.errorErrno = ENOMEM;
+            return ArrowFeatureStatus::FAILURE;
+        }
+        memcpy(outPtr, abyWKB.data(), nWKBSize);
+    }
 
-            const int iArrowField = sHelper.m_mapOGRGeomFieldToArrowField[0];
-            const size_t nWKBSize = poOGRGeometry->WkbSize();
+    auto &abSetFields = ctxt.abSetFields;
+    abSetFields.clear();
+    abSetFields.resize(sHelper.m_nFieldCount);
 
-            if (iFeat > 0)
-            {
-                auto psArray = out_array->children[iArrowField];
-                auto panOffsets = static_cast<int32_t *>(
-                    const_cast<void *>(psArray->buffers[1]));
-                const uint32_t nCurLength =
-                    static_cast<uint32_t>(panOffsets[iFeat]);
-                if (nWKBSize <= nMemLimit && nWKBSize > nMemLimit - nCurLength)
-                {
-                    goto after_loop;
-                }
-            }
+    if (properties != nullptr)
+    {
+        const auto data = properties->data();
+        const auto size = properties->size();
 
-            GByte *outPtr =
-                sHelper.GetPtrForStringOrBinary(iArrowField, iFeat, nWKBSize);
-            if (outPtr == nullptr)
-            {
-                errorErrno = ENOMEM;
-                goto error;
-            }
-            poOGRGeometry->exportToWkb(wkbNDR, outPtr, wkbVariantIso);
+        uoffset_t offset = 0;
+        // size must be at least large enough to contain
+        // a single column index and smallest value type
+        if (size > 0 && size < (sizeof(uint16_t) + sizeof(uint8_t)))
+        {
+            CPLErrorInvalidSize("property value");
+            return ArrowFeatureStatus::FAILURE;
         }
 
-        abSetFields.clear();
-        abSetFields.resize(sHelper.m_nFieldCount);
-
-        if (properties != nullptr)
+        while (offset + 1 < size)
         {
-            const auto data = properties->data();
-            const auto size = properties->size();
-
-            uoffset_t offset = 0;
-            // size must be at least large enough to contain
-            // a single column index and smallest value type
-            if (size > 0 && size < (sizeof(uint16_t) + sizeof(uint8_t)))
+            if (offset + sizeof(uint16_t) > size)
             {
                 CPLErrorInvalidSize("property value");
-                goto error;
+                return ArrowFeatureStatus::FAILURE;
             }
-
-            while (offset + 1 < size)
+            uint16_t i;
+            memcpy(&i, data + offset, sizeof(i));
+            CPL_LSBPTR16(&i);
+            offset += sizeof(uint16_t);
+            // TODO: use columns from feature if defined
+            const auto columns = m_poHeader->columns();
+            if (columns == nullptr)
             {
-                if (offset + sizeof(uint16_t) > size)
-                {
-                    CPLErrorInvalidSize("property value");
-                    goto error;
-                }
-                uint16_t i;
-                memcpy(&i, data + offset, sizeof(i));
-                CPL_LSBPTR16(&i);
-                offset += sizeof(uint16_t);
-                // TODO: use columns from feature if defined
-                const auto columns = m_poHeader->columns();
-                if (columns == nullptr)
-                {
-                    CPLErrorInvalidPointer("columns");
-                    goto error;
-                }
-                if (i >= columns->size())
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Column index %hu out of range", i);
-                    goto error;
-                }
-
-                abSetFields[i] = true;
-                const auto column = columns->Get(i);
-                const auto type = column->type();
-                const int iArrowField = sHelper.m_mapOGRFieldToArrowField[i];
-                const bool isIgnored = iArrowField < 0;
-                auto psArray =
-                    isIgnored ? nullptr : out_array->children[iArrowField];
+                CPLErrorInvalidPointer("columns");
+                return ArrowFeatureStatus::FAILURE;
+            }
+            if (i >= columns->size())
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Column index %hu out of range", i);
+                return ArrowFeatureStatus::FAILURE;
+            }
 
-                switch (type)
-                {
-                    case ColumnType::Bool:
-                        if (offset + sizeof(unsigned char) > size)
-                        {
-                            CPLErrorInvalidSize("bool value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            if (*(data + offset))
-                            {
-                                sHelper.SetBoolOn(psArray, iFeat);
-                            }
-                        }
-                        offset += sizeof(unsigned char);
-                        break;
+            abSetFields[i] = true;
+            const auto column = columns->Get(i);
+            const auto type = column->type();
+            const int iArrowField = sHelper.m_mapOGRFieldToArrowField[i];
+            const bool isIgnored = iArrowField < 0;
+            auto psArray =
+                isIgnored ? nullptr : out_array->children[iArrowField];
 
-                    case ColumnType::Byte:
-                        if (offset + sizeof(signed char) > size)
-                        {
-                            CPLErrorInvalidSize("byte value");
-                            goto error;
-                        }
-                        if (!isIgnored)
+            switch (type)
+            {
+                case ColumnType::Bool:
+                    if (offset + sizeof(unsigned char) > size)
+                    {
+                        CPLErrorInvalidSize("bool value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        if (*(data + offset))
                         {
-                            sHelper.SetInt8(psArray, iFeat,
-                                            *reinterpret_cast<const int8_t *>(
-                                                data + offset));
+                            sHelper.SetBoolOn(psArray, iFeat);
                         }
-                        offset += sizeof(signed char);
-                        break;
+                    }
+                    offset += sizeof(unsigned char);
+                    break;
 
-                    case ColumnType::UByte:
-                        if (offset + sizeof(unsigned char) > size)
-                        {
-                            CPLErrorInvalidSize("ubyte value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            sHelper.SetUInt8(psArray, iFeat,
-                                             *reinterpret_cast<const uint8_t *>(
-                                                 data + offset));
-                        }
-                        offset += sizeof(unsigned char);
-                        break;
+                case ColumnType::Byte:
+                    if (offset + sizeof(signed char) > size)
+                    {
+                        CPLErrorInvalidSize("byte value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        sHelper.SetInt8(psArray, iFeat,
+                                        *reinterpret_cast<const int8_t *>(
+                                            data + offset));
+                    }
+                    offset += sizeof(signed char);
+                    break;
 
-                    case ColumnType::Short:
-                        if (offset + sizeof(int16_t) > size)
-                        {
-                            CPLErrorInvalidSize("short value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            short s;
-                            memcpy(&s, data + offset, sizeof(int16_t));
-                            CPL_LSBPTR16(&s);
-                            sHelper.SetInt16(psArray, iFeat, s);
-                        }
-                        offset += sizeof(int16_t);
-                        break;
+                case ColumnType::UByte:
+                    if (offset + sizeof(unsigned char) > size)
+                    {
+                        CPLErrorInvalidSize("ubyte value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        sHelper.SetUInt8(psArray, iFeat,
+                                         *reinterpret_cast<const uint8_t *>(
+                                             data + offset));
+                    }
+                    offset += sizeof(unsigned char);
+                    break;
 
-                    case ColumnType::UShort:
-                        if (offset + sizeof(uint16_t) > size)
-                        {
-                            CPLErrorInvalidSize("ushort value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            uint16_t s;
-                            memcpy(&s, data + offset, sizeof(uint16_t));
-                            CPL_LSBPTR16(&s);
-                            sHelper.SetInt32(psArray, iFeat, s);
-                        }
-                        offset += sizeof(uint16_t);
-                        break;
+                case ColumnType::Short:
+                    if (offset + sizeof(int16_t) > size)
+                    {
+                        CPLErrorInvalidSize("short value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        short s;
+                        memcpy(&s, data + offset, sizeof(int16_t));
+                        CPL_LSBPTR16(&s);
+                        sHelper.SetInt16(psArray, iFeat, s);
+                    }
+                    offset += sizeof(int16_t);
+                    break;
 
-                    case ColumnType::Int:
-                        if (offset + sizeof(int32_t) > size)
-                        {
-                            CPLErrorInvalidSize("int32 value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            int32_t nVal;
-                            memcpy(&nVal, data + offset, sizeof(int32_t));
-                            CPL_LSBPTR32(&nVal);
-                            sHelper.SetInt32(psArray, iFeat, nVal);
-                        }
-                        offset += sizeof(int32_t);
-                        break;
+                case ColumnType::UShort:
+                    if (offset + sizeof(uint16_t) > size)
+                    {
+                        CPLErrorInvalidSize("ushort value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        uint16_t s;
+                        memcpy(&s, data + offset, sizeof(uint16_t));
+                        CPL_LSBPTR16(&s);
+                        sHelper.SetInt32(psArray, iFeat, s);
+                    }
+                    offset += sizeof(uint16_t);
+                    break;
 
-                    case ColumnType::UInt:
-                        if (offset + sizeof(uint32_t) > size)
-                        {
-                            CPLErrorInvalidSize("uint value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            uint32_t v;
-                            memcpy(&v, data + offset, sizeof(int32_t));
-                            CPL_LSBPTR32(&v);
-                            sHelper.SetInt64(psArray, iFeat, v);
-                        }
-                        offset += sizeof(int32_t);
-                        break;
+                case ColumnType::Int:
+                    if (offset + sizeof(int32_t) > size)
+                    {
+                        CPLErrorInvalidSize("int32 value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        int32_t nVal;
+                        memcpy(&nVal, data + offset, sizeof(int32_t));
+                        CPL_LSBPTR32(&nVal);
+                        sHelper.SetInt32(psArray, iFeat, nVal);
+                    }
+                    offset += sizeof(int32_t);
+                    break;
 
-                    case ColumnType::Long:
-                        if (offset + sizeof(int64_t) > size)
-                        {
-                            CPLErrorInvalidSize("int64 value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            int64_t v;
-                            memcpy(&v, data + offset, sizeof(int64_t));
-                            CPL_LSBPTR64(&v);
-                            sHelper.SetInt64(psArray, iFeat, v);
-                        }
-                        offset += sizeof(int64_t);
-                        break;
+                case ColumnType::UInt:
+                    if (offset + sizeof(uint32_t) > size)
+                    {
+                        CPLErrorInvalidSize("uint value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        uint32_t v;
+                        memcpy(&v, data + offset, sizeof(int32_t));
+                        CPL_LSBPTR32(&v);
+                        sHelper.SetInt64(psArray, iFeat, v);
+                    }
+                    offset += sizeof(int32_t);
+                    break;
 
-                    case ColumnType::ULong:
-                        if (offset + sizeof(uint64_t) > size)
-                        {
-                            CPLErrorInvalidSize("uint64 value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            uint64_t v;
-                            memcpy(&v, data + offset, sizeof(v));
-                            CPL_LSBPTR64(&v);
-                            sHelper.SetDouble(psArray, iFeat,
-                                              static_cast<double>(v));
-                        }
-                        offset += sizeof(int64_t);
-                        break;
+                case ColumnType::Long:
+                    if (offset + sizeof(int64_t) > size)
+                    {
+                        CPLErrorInvalidSize("int64 value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        int64_t v;
+                        memcpy(&v, data + offset, sizeof(int64_t));
+                        CPL_LSBPTR64(&v);
+                        sHelper.SetInt64(psArray, iFeat, v);
+                    }
+                    offset += sizeof(int64_t);
+                    break;
 
-                    case ColumnType::Float:
-                        if (offset + sizeof(float) > size)
-                        {
-                            CPLErrorInvalidSize("float value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            float f;
-                            memcpy(&f, data + offset, sizeof(float));
-                            CPL_LSBPTR32(&f);
-                            sHelper.SetFloat(psArray, iFeat, f);
-                        }
-                        offset += sizeof(float);
-                        break;
+                case ColumnType::ULong:
+                    if (offset + sizeof(uint64_t) > size)
+                    {
+                        CPLErrorInvalidSize("uint64 value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        uint64_t v;
+                        memcpy(&v, data + offset, sizeof(v));
+                        CPL_LSBPTR64(&v);
+                        sHelper.SetDouble(psArray, iFeat,
+                                          static_cast<double>(v));
+                    }
+                    offset += sizeof(int64_t);
+                    break;
 
-                    case ColumnType::Double:
-                        if (offset + sizeof(double) > size)
-                        {
-                            CPLErrorInvalidSize("double value");
-                            goto error;
-                        }
-                        if (!isIgnored)
-                        {
-                            double v;
-                            memcpy(&v, data + offset, sizeof(double));
-                            CPL_LSBPTR64(&v);
-                            sHelper.SetDouble(psArray, iFeat, v);
-                        }
-                        offset += sizeof(double);
-                        break;
+                case ColumnType::Float:
+                    if (offset + sizeof(float) > size)
+                    {
+                        CPLErrorInvalidSize("float value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        float f;
+                        memcpy(&f, data + offset, sizeof(float));
+                        CPL_LSBPTR32(&f);
+                        sHelper.SetFloat(psArray, iFeat, f);
+                    }
+                    offset += sizeof(float);
+                    break;
 
-                    case ColumnType::DateTime:
+                case ColumnType::Double:
+                    if (offset + sizeof(double) > size)
                     {
-                        if (!bDateTimeAsString)
-                        {
-                            if (offset + sizeof(uint32_t) > size)
-                            {
-                                CPLErrorInvalidSize("datetime length ");
-                                goto error;
-                            }
-                            uint32_t len;
-                            memcpy(&len, data + offset, sizeof(int32_t));
-                            CPL_LSBPTR32(&len);
-                            offset += sizeof(uint32_t);
-                            if (len > size - offset || len > 32)
-                            {
-                                CPLErrorInvalidSize("datetime value");
-                                goto error;
-                            }
-                            if (!isIgnored)
-                            {
-                                OGRField ogrField;
-                                if (ParseDateTime(
-                                        std::string_view(
-                                            reinterpret_cast<const char *>(
-                                                data + offset),
-                                            len),
-                                        &ogrField))
-                                {
-                                    sHelper.SetDateTime(
-                                        psArray, iFeat, brokenDown,
-                                        sHelper.m_anTZFlags[i], ogrField);
-                                }
-                                else
-                                {
-                                    char str[32 + 1];
-                                    memcpy(str, data + offset, len);
-                                    str[len] = '\0';
-                                    if (OGRParseDate(str, &ogrField, 0))
-                                    {
-                                        sHelper.SetDateTime(
-                                            psArray, iFeat, brokenDown,
-                                            sHelper.m_anTZFlags[i], ogrField);
-                                    }
-                                }
-                            }
-                            offset += len;
-                            break;
-                        }
-                        else
-                        {
-                            [[fallthrough]];
-                        }
+                        CPLErrorInvalidSize("double value");
+                        return ArrowFeatureStatus::FAILURE;
                     }
+                    if (!isIgnored)
+                    {
+                        double v;
+                        memcpy(&v, data + offset, sizeof(double));
+                        CPL_LSBPTR64(&v);
+                        sHelper.SetDouble(psArray, iFeat, v);
+                    }
+                    offset += sizeof(double);
+                    break;
 
-                    case ColumnType::String:
-                    case ColumnType::Json:
-                    case ColumnType::Binary:
+                case ColumnType::DateTime:
+                {
+                    if (!ctxt.bDateTimeAsString)
                     {
                         if (offset + sizeof(uint32_t) > size)
                         {
-                            CPLErrorInvalidSize("string length");
-                            goto error;
+                            CPLErrorInvalidSize("datetime length ");
+                            return ArrowFeatureStatus::FAILURE;
                         }
                         uint32_t len;
                         memcpy(&len, data + offset, sizeof(int32_t));
                         CPL_LSBPTR32(&len);
                         offset += sizeof(uint32_t);
-                        if (len > size - offset)
+                        if (len > size - offset || len > 32)
                         {
-                            CPLErrorInvalidSize("string value");
-                            goto error;
+                            CPLErrorInvalidSize("datetime value");
+                            return ArrowFeatureStatus::FAILURE;
                         }
                         if (!isIgnored)
                         {
-                            if (iFeat > 0)
+                            OGRField ogrField;
+                            if (ParseDateTime(
+                                    std::string_view(
+                                        reinterpret_cast<const char *>(data +
+                                                                       offset),
+                                        len),
+                                    &ogrField))
                             {
-                                auto panOffsets = static_cast<int32_t *>(
-                                    const_cast<void *>(psArray->buffers[1]));
-                                const uint32_t nCurLength =
-                                    static_cast<uint32_t>(panOffsets[iFeat]);
-                                if (len <= nMemLimit &&
-                                    len > nMemLimit - nCurLength)
-                                {
-                                    goto after_loop;
-                                }
+                                sHelper.SetDateTime(
+                                    psArray, iFeat, ctxt.brokenDown,
+                                    sHelper.m_anTZFlags[i], ogrField);
                             }
-
-                            GByte *outPtr = sHelper.GetPtrForStringOrBinary(
-                                iArrowField, iFeat, len);
-                            if (outPtr == nullptr)
+                            else
                             {
-                                errorErrno = ENOMEM;
-                                goto error;
+                                char str[32 + 1];
+                                memcpy(str, data + offset, len);
+                                str[len] = '\0';
+                                if (OGRParseDate(str, &ogrField, 0))
+                                {
+                                    sHelper.SetDateTime(
+                                        psArray, iFeat, ctxt.brokenDown,
+                                        sHelper.m_anTZFlags[i], ogrField);
+                                }
                             }
-                            memcpy(outPtr, data + offset, len);
                         }
                         offset += len;
                         break;
                     }
+                    else
+                    {
+                        [[fallthrough]];
+                    }
                 }
-            }
-        }
 
-        // Mark null fields
-        for (int i = 0; i < sHelper.m_nFieldCount; i++)
-        {
-            if (!abSetFields[i] && sHelper.m_abNullableFields[i])
-            {
-                const int iArrowField = sHelper.m_mapOGRFieldToArrowField[i];
-                if (iArrowField >= 0)
+                case ColumnType::String:
+                case ColumnType::Json:
+                case ColumnType::Binary:
                 {
-                    sHelper.SetNull(iArrowField, iFeat);
+                    if (offset + sizeof(uint32_t) > size)
+                    {
+                        CPLErrorInvalidSize("string length");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    uint32_t len;
+                    memcpy(&len, data + offset, sizeof(int32_t));
+                    CPL_LSBPTR32(&len);
+                    offset += sizeof(uint32_t);
+                    if (len > size - offset)
+                    {
+                        CPLErrorInvalidSize("string value");
+                        return ArrowFeatureStatus::FAILURE;
+                    }
+                    if (!isIgnored)
+                    {
+                        if (iFeat > 0)
+                        {
+                            auto panOffsets = static_cast<int32_t *>(
+                                const_cast<void *>(psArray->buffers[1]));
+                            const uint32_t nCurLength =
+                                static_cast<uint32_t>(panOffsets[iFeat]);
+                            if (len <= ctxt.nMemLimit &&
+                                len > ctxt.nMemLimit - nCurLength)
+                            {
+                                return ArrowFeatureStatus::BATCH_FULL;
+                            }
+                        }
+
+                        GByte *outPtr = sHelper.GetPtrForStringOrBinary(
+                            iArrowField, iFeat, len);
+                        if (outPtr == nullptr)
+                        {
+                            ctxt.errorErrno = ENOMEM;
+                            return ArrowFeatureStatus::FAILURE;
+                        }
+                        memcpy(outPtr, data + offset, len);
+                    }
+                    offset += len;
+                    break;
                 }
             }
         }
+    }
 
-        iFeat++;
-
-    end_of_loop:
-
-        if (VSIFEofL(m_poFp) || VSIFErrorL(m_poFp))
+    // Mark null fields
+    for (int i = 0; i < sHelper.m_nFieldCount; i++)
+    {
+        if (!abSetFields[i] && sHelper.m_abNullableFields[i])
         {
-            CPLDebug("FlatGeobuf", "GetNextFeature: iteration end due to EOF");
-            break;
+            const int iArrowField = sHelper.m_mapOGRFieldToArrowField[i];
+            if (iArrowField >= 0)
+            {
+                sHelper.SetNull(iArrowField, iFeat);
+            }
         }
-
-        m_featuresPos++;
-        bEOFOrError = false;
     }
-after_loop:
-    if (bEOFOrError)
-        m_bEOF = true;
 
-    sHelper.Shrink(iFeat);
+    return ArrowFeatureStatus::OK;
+}
+
+/************************************************************************/
+/*                    PostFilterAndKeepArrowArray()                     */
+/************************************************************************/
 
+// Applies the attribute filter to out_array. Releases it and returns false
+// if it ends up empty.
+bool OGRFlatGeobufLayer::PostFilterAndKeepArrowArray(
+    struct ArrowArrayStream *stream, struct ArrowArray *out_array,
+    GIntBig nFeatureIdxStart)
+{
     if (out_array->length != 0 && m_poAttrQuery)
     {
         struct ArrowSchema schema;
@@ -2014,7 +2107,8 @@ after_loop:
         auto poFilterGeomBackup = m_poFilterGeom;
         m_poFilterGeom = nullptr;
         CPLStringList aosOptions;
-        if (!m_poFilterGeom)
+        // FIDs are only sequential when there is no spatial filter
+        if (!poFilterGeomBackup)
         {
             aosOptions.SetNameValue("BASE_SEQUENTIAL_FID",
                                     CPLSPrintf(CPL_FRMT_GIB, nFeatureIdxStart));
@@ -2029,18 +2123,360 @@ after_loop:
         if (out_array->release)
             out_array->release(out_array);
         memset(out_array, 0, sizeof(*out_array));
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       FillArrowArrayFromJob()                        */
+/*                                                                      */
+/*      Called from worker threads to decode the features of a job.     */
+/************************************************************************/
+
+void OGRFlatGeobufLayer::FillArrowArrayFromJob(ArrowArrayJob &job) const
+{
+    OGRArrowArrayHelper sHelper(
+        nullptr,  // dataset pointer. only used for field domains (not used by
+                  // FlatGeobuf)
+        m_poFeatureDefn, m_aosArrowArrayStreamOptions, &job.sArray);
+    if (job.sArray.release == nullptr)
+    {
+        job.nErrno = ENOMEM;
+        return;
+    }
+
+    const auto &oReader = *m_poArrowArrayReader;
+    ArrowFeatureContext ctxt(
+        oReader.poFilterGeom.get(), oReader.bFilterIsEnvelope,
+        oReader.sFilterEnvelope,
+        m_aosArrowArrayStreamOptions.FetchBool(GAS_OPT_DATETIME_AS_STRING,
+                                               false));
+
+    int iFeat = 0;
+    size_t i = job.iFirstFeature;
+    for (; i < job.anFIDs.size() && iFeat < sHelper.m_nMaxBatchSize; ++i)
+    {
+        const size_t nFeatureOffset = job.anFeatureOffsets[i];
+        const auto eStatus = FillArrowArrayFeature(
+            job.abyFeatures.data() + nFeatureOffset,
+            static_cast<uint32_t>(job.anFeatureOffsets[i + 1] -
+                                  nFeatureOffset),
+            job.anFIDs[i], sHelper, &job.sArray, iFeat, ctxt);
+        if (eStatus == ArrowFeatureStatus::FAILURE)
+        {
+            sHelper.ClearArray();
+            job.nErrno = ctxt.errorErrno;
+            return;
+        }
+        if (eStatus == ArrowFeatureStatus::BATCH_FULL)
+            break;
+        if (eStatus == ArrowFeatureStatus::OK)
+            ++iFeat;
+    }
+    job.iNextFeature = i;
+    sHelper.Shrink(iFeat);
+}
+
+/************************************************************************/
+/*                        SubmitArrowArrayJob()                         */
+/************************************************************************/
+
+void OGRFlatGeobufLayer::SubmitArrowArrayJob(ArrowArrayJob *psJob)
+{
+    auto &oReader = *m_poArrowArrayReader;
+    const auto RunJob = [this, psJob, &oReader]()
+    {
+        {
+            auto oContext = psJob->oErrorAccumulator.InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oContext);
+            FillArrowArrayFromJob(*psJob);
+        }
+        std::lock_guard oLock(oReader.oMutex);
+        psJob->bFinished = true;
+        oReader.oCV.notify_all();
+    };
+    if (!oReader.poJobQueue->SubmitJob(RunJob))
+        RunJob();
+}
+
+/************************************************************************/
+/*                       SubmitArrowArrayJobs()                         */
+/*                                                                      */
+/*      Read the data of the next features, and submit it to worker     */
+/*      threads, until the maximum number of pending jobs is reached.   */
+/************************************************************************/
+
+void OGRFlatGeobufLayer::SubmitArrowArrayJobs()
+{
+    auto &oReader = *m_poArrowArrayReader;
+    const size_t nMaxBatchSize = static_cast<size_t>(
+        OGRArrowArrayHelper::GetMaxFeaturesInBatch(
+            m_aosArrowArrayStreamOptions));
+
+    while (!oReader.bFinished && oReader.apoJobs.size() < oReader.nMaxJobs)
+    {
+        auto poJob = std::make_unique<ArrowArrayJob>();
+        poJob->anFeatureOffsets.push_back(0);
+        while (poJob->anFIDs.size() < nMaxBatchSize &&
+               poJob->abyFeatures.size() < FGB_ARROW_JOB_SIZE)
+        {
+            GIntBig fid = 0;
+            uint32_t featureSize = 0;
+            const int ret = readNextFeatureSize(fid, featureSize);
+            if (ret <= 0)
+            {
+                oReader.bFinished = true;
+                if (ret < 0)
+                    oReader.nErrno = EIO;
+                break;
+            }
+
+            const size_t nOldSize = poJob->abyFeatures.size();
+            try
+            {
+                poJob->abyFeatures.resize(nOldSize + featureSize);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLErrorMemoryAllocation("feature buffer");
+                oReader.bFinished = true;
+                oReader.nErrno = ENOMEM;
+                break;
+            }
+            if (VSIFReadL(poJob->abyFeatures.data() + nOldSize, 1, featureSize,
+                          m_poFp) != featureSize)
+            {
+                CPLErrorIO("reading feature");
+                oReader.bFinished = true;
+                oReader.nErrno = EIO;
+                break;
+            }
+            m_offset += featureSize + sizeof(featureSize);
+            poJob->anFeatureOffsets.push_back(poJob->abyFeatures.size());
+            poJob->anFIDs.push_back(fid);
+
+            if (VSIFEofL(m_poFp) || VSIFErrorL(m_poFp))
+            {
+                CPLDebug("FlatGeobuf",
+                         "GetNextArrowArray: iteration end due to EOF");
+                oReader.bFinished = true;
+                break;
+            }
+            m_featuresPos++;
+        }
+
+        // Features of a batch in error are not returned, as in the
+        // single-threaded implementation.
+        if (poJob->anFIDs.empty() || oReader.nErrno != 0)
+            break;
+
+        ArrowArrayJob *psJob = poJob.get();
+        oReader.apoJobs.push_back(std::move(poJob));
+        SubmitArrowArrayJob(psJob);
+    }
+}
+
+/************************************************************************/
+/*                     GetNextArrowArrayParallel()                      */
+/************************************************************************/
+
+// The thread consuming the stream reads the data of features, for example
+// the ones selected by the spatial index, and worker threads decode them
+// into ArrowArray batches, which are returned in the order of the
+// features.
+int OGRFlatGeobufLayer::GetNextArrowArrayParallel(
+    struct ArrowArrayStream *stream, struct ArrowArray *out_array)
+{
+    auto &oReader = *m_poArrowArrayReader;
+    while (true)
+    {
+        SubmitArrowArrayJobs();
+        if (oReader.apoJobs.empty())
+        {
+            const int nErrno = oReader.nErrno;
+            oReader.nErrno = 0;
+            return nErrno;
+        }
+
+        auto poJob = std::move(oReader.apoJobs.front());
+        oReader.apoJobs.pop_front();
+        {
+            std::unique_lock oLock(oReader.oMutex);
+            oReader.oCV.wait(oLock, [&poJob] { return poJob->bFinished; });
+        }
+
+        poJob->oErrorAccumulator.ReplayErrors();
+        const GIntBig nFirstFID = poJob->anFIDs[poJob->iFirstFeature];
+        if (poJob->nErrno != 0)
+        {
+            // Stop iterating at the first error
+            oReader.poJobQueue->WaitCompletion();
+            oReader.apoJobs.clear();
+            oReader.bFinished = true;
+            return poJob->nErrno;
+        }
+
+        if (poJob->iNextFeature < poJob->anFIDs.size())
+        {
+            // The batch is full: remaining features go to a new job, which
+            // must be the next one to be returned.
+            auto poNewJob = std::make_unique<ArrowArrayJob>();
+            poNewJob->abyFeatures = std::move(poJob->abyFeatures);
+            poNewJob->anFeatureOffsets = std::move(poJob->anFeatureOffsets);
+            poNewJob->anFIDs = std::move(poJob->anFIDs);
+            poNewJob->iFirstFeature = poJob->iNextFeature;
+            ArrowArrayJob *psNewJob = poNewJob.get();
+            oReader.apoJobs.push_front(std::move(poNewJob));
+            SubmitArrowArrayJob(psNewJob);
+        }
+        else
+        {
+            // Keep worker threads busy while the caller processes this batch
+            SubmitArrowArrayJobs();
+        }
+
+        *out_array = poJob->sArray;
+        memset(&poJob->sArray, 0, sizeof(poJob->sArray));
+        if (PostFilterAndKeepArrowArray(stream, out_array, nFirstFID))
+            return 0;
+    }
+}
+
+/************************************************************************/
+/*                      GetNextArrowArray()                             */
+/************************************************************************/
+
+int OGRFlatGeobufLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                          struct ArrowArray *out_array)
+{
+    if (!m_poSharedArrowArrayStreamPrivateData->m_anQueriedFIDs.empty() ||
+        CPLTestBool(
+            CPLGetConfigOption("OGR_FLATGEOBUF_STREAM_BASE_IMPL", "NO")))
+    {
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+begin:
+    memset(out_array, 0, sizeof(*out_array));
+
+    if (m_create)
+        return EINVAL;
+
+    if (m_poArrowArrayReader)
+        return GetNextArrowArrayParallel(stream, out_array);
+
+    if (m_bEOF || (m_featuresCount > 0 && m_featuresPos >= m_featuresCount))
+    {
+        return 0;
+    }
+
+    if (readIndex() != OGRERR_NONE)
+        return EIO;
+
+    const int nThreads =
+        OGRGetNumThreadsForArrowArray("OGR_FLATGEOBUF_NUM_THREADS");
+    if (nThreads > 1)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+        {
+            m_poArrowArrayReader = std::make_unique<ArrowArrayReader>();
+            m_poArrowArrayReader->poJobQueue = poThreadPool->CreateJobQueue();
+            m_poArrowArrayReader->nMaxJobs = 2 * static_cast<size_t>(nThreads);
+            if (m_poFilterGeom)
+            {
+                m_poArrowArrayReader->poFilterGeom.reset(
+                    m_poFilterGeom->clone());
+                m_poArrowArrayReader->bFilterIsEnvelope =
+                    CPL_TO_BOOL(m_bFilterIsEnvelope);
+                m_poArrowArrayReader->sFilterEnvelope = m_sFilterEnvelope;
+            }
+            return GetNextArrowArrayParallel(stream, out_array);
+        }
+    }
+
+    OGRArrowArrayHelper sHelper(
+        nullptr,  // dataset pointer. only used for field domains (not used by
+                  // FlatGeobuf)
+        m_poFeatureDefn, m_aosArrowArrayStreamOptions, out_array);
+    if (out_array->release == nullptr)
+    {
+        return ENOMEM;
+    }
+
+    ArrowFeatureContext ctxt(m_poFilterGeom, CPL_TO_BOOL(m_bFilterIsEnvelope),
+                             m_sFilterEnvelope,
+                             m_aosArrowArrayStreamOptions.FetchBool(
+                                 GAS_OPT_DATETIME_AS_STRING, false));
+
+    int iFeat = 0;
+    bool bEOFOrError = true;
+
+    const GIntBig nFeatureIdxStart = m_featuresPos;
+
+    while (iFeat < sHelper.m_nMaxBatchSize)
+    {
+        bEOFOrError = true;
+
+        GIntBig fid = 0;
+        uint32_t featureSize = 0;
+        const int ret = readNextFeatureSize(fid, featureSize);
+        if (ret == 0)
+            break;
+        if (ret < 0)
+            goto error;
+
+        if (ensureFeatureBuf(featureSize) != OGRERR_NONE)
+            goto error;
+        if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
+        {
+            CPLErrorIO("reading feature");
+            goto error;
+        }
+        m_offset += featureSize + sizeof(featureSize);
 
-        if (m_poAttrQuery || m_poFilterGeom)
+        const auto eStatus = FillArrowArrayFeature(
+            m_featureBuf, featureSize, fid, sHelper, out_array, iFeat, ctxt);
+        if (eStatus == ArrowFeatureStatus::FAILURE)
+            goto error;
+        if (eStatus == ArrowFeatureStatus::BATCH_FULL)
         {
-            goto begin;
+            // Read that feature again for the next batch
+            m_offset -= featureSize + sizeof(featureSize);
+            if (VSIFSeekL(m_poFp, m_offset, SEEK_SET) != 0)
+                goto error;
+            bEOFOrError = false;
+            break;
         }
+        if (eStatus == ArrowFeatureStatus::OK)
+            iFeat++;
+
+        if (VSIFEofL(m_poFp) || VSIFErrorL(m_poFp))
+        {
+            CPLDebug("FlatGeobuf", "GetNextFeature: iteration end due to EOF");
+            break;
+        }
+
+        m_featuresPos++;
+        bEOFOrError = false;
+    }
+    if (bEOFOrError)
+        m_bEOF = true;
+
+    sHelper.Shrink(iFeat);
+
+    if (!PostFilterAndKeepArrowArray(stream, out_array, nFeatureIdxStart) &&
+        (m_poAttrQuery || m_poFilterGeom))
+    {
+        goto begin;
     }
 
     return 0;
 
 error:
     sHelper.ClearArray();
-    return errorErrno;
+    return ctxt.errorErrno;
 }
 
 OGRErr OGRFlatGeobufLayer::CreateField(const OGRFieldDefn *poField,
@@ -2067,6 +2503,104 @@ OGRErr OGRFlatGeobufLayer::CreateField(const OGRFieldDefn *poField,
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                          AppendProperty()                            */
+/************************************************************************/
+
+// Helpers to serialize property values, as done by ICreateFeature() and
+// WriteArrowBatch()
+
+template <class T>
+static void AppendProperty(std::vector<uint8_t> &properties, T val)
+{
+    if constexpr (sizeof(T) == 2)
+        CPL_LSBPTR16(&val);
+    else if constexpr (sizeof(T) == 4)
+        CPL_LSBPTR32(&val);
+    else if constexpr (sizeof(T) == 8)
+        CPL_LSBPTR64(&val);
+    std::copy(reinterpret_cast<const uint8_t *>(&val),
+              reinterpret_cast<const uint8_t *>(&val + 1),
+              std::back_inserter(properties));
+}
+
+static void AppendIntegerProperty(std::vector<uint8_t> &properties,
+                                  OGRFieldSubType fieldSubType, int nVal)
+{
+    if (fieldSubType == OFSTBoolean)
+        AppendProperty(properties, static_cast<GByte>(nVal));
+    else if (fieldSubType == OFSTInt16)
+        AppendProperty(properties, static_cast<short>(nVal));
+    else
+        AppendProperty(properties, nVal);
+}
+
+static void AppendRealProperty(std::vector<uint8_t> &properties,
+                               OGRFieldSubType fieldSubType, double dfVal)
+{
+    if (fieldSubType == OFSTFloat32)
+        AppendProperty(properties, static_cast<float>(dfVal));
+    else
+        AppendProperty(properties, dfVal);
+}
+
+static void AppendDateTimeProperty(std::vector<uint8_t> &properties,
+                                   const OGRField *field)
+{
+    char szBuffer[OGR_SIZEOF_ISO8601_DATETIME_BUFFER];
+    const size_t len = OGRGetISO8601DateTime(field, false, szBuffer);
+    AppendProperty(properties, static_cast<uint32_t>(len));
+    std::copy(szBuffer, szBuffer + len, std::back_inserter(properties));
+}
+
+static OGRErr AppendStringOrBinaryProperty(std::vector<uint8_t> &properties,
+                                           const GByte *pabyData, size_t len,
+                                           bool bIsString)
+{
+    const char *pszType = bIsString ? "String" : "Binary";
+    if (len >= feature_max_buffer_size ||
+        properties.size() > feature_max_buffer_size - len)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "ICreateFeature: %s too long",
+                 pszType);
+        return OGRERR_FAILURE;
+    }
+    if (bIsString &&
+        !CPLIsUTF8(reinterpret_cast<const char *>(pabyData),
+                   static_cast<int>(len)))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "ICreateFeature: String '%s' is not a valid UTF-8 string",
+                 std::string(reinterpret_cast<const char *>(pabyData), len)
+                     .c_str());
+        return OGRERR_FAILURE;
+    }
+
+    // Valid cast since feature_max_buffer_size is 2 GB
+    AppendProperty(properties, static_cast<uint32_t>(len));
+    try
+    {
+        // to avoid coverity scan warning: "To avoid a quadratic
+        // time penalty when using reserve(), always increase the
+        // capacity
+        /// by a multiple of its current value"
+        if (properties.size() + len > properties.capacity() &&
+            properties.size() < std::numeric_limits<size_t>::max() / 2)
+        {
+            properties.reserve(
+                std::max(2 * properties.size(), properties.size() + len));
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "ICreateFeature: %s too long",
+                 pszType);
+        return OGRERR_FAILURE;
+    }
+    std::copy(pabyData, pabyData + len, std::back_inserter(properties));
+    return OGRERR_NONE;
+}
+
 OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
 {
     if (!m_create)
@@ -2090,182 +2624,49 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
         if (!poNewFeature->IsFieldSetAndNotNull(i))
             continue;
 
-        uint16_t column_index_le = static_cast<uint16_t>(i);
-        CPL_LSBPTR16(&column_index_le);
-
-        // CPLDebugOnly("FlatGeobuf", "DEBUG ICreateFeature: column_index_le:
-        // %hu", column_index_le);
-
-        std::copy(reinterpret_cast<const uint8_t *>(&column_index_le),
-                  reinterpret_cast<const uint8_t *>(&column_index_le + 1),
-                  std::back_inserter(properties));
+        AppendProperty(properties, static_cast<uint16_t>(i));
 
-        const auto fieldType = fieldDef->GetType();
-        const auto fieldSubType = fieldDef->GetSubType();
-        const auto field = poNewFeature->GetRawFieldRef(i);
-        switch (fieldType)
-        {
-            case OGRFieldType::OFTInteger:
-            {
-                int nVal = field->Integer;
-                if (fieldSubType == OFSTBoolean)
-                {
-                    GByte byVal = static_cast<GByte>(nVal);
-                    std::copy(reinterpret_cast<const uint8_t *>(&byVal),
-                              reinterpret_cast<const uint8_t *>(&byVal + 1),
-                              std::back_inserter(properties));
-                }
-                else if (fieldSubType == OFSTInt16)
-                {
-                    short sVal = static_cast<short>(nVal);
-                    CPL_LSBPTR16(&sVal);
-                    std::copy(reinterpret_cast<const uint8_t *>(&sVal),
-                              reinterpret_cast<const uint8_t *>(&sVal + 1),
-                              std::back_inserter(properties));
-                }
-                else
-                {
-                    CPL_LSBPTR32(&nVal);
-                    std::copy(reinterpret_cast<const uint8_t *>(&nVal),
-                              reinterpret_cast<const uint8_t *>(&nVal + 1),
-                              std::back_inserter(properties));
-                }
+        const auto fieldType = fieldDef->GetType();
+        const auto fieldSubType = fieldDef->GetSubType();
+        const auto field = poNewFeature->GetRawFieldRef(i);
+        switch (fieldType)
+        {
+            case OGRFieldType::OFTInteger:
+                AppendIntegerProperty(properties, fieldSubType,
+                                      field->Integer);
                 break;
-            }
             case OGRFieldType::OFTInteger64:
-            {
-                GIntBig nVal = field->Integer64;
-                CPL_LSBPTR64(&nVal);
-                std::copy(reinterpret_cast<const uint8_t *>(&nVal),
-                          reinterpret_cast<const uint8_t *>(&nVal + 1),
-                          std::back_inserter(properties));
+                AppendProperty(properties,
+                               static_cast<int64_t>(field->Integer64));
                 break;
-            }
             case OGRFieldType::OFTReal:
-            {
-                double dfVal = field->Real;
-                if (fieldSubType == OFSTFloat32)
-                {
-                    float fVal = static_cast<float>(dfVal);
-                    CPL_LSBPTR32(&fVal);
-                    std::copy(reinterpret_cast<const uint8_t *>(&fVal),
-                              reinterpret_cast<const uint8_t *>(&fVal + 1),
-                              std::back_inserter(properties));
-                }
-                else
-                {
-                    CPL_LSBPTR64(&dfVal);
-                    std::copy(reinterpret_cast<const uint8_t *>(&dfVal),
-                              reinterpret_cast<const uint8_t *>(&dfVal + 1),
-                              std::back_inserter(properties));
-                }
+                AppendRealProperty(properties, fieldSubType, field->Real);
                 break;
-            }
             case OGRFieldType::OFTDate:
             case OGRFieldType::OFTTime:
             case OGRFieldType::OFTDateTime:
-            {
-                char szBuffer[OGR_SIZEOF_ISO8601_DATETIME_BUFFER];
-                const size_t len =
-                    OGRGetISO8601DateTime(field, false, szBuffer);
-                uint32_t l_le = static_cast<uint32_t>(len);
-                CPL_LSBPTR32(&l_le);
-                std::copy(reinterpret_cast<const uint8_t *>(&l_le),
-                          reinterpret_cast<const uint8_t *>(&l_le + 1),
-                          std::back_inserter(properties));
-                std::copy(szBuffer, szBuffer + len,
-                          std::back_inserter(properties));
+                AppendDateTimeProperty(properties, field);
                 break;
-            }
             case OGRFieldType::OFTString:
-            {
-                const size_t len = strlen(field->String);
-                if (len >= feature_max_buffer_size ||
-                    properties.size() > feature_max_buffer_size - len)
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "ICreateFeature: String too long");
-                    return OGRERR_FAILURE;
-                }
-                if (!CPLIsUTF8(field->String, static_cast<int>(len)))
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "ICreateFeature: String '%s' is not a valid UTF-8 "
-                             "string",
-                             field->String);
-                    return OGRERR_FAILURE;
-                }
-
-                // Valid cast since feature_max_buffer_size is 2 GB
-                uint32_t l_le = static_cast<uint32_t>(len);
-                CPL_LSBPTR32(&l_le);
-                std::copy(reinterpret_cast<const uint8_t *>(&l_le),
-                          reinterpret_cast<const uint8_t *>(&l_le + 1),
-                          std::back_inserter(properties));
-                try
-                {
-                    // to avoid coverity scan warning: "To avoid a quadratic
-                    // time penalty when using reserve(), always increase the
-                    // capacity
-                    /// by a multiple of its current value"
-                    if (properties.size() + len > properties.capacity() &&
-                        properties.size() <
-                            std::numeric_limits<size_t>::max() / 2)
-                    {
-                        properties.reserve(std::max(2 * properties.size(),
-                                                    properties.size() + len));
-                    }
-                }
-                catch (const std::bad_alloc &)
+                if (AppendStringOrBinaryProperty(
+                        properties,
+                        reinterpret_cast<const GByte *>(field->String),
+                        strlen(field->String),
+                        /* bIsString = */ true) != OGRERR_NONE)
                 {
-                    CPLError(CE_Failure, CPLE_OutOfMemory,
-                             "ICreateFeature: String too long");
                     return OGRERR_FAILURE;
                 }
-                std::copy(field->String, field->String + len,
-                          std::back_inserter(properties));
                 break;
-            }
 
             case OGRFieldType::OFTBinary:
-            {
-                const size_t len = field->Binary.nCount;
-                if (len >= feature_max_buffer_size ||
-                    properties.size() > feature_max_buffer_size - len)
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "ICreateFeature: Binary too long");
-                    return OGRERR_FAILURE;
-                }
-                uint32_t l_le = static_cast<uint32_t>(len);
-                CPL_LSBPTR32(&l_le);
-                std::copy(reinterpret_cast<const uint8_t *>(&l_le),
-                          reinterpret_cast<const uint8_t *>(&l_le + 1),
-                          std::back_inserter(properties));
-                try
-                {
-                    // to avoid coverity scan warning: "To avoid a quadratic
-                    // time penalty when using reserve(), always increase the
-                    // capacity
-                    /// by a multiple of its current value"
-                    if (properties.size() + len > properties.capacity() &&
-                        properties.size() <
-                            std::numeric_limits<size_t>::max() / 2)
-                    {
-                        properties.reserve(std::max(2 * properties.size(),
-                                                    properties.size() + len));
-                    }
-                }
-                catch (const std::bad_alloc &)
+                if (AppendStringOrBinaryProperty(
+                        properties, field->Binary.paData,
+                        field->Binary.nCount,
+                        /* bIsString = */ false) != OGRERR_NONE)
                 {
-                    CPLError(CE_Failure, CPLE_OutOfMemory,
-                             "ICreateFeature: Binary too long");
                     return OGRERR_FAILURE;
                 }
-                std::copy(field->Binary.paData, field->Binary.paData + len,
-                          std::back_inserter(properties));
                 break;
-            }
 
             default:
                 CPLError(CE_Failure, CPLE_AppDefined,
@@ -2325,81 +2726,680 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
                                   m_hasM};
             geometryOffset = writer.write(0);
         }
-        const auto pProperties = properties.empty() ? nullptr : &properties;
-        if (properties.size() > feature_max_buffer_size - geometryOffset.o)
+        OGREnvelope sEnvelope;
+        if (ogrGeometry != nullptr)
+            ogrGeometry->getEnvelope(&sEnvelope);
+        return writeFeature(fbb, properties, geometryOffset,
+                            ogrGeometry ? &sEnvelope : nullptr);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "ICreateFeature: Memory allocation failure");
+        return OGRERR_FAILURE;
+    }
+}
+
+/************************************************************************/
+/*                           writeFeature()                             */
+/************************************************************************/
+
+// Serializes a feature, whose properties and geometry have been added to fbb,
+// and appends it to the output file.
+OGRErr OGRFlatGeobufLayer::writeFeature(
+    FlatBufferBuilder &fbb, const std::vector<uint8_t> &properties,
+    flatbuffers::Offset<FlatGeobuf::Geometry> geometryOffset,
+    const OGREnvelope *psEnvelope)
+{
+    const auto pProperties = properties.empty() ? nullptr : &properties;
+    if (properties.size() > feature_max_buffer_size - geometryOffset.o)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "ICreateFeature: Too big feature");
+        return OGRERR_FAILURE;
+    }
+    // TODO: write columns if mixed schema in collection
+    const auto feature = CreateFeatureDirect(fbb, geometryOffset, pProperties);
+    fbb.FinishSizePrefixed(feature);
+
+    if (psEnvelope != nullptr)
+    {
+        if (m_sExtent.IsInit())
+            m_sExtent.Merge(*psEnvelope);
+        else
+            m_sExtent = *psEnvelope;
+    }
+
+    if (m_featuresCount == 0)
+    {
+        if (m_poFpWrite == nullptr)
         {
-            CPLError(CE_Failure, CPLE_OutOfMemory,
-                     "ICreateFeature: Too big feature");
+            CPLErrorInvalidPointer("output file handler");
             return OGRERR_FAILURE;
         }
-        // TODO: write columns if mixed schema in collection
-        const auto feature =
-            CreateFeatureDirect(fbb, geometryOffset, pProperties);
-        fbb.FinishSizePrefixed(feature);
+        if (!SupportsSeekWhileWriting(m_osFilename))
+        {
+            writeHeader(m_poFpWrite, 0, nullptr);
+        }
+        else
+        {
+            std::vector<double> dummyExtent(
+                4, std::numeric_limits<double>::quiet_NaN());
+            const uint64_t dummyFeatureCount =
+                0xDEADBEEF;  // write non-zero value, otherwise the reserved
+                             // size is not OK
+            writeHeader(m_poFpWrite, dummyFeatureCount,
+                        &dummyExtent);  // we will update it later
+            m_offsetAfterHeader = m_writeOffset;
+        }
+        CPLDebugOnly("FlatGeobuf", "Writing first feature at offset: %lu",
+                     static_cast<long unsigned int>(m_writeOffset));
+    }
+
+    m_maxFeatureSize =
+        std::max(m_maxFeatureSize, static_cast<uint32_t>(fbb.GetSize()));
+    size_t c =
+        VSIFWriteL(fbb.GetBufferPointer(), 1, fbb.GetSize(), m_poFpWrite);
+    if (c == 0)
+        return CPLErrorIO("writing feature");
+    if (m_bCreateSpatialIndexAtClose)
+    {
+        const OGREnvelope sEnvelope =
+            psEnvelope ? *psEnvelope : OGREnvelope();
+        FeatureItem item;
+        item.size = static_cast<uint32_t>(fbb.GetSize());
+        item.offset = m_writeOffset;
+        item.nodeItem = {sEnvelope.MinX, sEnvelope.MinY, sEnvelope.MaxX,
+                         sEnvelope.MaxY, 0};
+        m_featureItems.emplace_back(std::move(item));
+    }
+    m_writeOffset += c;
 
-        OGREnvelope psEnvelope;
-        if (ogrGeometry != nullptr)
+    m_featuresCount++;
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                       OGRFlatGeobufArrowWriteColumn                  */
+/************************************************************************/
+
+namespace
+{
+/** Column of an Arrow batch directly serialized by the native
+ * WriteArrowBatch() implementation. */
+struct OGRFlatGeobufArrowWriteColumn
+{
+    enum class Type
+    {
+        GEOMETRY,
+        LARGE_GEOMETRY,
+        BOOLEAN,
+        INT8,
+        UINT8,
+        INT16,
+        UINT16,
+        INT32,
+        UINT32,
+        INT64,
+        FLOAT32,
+        FLOAT64,
+        STRING,
+        LARGE_STRING,
+        BINARY,
+        LARGE_BINARY,
+        DATE32,
+        TIMESTAMP,
+    };
+
+    Type eType = Type::INT32;
+    const struct ArrowArray *array = nullptr;
+    int iField = -1;             // -1 for the geometry column
+    int nInvFactorToSecond = 1;  // only for TIMESTAMP
+    std::string osTZ{};          // only for TIMESTAMP
+};
+}  // namespace
+
+static const struct
+{
+    const char *pszFormat;
+    OGRFieldType eFieldType;
+    OGRFlatGeobufArrowWriteColumn::Type eType;
+} gasFlatGeobufArrowWriteTypes[] = {
+    {"b", OFTInteger, OGRFlatGeobufArrowWriteColumn::Type::BOOLEAN},
+    {"c", OFTInteger, OGRFlatGeobufArrowWriteColumn::Type::INT8},
+    {"C", OFTInteger, OGRFlatGeobufArrowWriteColumn::Type::UINT8},
+    {"s", OFTInteger, OGRFlatGeobufArrowWriteColumn::Type::INT16},
+    {"S", OFTInteger, OGRFlatGeobufArrowWriteColumn::Type::UINT16},
+    {"i", OFTInteger, OGRFlatGeobufArrowWriteColumn::Type::INT32},
+    {"I", OFTInteger64, OGRFlatGeobufArrowWriteColumn::Type::UINT32},
+    {"l", OFTInteger64, OGRFlatGeobufArrowWriteColumn::Type::INT64},
+    {"f", OFTReal, OGRFlatGeobufArrowWriteColumn::Type::FLOAT32},
+    {"g", OFTReal, OGRFlatGeobufArrowWriteColumn::Type::FLOAT64},
+    {"u", OFTString, OGRFlatGeobufArrowWriteColumn::Type::STRING},
+    {"U", OFTString, OGRFlatGeobufArrowWriteColumn::Type::LARGE_STRING},
+    {"z", OFTBinary, OGRFlatGeobufArrowWriteColumn::Type::BINARY},
+    {"Z", OFTBinary, OGRFlatGeobufArrowWriteColumn::Type::LARGE_BINARY},
+    {"tdD", OFTDate, OGRFlatGeobufArrowWriteColumn::Type::DATE32},
+};
+
+/************************************************************************/
+/*                     CanUseNativeWriteArrowBatch()                    */
+/************************************************************************/
+
+/** Returns whether WriteArrowBatch() can directly serialize the columns of
+ * the batch, with the same result as OGRLayer::WriteArrowBatch(). In which
+ * case asColumns is filled, with field columns in the order of the layer
+ * fields, and the geometry column, if any, last.
+ */
+static bool CanUseNativeWriteArrowBatch(
+    OGRLayer *poLayer, const struct ArrowSchema *schema,
+    const struct ArrowArray *array, CSLConstList papszOptions,
+    std::vector<OGRFlatGeobufArrowWriteColumn> &asColumns)
+{
+    if (strcmp(schema->format, "+s") != 0 ||
+        schema->n_children != array->n_children || array->length < 0 ||
+        CPLTestBool(
+            CPLGetConfigOption("OGR_APPLY_GEOM_SET_PRECISION", "FALSE")))
+    {
+        return false;
+    }
+
+    const OGRFeatureDefn *poFeatureDefn = poLayer->GetLayerDefn();
+    const char *pszFIDName =
+        CSLFetchNameValueDef(papszOptions, "FID", poLayer->GetFIDColumn());
+    if (!pszFIDName || pszFIDName[0] == 0)
+        pszFIDName = OGRLayer::DEFAULT_ARROW_FID_NAME;
+    const char *pszGeomFieldName = CSLFetchNameValueDef(
+        papszOptions, "GEOMETRY_NAME", poLayer->GetGeometryColumn());
+    if (!pszGeomFieldName || pszGeomFieldName[0] == 0)
+        pszGeomFieldName = OGRLayer::DEFAULT_ARROW_GEOMETRY_NAME;
+
+    const int nFieldCount = poFeatureDefn->GetFieldCount();
+    std::vector<bool> abFieldSet(nFieldCount);
+    bool bFIDSet = false;
+    OGRFlatGeobufArrowWriteColumn sGeomColumn;
+    for (int64_t i = 0; i < schema->n_children; ++i)
+    {
+        const struct ArrowSchema *childSchema = schema->children[i];
+        const char *pszName = childSchema->name;
+        const char *format = childSchema->format;
+        if (childSchema->dictionary != nullptr || pszName == nullptr)
+            return false;
+
+        OGRFlatGeobufArrowWriteColumn sColumn;
+        sColumn.array = array->children[i];
+
+        if (strcmp(pszName, pszFIDName) == 0)
         {
-            ogrGeometry->getEnvelope(&psEnvelope);
-            if (m_sExtent.IsInit())
-                m_sExtent.Merge(psEnvelope);
-            else
-                m_sExtent = psEnvelope;
+            // FlatGeobuf does not store FIDs: just check the column would
+            // be recognized as the FID one by the generic implementation.
+            if (bFIDSet ||
+                (strcmp(format, "i") != 0 && strcmp(format, "l") != 0))
+            {
+                return false;
+            }
+            bFIDSet = true;
+            continue;
         }
 
-        if (m_featuresCount == 0)
+        const int iField = poFeatureDefn->GetFieldIndex(pszName);
+        if (iField >= 0)
         {
-            if (m_poFpWrite == nullptr)
+            const OGRFieldDefn *poFieldDefn =
+                poFeatureDefn->GetFieldDefn(iField);
+            const OGRFieldType eFieldType = poFieldDefn->GetType();
+            const OGRFieldSubType eSubType = poFieldDefn->GetSubType();
+            if (abFieldSet[iField])
+                return false;
+
+            bool bTypeOK = false;
+            for (const auto &sType : gasFlatGeobufArrowWriteTypes)
             {
-                CPLErrorInvalidPointer("output file handler");
-                return OGRERR_FAILURE;
+                if (strcmp(format, sType.pszFormat) == 0)
+                {
+                    bTypeOK = sType.eFieldType == eFieldType;
+                    sColumn.eType = sType.eType;
+                    break;
+                }
             }
-            if (!SupportsSeekWhileWriting(m_osFilename))
+            // OGRFeature::SetField() clamps values that do not fit into
+            // the Boolean or Int16 subtypes, with a warning
+            if (bTypeOK && eSubType == OFSTBoolean &&
+                sColumn.eType != OGRFlatGeobufArrowWriteColumn::Type::BOOLEAN)
             {
-                writeHeader(m_poFpWrite, 0, nullptr);
+                bTypeOK = false;
             }
-            else
+            else if (bTypeOK && eSubType == OFSTInt16 &&
+                     (sColumn.eType ==
+                          OGRFlatGeobufArrowWriteColumn::Type::UINT16 ||
+                      sColumn.eType ==
+                          OGRFlatGeobufArrowWriteColumn::Type::INT32))
             {
-                std::vector<double> dummyExtent(
-                    4, std::numeric_limits<double>::quiet_NaN());
-                const uint64_t dummyFeatureCount =
-                    0xDEADBEEF;  // write non-zero value, otherwise the reserved
-                                 // size is not OK
-                writeHeader(m_poFpWrite, dummyFeatureCount,
-                            &dummyExtent);  // we will update it later
-                m_offsetAfterHeader = m_writeOffset;
+                bTypeOK = false;
             }
-            CPLDebugOnly("FlatGeobuf", "Writing first feature at offset: %lu",
-                         static_cast<long unsigned int>(m_writeOffset));
+            if (!bTypeOK && eFieldType == OFTDateTime &&
+                strncmp(format, "ts", 2) == 0 && format[2] != 0 &&
+                format[3] == ':')
+            {
+                bTypeOK = true;
+                sColumn.eType = OGRFlatGeobufArrowWriteColumn::Type::TIMESTAMP;
+                sColumn.osTZ = format + strlen("ts?:");
+                switch (format[2])
+                {
+                    case 's':
+                        sColumn.nInvFactorToSecond = 1;
+                        break;
+                    case 'm':
+                        sColumn.nInvFactorToSecond = 1000;
+                        break;
+                    case 'u':
+                        sColumn.nInvFactorToSecond = 1000 * 1000;
+                        break;
+                    case 'n':
+                        sColumn.nInvFactorToSecond = 1000 * 1000 * 1000;
+                        break;
+                    default:
+                        bTypeOK = false;
+                        break;
+                }
+            }
+            if (!bTypeOK)
+                return false;
+
+            abFieldSet[iField] = true;
+            sColumn.iField = iField;
+            asColumns.push_back(std::move(sColumn));
+            continue;
         }
 
-        m_maxFeatureSize =
-            std::max(m_maxFeatureSize, static_cast<uint32_t>(fbb.GetSize()));
-        size_t c =
-            VSIFWriteL(fbb.GetBufferPointer(), 1, fbb.GetSize(), m_poFpWrite);
-        if (c == 0)
-            return CPLErrorIO("writing feature");
-        if (m_bCreateSpatialIndexAtClose)
+        if (sGeomColumn.array != nullptr ||
+            poFeatureDefn->GetGeomFieldCount() == 0)
         {
-            FeatureItem item;
-            item.size = static_cast<uint32_t>(fbb.GetSize());
-            item.offset = m_writeOffset;
-            item.nodeItem = {psEnvelope.MinX, psEnvelope.MinY, psEnvelope.MaxX,
-                             psEnvelope.MaxY, 0};
-            m_featureItems.emplace_back(std::move(item));
+            return false;
+        }
+        bool bIsGeom = poFeatureDefn->GetGeomFieldIndex(pszName) == 0 ||
+                       strcmp(pszName, pszGeomFieldName) == 0;
+        if (!bIsGeom && childSchema->metadata)
+        {
+            const auto oMetadata =
+                OGRParseArrowMetadata(childSchema->metadata);
+            const auto oIter = oMetadata.find(ARROW_EXTENSION_NAME_KEY);
+            bIsGeom = oIter != oMetadata.end() &&
+                      (oIter->second == EXTENSION_NAME_OGC_WKB ||
+                       oIter->second == EXTENSION_NAME_GEOARROW_WKB);
         }
-        m_writeOffset += c;
+        if (!bIsGeom)
+            return false;
+        if (strcmp(format, "z") == 0)
+            sColumn.eType = OGRFlatGeobufArrowWriteColumn::Type::GEOMETRY;
+        else if (strcmp(format, "Z") == 0)
+            sColumn.eType = OGRFlatGeobufArrowWriteColumn::Type::LARGE_GEOMETRY;
+        else
+            return false;
+        sGeomColumn = std::move(sColumn);
+    }
 
-        m_featuresCount++;
+    // Properties must be serialized in the order of the layer fields
+    std::sort(asColumns.begin(), asColumns.end(),
+              [](const OGRFlatGeobufArrowWriteColumn &a,
+                 const OGRFlatGeobufArrowWriteColumn &b)
+              { return a.iField < b.iField; });
+    if (sGeomColumn.array != nullptr)
+        asColumns.push_back(std::move(sGeomColumn));
 
-        return OGRERR_NONE;
+    return !asColumns.empty();
+}
+
+/************************************************************************/
+/*                            TestBit()                                 */
+/************************************************************************/
+
+static inline bool TestBit(const void *pabyData, size_t nIdx)
+{
+    return (static_cast<const GByte *>(pabyData)[nIdx / 8] &
+            (1 << (nIdx % 8))) != 0;
+}
+
+/************************************************************************/
+/*                          WriteArrowBatch()                           */
+/************************************************************************/
+
+/** Writes an Arrow batch.
+ *
+ * Instead of going through a OGRFeature per row as OGRLayer::WriteArrowBatch()
+ * does, the values of the Arrow arrays are directly serialized as FlatGeobuf
+ * properties, and WKB geometries are transcoded to FlatGeobuf geometries
+ * without being instantiated as OGRGeometry when possible.
+ * Batches this code cannot deal with identically to the generic
+ * implementation are delegated to it.
+ */
+bool OGRFlatGeobufLayer::WriteArrowBatch(const struct ArrowSchema *schema,
+                                         struct ArrowArray *array,
+                                         CSLConstList papszOptions)
+{
+    std::vector<OGRFlatGeobufArrowWriteColumn> asColumns;
+    if (!m_create ||
+        CPLTestBool(CPLGetConfigOption(
+            "OGR_FLATGEOBUF_WRITE_ARROW_BATCH_BASE_IMPL", "NO")) ||
+        !CanUseNativeWriteArrowBatch(this, schema, array, papszOptions,
+                                     asColumns))
+    {
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
     }
-    catch (const std::bad_alloc &)
+
+    std::vector<uint8_t> &properties = m_writeProperties;
+    properties.reserve(1024 * 4);
+    FlatBufferBuilder fbb;
+    WKBGeometryWriter oWKBWriter(m_geometryType, m_hasZ, m_hasM);
+
+    const size_t nRows = static_cast<size_t>(array->length);
+    for (size_t iRow = 0; iRow < nRows; ++iRow)
     {
-        CPLError(CE_Failure, CPLE_OutOfMemory,
-                 "ICreateFeature: Memory allocation failure");
-        return OGRERR_FAILURE;
+        properties.clear();
+        fbb.Clear();
+        fbb.TrackMinAlign(8);
+
+        bool bHasGeom = false;
+        const GByte *pabyWKB = nullptr;
+        size_t nWKBSize = 0;
+
+        for (const auto &sColumn : asColumns)
+        {
+            const struct ArrowArray *psArray = sColumn.array;
+            const size_t iIdx = iRow + static_cast<size_t>(psArray->offset);
+            const void *pValues = psArray->buffers[1];
+
+            if (psArray->null_count != 0 && psArray->buffers[0] &&
+                !TestBit(psArray->buffers[0], iIdx))
+            {
+                continue;
+            }
+
+            const auto AppendFieldIndex = [&properties, &sColumn]()
+            {
+                AppendProperty(properties,
+                               static_cast<uint16_t>(sColumn.iField));
+            };
+            const auto fieldSubType =
+                sColumn.iField >= 0
+                    ? m_poFeatureDefn->GetFieldDefn(sColumn.iField)
+                          ->GetSubType()
+                    : OFSTNone;
+
+            switch (sColumn.eType)
+            {
+                case OGRFlatGeobufArrowWriteColumn::Type::BOOLEAN:
+                    AppendFieldIndex();
+                    AppendIntegerProperty(properties, fieldSubType,
+                                          TestBit(pValues, iIdx) ? 1 : 0);
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::INT8:
+                    AppendFieldIndex();
+                    AppendIntegerProperty(
+                        properties, fieldSubType,
+                        static_cast<const int8_t *>(pValues)[iIdx]);
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::UINT8:
+                    AppendFieldIndex();
+                    AppendIntegerProperty(
+                        properties, fieldSubType,
+                        static_cast<const uint8_t *>(pValues)[iIdx]);
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::INT16:
+                    AppendFieldIndex();
+                    AppendIntegerProperty(
+                        properties, fieldSubType,
+                        static_cast<const int16_t *>(pValues)[iIdx]);
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::UINT16:
+                    AppendFieldIndex();
+                    AppendIntegerProperty(
+                        properties, fieldSubType,
+                        static_cast<const uint16_t *>(pValues)[iIdx]);
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::INT32:
+                    AppendFieldIndex();
+                    AppendIntegerProperty(
+                        properties, fieldSubType,
+                        static_cast<const int32_t *>(pValues)[iIdx]);
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::UINT32:
+                    AppendFieldIndex();
+                    AppendProperty(properties,
+                                   static_cast<int64_t>(
+                                       static_cast<const uint32_t *>(
+                                           pValues)[iIdx]));
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::INT64:
+                    AppendFieldIndex();
+                    AppendProperty(properties,
+                                   static_cast<const int64_t *>(pValues)[iIdx]);
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::FLOAT32:
+                    AppendFieldIndex();
+                    AppendRealProperty(
+                        properties, fieldSubType,
+                        static_cast<const float *>(pValues)[iIdx]);
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::FLOAT64:
+                    AppendFieldIndex();
+                    AppendRealProperty(
+                        properties, fieldSubType,
+                        static_cast<const double *>(pValues)[iIdx]);
+                    break;
+
+                case OGRFlatGeobufArrowWriteColumn::Type::DATE32:
+                case OGRFlatGeobufArrowWriteColumn::Type::TIMESTAMP:
+                {
+                    OGRField sField;
+                    bool bOK;
+                    if (sColumn.eType ==
+                        OGRFlatGeobufArrowWriteColumn::Type::DATE32)
+                    {
+                        // Days since epoch
+                        const int64_t nTimestamp =
+                            static_cast<int64_t>(
+                                static_cast<const int32_t *>(pValues)[iIdx]) *
+                            3600 * 24;
+                        bOK = OGRArrowTimestampToOGRField(nTimestamp, 1, "",
+                                                          sField);
+                    }
+                    else
+                    {
+                        bOK = OGRArrowTimestampToOGRField(
+                            static_cast<const int64_t *>(pValues)[iIdx],
+                            sColumn.nInvFactorToSecond, sColumn.osTZ.c_str(),
+                            sField);
+                    }
+                    // Out of range dates result in a null field
+                    if (bOK)
+                    {
+                        AppendFieldIndex();
+                        AppendDateTimeProperty(properties, &sField);
+                    }
+                    break;
+                }
+
+                case OGRFlatGeobufArrowWriteColumn::Type::STRING:
+                case OGRFlatGeobufArrowWriteColumn::Type::LARGE_STRING:
+                case OGRFlatGeobufArrowWriteColumn::Type::BINARY:
+                case OGRFlatGeobufArrowWriteColumn::Type::LARGE_BINARY:
+                case OGRFlatGeobufArrowWriteColumn::Type::GEOMETRY:
+                case OGRFlatGeobufArrowWriteColumn::Type::LARGE_GEOMETRY:
+                {
+                    uint64_t nStart;
+                    uint64_t nEnd;
+                    if (sColumn.eType ==
+                            OGRFlatGeobufArrowWriteColumn::Type::STRING ||
+                        sColumn.eType ==
+                            OGRFlatGeobufArrowWriteColumn::Type::BINARY ||
+                        sColumn.eType ==
+                            OGRFlatGeobufArrowWriteColumn::Type::GEOMETRY)
+                    {
+                        const auto panOffsets =
+                            static_cast<const uint32_t *>(pValues);
+                        nStart = panOffsets[iIdx];
+                        nEnd = panOffsets[iIdx + 1];
+                    }
+                    else
+                    {
+                        const auto panOffsets =
+                            static_cast<const uint64_t *>(pValues);
+                        nStart = panOffsets[iIdx];
+                        nEnd = panOffsets[iIdx + 1];
+                    }
+                    const GByte *pabyData =
+                        static_cast<const GByte *>(psArray->buffers[2]) +
+                        nStart;
+                    size_t nLen = static_cast<size_t>(nEnd - nStart);
+
+                    if (sColumn.eType ==
+                            OGRFlatGeobufArrowWriteColumn::Type::GEOMETRY ||
+                        sColumn.eType ==
+                            OGRFlatGeobufArrowWriteColumn::Type::LARGE_GEOMETRY)
+                    {
+                        bHasGeom = true;
+                        pabyWKB = pabyData;
+                        nWKBSize = nLen;
+                        break;
+                    }
+
+                    const bool bIsString =
+                        sColumn.eType ==
+                            OGRFlatGeobufArrowWriteColumn::Type::STRING ||
+                        sColumn.eType ==
+                            OGRFlatGeobufArrowWriteColumn::Type::LARGE_STRING;
+                    if (bIsString)
+                    {
+                        // OGRFeature::SetField() stops at the first nul
+                        // character
+                        const void *pNul = memchr(pabyData, 0, nLen);
+                        if (pNul)
+                            nLen = static_cast<size_t>(
+                                static_cast<const GByte *>(pNul) - pabyData);
+                    }
+                    AppendFieldIndex();
+                    if (AppendStringOrBinaryProperty(properties, pabyData,
+                                                     nLen, bIsString) !=
+                        OGRERR_NONE)
+                    {
+                        return false;
+                    }
+                    break;
+                }
+            }
+        }
+
+        try
+        {
+            flatbuffers::Offset<FlatGeobuf::Geometry> geometryOffset = 0;
+            OGREnvelope sEnvelope;
+            bool bHasEnvelope = false;
+            if (bHasGeom && oWKBWriter.parse(pabyWKB, nWKBSize) &&
+                !oWKBWriter.isEmpty())
+            {
+                // Same checks as ICreateFeature()
+                const auto eGType = oWKBWriter.getGeometryType();
+                if (m_geometryType != GeometryType::Unknown &&
+                    eGType != m_eGType)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "ICreateFeature: Mismatched geometry type. "
+                             "Feature geometry type is %s, "
+                             "expected layer geometry type is %s",
+                             OGRGeometryTypeToName(eGType),
+                             OGRGeometryTypeToName(m_eGType));
+                    return false;
+                }
+                if (nWKBSize > feature_max_buffer_size - nWKBSize / 10)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "ICreateFeature: Too big geometry");
+                    return false;
+                }
+                geometryOffset = oWKBWriter.write(fbb);
+                oWKBWriter.getEnvelope(sEnvelope);
+                bHasEnvelope = true;
+            }
+            else
+            {
+                std::unique_ptr<OGRGeometry> poGeom;
+                if (bHasGeom)
+                {
+                    // Invalid WKB results in a null geometry
+                    OGRGeometry *poGeomRaw = nullptr;
+                    size_t nBytesConsumed = 0;
+                    OGRGeometryFactory::createFromWkb(
+                        pabyWKB, nullptr, &poGeomRaw, nWKBSize, wkbVariantIso,
+                        nBytesConsumed);
+                    poGeom.reset(poGeomRaw);
+                }
+                if (m_bCreateSpatialIndexAtClose &&
+                    (poGeom == nullptr || poGeom->IsEmpty()))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "ICreateFeature: NULL geometry not supported "
+                             "with spatial index");
+                    return false;
+                }
+                if (poGeom != nullptr &&
+                    m_geometryType != GeometryType::Unknown &&
+                    poGeom->getGeometryType() != m_eGType)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "ICreateFeature: Mismatched geometry type. "
+                             "Feature geometry type is %s, "
+                             "expected layer geometry type is %s",
+                             OGRGeometryTypeToName(poGeom->getGeometryType()),
+                             OGRGeometryTypeToName(m_eGType));
+                    return false;
+                }
+                if (poGeom && !poGeom->IsEmpty())
+                {
+                    const auto nGeomWKBSize = poGeom->WkbSize();
+                    if (nGeomWKBSize >
+                        feature_max_buffer_size - nGeomWKBSize / 10)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory,
+                                 "ICreateFeature: Too big geometry");
+                        return false;
+                    }
+                    GeometryWriter writer{fbb, poGeom.get(), m_geometryType,
+                                          m_hasZ, m_hasM};
+                    geometryOffset = writer.write(0);
+                }
+                if (poGeom)
+                {
+                    poGeom->getEnvelope(&sEnvelope);
+                    bHasEnvelope = true;
+                }
+            }
+            if (writeFeature(fbb, properties, geometryOffset,
+                             bHasEnvelope ? &sEnvelope : nullptr) !=
+                OGRERR_NONE)
+            {
+                return false;
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "ICreateFeature: Memory allocation failure");
+            return false;
+        }
     }
+
+    return true;
 }
 
 OGRErr OGRFlatGeobufLayer::IGetExtent(int iGeomField, OGREnvelope *psExtent,
@@ -2440,6 +3440,8 @@ int OGRFlatGeobufLayer::TestCapability(const char *pszCap)
         return true;
     else if (EQUAL(pszCap, OLCFastGetArrowStream))
         return true;
+    else if (EQUAL(pszCap, OLCFastWriteArrowBatch))
+        return m_create;
     else
         return false;
 }
@@ -2447,6 +3449,7 @@ int OGRFlatGeobufLayer::TestCapability(const char *pszCap)
 void OGRFlatGeobufLayer::ResetReading()
 {
     CPLDebugOnly("FlatGeobuf", "ResetReading");
+    m_poArrowArrayReader.reset();
     m_offset = m_offsetFeatures;
     m_bEOF = false;
     m_featuresPos = 0;
@@ -19,9 +19,12 @@
 #include "ogr_recordbatch.h"
 #include "ogrlayerarrow.h"
 #include "cpl_time.h"
+#include "gdal_thread_pool.h"
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <map>
+#include <queue>
 #include <set>
 #include <vector>
 
@@ -2181,6 +2184,366 @@ void OGRGenSQLResultsLayer::ReadIndexFields(OGRFeature *poSrcFeat,
     }
 }
 
+/************************************************************************/
+/*                          OGRGenSQLSortRuns                           */
+/*                                                                      */
+/*      Sorted runs of ORDER BY key values, spilled to a temporary      */
+/*      file by CreateOrderByIndex() when OGR_SQL_SORT_MAX_MEMORY is    */
+/*      exceeded, and merged back at the end.                           */
+/************************************************************************/
+
+namespace
+{
+class OGRGenSQLSortRuns
+{
+  public:
+    OGRGenSQLSortRuns() = default;
+    ~OGRGenSQLSortRuns();
+
+    int GetRunCount() const
+    {
+        return static_cast<int>(m_aoRuns.size());
+    }
+
+    bool WriteRun(const OGRField *pasIndexFields, int nOrderItems,
+                  const std::vector<bool> &abIsStringKey,
+                  const std::vector<GIntBig> &anFIDList,
+                  const std::vector<GIntBig> &anSortedIndex,
+                  GIntBig nFirstSequence);
+
+    bool Merge(
+        const std::function<int(const OGRField *, const OGRField *)> &compare,
+        const std::function<void(OGRField *)> &freeRow, int nOrderItems,
+        const std::vector<bool> &abIsStringKey, GIntBig nTotalCount,
+        std::vector<GIntBig> &anFIDIndex, bool &bAlreadySorted);
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(OGRGenSQLSortRuns)
+
+    struct Run
+    {
+        vsi_l_offset nOffset = 0;
+        vsi_l_offset nSize = 0;
+        GIntBig nCount = 0;
+    };
+
+    std::string m_osFilename{};
+    VSILFILE *m_fp = nullptr;
+    vsi_l_offset m_nFileSize = 0;
+    std::vector<Run> m_aoRuns{};
+
+    bool Flush(std::string &osBuffer);
+};
+
+constexpr size_t SORT_RUN_BUFFER_SIZE = 1024 * 1024;
+
+/************************************************************************/
+/*                        ~OGRGenSQLSortRuns()                          */
+/************************************************************************/
+
+OGRGenSQLSortRuns::~OGRGenSQLSortRuns()
+{
+    if (m_fp)
+    {
+        VSIFCloseL(m_fp);
+        VSIUnlink(m_osFilename.c_str());
+    }
+}
+
+/************************************************************************/
+/*                               Flush()                                */
+/************************************************************************/
+
+bool OGRGenSQLSortRuns::Flush(std::string &osBuffer)
+{
+    if (VSIFWriteL(osBuffer.data(), 1, osBuffer.size(), m_fp) !=
+        osBuffer.size())
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "CreateOrderByIndex(): cannot write in %s",
+                 m_osFilename.c_str());
+        return false;
+    }
+    m_nFileSize += osBuffer.size();
+    osBuffer.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                             WriteRun()                               */
+/*                                                                      */
+/*      Each row is written as its sequence number in the source        */
+/*      layer, its FID, and its key values: OGRField as is, except      */
+/*      for set string values which are written as a length and         */
+/*      their characters.                                               */
+/************************************************************************/
+
+bool OGRGenSQLSortRuns::WriteRun(const OGRField *pasIndexFields,
+                                 int nOrderItems,
+                                 const std::vector<bool> &abIsStringKey,
+                                 const std::vector<GIntBig> &anFIDList,
+                                 const std::vector<GIntBig> &anSortedIndex,
+                                 GIntBig nFirstSequence)
+{
+    if (m_fp == nullptr)
+    {
+        m_osFilename = CPLGenerateTempFilenameSafe("ogr_gensql_sort");
+        m_fp = VSIFOpenL(m_osFilename.c_str(), "wb+");
+        if (m_fp == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "CreateOrderByIndex(): cannot create %s",
+                     m_osFilename.c_str());
+            return false;
+        }
+    }
+
+    Run oRun;
+    oRun.nOffset = m_nFileSize;
+    oRun.nCount = static_cast<GIntBig>(anSortedIndex.size());
+
+    std::string osBuffer;
+    osBuffer.reserve(SORT_RUN_BUFFER_SIZE);
+    for (const GIntBig nIdx : anSortedIndex)
+    {
+        const GIntBig anHeader[] = {nFirstSequence + nIdx,
+                                    anFIDList[static_cast<size_t>(nIdx)]};
+        osBuffer.append(reinterpret_cast<const char *>(anHeader),
+                        sizeof(anHeader));
+        const OGRField *pasRow =
+            pasIndexFields + static_cast<size_t>(nIdx) * nOrderItems;
+        for (int iKey = 0; iKey < nOrderItems; iKey++)
+        {
+            const OGRField *psField = &pasRow[iKey];
+            if (abIsStringKey[iKey] && !OGR_RawField_IsUnset(psField) &&
+                !OGR_RawField_IsNull(psField))
+            {
+                const uint32_t nLen =
+                    static_cast<uint32_t>(strlen(psField->String));
+                osBuffer += '\1';
+                osBuffer.append(reinterpret_cast<const char *>(&nLen),
+                                sizeof(nLen));
+                osBuffer.append(psField->String, nLen);
+            }
+            else
+            {
+                osBuffer += '\0';
+                osBuffer.append(reinterpret_cast<const char *>(psField),
+                                sizeof(OGRField));
+            }
+        }
+        if (osBuffer.size() >= SORT_RUN_BUFFER_SIZE && !Flush(osBuffer))
+            return false;
+    }
+    if (!Flush(osBuffer))
+        return false;
+
+    oRun.nSize = m_nFileSize - oRun.nOffset;
+    m_aoRuns.push_back(oRun);
+    return true;
+}
+
+/************************************************************************/
+/*                               Merge()                                */
+/*                                                                      */
+/*      K-way merge of the runs. Ties are resolved in favor of the      */
+/*      earliest run, so that the result is the same as with an        */
+/*      in-memory stable sort.                                          */
+/************************************************************************/
+
+bool OGRGenSQLSortRuns::Merge(
+    const std::function<int(const OGRField *, const OGRField *)> &compare,
+    const std::function<void(OGRField *)> &freeRow, int nOrderItems,
+    const std::vector<bool> &abIsStringKey, GIntBig nTotalCount,
+    std::vector<GIntBig> &anFIDIndex, bool &bAlreadySorted)
+{
+    struct Reader
+    {
+        vsi_l_offset nNextOffset = 0;
+        vsi_l_offset nRemainingBytes = 0;
+        GIntBig nRemainingRows = 0;
+        std::string osBuffer{};
+        size_t nBufferPos = 0;
+
+        bool bHasRow = false;
+        GIntBig nSequence = 0;
+        GIntBig nFID = 0;
+        std::vector<OGRField> asRow{};
+    };
+
+    const size_t nReaderBufferSize = std::max<size_t>(
+        65536, SORT_RUN_BUFFER_SIZE / std::max<size_t>(1, m_aoRuns.size()));
+
+    std::vector<Reader> aoReaders(m_aoRuns.size());
+    for (size_t i = 0; i < m_aoRuns.size(); ++i)
+    {
+        aoReaders[i].nNextOffset = m_aoRuns[i].nOffset;
+        aoReaders[i].nRemainingBytes = m_aoRuns[i].nSize;
+        aoReaders[i].nRemainingRows = m_aoRuns[i].nCount;
+        aoReaders[i].asRow.resize(nOrderItems);
+    }
+
+    const auto ReadBytes = [this, nReaderBufferSize](Reader &oReader,
+                                                     void *pDst, size_t nBytes)
+    {
+        GByte *pabyDst = static_cast<GByte *>(pDst);
+        while (nBytes > 0)
+        {
+            if (oReader.nBufferPos == oReader.osBuffer.size())
+            {
+                const size_t nToRead = static_cast<size_t>(
+                    std::min<vsi_l_offset>(nReaderBufferSize,
+                                           oReader.nRemainingBytes));
+                if (nToRead == 0)
+                    return false;
+                oReader.osBuffer.resize(nToRead);
+                if (VSIFSeekL(m_fp, oReader.nNextOffset, SEEK_SET) != 0 ||
+                    VSIFReadL(&oReader.osBuffer[0], 1, nToRead, m_fp) !=
+                        nToRead)
+                {
+                    return false;
+                }
+                oReader.nNextOffset += nToRead;
+                oReader.nRemainingBytes -= nToRead;
+                oReader.nBufferPos = 0;
+            }
+            const size_t nAvail = std::min(
+                nBytes, oReader.osBuffer.size() - oReader.nBufferPos);
+            memcpy(pabyDst, oReader.osBuffer.data() + oReader.nBufferPos,
+                   nAvail);
+            oReader.nBufferPos += nAvail;
+            pabyDst += nAvail;
+            nBytes -= nAvail;
+        }
+        return true;
+    };
+
+    const auto ReadRow = [&ReadBytes, &abIsStringKey,
+                          nOrderItems](Reader &oReader)
+    {
+        GIntBig anHeader[2] = {0, 0};
+        if (!ReadBytes(oReader, anHeader, sizeof(anHeader)))
+            return false;
+        oReader.nSequence = anHeader[0];
+        oReader.nFID = anHeader[1];
+        memset(oReader.asRow.data(), 0, sizeof(OGRField) * nOrderItems);
+        // From now on, the row must be freed even if reading fails
+        oReader.bHasRow = true;
+        for (int iKey = 0; iKey < nOrderItems; iKey++)
+        {
+            OGRField *psField = &oReader.asRow[iKey];
+            char chKind = 0;
+            if (!ReadBytes(oReader, &chKind, 1))
+                return false;
+            if (chKind == '\1')
+            {
+                uint32_t nLen = 0;
+                if (!ReadBytes(oReader, &nLen, sizeof(nLen)))
+                    return false;
+                char *pszStr = static_cast<char *>(
+                    VSI_MALLOC_VERBOSE(static_cast<size_t>(nLen) + 1));
+                if (pszStr == nullptr)
+                    return false;
+                if (!ReadBytes(oReader, pszStr, nLen))
+                {
+                    VSIFree(pszStr);
+                    return false;
+                }
+                pszStr[nLen] = '\0';
+                psField->String = pszStr;
+            }
+            else
+            {
+                OGRField sField;
+                if (!ReadBytes(oReader, &sField, sizeof(sField)))
+                    return false;
+                // Key values are only owned by the row if they are strings
+                if (abIsStringKey[iKey] && !OGR_RawField_IsUnset(&sField) &&
+                    !OGR_RawField_IsNull(&sField))
+                {
+                    return false;
+                }
+                *psField = sField;
+            }
+        }
+        oReader.nRemainingRows--;
+        return true;
+    };
+
+    const auto FreeReaderRows = [&aoReaders, &freeRow]()
+    {
+        for (auto &oReader : aoReaders)
+        {
+            if (oReader.bHasRow)
+            {
+                freeRow(oReader.asRow.data());
+                oReader.bHasRow = false;
+            }
+        }
+    };
+
+    try
+    {
+        anFIDIndex.reserve(static_cast<size_t>(nTotalCount));
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "CreateOrderByIndex(): out of memory");
+        return false;
+    }
+
+    // Returns true if run a must be output after run b
+    const auto cmp = [&aoReaders, &compare](int a, int b)
+    {
+        const int nResult =
+            compare(aoReaders[a].asRow.data(), aoReaders[b].asRow.data());
+        return nResult > 0 || (nResult == 0 && a > b);
+    };
+    std::priority_queue<int, std::vector<int>, decltype(cmp)> oHeap(cmp);
+
+    const auto Fail = [this, &FreeReaderRows]()
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "CreateOrderByIndex(): cannot read %s", m_osFilename.c_str());
+        FreeReaderRows();
+        return false;
+    };
+
+    for (int i = 0; i < static_cast<int>(aoReaders.size()); ++i)
+    {
+        if (aoReaders[i].nRemainingRows > 0)
+        {
+            if (!ReadRow(aoReaders[i]))
+                return Fail();
+            oHeap.push(i);
+        }
+    }
+
+    bAlreadySorted = true;
+    while (!oHeap.empty())
+    {
+        const int iRun = oHeap.top();
+        oHeap.pop();
+        Reader &oReader = aoReaders[iRun];
+        if (oReader.nSequence != static_cast<GIntBig>(anFIDIndex.size()))
+            bAlreadySorted = false;
+        anFIDIndex.push_back(oReader.nFID);
+        freeRow(oReader.asRow.data());
+        oReader.bHasRow = false;
+        if (oReader.nRemainingRows > 0)
+        {
+            if (!ReadRow(oReader))
+                return Fail();
+            oHeap.push(iRun);
+        }
+    }
+
+    return true;
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                         CreateOrderByIndex()                         */
 /*                                                                      */
@@ -2291,12 +2654,59 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
 
     IndexFieldsFreer oIndexFieldsFreer(*this, asIndexFields, nIndexSize);
 
+    /* -------------------------------------------------------------------- */
+    /*      Determine the memory budget for the key values. When it is      */
+    /*      exceeded, the keys read so far are sorted and spilled to a      */
+    /*      temporary file, and the sorted runs are merged at the end.      */
+    /* -------------------------------------------------------------------- */
+    GIntBig nMaxMemory = 0;
+    {
+        const char *pszMaxMemory =
+            CPLGetConfigOption("OGR_SQL_SORT_MAX_MEMORY", "25%");
+        if (CPLParseMemorySize(pszMaxMemory, &nMaxMemory, nullptr) !=
+                CE_None ||
+            nMaxMemory <= 0)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Invalid value for OGR_SQL_SORT_MAX_MEMORY: %s. "
+                     "Ignoring it",
+                     pszMaxMemory);
+            nMaxMemory = std::numeric_limits<GIntBig>::max();
+        }
+    }
+
+    std::vector<bool> abIsStringKey;
+    for (int iKey = 0; iKey < nOrderItems; iKey++)
+        abIsStringKey.push_back(IsStringOrderByKey(iKey));
+
+    OGRGenSQLSortRuns oRuns;
+    GIntBig nMemoryUsed = 0;
+    GIntBig nSequence = 0;
+
     /* -------------------------------------------------------------------- */
     /*      Read in all the key values.                                     */
     /* -------------------------------------------------------------------- */
 
     for (auto &&poSrcFeat : *m_poSrcLayer)
     {
+        if (nIndexSize > 0 && nMemoryUsed > nMaxMemory)
+        {
+            if (!SortIndex(asIndexFields.data(), nIndexSize) ||
+                !oRuns.WriteRun(asIndexFields.data(), nOrderItems,
+                                abIsStringKey, anFIDList, m_anFIDIndex,
+                                nSequence - static_cast<GIntBig>(nIndexSize)))
+            {
+                m_anFIDIndex.clear();
+                return;
+            }
+            FreeIndexFields(asIndexFields.data(), nIndexSize);
+            memset(asIndexFields.data(), 0,
+                   sizeof(OGRField) * nOrderItems * nIndexSize);
+            nIndexSize = 0;
+            anFIDList.clear();
+            nMemoryUsed = 0;
+        }
+
         if (nIndexSize == nFeaturesAlloc)
         {
             const uint64_t nNewFeaturesAlloc64 =
@@ -2336,19 +2746,140 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
             nFeaturesAlloc = nNewFeaturesAlloc;
         }
 
-        ReadIndexFields(poSrcFeat.get(), nOrderItems,
-                        asIndexFields.data() + nIndexSize * nOrderItems);
+        OGRField *pasRow = asIndexFields.data() + nIndexSize * nOrderItems;
+        ReadIndexFields(poSrcFeat.get(), nOrderItems, pasRow);
 
         anFIDList.push_back(poSrcFeat->GetFID());
 
+        // Approximate memory used by the row: the key values, its FID and
+        // its index entry.
+        nMemoryUsed += static_cast<GIntBig>(sizeof(OGRField)) * nOrderItems +
+                       2 * static_cast<GIntBig>(sizeof(GIntBig));
+        for (int iKey = 0; iKey < nOrderItems; iKey++)
+        {
+            if (abIsStringKey[iKey] && !OGR_RawField_IsUnset(&pasRow[iKey]) &&
+                !OGR_RawField_IsNull(&pasRow[iKey]))
+            {
+                nMemoryUsed +=
+                    static_cast<GIntBig>(strlen(pasRow[iKey].String)) + 1;
+            }
+        }
+
         nIndexSize++;
+        nSequence++;
     }
 
     // CPLDebug("GenSQL", "CreateOrderByIndex() = %zu features", nIndexSize);
 
     /* -------------------------------------------------------------------- */
-    /*      Initialize m_anFIDIndex                                         */
+    /*      Sort the records.                                               */
     /* -------------------------------------------------------------------- */
+    if (!SortIndex(asIndexFields.data(), nIndexSize))
+    {
+        m_anFIDIndex.clear();
+        return;
+    }
+
+    bool bAlreadySorted = true;
+    if (oRuns.GetRunCount() > 0)
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Spill the last run, and merge all of them.                  */
+        /* ---------------------------------------------------------------- */
+        if (nIndexSize > 0 &&
+            !oRuns.WriteRun(asIndexFields.data(), nOrderItems, abIsStringKey,
+                            anFIDList, m_anFIDIndex,
+                            nSequence - static_cast<GIntBig>(nIndexSize)))
+        {
+            m_anFIDIndex.clear();
+            return;
+        }
+        FreeIndexFields(asIndexFields.data(), nIndexSize);
+        nIndexSize = 0;
+        std::vector<OGRField>().swap(asIndexFields);
+        std::vector<GIntBig>().swap(anFIDList);
+        m_anFIDIndex.clear();
+
+        CPLDebug("GenSQL", "Merging %d sorted runs of " CPL_FRMT_GIB
+                 " features", oRuns.GetRunCount(), nSequence);
+        if (!oRuns.Merge(
+                [this](const OGRField *pasFirst, const OGRField *pasSecond)
+                { return Compare(pasFirst, pasSecond); },
+                [this](OGRField *pasRow) { FreeIndexFields(pasRow, 1); },
+                nOrderItems, abIsStringKey, nSequence, m_anFIDIndex,
+                bAlreadySorted))
+        {
+            m_anFIDIndex.clear();
+            return;
+        }
+    }
+    else
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Rework the FID map to map to real FIDs.                     */
+        /* ---------------------------------------------------------------- */
+        for (size_t i = 0; i < nIndexSize; i++)
+        {
+            if (m_anFIDIndex[i] != static_cast<GIntBig>(i))
+                bAlreadySorted = false;
+            m_anFIDIndex[i] = anFIDList[static_cast<size_t>(m_anFIDIndex[i])];
+        }
+    }
+
+    /* If it is already sorted, then free than m_anFIDIndex array */
+    /* so that GetNextFeature() can call a sequential GetNextFeature() */
+    /* on the source array. Very useful for layers where random access */
+    /* is slow. */
+    /* Use case: the GML result of a WFS GetFeature with a SORTBY */
+    if (bAlreadySorted)
+    {
+        m_anFIDIndex.clear();
+    }
+
+    ResetReading();
+}
+
+/************************************************************************/
+/*                         IsStringOrderByKey()                         */
+/*                                                                      */
+/*      Whether the values of an ORDER BY key are stored as strings     */
+/*      allocated by ReadIndexFields().                                 */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::IsStringOrderByKey(int iKey) const
+{
+    const swq_order_def *psKeyDef = m_pSelectInfo->order_defs + iKey;
+    if (psKeyDef->field_index >= m_iFIDFieldIndex)
+    {
+        switch (SpecialFieldTypes[psKeyDef->field_index - m_iFIDFieldIndex])
+        {
+            case SWQ_INTEGER:
+            case SWQ_INTEGER64:
+            case SWQ_FLOAT:
+                return false;
+            default:
+                return true;
+        }
+    }
+    return m_poSrcLayer->GetLayerDefn()
+               ->GetFieldDefn(psKeyDef->field_index)
+               ->GetType() == OFTString;
+}
+
+/************************************************************************/
+/*                             SortIndex()                              */
+/*                                                                      */
+/*      Initialize m_anFIDIndex with the indices of the nIndexSize      */
+/*      rows of pasIndexFields, in sorted order. Sections of the        */
+/*      index are sorted in parallel, and then merged pairwise, also    */
+/*      in parallel. The result does not depend on the number of        */
+/*      threads, as the merge sort is stable.                           */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::SortIndex(const OGRField *pasIndexFields,
+                                      size_t nIndexSize)
+{
+    m_anFIDIndex.clear();
     try
     {
         m_anFIDIndex.reserve(nIndexSize);
@@ -2357,49 +2888,94 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
     {
         CPLError(CE_Failure, CPLE_OutOfMemory,
                  "CreateOrderByIndex(): out of memory");
-        return;
+        return false;
     }
     for (size_t i = 0; i < nIndexSize; i++)
         m_anFIDIndex.push_back(static_cast<GIntBig>(i));
 
-    /* -------------------------------------------------------------------- */
-    /*      Quick sort the records.                                         */
-    /* -------------------------------------------------------------------- */
+    if (nIndexSize < 2)
+        return true;
 
     GIntBig *panMerged = static_cast<GIntBig *>(
         VSI_MALLOC_VERBOSE(sizeof(GIntBig) * nIndexSize));
     if (panMerged == nullptr)
     {
         m_anFIDIndex.clear();
-        return;
+        return false;
     }
 
-    // Note: this merge sort is slightly faster than std::sort()
-    SortIndexSection(asIndexFields.data(), panMerged, 0, nIndexSize);
-    VSIFree(panMerged);
+    // Same default as the GPKG ArrowArray reader, so that a single
+    // request does not take all cores
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    int nThreads = pszThreads == nullptr ? std::min(4, CPLGetNumCPUs())
+                   : EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                   : atoi(pszThreads);
+    // Do not bother with threads for small sections
+    constexpr size_t MIN_ENTRIES_PER_SECTION = 16384;
+    nThreads = static_cast<int>(std::min<size_t>(
+        std::max(1, std::min(128, nThreads)),
+        nIndexSize / MIN_ENTRIES_PER_SECTION));
+
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (!poQueue)
+    {
+        // Note: this merge sort is slightly faster than std::sort()
+        SortIndexSection(pasIndexFields, panMerged, 0, nIndexSize);
+        VSIFree(panMerged);
+        return true;
+    }
 
-    /* -------------------------------------------------------------------- */
-    /*      Rework the FID map to map to real FIDs.                         */
-    /* -------------------------------------------------------------------- */
-    bool bAlreadySorted = true;
-    for (size_t i = 0; i < nIndexSize; i++)
+    // Boundaries of the sorted sections
+    std::vector<size_t> anBounds;
+    const int nSections = 4 * nThreads;
+    for (int i = 0; i <= nSections; ++i)
+        anBounds.push_back(nIndexSize * i / nSections);
+
+    const auto SubmitOrRun = [&poQueue](std::function<void()> task)
     {
-        if (m_anFIDIndex[i] != static_cast<GIntBig>(i))
-            bAlreadySorted = false;
-        m_anFIDIndex[i] = anFIDList[static_cast<size_t>(m_anFIDIndex[i])];
+        if (!poQueue->SubmitJob(task))
+            task();
+    };
+
+    for (int i = 0; i < nSections; ++i)
+    {
+        const size_t nStart = anBounds[i];
+        const size_t nEntries = anBounds[i + 1] - nStart;
+        SubmitOrRun([this, pasIndexFields, panMerged, nStart, nEntries]()
+                    { SortIndexSection(pasIndexFields, panMerged, nStart,
+                                       nEntries); });
     }
+    poQueue->WaitCompletion();
 
-    /* If it is already sorted, then free than m_anFIDIndex array */
-    /* so that GetNextFeature() can call a sequential GetNextFeature() */
-    /* on the source array. Very useful for layers where random access */
-    /* is slow. */
-    /* Use case: the GML result of a WFS GetFeature with a SORTBY */
-    if (bAlreadySorted)
+    while (anBounds.size() > 2)
     {
-        m_anFIDIndex.clear();
+        std::vector<size_t> anNewBounds;
+        size_t i = 0;
+        for (; i + 2 < anBounds.size(); i += 2)
+        {
+            const size_t nStart = anBounds[i];
+            const size_t nFirstGroup = anBounds[i + 1] - nStart;
+            const size_t nSecondGroup = anBounds[i + 2] - anBounds[i + 1];
+            SubmitOrRun(
+                [this, pasIndexFields, panMerged, nStart, nFirstGroup,
+                 nSecondGroup]()
+                {
+                    MergeIndexSections(pasIndexFields, panMerged, nStart,
+                                       nFirstGroup, nSecondGroup);
+                });
+            anNewBounds.push_back(nStart);
+        }
+        // Odd section left alone
+        for (; i < anBounds.size(); ++i)
+            anNewBounds.push_back(anBounds[i]);
+        poQueue->WaitCompletion();
+        anBounds = std::move(anNewBounds);
     }
 
-    ResetReading();
+    VSIFree(panMerged);
+    return true;
 }
 
 /************************************************************************/
@@ -2416,18 +2992,40 @@ void OGRGenSQLResultsLayer::SortIndexSection(const OGRField *pasIndexFields,
     if (nEntries < 2)
         return;
 
+    const size_t nFirstGroup = nEntries / 2;
+    const size_t nSecondGroup = nEntries - nFirstGroup;
+
+    SortIndexSection(pasIndexFields, panMerged, nStart, nFirstGroup);
+    SortIndexSection(pasIndexFields, panMerged, nStart + nFirstGroup,
+                     nSecondGroup);
+    MergeIndexSections(pasIndexFields, panMerged, nStart, nFirstGroup,
+                       nSecondGroup);
+}
+
+/************************************************************************/
+/*                         MergeIndexSections()                         */
+/*                                                                      */
+/*      Merge two consecutive sorted sections of the index. Only the    */
+/*      [nStart, nStart + nFirstGroup + nSecondGroup) range of          */
+/*      panMerged is used, so that disjoint sections can be merged      */
+/*      concurrently.                                                   */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::MergeIndexSections(const OGRField *pasIndexFields,
+                                               GIntBig *panMerged,
+                                               size_t nStart,
+                                               size_t nFirstGroup,
+                                               size_t nSecondGroup)
+
+{
     swq_select *psSelectInfo = m_pSelectInfo.get();
     const int nOrderItems = psSelectInfo->order_specs;
 
-    size_t nFirstGroup = nEntries / 2;
+    const size_t nEntries = nFirstGroup + nSecondGroup;
     size_t nFirstStart = nStart;
-    size_t nSecondGroup = nEntries - nFirstGroup;
     size_t nSecondStart = nStart + nFirstGroup;
 
-    SortIndexSection(pasIndexFields, panMerged, nFirstStart, nFirstGroup);
-    SortIndexSection(pasIndexFields, panMerged, nSecondStart, nSecondGroup);
-
-    for (size_t iMerge = 0; iMerge < nEntries; ++iMerge)
+    for (size_t iMerge = nStart; iMerge < nStart + nEntries; ++iMerge)
     {
         int nResult = 0;
 
@@ -2455,7 +3053,8 @@ void OGRGenSQLResultsLayer::SortIndexSection(const OGRField *pasIndexFields,
     }
 
     /* Copy the merge list back into the main index */
-    memcpy(m_anFIDIndex.data() + nStart, panMerged, sizeof(GIntBig) * nEntries);
+    memcpy(m_anFIDIndex.data() + nStart, panMerged + nStart,
+           sizeof(GIntBig) * nEntries);
 }
 
 /************************************************************************/
@@ -79,8 +79,13 @@ class OGRGenSQLResultsLayer final : public OGRLayer
     void CreateOrderByIndex();
     void ReadIndexFields(OGRFeature *poSrcFeat, int nOrderItems,
                          OGRField *pasIndexFields);
+    bool IsStringOrderByKey(int iKey) const;
+    bool SortIndex(const OGRField *pasIndexFields, size_t nIndexSize);
     void SortIndexSection(const OGRField *pasIndexFields, GIntBig *panMerged,
                           size_t nStart, size_t nEntries);
+    void MergeIndexSections(const OGRField *pasIndexFields,
+                            GIntBig *panMerged, size_t nStart,
+                            size_t nFirstGroup, size_t nSecondGroup);
     void FreeIndexFields(OGRField *pasIndexFields, size_t l_nIndexSize);
     int Compare(const OGRField *pasFirst, const OGRField *pasSecond);
 
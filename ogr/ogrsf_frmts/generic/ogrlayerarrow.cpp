@@ -29,6 +29,8 @@
 #include <cassert>
 #include <cinttypes>
 #include <limits>
+#include <map>
+#include <type_traits>
 #include <utility>
 #include <set>
 
@@ -3731,13 +3733,39 @@ FillValidityArrayFromWKBArray(struct ArrowArray *array, const OGRLayer *poLayer,
 }
 
 /************************************************************************/
-/*               ArrowTimestampToOGRDateTime()                          */
+/*                   OGRGetNumThreadsForArrowArray()                    */
 /************************************************************************/
 
-static void ArrowTimestampToOGRDateTime(int64_t nTimestamp,
-                                        int nInvFactorToSecond,
-                                        const char *pszTZ, OGRFeature &oFeature,
-                                        int iField)
+/** Returns the number of threads that a driver may use to build ArrowArray
+ * batches, from its pszConfigOption configuration option, or
+ * GDAL_NUM_THREADS if it is not set.
+ *
+ * Defaults to the minimum of 4 and the number of CPUs, so that a single
+ * ogr2ogr invocation does not take all cores.
+ */
+int OGRGetNumThreadsForArrowArray(const char *pszConfigOption)
+{
+    const char *pszNumThreads = CPLGetConfigOption(
+        pszConfigOption, CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    if (pszNumThreads == nullptr)
+        return std::min(4, CPLGetNumCPUs());
+    return std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                         ? CPLGetNumCPUs()
+                                         : atoi(pszNumThreads)));
+}
+
+/************************************************************************/
+/*                    OGRArrowTimestampToOGRField()                     */
+/************************************************************************/
+
+/** Converts an Arrow timestamp, expressed in 1/nInvFactorToSecond seconds
+ * since epoch, with the pszTZ timezone of the Arrow format, to the Date
+ * member of a OGRField, as OGRFeature::SetField() would set it.
+ *
+ * Returns false (and emits an error) if the year cannot be represented.
+ */
+bool OGRArrowTimestampToOGRField(int64_t nTimestamp, int nInvFactorToSecond,
+                                 const char *pszTZ, OGRField &sField)
 {
     double floatingPart = 0;
     if (nInvFactorToSecond)
@@ -3776,9 +3804,41 @@ static void ArrowTimestampToOGRDateTime(int64_t nTimestamp,
     }
     struct tm dt;
     CPLUnixTimeToYMDHMS(nTimestamp, &dt);
-    oFeature.SetField(iField, dt.tm_year + 1900, dt.tm_mon + 1, dt.tm_mday,
-                      dt.tm_hour, dt.tm_min,
-                      static_cast<float>(dt.tm_sec + floatingPart), nTZFlag);
+    const int nYear = dt.tm_year + 1900;
+    if (static_cast<GInt16>(nYear) != nYear)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Years < -32768 or > 32767 are not supported");
+        return false;
+    }
+    sField.Date.Year = static_cast<GInt16>(nYear);
+    sField.Date.Month = static_cast<GByte>(dt.tm_mon + 1);
+    sField.Date.Day = static_cast<GByte>(dt.tm_mday);
+    sField.Date.Hour = static_cast<GByte>(dt.tm_hour);
+    sField.Date.Minute = static_cast<GByte>(dt.tm_min);
+    sField.Date.Second = static_cast<float>(dt.tm_sec + floatingPart);
+    sField.Date.TZFlag = static_cast<GByte>(nTZFlag);
+    return true;
+}
+
+/************************************************************************/
+/*               ArrowTimestampToOGRDateTime()                          */
+/************************************************************************/
+
+static void ArrowTimestampToOGRDateTime(int64_t nTimestamp,
+                                        int nInvFactorToSecond,
+                                        const char *pszTZ, OGRFeature &oFeature,
+                                        int iField)
+{
+    OGRField sField;
+    if (OGRArrowTimestampToOGRField(nTimestamp, nInvFactorToSecond, pszTZ,
+                                    sField))
+    {
+        oFeature.SetField(iField, sField.Date.Year, sField.Date.Month,
+                          sField.Date.Day, sField.Date.Hour,
+                          sField.Date.Minute, sField.Date.Second,
+                          sField.Date.TZFlag);
+    }
 }
 
 /************************************************************************/
@@ -4821,6 +4881,779 @@ static bool SetFieldForOtherFormats(OGRFeature &oFeature,
     return true;
 }
 
+/************************************************************************/
+/*                     OGRArrowVectorizedFilter                         */
+/************************************************************************/
+
+namespace
+{
+
+// Vectorized evaluation of an attribute filter over the columns of an Arrow
+// record batch, as an alternative to evaluating it on an OGRFeature built for
+// each row. Only a subset of OGR SQL is supported: comparisons, IN, BETWEEN
+// and IS NULL on numeric, boolean or string columns, combined with AND, OR
+// and NOT. The expression is checked once with IsSupported(), and evaluated
+// for all rows at once by Evaluate(). NULL handling mimics
+// SWQGeneralEvaluator(), so that the selected rows are exactly the same as
+// with OGRFeatureQuery::Evaluate().
+class OGRArrowVectorizedFilter
+{
+  public:
+    // Result of a boolean sub-expression, for all rows
+    struct BoolColumn
+    {
+        std::vector<uint8_t> abyValue{};
+        std::vector<uint8_t> abyNull{};
+    };
+
+    OGRArrowVectorizedFilter(
+        OGRFeatureDefn *poFeatureDefn,
+        const std::map<std::string, std::vector<int>> &oMapFieldNameToArrowPath,
+        const struct ArrowSchema *schema, const struct ArrowArray *array)
+        : m_poFeatureDefn(poFeatureDefn),
+          m_oMapFieldNameToArrowPath(oMapFieldNameToArrowPath),
+          m_schema(schema), m_array(array),
+          m_nLength(static_cast<size_t>(array->length))
+    {
+    }
+
+    bool IsSupported(const swq_expr_node *poNode) const;
+    void Evaluate(const swq_expr_node *poNode, BoolColumn &oRes);
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(OGRArrowVectorizedFilter)
+
+    enum class Domain
+    {
+        INTEGER,
+        FLOAT,
+        STRING,
+        UNSUPPORTED
+    };
+
+    struct Column
+    {
+        const struct ArrowSchema *schema = nullptr;
+        const struct ArrowArray *array = nullptr;
+        // Parent structures that may have null rows
+        std::vector<const struct ArrowArray *> apoNullableParents{};
+    };
+
+    // Values of a numeric operand: either a column or a constant
+    template <class T> struct Operand
+    {
+        bool bIsConstant = false;
+        T constant{};
+        const std::vector<T> *pValues = nullptr;
+        const std::vector<uint8_t> *pNull = nullptr;
+
+        inline T Get(size_t i) const
+        {
+            return bIsConstant ? constant : (*pValues)[i];
+        }
+
+        inline bool IsNull(size_t i) const
+        {
+            return !bIsConstant && (*pNull)[i];
+        }
+    };
+
+    OGRFeatureDefn *const m_poFeatureDefn;
+    const std::map<std::string, std::vector<int>> &m_oMapFieldNameToArrowPath;
+    const struct ArrowSchema *const m_schema;
+    const struct ArrowArray *const m_array;
+    const size_t m_nLength;
+
+    // Decoded columns, cached as they may be used several times
+    std::map<const struct ArrowArray *, std::vector<int64_t>> m_oMapIntValues{};
+    std::map<const struct ArrowArray *, std::vector<double>> m_oMapFloatValues{};
+    std::map<const struct ArrowArray *, std::vector<uint8_t>> m_oMapNulls{};
+
+    bool GetColumn(const swq_expr_node *poNode, Column &sCol) const;
+    Domain GetComparisonDomain(const swq_expr_node *poNode) const;
+    bool IsSupportedOperand(const swq_expr_node *poNode) const;
+
+    const std::vector<uint8_t> &GetNulls(const Column &sCol);
+    template <class T> const std::vector<T> &GetValues(const Column &sCol);
+    template <class T>
+    void GetOperand(const swq_expr_node *poNode, Operand<T> &oOperand);
+
+    template <class T>
+    void EvaluateNumeric(const swq_expr_node *poNode, BoolColumn &oRes);
+    void EvaluateString(const swq_expr_node *poNode, BoolColumn &oRes);
+};
+
+/************************************************************************/
+/*                            GetColumn()                               */
+/************************************************************************/
+
+// Returns the Arrow column of a SNT_COLUMN node, if it is a regular field
+// whose Arrow type is consistent with its OGR SQL type.
+bool OGRArrowVectorizedFilter::GetColumn(const swq_expr_node *poNode,
+                                         Column &sCol) const
+{
+    if (poNode->eNodeType != SNT_COLUMN || poNode->table_index != 0 ||
+        poNode->field_index < 0 ||
+        poNode->field_index >= m_poFeatureDefn->GetFieldCount())
+    {
+        return false;
+    }
+    const auto oIter = m_oMapFieldNameToArrowPath.find(
+        m_poFeatureDefn->GetFieldDefn(poNode->field_index)->GetNameRef());
+    if (oIter == m_oMapFieldNameToArrowPath.end())
+        return false;
+
+    const struct ArrowSchema *schema = m_schema;
+    const struct ArrowArray *array = m_array;
+    std::vector<const struct ArrowArray *> apoNullableParents;
+    for (size_t i = 0; i < oIter->second.size(); ++i)
+    {
+        // A null_count of -1 means unknown: the validity buffer must be read
+        if (i > 0 && array->null_count != 0 && array->buffers[0])
+            apoNullableParents.push_back(array);
+        schema = schema->children[oIter->second[i]];
+        array = array->children[oIter->second[i]];
+    }
+
+    const char *format = schema->format;
+    bool bOK = false;
+    switch (poNode->field_type)
+    {
+        case SWQ_INTEGER:
+        case SWQ_INTEGER64:
+        case SWQ_BOOLEAN:
+            bOK = IsBoolean(format) || IsInt8(format) || IsUInt8(format) ||
+                  IsInt16(format) || IsUInt16(format) || IsInt32(format) ||
+                  IsUInt32(format) || IsInt64(format);
+            break;
+        case SWQ_FLOAT:
+            bOK = IsFloat32(format) || IsFloat64(format);
+            break;
+        case SWQ_STRING:
+            bOK = IsString(format) || IsLargeString(format);
+            break;
+        default:
+            break;
+    }
+    if (!bOK)
+        return false;
+
+    sCol.schema = schema;
+    sCol.array = array;
+    sCol.apoNullableParents = std::move(apoNullableParents);
+    return true;
+}
+
+/************************************************************************/
+/*                       IsSupportedOperand()                           */
+/************************************************************************/
+
+bool OGRArrowVectorizedFilter::IsSupportedOperand(
+    const swq_expr_node *poNode) const
+{
+    Column sCol;
+    return (poNode->eNodeType == SNT_CONSTANT && !poNode->is_null) ||
+           GetColumn(poNode, sCol);
+}
+
+/************************************************************************/
+/*                       GetComparisonDomain()                          */
+/************************************************************************/
+
+// Returns how SWQGeneralEvaluator() compares the operands of a
+// comparison, IN or BETWEEN node.
+OGRArrowVectorizedFilter::Domain
+OGRArrowVectorizedFilter::GetComparisonDomain(
+    const swq_expr_node *poNode) const
+{
+    const auto eType0 = poNode->papoSubExpr[0]->field_type;
+    const auto eType1 = poNode->papoSubExpr[1]->field_type;
+    Domain eDomain = Domain::UNSUPPORTED;
+    if (eType0 == SWQ_FLOAT || eType1 == SWQ_FLOAT)
+    {
+        if ((eType0 == SWQ_FLOAT || SWQ_IS_INTEGER(eType0)) &&
+            (eType1 == SWQ_FLOAT || SWQ_IS_INTEGER(eType1)))
+        {
+            eDomain = Domain::FLOAT;
+        }
+    }
+    else if ((SWQ_IS_INTEGER(eType0) || eType0 == SWQ_BOOLEAN) &&
+             (SWQ_IS_INTEGER(eType1) || eType1 == SWQ_BOOLEAN))
+    {
+        eDomain = Domain::INTEGER;
+    }
+    else if (eType0 == SWQ_STRING && eType1 == SWQ_STRING)
+    {
+        eDomain = Domain::STRING;
+    }
+    if (eDomain == Domain::UNSUPPORTED)
+        return eDomain;
+
+    // Only the first 2 operands are converted to the domain type by
+    // SWQGeneralEvaluator(), so require the others to already be of it.
+    for (int i = 2; i < poNode->nSubExprCount; ++i)
+    {
+        const auto eType = poNode->papoSubExpr[i]->field_type;
+        if ((eDomain == Domain::FLOAT && eType != SWQ_FLOAT) ||
+            (eDomain == Domain::INTEGER && !SWQ_IS_INTEGER(eType) &&
+             eType != SWQ_BOOLEAN) ||
+            (eDomain == Domain::STRING && eType != SWQ_STRING))
+        {
+            return Domain::UNSUPPORTED;
+        }
+    }
+    return eDomain;
+}
+
+/************************************************************************/
+/*                           IsSupported()                              */
+/************************************************************************/
+
+bool OGRArrowVectorizedFilter::IsSupported(const swq_expr_node *poNode) const
+{
+    if (poNode->eNodeType == SNT_COLUMN)
+    {
+        // Boolean column used as a predicate
+        Column sCol;
+        return poNode->field_type == SWQ_BOOLEAN && GetColumn(poNode, sCol);
+    }
+    if (poNode->eNodeType != SNT_OPERATION)
+        return false;
+
+    switch (poNode->nOperation)
+    {
+        case SWQ_AND:
+        case SWQ_OR:
+            return poNode->nSubExprCount == 2 &&
+                   IsSupported(poNode->papoSubExpr[0]) &&
+                   IsSupported(poNode->papoSubExpr[1]);
+
+        case SWQ_NOT:
+            return poNode->nSubExprCount == 1 &&
+                   IsSupported(poNode->papoSubExpr[0]);
+
+        case SWQ_ISNULL:
+        {
+            Column sCol;
+            return poNode->nSubExprCount == 1 &&
+                   GetColumn(poNode->papoSubExpr[0], sCol);
+        }
+
+        case SWQ_EQ:
+        case SWQ_NE:
+        case SWQ_GE:
+        case SWQ_LE:
+        case SWQ_LT:
+        case SWQ_GT:
+        case SWQ_IN:
+        case SWQ_BETWEEN:
+        {
+            if (poNode->nSubExprCount < 2 ||
+                (poNode->nOperation == SWQ_BETWEEN &&
+                 poNode->nSubExprCount != 3) ||
+                (poNode->nOperation != SWQ_BETWEEN &&
+                 poNode->nOperation != SWQ_IN && poNode->nSubExprCount != 2))
+            {
+                return false;
+            }
+            const Domain eDomain = GetComparisonDomain(poNode);
+            if (eDomain == Domain::UNSUPPORTED)
+                return false;
+            // String comparisons are only supported between a column and
+            // constants, and IN / BETWEEN only on a column.
+            Column sCol;
+            if ((eDomain == Domain::STRING ||
+                 poNode->nOperation == SWQ_IN ||
+                 poNode->nOperation == SWQ_BETWEEN) &&
+                !GetColumn(poNode->papoSubExpr[0], sCol))
+            {
+                return false;
+            }
+            for (int i = 0; i < poNode->nSubExprCount; ++i)
+            {
+                const auto *poSubExpr = poNode->papoSubExpr[i];
+                if (i > 0 && (eDomain == Domain::STRING ||
+                              poNode->nOperation == SWQ_IN ||
+                              poNode->nOperation == SWQ_BETWEEN))
+                {
+                    if (poSubExpr->eNodeType != SNT_CONSTANT ||
+                        poSubExpr->is_null ||
+                        (eDomain == Domain::STRING &&
+                         poSubExpr->string_value == nullptr))
+                    {
+                        return false;
+                    }
+                }
+                else if (!IsSupportedOperand(poSubExpr))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                             GetNulls()                               */
+/************************************************************************/
+
+// A row is null if the column or one of its parent structures is null, as
+// in the per-feature code path of PostFilterArrowArray().
+// A null_count of -1 (unknown) is dealt with by reading the validity buffer.
+const std::vector<uint8_t> &
+OGRArrowVectorizedFilter::GetNulls(const Column &sCol)
+{
+    auto oIter = m_oMapNulls.find(sCol.array);
+    if (oIter != m_oMapNulls.end())
+        return oIter->second;
+
+    auto &abyNull = m_oMapNulls[sCol.array];
+    abyNull.resize(m_nLength);
+    const auto MergeNulls = [this, &abyNull](const struct ArrowArray *array)
+    {
+        const uint8_t *pabyValidity =
+            array->null_count == 0
+                ? nullptr
+                : static_cast<const uint8_t *>(array->buffers[0]);
+        if (pabyValidity)
+        {
+            const size_t nOffset = static_cast<size_t>(array->offset);
+            for (size_t i = 0; i < m_nLength; ++i)
+                abyNull[i] |= !TestBit(pabyValidity, i + nOffset);
+        }
+    };
+    for (const auto *psParent : sCol.apoNullableParents)
+        MergeNulls(psParent);
+    MergeNulls(sCol.array);
+    return abyNull;
+}
+
+/************************************************************************/
+/*                            GetValues()                               */
+/************************************************************************/
+
+template <class T, class ArrowType>
+static void DecodeArrowValues(const struct ArrowArray *array, size_t nLength,
+                              std::vector<T> &aValues)
+{
+    const auto *paValues =
+        static_cast<const ArrowType *>(array->buffers[1]) +
+        static_cast<size_t>(array->offset);
+    for (size_t i = 0; i < nLength; ++i)
+        aValues[i] = static_cast<T>(paValues[i]);
+}
+
+template <class T>
+const std::vector<T> &OGRArrowVectorizedFilter::GetValues(const Column &sCol)
+{
+    auto &oMap = [this]() -> auto &
+    {
+        if constexpr (std::is_same_v<T, double>)
+            return m_oMapFloatValues;
+        else
+            return m_oMapIntValues;
+    }();
+    auto oIter = oMap.find(sCol.array);
+    if (oIter != oMap.end())
+        return oIter->second;
+
+    auto &aValues = oMap[sCol.array];
+    aValues.resize(m_nLength);
+    const char *format = sCol.schema->format;
+    const auto *array = sCol.array;
+    if (IsBoolean(format))
+    {
+        const auto *pabyData = static_cast<const uint8_t *>(array->buffers[1]);
+        const size_t nOffset = static_cast<size_t>(array->offset);
+        for (size_t i = 0; i < m_nLength; ++i)
+            aValues[i] = TestBit(pabyData, i + nOffset) ? 1 : 0;
+    }
+    else if (IsInt8(format))
+        DecodeArrowValues<T, int8_t>(array, m_nLength, aValues);
+    else if (IsUInt8(format))
+        DecodeArrowValues<T, uint8_t>(array, m_nLength, aValues);
+    else if (IsInt16(format))
+        DecodeArrowValues<T, int16_t>(array, m_nLength, aValues);
+    else if (IsUInt16(format))
+        DecodeArrowValues<T, uint16_t>(array, m_nLength, aValues);
+    else if (IsInt32(format))
+        DecodeArrowValues<T, int32_t>(array, m_nLength, aValues);
+    else if (IsUInt32(format))
+        DecodeArrowValues<T, uint32_t>(array, m_nLength, aValues);
+    else if (IsInt64(format))
+        DecodeArrowValues<T, int64_t>(array, m_nLength, aValues);
+    else if (IsFloat32(format))
+        DecodeArrowValues<T, float>(array, m_nLength, aValues);
+    else
+    {
+        CPLAssert(IsFloat64(format));
+        DecodeArrowValues<T, double>(array, m_nLength, aValues);
+    }
+    return aValues;
+}
+
+/************************************************************************/
+/*                           GetOperand()                               */
+/************************************************************************/
+
+template <class T>
+void OGRArrowVectorizedFilter::GetOperand(const swq_expr_node *poNode,
+                                          Operand<T> &oOperand)
+{
+    if (poNode->eNodeType == SNT_CONSTANT)
+    {
+        oOperand.bIsConstant = true;
+        // Same conversion as done by SWQGeneralEvaluator()
+        if constexpr (std::is_same_v<T, double>)
+        {
+            oOperand.constant = SWQ_IS_INTEGER(poNode->field_type)
+                                    ? static_cast<double>(poNode->int_value)
+                                    : poNode->float_value;
+        }
+        else
+        {
+            oOperand.constant = poNode->int_value;
+        }
+    }
+    else
+    {
+        Column sCol;
+        CPL_IGNORE_RET_VAL(GetColumn(poNode, sCol));
+        oOperand.pValues = &GetValues<T>(sCol);
+        oOperand.pNull = &GetNulls(sCol);
+    }
+}
+
+/************************************************************************/
+/*                         EvaluateNumeric()                            */
+/************************************************************************/
+
+template <class T>
+void OGRArrowVectorizedFilter::EvaluateNumeric(const swq_expr_node *poNode,
+                                               BoolColumn &oRes)
+{
+    auto &abyValue = oRes.abyValue;
+    auto &abyNull = oRes.abyNull;
+
+    Operand<T> oFirst;
+    GetOperand(poNode->papoSubExpr[0], oFirst);
+
+    if (poNode->nOperation == SWQ_IN)
+    {
+        // Constants only, and never null
+        std::vector<T> aValues;
+        for (int i = 1; i < poNode->nSubExprCount; ++i)
+        {
+            Operand<T> oOperand;
+            GetOperand(poNode->papoSubExpr[i], oOperand);
+            aValues.push_back(oOperand.constant);
+        }
+        for (size_t i = 0; i < m_nLength; ++i)
+        {
+            abyNull[i] = oFirst.IsNull(i);
+            const T v = oFirst.Get(i);
+            bool bMatch = false;
+            for (const T &val : aValues)
+                bMatch |= (v == val);
+            abyValue[i] = !abyNull[i] && bMatch;
+        }
+        return;
+    }
+
+    Operand<T> oSecond;
+    GetOperand(poNode->papoSubExpr[1], oSecond);
+
+    const auto Compare = [this, &abyValue, &abyNull, &oFirst,
+                          &oSecond](auto cmp)
+    {
+        for (size_t i = 0; i < m_nLength; ++i)
+        {
+            const bool bNull = oFirst.IsNull(i) || oSecond.IsNull(i);
+            abyNull[i] = bNull;
+            abyValue[i] = !bNull && cmp(oFirst.Get(i), oSecond.Get(i));
+        }
+    };
+
+    switch (poNode->nOperation)
+    {
+        case SWQ_EQ:
+            Compare([](T a, T b) { return a == b; });
+            break;
+        case SWQ_NE:
+            Compare([](T a, T b) { return a != b; });
+            break;
+        case SWQ_GE:
+            Compare([](T a, T b) { return a >= b; });
+            break;
+        case SWQ_LE:
+            Compare([](T a, T b) { return a <= b; });
+            break;
+        case SWQ_LT:
+            Compare([](T a, T b) { return a < b; });
+            break;
+        case SWQ_GT:
+            Compare([](T a, T b) { return a > b; });
+            break;
+        case SWQ_BETWEEN:
+        {
+            Operand<T> oThird;
+            GetOperand(poNode->papoSubExpr[2], oThird);
+            const T maxVal = oThird.constant;
+            Compare([maxVal](T a, T b) { return a >= b && a <= maxVal; });
+            break;
+        }
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                       Case insensitive helpers                       */
+/************************************************************************/
+
+// Equivalent of strncasecmp(a, b, n), on strings that are not necessarily
+// nul-terminated, but whose length (up to the first nul character) is known.
+static int ArrowStrNCaseCmp(const char *a, size_t la, const char *b,
+                            size_t lb, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        const int ca =
+            i < la ? tolower(static_cast<unsigned char>(a[i])) : 0;
+        const int cb =
+            i < lb ? tolower(static_cast<unsigned char>(b[i])) : 0;
+        if (ca != cb)
+            return ca - cb;
+        if (ca == 0)
+            return 0;
+    }
+    return 0;
+}
+
+// Equivalent of strcasecmp(a, b)
+static int ArrowStrCaseCmp(const char *a, size_t la, const char *b, size_t lb)
+{
+    return ArrowStrNCaseCmp(a, la, b, lb, std::max(la, lb) + 1);
+}
+
+// Same logic as the SWQ_EQ case for strings in SWQGeneralEvaluator(),
+// which handles the optional +00 suffix of timestamps.
+static bool ArrowStrEqual(const char *a, size_t la, const char *b, size_t lb)
+{
+    if (la > 3 && lb > 3)
+    {
+        if (memcmp(a + la - 3, "+00", 3) == 0 && b[lb - 3] == ':')
+            return ArrowStrNCaseCmp(a, la, b, lb, lb) == 0;
+        if (a[la - 3] == ':' && memcmp(b + lb - 3, "+00", 3) == 0)
+            return ArrowStrNCaseCmp(a, la, b, lb, la) == 0;
+    }
+    return ArrowStrCaseCmp(a, la, b, lb) == 0;
+}
+
+/************************************************************************/
+/*                          EvaluateString()                            */
+/************************************************************************/
+
+void OGRArrowVectorizedFilter::EvaluateString(const swq_expr_node *poNode,
+                                              BoolColumn &oRes)
+{
+    Column sCol;
+    CPL_IGNORE_RET_VAL(GetColumn(poNode->papoSubExpr[0], sCol));
+    const auto &abyColNull = GetNulls(sCol);
+    const bool bLarge = IsLargeString(sCol.schema->format);
+    const auto *array = sCol.array;
+    const size_t nOffset = static_cast<size_t>(array->offset);
+    const char *pachData = static_cast<const char *>(array->buffers[2]);
+
+    std::vector<std::pair<const char *, size_t>> aConstants;
+    for (int i = 1; i < poNode->nSubExprCount; ++i)
+    {
+        const char *pszVal = poNode->papoSubExpr[i]->string_value;
+        aConstants.emplace_back(pszVal, strlen(pszVal));
+    }
+
+    for (size_t i = 0; i < m_nLength; ++i)
+    {
+        oRes.abyNull[i] = abyColNull[i];
+        if (abyColNull[i])
+        {
+            oRes.abyValue[i] = false;
+            continue;
+        }
+
+        size_t nStart, nEnd;
+        if (bLarge)
+        {
+            const auto *panOffsets =
+                static_cast<const uint64_t *>(array->buffers[1]);
+            nStart = static_cast<size_t>(panOffsets[i + nOffset]);
+            nEnd = static_cast<size_t>(panOffsets[i + nOffset + 1]);
+        }
+        else
+        {
+            const auto *panOffsets =
+                static_cast<const uint32_t *>(array->buffers[1]);
+            nStart = panOffsets[i + nOffset];
+            nEnd = panOffsets[i + nOffset + 1];
+        }
+        const char *pachVal = pachData + nStart;
+        // The per-feature evaluation sees the value up to its first nul
+        // character.
+        const void *pNul = memchr(pachVal, 0, nEnd - nStart);
+        const size_t nLen =
+            pNul ? static_cast<size_t>(static_cast<const char *>(pNul) -
+                                       pachVal)
+                 : nEnd - nStart;
+
+        bool bRes = false;
+        switch (poNode->nOperation)
+        {
+            case SWQ_EQ:
+                bRes = ArrowStrEqual(pachVal, nLen, aConstants[0].first,
+                                     aConstants[0].second);
+                break;
+            case SWQ_NE:
+                bRes = ArrowStrCaseCmp(pachVal, nLen, aConstants[0].first,
+                                       aConstants[0].second) != 0;
+                break;
+            case SWQ_GE:
+                bRes = ArrowStrCaseCmp(pachVal, nLen, aConstants[0].first,
+                                       aConstants[0].second) >= 0;
+                break;
+            case SWQ_LE:
+                bRes = ArrowStrCaseCmp(pachVal, nLen, aConstants[0].first,
+                                       aConstants[0].second) <= 0;
+                break;
+            case SWQ_LT:
+                bRes = ArrowStrCaseCmp(pachVal, nLen, aConstants[0].first,
+                                       aConstants[0].second) < 0;
+                break;
+            case SWQ_GT:
+                bRes = ArrowStrCaseCmp(pachVal, nLen, aConstants[0].first,
+                                       aConstants[0].second) > 0;
+                break;
+            case SWQ_IN:
+                for (const auto &oConstant : aConstants)
+                {
+                    if (ArrowStrCaseCmp(pachVal, nLen, oConstant.first,
+                                        oConstant.second) == 0)
+                    {
+                        bRes = true;
+                        break;
+                    }
+                }
+                break;
+            case SWQ_BETWEEN:
+                bRes = ArrowStrCaseCmp(pachVal, nLen, aConstants[0].first,
+                                       aConstants[0].second) >= 0 &&
+                       ArrowStrCaseCmp(pachVal, nLen, aConstants[1].first,
+                                       aConstants[1].second) <= 0;
+                break;
+            default:
+                CPLAssert(false);
+                break;
+        }
+        oRes.abyValue[i] = bRes;
+    }
+}
+
+/************************************************************************/
+/*                            Evaluate()                                */
+/************************************************************************/
+
+void OGRArrowVectorizedFilter::Evaluate(const swq_expr_node *poNode,
+                                        BoolColumn &oRes)
+{
+    oRes.abyValue.resize(m_nLength);
+    oRes.abyNull.resize(m_nLength);
+    auto &abyValue = oRes.abyValue;
+    auto &abyNull = oRes.abyNull;
+
+    if (poNode->eNodeType == SNT_COLUMN)
+    {
+        Column sCol;
+        CPL_IGNORE_RET_VAL(GetColumn(poNode, sCol));
+        const auto &anValues = GetValues<int64_t>(sCol);
+        abyNull = GetNulls(sCol);
+        for (size_t i = 0; i < m_nLength; ++i)
+            abyValue[i] = !abyNull[i] && anValues[i] != 0;
+        return;
+    }
+
+    switch (poNode->nOperation)
+    {
+        case SWQ_AND:
+        case SWQ_OR:
+        {
+            Evaluate(poNode->papoSubExpr[0], oRes);
+            BoolColumn oOther;
+            Evaluate(poNode->papoSubExpr[1], oOther);
+            if (poNode->nOperation == SWQ_AND)
+            {
+                for (size_t i = 0; i < m_nLength; ++i)
+                {
+                    abyValue[i] = abyValue[i] & oOther.abyValue[i];
+                    abyNull[i] = abyNull[i] & oOther.abyNull[i];
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < m_nLength; ++i)
+                {
+                    abyValue[i] = abyValue[i] | oOther.abyValue[i];
+                    abyNull[i] = abyNull[i] | oOther.abyNull[i];
+                }
+            }
+            break;
+        }
+
+        case SWQ_NOT:
+        {
+            Evaluate(poNode->papoSubExpr[0], oRes);
+            for (size_t i = 0; i < m_nLength; ++i)
+                abyValue[i] = !abyValue[i] && !abyNull[i];
+            break;
+        }
+
+        case SWQ_ISNULL:
+        {
+            Column sCol;
+            CPL_IGNORE_RET_VAL(GetColumn(poNode->papoSubExpr[0], sCol));
+            abyValue = GetNulls(sCol);
+            std::fill(abyNull.begin(), abyNull.end(), 0);
+            break;
+        }
+
+        default:
+        {
+            switch (GetComparisonDomain(poNode))
+            {
+                case Domain::INTEGER:
+                    EvaluateNumeric<int64_t>(poNode, oRes);
+                    break;
+                case Domain::FLOAT:
+                    EvaluateNumeric<double>(poNode, oRes);
+                    break;
+                case Domain::STRING:
+                    EvaluateString(poNode, oRes);
+                    break;
+                case Domain::UNSUPPORTED:
+                    CPLAssert(false);
+                    break;
+            }
+            break;
+        }
+    }
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                 FillValidityArrayFromAttrQuery()                     */
 /************************************************************************/
@@ -4839,6 +5672,34 @@ static size_t FillValidityArrayFromAttrQuery(
     BuildMapFieldNameToArrowPath(schema, oMapFieldNameToArrowPath,
                                  std::string(), anArrowPathTmp);
 
+    const size_t nLength = abyValidityFromFilters.size();
+
+    // Try first to evaluate the filter on whole columns, which is much
+    // faster than building a feature for each row.
+    const swq_expr_node *poExpr =
+        static_cast<const swq_expr_node *>(poAttrQuery->GetSWQExpr());
+    if (poExpr && CPLTestBool(CPLGetConfigOption(
+                      "OGR_ARROW_VECTORIZED_ATTRIBUTE_FILTER", "YES")))
+    {
+        OGRArrowVectorizedFilter oFilter(
+            poFeatureDefn, oMapFieldNameToArrowPath, schema, array);
+        if (oFilter.IsSupported(poExpr))
+        {
+            OGRArrowVectorizedFilter::BoolColumn oRes;
+            oFilter.Evaluate(poExpr, oRes);
+            for (size_t iRow = 0; iRow < nLength; ++iRow)
+            {
+                if (!abyValidityFromFilters[iRow])
+                    continue;
+                if (oRes.abyValue[iRow])
+                    nCountIntersecting++;
+                else
+                    abyValidityFromFilters[iRow] = false;
+            }
+            return nCountIntersecting;
+        }
+    }
+
     struct UsedFieldsInfo
     {
         int iOGRFieldIndex{};
@@ -4879,8 +5740,6 @@ static size_t FillValidityArrayFromAttrQuery(
         }
     }
 
-    const size_t nLength = abyValidityFromFilters.size();
-
     GIntBig nBaseSeqFID = -1;
     std::vector<int> anArrowPathToFIDColumn;
     if (bNeedsFID)
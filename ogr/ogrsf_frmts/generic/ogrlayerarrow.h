@@ -14,7 +14,9 @@
 #define OGRLAYERARROW_H_DEFINED
 
 #include "cpl_port.h"
+#include "ogr_core.h"
 
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -39,6 +41,12 @@ bool CPL_DLL OGRCloneArrowArray(const struct ArrowSchema *schema,
 bool CPL_DLL OGRCloneArrowSchema(const struct ArrowSchema *schema,
                                  struct ArrowSchema *out_schema);
 
+bool CPL_DLL OGRArrowTimestampToOGRField(int64_t nTimestamp,
+                                         int nInvFactorToSecond,
+                                         const char *pszTZ, OGRField &sField);
+
+int CPL_DLL OGRGetNumThreadsForArrowArray(const char *pszConfigOption);
+
 /** C++ wrapper on top of ArrowArrayStream */
 class OGRArrowArrayStream
 {
@@ -75,6 +75,8 @@ class OGRGeoJSONLayer final : public OGRMemLayer
     virtual OGRFeature *GetNextFeature() override;
     virtual OGRFeature *GetFeature(GIntBig nFID) override;
     virtual GIntBig GetFeatureCount(int bForce) override;
+    int GetNextArrowArray(struct ArrowArrayStream *,
+                          struct ArrowArray *out_array) override;
 
     OGRErr ISetFeature(OGRFeature *poFeature) override;
     OGRErr ICreateFeature(OGRFeature *poFeature) override;
@@ -147,6 +149,7 @@ class OGRGeoJSONLayer final : public OGRMemLayer
     GIntBig nFeatureReadSinceReset_ = 0;
     bool m_bSupportsMGeometries = false;
     bool m_bSupportsZGeometries = true;
+    bool m_bArrowArrayFallback = false;
 
     //! Write options used by ICreateFeature() in append scenarios
     OGRGeoJSONWriteOptions oWriteOptions_;
@@ -154,6 +157,7 @@ class OGRGeoJSONLayer final : public OGRMemLayer
     bool IngestAll();
     void TerminateAppendSession();
     bool SetOrUpdateFeaturePreparation();
+    bool CanUseNativeGetNextArrowArray();
 
     CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONLayer)
 };
@@ -0,0 +1,1641 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Direct translation of GeoJSON features to Arrow arrays
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "ogrgeojsonarrowreader.h"
+
+#include "cpl_error.h"
+#include "ogrgeojsonreader.h"
+#include "ogrlayerarrow.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+//! @cond Doxygen_Suppress
+
+namespace
+{
+enum class NumberType
+{
+    INTEGER,
+    REAL,
+    INVALID,
+};
+}  // namespace
+
+/************************************************************************/
+/*                      OGRGeoJSONArrowParseNumber()                    */
+/************************************************************************/
+
+// Same conversion as OGRJSONCollectionStreamingParser::Number(). Integers
+// that might not fit on a int64 are rejected, as well as numbers that would
+// not be correctly handled by CPLAtoGIntBig().
+
+static NumberType OGRGeoJSONArrowParseNumber(const char *pszValue,
+                                             size_t nLength, GIntBig &nVal,
+                                             double &dfVal)
+{
+    const CPLValueType eType = CPLGetValueType(pszValue);
+    if (eType == CPL_VALUE_REAL)
+    {
+        dfVal = CPLAtof(pszValue);
+        return NumberType::REAL;
+    }
+    if (eType == CPL_VALUE_INTEGER)
+    {
+        const size_t nDigits = pszValue[0] == '-' ? nLength - 1 : nLength;
+        if (nDigits > 18)
+            return NumberType::INVALID;
+        nVal = CPLAtoGIntBig(pszValue);
+        return NumberType::INTEGER;
+    }
+    if (nLength == strlen("Infinity") && EQUAL(pszValue, "Infinity"))
+    {
+        dfVal = std::numeric_limits<double>::infinity();
+        return NumberType::REAL;
+    }
+    if (nLength == strlen("-Infinity") && EQUAL(pszValue, "-Infinity"))
+    {
+        dfVal = -std::numeric_limits<double>::infinity();
+        return NumberType::REAL;
+    }
+    if (nLength == strlen("NaN") && EQUAL(pszValue, "NaN"))
+    {
+        dfVal = std::numeric_limits<double>::quiet_NaN();
+        return NumberType::REAL;
+    }
+    return NumberType::INVALID;
+}
+
+/************************************************************************/
+/*                      OGRGeoJSONArrowRowBuilder()                     */
+/************************************************************************/
+
+OGRGeoJSONArrowRowBuilder::OGRGeoJSONArrowRowBuilder(
+    const OGRGeoJSONBaseReader &oReader, OGRLayer *poLayer)
+    : m_poFeatureDefn(poLayer->GetLayerDefn()),
+      m_nFieldCount(m_poFeatureDefn->GetFieldCount()),
+      m_bAttributesSkip(oReader.bAttributesSkip_),
+      m_bFeatureLevelIdAsFID(oReader.bFeatureLevelIdAsFID_),
+      m_nMemLimit(OGRArrowArrayHelper::GetMemLimit())
+{
+    const char *pszFIDColumn = poLayer->GetFIDColumn();
+    m_abSkipField.resize(m_nFieldCount);
+    m_abFIDField.resize(m_nFieldCount);
+    for (int i = 0; i < m_nFieldCount; ++i)
+    {
+        const OGRFieldDefn *poFieldDefn =
+            m_poFeatureDefn->GetFieldDefnUnsafe(i);
+        const auto eType = poFieldDefn->GetType();
+        m_abFIDField[i] = (eType == OFTInteger || eType == OFTInteger64) &&
+                          EQUAL(poFieldDefn->GetNameRef(), pszFIDColumn);
+        m_abSkipField[i] = poFieldDefn->IsIgnored() && !m_abFIDField[i];
+        m_oMapFieldNameToIdx.emplace(poFieldDefn->GetNameRef(), i);
+    }
+    m_iIdField = m_poFeatureDefn->GetFieldIndexCaseSensitive("id");
+    m_bSkipGeometry = m_poFeatureDefn->GetGeomFieldCount() == 0 ||
+                      m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored();
+
+    m_asFields.resize(m_nFieldCount);
+    m_aeFieldState.resize(m_nFieldCount, FieldState::UNSET);
+    m_aosStrings.resize(m_nFieldCount);
+}
+
+/************************************************************************/
+/*                            IsCompatible()                            */
+/************************************************************************/
+
+/* static */
+bool OGRGeoJSONArrowRowBuilder::IsCompatible(
+    const OGRGeoJSONBaseReader &oReader, OGRLayer *poLayer,
+    const CPLStringList &aosArrowArrayStreamOptions)
+{
+    if (oReader.bIsGeocouchSpatiallistFormat ||
+        oReader.bFlattenNestedAttributes_ || !oReader.bGeometryPreserve_ ||
+        oReader.eForeignMemberProcessing_ !=
+            OGRGeoJSONBaseReader::ForeignMemberProcessing::NONE ||
+        aosArrowArrayStreamOptions.FetchBool(GAS_OPT_DATETIME_AS_STRING,
+                                             false))
+    {
+        return false;
+    }
+
+    const OGRFeatureDefn *poFeatureDefn = poLayer->GetLayerDefn();
+    if (poFeatureDefn->GetGeomFieldCount() > 1)
+        return false;
+
+    // List fields, or strings holding JSON arrays or objects, are not
+    // handled by OGRGeoJSONArrowRowBuilder
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); ++i)
+    {
+        const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefnUnsafe(i);
+        switch (poFieldDefn->GetType())
+        {
+            case OFTInteger:
+                if (poFieldDefn->GetSubType() != OFSTNone &&
+                    poFieldDefn->GetSubType() != OFSTBoolean)
+                {
+                    return false;
+                }
+                break;
+            case OFTString:
+                if (poFieldDefn->GetSubType() != OFSTNone)
+                    return false;
+                break;
+            case OFTInteger64:
+            case OFTReal:
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                            StartFeature()                            */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::StartFeature()
+{
+    m_nDepth = 0;
+    m_nSkipDepth = 0;
+    m_eTarget = Target::NONE;
+    m_iCurField = -1;
+    m_bInProperties = false;
+    m_bInGeometry = false;
+    m_bFeatureComplete = false;
+    m_bUnsupported = false;
+    m_bTypeSeen = false;
+    m_bIdSeen = false;
+    m_bPropertiesSeen = false;
+    m_bGeometrySeen = false;
+    m_bGeomTypeSeen = false;
+    m_bCoordinatesSeen = false;
+    m_bHasProperties = false;
+    m_bTopLevelMemberIsField = false;
+    m_eIdKind = IdKind::NONE;
+    m_eGeomType = wkbUnknown;
+    m_asCoordArrays.clear();
+    m_anCoordArrayStack.clear();
+    m_adfCoords.clear();
+    m_bHasZ = false;
+    m_iNextFieldGuess = 0;
+
+    m_bIsFeature = false;
+    m_nFID = OGRNullFID;
+    m_bHasFIDFromField = false;
+    std::fill(m_aeFieldState.begin(), m_aeFieldState.end(),
+              FieldState::UNSET);
+    m_bHasGeometry = false;
+    m_abyWKB.clear();
+}
+
+/************************************************************************/
+/*                           SetUnsupported()                           */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::SetUnsupported()
+{
+    m_bUnsupported = true;
+}
+
+/************************************************************************/
+/*                            GetFieldIndex()                           */
+/************************************************************************/
+
+int OGRGeoJSONArrowRowBuilder::GetFieldIndex(const char *pszKey)
+{
+    // Properties are generally in the order of the layer fields
+    if (m_iNextFieldGuess < m_nFieldCount &&
+        strcmp(m_poFeatureDefn->GetFieldDefnUnsafe(m_iNextFieldGuess)
+                   ->GetNameRef(),
+               pszKey) == 0)
+    {
+        return m_iNextFieldGuess++;
+    }
+    const auto oIter = m_oMapFieldNameToIdx.find(pszKey);
+    if (oIter == m_oMapFieldNameToIdx.end())
+        return -1;
+    m_iNextFieldGuess = oIter->second + 1;
+    return oIter->second;
+}
+
+/************************************************************************/
+/*                            StartObject()                             */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::StartObject()
+{
+    if (m_bUnsupported)
+        return;
+    if (m_nSkipDepth > 0)
+    {
+        ++m_nSkipDepth;
+        return;
+    }
+    if (m_nDepth == 0)
+    {
+        m_nDepth = 1;
+        return;
+    }
+
+    const Target eTarget = m_eTarget;
+    m_eTarget = Target::NONE;
+    switch (eTarget)
+    {
+        case Target::SKIP:
+        case Target::TYPE:
+            m_nSkipDepth = 1;
+            break;
+
+        case Target::PROPERTIES:
+            m_bHasProperties = true;
+            m_bInProperties = true;
+            ++m_nDepth;
+            break;
+
+        case Target::GEOMETRY:
+            m_bInGeometry = true;
+            ++m_nDepth;
+            break;
+
+        default:
+            SetUnsupported();
+            break;
+    }
+}
+
+/************************************************************************/
+/*                             EndObject()                              */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::EndObject()
+{
+    if (m_bUnsupported)
+        return;
+    if (m_nSkipDepth > 0)
+    {
+        --m_nSkipDepth;
+        return;
+    }
+
+    --m_nDepth;
+    if (m_nDepth == 0)
+    {
+        FinishFeature();
+    }
+    else if (m_bInProperties)
+    {
+        m_bInProperties = false;
+    }
+    else if (m_bInGeometry)
+    {
+        m_bInGeometry = false;
+        FinishGeometry();
+    }
+}
+
+/************************************************************************/
+/*                         StartObjectMember()                          */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::StartObjectMember(const char *pszKey,
+                                                  size_t /* nKeyLen */)
+{
+    if (m_bUnsupported || m_nSkipDepth > 0)
+        return;
+
+    m_eTarget = Target::SKIP;
+
+    if (m_bInProperties)
+    {
+        const int iField = GetFieldIndex(pszKey);
+        if (iField >= 0 && !m_abSkipField[iField])
+        {
+            m_eTarget = Target::FIELD;
+            m_iCurField = iField;
+        }
+        return;
+    }
+
+    // OGRGeoJSONFindMemberByName() is case insensitive and returns the
+    // first member found, whereas json-c retains the last duplicate:
+    // do not try to replicate that.
+    const auto CheckMember = [this, pszKey](const char *pszName, bool &bSeen)
+    {
+        if (strcmp(pszKey, pszName) == 0)
+        {
+            if (bSeen)
+                SetUnsupported();
+            bSeen = true;
+            return true;
+        }
+        if (EQUAL(pszKey, pszName))
+            SetUnsupported();
+        return false;
+    };
+
+    if (m_bInGeometry)
+    {
+        if (CheckMember("type", m_bGeomTypeSeen))
+            m_eTarget = Target::GEOMETRY_TYPE;
+        else if (CheckMember("coordinates", m_bCoordinatesSeen))
+            m_eTarget = Target::COORDINATES;
+        else if (EQUAL(pszKey, "crs"))
+            SetUnsupported();
+        return;
+    }
+
+    if (!m_bTopLevelMemberIsField &&
+        m_oMapFieldNameToIdx.find(pszKey) != m_oMapFieldNameToIdx.end())
+    {
+        m_bTopLevelMemberIsField = true;
+    }
+
+    if (CheckMember("type", m_bTypeSeen))
+        m_eTarget = Target::TYPE;
+    else if (CheckMember("id", m_bIdSeen))
+        m_eTarget = Target::ID;
+    else if (CheckMember("properties", m_bPropertiesSeen))
+        m_eTarget = m_bAttributesSkip ? Target::SKIP : Target::PROPERTIES;
+    else if (CheckMember("geometry", m_bGeometrySeen))
+        m_eTarget = m_bSkipGeometry ? Target::SKIP : Target::GEOMETRY;
+}
+
+/************************************************************************/
+/*                             StartArray()                             */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::StartArray()
+{
+    if (m_bUnsupported)
+        return;
+    if (m_nSkipDepth > 0)
+    {
+        ++m_nSkipDepth;
+        return;
+    }
+
+    if (!m_anCoordArrayStack.empty())
+    {
+        CoordArray &oParent = m_asCoordArrays[m_anCoordArrayStack.back()];
+        if (oParent.bIsPosition)
+        {
+            SetUnsupported();
+            return;
+        }
+        ++oParent.nCount;
+        m_anCoordArrayStack.push_back(m_asCoordArrays.size());
+        m_asCoordArrays.emplace_back();
+        ++m_nDepth;
+        return;
+    }
+
+    const Target eTarget = m_eTarget;
+    m_eTarget = Target::NONE;
+    switch (eTarget)
+    {
+        case Target::COORDINATES:
+            m_anCoordArrayStack.push_back(m_asCoordArrays.size());
+            m_asCoordArrays.emplace_back();
+            ++m_nDepth;
+            break;
+
+        case Target::PROPERTIES:
+            // Not an object, hence ignored, but it still prevents top
+            // level members from being used as fields.
+            m_bHasProperties = true;
+            m_nSkipDepth = 1;
+            break;
+
+        case Target::SKIP:
+        case Target::TYPE:
+            m_nSkipDepth = 1;
+            break;
+
+        default:
+            SetUnsupported();
+            break;
+    }
+}
+
+/************************************************************************/
+/*                              EndArray()                              */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::EndArray()
+{
+    if (m_bUnsupported)
+        return;
+    if (m_nSkipDepth > 0)
+    {
+        --m_nSkipDepth;
+        return;
+    }
+    if (m_anCoordArrayStack.empty())
+    {
+        SetUnsupported();
+        return;
+    }
+
+    --m_nDepth;
+    const CoordArray &oArray = m_asCoordArrays[m_anCoordArrayStack.back()];
+    m_anCoordArrayStack.pop_back();
+    if (oArray.bIsPosition)
+    {
+        // OGRGeoJSONReadRawPoint() requires at least 2 values
+        if (oArray.nCount < 2)
+        {
+            SetUnsupported();
+            return;
+        }
+        m_adfCoords.push_back(m_adfPos[0]);
+        m_adfCoords.push_back(m_adfPos[1]);
+        m_adfCoords.push_back(oArray.nCount == 3 ? m_adfPos[2] : 0.0);
+        if (oArray.nCount == 3)
+            m_bHasZ = true;
+    }
+}
+
+/************************************************************************/
+/*                               String()                               */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::String(const char *pszValue,
+                                       size_t /* nLength */)
+{
+    if (m_bUnsupported || m_nSkipDepth > 0)
+        return;
+    if (!m_anCoordArrayStack.empty())
+    {
+        SetUnsupported();
+        return;
+    }
+
+    const Target eTarget = m_eTarget;
+    m_eTarget = Target::NONE;
+    switch (eTarget)
+    {
+        case Target::SKIP:
+            break;
+
+        case Target::TYPE:
+            m_bIsFeature = strcmp(pszValue, "Feature") == 0;
+            break;
+
+        case Target::ID:
+            m_eIdKind = IdKind::STRING;
+            m_osId.assign(pszValue);
+            break;
+
+        case Target::PROPERTIES:
+            m_bHasProperties = true;
+            break;
+
+        case Target::FIELD:
+            SetFieldFromString(m_iCurField, pszValue);
+            break;
+
+        case Target::GEOMETRY_TYPE:
+            // Same as OGRGeoJSONGetType()
+            if (EQUAL(pszValue, "Point"))
+                m_eGeomType = wkbPoint;
+            else if (EQUAL(pszValue, "LineString"))
+                m_eGeomType = wkbLineString;
+            else if (EQUAL(pszValue, "Polygon"))
+                m_eGeomType = wkbPolygon;
+            else if (EQUAL(pszValue, "MultiPoint"))
+                m_eGeomType = wkbMultiPoint;
+            else if (EQUAL(pszValue, "MultiLineString"))
+                m_eGeomType = wkbMultiLineString;
+            else if (EQUAL(pszValue, "MultiPolygon"))
+                m_eGeomType = wkbMultiPolygon;
+            else
+                SetUnsupported();
+            break;
+
+        default:
+            SetUnsupported();
+            break;
+    }
+}
+
+/************************************************************************/
+/*                               Number()                               */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::Number(const char *pszValue, size_t nLength)
+{
+    if (m_bUnsupported || m_nSkipDepth > 0)
+        return;
+
+    GIntBig nVal = 0;
+    double dfVal = 0;
+    if (!m_anCoordArrayStack.empty())
+    {
+        CoordArray &oArray = m_asCoordArrays[m_anCoordArrayStack.back()];
+        if ((oArray.nCount > 0 && !oArray.bIsPosition) || oArray.nCount == 3)
+        {
+            SetUnsupported();
+            return;
+        }
+        const auto eNumberType =
+            OGRGeoJSONArrowParseNumber(pszValue, nLength, nVal, dfVal);
+        if (eNumberType == NumberType::INVALID)
+        {
+            SetUnsupported();
+            return;
+        }
+        m_adfPos[oArray.nCount] = eNumberType == NumberType::INTEGER
+                                      ? static_cast<double>(nVal)
+                                      : dfVal;
+        ++oArray.nCount;
+        oArray.bIsPosition = true;
+        return;
+    }
+
+    const Target eTarget = m_eTarget;
+    m_eTarget = Target::NONE;
+    switch (eTarget)
+    {
+        case Target::SKIP:
+        case Target::TYPE:
+            break;
+
+        case Target::PROPERTIES:
+            m_bHasProperties = true;
+            break;
+
+        case Target::ID:
+        case Target::FIELD:
+        {
+            const auto eNumberType =
+                OGRGeoJSONArrowParseNumber(pszValue, nLength, nVal, dfVal);
+            if (eNumberType == NumberType::INVALID)
+            {
+                SetUnsupported();
+            }
+            else if (eTarget == Target::ID)
+            {
+                if (eNumberType == NumberType::INTEGER)
+                {
+                    m_eIdKind = IdKind::INTEGER;
+                    m_nId = nVal;
+                }
+                else
+                {
+                    m_eIdKind = IdKind::OTHER;
+                }
+            }
+            else if (eNumberType == NumberType::INTEGER)
+            {
+                SetFieldFromInteger(m_iCurField, nVal);
+            }
+            else
+            {
+                SetFieldFromReal(m_iCurField, dfVal);
+            }
+            break;
+        }
+
+        default:
+            SetUnsupported();
+            break;
+    }
+}
+
+/************************************************************************/
+/*                              Boolean()                               */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::Boolean(bool bVal)
+{
+    if (m_bUnsupported || m_nSkipDepth > 0)
+        return;
+    if (!m_anCoordArrayStack.empty())
+    {
+        SetUnsupported();
+        return;
+    }
+
+    const Target eTarget = m_eTarget;
+    m_eTarget = Target::NONE;
+    switch (eTarget)
+    {
+        case Target::SKIP:
+        case Target::TYPE:
+            break;
+
+        case Target::ID:
+            m_eIdKind = IdKind::OTHER;
+            break;
+
+        case Target::PROPERTIES:
+            m_bHasProperties = true;
+            break;
+
+        case Target::FIELD:
+        {
+            if (m_poFeatureDefn->GetFieldDefnUnsafe(m_iCurField)->GetType() ==
+                OFTString)
+            {
+                SetFieldFromString(m_iCurField, bVal ? "true" : "false");
+            }
+            else if (m_poFeatureDefn->GetFieldDefnUnsafe(m_iCurField)
+                         ->GetType() == OFTReal)
+            {
+                SetFieldFromReal(m_iCurField, bVal ? 1.0 : 0.0);
+            }
+            else
+            {
+                SetFieldFromInteger(m_iCurField, bVal ? 1 : 0);
+            }
+            break;
+        }
+
+        default:
+            SetUnsupported();
+            break;
+    }
+}
+
+/************************************************************************/
+/*                                Null()                                */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::Null()
+{
+    if (m_bUnsupported || m_nSkipDepth > 0)
+        return;
+    if (!m_anCoordArrayStack.empty())
+    {
+        SetUnsupported();
+        return;
+    }
+
+    // A null member is seen as absent by OGRGeoJSONFindMemberByName() and
+    // CPL_json_object_object_get()
+    const Target eTarget = m_eTarget;
+    m_eTarget = Target::NONE;
+    switch (eTarget)
+    {
+        case Target::SKIP:
+        case Target::TYPE:
+        case Target::ID:
+        case Target::PROPERTIES:
+        case Target::GEOMETRY:
+            break;
+
+        case Target::FIELD:
+            m_aeFieldState[m_iCurField] = FieldState::NULL_VALUE;
+            if (m_abFIDField[m_iCurField])
+                m_bHasFIDFromField = false;
+            break;
+
+        default:
+            SetUnsupported();
+            break;
+    }
+}
+
+/************************************************************************/
+/*                         SetFieldFromString()                         */
+/************************************************************************/
+
+// The Set*() methods below mimic OGRGeoJSONReaderSetField()
+
+void OGRGeoJSONArrowRowBuilder::SetFieldFromString(int iField,
+                                                   const char *pszValue)
+{
+    switch (m_poFeatureDefn->GetFieldDefnUnsafe(iField)->GetType())
+    {
+        case OFTString:
+            m_aosStrings[iField].assign(pszValue);
+            m_aeFieldState[iField] = FieldState::SET;
+            break;
+
+        case OFTDate:
+        case OFTTime:
+        case OFTDateTime:
+        {
+            // The field is left untouched if the value cannot be parsed
+            OGRField sField;
+            if (OGRParseDate(pszValue, &sField, 0))
+            {
+                m_asFields[iField] = sField;
+                m_aeFieldState[iField] = FieldState::SET;
+            }
+            break;
+        }
+
+        default:
+            SetUnsupported();
+            break;
+    }
+}
+
+/************************************************************************/
+/*                         SetFieldFromInteger()                        */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::SetFieldFromInteger(int iField, GIntBig nVal)
+{
+    const OGRFieldDefn *poFieldDefn =
+        m_poFeatureDefn->GetFieldDefnUnsafe(iField);
+    switch (poFieldDefn->GetType())
+    {
+        case OFTInteger:
+        {
+            if (poFieldDefn->GetSubType() == OFSTBoolean && nVal != 0 &&
+                nVal != 1)
+            {
+                SetUnsupported();
+                break;
+            }
+            // Same clamping as json_object_get_int()
+            const int nVal32 = static_cast<int>(std::clamp<GIntBig>(
+                nVal, std::numeric_limits<int>::min(),
+                std::numeric_limits<int>::max()));
+            m_asFields[iField].Integer = nVal32;
+            m_aeFieldState[iField] = FieldState::SET;
+            if (m_abFIDField[iField])
+            {
+                m_bHasFIDFromField = true;
+                m_nFIDFromField = nVal32;
+            }
+            break;
+        }
+
+        case OFTInteger64:
+            m_asFields[iField].Integer64 = nVal;
+            m_aeFieldState[iField] = FieldState::SET;
+            if (m_abFIDField[iField])
+            {
+                m_bHasFIDFromField = true;
+                m_nFIDFromField = nVal;
+            }
+            break;
+
+        case OFTReal:
+            m_asFields[iField].Real = static_cast<double>(nVal);
+            m_aeFieldState[iField] = FieldState::SET;
+            break;
+
+        case OFTString:
+            m_aosStrings[iField].assign(CPLSPrintf(CPL_FRMT_GIB, nVal));
+            m_aeFieldState[iField] = FieldState::SET;
+            break;
+
+        default:
+            SetUnsupported();
+            break;
+    }
+}
+
+/************************************************************************/
+/*                          SetFieldFromReal()                          */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::SetFieldFromReal(int iField, double dfVal)
+{
+    if (m_poFeatureDefn->GetFieldDefnUnsafe(iField)->GetType() == OFTReal)
+    {
+        m_asFields[iField].Real = dfVal;
+        m_aeFieldState[iField] = FieldState::SET;
+    }
+    else
+    {
+        // Conversions of doubles to strings or integers by json-c are not
+        // replicated
+        SetUnsupported();
+    }
+}
+
+/************************************************************************/
+/*                           FinishFeature()                            */
+/************************************************************************/
+
+// Mimics the end of OGRGeoJSONBaseReader::ReadFeature()
+
+void OGRGeoJSONArrowRowBuilder::FinishFeature()
+{
+    m_bFeatureComplete = true;
+    if (!m_bIsFeature)
+        return;
+
+    // Top level members are then used as fields
+    if (!m_bAttributesSkip && !m_bHasProperties && m_bTopLevelMemberIsField)
+    {
+        SetUnsupported();
+        return;
+    }
+
+    if (m_eIdKind != IdKind::NONE)
+    {
+        if (m_bFeatureLevelIdAsFID)
+        {
+            if (m_eIdKind != IdKind::INTEGER)
+            {
+                SetUnsupported();
+                return;
+            }
+            m_nFID = m_nId;
+        }
+        else if (m_iIdField >= 0 &&
+                 m_aeFieldState[m_iIdField] == FieldState::UNSET)
+        {
+            const OGRFieldDefn *poFieldDefn =
+                m_poFeatureDefn->GetFieldDefnUnsafe(m_iIdField);
+            const auto eType = poFieldDefn->GetType();
+            if (eType == OFTString && m_eIdKind == IdKind::STRING)
+            {
+                m_aosStrings[m_iIdField] = m_osId;
+                m_aeFieldState[m_iIdField] = FieldState::SET;
+            }
+            else if (eType == OFTString && m_eIdKind == IdKind::INTEGER)
+            {
+                m_aosStrings[m_iIdField].assign(
+                    CPLSPrintf(CPL_FRMT_GIB, m_nId));
+                m_aeFieldState[m_iIdField] = FieldState::SET;
+            }
+            else if (eType == OFTInteger &&
+                     poFieldDefn->GetSubType() == OFSTNone &&
+                     m_eIdKind == IdKind::INTEGER &&
+                     m_nId >= std::numeric_limits<int>::min() &&
+                     m_nId <= std::numeric_limits<int>::max())
+            {
+                m_asFields[m_iIdField].Integer = static_cast<int>(m_nId);
+                m_aeFieldState[m_iIdField] = FieldState::SET;
+            }
+            else if (eType == OFTInteger64 && m_eIdKind == IdKind::INTEGER)
+            {
+                m_asFields[m_iIdField].Integer64 = m_nId;
+                m_aeFieldState[m_iIdField] = FieldState::SET;
+            }
+            else
+            {
+                SetUnsupported();
+                return;
+            }
+        }
+    }
+
+    if (m_nFID == OGRNullFID && m_bHasFIDFromField)
+        m_nFID = m_nFIDFromField;
+}
+
+/************************************************************************/
+/*                           FinishGeometry()                           */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::FinishGeometry()
+{
+    if (m_eGeomType == wkbUnknown || m_asCoordArrays.empty())
+    {
+        SetUnsupported();
+        return;
+    }
+
+    m_abyWKB.clear();
+    m_abyWKB.reserve(m_adfCoords.size() * sizeof(double) +
+                     m_asCoordArrays.size() * (1 + 2 * sizeof(uint32_t)));
+    size_t iArray = 0;
+    size_t iCoord = 0;
+    if (!WriteGeometry(m_eGeomType, iArray, iCoord))
+    {
+        SetUnsupported();
+        return;
+    }
+    m_bHasGeometry = true;
+}
+
+/************************************************************************/
+/*                             WriteUInt32()                            */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::WriteUInt32(uint32_t nVal)
+{
+    CPL_LSBPTR32(&nVal);
+    const GByte *pabyVal = reinterpret_cast<const GByte *>(&nVal);
+    m_abyWKB.insert(m_abyWKB.end(), pabyVal, pabyVal + sizeof(nVal));
+}
+
+/************************************************************************/
+/*                             WriteHeader()                            */
+/************************************************************************/
+
+void OGRGeoJSONArrowRowBuilder::WriteHeader(OGRwkbGeometryType eType)
+{
+    // Same as exportToWkb(wkbNDR, ..., wkbVariantIso). As in the
+    // OGRGeometry built by OGRGeoJSONReadGeometry(), all parts are 3D as
+    // soon as one position has a Z value.
+    m_abyWKB.push_back(static_cast<GByte>(wkbNDR));
+    WriteUInt32(static_cast<uint32_t>(eType) + (m_bHasZ ? 1000 : 0));
+}
+
+/************************************************************************/
+/*                            WritePosition()                           */
+/************************************************************************/
+
+bool OGRGeoJSONArrowRowBuilder::WritePosition(size_t &iArray, size_t &iCoord)
+{
+    if (iArray >= m_asCoordArrays.size() ||
+        !m_asCoordArrays[iArray].bIsPosition)
+    {
+        return false;
+    }
+    ++iArray;
+
+    const int nDims = m_bHasZ ? 3 : 2;
+    for (int i = 0; i < nDims; ++i)
+    {
+        double dfVal = m_adfCoords[3 * iCoord + i];
+        CPL_LSBPTR64(&dfVal);
+        const GByte *pabyVal = reinterpret_cast<const GByte *>(&dfVal);
+        m_abyWKB.insert(m_abyWKB.end(), pabyVal, pabyVal + sizeof(dfVal));
+    }
+    ++iCoord;
+    return true;
+}
+
+/************************************************************************/
+/*                            WriteGeometry()                           */
+/************************************************************************/
+
+// Consumes the arrays of the coordinates of eType, which are stored in
+// depth-first order in m_asCoordArrays, and checks that their nesting is
+// the one expected for eType.
+
+bool OGRGeoJSONArrowRowBuilder::WriteGeometry(OGRwkbGeometryType eType,
+                                              size_t &iArray, size_t &iCoord)
+{
+    WriteHeader(eType);
+    if (eType == wkbPoint)
+        return WritePosition(iArray, iCoord);
+
+    if (iArray >= m_asCoordArrays.size() ||
+        m_asCoordArrays[iArray].bIsPosition)
+    {
+        return false;
+    }
+    const int nCount = m_asCoordArrays[iArray].nCount;
+    ++iArray;
+    WriteUInt32(static_cast<uint32_t>(nCount));
+
+    for (int i = 0; i < nCount; ++i)
+    {
+        bool bOK = false;
+        switch (eType)
+        {
+            case wkbLineString:
+                bOK = WritePosition(iArray, iCoord);
+                break;
+
+            case wkbPolygon:
+            {
+                // Linear ring
+                if (iArray >= m_asCoordArrays.size() ||
+                    m_asCoordArrays[iArray].bIsPosition)
+                {
+                    return false;
+                }
+                const int nPoints = m_asCoordArrays[iArray].nCount;
+                ++iArray;
+                WriteUInt32(static_cast<uint32_t>(nPoints));
+                bOK = true;
+                for (int j = 0; bOK && j < nPoints; ++j)
+                    bOK = WritePosition(iArray, iCoord);
+                break;
+            }
+
+            case wkbMultiPoint:
+                bOK = WriteGeometry(wkbPoint, iArray, iCoord);
+                break;
+
+            case wkbMultiLineString:
+                bOK = WriteGeometry(wkbLineString, iArray, iCoord);
+                break;
+
+            case wkbMultiPolygon:
+                bOK = WriteGeometry(wkbPolygon, iArray, iCoord);
+                break;
+
+            default:
+                break;
+        }
+        if (!bOK)
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                           SetFromFeature()                           */
+/************************************************************************/
+
+// Stages the content of a feature read through the regular code path.
+
+void OGRGeoJSONArrowRowBuilder::SetFromFeature(const OGRFeature &oFeature)
+{
+    StartFeature();
+    m_bIsFeature = true;
+    m_nFID = oFeature.GetFID();
+    for (int i = 0; i < m_nFieldCount; ++i)
+    {
+        const OGRField *psField = oFeature.GetRawFieldRef(i);
+        if (OGR_RawField_IsUnset(psField))
+        {
+            continue;
+        }
+        if (OGR_RawField_IsNull(psField))
+        {
+            m_aeFieldState[i] = FieldState::NULL_VALUE;
+            continue;
+        }
+        if (m_poFeatureDefn->GetFieldDefnUnsafe(i)->GetType() == OFTString)
+            m_aosStrings[i].assign(psField->String);
+        else
+            m_asFields[i] = *psField;
+        m_aeFieldState[i] = FieldState::SET;
+    }
+
+    const OGRGeometry *poGeom = oFeature.GetGeometryRef();
+    if (poGeom && !m_bSkipGeometry)
+    {
+        m_abyWKB.resize(poGeom->WkbSize());
+        poGeom->exportToWkb(wkbNDR, m_abyWKB.data(), wkbVariantIso);
+        m_bHasGeometry = true;
+    }
+}
+
+/************************************************************************/
+/*                            FitsInBatch()                             */
+/************************************************************************/
+
+// Checks that the staged row does not make the string or binary buffers
+// of the current array exceed the memory limit.
+
+bool OGRGeoJSONArrowRowBuilder::FitsInBatch(const OGRArrowArrayHelper &oHelper,
+                                            int iFeat) const
+{
+    if (iFeat == 0)
+        return true;
+
+    const auto Fits = [&oHelper, iFeat, this](int iArrowField, size_t nLen)
+    {
+        const auto psArray = oHelper.m_out_array->children[iArrowField];
+        const uint32_t nCurLength = static_cast<uint32_t>(
+            static_cast<const int32_t *>(psArray->buffers[1])[iFeat]);
+        return nLen > m_nMemLimit || nLen <= m_nMemLimit - nCurLength;
+    };
+
+    for (int iField = 0; iField < m_nFieldCount; ++iField)
+    {
+        const int iArrowField = oHelper.m_mapOGRFieldToArrowField[iField];
+        if (iArrowField >= 0 && m_aeFieldState[iField] == FieldState::SET &&
+            m_poFeatureDefn->GetFieldDefnUnsafe(iField)->GetType() ==
+                OFTString &&
+            !Fits(iArrowField, m_aosStrings[iField].size()))
+        {
+            return false;
+        }
+    }
+
+    if (m_bHasGeometry && oHelper.m_nGeomFieldCount > 0)
+    {
+        const int iArrowField = oHelper.m_mapOGRGeomFieldToArrowField[0];
+        if (iArrowField >= 0 && !Fits(iArrowField, m_abyWKB.size()))
+            return false;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                             AppendRow()                              */
+/************************************************************************/
+
+bool OGRGeoJSONArrowRowBuilder::AppendRow(OGRArrowArrayHelper &oHelper,
+                                          int iFeat, GIntBig nFID)
+{
+    if (oHelper.m_panFIDValues)
+        oHelper.m_panFIDValues[iFeat] = nFID;
+
+    for (int iField = 0; iField < m_nFieldCount; ++iField)
+    {
+        const int iArrowField = oHelper.m_mapOGRFieldToArrowField[iField];
+        if (iArrowField < 0)
+            continue;
+        auto psArray = oHelper.m_out_array->children[iArrowField];
+        if (m_aeFieldState[iField] == FieldState::SET)
+        {
+            const OGRFieldDefn *poFieldDefn =
+                m_poFeatureDefn->GetFieldDefnUnsafe(iField);
+            const OGRField &sField = m_asFields[iField];
+            switch (poFieldDefn->GetType())
+            {
+                case OFTInteger:
+                {
+                    if (poFieldDefn->GetSubType() == OFSTBoolean)
+                    {
+                        if (sField.Integer != 0)
+                            oHelper.SetBoolOn(psArray, iFeat);
+                    }
+                    else
+                    {
+                        oHelper.SetInt32(psArray, iFeat, sField.Integer);
+                    }
+                    break;
+                }
+
+                case OFTInteger64:
+                {
+                    oHelper.SetInt64(psArray, iFeat, sField.Integer64);
+                    break;
+                }
+
+                case OFTReal:
+                {
+                    if (poFieldDefn->GetSubType() == OFSTFloat32)
+                    {
+                        oHelper.SetFloat(psArray, iFeat,
+                                         static_cast<float>(sField.Real));
+                    }
+                    else
+                    {
+                        oHelper.SetDouble(psArray, iFeat, sField.Real);
+                    }
+                    break;
+                }
+
+                case OFTString:
+                {
+                    const std::string &osVal = m_aosStrings[iField];
+                    GByte *pabyOut = oHelper.GetPtrForStringOrBinary(
+                        iArrowField, iFeat, osVal.size());
+                    if (pabyOut == nullptr)
+                        return false;
+                    memcpy(pabyOut, osVal.data(), osVal.size());
+                    break;
+                }
+
+                case OFTDate:
+                {
+                    oHelper.SetDate(psArray, iFeat, m_brokenDown, sField);
+                    break;
+                }
+
+                case OFTTime:
+                {
+                    oHelper.SetInt32(
+                        psArray, iFeat,
+                        sField.Date.Hour * 3600000 +
+                            sField.Date.Minute * 60000 +
+                            static_cast<int>(sField.Date.Second * 1000 + 0.5));
+                    break;
+                }
+
+                case OFTDateTime:
+                {
+                    oHelper.SetDateTime(psArray, iFeat, m_brokenDown,
+                                        oHelper.m_anTZFlags[iField], sField);
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+        else if (oHelper.m_abNullableFields[iField])
+        {
+            if (!oHelper.SetNull(iArrowField, iFeat))
+                return false;
+        }
+        else if (psArray->n_buffers == 3)
+        {
+            oHelper.SetEmptyStringOrBinary(psArray, iFeat);
+        }
+    }
+
+    if (oHelper.m_nGeomFieldCount > 0)
+    {
+        const int iArrowField = oHelper.m_mapOGRGeomFieldToArrowField[0];
+        if (iArrowField >= 0)
+        {
+            // Geometry fields of GeoJSON layers are always nullable
+            if (m_bHasGeometry)
+            {
+                GByte *pabyOut = oHelper.GetPtrForStringOrBinary(
+                    iArrowField, iFeat, m_abyWKB.size());
+                if (pabyOut == nullptr)
+                    return false;
+                memcpy(pabyOut, m_abyWKB.data(), m_abyWKB.size());
+            }
+            else if (!oHelper.SetNull(iArrowField, iFeat))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                    OGRGeoJSONArrowBatchBuilder()                     */
+/************************************************************************/
+
+OGRGeoJSONArrowBatchBuilder::OGRGeoJSONArrowBatchBuilder(
+    GDALDataset *poDS, OGRLayer *poLayer, const CPLStringList &aosOptions)
+    : m_poDS(poDS), m_poLayer(poLayer), m_aosOptions(aosOptions),
+      m_nMaxBatchSize(OGRArrowArrayHelper::GetMaxFeaturesInBatch(aosOptions))
+{
+}
+
+/************************************************************************/
+/*                    ~OGRGeoJSONArrowBatchBuilder()                    */
+/************************************************************************/
+
+OGRGeoJSONArrowBatchBuilder::~OGRGeoJSONArrowBatchBuilder()
+{
+    if (m_sCurArray.release)
+        m_sCurArray.release(&m_sCurArray);
+    for (auto &sArray : m_asPendingArrays)
+    {
+        if (sArray.release)
+            sArray.release(&sArray);
+    }
+}
+
+/************************************************************************/
+/*                             StartArray()                             */
+/************************************************************************/
+
+bool OGRGeoJSONArrowBatchBuilder::StartArray()
+{
+    m_poHelper = std::make_unique<OGRArrowArrayHelper>(
+        m_poDS, m_poLayer->GetLayerDefn(), m_aosOptions, &m_sCurArray);
+    m_nCurRows = 0;
+    if (m_sCurArray.release == nullptr)
+    {
+        m_poHelper.reset();
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             AppendRow()                              */
+/************************************************************************/
+
+bool OGRGeoJSONArrowBatchBuilder::AppendRow(
+    OGRGeoJSONArrowRowBuilder &oRowBuilder, GIntBig nFID)
+{
+    if (!m_poHelper && !StartArray())
+        return false;
+    if (!oRowBuilder.FitsInBatch(*m_poHelper, m_nCurRows))
+    {
+        FinishArray();
+        if (!StartArray())
+            return false;
+    }
+    if (!oRowBuilder.AppendRow(*m_poHelper, m_nCurRows, nFID))
+        return false;
+    ++m_nCurRows;
+    if (m_nCurRows == m_poHelper->m_nMaxBatchSize)
+        FinishArray();
+    return true;
+}
+
+/************************************************************************/
+/*                            FinishArray()                             */
+/************************************************************************/
+
+void OGRGeoJSONArrowBatchBuilder::FinishArray()
+{
+    if (!m_poHelper)
+        return;
+    if (m_nCurRows == 0)
+    {
+        m_poHelper->ClearArray();
+    }
+    else
+    {
+        m_poHelper->Shrink(m_nCurRows);
+        m_asPendingArrays.push_back(m_sCurArray);
+        memset(&m_sCurArray, 0, sizeof(m_sCurArray));
+        m_nRowCount += m_nCurRows;
+    }
+    m_poHelper.reset();
+    m_nCurRows = 0;
+}
+
+/************************************************************************/
+/*                            GetNextArray()                            */
+/************************************************************************/
+
+void OGRGeoJSONArrowBatchBuilder::GetNextArray(struct ArrowArray *out_array)
+{
+    *out_array = m_asPendingArrays.front();
+    m_asPendingArrays.pop_front();
+}
+
+/************************************************************************/
+/*                    OGRGeoJSONReaderArrowParser()                     */
+/************************************************************************/
+
+OGRGeoJSONReaderArrowParser::OGRGeoJSONReaderArrowParser(
+    const OGRGeoJSONBaseReader &oReader, OGRLayer *poLayer,
+    const CPLStringList &aosOptions)
+    : m_oRowBuilder(oReader, poLayer),
+      m_oBatchBuilder(poLayer->GetDataset(), poLayer, aosOptions)
+{
+}
+
+/************************************************************************/
+/*                        Token callbacks                               */
+/************************************************************************/
+
+// Tokens of the members of the "features" array are forwarded to the row
+// builder. Structure detection is the same as in
+// OGRJSONCollectionStreamingParser.
+
+void OGRGeoJSONReaderArrowParser::String(const char *pszValue, size_t nLength)
+{
+    if (m_bInFeature)
+        m_oRowBuilder.String(pszValue, nLength);
+}
+
+void OGRGeoJSONReaderArrowParser::Number(const char *pszValue, size_t nLength)
+{
+    if (m_bInFeature)
+        m_oRowBuilder.Number(pszValue, nLength);
+}
+
+void OGRGeoJSONReaderArrowParser::Boolean(bool bVal)
+{
+    if (m_bInFeature)
+        m_oRowBuilder.Boolean(bVal);
+}
+
+void OGRGeoJSONReaderArrowParser::Null()
+{
+    if (m_bInFeature)
+        m_oRowBuilder.Null();
+}
+
+void OGRGeoJSONReaderArrowParser::StartObject()
+{
+    if (m_bInFeature)
+    {
+        m_oRowBuilder.StartObject();
+    }
+    else if (m_bInFeaturesArray && m_nDepth == 2)
+    {
+        m_bInFeature = true;
+        m_oRowBuilder.StartFeature();
+        m_oRowBuilder.StartObject();
+    }
+    m_nDepth++;
+}
+
+void OGRGeoJSONReaderArrowParser::EndObject()
+{
+    m_nDepth--;
+    if (m_bInFeature)
+    {
+        m_oRowBuilder.EndObject();
+        if (m_nDepth == 2)
+        {
+            m_bInFeature = false;
+            FinishFeature();
+        }
+    }
+    else if (m_nDepth == 1)
+    {
+        m_bInFeatures = false;
+    }
+}
+
+void OGRGeoJSONReaderArrowParser::StartObjectMember(const char *pszKey,
+                                                    size_t nKeyLen)
+{
+    if (m_nDepth == 1)
+        m_bInFeatures = strcmp(pszKey, "features") == 0;
+    else if (m_bInFeature)
+        m_oRowBuilder.StartObjectMember(pszKey, nKeyLen);
+}
+
+void OGRGeoJSONReaderArrowParser::StartArray()
+{
+    if (m_nDepth == 1 && m_bInFeatures)
+        m_bInFeaturesArray = true;
+    else if (m_bInFeature)
+        m_oRowBuilder.StartArray();
+    m_nDepth++;
+}
+
+void OGRGeoJSONReaderArrowParser::EndArray()
+{
+    m_nDepth--;
+    if (m_nDepth == 1 && m_bInFeaturesArray)
+        m_bInFeaturesArray = false;
+    else if (m_bInFeature)
+        m_oRowBuilder.EndArray();
+}
+
+void OGRGeoJSONReaderArrowParser::Exception(const char *pszMessage)
+{
+    CPLError(CE_Failure, CPLE_AppDefined, "%s", pszMessage);
+}
+
+/************************************************************************/
+/*                           Used FIDs                                  */
+/************************************************************************/
+
+bool OGRGeoJSONReaderArrowParser::IsFIDUsed(GIntBig nFID) const
+{
+    if (m_bUsedFIDsAsSet)
+        return cpl::contains(m_oSetUsedFIDs, nFID);
+    if (m_aoUsedFIDRanges.empty() || nFID > m_aoUsedFIDRanges.back().second)
+        return false;
+    auto oIter = std::upper_bound(
+        m_aoUsedFIDRanges.begin(), m_aoUsedFIDRanges.end(), nFID,
+        [](GIntBig nVal, const std::pair<GIntBig, GIntBig> &oRange)
+        { return nVal < oRange.first; });
+    if (oIter == m_aoUsedFIDRanges.begin())
+        return false;
+    --oIter;
+    return nFID <= oIter->second;
+}
+
+void OGRGeoJSONReaderArrowParser::AddUsedFID(GIntBig nFID)
+{
+    ++m_nUsedFIDCount;
+    if (!m_bUsedFIDsAsSet)
+    {
+        if (m_aoUsedFIDRanges.empty())
+        {
+            m_aoUsedFIDRanges.emplace_back(nFID, nFID);
+            return;
+        }
+        if (nFID > m_aoUsedFIDRanges.back().second)
+        {
+            if (nFID == m_aoUsedFIDRanges.back().second + 1)
+                m_aoUsedFIDRanges.back().second = nFID;
+            else
+                m_aoUsedFIDRanges.emplace_back(nFID, nFID);
+            return;
+        }
+        for (const auto &oRange : m_aoUsedFIDRanges)
+        {
+            for (GIntBig nVal = oRange.first; nVal <= oRange.second; ++nVal)
+                m_oSetUsedFIDs.insert(nVal);
+        }
+        m_aoUsedFIDRanges.clear();
+        m_bUsedFIDsAsSet = true;
+    }
+    m_oSetUsedFIDs.insert(nFID);
+}
+
+/************************************************************************/
+/*                           FinishFeature()                            */
+/************************************************************************/
+
+void OGRGeoJSONReaderArrowParser::FinishFeature()
+{
+    if (m_oRowBuilder.IsUnsupported())
+    {
+        StopParsing();
+        return;
+    }
+    if (!m_oRowBuilder.IsFeature())
+        return;
+
+    // Same logic as OGRGeoJSONReaderStreamingParser::GotFeature()
+    GIntBig nFID = m_oRowBuilder.GetFID();
+    if (nFID == OGRNullFID)
+    {
+        nFID = m_nUsedFIDCount;
+        while (IsFIDUsed(nFID))
+            ++nFID;
+    }
+    else if (IsFIDUsed(nFID))
+    {
+        if (!m_bOriginalIdModifiedEmitted)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Several features with id = " CPL_FRMT_GIB " have "
+                     "been found. Altering it to be unique. "
+                     "This warning will not be emitted anymore for "
+                     "this layer",
+                     nFID);
+            m_bOriginalIdModifiedEmitted = true;
+        }
+        nFID = m_nUsedFIDCount;
+        while (IsFIDUsed(nFID))
+            ++nFID;
+    }
+    AddUsedFID(nFID);
+
+    if (!m_oBatchBuilder.AppendRow(m_oRowBuilder, nFID))
+    {
+        m_bFailed = true;
+        StopParsing();
+    }
+}
+
+/************************************************************************/
+/*                    OGRGeoJSONRecordArrowParser()                     */
+/************************************************************************/
+
+OGRGeoJSONRecordArrowParser::OGRGeoJSONRecordArrowParser(
+    const OGRGeoJSONBaseReader &oReader, OGRLayer *poLayer)
+    : m_oRowBuilder(oReader, poLayer)
+{
+}
+
+/************************************************************************/
+/*                            ParseRecord()                             */
+/************************************************************************/
+
+bool OGRGeoJSONRecordArrowParser::ParseRecord(const char *pszText,
+                                              size_t nLength)
+{
+    Reset();
+    m_oRowBuilder.StartFeature();
+    return Parse(pszText, nLength, true) && !ExceptionOccurred() &&
+           m_oRowBuilder.IsFeatureComplete() &&
+           !m_oRowBuilder.IsUnsupported() && m_oRowBuilder.IsFeature();
+}
+
+/************************************************************************/
+/*                        Token callbacks                               */
+/************************************************************************/
+
+void OGRGeoJSONRecordArrowParser::String(const char *pszValue, size_t nLength)
+{
+    m_oRowBuilder.String(pszValue, nLength);
+}
+
+void OGRGeoJSONRecordArrowParser::Number(const char *pszValue, size_t nLength)
+{
+    m_oRowBuilder.Number(pszValue, nLength);
+}
+
+void OGRGeoJSONRecordArrowParser::Boolean(bool bVal)
+{
+    m_oRowBuilder.Boolean(bVal);
+}
+
+void OGRGeoJSONRecordArrowParser::Null()
+{
+    m_oRowBuilder.Null();
+}
+
+void OGRGeoJSONRecordArrowParser::StartObject()
+{
+    m_oRowBuilder.StartObject();
+}
+
+void OGRGeoJSONRecordArrowParser::EndObject()
+{
+    m_oRowBuilder.EndObject();
+}
+
+void OGRGeoJSONRecordArrowParser::StartObjectMember(const char *pszKey,
+                                                    size_t nKeyLen)
+{
+    m_oRowBuilder.StartObjectMember(pszKey, nKeyLen);
+}
+
+void OGRGeoJSONRecordArrowParser::StartArray()
+{
+    m_oRowBuilder.StartArray();
+}
+
+void OGRGeoJSONRecordArrowParser::EndArray()
+{
+    m_oRowBuilder.EndArray();
+}
+
+void OGRGeoJSONRecordArrowParser::Exception(const char * /* pszMessage */)
+{
+    // Invalid records are reported by OGRJSonParse() in the regular code
+    // path
+}
+
+//! @endcond
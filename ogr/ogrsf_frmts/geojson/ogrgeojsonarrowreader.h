@@ -0,0 +1,369 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Direct translation of GeoJSON features to Arrow arrays
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef OGRGEOJSONARROWREADER_H_INCLUDED
+#define OGRGEOJSONARROWREADER_H_INCLUDED
+
+#include "cpl_json_streaming_parser.h"
+#include "cpl_string.h"
+#include "ogr_feature.h"
+#include "ograrrowarrayhelper.h"
+
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+//! @cond Doxygen_Suppress
+
+class OGRGeoJSONBaseReader;
+
+/************************************************************************/
+/*                       OGRGeoJSONArrowRowBuilder                      */
+/************************************************************************/
+
+/** Translates the JSON tokens of a GeoJSON Feature object into a row of an
+ * Arrow array, without instantiating json_object or OGRFeature objects.
+ *
+ * Only the constructs for which the result is known to be identical to the
+ * one of OGRGeoJSONBaseReader::ReadFeature() are handled. When something else
+ * is met, IsUnsupported() becomes true, remaining tokens of the feature are
+ * ignored, and the caller must go through the regular code path.
+ */
+class OGRGeoJSONArrowRowBuilder
+{
+  public:
+    OGRGeoJSONArrowRowBuilder(const OGRGeoJSONBaseReader &oReader,
+                              OGRLayer *poLayer);
+
+    static bool IsCompatible(const OGRGeoJSONBaseReader &oReader,
+                             OGRLayer *poLayer,
+                             const CPLStringList &aosArrowArrayStreamOptions);
+
+    // Must be called before forwarding the StartObject() token of a feature.
+    void StartFeature();
+
+    void StartObject();
+    void EndObject();
+    void StartObjectMember(const char *pszKey, size_t nKeyLen);
+    void StartArray();
+    void EndArray();
+    void String(const char *pszValue, size_t nLength);
+    void Number(const char *pszValue, size_t nLength);
+    void Boolean(bool bVal);
+    void Null();
+
+    bool IsFeatureComplete() const
+    {
+        return m_bFeatureComplete;
+    }
+
+    bool IsUnsupported() const
+    {
+        return m_bUnsupported;
+    }
+
+    // Whether the object has a "type": "Feature" member
+    bool IsFeature() const
+    {
+        return m_bIsFeature;
+    }
+
+    // FID set by the feature, or OGRNullFID
+    GIntBig GetFID() const
+    {
+        return m_nFID;
+    }
+
+    void SetFromFeature(const OGRFeature &oFeature);
+
+    bool FitsInBatch(const OGRArrowArrayHelper &oHelper, int iFeat) const;
+    bool AppendRow(OGRArrowArrayHelper &oHelper, int iFeat, GIntBig nFID);
+
+  private:
+    enum class Target
+    {
+        NONE,
+        SKIP,
+        TYPE,
+        ID,
+        PROPERTIES,
+        GEOMETRY,
+        FIELD,
+        GEOMETRY_TYPE,
+        COORDINATES,
+    };
+
+    enum class FieldState : char
+    {
+        UNSET,
+        NULL_VALUE,
+        SET,
+    };
+
+    enum class IdKind
+    {
+        NONE,
+        STRING,
+        INTEGER,
+        OTHER,
+    };
+
+    // Array of the "coordinates" member, in depth-first order
+    struct CoordArray
+    {
+        int nCount = 0;
+        bool bIsPosition = false;
+    };
+
+    const OGRFeatureDefn *const m_poFeatureDefn;
+    const int m_nFieldCount;
+    const bool m_bAttributesSkip;
+    const bool m_bFeatureLevelIdAsFID;
+    const uint32_t m_nMemLimit;
+    bool m_bSkipGeometry = false;
+    int m_iIdField = -1;
+    std::vector<bool> m_abSkipField{};
+    std::vector<bool> m_abFIDField{};
+    std::map<std::string, int, std::less<>> m_oMapFieldNameToIdx{};
+    int m_iNextFieldGuess = 0;
+
+    // Parsing state
+    int m_nDepth = 0;
+    int m_nSkipDepth = 0;
+    Target m_eTarget = Target::NONE;
+    int m_iCurField = -1;
+    bool m_bInProperties = false;
+    bool m_bInGeometry = false;
+    bool m_bFeatureComplete = false;
+    bool m_bUnsupported = false;
+    bool m_bTypeSeen = false;
+    bool m_bIdSeen = false;
+    bool m_bPropertiesSeen = false;
+    bool m_bGeometrySeen = false;
+    bool m_bGeomTypeSeen = false;
+    bool m_bCoordinatesSeen = false;
+    bool m_bHasProperties = false;
+    bool m_bTopLevelMemberIsField = false;
+    IdKind m_eIdKind = IdKind::NONE;
+    std::string m_osId{};
+    GIntBig m_nId = 0;
+    OGRwkbGeometryType m_eGeomType = wkbUnknown;
+    std::vector<CoordArray> m_asCoordArrays{};
+    std::vector<size_t> m_anCoordArrayStack{};
+    double m_adfPos[3] = {0, 0, 0};
+    std::vector<double> m_adfCoords{};
+    bool m_bHasZ = false;
+
+    // Staged row
+    bool m_bIsFeature = false;
+    GIntBig m_nFID = OGRNullFID;
+    bool m_bHasFIDFromField = false;
+    GIntBig m_nFIDFromField = 0;
+    std::vector<OGRField> m_asFields{};
+    std::vector<FieldState> m_aeFieldState{};
+    std::vector<std::string> m_aosStrings{};
+    bool m_bHasGeometry = false;
+    std::vector<GByte> m_abyWKB{};
+    struct tm m_brokenDown{};
+
+    int GetFieldIndex(const char *pszKey);
+    void SetUnsupported();
+    void SetFieldFromString(int iField, const char *pszValue);
+    void SetFieldFromInteger(int iField, GIntBig nVal);
+    void SetFieldFromReal(int iField, double dfVal);
+    void FinishFeature();
+    void FinishGeometry();
+    bool WriteGeometry(OGRwkbGeometryType eType, size_t &iArray,
+                       size_t &iCoord);
+    bool WritePosition(size_t &iArray, size_t &iCoord);
+    void WriteUInt32(uint32_t nVal);
+    void WriteHeader(OGRwkbGeometryType eType);
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONArrowRowBuilder)
+};
+
+/************************************************************************/
+/*                     OGRGeoJSONArrowBatchBuilder                      */
+/************************************************************************/
+
+/** Accumulates rows staged by a OGRGeoJSONArrowRowBuilder into Arrow
+ * arrays of at most MAX_FEATURES_IN_BATCH rows. */
+class OGRGeoJSONArrowBatchBuilder
+{
+  public:
+    OGRGeoJSONArrowBatchBuilder(GDALDataset *poDS, OGRLayer *poLayer,
+                                const CPLStringList &aosOptions);
+    ~OGRGeoJSONArrowBatchBuilder();
+
+    bool AppendRow(OGRGeoJSONArrowRowBuilder &oRowBuilder, GIntBig nFID);
+    void FinishArray();
+
+    bool HasPendingArray() const
+    {
+        return !m_asPendingArrays.empty();
+    }
+
+    void GetNextArray(struct ArrowArray *out_array);
+
+    // Number of rows in finished arrays
+    GIntBig GetRowCount() const
+    {
+        return m_nRowCount;
+    }
+
+  private:
+    GDALDataset *const m_poDS;
+    OGRLayer *const m_poLayer;
+    const CPLStringList m_aosOptions;
+    const int m_nMaxBatchSize;
+    std::unique_ptr<OGRArrowArrayHelper> m_poHelper{};
+    struct ArrowArray m_sCurArray{};
+    int m_nCurRows = 0;
+    GIntBig m_nRowCount = 0;
+    std::deque<struct ArrowArray> m_asPendingArrays{};
+
+    bool StartArray();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONArrowBatchBuilder)
+};
+
+/************************************************************************/
+/*                     OGRGeoJSONReaderArrowParser                      */
+/************************************************************************/
+
+/** Streaming parser of a FeatureCollection, used by
+ * OGRGeoJSONReader::GetNextArrowArray(). */
+class OGRGeoJSONReaderArrowParser final : public CPLJSonStreamingParser
+{
+  public:
+    OGRGeoJSONReaderArrowParser(const OGRGeoJSONBaseReader &oReader,
+                                OGRLayer *poLayer,
+                                const CPLStringList &aosOptions);
+
+    void String(const char *pszValue, size_t nLength) override;
+    void Number(const char *pszValue, size_t nLength) override;
+    void Boolean(bool bVal) override;
+    void Null() override;
+    void StartObject() override;
+    void EndObject() override;
+    void StartObjectMember(const char *pszKey, size_t nKeyLen) override;
+    void StartArray() override;
+    void EndArray() override;
+    void Exception(const char *pszMessage) override;
+
+    OGRGeoJSONArrowBatchBuilder &GetBatchBuilder()
+    {
+        return m_oBatchBuilder;
+    }
+
+    bool IsUnsupported() const
+    {
+        return m_oRowBuilder.IsUnsupported();
+    }
+
+    bool HasFailed() const
+    {
+        return m_bFailed;
+    }
+
+    bool IsFinished() const
+    {
+        return m_bFinished;
+    }
+
+    void SetFinished()
+    {
+        m_bFinished = true;
+    }
+
+    bool GetOriginalIdModifiedEmitted() const
+    {
+        return m_bOriginalIdModifiedEmitted;
+    }
+
+    void SetOriginalIdModifiedEmitted(bool b)
+    {
+        m_bOriginalIdModifiedEmitted = b;
+    }
+
+  private:
+    OGRGeoJSONArrowRowBuilder m_oRowBuilder;
+    OGRGeoJSONArrowBatchBuilder m_oBatchBuilder;
+    int m_nDepth = 0;
+    bool m_bInFeatures = false;
+    bool m_bInFeaturesArray = false;
+    bool m_bInFeature = false;
+    bool m_bFailed = false;
+    bool m_bFinished = false;
+    bool m_bOriginalIdModifiedEmitted = false;
+
+    // FIDs already used. Stored as sorted ranges while they are assigned
+    // in increasing order, which is the common case, and in a set otherwise.
+    std::vector<std::pair<GIntBig, GIntBig>> m_aoUsedFIDRanges{};
+    std::set<GIntBig> m_oSetUsedFIDs{};
+    bool m_bUsedFIDsAsSet = false;
+    GIntBig m_nUsedFIDCount = 0;
+
+    bool IsFIDUsed(GIntBig nFID) const;
+    void AddUsedFID(GIntBig nFID);
+    void FinishFeature();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONReaderArrowParser)
+};
+
+/************************************************************************/
+/*                     OGRGeoJSONRecordArrowParser                      */
+/************************************************************************/
+
+/** Parser of a single JSON object, such as a record of a GeoJSONSeq file,
+ * whose tokens are forwarded to a OGRGeoJSONArrowRowBuilder. */
+class OGRGeoJSONRecordArrowParser final : public CPLJSonStreamingParser
+{
+  public:
+    OGRGeoJSONRecordArrowParser(const OGRGeoJSONBaseReader &oReader,
+                                OGRLayer *poLayer);
+
+    // Returns true if the record is a Feature that has been staged by the
+    // row builder. Otherwise, the caller must use the regular code path and
+    // stage the row with OGRGeoJSONArrowRowBuilder::SetFromFeature().
+    bool ParseRecord(const char *pszText, size_t nLength);
+
+    OGRGeoJSONArrowRowBuilder &GetRowBuilder()
+    {
+        return m_oRowBuilder;
+    }
+
+    void String(const char *pszValue, size_t nLength) override;
+    void Number(const char *pszValue, size_t nLength) override;
+    void Boolean(bool bVal) override;
+    void Null() override;
+    void StartObject() override;
+    void EndObject() override;
+    void StartObjectMember(const char *pszKey, size_t nKeyLen) override;
+    void StartArray() override;
+    void EndArray() override;
+    void Exception(const char *pszMessage) override;
+
+  private:
+    OGRGeoJSONArrowRowBuilder m_oRowBuilder;
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONRecordArrowParser)
+};
+
+//! @endcond
+
+#endif  // OGRGEOJSONARROWREADER_H_INCLUDED
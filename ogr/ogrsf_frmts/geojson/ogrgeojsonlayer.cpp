@@ -32,6 +32,7 @@
 
 #include "ogr_geojson.h"
 #include "ogrgeojsonreader.h"
+#include "ogrgeojsonarrowreader.h"
 
 /************************************************************************/
 /*                       STATIC MEMBERS DEFINITION                      */
@@ -114,6 +115,7 @@ void OGRGeoJSONLayer::SetFIDColumn(const char *pszFIDColumn)
 void OGRGeoJSONLayer::ResetReading()
 {
     nFeatureReadSinceReset_ = 0;
+    m_bArrowArrayFallback = false;
     if (poReader_)
     {
         TerminateAppendSession();
@@ -163,6 +165,44 @@ OGRFeature *OGRGeoJSONLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                   CanUseNativeGetNextArrowArray()                    */
+/************************************************************************/
+
+bool OGRGeoJSONLayer::CanUseNativeGetNextArrowArray()
+{
+    return poReader_ != nullptr && !bHasAppendedFeatures_ &&
+           m_poFilterGeom == nullptr && m_poAttrQuery == nullptr &&
+           !CPLTestBool(
+               CPLGetConfigOption("OGR_GEOJSON_STREAM_BASE_IMPL", "NO")) &&
+           OGRGeoJSONArrowRowBuilder::IsCompatible(
+               *poReader_, this, m_aosArrowArrayStreamOptions);
+}
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/************************************************************************/
+
+// Features of the common subset of GeoJSON are directly translated from
+// JSON tokens to Arrow arrays. As soon as a feature outside of that subset
+// is met, the rest of the layer goes through the generic implementation.
+int OGRGeoJSONLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                       struct ArrowArray *out_array)
+{
+    if (m_bArrowArrayFallback || !CanUseNativeGetNextArrowArray())
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    bool bFallback = false;
+    const int nRet = poReader_->GetNextArrowArray(
+        this, m_aosArrowArrayStreamOptions, out_array, bFallback);
+    if (bFallback)
+    {
+        m_bArrowArrayFallback = true;
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+    return nRet;
+}
+
 /************************************************************************/
 /*                          GetFeatureCount()                           */
 /************************************************************************/
@@ -513,6 +553,8 @@ int OGRGeoJSONLayer::TestCapability(const char *pszCap)
     else if (EQUAL(pszCap, OLCFastGetExtent) ||
              EQUAL(pszCap, OLCFastGetExtent3D))
         return m_poFilterGeom == nullptr && m_poAttrQuery == nullptr;
+    else if (EQUAL(pszCap, OLCFastGetArrowStream))
+        return CanUseNativeGetNextArrowArray();
     return OGRMemLayer::TestCapability(pszCap);
 }
 
@@ -17,6 +17,7 @@
 #include "ogr_geojson.h"
 #include "ogrlibjsonutils.h"
 #include "ogrjsoncollectionstreamingparser.h"
+#include "ogrgeojsonarrowreader.h"
 #include "ogr_api.h"
 
 #include <cmath>
@@ -659,6 +660,10 @@ void OGRGeoJSONReader::ResetReading()
             poStreamingParser_->GetOriginalIdModifiedEmitted();
     delete poStreamingParser_;
     poStreamingParser_ = nullptr;
+    if (poArrowParser_)
+        bOriginalIdModifiedEmitted_ =
+            poArrowParser_->GetOriginalIdModifiedEmitted();
+    poArrowParser_.reset();
 }
 
 /************************************************************************/
@@ -670,6 +675,12 @@ OGRFeature *OGRGeoJSONReader::GetNextFeature(OGRGeoJSONLayer *poLayer)
     CPLAssert(fp_);
     if (poStreamingParser_ == nullptr)
     {
+        if (poArrowParser_)
+        {
+            bOriginalIdModifiedEmitted_ =
+                poArrowParser_->GetOriginalIdModifiedEmitted();
+            poArrowParser_.reset();
+        }
         poStreamingParser_ = new OGRGeoJSONReaderStreamingParser(
             *this, poLayer, false, bStoreNativeData_);
         poStreamingParser_->SetOriginalIdModifiedEmitted(
@@ -714,6 +725,101 @@ OGRFeature *OGRGeoJSONReader::GetNextFeature(OGRGeoJSONLayer *poLayer)
     return nullptr;
 }
 
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/************************************************************************/
+
+// Directly builds Arrow arrays from the JSON tokens of the features. If a
+// feature that cannot be handled that way is met, bFallback is set, and the
+// reading is rewinded just after the last feature that has been returned,
+// so that the caller can continue with OGRLayer::GetNextArrowArray().
+
+int OGRGeoJSONReader::GetNextArrowArray(OGRGeoJSONLayer *poLayer,
+                                        const CPLStringList &aosOptions,
+                                        struct ArrowArray *out_array,
+                                        bool &bFallback)
+{
+    CPLAssert(fp_);
+    bFallback = false;
+    memset(out_array, 0, sizeof(*out_array));
+
+    if (poArrowParser_ == nullptr)
+    {
+        if (poStreamingParser_)
+        {
+            bOriginalIdModifiedEmitted_ =
+                poStreamingParser_->GetOriginalIdModifiedEmitted();
+            delete poStreamingParser_;
+            poStreamingParser_ = nullptr;
+        }
+        poArrowParser_ = std::make_unique<OGRGeoJSONReaderArrowParser>(
+            *this, poLayer, aosOptions);
+        poArrowParser_->SetOriginalIdModifiedEmitted(
+            bOriginalIdModifiedEmitted_);
+        VSIFSeekL(fp_, 0, SEEK_SET);
+        bFirstSeg_ = true;
+        bJSonPLikeWrapper_ = false;
+    }
+
+    auto &oBatchBuilder = poArrowParser_->GetBatchBuilder();
+    while (!oBatchBuilder.HasPendingArray() && !poArrowParser_->IsFinished())
+    {
+        size_t nRead = VSIFReadL(pabyBuffer_, 1, nBufferSize_, fp_);
+        const bool bFinished = nRead < nBufferSize_;
+        size_t nSkip = 0;
+        if (bFirstSeg_)
+        {
+            bFirstSeg_ = false;
+            nSkip = SkipPrologEpilogAndUpdateJSonPLikeWrapper(nRead);
+        }
+        if (bFinished && bJSonPLikeWrapper_ && nRead > nSkip)
+            nRead--;
+        if (!poArrowParser_->Parse(
+                reinterpret_cast<const char *>(pabyBuffer_ + nSkip),
+                nRead - nSkip, bFinished) ||
+            poArrowParser_->ExceptionOccurred() || bFinished)
+        {
+            poArrowParser_->SetFinished();
+            if (!poArrowParser_->IsUnsupported())
+                oBatchBuilder.FinishArray();
+        }
+    }
+
+    if (poArrowParser_->HasFailed())
+        return ENOMEM;
+
+    if (oBatchBuilder.HasPendingArray())
+    {
+        oBatchBuilder.GetNextArray(out_array);
+        return 0;
+    }
+
+    if (poArrowParser_->IsUnsupported())
+    {
+        // Rows of the current, unfinished, array are discarded, and read
+        // again through GetNextFeature()
+        const GIntBig nSkip = oBatchBuilder.GetRowCount();
+        CPLDebug("GeoJSON",
+                 "Using GetNextFeature() from feature " CPL_FRMT_GIB
+                 " for GetNextArrowArray()",
+                 nSkip);
+        ResetReading();
+        {
+            CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+            for (GIntBig i = 0; i < nSkip; ++i)
+            {
+                auto poFeature =
+                    std::unique_ptr<OGRFeature>(GetNextFeature(poLayer));
+                if (!poFeature)
+                    break;
+            }
+        }
+        bFallback = true;
+    }
+
+    return 0;
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
@@ -732,6 +838,10 @@ OGRFeature *OGRGeoJSONReader::GetFeature(OGRGeoJSONLayer *poLayer, GIntBig nFID)
                 poStreamingParser_->GetOriginalIdModifiedEmitted();
         delete poStreamingParser_;
         poStreamingParser_ = nullptr;
+        if (poArrowParser_)
+            bOriginalIdModifiedEmitted_ =
+                poArrowParser_->GetOriginalIdModifiedEmitted();
+        poArrowParser_.reset();
 
         OGRGeoJSONReaderStreamingParser oParser(*this, poLayer, false,
                                                 bStoreNativeData_);
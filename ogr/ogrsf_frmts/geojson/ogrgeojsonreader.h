@@ -23,6 +23,7 @@
 
 #include <utility>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -102,6 +103,8 @@ class OGRGeoJSONBaseReader
         ForeignMemberProcessing::AUTO;
 
   private:
+    friend class OGRGeoJSONArrowRowBuilder;
+
     std::set<int> aoSetUndeterminedTypeFields_;
 
     // bFlatten... is a tri-state boolean with -1 being unset.
@@ -130,6 +133,7 @@ class OGRGeoJSONBaseReader
 
 class OGRGeoJSONDataSource;
 class OGRGeoJSONReaderStreamingParser;
+class OGRGeoJSONReaderArrowParser;
 
 class OGRGeoJSONReader : public OGRGeoJSONBaseReader
 {
@@ -154,6 +158,10 @@ class OGRGeoJSONReader : public OGRGeoJSONBaseReader
     OGRFeature *GetFeature(OGRGeoJSONLayer *poLayer, GIntBig nFID);
     bool IngestAll(OGRGeoJSONLayer *poLayer);
 
+    int GetNextArrowArray(OGRGeoJSONLayer *poLayer,
+                          const CPLStringList &aosOptions,
+                          struct ArrowArray *out_array, bool &bFallback);
+
     VSILFILE *GetFP()
     {
         return fp_;
@@ -174,6 +182,7 @@ class OGRGeoJSONReader : public OGRGeoJSONBaseReader
 
     json_object *poGJObject_;
     OGRGeoJSONReaderStreamingParser *poStreamingParser_;
+    std::unique_ptr<OGRGeoJSONReaderArrowParser> poArrowParser_{};
     bool bFirstSeg_;
     bool bJSonPLikeWrapper_;
     VSILFILE *fp_;
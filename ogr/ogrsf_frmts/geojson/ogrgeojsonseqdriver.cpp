@@ -20,6 +20,7 @@
 #include "ogrgeojsonreader.h"
 #include "ogrgeojsonwriter.h"
 #include "ogrgeojsongeometry.h"
+#include "ogrgeojsonarrowreader.h"
 
 #include <algorithm>
 #include <memory>
@@ -90,7 +91,14 @@ class OGRGeoJSONSeqLayer final : public OGRLayer
     OGRGeometryFactory::TransformWithOptionsCache m_oTransformCache;
     OGRGeoJSONWriteOptions m_oWriteOptions;
 
+    // Native implementation of GetNextArrowArray()
+    std::unique_ptr<OGRGeoJSONRecordArrowParser> m_poArrowParser{};
+    std::unique_ptr<OGRGeoJSONArrowBatchBuilder> m_poArrowBatchBuilder{};
+
+    bool ReadNextRecord();
     json_object *GetNextObject(bool bLooseIdentification);
+    OGRFeature *TranslateObject(json_object *poObject);
+    bool CanUseNativeGetNextArrowArray();
 
   public:
     OGRGeoJSONSeqLayer(OGRGeoJSONSeqDataSource *poDS, const char *pszName);
@@ -120,6 +128,8 @@ class OGRGeoJSONSeqLayer final : public OGRLayer
 
     GIntBig GetFeatureCount(int) override;
     int TestCapability(const char *) override;
+    int GetNextArrowArray(struct ArrowArrayStream *,
+                          struct ArrowArray *out_array) override;
     OGRErr ICreateFeature(OGRFeature *poFeature) override;
     OGRErr CreateField(const OGRFieldDefn *, int) override;
 
@@ -480,13 +490,16 @@ void OGRGeoJSONSeqLayer::ResetReading()
     m_nPosInBuffer = nBufferSizeValidated;
     m_nBufferValidSize = nBufferSizeValidated;
     m_nNextFID = 0;
+    m_poArrowParser.reset();
+    m_poArrowBatchBuilder.reset();
 }
 
 /************************************************************************/
-/*                           GetNextObject()                            */
+/*                           ReadNextRecord()                           */
 /************************************************************************/
 
-json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
+// Sets m_osFeatureBuffer to the text of the next non-empty record.
+bool OGRGeoJSONSeqLayer::ReadNextRecord()
 {
     m_osFeatureBuffer.clear();
     while (true)
@@ -496,7 +509,7 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
         {
             if (m_nBufferValidSize < m_osBuffer.size())
             {
-                return nullptr;
+                return false;
             }
             m_nBufferValidSize =
                 VSIFReadL(&m_osBuffer[0], 1, m_osBuffer.size(), m_poDS->m_fp);
@@ -520,7 +533,7 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
             }
             if (m_nPosInBuffer >= m_nBufferValidSize)
             {
-                return nullptr;
+                return false;
             }
         }
 
@@ -548,7 +561,7 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
                          "for larger features, or 0 to remove any size limit.",
                          static_cast<unsigned>(m_osFeatureBuffer.size() / 1024 /
                                                1024));
-                return nullptr;
+                return false;
             }
             m_nPosInBuffer = m_nBufferValidSize;
             if (m_nBufferValidSize == m_osBuffer.size())
@@ -565,21 +578,69 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
         }
         if (!m_osFeatureBuffer.empty())
         {
-            json_object *poObject = nullptr;
-            CPL_IGNORE_RET_VAL(
-                OGRJSonParse(m_osFeatureBuffer.c_str(), &poObject));
-            m_osFeatureBuffer.clear();
-            if (json_object_get_type(poObject) == json_type_object)
-            {
-                return poObject;
-            }
-            json_object_put(poObject);
-            if (bLooseIdentification)
-            {
-                return nullptr;
-            }
+            return true;
+        }
+    }
+}
+
+/************************************************************************/
+/*                           GetNextObject()                            */
+/************************************************************************/
+
+json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
+{
+    while (ReadNextRecord())
+    {
+        json_object *poObject = nullptr;
+        CPL_IGNORE_RET_VAL(OGRJSonParse(m_osFeatureBuffer.c_str(), &poObject));
+        m_osFeatureBuffer.clear();
+        if (json_object_get_type(poObject) == json_type_object)
+        {
+            return poObject;
+        }
+        json_object_put(poObject);
+        if (bLooseIdentification)
+        {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                          TranslateObject()                           */
+/************************************************************************/
+
+// Returns nullptr if the object must be skipped. Takes ownership of
+// poObject.
+OGRFeature *OGRGeoJSONSeqLayer::TranslateObject(json_object *poObject)
+{
+    OGRFeature *poFeature;
+    auto type = OGRGeoJSONGetType(poObject);
+    if (type == GeoJSONObject::eFeature)
+    {
+        poFeature =
+            m_oReader.ReadFeature(this, poObject, m_osFeatureBuffer.c_str());
+        json_object_put(poObject);
+    }
+    else if (type == GeoJSONObject::eFeatureCollection ||
+             type == GeoJSONObject::eUnknown)
+    {
+        json_object_put(poObject);
+        return nullptr;
+    }
+    else
+    {
+        OGRGeometry *poGeom = m_oReader.ReadGeometry(poObject, GetSpatialRef());
+        json_object_put(poObject);
+        if (!poGeom)
+        {
+            return nullptr;
         }
+        poFeature = new OGRFeature(m_poFeatureDefn);
+        poFeature->SetGeometryDirectly(poGeom);
     }
+    return poFeature;
 }
 
 /************************************************************************/
@@ -605,32 +666,9 @@ OGRFeature *OGRGeoJSONSeqLayer::GetNextFeature()
         auto poObject = GetNextObject(false);
         if (!poObject)
             return nullptr;
-        OGRFeature *poFeature;
-        auto type = OGRGeoJSONGetType(poObject);
-        if (type == GeoJSONObject::eFeature)
-        {
-            poFeature = m_oReader.ReadFeature(this, poObject,
-                                              m_osFeatureBuffer.c_str());
-            json_object_put(poObject);
-        }
-        else if (type == GeoJSONObject::eFeatureCollection ||
-                 type == GeoJSONObject::eUnknown)
-        {
-            json_object_put(poObject);
+        OGRFeature *poFeature = TranslateObject(poObject);
+        if (!poFeature)
             continue;
-        }
-        else
-        {
-            OGRGeometry *poGeom =
-                m_oReader.ReadGeometry(poObject, GetSpatialRef());
-            json_object_put(poObject);
-            if (!poGeom)
-            {
-                continue;
-            }
-            poFeature = new OGRFeature(m_poFeatureDefn);
-            poFeature->SetGeometryDirectly(poGeom);
-        }
 
         if (poFeature->GetFID() == OGRNullFID)
         {
@@ -661,6 +699,87 @@ GIntBig OGRGeoJSONSeqLayer::GetFeatureCount(int bForce)
     return OGRLayer::GetFeatureCount(bForce);
 }
 
+/************************************************************************/
+/*                   CanUseNativeGetNextArrowArray()                    */
+/************************************************************************/
+
+bool OGRGeoJSONSeqLayer::CanUseNativeGetNextArrowArray()
+{
+    // Undocumented: for testing purposes only
+    return m_poDS->m_bSupportsRead && !m_bWriteOnlyLayer &&
+           m_poFilterGeom == nullptr && m_poAttrQuery == nullptr &&
+           !CPLTestBool(
+               CPLGetConfigOption("OGR_GEOJSONSEQ_STREAM_BASE_IMPL", "NO")) &&
+           OGRGeoJSONArrowRowBuilder::IsCompatible(
+               m_oReader, this, m_aosArrowArrayStreamOptions);
+}
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/************************************************************************/
+
+// Records are directly translated from JSON tokens to Arrow arrays when
+// possible, and go through TranslateObject() otherwise.
+int OGRGeoJSONSeqLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                          struct ArrowArray *out_array)
+{
+    if (!CanUseNativeGetNextArrowArray())
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    memset(out_array, 0, sizeof(*out_array));
+
+    GetLayerDefn();  // force scan if not already done
+    if (!m_poArrowParser)
+    {
+        m_poArrowParser =
+            std::make_unique<OGRGeoJSONRecordArrowParser>(m_oReader, this);
+        m_poArrowBatchBuilder = std::make_unique<OGRGeoJSONArrowBatchBuilder>(
+            m_poDS, this, m_aosArrowArrayStreamOptions);
+    }
+
+    auto &oRowBuilder = m_poArrowParser->GetRowBuilder();
+    while (!m_poArrowBatchBuilder->HasPendingArray())
+    {
+        if (!ReadNextRecord())
+        {
+            m_poArrowBatchBuilder->FinishArray();
+            if (!m_poArrowBatchBuilder->HasPendingArray())
+                return 0;
+            break;
+        }
+
+        if (!m_poArrowParser->ParseRecord(m_osFeatureBuffer.c_str(),
+                                          m_osFeatureBuffer.size()))
+        {
+            json_object *poObject = nullptr;
+            CPL_IGNORE_RET_VAL(
+                OGRJSonParse(m_osFeatureBuffer.c_str(), &poObject));
+            if (json_object_get_type(poObject) != json_type_object)
+            {
+                json_object_put(poObject);
+                continue;
+            }
+            auto poFeature =
+                std::unique_ptr<OGRFeature>(TranslateObject(poObject));
+            if (!poFeature)
+                continue;
+            oRowBuilder.SetFromFeature(*poFeature);
+        }
+
+        GIntBig nFID = oRowBuilder.GetFID();
+        if (nFID == OGRNullFID)
+        {
+            nFID = m_nNextFID;
+            m_nNextFID++;
+        }
+        if (!m_poArrowBatchBuilder->AppendRow(oRowBuilder, nFID))
+            return ENOMEM;
+    }
+
+    m_poArrowBatchBuilder->GetNextArray(out_array);
+    return 0;
+}
+
 /************************************************************************/
 /*                           TestCapability()                           */
 /************************************************************************/
@@ -678,6 +797,10 @@ int OGRGeoJSONSeqLayer::TestCapability(const char *pszCap)
     {
         return m_poDS->GetAccess() == GA_Update;
     }
+    if (EQUAL(pszCap, OLCFastGetArrowStream))
+    {
+        return CanUseNativeGetNextArrowArray();
+    }
 
     return false;
 }
@@ -656,6 +656,7 @@ class OGRGeoPackageLayer CPL_NON_FINAL : public OGRLayer,
 /************************************************************************/
 
 struct OGRGPKGTableLayerFillArrowArray;
+struct OGRGPKGArrowWriteColumn;
 struct sqlite_rtree_bl;
 
 class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
@@ -774,6 +775,9 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
 #endif
 
     void CheckGeometryType(const OGRFeature *poFeature);
+    void CheckGeometryType(OGRwkbGeometryType eGeomType);
+    bool UpdateExtentAndSpatialIndex(GIntBig nFID, const OGREnvelope &oEnv,
+                                     bool bUpsert);
 
     OGRErr ReadTableDefinition();
     void InitView();
@@ -789,6 +793,10 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
                                         const char *pszNewName);
 
     OGRErr CreateOrUpsertFeature(OGRFeature *poFeature, bool bUpsert);
+    bool CanUseNativeWriteArrowBatch(
+        const struct ArrowSchema *schema, struct ArrowArray *array,
+        CSLConstList papszOptions,
+        std::vector<OGRGPKGArrowWriteColumn> &asColumns);
 
     GIntBig GetTotalFeatureCount();
 
@@ -876,6 +884,9 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
                           const int *panUpdatedGeomFieldsIdx,
                           bool bUpdateStyleString) override;
     OGRErr DeleteFeature(GIntBig nFID) override;
+    bool WriteArrowBatch(const struct ArrowSchema *schema,
+                         struct ArrowArray *array,
+                         CSLConstList papszOptions = nullptr) override;
 
     OGRErr ISetSpatialFilter(int iGeomField,
                              const OGRGeometry *poGeom) override;
@@ -1012,6 +1023,8 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     OGRErr SaveTimestamp();
     OGRErr BuildColumns();
     bool IsGeomFieldSet(OGRFeature *poFeature);
+    static int FormatDateField(const OGRField *psFieldRaw, char *pszBuffer);
+    int FormatDateTimeField(const OGRField *psFieldRaw, char *pszBuffer) const;
     std::string FeatureGenerateUpdateSQL(const OGRFeature *poFeature) const;
     std::string FeatureGenerateUpdateSQL(
         const OGRFeature *poFeature, int nUpdatedFieldsCount,
@@ -206,6 +206,85 @@ bool OGRGeoPackageTableLayer::IsGeomFieldSet(OGRFeature *poFeature)
            poFeature->GetGeomFieldRef(0);
 }
 
+//----------------------------------------------------------------------
+// FormatDateField()
+//
+// Format the value of a Date field as stored in the table, in
+// pszBuffer (which must be at least OGR_SIZEOF_ISO8601_DATETIME_BUFFER
+// bytes large). Returns the number of bytes written.
+//
+int OGRGeoPackageTableLayer::FormatDateField(const OGRField *psFieldRaw,
+                                             char *pszBuffer)
+{
+    if (psFieldRaw->Date.Year < 0 || psFieldRaw->Date.Year >= 10000)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "OGRGetISO8601DateTime(): year %d unsupported ",
+                 psFieldRaw->Date.Year);
+        return 0;
+    }
+
+    int nYear = psFieldRaw->Date.Year;
+    pszBuffer[3] = (nYear % 10) + '0';
+    nYear /= 10;
+    pszBuffer[2] = (nYear % 10) + '0';
+    nYear /= 10;
+    pszBuffer[1] = (nYear % 10) + '0';
+    nYear /= 10;
+    pszBuffer[0] = static_cast<char>(nYear /*% 10*/ + '0');
+    pszBuffer[4] = '-';
+    pszBuffer[5] = ((psFieldRaw->Date.Month / 10) % 10) + '0';
+    pszBuffer[6] = (psFieldRaw->Date.Month % 10) + '0';
+    pszBuffer[7] = '-';
+    pszBuffer[8] = ((psFieldRaw->Date.Day / 10) % 10) + '0';
+    pszBuffer[9] = (psFieldRaw->Date.Day % 10) + '0';
+    return 10;
+}
+
+//----------------------------------------------------------------------
+// FormatDateTimeField()
+//
+// Format the value of a DateTime field as stored in the table, in
+// pszBuffer (which must be at least OGR_SIZEOF_ISO8601_DATETIME_BUFFER
+// bytes large). Returns the number of bytes written.
+//
+int OGRGeoPackageTableLayer::FormatDateTimeField(const OGRField *psFieldRaw,
+                                                 char *pszBuffer) const
+{
+    if (m_poDS->m_bDateTimeWithTZ || psFieldRaw->Date.TZFlag == 100)
+    {
+        return OGRGetISO8601DateTime(psFieldRaw, m_sDateTimeFormat, pszBuffer);
+    }
+
+    OGRField sField(*psFieldRaw);
+    if (sField.Date.TZFlag == 0 || sField.Date.TZFlag == 1)
+    {
+        sField.Date.TZFlag = 100;
+    }
+    else
+    {
+        struct tm brokendowntime;
+        brokendowntime.tm_year = sField.Date.Year - 1900;
+        brokendowntime.tm_mon = sField.Date.Month - 1;
+        brokendowntime.tm_mday = sField.Date.Day;
+        brokendowntime.tm_hour = sField.Date.Hour;
+        brokendowntime.tm_min = sField.Date.Minute;
+        brokendowntime.tm_sec = 0;
+        GIntBig nDT = CPLYMDHMSToUnixTime(&brokendowntime);
+        const int TZOffset = std::abs(sField.Date.TZFlag - 100) * 15;
+        nDT -= TZOffset * 60;
+        CPLUnixTimeToYMDHMS(nDT, &brokendowntime);
+        sField.Date.Year = static_cast<GInt16>(brokendowntime.tm_year + 1900);
+        sField.Date.Month = static_cast<GByte>(brokendowntime.tm_mon + 1);
+        sField.Date.Day = static_cast<GByte>(brokendowntime.tm_mday);
+        sField.Date.Hour = static_cast<GByte>(brokendowntime.tm_hour);
+        sField.Date.Minute = static_cast<GByte>(brokendowntime.tm_min);
+        sField.Date.TZFlag = 100;
+    }
+
+    return OGRGetISO8601DateTime(&sField, m_sDateTimeFormat, pszBuffer);
+}
+
 OGRErr OGRGeoPackageTableLayer::FeatureBindParameters(
     OGRFeature *poFeature, sqlite3_stmt *poStmt, int *pnColCount, bool bAddFID,
     bool bBindUnsetFields, int nUpdatedFieldsCount,
@@ -357,97 +436,21 @@ OGRErr OGRGeoPackageTableLayer::FeatureBindParameters(
                     if (eType == OFTDate)
                     {
                         destructorType = SQLITE_STATIC;
-                        const auto psFieldRaw =
-                            poFeature->GetRawFieldRef(iField);
                         char *pszValEdit =
                             &m_osInsertionBuffer[nInsertionBufferPos];
                         pszVal = pszValEdit;
-                        if (psFieldRaw->Date.Year < 0 ||
-                            psFieldRaw->Date.Year >= 10000)
-                        {
-                            CPLError(
-                                CE_Failure, CPLE_AppDefined,
-                                "OGRGetISO8601DateTime(): year %d unsupported ",
-                                psFieldRaw->Date.Year);
-                            nValLengthBytes = 0;
-                        }
-                        else
-                        {
-                            int nYear = psFieldRaw->Date.Year;
-                            pszValEdit[3] = (nYear % 10) + '0';
-                            nYear /= 10;
-                            pszValEdit[2] = (nYear % 10) + '0';
-                            nYear /= 10;
-                            pszValEdit[1] = (nYear % 10) + '0';
-                            nYear /= 10;
-                            pszValEdit[0] =
-                                static_cast<char>(nYear /*% 10*/ + '0');
-                            pszValEdit[4] = '-';
-                            pszValEdit[5] =
-                                ((psFieldRaw->Date.Month / 10) % 10) + '0';
-                            pszValEdit[6] = (psFieldRaw->Date.Month % 10) + '0';
-                            pszValEdit[7] = '-';
-                            pszValEdit[8] =
-                                ((psFieldRaw->Date.Day / 10) % 10) + '0';
-                            pszValEdit[9] = (psFieldRaw->Date.Day % 10) + '0';
-                            nValLengthBytes = 10;
-                            nInsertionBufferPos += 10;
-                        }
+                        nValLengthBytes = FormatDateField(
+                            poFeature->GetRawFieldRef(iField), pszValEdit);
+                        nInsertionBufferPos += nValLengthBytes;
                     }
                     else if (eType == OFTDateTime)
                     {
                         destructorType = SQLITE_STATIC;
-                        const auto psFieldRaw =
-                            poFeature->GetRawFieldRef(iField);
                         char *pszValEdit =
                             &m_osInsertionBuffer[nInsertionBufferPos];
                         pszVal = pszValEdit;
-                        if (m_poDS->m_bDateTimeWithTZ ||
-                            psFieldRaw->Date.TZFlag == 100)
-                        {
-                            nValLengthBytes = OGRGetISO8601DateTime(
-                                psFieldRaw, m_sDateTimeFormat, pszValEdit);
-                        }
-                        else
-                        {
-                            OGRField sField(*psFieldRaw);
-                            if (sField.Date.TZFlag == 0 ||
-                                sField.Date.TZFlag == 1)
-                            {
-                                sField.Date.TZFlag = 100;
-                            }
-                            else
-                            {
-                                struct tm brokendowntime;
-                                brokendowntime.tm_year =
-                                    sField.Date.Year - 1900;
-                                brokendowntime.tm_mon = sField.Date.Month - 1;
-                                brokendowntime.tm_mday = sField.Date.Day;
-                                brokendowntime.tm_hour = sField.Date.Hour;
-                                brokendowntime.tm_min = sField.Date.Minute;
-                                brokendowntime.tm_sec = 0;
-                                GIntBig nDT =
-                                    CPLYMDHMSToUnixTime(&brokendowntime);
-                                const int TZOffset =
-                                    std::abs(sField.Date.TZFlag - 100) * 15;
-                                nDT -= TZOffset * 60;
-                                CPLUnixTimeToYMDHMS(nDT, &brokendowntime);
-                                sField.Date.Year = static_cast<GInt16>(
-                                    brokendowntime.tm_year + 1900);
-                                sField.Date.Month = static_cast<GByte>(
-                                    brokendowntime.tm_mon + 1);
-                                sField.Date.Day =
-                                    static_cast<GByte>(brokendowntime.tm_mday);
-                                sField.Date.Hour =
-                                    static_cast<GByte>(brokendowntime.tm_hour);
-                                sField.Date.Minute =
-                                    static_cast<GByte>(brokendowntime.tm_min);
-                                sField.Date.TZFlag = 100;
-                            }
-
-                            nValLengthBytes = OGRGetISO8601DateTime(
-                                &sField, m_sDateTimeFormat, pszValEdit);
-                        }
+                        nValLengthBytes = FormatDateTimeField(
+                            poFeature->GetRawFieldRef(iField), pszValEdit);
                         nInsertionBufferPos += nValLengthBytes;
                     }
                     else if (eType == OFTString)
@@ -2151,33 +2154,36 @@ void OGRGeoPackageTableLayer::DisableFeatureCountTriggers(
  * reflect the dimensionality of feature geometries.
  */
 void OGRGeoPackageTableLayer::CheckGeometryType(const OGRFeature *poFeature)
+{
+    const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+    if (poGeom != nullptr)
+        CheckGeometryType(poGeom->getGeometryType());
+}
+
+/** Same as above, from the type of a (non-null) feature geometry. */
+void OGRGeoPackageTableLayer::CheckGeometryType(OGRwkbGeometryType eGeomType)
 {
     const OGRwkbGeometryType eLayerGeomType = GetGeomType();
     const OGRwkbGeometryType eFlattenLayerGeomType = wkbFlatten(eLayerGeomType);
-    const OGRGeometry *poGeom = poFeature->GetGeometryRef();
     if (eFlattenLayerGeomType != wkbNone && eFlattenLayerGeomType != wkbUnknown)
     {
-        if (poGeom != nullptr)
+        const OGRwkbGeometryType eFlattenGeomType = wkbFlatten(eGeomType);
+        if (!OGR_GT_IsSubClassOf(eFlattenGeomType, eFlattenLayerGeomType) &&
+            !cpl::contains(m_eSetBadGeomTypeWarned, eFlattenGeomType))
         {
-            OGRwkbGeometryType eGeomType =
-                wkbFlatten(poGeom->getGeometryType());
-            if (!OGR_GT_IsSubClassOf(eGeomType, eFlattenLayerGeomType) &&
-                !cpl::contains(m_eSetBadGeomTypeWarned, eGeomType))
-            {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "A geometry of type %s is inserted into layer %s "
-                         "of geometry type %s, which is not normally allowed "
-                         "by the GeoPackage specification, but the driver will "
-                         "however do it. "
-                         "To create a conformant GeoPackage, if using ogr2ogr, "
-                         "the -nlt option can be used to override the layer "
-                         "geometry type. "
-                         "This warning will no longer be emitted for this "
-                         "combination of layer and feature geometry type.",
-                         OGRToOGCGeomType(eGeomType), GetName(),
-                         OGRToOGCGeomType(eFlattenLayerGeomType));
-                m_eSetBadGeomTypeWarned.insert(eGeomType);
-            }
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "A geometry of type %s is inserted into layer %s "
+                     "of geometry type %s, which is not normally allowed "
+                     "by the GeoPackage specification, but the driver will "
+                     "however do it. "
+                     "To create a conformant GeoPackage, if using ogr2ogr, "
+                     "the -nlt option can be used to override the layer "
+                     "geometry type. "
+                     "This warning will no longer be emitted for this "
+                     "combination of layer and feature geometry type.",
+                     OGRToOGCGeomType(eFlattenGeomType), GetName(),
+                     OGRToOGCGeomType(eFlattenLayerGeomType));
+            m_eSetBadGeomTypeWarned.insert(eFlattenGeomType);
         }
     }
 
@@ -2185,50 +2191,46 @@ void OGRGeoPackageTableLayer::CheckGeometryType(const OGRFeature *poFeature)
     // if we have geometries with Z and M components
     if (m_nZFlag == 0 || m_nMFlag == 0)
     {
-        if (poGeom != nullptr)
+        bool bUpdateGpkgGeometryColumnsTable = false;
+        if (m_nZFlag == 0 && wkbHasZ(eGeomType))
         {
-            bool bUpdateGpkgGeometryColumnsTable = false;
-            const OGRwkbGeometryType eGeomType = poGeom->getGeometryType();
-            if (m_nZFlag == 0 && wkbHasZ(eGeomType))
+            if (eLayerGeomType != wkbUnknown && !wkbHasZ(eLayerGeomType))
             {
-                if (eLayerGeomType != wkbUnknown && !wkbHasZ(eLayerGeomType))
-                {
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "Layer '%s' has been declared with non-Z geometry type "
-                        "%s, but it does contain geometries with Z. Setting "
-                        "the Z=2 hint into gpkg_geometry_columns",
-                        GetName(),
-                        OGRToOGCGeomType(eLayerGeomType, true, true, true));
-                }
-                m_nZFlag = 2;
-                bUpdateGpkgGeometryColumnsTable = true;
-            }
-            if (m_nMFlag == 0 && wkbHasM(eGeomType))
-            {
-                if (eLayerGeomType != wkbUnknown && !wkbHasM(eLayerGeomType))
-                {
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "Layer '%s' has been declared with non-M geometry type "
-                        "%s, but it does contain geometries with M. Setting "
-                        "the M=2 hint into gpkg_geometry_columns",
-                        GetName(),
-                        OGRToOGCGeomType(eLayerGeomType, true, true, true));
-                }
-                m_nMFlag = 2;
-                bUpdateGpkgGeometryColumnsTable = true;
+                CPLError(
+                    CE_Warning, CPLE_AppDefined,
+                    "Layer '%s' has been declared with non-Z geometry type "
+                    "%s, but it does contain geometries with Z. Setting "
+                    "the Z=2 hint into gpkg_geometry_columns",
+                    GetName(),
+                    OGRToOGCGeomType(eLayerGeomType, true, true, true));
             }
-            if (bUpdateGpkgGeometryColumnsTable)
+            m_nZFlag = 2;
+            bUpdateGpkgGeometryColumnsTable = true;
+        }
+        if (m_nMFlag == 0 && wkbHasM(eGeomType))
+        {
+            if (eLayerGeomType != wkbUnknown && !wkbHasM(eLayerGeomType))
             {
-                /* Update gpkg_geometry_columns */
-                char *pszSQL = sqlite3_mprintf(
-                    "UPDATE gpkg_geometry_columns SET z = %d, m = %d WHERE "
-                    "table_name = '%q' AND column_name = '%q'",
-                    m_nZFlag, m_nMFlag, GetName(), GetGeometryColumn());
-                CPL_IGNORE_RET_VAL(SQLCommand(m_poDS->GetDB(), pszSQL));
-                sqlite3_free(pszSQL);
+                CPLError(
+                    CE_Warning, CPLE_AppDefined,
+                    "Layer '%s' has been declared with non-M geometry type "
+                    "%s, but it does contain geometries with M. Setting "
+                    "the M=2 hint into gpkg_geometry_columns",
+                    GetName(),
+                    OGRToOGCGeomType(eLayerGeomType, true, true, true));
             }
+            m_nMFlag = 2;
+            bUpdateGpkgGeometryColumnsTable = true;
+        }
+        if (bUpdateGpkgGeometryColumnsTable)
+        {
+            /* Update gpkg_geometry_columns */
+            char *pszSQL = sqlite3_mprintf(
+                "UPDATE gpkg_geometry_columns SET z = %d, m = %d WHERE "
+                "table_name = '%q' AND column_name = '%q'",
+                m_nZFlag, m_nMFlag, GetName(), GetGeometryColumn());
+            CPL_IGNORE_RET_VAL(SQLCommand(m_poDS->GetDB(), pszSQL));
+            sqlite3_free(pszSQL);
         }
     }
 }
@@ -2316,6 +2318,91 @@ static float rtreeValueUp(double d)
     return f;
 }
 
+/************************************************************************/
+/*                    UpdateExtentAndSpatialIndex()                     */
+/************************************************************************/
+
+// Called after the insertion of a feature with a non-empty geometry of
+// envelope oEnv. Updates the layer extent, and registers the RTree entry of
+// the feature when the RTree triggers are disabled (deferred spatial index
+// update within a transaction), or when the RTree is built in a background
+// thread.
+
+bool OGRGeoPackageTableLayer::UpdateExtentAndSpatialIndex(
+    GIntBig nFID, const OGREnvelope &oEnv, bool bUpsert)
+{
+    UpdateExtent(&oEnv);
+
+    if (!bUpsert && !m_bDeferredSpatialIndexCreation && HasSpatialIndex() &&
+        m_poDS->IsInTransaction())
+    {
+        m_nCountInsertInTransaction++;
+        if (m_nCountInsertInTransactionThreshold < 0)
+        {
+            m_nCountInsertInTransactionThreshold = atoi(CPLGetConfigOption(
+                "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
+        }
+        if (m_nCountInsertInTransaction == m_nCountInsertInTransactionThreshold)
+        {
+            StartDeferredSpatialIndexUpdate();
+        }
+        else if (!m_aoRTreeTriggersSQL.empty())
+        {
+            if (m_aoRTreeEntries.size() == 1000 * 1000)
+            {
+                if (!FlushPendingSpatialIndexUpdate())
+                    return false;
+            }
+            GPKGRTreeEntry sEntry;
+            sEntry.nId = nFID;
+            sEntry.fMinX = rtreeValueDown(oEnv.MinX);
+            sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
+            sEntry.fMinY = rtreeValueDown(oEnv.MinY);
+            sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
+            m_aoRTreeEntries.push_back(sEntry);
+        }
+    }
+    else if (!bUpsert && m_bAllowedRTreeThread && !m_bErrorDuringRTreeThread)
+    {
+        GPKGRTreeEntry sEntry;
+#ifdef DEBUG_VERBOSE
+        if (m_aoRTreeEntries.empty())
+            CPLDebug("GPKG",
+                     "Starting to fill m_aoRTreeEntries at FID " CPL_FRMT_GIB,
+                     nFID);
+#endif
+        sEntry.nId = nFID;
+        sEntry.fMinX = rtreeValueDown(oEnv.MinX);
+        sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
+        sEntry.fMinY = rtreeValueDown(oEnv.MinY);
+        sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
+        try
+        {
+            m_aoRTreeEntries.push_back(sEntry);
+            if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
+            {
+                m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
+                m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
+            }
+            if (!m_bThreadRTreeStarted &&
+                m_oQueueRTreeEntries.size() == m_nRTreeBatchesBeforeStart)
+            {
+                StartAsyncRTree();
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLDebug("GPKG", "Memory allocation error regarding RTree "
+                             "structures. Falling back to slower method");
+            if (m_bThreadRTreeStarted)
+                CancelAsyncRTree();
+            else
+                m_bAllowedRTreeThread = false;
+        }
+    }
+    return true;
+}
+
 OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
                                                       bool bUpsert)
 {
@@ -2573,81 +2660,8 @@ OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
         {
             OGREnvelope oEnv;
             poGeom->getEnvelope(&oEnv);
-            UpdateExtent(&oEnv);
-
-            if (!bUpsert && !m_bDeferredSpatialIndexCreation &&
-                HasSpatialIndex() && m_poDS->IsInTransaction())
-            {
-                m_nCountInsertInTransaction++;
-                if (m_nCountInsertInTransactionThreshold < 0)
-                {
-                    m_nCountInsertInTransactionThreshold =
-                        atoi(CPLGetConfigOption(
-                            "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
-                }
-                if (m_nCountInsertInTransaction ==
-                    m_nCountInsertInTransactionThreshold)
-                {
-                    StartDeferredSpatialIndexUpdate();
-                }
-                else if (!m_aoRTreeTriggersSQL.empty())
-                {
-                    if (m_aoRTreeEntries.size() == 1000 * 1000)
-                    {
-                        if (!FlushPendingSpatialIndexUpdate())
-                            return OGRERR_FAILURE;
-                    }
-                    GPKGRTreeEntry sEntry;
-                    sEntry.nId = nFID;
-                    sEntry.fMinX = rtreeValueDown(oEnv.MinX);
-                    sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
-                    sEntry.fMinY = rtreeValueDown(oEnv.MinY);
-                    sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                    m_aoRTreeEntries.push_back(sEntry);
-                }
-            }
-            else if (!bUpsert && m_bAllowedRTreeThread &&
-                     !m_bErrorDuringRTreeThread)
-            {
-                GPKGRTreeEntry sEntry;
-#ifdef DEBUG_VERBOSE
-                if (m_aoRTreeEntries.empty())
-                    CPLDebug("GPKG",
-                             "Starting to fill m_aoRTreeEntries at "
-                             "FID " CPL_FRMT_GIB,
-                             nFID);
-#endif
-                sEntry.nId = nFID;
-                sEntry.fMinX = rtreeValueDown(oEnv.MinX);
-                sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
-                sEntry.fMinY = rtreeValueDown(oEnv.MinY);
-                sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                try
-                {
-                    m_aoRTreeEntries.push_back(sEntry);
-                    if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
-                    {
-                        m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
-                        m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
-                    }
-                    if (!m_bThreadRTreeStarted &&
-                        m_oQueueRTreeEntries.size() ==
-                            m_nRTreeBatchesBeforeStart)
-                    {
-                        StartAsyncRTree();
-                    }
-                }
-                catch (const std::bad_alloc &)
-                {
-                    CPLDebug("GPKG",
-                             "Memory allocation error regarding RTree "
-                             "structures. Falling back to slower method");
-                    if (m_bThreadRTreeStarted)
-                        CancelAsyncRTree();
-                    else
-                        m_bAllowedRTreeThread = false;
-                }
-            }
+            if (!UpdateExtentAndSpatialIndex(nFID, oEnv, bUpsert))
+                return OGRERR_FAILURE;
         }
     }
 
@@ -4376,7 +4390,8 @@ int OGRGeoPackageTableLayer::TestCapability(const char *pszCap)
 {
     if (!m_bFeatureDefnCompleted)
         GetLayerDefn();
-    if (EQUAL(pszCap, OLCSequentialWrite))
+    if (EQUAL(pszCap, OLCSequentialWrite) ||
+        EQUAL(pszCap, OLCFastWriteArrowBatch))
     {
         return m_poDS->GetUpdate();
     }
@@ -8786,16 +8801,7 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
     }
 
     const auto GetThreadsAvailable = []()
-    {
-        const char *pszMaxThreads =
-            CPLGetConfigOption("OGR_GPKG_NUM_THREADS", nullptr);
-        if (pszMaxThreads == nullptr)
-            return std::min(4, CPLGetNumCPUs());
-        else if (EQUAL(pszMaxThreads, "ALL_CPUS"))
-            return CPLGetNumCPUs();
-        else
-            return atoi(pszMaxThreads);
-    };
+    { return OGRGetNumThreadsForArrowArray("OGR_GPKG_NUM_THREADS"); };
 
     // Start asynchronous tasks to prefetch the next ArrowArray
     if (m_poDS->GetAccess() == GA_ReadOnly &&
@@ -9196,6 +9202,725 @@ OGRErr OGRGeoPackageTableLayer::IGetExtent3D(int iGeomField,
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                       OGRGPKGArrowWriteColumn                        */
+/************************************************************************/
+
+/** Column of an Arrow batch bound by the native WriteArrowBatch()
+ * implementation. Columns are stored in the order of the placeholders of
+ * the INSERT statement. */
+struct OGRGPKGArrowWriteColumn
+{
+    enum class Type
+    {
+        FID_INT32,
+        FID_INT64,
+        GEOMETRY,
+        LARGE_GEOMETRY,
+        BOOLEAN,
+        INT8,
+        UINT8,
+        INT16,
+        UINT16,
+        INT32,
+        UINT32,
+        INT64,
+        FLOAT32,
+        FLOAT64,
+        STRING,
+        LARGE_STRING,
+        BINARY,
+        LARGE_BINARY,
+        DATE32,
+        TIMESTAMP,
+    };
+
+    Type eType = Type::INT32;
+    struct ArrowArray *array = nullptr;
+    std::string osSQLName{};
+    int nInvFactorToSecond = 1;  // only for TIMESTAMP
+    std::string osTZ{};          // only for TIMESTAMP
+};
+
+static const struct
+{
+    const char *pszFormat;
+    OGRFieldType eFieldType;
+    OGRGPKGArrowWriteColumn::Type eType;
+} gasGPKGArrowWriteTypes[] = {
+    {"b", OFTInteger, OGRGPKGArrowWriteColumn::Type::BOOLEAN},
+    {"c", OFTInteger, OGRGPKGArrowWriteColumn::Type::INT8},
+    {"C", OFTInteger, OGRGPKGArrowWriteColumn::Type::UINT8},
+    {"s", OFTInteger, OGRGPKGArrowWriteColumn::Type::INT16},
+    {"S", OFTInteger, OGRGPKGArrowWriteColumn::Type::UINT16},
+    {"i", OFTInteger, OGRGPKGArrowWriteColumn::Type::INT32},
+    {"I", OFTInteger64, OGRGPKGArrowWriteColumn::Type::UINT32},
+    {"l", OFTInteger64, OGRGPKGArrowWriteColumn::Type::INT64},
+    {"f", OFTReal, OGRGPKGArrowWriteColumn::Type::FLOAT32},
+    {"g", OFTReal, OGRGPKGArrowWriteColumn::Type::FLOAT64},
+    {"u", OFTString, OGRGPKGArrowWriteColumn::Type::STRING},
+    {"U", OFTString, OGRGPKGArrowWriteColumn::Type::LARGE_STRING},
+    {"z", OFTBinary, OGRGPKGArrowWriteColumn::Type::BINARY},
+    {"Z", OFTBinary, OGRGPKGArrowWriteColumn::Type::LARGE_BINARY},
+    {"tdD", OFTDate, OGRGPKGArrowWriteColumn::Type::DATE32},
+};
+
+/************************************************************************/
+/*                     CanUseNativeWriteArrowBatch()                    */
+/************************************************************************/
+
+/** Returns whether WriteArrowBatch() can directly bind the columns of the
+ * batch to a single INSERT statement, with the same result as
+ * OGRLayer::WriteArrowBatch(). In which case asColumns is filled.
+ */
+bool OGRGeoPackageTableLayer::CanUseNativeWriteArrowBatch(
+    const struct ArrowSchema *schema, struct ArrowArray *array,
+    CSLConstList papszOptions, std::vector<OGRGPKGArrowWriteColumn> &asColumns)
+{
+    if (!m_poDS->GetUpdate() || !m_bIsTable || m_pszFidColumn == nullptr ||
+        m_iFIDAsRegularColumnIndex >= 0 ||
+        m_poFeatureDefn->GetGeomFieldCount() > 1 ||
+        strcmp(schema->format, "+s") != 0 ||
+        schema->n_children != array->n_children || array->length < 0)
+    {
+        return false;
+    }
+
+    const char *pszFIDName =
+        CSLFetchNameValueDef(papszOptions, "FID", GetFIDColumn());
+    if (!pszFIDName || pszFIDName[0] == 0)
+        pszFIDName = DEFAULT_ARROW_FID_NAME;
+    const char *pszGeomFieldName = CSLFetchNameValueDef(
+        papszOptions, "GEOMETRY_NAME", GetGeometryColumn());
+    if (!pszGeomFieldName || pszGeomFieldName[0] == 0)
+        pszGeomFieldName = DEFAULT_ARROW_GEOMETRY_NAME;
+
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    std::vector<bool> abFieldSet(nFieldCount);
+    bool bFIDSet = false;
+    bool bGeomSet = false;
+    for (int64_t i = 0; i < schema->n_children; ++i)
+    {
+        const struct ArrowSchema *childSchema = schema->children[i];
+        const char *pszName = childSchema->name;
+        const char *format = childSchema->format;
+        if (childSchema->dictionary != nullptr || pszName == nullptr)
+            return false;
+
+        OGRGPKGArrowWriteColumn sColumn;
+        sColumn.array = array->children[i];
+
+        if (strcmp(pszName, pszFIDName) == 0)
+        {
+            if (bFIDSet)
+                return false;
+            if (strcmp(format, "i") == 0)
+                sColumn.eType = OGRGPKGArrowWriteColumn::Type::FID_INT32;
+            else if (strcmp(format, "l") == 0)
+                sColumn.eType = OGRGPKGArrowWriteColumn::Type::FID_INT64;
+            else
+                return false;
+            bFIDSet = true;
+            sColumn.osSQLName = m_pszFidColumn;
+            asColumns.push_back(std::move(sColumn));
+            continue;
+        }
+
+        const int iField = m_poFeatureDefn->GetFieldIndex(pszName);
+        if (iField >= 0)
+        {
+            const OGRFieldDefn *poFieldDefn =
+                m_poFeatureDefn->GetFieldDefn(iField);
+            const OGRFieldType eFieldType = poFieldDefn->GetType();
+            // String fields with a width need the checks and truncation done
+            // by FeatureBindParameters()
+            if (abFieldSet[iField] || poFieldDefn->IsGenerated() ||
+                (eFieldType == OFTString && poFieldDefn->GetWidth() > 0))
+            {
+                return false;
+            }
+
+            bool bTypeOK = false;
+            for (const auto &sType : gasGPKGArrowWriteTypes)
+            {
+                if (strcmp(format, sType.pszFormat) == 0)
+                {
+                    bTypeOK = sType.eFieldType == eFieldType;
+                    sColumn.eType = sType.eType;
+                    break;
+                }
+            }
+            if (!bTypeOK && eFieldType == OFTDateTime &&
+                strncmp(format, "ts", 2) == 0 && format[2] != 0 &&
+                format[3] == ':')
+            {
+                bTypeOK = true;
+                sColumn.eType = OGRGPKGArrowWriteColumn::Type::TIMESTAMP;
+                sColumn.osTZ = format + strlen("ts?:");
+                switch (format[2])
+                {
+                    case 's':
+                        sColumn.nInvFactorToSecond = 1;
+                        break;
+                    case 'm':
+                        sColumn.nInvFactorToSecond = 1000;
+                        break;
+                    case 'u':
+                        sColumn.nInvFactorToSecond = 1000 * 1000;
+                        break;
+                    case 'n':
+                        sColumn.nInvFactorToSecond = 1000 * 1000 * 1000;
+                        break;
+                    default:
+                        bTypeOK = false;
+                        break;
+                }
+            }
+            if (!bTypeOK)
+                return false;
+
+            abFieldSet[iField] = true;
+            sColumn.osSQLName = poFieldDefn->GetNameRef();
+            asColumns.push_back(std::move(sColumn));
+            continue;
+        }
+
+        if (bGeomSet || m_poFeatureDefn->GetGeomFieldCount() == 0)
+            return false;
+        bool bIsGeom = m_poFeatureDefn->GetGeomFieldIndex(pszName) == 0 ||
+                       strcmp(pszName, pszGeomFieldName) == 0;
+        if (!bIsGeom && childSchema->metadata)
+        {
+            const auto oMetadata =
+                OGRParseArrowMetadata(childSchema->metadata);
+            const auto oIter = oMetadata.find(ARROW_EXTENSION_NAME_KEY);
+            bIsGeom = oIter != oMetadata.end() &&
+                      (oIter->second == EXTENSION_NAME_OGC_WKB ||
+                       oIter->second == EXTENSION_NAME_GEOARROW_WKB);
+        }
+        if (!bIsGeom)
+            return false;
+        if (strcmp(format, "z") == 0)
+            sColumn.eType = OGRGPKGArrowWriteColumn::Type::GEOMETRY;
+        else if (strcmp(format, "Z") == 0)
+            sColumn.eType = OGRGPKGArrowWriteColumn::Type::LARGE_GEOMETRY;
+        else
+            return false;
+        bGeomSet = true;
+        sColumn.osSQLName = GetGeometryColumn();
+        asColumns.push_back(std::move(sColumn));
+    }
+
+    // Fields that are not in the batch must get their default value, as
+    // done by CreateFeature().
+    for (int i = 0; i < nFieldCount; ++i)
+    {
+        if (!abFieldSet[i] &&
+            m_poFeatureDefn->GetFieldDefn(i)->GetDefault() != nullptr)
+        {
+            return false;
+        }
+    }
+
+    return !asColumns.empty();
+}
+
+/************************************************************************/
+/*                            TestBit()                                 */
+/************************************************************************/
+
+static inline bool TestBit(const void *pabyData, size_t nIdx)
+{
+    return (static_cast<const GByte *>(pabyData)[nIdx / 8] &
+            (1 << (nIdx % 8))) != 0;
+}
+
+/************************************************************************/
+/*                          WriteArrowBatch()                           */
+/************************************************************************/
+
+/** Writes an Arrow batch.
+ *
+ * Instead of going through a OGRFeature per row as OGRLayer::WriteArrowBatch()
+ * does, the values of the Arrow arrays are directly bound to a single
+ * prepared INSERT statement, and WKB geometries are wrapped into GeoPackage
+ * blobs without being instantiated as OGRGeometry when possible.
+ * Batches this code cannot deal with identically to the generic
+ * implementation are delegated to it.
+ */
+bool OGRGeoPackageTableLayer::WriteArrowBatch(const struct ArrowSchema *schema,
+                                              struct ArrowArray *array,
+                                              CSLConstList papszOptions)
+{
+    if (!m_bFeatureDefnCompleted)
+        GetLayerDefn();
+
+    std::vector<OGRGPKGArrowWriteColumn> asColumns;
+    if (CPLTestBool(CPLGetConfigOption("OGR_GPKG_WRITE_ARROW_BATCH_BASE_IMPL",
+                                       "NO")) ||
+        !CanUseNativeWriteArrowBatch(schema, array, papszOptions, asColumns))
+    {
+        return OGRGeoPackageLayer::WriteArrowBatch(schema, array, papszOptions);
+    }
+
+    if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
+        return false;
+
+    CancelAsyncNextArrowArray();
+
+    bool bTransactionOK;
+    {
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        bTransactionOK = StartTransaction() == OGRERR_NONE;
+    }
+
+#ifdef ENABLE_GPKG_OGR_CONTENTS
+    // To maximize performance of insertion, disable feature count triggers
+    if (m_bOGRFeatureCountTriggersEnabled)
+    {
+        DisableFeatureCountTriggers();
+    }
+#endif
+
+    const OGRGPKGArrowWriteColumn *psFIDColumn = nullptr;
+    bool bHasGeomColumn = false;
+    std::string osSQL("INSERT INTO \"");
+    osSQL += SQLEscapeName(m_pszTableName);
+    osSQL += "\" (";
+    for (size_t iCol = 0; iCol < asColumns.size(); ++iCol)
+    {
+        const auto &sColumn = asColumns[iCol];
+        if (sColumn.eType == OGRGPKGArrowWriteColumn::Type::FID_INT32 ||
+            sColumn.eType == OGRGPKGArrowWriteColumn::Type::FID_INT64)
+        {
+            psFIDColumn = &sColumn;
+        }
+        else if (sColumn.eType == OGRGPKGArrowWriteColumn::Type::GEOMETRY ||
+                 sColumn.eType ==
+                     OGRGPKGArrowWriteColumn::Type::LARGE_GEOMETRY)
+        {
+            bHasGeomColumn = true;
+        }
+        if (iCol > 0)
+            osSQL += ", ";
+        osSQL += '"';
+        osSQL += SQLEscapeName(sColumn.osSQLName.c_str());
+        osSQL += '"';
+    }
+    osSQL += ") VALUES (";
+    for (size_t iCol = 0; iCol < asColumns.size(); ++iCol)
+    {
+        if (iCol > 0)
+            osSQL += ", ";
+        osSQL += '?';
+    }
+    osSQL += ')';
+
+    sqlite3 *hDB = m_poDS->GetDB();
+    sqlite3_stmt *hStmt = nullptr;
+    if (SQLPrepareWithError(hDB, osSQL.c_str(), -1, &hStmt, nullptr) !=
+        SQLITE_OK)
+    {
+        if (bTransactionOK)
+            RollbackTransaction();
+        return false;
+    }
+
+    // Within a transaction, UpdateExtentAndSpatialIndex() switches to a bulk
+    // update of the RTree once OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD features
+    // have been inserted. Do it right away, as the batch is the equivalent of
+    // many CreateFeature() calls.
+    if (bHasGeomColumn && array->length > 0 &&
+        !m_bDeferredSpatialIndexCreation && HasSpatialIndex() &&
+        m_poDS->IsInTransaction() && m_aoRTreeTriggersSQL.empty())
+    {
+        if (m_nCountInsertInTransactionThreshold < 0)
+        {
+            m_nCountInsertInTransactionThreshold = atoi(CPLGetConfigOption(
+                "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
+        }
+        if (m_nCountInsertInTransaction < m_nCountInsertInTransactionThreshold)
+        {
+            m_nCountInsertInTransaction = m_nCountInsertInTransactionThreshold;
+            StartDeferredSpatialIndexUpdate();
+        }
+    }
+
+    const bool bCanUseWKBAsIs =
+        m_sBinaryPrecision.nXYBitPrecision == INT_MIN &&
+        m_sBinaryPrecision.nZBitPrecision == INT_MIN &&
+        m_sBinaryPrecision.nMBitPrecision == INT_MIN;
+    std::vector<GByte> abyBlob;
+    // One buffer per column, as text values are bound with SQLITE_STATIC
+    std::string osDateTimeBuffers(
+        asColumns.size() * OGR_SIZEOF_ISO8601_DATETIME_BUFFER, '\0');
+    int64_t fidNullCount = 0;
+    bool bRet = true;
+    const size_t nRows = static_cast<size_t>(array->length);
+    for (size_t iRow = 0; bRet && iRow < nRows; ++iRow)
+    {
+        bool bHasGeom = false;
+        bool bGeomEmpty = true;
+        OGREnvelope sEnvelope;
+
+        for (size_t iCol = 0; bRet && iCol < asColumns.size(); ++iCol)
+        {
+            const auto &sColumn = asColumns[iCol];
+            const struct ArrowArray *psArray = sColumn.array;
+            const size_t iIdx = iRow + static_cast<size_t>(psArray->offset);
+            const int iParam = static_cast<int>(iCol) + 1;
+            const void *pValues = psArray->buffers[1];
+            int err = SQLITE_OK;
+
+            if (psArray->null_count != 0 && psArray->buffers[0] &&
+                !TestBit(psArray->buffers[0], iIdx))
+            {
+                err = sqlite3_bind_null(hStmt, iParam);
+            }
+            else
+            {
+                switch (sColumn.eType)
+                {
+                    case OGRGPKGArrowWriteColumn::Type::BOOLEAN:
+                        err = sqlite3_bind_int(hStmt, iParam,
+                                               TestBit(pValues, iIdx) ? 1 : 0);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::INT8:
+                        err = sqlite3_bind_int(
+                            hStmt, iParam,
+                            static_cast<const int8_t *>(pValues)[iIdx]);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::UINT8:
+                        err = sqlite3_bind_int(
+                            hStmt, iParam,
+                            static_cast<const uint8_t *>(pValues)[iIdx]);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::INT16:
+                        err = sqlite3_bind_int(
+                            hStmt, iParam,
+                            static_cast<const int16_t *>(pValues)[iIdx]);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::UINT16:
+                        err = sqlite3_bind_int(
+                            hStmt, iParam,
+                            static_cast<const uint16_t *>(pValues)[iIdx]);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::FID_INT32:
+                    case OGRGPKGArrowWriteColumn::Type::INT32:
+                        err = sqlite3_bind_int(
+                            hStmt, iParam,
+                            static_cast<const int32_t *>(pValues)[iIdx]);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::UINT32:
+                        err = sqlite3_bind_int64(
+                            hStmt, iParam,
+                            static_cast<const uint32_t *>(pValues)[iIdx]);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::FID_INT64:
+                    case OGRGPKGArrowWriteColumn::Type::INT64:
+                        err = sqlite3_bind_int64(
+                            hStmt, iParam,
+                            static_cast<const int64_t *>(pValues)[iIdx]);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::FLOAT32:
+                        err = sqlite3_bind_double(
+                            hStmt, iParam,
+                            static_cast<const float *>(pValues)[iIdx]);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::FLOAT64:
+                        err = sqlite3_bind_double(
+                            hStmt, iParam,
+                            static_cast<const double *>(pValues)[iIdx]);
+                        break;
+
+                    case OGRGPKGArrowWriteColumn::Type::STRING:
+                    case OGRGPKGArrowWriteColumn::Type::LARGE_STRING:
+                    case OGRGPKGArrowWriteColumn::Type::BINARY:
+                    case OGRGPKGArrowWriteColumn::Type::LARGE_BINARY:
+                    case OGRGPKGArrowWriteColumn::Type::GEOMETRY:
+                    case OGRGPKGArrowWriteColumn::Type::LARGE_GEOMETRY:
+                    {
+                        uint64_t nStart;
+                        uint64_t nEnd;
+                        if (sColumn.eType ==
+                                OGRGPKGArrowWriteColumn::Type::STRING ||
+                            sColumn.eType ==
+                                OGRGPKGArrowWriteColumn::Type::BINARY ||
+                            sColumn.eType ==
+                                OGRGPKGArrowWriteColumn::Type::GEOMETRY)
+                        {
+                            const auto panOffsets =
+                                static_cast<const uint32_t *>(pValues);
+                            nStart = panOffsets[iIdx];
+                            nEnd = panOffsets[iIdx + 1];
+                        }
+                        else
+                        {
+                            const auto panOffsets =
+                                static_cast<const uint64_t *>(pValues);
+                            nStart = panOffsets[iIdx];
+                            nEnd = panOffsets[iIdx + 1];
+                        }
+                        const GByte *pabyData =
+                            static_cast<const GByte *>(psArray->buffers[2]) +
+                            nStart;
+                        const size_t nLen = static_cast<size_t>(nEnd - nStart);
+
+                        if (sColumn.eType ==
+                                OGRGPKGArrowWriteColumn::Type::GEOMETRY ||
+                            sColumn.eType ==
+                                OGRGPKGArrowWriteColumn::Type::LARGE_GEOMETRY)
+                        {
+                            OGRwkbGeometryType eGeomType = wkbUnknown;
+                            if (bCanUseWKBAsIs &&
+                                GPkgGeometryFromWKB(pabyData, nLen, m_iSrs,
+                                                    abyBlob, eGeomType,
+                                                    bGeomEmpty, sEnvelope))
+                            {
+                                bHasGeom = true;
+                                CheckGeometryType(eGeomType);
+                                err = sqlite3_bind_blob(
+                                    hStmt, iParam, abyBlob.data(),
+                                    static_cast<int>(abyBlob.size()),
+                                    SQLITE_STATIC);
+                                break;
+                            }
+
+                            OGRGeometry *poGeomRaw = nullptr;
+                            size_t nBytesConsumed = 0;
+                            OGRGeometryFactory::createFromWkb(
+                                pabyData, nullptr, &poGeomRaw, nLen,
+                                wkbVariantIso, nBytesConsumed);
+                            const std::unique_ptr<OGRGeometry> poGeom(
+                                poGeomRaw);
+                            if (!poGeom)
+                            {
+                                // Invalid WKB results in a null geometry
+                                err = sqlite3_bind_null(hStmt, iParam);
+                                break;
+                            }
+                            size_t nBlobSize = 0;
+                            GByte *pabyBlob = GPkgGeometryFromOGR(
+                                poGeom.get(), m_iSrs, &m_sBinaryPrecision,
+                                &nBlobSize);
+                            if (pabyBlob == nullptr)
+                            {
+                                bRet = false;
+                                break;
+                            }
+                            bHasGeom = true;
+                            bGeomEmpty = poGeom->IsEmpty();
+                            if (!bGeomEmpty)
+                                poGeom->getEnvelope(&sEnvelope);
+                            CheckGeometryType(poGeom->getGeometryType());
+                            CreateGeometryExtensionIfNecessary(poGeom.get());
+                            err = sqlite3_bind_blob(
+                                hStmt, iParam, pabyBlob,
+                                static_cast<int>(nBlobSize), CPLFree);
+                            break;
+                        }
+
+                        if (nLen > static_cast<size_t>(INT_MAX))
+                        {
+                            CPLError(CE_Failure, CPLE_AppDefined,
+                                     "Content for field %s is too large",
+                                     sColumn.osSQLName.c_str());
+                            bRet = false;
+                        }
+                        else if (sColumn.eType ==
+                                     OGRGPKGArrowWriteColumn::Type::STRING ||
+                                 sColumn.eType == OGRGPKGArrowWriteColumn::
+                                                      Type::LARGE_STRING)
+                        {
+                            err = sqlite3_bind_text(
+                                hStmt, iParam,
+                                reinterpret_cast<const char *>(pabyData),
+                                static_cast<int>(nLen), SQLITE_STATIC);
+                        }
+                        else
+                        {
+                            err = sqlite3_bind_blob(hStmt, iParam, pabyData,
+                                                    static_cast<int>(nLen),
+                                                    SQLITE_STATIC);
+                        }
+                        break;
+                    }
+
+                    case OGRGPKGArrowWriteColumn::Type::DATE32:
+                    case OGRGPKGArrowWriteColumn::Type::TIMESTAMP:
+                    {
+                        OGRField sField;
+                        if (sColumn.eType ==
+                            OGRGPKGArrowWriteColumn::Type::DATE32)
+                        {
+                            // Days since epoch
+                            const int64_t nTimestamp =
+                                static_cast<int64_t>(
+                                    static_cast<const int32_t *>(
+                                        pValues)[iIdx]) *
+                                3600 * 24;
+                            if (!OGRArrowTimestampToOGRField(nTimestamp, 1,
+                                                             "", sField))
+                            {
+                                err = sqlite3_bind_null(hStmt, iParam);
+                                break;
+                            }
+                        }
+                        else if (!OGRArrowTimestampToOGRField(
+                                     static_cast<const int64_t *>(
+                                         pValues)[iIdx],
+                                     sColumn.nInvFactorToSecond,
+                                     sColumn.osTZ.c_str(), sField))
+                        {
+                            err = sqlite3_bind_null(hStmt, iParam);
+                            break;
+                        }
+
+                        char *pszBuffer = &osDateTimeBuffers[
+                            iCol * OGR_SIZEOF_ISO8601_DATETIME_BUFFER];
+                        const int nLen =
+                            sColumn.eType ==
+                                    OGRGPKGArrowWriteColumn::Type::DATE32
+                                ? FormatDateField(&sField, pszBuffer)
+                                : FormatDateTimeField(&sField, pszBuffer);
+                        if (nLen == 0)
+                            bRet = false;
+                        else
+                            err = sqlite3_bind_text(hStmt, iParam, pszBuffer,
+                                                    nLen, SQLITE_STATIC);
+                        break;
+                    }
+                }
+            }
+
+            if (bRet && err != SQLITE_OK)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "sqlite3_bind_() for column %s failed: %s",
+                         sColumn.osSQLName.c_str(), sqlite3_errmsg(hDB));
+                bRet = false;
+            }
+        }
+        if (!bRet)
+            break;
+
+        const int err = sqlite3_step(hStmt);
+        if (!(err == SQLITE_OK || err == SQLITE_DONE))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "failed to execute insert : %s",
+                     sqlite3_errmsg(hDB) ? sqlite3_errmsg(hDB) : "");
+            bRet = false;
+            break;
+        }
+        const GIntBig nFID = sqlite3_last_insert_rowid(hDB);
+        sqlite3_reset(hStmt);
+        sqlite3_clear_bindings(hStmt);
+
+        if (bHasGeom && !bGeomEmpty &&
+            !UpdateExtentAndSpatialIndex(nFID, sEnvelope, false))
+        {
+            bRet = false;
+            break;
+        }
+
+#ifdef ENABLE_GPKG_OGR_CONTENTS
+        // Same as CreateOrUpsertFeature()
+        if (m_nTotalFeatureCount >= 0)
+        {
+            if (m_nTotalFeatureCount < std::numeric_limits<int64_t>::max())
+            {
+                m_nTotalFeatureCount++;
+            }
+            else
+            {
+                if (m_poDS->m_bHasGPKGOGRContents)
+                {
+                    char *pszSQL = sqlite3_mprintf(
+                        "UPDATE gpkg_ogr_contents SET feature_count = null "
+                        "WHERE lower(table_name) = lower('%q')",
+                        m_pszTableName);
+                    CPL_IGNORE_RET_VAL(sqlite3_exec(
+                        m_poDS->hDB, pszSQL, nullptr, nullptr, nullptr));
+                    sqlite3_free(pszSQL);
+                }
+                m_nTotalFeatureCount = -1;
+            }
+        }
+#endif
+        m_bContentChanged = true;
+
+        // Write back the FID of the feature into the FID column, as
+        // OGRLayer::WriteArrowBatch() does.
+        if (psFIDColumn)
+        {
+            struct ArrowArray *psArray = psFIDColumn->array;
+            const size_t iIdx = iRow + static_cast<size_t>(psArray->offset);
+            GByte *pabyValidity =
+                static_cast<GByte *>(const_cast<void *>(psArray->buffers[0]));
+            void *pValues = const_cast<void *>(psArray->buffers[1]);
+            if (psFIDColumn->eType ==
+                OGRGPKGArrowWriteColumn::Type::FID_INT32)
+            {
+                if (nFID > INT32_MAX)
+                {
+                    if (pabyValidity)
+                    {
+                        ++fidNullCount;
+                        pabyValidity[iIdx / 8] &=
+                            static_cast<GByte>(~(1 << (iIdx % 8)));
+                    }
+                    CPLError(CE_Warning, CPLE_AppDefined,
+                             "FID " CPL_FRMT_GIB
+                             " cannot be stored in FID array of type int32",
+                             nFID);
+                }
+                else
+                {
+                    if (pabyValidity)
+                        pabyValidity[iIdx / 8] |=
+                            static_cast<GByte>(1 << (iIdx % 8));
+                    static_cast<int32_t *>(pValues)[iIdx] =
+                        static_cast<int32_t>(nFID);
+                }
+            }
+            else
+            {
+                if (pabyValidity)
+                    pabyValidity[iIdx / 8] |=
+                        static_cast<GByte>(1 << (iIdx % 8));
+                static_cast<int64_t *>(pValues)[iIdx] = nFID;
+            }
+        }
+    }
+
+    sqlite3_finalize(hStmt);
+
+    if (!bRet)
+    {
+        if (bTransactionOK)
+            RollbackTransaction();
+        return false;
+    }
+
+    if (psFIDColumn && psFIDColumn->array->buffers[0])
+        psFIDColumn->array->null_count = fidNullCount;
+
+    if (bTransactionOK && CommitTransaction() != OGRERR_NONE)
+        return false;
+
+    return true;
+}
+
 /************************************************************************/
 /*                           Truncate()                                 */
 /************************************************************************/
@@ -14,6 +14,8 @@
 #include "ogr_p.h"
 #include "ogr_wkb.h"
 #include "sqlite/ogrsqlitebase.h"
+#include <cmath>
+#include <cstring>
 #include <limits>
 
 /* Requirement 20: A GeoPackage SHALL store feature table geometries */
@@ -349,6 +351,201 @@ GByte *GPkgGeometryFromOGR(const OGRGeometry *poGeometry, int iSrsId,
     return pabyWkb;
 }
 
+/* Returns whether pabyWkb + iOffset starts with an ISO WKB geometry in the */
+/* native byte order whose export through OGRGeometry::exportToWkb() would */
+/* give the same bytes. Only (Multi)Point/LineString/Polygon geometries whose */
+/* parts have the dimensionality of their parent are accepted, as other */
+/* types may require a geometry extension to be registered. */
+static bool GPkgIsWKBUsableAsIs(const GByte *pabyWkb, size_t nWkbLen,
+                                size_t &iOffset, uint32_t &nType, bool bIsPart)
+{
+    if (nWkbLen - iOffset < 5 ||
+        pabyWkb[iOffset] != static_cast<GByte>(CPL_IS_LSB))
+        return false;
+    memcpy(&nType, pabyWkb + iOffset + 1, sizeof(nType));
+    iOffset += 5;
+
+    const uint32_t nFlatType = nType % 1000;
+    const uint32_t nDimCode = nType / 1000;
+    if (nDimCode > 3)
+        return false;
+    const size_t nPointSize =
+        (2 + ((nDimCode & 1) != 0 ? 1 : 0) + (nDimCode >= 2 ? 1 : 0)) *
+        sizeof(double);
+
+    const auto ReadCount = [pabyWkb, nWkbLen, &iOffset](uint32_t &nCount)
+    {
+        if (nWkbLen - iOffset < sizeof(uint32_t))
+            return false;
+        memcpy(&nCount, pabyWkb + iOffset, sizeof(uint32_t));
+        iOffset += sizeof(uint32_t);
+        return true;
+    };
+
+    const auto SkipPoints = [nWkbLen, nPointSize, &iOffset](uint32_t nPoints)
+    {
+        if (nPoints > (nWkbLen - iOffset) / nPointSize)
+            return false;
+        iOffset += nPoints * nPointSize;
+        return true;
+    };
+
+    switch (nFlatType)
+    {
+        case wkbPoint:
+            return SkipPoints(1);
+
+        case wkbLineString:
+        {
+            uint32_t nPoints = 0;
+            return ReadCount(nPoints) && SkipPoints(nPoints);
+        }
+
+        case wkbPolygon:
+        {
+            uint32_t nRings = 0;
+            if (!ReadCount(nRings) ||
+                nRings > (nWkbLen - iOffset) / sizeof(uint32_t))
+                return false;
+            for (uint32_t i = 0; i < nRings; ++i)
+            {
+                uint32_t nPoints = 0;
+                if (!ReadCount(nPoints) || !SkipPoints(nPoints))
+                    return false;
+            }
+            return true;
+        }
+
+        case wkbMultiPoint:
+        case wkbMultiLineString:
+        case wkbMultiPolygon:
+        {
+            uint32_t nParts = 0;
+            if (bIsPart || !ReadCount(nParts) ||
+                nParts > (nWkbLen - iOffset) / 9)
+                return false;
+            const uint32_t nExpectedPartType =
+                nDimCode * 1000 + nFlatType - (wkbMultiPoint - wkbPoint);
+            for (uint32_t i = 0; i < nParts; ++i)
+            {
+                uint32_t nPartType = 0;
+                if (!GPkgIsWKBUsableAsIs(pabyWkb, nWkbLen, iOffset, nPartType,
+                                         true) ||
+                    nPartType != nExpectedPartType)
+                    return false;
+            }
+            return true;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+/* Same as GPkgGeometryFromOGR(), but directly from a WKB geometry, which */
+/* is used as it is. Returns false, without emitting any error, if the WKB */
+/* geometry is not suitable for that, in which case the caller must go */
+/* through GPkgGeometryFromOGR(). On success, the blob is stored in abyBlob, */
+/* and the type, emptiness and 2D envelope of the geometry are returned. */
+bool GPkgGeometryFromWKB(const GByte *pabyWkb, size_t nWkbLen, int iSrsId,
+                         std::vector<GByte> &abyBlob,
+                         OGRwkbGeometryType &eGeomType, bool &bEmpty,
+                         OGREnvelope &sEnvelope)
+{
+    size_t iOffset = 0;
+    uint32_t nType = 0;
+    if (!GPkgIsWKBUsableAsIs(pabyWkb, nWkbLen, iOffset, nType, false) ||
+        iOffset != nWkbLen)
+    {
+        return false;
+    }
+
+    OGRReadWKBGeometryType(pabyWkb, wkbVariantIso, &eGeomType);
+    const bool bPoint = wkbFlatten(eGeomType) == wkbPoint;
+    /* Same as getCoordinateDimension() */
+    const int iDims = wkbHasZ(eGeomType) ? 3 : 2;
+
+    OGREnvelope3D sEnvelope3D;
+    if (bPoint)
+    {
+        double dfX = 0;
+        double dfY = 0;
+        memcpy(&dfX, pabyWkb + 5, sizeof(double));
+        memcpy(&dfY, pabyWkb + 5 + sizeof(double), sizeof(double));
+        bEmpty = std::isnan(dfX) && std::isnan(dfY);
+        sEnvelope3D.MinX = dfX;
+        sEnvelope3D.MaxX = dfX;
+        sEnvelope3D.MinY = dfY;
+        sEnvelope3D.MaxY = dfY;
+    }
+    else
+    {
+        if (iDims == 3)
+        {
+            if (!OGRWKBGetBoundingBox(pabyWkb, nWkbLen, sEnvelope3D))
+                return false;
+        }
+        else
+        {
+            OGREnvelope sEnvelope2D;
+            if (!OGRWKBGetBoundingBox(pabyWkb, nWkbLen, sEnvelope2D))
+                return false;
+            sEnvelope3D.MinX = sEnvelope2D.MinX;
+            sEnvelope3D.MaxX = sEnvelope2D.MaxX;
+            sEnvelope3D.MinY = sEnvelope2D.MinY;
+            sEnvelope3D.MaxY = sEnvelope2D.MaxY;
+        }
+        bEmpty = !sEnvelope3D.IsInit();
+    }
+    sEnvelope.MinX = sEnvelope3D.MinX;
+    sEnvelope.MaxX = sEnvelope3D.MaxX;
+    sEnvelope.MinY = sEnvelope3D.MinY;
+    sEnvelope.MaxY = sEnvelope3D.MaxY;
+
+    /* Header has 8 bytes for sure, and optional extra space for bounds */
+    size_t nHeaderLen = 2 + 1 + 1 + 4;
+    if (!bPoint && !bEmpty)
+    {
+        nHeaderLen += 8 * 2 * iDims;
+    }
+    if (nHeaderLen + nWkbLen >
+        static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        return false;
+    }
+    abyBlob.resize(nHeaderLen + nWkbLen);
+
+    /* Header Magic and GPKG BLOB Version */
+    abyBlob[0] = 0x47;
+    abyBlob[1] = 0x50;
+    abyBlob[2] = 0;
+
+    /* No envelope for point type or empty geometries */
+    GByte byEnv = 0;
+    if (!bPoint && !bEmpty)
+        byEnv = (iDims == 3) ? 2 : 1;
+    GByte byFlags = static_cast<GByte>(byEnv << 1);
+    if (bEmpty)
+        byFlags |= (1 << 4);
+    /* Use native endianness */
+    byFlags |= static_cast<GByte>(CPL_IS_LSB);
+    abyBlob[3] = byFlags;
+
+    memcpy(abyBlob.data() + 4, &iSrsId, 4);
+
+    if (byEnv != 0)
+    {
+        double adfEnv[6] = {sEnvelope3D.MinX, sEnvelope3D.MaxX,
+                            sEnvelope3D.MinY, sEnvelope3D.MaxY,
+                            sEnvelope3D.MinZ, sEnvelope3D.MaxZ};
+        memcpy(abyBlob.data() + 8, adfEnv, 8 * 2 * iDims);
+    }
+
+    memcpy(abyBlob.data() + nHeaderLen, pabyWkb, nWkbLen);
+    return true;
+}
+
 OGRErr GPkgHeaderFromWKB(const GByte *pabyGpkg, size_t nGpkgLen,
                          GPkgHeader *poHeader)
 {
@@ -13,6 +13,8 @@
 #include "ogrsf_frmts.h"
 #include <sqlite3.h>
 
+#include <vector>
+
 #ifndef OGR_GEOPACKAGEUTILITY_H_INCLUDED
 #define OGR_GEOPACKAGEUTILITY_H_INCLUDED
 
@@ -44,6 +46,10 @@ OGRwkbGeometryType GPkgGeometryTypeToWKB(const char *pszGpkgType, bool bHasZ,
 GByte *GPkgGeometryFromOGR(const OGRGeometry *poGeometry, int iSrsId,
                            const OGRGeomCoordinateBinaryPrecision *psPrecision,
                            size_t *pnWkbLen);
+bool GPkgGeometryFromWKB(const GByte *pabyWkb, size_t nWkbLen, int iSrsId,
+                         std::vector<GByte> &abyBlob,
+                         OGRwkbGeometryType &eGeomType, bool &bEmpty,
+                         OGREnvelope &sEnvelope);
 OGRGeometry *GPkgGeometryToOGR(const GByte *pabyGpkg, size_t nGpkgLen,
                                OGRSpatialReference *poSrs);
 
@@ -1647,6 +1647,54 @@ int64_t FileGDBTable::GetAndSelectNextNonEmptyRow(int64_t iRow)
     return -1;
 }
 
+/************************************************************************/
+/*                        SelectRowFromBlob()                           */
+/************************************************************************/
+
+bool FileGDBTable::SelectRowFromBlob(int64_t iRow, const GByte *pabyBlob,
+                                     GUInt32 nBlobLength)
+{
+    const int errorRetValue = FALSE;
+    returnErrorAndCleanupIf(
+        iRow < 0 || iRow >= m_nTotalRecordCount ||
+            nBlobLength < static_cast<GUInt32>(m_nNullableFieldsSizeInBytes) ||
+            nBlobLength > INT_MAX - ZEROES_AFTER_END_OF_BUFFER,
+        m_nCurRow = -1);
+
+    if (m_abyBuffer.size() < nBlobLength + ZEROES_AFTER_END_OF_BUFFER)
+    {
+        try
+        {
+            m_abyBuffer.resize(nBlobLength + ZEROES_AFTER_END_OF_BUFFER);
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+            returnErrorAndCleanupIf(true, m_nCurRow = -1);
+        }
+    }
+
+    if (nBlobLength > 0)
+        memcpy(m_abyBuffer.data(), pabyBlob, nBlobLength);
+    /* Protection for 4 ReadVarUInt64NoCheck */
+    CPL_STATIC_ASSERT(ZEROES_AFTER_END_OF_BUFFER == 4);
+    m_abyBuffer[nBlobLength] = 0;
+    m_abyBuffer[nBlobLength + 1] = 0;
+    m_abyBuffer[nBlobLength + 2] = 0;
+    m_abyBuffer[nBlobLength + 3] = 0;
+
+    m_nRowBlobLength = nBlobLength;
+    m_bIsDeleted = false;
+    m_nCurRow = iRow;
+    m_nLastCol = -1;
+    m_pabyIterVals = m_abyBuffer.data() + m_nNullableFieldsSizeInBytes;
+    m_iAccNullable = 0;
+    m_bError = FALSE;
+    m_nChSaved = -1;
+
+    return TRUE;
+}
+
 /************************************************************************/
 /*                            SelectRow()                               */
 /************************************************************************/
@@ -724,6 +724,27 @@ class FileGDBTable
         return m_bIsDeleted;
     }
 
+    bool HasTableX() const
+    {
+        return m_fpTableX != nullptr;
+    }
+
+    /* Raw content of the row selected by SelectRow() */
+    const GByte *GetCurRowBlob() const
+    {
+        return m_abyBuffer.data();
+    }
+
+    GUInt32 GetCurRowBlobLength() const
+    {
+        return m_nRowBlobLength;
+    }
+
+    /* Select a row whose raw content has been read by another instance
+     * opened on the same table. */
+    bool SelectRowFromBlob(int64_t iRow, const GByte *pabyBlob,
+                           GUInt32 nBlobLength);
+
     const OGRField *GetFieldValue(int iCol);
     std::vector<OGRField> GetAllFieldValues();
     void FreeAllFieldValues(std::vector<OGRField> &asFields);
@@ -22,6 +22,7 @@
 #include "gdal_rat.h"
 
 #include <array>
+#include <memory>
 #include <vector>
 #include <map>
 
@@ -141,6 +142,8 @@ class OGROpenFileGDBLayer final : public OGRLayer
     int BuildLayerDefinition();
     int BuildGeometryColumnGDBv10(const std::string &osParentDefinition);
     OGRFeature *GetCurrentFeature();
+    OGRFeature *TranslateRow(FileGDBTable *poTable,
+                             FileGDBOGRGeometryConverter *poGeomConverter);
 
     std::unique_ptr<FileGDBOGRGeometryConverter> m_poGeomConverter{};
 
@@ -177,6 +180,20 @@ class OGROpenFileGDBLayer final : public OGRLayer
                                std::vector<OGRField> &fields,
                                const OGRGeometry *&poGeom, bool bUpdate);
 
+    // Parallel implementation of GetNextArrowArray()
+    struct ArrowArrayReader;
+    std::unique_ptr<ArrowArrayReader> m_poArrowArrayReader{};
+    bool m_bArrowArrayReaderFallback = false;
+
+    bool CanUseParallelGetNextArrowArray();
+    bool FillArrowArrayFromRows(FileGDBTable *poTable,
+                                FileGDBOGRGeometryConverter *poGeomConverter,
+                                const std::vector<GByte> &abyRows,
+                                const std::vector<size_t> &anRowOffsets,
+                                const std::vector<int64_t> &anRowIdx,
+                                struct ArrowArray *out_array);
+    void SubmitArrowArrayJobs();
+
     CPL_DISALLOW_COPY_ASSIGN(OGROpenFileGDBLayer)
 
   public:
@@ -280,6 +297,9 @@ class OGROpenFileGDBLayer final : public OGRLayer
 
     virtual int TestCapability(const char *) override;
 
+    int GetNextArrowArray(struct ArrowArrayStream *,
+                          struct ArrowArray *out_array) override;
+
     virtual OGRErr Rename(const char *pszNewName) override;
 
     virtual OGRErr CreateField(const OGRFieldDefn *poField,
@@ -377,9 +397,10 @@ class OGROpenFileGDBFeatureDefn : public OGRFeatureDefn
 
     virtual int GetFieldCount() const override
     {
+        // No write to members here, as this is also called by the worker
+        // threads of GetNextArrowArray() once the layer definition is built.
         if (!m_bHasBuiltFieldDefn && m_poLayer != nullptr)
         {
-            m_bHasBuiltFieldDefn = false;
             (void)m_poLayer->BuildLayerDefinition();
         }
         return OGRFeatureDefn::GetFieldCount();
@@ -20,14 +20,21 @@
 #include <cstring>
 #include <cwchar>
 #include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <mutex>
 #include <string>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_minixml.h"
 #include "cpl_quad_tree.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -38,6 +45,8 @@
 #include "filegdbtable.h"
 #include "ogr_swq.h"
 #include "filegdb_coordprec_read.h"
+#include "ograrrowarrayhelper.h"
+#include "ogrlayerarrow.h"
 
 OGROpenFileGDBGeomFieldDefn::~OGROpenFileGDBGeomFieldDefn() = default;
 
@@ -99,6 +108,9 @@ OGROpenFileGDBLayer::OGROpenFileGDBLayer(OGROpenFileGDBDataSource *poDS,
 
 OGROpenFileGDBLayer::~OGROpenFileGDBLayer()
 {
+    // Wait for pending jobs of GetNextArrowArray() before anything else
+    m_poArrowArrayReader.reset();
+
     OGROpenFileGDBLayer::SyncToDisk();
 
     if (m_poFeatureDefn)
@@ -124,6 +136,7 @@ OGROpenFileGDBLayer::~OGROpenFileGDBLayer()
 
 void OGROpenFileGDBLayer::Close()
 {
+    m_poArrowArrayReader.reset();
     delete m_poLyrTable;
     m_poLyrTable = nullptr;
     m_bValidLayerDefn = FALSE;
@@ -899,6 +912,9 @@ const char *OGROpenFileGDBLayer::GetFIDColumn()
 
 void OGROpenFileGDBLayer::ResetReading()
 {
+    m_poArrowArrayReader.reset();
+    m_bArrowArrayReaderFallback = false;
+
     if (m_iCurFeat != 0)
     {
         if (m_eSpatialIndexState == SPI_IN_BUILDING)
@@ -1724,11 +1740,26 @@ void OGROpenFileGDBLayer::BuildCombinedIterator()
 /***********************************************************************/
 
 OGRFeature *OGROpenFileGDBLayer::GetCurrentFeature()
+{
+    return TranslateRow(m_poLyrTable, m_poGeomConverter.get());
+}
+
+/***********************************************************************/
+/*                            TranslateRow()                           */
+/*                                                                     */
+/*      Build a feature from the row selected in poTable, which is     */
+/*      m_poLyrTable, except for the parallel implementation of        */
+/*      GetNextArrowArray() where each worker thread has its own one.  */
+/***********************************************************************/
+
+OGRFeature *
+OGROpenFileGDBLayer::TranslateRow(FileGDBTable *poTable,
+                                  FileGDBOGRGeometryConverter *poGeomConverter)
 {
     OGRFeature *poFeature = nullptr;
     int iOGRIdx = 0;
-    int64_t iRow = m_poLyrTable->GetCurRow();
-    for (int iGDBIdx = 0; iGDBIdx < m_poLyrTable->GetFieldCount(); iGDBIdx++)
+    int64_t iRow = poTable->GetCurRow();
+    for (int iGDBIdx = 0; iGDBIdx < poTable->GetFieldCount(); iGDBIdx++)
     {
         if (iOGRIdx == m_iFIDAsRegularColumnIndex)
             iOGRIdx++;
@@ -1742,14 +1773,13 @@ OGRFeature *OGROpenFileGDBLayer::GetCurrentFeature()
                 continue;
             }
 
-            const OGRField *psField = m_poLyrTable->GetFieldValue(iGDBIdx);
+            const OGRField *psField = poTable->GetFieldValue(iGDBIdx);
             if (psField != nullptr)
             {
                 if (m_eSpatialIndexState == SPI_IN_BUILDING)
                 {
                     OGREnvelope sFeatureEnvelope;
-                    if (m_poLyrTable->GetFeatureExtent(psField,
-                                                       &sFeatureEnvelope))
+                    if (poTable->GetFeatureExtent(psField, &sFeatureEnvelope))
                     {
 #if SIZEOF_VOIDP < 8
                         if (iRow > INT32_MAX)
@@ -1777,14 +1807,13 @@ OGRFeature *OGROpenFileGDBLayer::GetCurrentFeature()
 
                 if (m_poFilterGeom != nullptr &&
                     m_eSpatialIndexState != SPI_COMPLETED &&
-                    !m_poLyrTable->DoesGeometryIntersectsFilterEnvelope(
-                        psField))
+                    !poTable->DoesGeometryIntersectsFilterEnvelope(psField))
                 {
                     delete poFeature;
                     return nullptr;
                 }
 
-                OGRGeometry *poGeom = m_poGeomConverter->GetAsGeometry(psField);
+                OGRGeometry *poGeom = poGeomConverter->GetAsGeometry(psField);
                 if (poGeom != nullptr)
                 {
                     OGRwkbGeometryType eFlattenType =
@@ -1817,13 +1846,13 @@ OGRFeature *OGROpenFileGDBLayer::GetCurrentFeature()
                 }
             }
         }
-        else if (iGDBIdx != m_poLyrTable->GetObjectIdFieldIdx())
+        else if (iGDBIdx != poTable->GetObjectIdFieldIdx())
         {
             const OGRFieldDefn *poFieldDefn =
                 m_poFeatureDefn->GetFieldDefn(iOGRIdx);
             if (!poFieldDefn->IsIgnored())
             {
-                const OGRField *psField = m_poLyrTable->GetFieldValue(iGDBIdx);
+                const OGRField *psField = poTable->GetFieldValue(iGDBIdx);
                 if (poFeature == nullptr)
                     poFeature = new OGRFeature(m_poFeatureDefn);
                 if (psField == nullptr)
@@ -1840,7 +1869,7 @@ OGRFeature *OGROpenFileGDBLayer::GetCurrentFeature()
                     else if (poFieldDefn->GetType() == OFTDateTime)
                     {
                         OGRField sField = *psField;
-                        if (m_poLyrTable->GetField(iGDBIdx)->GetType() ==
+                        if (poTable->GetField(iGDBIdx)->GetType() ==
                             FGFT_DATETIME)
                         {
                             sField.Date.TZFlag = m_bTimeInUTC ? 100 : 0;
@@ -1858,10 +1887,10 @@ OGRFeature *OGROpenFileGDBLayer::GetCurrentFeature()
     if (poFeature == nullptr)
         poFeature = new OGRFeature(m_poFeatureDefn);
 
-    if (m_poLyrTable->HasDeletedFeaturesListed())
+    if (poTable->HasDeletedFeaturesListed())
     {
         poFeature->SetField(poFeature->GetFieldCount() - 1,
-                            m_poLyrTable->IsCurRowDeleted());
+                            poTable->IsCurRowDeleted());
     }
 
     poFeature->SetFID(iRow + 1);
@@ -1979,6 +2008,553 @@ OGRFeature *OGROpenFileGDBLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                         ArrowArrayReader                             */
+/************************************************************************/
+
+// Target size of the row blobs processed by a job of the parallel
+// implementation of GetNextArrowArray().
+constexpr size_t OPENFILEGDB_ARROW_JOB_SIZE = 4 * 1024 * 1024;
+
+struct OGROpenFileGDBLayer::ArrowArrayReader
+{
+    struct Job
+    {
+        // Raw content of the rows, as read from the .gdbtable file.
+        // Row i is made of bytes [anRowOffsets[i], anRowOffsets[i+1]) of
+        // abyRows.
+        std::vector<GByte> abyRows{};
+        std::vector<size_t> anRowOffsets{};
+        std::vector<int64_t> anRowIdx{};
+        struct ArrowArray sArray;
+        CPLErrorAccumulator oErrorAccumulator{};
+        bool bSuccess = false;
+        bool bFinished = false;
+
+        Job()
+        {
+            memset(&sArray, 0, sizeof(sArray));
+        }
+
+        ~Job()
+        {
+            if (sArray.release)
+                sArray.release(&sArray);
+        }
+
+        CPL_DISALLOW_COPY_ASSIGN(Job)
+    };
+
+    // Table and geometry converter used by a worker thread to decode rows,
+    // as FileGDBTable and FileGDBOGRGeometryConverter are stateful.
+    struct Decoder
+    {
+        FileGDBTable oTable{};
+        std::unique_ptr<FileGDBOGRGeometryConverter> poGeomConverter{};
+    };
+
+    std::unique_ptr<CPLJobQueue> poJobQueue{};
+    size_t nMaxJobs = 0;
+    std::deque<std::unique_ptr<Job>> apoJobs{};
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+
+    // Decoders not currently used by a job. Protected by oMutex.
+    std::vector<std::unique_ptr<Decoder>> apoDecoders{};
+
+    // Set when no more job can be submitted.
+    bool bFinished = false;
+
+    ArrowArrayReader() = default;
+
+    ~ArrowArrayReader()
+    {
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+    }
+
+    std::unique_ptr<Decoder> AcquireDecoder(OGROpenFileGDBLayer *poLayer);
+    void ReleaseDecoder(std::unique_ptr<Decoder> &&poDecoder);
+
+    CPL_DISALLOW_COPY_ASSIGN(ArrowArrayReader)
+};
+
+/************************************************************************/
+/*                          AcquireDecoder()                            */
+/************************************************************************/
+
+std::unique_ptr<OGROpenFileGDBLayer::ArrowArrayReader::Decoder>
+OGROpenFileGDBLayer::ArrowArrayReader::AcquireDecoder(
+    OGROpenFileGDBLayer *poLayer)
+{
+    {
+        std::lock_guard oLock(oMutex);
+        if (!apoDecoders.empty())
+        {
+            auto poDecoder = std::move(apoDecoders.back());
+            apoDecoders.pop_back();
+            return poDecoder;
+        }
+    }
+
+    auto poDecoder = std::make_unique<Decoder>();
+    if (!poDecoder->oTable.Open(poLayer->m_osGDBFilename, false,
+                                poLayer->GetDescription()))
+    {
+        return nullptr;
+    }
+    if (poLayer->m_iGeomFieldIdx >= 0)
+    {
+        const FileGDBGeomField *poGDBGeomField =
+            cpl::down_cast<const FileGDBGeomField *>(
+                poDecoder->oTable.GetField(poLayer->m_iGeomFieldIdx));
+        poDecoder->poGeomConverter.reset(
+            FileGDBOGRGeometryConverter::BuildConverter(poGDBGeomField));
+        if (!poDecoder->poGeomConverter)
+            return nullptr;
+    }
+    return poDecoder;
+}
+
+/************************************************************************/
+/*                          ReleaseDecoder()                            */
+/************************************************************************/
+
+void OGROpenFileGDBLayer::ArrowArrayReader::ReleaseDecoder(
+    std::unique_ptr<Decoder> &&poDecoder)
+{
+    std::lock_guard oLock(oMutex);
+    apoDecoders.push_back(std::move(poDecoder));
+}
+
+/************************************************************************/
+/*                  CanUseParallelGetNextArrowArray()                   */
+/************************************************************************/
+
+bool OGROpenFileGDBLayer::CanUseParallelGetNextArrowArray()
+{
+    // Worker threads open their own handle on the table, so the file must
+    // not be modified behind them. And without a .gdbtablx, the location of
+    // rows is only known after a scan of the whole .gdbtable.
+    if (!BuildLayerDefinition() || m_bEditable ||
+        m_poFilterGeom != nullptr || m_poAttrQuery != nullptr ||
+        m_nFilteredFeatureCount >= 0 || !m_poLyrTable->HasTableX() ||
+        m_poLyrTable->HasDeletedFeaturesListed() ||
+        CPLTestBool(
+            CPLGetConfigOption("OGR_OPENFILEGDB_STREAM_BASE_IMPL", "NO")) ||
+        OGRGetNumThreadsForArrowArray("OGR_OPENFILEGDB_NUM_THREADS") <= 1)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < m_poFeatureDefn->GetFieldCount(); ++i)
+    {
+        const OGRFieldDefn *poFieldDefn = m_poFeatureDefn->GetFieldDefn(i);
+        if (poFieldDefn->IsIgnored())
+            continue;
+        switch (poFieldDefn->GetType())
+        {
+            case OFTInteger:
+            case OFTInteger64:
+            case OFTReal:
+            case OFTString:
+            case OFTBinary:
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                    OGROpenFileGDBFillArrowArray()                    */
+/************************************************************************/
+
+static bool OGROpenFileGDBFillArrowArray(OGRArrowArrayHelper &oHelper,
+                                         const OGRFeatureDefn *poFeatureDefn,
+                                         const OGRFeature &oFeature,
+                                         int iFeat, struct tm &brokenDown)
+{
+    if (oHelper.m_panFIDValues)
+        oHelper.m_panFIDValues[iFeat] = oFeature.GetFID();
+
+    for (int iField = 0; iField < oHelper.m_nFieldCount; ++iField)
+    {
+        const int iArrowField = oHelper.m_mapOGRFieldToArrowField[iField];
+        if (iArrowField < 0)
+            continue;
+        auto psArray = oHelper.m_out_array->children[iArrowField];
+        const OGRField *psField = oFeature.GetRawFieldRef(iField);
+        if (!OGR_RawField_IsUnset(psField) && !OGR_RawField_IsNull(psField))
+        {
+            const OGRFieldDefn *poFieldDefn =
+                poFeatureDefn->GetFieldDefnUnsafe(iField);
+            switch (poFieldDefn->GetType())
+            {
+                case OFTInteger:
+                {
+                    if (poFieldDefn->GetSubType() == OFSTBoolean)
+                    {
+                        if (psField->Integer != 0)
+                            oHelper.SetBoolOn(psArray, iFeat);
+                    }
+                    else if (poFieldDefn->GetSubType() == OFSTInt16)
+                    {
+                        oHelper.SetInt16(
+                            psArray, iFeat,
+                            static_cast<int16_t>(psField->Integer));
+                    }
+                    else
+                    {
+                        oHelper.SetInt32(psArray, iFeat, psField->Integer);
+                    }
+                    break;
+                }
+
+                case OFTInteger64:
+                {
+                    oHelper.SetInt64(psArray, iFeat, psField->Integer64);
+                    break;
+                }
+
+                case OFTReal:
+                {
+                    if (poFieldDefn->GetSubType() == OFSTFloat32)
+                    {
+                        oHelper.SetFloat(psArray, iFeat,
+                                         static_cast<float>(psField->Real));
+                    }
+                    else
+                    {
+                        oHelper.SetDouble(psArray, iFeat, psField->Real);
+                    }
+                    break;
+                }
+
+                case OFTString:
+                {
+                    const size_t nLen = strlen(psField->String);
+                    GByte *pabyOut = oHelper.GetPtrForStringOrBinary(
+                        iArrowField, iFeat, nLen);
+                    if (pabyOut == nullptr)
+                        return false;
+                    memcpy(pabyOut, psField->String, nLen);
+                    break;
+                }
+
+                case OFTBinary:
+                {
+                    const size_t nLen = psField->Binary.nCount;
+                    GByte *pabyOut = oHelper.GetPtrForStringOrBinary(
+                        iArrowField, iFeat, nLen);
+                    if (pabyOut == nullptr)
+                        return false;
+                    if (nLen)
+                        memcpy(pabyOut, psField->Binary.paData, nLen);
+                    break;
+                }
+
+                case OFTDate:
+                {
+                    oHelper.SetDate(psArray, iFeat, brokenDown, *psField);
+                    break;
+                }
+
+                case OFTTime:
+                {
+                    oHelper.SetInt32(
+                        psArray, iFeat,
+                        psField->Date.Hour * 3600000 +
+                            psField->Date.Minute * 60000 +
+                            static_cast<int>(psField->Date.Second * 1000 +
+                                             0.5));
+                    break;
+                }
+
+                case OFTDateTime:
+                {
+                    oHelper.SetDateTime(psArray, iFeat, brokenDown,
+                                        oHelper.m_anTZFlags[iField], *psField);
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+        else if (oHelper.m_abNullableFields[iField])
+        {
+            if (!oHelper.SetNull(iArrowField, iFeat))
+                return false;
+        }
+        else if (psArray->n_buffers == 3)
+        {
+            oHelper.SetEmptyStringOrBinary(psArray, iFeat);
+        }
+    }
+
+    for (int iGeomField = 0; iGeomField < oHelper.m_nGeomFieldCount;
+         ++iGeomField)
+    {
+        const int iArrowField =
+            oHelper.m_mapOGRGeomFieldToArrowField[iGeomField];
+        if (iArrowField < 0)
+            continue;
+        const OGRGeometry *poGeom = oFeature.GetGeomFieldRef(iGeomField);
+        std::unique_ptr<OGRGeometry> poEmptyGeom;
+        if (poGeom == nullptr)
+        {
+            const OGRGeomFieldDefn *poGeomFieldDefn =
+                poFeatureDefn->GetGeomFieldDefn(iGeomField);
+            if (poGeomFieldDefn->IsNullable())
+            {
+                if (!oHelper.SetNull(iArrowField, iFeat))
+                    return false;
+                continue;
+            }
+            // Same as the generic implementation
+            const auto eGeomType = poGeomFieldDefn->GetType();
+            poEmptyGeom.reset(OGRGeometryFactory::createGeometry(
+                wkbFlatten(eGeomType) == wkbUnknown ? wkbGeometryCollection
+                                                    : eGeomType));
+            if (poEmptyGeom == nullptr)
+            {
+                oHelper.SetEmptyStringOrBinary(
+                    oHelper.m_out_array->children[iArrowField], iFeat);
+                continue;
+            }
+            poGeom = poEmptyGeom.get();
+        }
+        const size_t nWKBSize = poGeom->WkbSize();
+        GByte *pabyOut =
+            oHelper.GetPtrForStringOrBinary(iArrowField, iFeat, nWKBSize);
+        if (pabyOut == nullptr)
+            return false;
+        poGeom->exportToWkb(wkbNDR, pabyOut, wkbVariantIso);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                       FillArrowArrayFromRows()                       */
+/*                                                                      */
+/*      Called from worker threads to decode rows read by the thread    */
+/*      consuming the stream, and convert them to an ArrowArray.        */
+/************************************************************************/
+
+bool OGROpenFileGDBLayer::FillArrowArrayFromRows(
+    FileGDBTable *poTable, FileGDBOGRGeometryConverter *poGeomConverter,
+    const std::vector<GByte> &abyRows, const std::vector<size_t> &anRowOffsets,
+    const std::vector<int64_t> &anRowIdx, struct ArrowArray *out_array)
+{
+    OGRArrowArrayHelper oHelper(m_poDS, m_poFeatureDefn,
+                                m_aosArrowArrayStreamOptions, out_array);
+    if (out_array->release == nullptr)
+        return false;
+
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+    const int nRows = static_cast<int>(anRowIdx.size());
+    bool bRet = true;
+    int iFeat = 0;
+    while (bRet && iFeat < nRows)
+    {
+        const size_t nOffset = anRowOffsets[iFeat];
+        bRet = poTable->SelectRowFromBlob(
+            anRowIdx[iFeat], abyRows.data() + nOffset,
+            static_cast<GUInt32>(anRowOffsets[iFeat + 1] - nOffset));
+        if (!bRet)
+            break;
+
+        std::unique_ptr<OGRFeature> poFeature(
+            TranslateRow(poTable, poGeomConverter));
+        bRet = poFeature &&
+               OGROpenFileGDBFillArrowArray(oHelper, m_poFeatureDefn,
+                                            *poFeature, iFeat, brokenDown);
+        ++iFeat;
+    }
+
+    if (!bRet)
+    {
+        oHelper.ClearArray();
+        return false;
+    }
+    oHelper.Shrink(iFeat);
+    return true;
+}
+
+/************************************************************************/
+/*                       SubmitArrowArrayJobs()                         */
+/*                                                                      */
+/*      Read the offsets of the rows in the .gdbtablx and the row       */
+/*      blobs in FID order, and submit them to worker threads, until    */
+/*      the maximum number of pending jobs is reached.                  */
+/************************************************************************/
+
+void OGROpenFileGDBLayer::SubmitArrowArrayJobs()
+{
+    auto &oReader = *m_poArrowArrayReader;
+    const size_t nMaxBatchSize = static_cast<size_t>(
+        OGRArrowArrayHelper::GetMaxFeaturesInBatch(
+            m_aosArrowArrayStreamOptions));
+    const int64_t nTotalRecordCount = m_poLyrTable->GetTotalRecordCount();
+
+    while (!oReader.bFinished && oReader.apoJobs.size() < oReader.nMaxJobs)
+    {
+        auto poJob = std::make_unique<ArrowArrayReader::Job>();
+        bool bOutOfMemory = false;
+        try
+        {
+            poJob->anRowOffsets.push_back(0);
+            while (poJob->anRowIdx.size() < nMaxBatchSize &&
+                   poJob->abyRows.size() < OPENFILEGDB_ARROW_JOB_SIZE)
+            {
+                if (m_iCurFeat == nTotalRecordCount)
+                {
+                    oReader.bFinished = true;
+                    break;
+                }
+                m_iCurFeat =
+                    m_poLyrTable->GetAndSelectNextNonEmptyRow(m_iCurFeat);
+                if (m_iCurFeat < 0)
+                {
+                    m_bEOF = TRUE;
+                    oReader.bFinished = true;
+                    break;
+                }
+                const GByte *pabyBlob = m_poLyrTable->GetCurRowBlob();
+                poJob->abyRows.insert(
+                    poJob->abyRows.end(), pabyBlob,
+                    pabyBlob + m_poLyrTable->GetCurRowBlobLength());
+                poJob->anRowOffsets.push_back(poJob->abyRows.size());
+                poJob->anRowIdx.push_back(m_iCurFeat);
+                m_iCurFeat++;
+            }
+        }
+        catch (const std::exception &e)
+        {
+            // Let GetNextArrowArray() replay the error once the previous
+            // batches have been consumed.
+            auto oContext = poJob->oErrorAccumulator.InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oContext);
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+            bOutOfMemory = true;
+        }
+
+        if (bOutOfMemory)
+        {
+            oReader.bFinished = true;
+            poJob->bFinished = true;
+            oReader.apoJobs.push_back(std::move(poJob));
+            break;
+        }
+
+        if (poJob->anRowIdx.empty())
+            continue;
+
+        ArrowArrayReader::Job *psJob = poJob.get();
+        oReader.apoJobs.push_back(std::move(poJob));
+        const auto RunJob = [this, psJob, &oReader]()
+        {
+            {
+                auto oContext =
+                    psJob->oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oContext);
+                auto poDecoder = oReader.AcquireDecoder(this);
+                if (poDecoder)
+                {
+                    psJob->bSuccess = FillArrowArrayFromRows(
+                        &poDecoder->oTable, poDecoder->poGeomConverter.get(),
+                        psJob->abyRows, psJob->anRowOffsets, psJob->anRowIdx,
+                        &psJob->sArray);
+                    oReader.ReleaseDecoder(std::move(poDecoder));
+                }
+            }
+            std::lock_guard oLock(oReader.oMutex);
+            psJob->bFinished = true;
+            oReader.oCV.notify_all();
+        };
+        if (!oReader.poJobQueue->SubmitJob(RunJob))
+            RunJob();
+    }
+}
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/************************************************************************/
+
+// The thread consuming the stream only reads the row offsets from the
+// .gdbtablx and the raw row blobs from the .gdbtable, in FID order. Worker
+// threads decode the attributes and geometries of those rows, with the same
+// code as GetNextFeature(), and convert them to ArrowArray batches, which
+// are returned in FID order.
+// Falls back to the generic implementation when filters are set, when the
+// layer is opened in update mode, when there is no .gdbtablx, or when
+// deleted features are listed.
+int OGROpenFileGDBLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                           struct ArrowArray *out_array)
+{
+    if (!m_poArrowArrayReader && !m_bArrowArrayReaderFallback)
+    {
+        const int nThreads =
+            OGRGetNumThreadsForArrowArray("OGR_OPENFILEGDB_NUM_THREADS");
+        CPLWorkerThreadPool *poThreadPool =
+            !m_bEOF && CanUseParallelGetNextArrowArray() &&
+                    !m_aosArrowArrayStreamOptions.FetchBool(
+                        GAS_OPT_DATETIME_AS_STRING, false)
+                ? GDALGetGlobalThreadPool(nThreads)
+                : nullptr;
+        if (poThreadPool)
+        {
+            // The in-memory spatial index is only built by GetNextFeature()
+            if (m_eSpatialIndexState == SPI_IN_BUILDING)
+                m_eSpatialIndexState = SPI_INVALID;
+
+            m_poArrowArrayReader = std::make_unique<ArrowArrayReader>();
+            m_poArrowArrayReader->poJobQueue = poThreadPool->CreateJobQueue();
+            m_poArrowArrayReader->nMaxJobs = 2 * static_cast<size_t>(nThreads);
+        }
+        else
+        {
+            m_bArrowArrayReaderFallback = true;
+        }
+    }
+    if (m_bArrowArrayReaderFallback)
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    memset(out_array, 0, sizeof(*out_array));
+
+    auto &oReader = *m_poArrowArrayReader;
+    SubmitArrowArrayJobs();
+    if (oReader.apoJobs.empty())
+        return 0;
+
+    auto poJob = std::move(oReader.apoJobs.front());
+    oReader.apoJobs.pop_front();
+    {
+        std::unique_lock oLock(oReader.oMutex);
+        oReader.oCV.wait(oLock, [&poJob] { return poJob->bFinished; });
+    }
+
+    poJob->oErrorAccumulator.ReplayErrors();
+    if (!poJob->bSuccess)
+        return ENOMEM;
+
+    *out_array = poJob->sArray;
+    memset(&poJob->sArray, 0, sizeof(poJob->sArray));
+
+    // Keep worker threads busy while the caller processes this batch
+    SubmitArrowArrayJobs();
+
+    return 0;
+}
+
 /***********************************************************************/
 /*                          GetFeature()                               */
 /***********************************************************************/
@@ -2357,6 +2933,11 @@ int OGROpenFileGDBLayer::TestCapability(const char *pszCap)
                 m_poLyrTable->HasSpatialIndex());
     }
 
+    else if (EQUAL(pszCap, OLCFastGetArrowStream))
+    {
+        return CanUseParallelGetNextArrowArray();
+    }
+
     return FALSE;
 }
 
@@ -0,0 +1,46 @@
+# SPDX-License-Identifier: MIT
+# Copyright 2025 GDAL contributors
+
+import time
+
+from osgeo import gdal
+
+
+def doit(resampling, use_avx2, downsampling_factor):
+
+    gdal.SetConfigOption("GDAL_USE_AVX2", use_avx2)
+
+    src_ds = gdal.GetDriverByName("MEM").Create(
+        "", 4000, 4000, 1, gdal.GDT_UInt16
+    )
+    src_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).Fill(1000)
+    # Put some nodata so that the masked code paths are taken
+    src_ds.GetRasterBand(1).WriteRaster(
+        1000, 1000, 500, 500, b"\x00" * (500 * 500 * 2)
+    )
+
+    size = 4000 // downsampling_factor
+    start = time.time()
+    gdal.Warp(
+        "",
+        src_ds,
+        format="MEM",
+        width=size,
+        height=size,
+        resampleAlg=resampling,
+    )
+    end = time.time()
+    print(
+        "resampling=%s, GDAL_USE_AVX2=%s, downsampling=%d: %.2f"
+        % (resampling, use_avx2, downsampling_factor, end - start)
+    )
+
+    gdal.SetConfigOption("GDAL_USE_AVX2", None)
+
+
+for resampling in ("cubic", "cubicspline", "lanczos"):
+    for downsampling_factor in (1, 3):
+        doit(resampling, "NO", downsampling_factor)
+        doit(resampling, "YES", downsampling_factor)
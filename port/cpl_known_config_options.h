@@ -74,6 +74,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "CHECK_WITH_INVERT_PROJ", // from gdaltransformer.cpp, gdalwarp_lib.cpp, gdalwarpoperation.cpp, ogrct.cpp
    "COG_DELETE_TEMP_FILES", // from cogdriver.cpp
    "COG_TMP_COMPRESSION", // from cogdriver.cpp
+   "COG_TMP_MAX_MEMORY", // from cogdriver.cpp
    "COMPRESS_GEOM", // from ogrsqlitelayer.cpp
    "COMPRESS_OVERVIEW", // from gt_overview.cpp
    "CONVERT_YCBCR_TO_RGB", // from ecwdataset.cpp, geotiff.cpp, gtiffdataset.cpp, gtiffdataset_read.cpp, gtiffdataset_write.cpp, gtiffrasterband.cpp
@@ -130,6 +131,8 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "CPL_VSIL_CURL_AUTHORIZATION_HEADER_ALLOWED_IF_REDIRECT", // from cpl_http.cpp, cpl_vsil_curl.cpp
    "CPL_VSIL_CURL_CACHE_SIZE", // from cpl_vsil_curl.cpp
    "CPL_VSIL_CURL_CHUNK_SIZE", // from cpl_vsil_curl.cpp
+   "CPL_VSIL_CURL_DISK_CACHE_DIR", // from cpl_vsil_curl.cpp
+   "CPL_VSIL_CURL_DISK_CACHE_SIZE", // from cpl_vsil_curl.cpp
    "CPL_VSIL_CURL_HONOR_CACHE_CONTROL", // from cpl_vsil_curl.cpp
    "CPL_VSIL_CURL_IGNORE_GLACIER_STORAGE", // from cpl_vsil_curl.cpp
    "CPL_VSIL_CURL_IGNORE_STORAGE_CLASSES", // from cpl_vsil_curl.cpp
@@ -263,6 +266,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_EXPRTK_MAX_VECTOR_LENGTH", // from vrtexpression_exprtk.cpp
    "GDAL_EXPRTK_TIMEOUT_SECONDS", // from vrtexpression_exprtk.cpp
    "GDAL_FILENAME_IS_UTF8", // from cpl_getexecpath.cpp, cpl_odbc.cpp, cpl_vsil_win32.cpp, cpl_vsisimple.cpp, cplgetsymbol.cpp, ecwcreatecopy.cpp, ecwdataset.cpp, gdalpython.cpp, netcdfdataset.cpp, netcdfmultidim.cpp, ogrxlsdatasource.cpp
+   "GDAL_FILLNODATA_TILE_SIZE", // from rasterfill.cpp
    "GDAL_FORCE_CACHING", // from gdaldataset.cpp, gdalrasterband.cpp
    "GDAL_GCPS_TO_GEOTRANSFORM_APPROX_OK", // from gdal_misc.cpp
    "GDAL_GCPS_TO_GEOTRANSFORM_APPROX_THRESHOLD", // from gdal_misc.cpp
@@ -337,7 +341,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_NETCDF_REPORT_EXTRA_DIM_VALUES", // from netcdfdataset.cpp
    "GDAL_NETCDF_VERIFY_DIMS", // from netcdfdataset.cpp
    "GDAL_NO_COSTLY_OVERVIEW", // from rasterio.cpp
-   "GDAL_NUM_THREADS", // from avifdataset.cpp, common.cpp, cpl_vsil_gzip.cpp, gdal_tps.cpp, gdalalgorithm.cpp, gdalgrid.cpp, gdalpansharpen.cpp, gdaltileindexdataset.cpp, gdalwarpkernel.cpp, gtiffdataset_write.cpp, jpegxl.cpp, libertiffdataset.cpp, ogr2ogr_lib.cpp, ogrmvtdataset.cpp, ogrparquetlayer.cpp, osm_parser.cpp, overview.cpp, rmfdataset.cpp, vrtdataset.cpp, zarr_array.cpp
+   "GDAL_NUM_THREADS", // from avifdataset.cpp, common.cpp, contour.cpp, cpl_vsil_gzip.cpp, gdal_tps.cpp, gdalalgorithm.cpp, gdaldem_lib.cpp, gdalgrid.cpp, gdalpansharpen.cpp, gdalproximity.cpp, gdalrasterband.cpp, gdalrasterize.cpp, gdalsievefilter.cpp, gdaltileindexdataset.cpp, gdalwarpkernel.cpp, gtiffdataset_write.cpp, jpegxl.cpp, libertiffdataset.cpp, ogr2ogr_lib.cpp, ogr_gensql.cpp, ogrmvtdataset.cpp, ogrparquetlayer.cpp, osm_parser.cpp, overview.cpp, polygonize.cpp, rasterfill.cpp, rmfdataset.cpp, vrtdataset.cpp, zarr_array.cpp
    "GDAL_OGCAPI_TILEMATRIXSET_LIMITS", // from gdalogcapidataset.cpp
    "GDAL_ONE_BIG_READ", // from jp2kakdataset.cpp, jpipkakdataset.cpp, mrsiddataset.cpp, rawdataset.cpp, wcsdataset.cpp
    "GDAL_OPEN_AFTER_COPY", // from jpgdataset.cpp, pngdataset.cpp
@@ -370,6 +374,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_PDF_WRITE_GEOREF_ON_IMAGE", // from pdfcreatecopy.cpp
    "GDAL_PNG_SINGLE_BLOCK", // from pngdataset.cpp
    "GDAL_PNG_WHOLE_IMAGE_OPTIM", // from pngdataset.cpp
+   "GDAL_PROXIMITY_CHUNK_LINES", // from gdalproximity.cpp
    "GDAL_PROXY_AUTH", // from cpl_http.cpp
    "GDAL_PYTHON_DRIVER_PATH", // from gdalpythondriverloader.cpp
    "GDAL_RASTER_PIPELINE_USE_GTIFF_FOR_TEMP_DATASET", // from gdalalg_raster_pipeline.cpp
@@ -383,11 +388,13 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_RB_INTERNALIZE_SLEEP_AFTER_DROP_LOCK", // from gdalrasterblock.cpp
    "GDAL_RB_LOCK_DEBUG_CONTENTION", // from gdalrasterblock.cpp
    "GDAL_RB_LOCK_TYPE", // from gdalrasterblock.cpp
+   "GDAL_RB_SHARD_COUNT", // from gdalrasterblock.cpp
    "GDAL_RB_TRYGET_SLEEP_AFTER_TAKE_LOCK", // from gdalrasterblock.cpp
    "GDAL_READDIR_LIMIT_ON_OPEN", // from gdalopeninfo.cpp, gtiffdataset_read.cpp, tiledbdense.cpp
    "GDAL_REPORT_DIRTY_BLOCK_FLUSHING", // from gdalabstractbandblockcache.cpp
    "GDAL_RPC_DEM_OPTIM", // from gdal_rpc.cpp
    "GDAL_SHARED_FILE", // from cpl_vsil_win32.cpp
+   "GDAL_SIEVE_TILE_SIZE", // from gdalsievefilter.cpp
    "GDAL_SIMUL_MEM_ALLOC_FAILURE_NODATA_MASK_BAND", // from gdalnodatamaskband.cpp
    "GDAL_SKIP", // from gdaldrivermanager.cpp
    "GDAL_STACTA_SKIP_MISSING_METATILE", // from stactadataset.cpp
@@ -403,6 +410,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_TIFF_OVR_BLOCKSIZE", // from geotiff.cpp
    "GDAL_TRY_PDS3_WITH_VICAR", // from pdsdrivercore.cpp
    "GDAL_USE_AVX", // from gdalgrid.cpp
+   "GDAL_USE_AVX2", // from gdalwarpkernel.cpp
    "GDAL_USE_GEOJP2", // from gdaljp2metadata.cpp
    "GDAL_USE_GMLJP2", // from gdaljp2metadata.cpp
    "GDAL_USE_SSE", // from gdalgrid.cpp
@@ -414,6 +422,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_VRT_PYTHON_TRUSTED_MODULES", // from vrtderivedrasterband.cpp
    "GDAL_VRT_RAWRASTERBAND_ALLOWED_SOURCE", // from vrtrawrasterband.cpp
    "GDAL_VRT_WARP_USE_DATASET_RASTERIO", // from vrtwarped.cpp
+   "GDAL_WARP_TRANSFORM_CACHE_MAX", // from gdalwarpkernel.cpp
    "GDAL_WARP_USE_AFFINE_OPTIMIZATION", // from gdalwarpkernel.cpp
    "GDAL_WARP_USE_TRANSLATION_OPTIM", // from gdalwarpoperation.cpp
    "GDAL_WMS_MAX_CONNECTIONS", // from gdalogcapidataset.cpp
@@ -686,6 +695,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "OGR_ARROW_READ_GDAL_FOOTER", // from ogrfeatherlayer.cpp
    "OGR_ARROW_REGISTER_GEOARROW_WKB_EXTENSION", // from ogrfeatherdriver.cpp
    "OGR_ARROW_USE_VSI", // from ogrfeatherdriver.cpp
+   "OGR_ARROW_VECTORIZED_ATTRIBUTE_FILTER", // from ogrlayerarrow.cpp
    "OGR_ARROW_WRITE_BBOX", // from ogrfeatherwriterlayer.cpp
    "OGR_ARROW_WRITE_GDAL_FOOTER", // from ogrfeatherwriterlayer.cpp
    "OGR_ARROW_WRITE_GDAL_GEOMETRY_TYPE", // from ogrfeatherwriterlayer.cpp
@@ -803,6 +813,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "OGR_SHAPE_USE_VSIMEM_FOR_TEMP", // from ogrshapedatasource.cpp
    "OGR_SKIP", // from gdaldrivermanager.cpp
    "OGR_SQL_LIKE_AS_ILIKE", // from ogrwfsfilter.cpp, swq_op_general.cpp
+   "OGR_SQL_SORT_MAX_MEMORY", // from ogr_gensql.cpp
    "OGR_SQL_STRICT", // from swq.cpp
    "OGR_SQLITE_ALLOW_EXTERNAL_ACCESS", // from ogrsqlitesqlfunctionscommon.cpp
    "OGR_SQLITE_CACHE", // from ogrgmldatasource.cpp, ogrsqlitedatasource.cpp
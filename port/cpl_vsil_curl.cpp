@@ -19,6 +19,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 
 #include "cpl_aws.h"
@@ -33,6 +34,14 @@
 #include "cpl_http.h"
 #include "cpl_mem_cache.h"
 
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
 #ifndef S_IRUSR
 #define S_IRUSR 00400
 #define S_IWUSR 00200
@@ -1489,7 +1498,8 @@ retry:
                             std::min<size_t>(sWriteFuncData.nSize - nOffset,
                                              knDOWNLOAD_CHUNK_SIZE);
                         poFS->AddRegion(m_pszURL, nOffset, nToCache,
-                                        sWriteFuncData.pBuffer + nOffset);
+                                        sWriteFuncData.pBuffer + nOffset,
+                                        &oFileProp);
                         nOffset += nToCache;
                     }
                 }
@@ -2302,7 +2312,8 @@ void VSICurlHandle::DownloadRegionPostProcess(const vsi_l_offset startOffset,
 #endif
         const size_t nChunkSize =
             std::min(static_cast<size_t>(knDOWNLOAD_CHUNK_SIZE), nSize);
-        poFS->AddRegion(m_pszURL, l_startOffset, nChunkSize, pBuffer);
+        poFS->AddRegion(m_pszURL, l_startOffset, nChunkSize, pBuffer,
+                        &oFileProp);
         l_startOffset += nChunkSize;
         pBuffer += nChunkSize;
         nSize -= nChunkSize;
@@ -2354,7 +2365,7 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             (iterOffset / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
         std::string osRegion;
         std::shared_ptr<std::string> psRegion =
-            poFS->GetRegion(m_pszURL, nOffsetToDownload);
+            poFS->GetRegion(m_pszURL, nOffsetToDownload, &oFileProp);
         if (psRegion != nullptr)
         {
             osRegion = *psRegion;
@@ -2394,10 +2405,11 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             // this should not cause bugs. Just missed optimization.
             for (int i = 1; i < nBlocksToDownload; i++)
             {
-                if (poFS->GetRegion(m_pszURL, nOffsetToDownload +
-                                                  static_cast<vsi_l_offset>(i) *
-                                                      knDOWNLOAD_CHUNK_SIZE) !=
-                    nullptr)
+                if (poFS->GetRegion(m_pszURL,
+                                    nOffsetToDownload +
+                                        static_cast<vsi_l_offset>(i) *
+                                            knDOWNLOAD_CHUNK_SIZE,
+                                    &oFileProp) != nullptr)
                 {
                     nBlocksToDownload = i;
                     break;
@@ -3919,25 +3931,431 @@ VSICurlFilesystemHandlerBase::GetRegionCache()
     return m_poRegionCacheDoNotUseDirectly.get();
 }
 
+/************************************************************************/
+/*                          VSICurlDiskCache                            */
+/************************************************************************/
+
+namespace
+{
+
+// Persistent cache of downloaded chunks, shared by all network file systems
+// and by all processes using the same CPL_VSIL_CURL_DISK_CACHE_DIR.
+// Each chunk is stored in its own file, whose name is the SHA256 of a key
+// made of the URL, a validator of the remote content (ETag, or file size and
+// modification time), the chunk size and the chunk offset. Only that hash is
+// stored in the file, and not the key, as URLs may contain credentials.
+// Files are written to a temporary file and atomically renamed, so that
+// concurrent readers never see partial content. The modification time of a
+// file is refreshed when it is read, and the least recently used files are
+// evicted when the total size of the cache exceeds
+// CPL_VSIL_CURL_DISK_CACHE_SIZE.
+class VSICurlDiskCache
+{
+  public:
+    VSICurlDiskCache(const std::string &osDir, GIntBig nMaxSize)
+        : m_osDir(osDir), m_nMaxSize(nMaxSize)
+    {
+    }
+
+    std::shared_ptr<std::string> Read(const std::string &osKey);
+    void Write(const std::string &osKey, const char *pData, size_t nSize);
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(VSICurlDiskCache)
+
+    const std::string m_osDir;
+    const GIntBig m_nMaxSize;
+
+    std::mutex m_oMutex{};
+    bool m_bDirCreated = false;
+    // Estimated size of the cache directory. -1 until it has been scanned.
+    GIntBig m_nCurSize = -1;
+    bool m_bEvicting = false;
+
+    std::string GetFilename(const std::string &osHash) const;
+    GIntBig Evict() const;
+};
+
+constexpr const char DISK_CACHE_SIGNATURE[] = "GDAL_VSICURL_CHUNK_V2";
+constexpr const char DISK_CACHE_EXTENSION[] = ".chunk";
+// Size of the lower-case hexadecimal SHA256 of the key
+constexpr size_t DISK_CACHE_HASH_SIZE = 64;
+constexpr size_t DISK_CACHE_HEADER_SIZE =
+    sizeof(DISK_CACHE_SIGNATURE) - 1 + DISK_CACHE_HASH_SIZE;
+
+/************************************************************************/
+/*                            GetFilename()                             */
+/************************************************************************/
+
+std::string VSICurlDiskCache::GetFilename(const std::string &osHash) const
+{
+    return CPLFormFilenameSafe(m_osDir.c_str(), osHash.c_str(),
+                               DISK_CACHE_EXTENSION + 1);
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCacheTouch()                        */
+/************************************************************************/
+
+void VSICurlDiskCacheTouch(const std::string &osFilename)
+{
+#ifdef _WIN32
+    wchar_t *pwszFilename =
+        CPLRecodeToWChar(osFilename.c_str(), CPL_ENC_UTF8, CPL_ENC_UCS2);
+    CPL_IGNORE_RET_VAL(_wutime(pwszFilename, nullptr));
+    CPLFree(pwszFilename);
+#else
+    CPL_IGNORE_RET_VAL(utime(osFilename.c_str(), nullptr));
+#endif
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+std::shared_ptr<std::string> VSICurlDiskCache::Read(const std::string &osKey)
+{
+    const std::string osHash = CPLGetLowerCaseHexSHA256(osKey);
+    const std::string osFilename = GetFilename(osHash);
+    CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+    auto fp = VSIVirtualHandleUniquePtr(VSIFOpenL(osFilename.c_str(), "rb"));
+    if (!fp)
+        return nullptr;
+
+    // Header: signature, SHA256 of the key, then the chunk content.
+    std::array<char, DISK_CACHE_HEADER_SIZE> abyHeader;
+    constexpr size_t nSigSize = sizeof(DISK_CACHE_SIGNATURE) - 1;
+    // Protects against foreign or renamed files
+    if (fp->Read(abyHeader.data(), abyHeader.size(), 1) != 1 ||
+        memcmp(abyHeader.data(), DISK_CACHE_SIGNATURE, nSigSize) != 0 ||
+        memcmp(abyHeader.data() + nSigSize, osHash.data(),
+               DISK_CACHE_HASH_SIZE) != 0)
+    {
+        return nullptr;
+    }
+
+    if (fp->Seek(0, SEEK_END) != 0)
+        return nullptr;
+    const vsi_l_offset nFileSize = fp->Tell();
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    if (nFileSize <= DISK_CACHE_HEADER_SIZE ||
+        nFileSize - DISK_CACHE_HEADER_SIZE >
+            static_cast<vsi_l_offset>(knDOWNLOAD_CHUNK_SIZE))
+    {
+        return nullptr;
+    }
+    auto out = std::make_shared<std::string>();
+    out->resize(static_cast<size_t>(nFileSize - DISK_CACHE_HEADER_SIZE));
+    if (fp->Seek(DISK_CACHE_HEADER_SIZE, SEEK_SET) != 0 ||
+        fp->Read(&(*out)[0], out->size(), 1) != 1)
+    {
+        return nullptr;
+    }
+    fp.reset();
+
+    VSICurlDiskCacheTouch(osFilename);
+    return out;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+void VSICurlDiskCache::Write(const std::string &osKey, const char *pData,
+                             size_t nSize)
+{
+    if (nSize == 0 || static_cast<GIntBig>(nSize) > m_nMaxSize)
+        return;
+
+    CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+    {
+        std::lock_guard oLock(m_oMutex);
+        if (!m_bDirCreated)
+        {
+            // Chunks may contain non-public data: restrict the directory we
+            // create to its owner.
+            VSIStatBufL sStat;
+            if (VSIStatL(m_osDir.c_str(), &sStat) != 0 &&
+                VSIMkdirRecursive(m_osDir.c_str(),
+                                  S_IRUSR | S_IWUSR | S_IXUSR) != 0)
+            {
+                CPLDebugOnce("VSICURL",
+                             "Cannot create disk cache directory %s",
+                             m_osDir.c_str());
+                return;
+            }
+            m_bDirCreated = true;
+        }
+    }
+
+    const std::string osHash = CPLGetLowerCaseHexSHA256(osKey);
+    const std::string osFilename = GetFilename(osHash);
+    // Unique among processes and threads
+    const std::string osTmpFilename =
+        CPLSPrintf("%s.%d." CPL_FRMT_GIB ".tmp", osFilename.c_str(),
+                   CPLGetCurrentProcessID(), CPLGetPID());
+#ifndef _WIN32
+    // Create the file with owner-only permissions before writing into it,
+    // as VSIFOpenL() would use the default ones. They are kept by the
+    // truncation below and by the rename.
+    if (!STARTS_WITH(osTmpFilename.c_str(), "/vsi"))
+    {
+        const int fd = open(osTmpFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                            S_IRUSR | S_IWUSR);
+        if (fd < 0)
+            return;
+        close(fd);
+    }
+#endif
+    {
+        auto fp =
+            VSIVirtualHandleUniquePtr(VSIFOpenL(osTmpFilename.c_str(), "wb"));
+        if (!fp)
+        {
+            VSIUnlink(osTmpFilename.c_str());
+            return;
+        }
+        constexpr size_t nSigSize = sizeof(DISK_CACHE_SIGNATURE) - 1;
+        if (fp->Write(DISK_CACHE_SIGNATURE, nSigSize, 1) != 1 ||
+            fp->Write(osHash.data(), DISK_CACHE_HASH_SIZE, 1) != 1 ||
+            fp->Write(pData, nSize, 1) != 1 || fp->Close() != 0)
+        {
+            fp.reset();
+            VSIUnlink(osTmpFilename.c_str());
+            return;
+        }
+    }
+    if (VSIRename(osTmpFilename.c_str(), osFilename.c_str()) != 0)
+    {
+        // Typically on Windows if another process has just written the
+        // same chunk.
+        VSIUnlink(osTmpFilename.c_str());
+        return;
+    }
+
+    {
+        std::lock_guard oLock(m_oMutex);
+        if (m_nCurSize >= 0)
+            m_nCurSize +=
+                static_cast<GIntBig>(DISK_CACHE_HEADER_SIZE + nSize);
+        if (m_bEvicting || (m_nCurSize >= 0 && m_nCurSize <= m_nMaxSize))
+            return;
+        m_bEvicting = true;
+    }
+
+    // The directory scan is done without m_oMutex held, so that other
+    // threads are not blocked meanwhile. Chunks written concurrently may be
+    // missed by the scan, which only makes m_nCurSize an underestimate until
+    // the next one.
+    const GIntBig nTotalSize = Evict();
+
+    std::lock_guard oLock(m_oMutex);
+    m_nCurSize = nTotalSize;
+    m_bEvicting = false;
+}
+
+/************************************************************************/
+/*                               Evict()                                */
+/************************************************************************/
+
+// Removes the least recently used chunks if the cache is too large, and
+// returns the resulting size of the cache (or -1 if it cannot be scanned).
+GIntBig VSICurlDiskCache::Evict() const
+{
+    struct Entry
+    {
+        std::string osFilename{};
+        GIntBig nSize = 0;
+        GIntBig nMTime = 0;
+    };
+
+    std::vector<Entry> aoEntries;
+    GIntBig nTotalSize = 0;
+    const GIntBig nNow = static_cast<GIntBig>(time(nullptr));
+    // Temporary files left by crashed processes
+    constexpr int STALE_TMP_FILE_DELAY_SEC = 3600;
+
+    VSIDIR *psDir = VSIOpenDir(m_osDir.c_str(), 0, nullptr);
+    if (!psDir)
+        return -1;
+    while (const VSIDIREntry *psEntry = VSIGetNextDirEntry(psDir))
+    {
+        if (!VSI_ISREG(psEntry->nMode))
+            continue;
+        std::string osFilename =
+            CPLFormFilenameSafe(m_osDir.c_str(), psEntry->pszName, nullptr);
+        if (cpl::ends_with(std::string(psEntry->pszName), ".tmp"))
+        {
+            if (psEntry->nMTime < nNow - STALE_TMP_FILE_DELAY_SEC)
+                VSIUnlink(osFilename.c_str());
+        }
+        else if (cpl::ends_with(std::string(psEntry->pszName),
+                                DISK_CACHE_EXTENSION))
+        {
+            Entry entry;
+            entry.osFilename = std::move(osFilename);
+            entry.nSize = static_cast<GIntBig>(psEntry->nSize);
+            entry.nMTime = psEntry->nMTime;
+            nTotalSize += entry.nSize;
+            aoEntries.push_back(std::move(entry));
+        }
+    }
+    VSICloseDir(psDir);
+
+    if (nTotalSize > m_nMaxSize)
+    {
+        // Evict down to 90% of the maximum size, to avoid rescanning the
+        // directory at each subsequent write.
+        const GIntBig nTargetSize = m_nMaxSize / 10 * 9;
+        std::sort(aoEntries.begin(), aoEntries.end(),
+                  [](const Entry &a, const Entry &b)
+                  { return a.nMTime < b.nMTime; });
+        for (const auto &entry : aoEntries)
+        {
+            if (nTotalSize <= nTargetSize)
+                break;
+            // Might fail if another process has removed it concurrently
+            VSIUnlink(entry.osFilename.c_str());
+            nTotalSize -= entry.nSize;
+        }
+    }
+    return nTotalSize;
+}
+
+/************************************************************************/
+/*                        GetVSICurlDiskCache()                         */
+/************************************************************************/
+
+std::mutex goDiskCacheMutex;
+bool gbDiskCacheInitialized = false;
+std::shared_ptr<VSICurlDiskCache> gpoDiskCache;
+
+// Returns nullptr if CPL_VSIL_CURL_DISK_CACHE_DIR is not set.
+// Configuration options are only read the first time, or after
+// ResetVSICurlDiskCache().
+std::shared_ptr<VSICurlDiskCache> GetVSICurlDiskCache()
+{
+    std::lock_guard oLock(goDiskCacheMutex);
+    if (gbDiskCacheInitialized)
+        return gpoDiskCache;
+    gbDiskCacheInitialized = true;
+
+    const char *pszDir =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", nullptr);
+    if (pszDir == nullptr || pszDir[0] == '\0')
+        return nullptr;
+
+    constexpr GIntBig DISK_CACHE_SIZE_DEFAULT =
+        static_cast<GIntBig>(1024) * 1024 * 1024;
+    GIntBig nMaxSize = DISK_CACHE_SIZE_DEFAULT;
+    const char *pszSize =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE", nullptr);
+    if (pszSize &&
+        (CPLParseMemorySize(pszSize, &nMaxSize, nullptr) != CE_None ||
+         nMaxSize <= 0))
+    {
+        CPLErrorOnce(CE_Warning, CPLE_AppDefined,
+                     "Invalid value for CPL_VSIL_CURL_DISK_CACHE_SIZE. "
+                     "Using default value of " CPL_FRMT_GIB " instead.",
+                     DISK_CACHE_SIZE_DEFAULT);
+        nMaxSize = DISK_CACHE_SIZE_DEFAULT;
+    }
+
+    gpoDiskCache = std::make_shared<VSICurlDiskCache>(pszDir, nMaxSize);
+    return gpoDiskCache;
+}
+
+/************************************************************************/
+/*                        ResetVSICurlDiskCache()                       */
+/************************************************************************/
+
+// Forces the configuration options to be read again at the next use.
+void ResetVSICurlDiskCache()
+{
+    std::lock_guard oLock(goDiskCacheMutex);
+    gbDiskCacheInitialized = false;
+    gpoDiskCache.reset();
+}
+
+/************************************************************************/
+/*                      GetVSICurlDiskCacheKey()                        */
+/************************************************************************/
+
+// Returns an empty string if the remote content cannot be identified well
+// enough for its chunks to be safely reused by another session.
+std::string GetVSICurlDiskCacheKey(const char *pszURL,
+                                   vsi_l_offset nFileOffsetStart,
+                                   const FileProp &oFileProp)
+{
+    std::string osValidator;
+    if (!oFileProp.ETag.empty())
+        osValidator = "etag:" + oFileProp.ETag;
+    else if (oFileProp.bHasComputedFileSize && oFileProp.mTime != 0)
+        osValidator = CPLSPrintf("size:" CPL_FRMT_GUIB ",mtime:" CPL_FRMT_GIB,
+                                 static_cast<GUIntBig>(oFileProp.fileSize),
+                                 static_cast<GIntBig>(oFileProp.mTime));
+    else
+        return std::string();
+
+    std::string osKey(pszURL);
+    osKey += '\n';
+    osKey += osValidator;
+    osKey += CPLSPrintf("\nchunk_size:%d\noffset:" CPL_FRMT_GUIB,
+                        VSICURLGetDownloadChunkSize(),
+                        static_cast<GUIntBig>(nFileOffsetStart));
+    return osKey;
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                          GetRegion()                                 */
 /************************************************************************/
 
 std::shared_ptr<std::string>
 VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
-                                        vsi_l_offset nFileOffsetStart)
+                                        vsi_l_offset nFileOffsetStart,
+                                        const FileProp *poFileProp)
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     nFileOffsetStart =
         (nFileOffsetStart / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
 
-    std::shared_ptr<std::string> out;
-    if (GetRegionCache()->tryGet(
-            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
     {
-        return out;
+        CPLMutexHolder oHolder(&hMutex);
+
+        std::shared_ptr<std::string> out;
+        if (GetRegionCache()->tryGet(
+                FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+                out))
+        {
+            return out;
+        }
+    }
+
+    // Fallback to the persistent disk cache, if enabled. Done without
+    // hMutex held, as this involves file I/O.
+    if (poFileProp)
+    {
+        auto poDiskCache = GetVSICurlDiskCache();
+        if (poDiskCache)
+        {
+            const std::string osKey =
+                GetVSICurlDiskCacheKey(pszURL, nFileOffsetStart, *poFileProp);
+            if (!osKey.empty())
+            {
+                auto out = poDiskCache->Read(osKey);
+                if (out)
+                {
+                    CPLMutexHolder oHolder(&hMutex);
+                    GetRegionCache()->insert(
+                        FilenameOffsetPair(std::string(pszURL),
+                                           nFileOffsetStart),
+                        out);
+                    return out;
+                }
+            }
+        }
     }
 
     return nullptr;
@@ -3949,14 +4367,29 @@ VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
 
 void VSICurlFilesystemHandlerBase::AddRegion(const char *pszURL,
                                              vsi_l_offset nFileOffsetStart,
-                                             size_t nSize, const char *pData)
+                                             size_t nSize, const char *pData,
+                                             const FileProp *poFileProp)
 {
-    CPLMutexHolder oHolder(&hMutex);
+    {
+        CPLMutexHolder oHolder(&hMutex);
+
+        std::shared_ptr<std::string> value(new std::string());
+        value->assign(pData, nSize);
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+    }
 
-    std::shared_ptr<std::string> value(new std::string());
-    value->assign(pData, nSize);
-    GetRegionCache()->insert(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+    if (poFileProp)
+    {
+        auto poDiskCache = GetVSICurlDiskCache();
+        if (poDiskCache)
+        {
+            const std::string osKey =
+                GetVSICurlDiskCacheKey(pszURL, nFileOffsetStart, *poFileProp);
+            if (!osKey.empty())
+                poDiskCache->Write(osKey, pData, nSize);
+        }
+    }
 }
 
 /************************************************************************/
@@ -4109,6 +4542,8 @@ void VSICurlFilesystemHandlerBase::ClearCache()
     nCachedFilesInDirList = 0;
 
     GetConnectionCache()[this].clear();
+
+    ResetVSICurlDiskCache();
 }
 
 /************************************************************************/
@@ -4245,6 +4680,12 @@ const char *VSICurlFilesystemHandlerBase::GetActualURL(const char *pszFilename)
     "  <Option name='CPL_VSIL_CURL_CACHE_SIZE' type='integer' "                \
     "description='Size in bytes of the global /vsicurl/ cache' "               \
     "default='16384000'/>"                                                     \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_DIR' type='string' "             \
+    "description='Directory where downloaded chunks are persistently "         \
+    "cached'/>"                                                                \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_SIZE' type='integer' "           \
+    "description='Maximum size in bytes of the persistent disk cache' "        \
+    "default='1073741824'/>"                                                   \
     "  <Option name='CPL_VSIL_CURL_IGNORE_GLACIER_STORAGE' type='boolean' "    \
     "description='Whether to skip files with Glacier storage class in "        \
     "directory listing.' default='YES'/>"                                      \
@@ -291,11 +291,15 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
         return false;
     }
 
-    std::shared_ptr<std::string> GetRegion(const char *pszURL,
-                                           vsi_l_offset nFileOffsetStart);
+    // When poFileProp is provided, the persistent disk cache configured with
+    // CPL_VSIL_CURL_DISK_CACHE_DIR is also used.
+    std::shared_ptr<std::string>
+    GetRegion(const char *pszURL, vsi_l_offset nFileOffsetStart,
+              const FileProp *poFileProp = nullptr);
 
     void AddRegion(const char *pszURL, vsi_l_offset nFileOffsetStart,
-                   size_t nSize, const char *pData);
+                   size_t nSize, const char *pData,
+                   const FileProp *poFileProp = nullptr);
 
     std::pair<bool, std::string>
     NotifyStartDownloadRegion(const std::string &osURL,